@@ -44,20 +44,24 @@ int main(uint32_t argc, char* argv[]) {
     uint32_t percent_mutation = 20;
     uint32_t tournament_size = 2;
     bool visualization = false;
+    char mutation_operator[20] = "all_params";
     osaka_object_typ curr_type = NOTSET;
 
     // variables that are only used for llvm optimization
     char** src_files;
     char test_file[50];
-    char answer[5];
     char num_src_files_str[10];
     uint32_t num_src_files = 0;
+    suite_str llvm_suite;
 
     // flag variables
     bool test = false;
     bool llvm_optimizing = false;
     bool using_params_file = false;
     bool caching = false;
+    bool async_output = false;
+    output_policy_typ output_policy = OUTPUT_BLOCK;
+    bool tracing = false;
 
     // Arg parsing to see if the help flag was triggered, overrides all other flags
 
@@ -70,7 +74,37 @@ int main(uint32_t argc, char* argv[]) {
                 printf("\t-parameters_file\t: Specifies that an input file at src/files/parameters.txt will be used to change some of the parameters for evolution.\n");
                 printf("\t-test\t\t\t: Enables the testing script for Shackleton to be run. Will be run regardless of other parameters specified.\n");
                 printf("\t-llvm_optimize\t\t: Specifies that the LLVM integrated portion of the tool will be used to optimize LLVM using evolution.\n\t\t\t\t  This option automatically sets the object type needed to LLVM_PASS\n");
-                printf("\t-cache\t\t\t: Caches information for each evolutionary run into files. This means something different depending on the object type being used.\n\n");
+                printf("\t-llvm_suite FILE\t: Same as -llvm_optimize, but the fitness is taken over the suite of benchmark programs that FILE describes,\n"
+                            "\t\t\t\t  as the weighted geometric mean of their times over their unoptimized times, see src/files/README.md\n");
+                printf("\t-aarch64\t\t: Evaluates ASSEMBLER individuals as AArch64 functions, built with %s and run under %s, one launch\n"
+                            "\t\t\t\t  per generation. Every result is checked against the interpreter\n", AARCH64_CC, AARCH64_EMULATOR);
+                printf("\t-cache\t\t\t: Caches information for each evolutionary run into a single JSON Lines run log, one record per evaluated individual.\n");
+                printf("\t-cache_binary\t\t: Same as -cache, but the run log is written in a compact binary format.\n");
+                printf("\t-async_output\t\t: Hands cache and visualization output to a background writer thread so the evolution loop never waits on disk.\n");
+                printf("\t-async_output_drop\t: Same as -async_output, but output is dropped instead of waiting when the writer falls behind.\n");
+                printf("\t-trace\t\t\t: Writes a timeline of the run to %s, viewable in Perfetto or chrome://tracing.\n", TRACE_DEFAULT_FILE);
+                printf("\t-bench\t\t\t: Runs the micro-benchmarks of the OSAKA routines and genetic operators, printed as JSON Lines and compared against\n"
+                            "\t\t\t\t  %s. Exits with status 1 if any benchmark regressed. Narrowed down with:\n", BENCH_BASELINE_FILE);
+                printf("\t  -bench_type N\t\t: Object type to benchmark, numbered as below (default 1, SIMPLE)\n");
+                printf("\t  -bench_genome N\t: Single genome length to benchmark instead of the default set\n");
+                printf("\t  -bench_population N\t: Single population size to benchmark instead of the default set\n");
+                printf("\t  -bench_save\t\t: Saves the results as the new baseline\n");
+                printf("\t-bench_evolution\t: Benchmarks whole evolutionary runs with a synthetic evaluator in place of the fitness functions, repeated with\n"
+                            "\t\t\t\t  1, 2, 4 ... evaluation threads. Also takes -bench_type, -bench_genome (default 20) and -bench_population (default 100), and:\n");
+                printf("\t  -bench_generations N\t: Generations per run (default 10)\n");
+                printf("\t  -bench_workers N\t: Largest number of evaluation threads (default the number of processors)\n");
+                printf("\t  -bench_cost_us N\t: CPU time burnt by every evaluation, in microseconds (default 1000)\n");
+                printf("\t  -bench_latency_us N\t: Mean time every evaluation waits, in microseconds (default 0)\n");
+                printf("\t  -bench_latency D\t: Distribution of the wait, constant, uniform or exponential (default constant)\n");
+                printf("\t  -bench_noise X\t: Standard deviation of the noise added to every fitness (default 0)\n");
+                printf("\t  -bench_seed N\t\t: Seed of the runs and of the evaluator (default 42)\n");
+                printf("\t  -bench_cache\t\t: Also writes a run log for every run\n");
+                printf("\t-job SPEC\t\t: Runs the job SPEC describes without asking anything. SPEC is a JSON object, inline or in a file, with the\n"
+                            "\t\t\t\t  keys type, generations, population, genome_length, crossover, mutation, mutation_operator, tournament,\n"
+                            "\t\t\t\t  visualization, test_file, sources, suite, evaluator, mock, workers, seed, output, cache and trace. May be\n"
+                            "\t\t\t\t  given several times\n");
+                printf("\t-queue PATH\t\t: Runs every .json job file of the folder PATH in name order, or every job file listed in the file PATH,\n"
+                            "\t\t\t\t  back to back. Both print one JSON line per job and exit with status 1 if any job was invalid\n\n");
                 printf("The Shackleton framework has a set number of object types available to evolve. If you would like to use different types than the ones listed below,"
                             " you can use the Editor tool found at src/editor_tool to add new object types. Please follow the instructions for using that tool given in the"
                             " README of the github repository in that subdirectory. Here are the currently available object types:\n\n");
@@ -86,7 +120,8 @@ int main(uint32_t argc, char* argv[]) {
                 printf("\t[3] percent_crossover = %d\t\t-- The percent chance that any one individual will have crossover applied to it\n", percent_crossover);
                 printf("\t[4] percent_mutation = %d\t\t-- The percent chance that any one individual will have mutation applied to it\n", percent_mutation);
                 printf("\t[5] tournament_size = %d\t\t\t-- The number of individuals in each tournament for selection\n", tournament_size);
-                printf("\t[6] visualization = %s\t\t-- Whether or not visualization of the evolution process is enabled\n\n", visualization ? "true" : "false");
+                printf("\t[6] visualization = %s\t\t-- Whether or not visualization of the evolution process is enabled\n", visualization ? "true" : "false");
+                printf("\t[7] mutation_operator = %s\t-- Whether mutation redraws every parameter of a unit (all_params) or only one (single_param)\n\n", mutation_operator);
                 printf("These are all the options that are built into the command line interface for the Shackleton tool. If you have more questions about the inner"
                             " workings of the tool and everything that goes into the implemention, please refer to the README documents contained in the github"
                             " repository which can be found at: https://github.com/ARM-software/Shackleton-Framework. \n\n");
@@ -95,6 +130,162 @@ int main(uint32_t argc, char* argv[]) {
         }
     }
 
+    // Arg parsing for the end to end benchmark, which also runs without any interaction
+
+    if (argc >= 2) {
+        for (uint32_t curr = 1; curr < argc; curr++) {
+            if (strcmp(argv[curr], "-bench_evolution") == 0) {
+
+                mock_config_str mock_config = { 1000000, 0, MOCK_LATENCY_CONSTANT, 0.0, 42 };
+                osaka_object_typ bench_type = SIMPLE;
+                uint32_t bench_genome_len = 20;
+                uint32_t bench_pop_size = 100;
+                uint32_t bench_generations = 10;
+                long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+                uint32_t bench_workers = num_processors > 0 && num_processors < EVOLUTION_MAX_WORKERS ? num_processors : EVOLUTION_MAX_WORKERS;
+                bool bench_cache = false;
+
+                for (uint32_t opt = 1; opt < argc; opt++) {
+                    if (strcmp(argv[opt], "-bench_type") == 0 && opt + 1 < argc) {
+                        bench_type = (osaka_object_typ) (atoi(argv[++opt]) - 1);
+                    }
+                    else if (strcmp(argv[opt], "-bench_genome") == 0 && opt + 1 < argc) {
+                        bench_genome_len = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_population") == 0 && opt + 1 < argc) {
+                        bench_pop_size = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_generations") == 0 && opt + 1 < argc) {
+                        bench_generations = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_workers") == 0 && opt + 1 < argc) {
+                        bench_workers = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_cost_us") == 0 && opt + 1 < argc) {
+                        mock_config.cost_ns = strtoull(argv[++opt], NULL, 10) * 1000;
+                    }
+                    else if (strcmp(argv[opt], "-bench_latency_us") == 0 && opt + 1 < argc) {
+                        mock_config.latency_ns = strtoull(argv[++opt], NULL, 10) * 1000;
+                    }
+                    else if (strcmp(argv[opt], "-bench_latency") == 0 && opt + 1 < argc) {
+                        mock_config.latency = mock_latency_from_name(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_noise") == 0 && opt + 1 < argc) {
+                        mock_config.noise = atof(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_seed") == 0 && opt + 1 < argc) {
+                        mock_config.seed = strtoull(argv[++opt], NULL, 10);
+                    }
+                    else if (strcmp(argv[opt], "-bench_cache") == 0) {
+                        bench_cache = true;
+                    }
+                }
+
+                if (bench_type < 0 || bench_type >= MAXTYPE) {
+                    printf("error: -bench_type must be between 1 and %d [file:\'%s\',line:%d]\n", MAXTYPE, __FILE__, __LINE__);
+                    exit(0);
+                }
+                if (bench_workers < 1 || bench_workers > EVOLUTION_MAX_WORKERS || bench_genome_len < 3 || bench_pop_size < 4) {
+                    printf("error: benchmarks need 1 to %d workers, a genome length of at least 3 and a population of at least 4 [file:\'%s\',line:%d]\n", EVOLUTION_MAX_WORKERS, __FILE__, __LINE__);
+                    exit(0);
+                }
+
+                bench_evolution(stdout, &mock_config, bench_type, bench_generations, bench_pop_size, bench_genome_len, bench_workers, bench_cache);
+                exit(0);
+
+            }
+        }
+    }
+
+    // Arg parsing for the micro-benchmarks, which also run without any interaction
+
+    if (argc >= 2) {
+        for (uint32_t curr = 1; curr < argc; curr++) {
+            if (strcmp(argv[curr], "-bench") == 0) {
+
+                osaka_object_typ bench_type = SIMPLE;
+                uint32_t bench_genome_len = 0;
+                uint32_t bench_pop_size = 0;
+                bool bench_saving = false;
+
+                for (uint32_t opt = 1; opt < argc; opt++) {
+                    if (strcmp(argv[opt], "-bench_type") == 0 && opt + 1 < argc) {
+                        bench_type = (osaka_object_typ) (atoi(argv[++opt]) - 1);
+                    }
+                    else if (strcmp(argv[opt], "-bench_genome") == 0 && opt + 1 < argc) {
+                        bench_genome_len = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_population") == 0 && opt + 1 < argc) {
+                        bench_pop_size = atoi(argv[++opt]);
+                    }
+                    else if (strcmp(argv[opt], "-bench_save") == 0) {
+                        bench_saving = true;
+                    }
+                }
+
+                if (bench_type < 0 || bench_type >= MAXTYPE) {
+                    printf("error: -bench_type must be between 1 and %d [file:\'%s\',line:%d]\n", MAXTYPE, __FILE__, __LINE__);
+                    exit(0);
+                }
+                if (bench_genome_len == 1 || bench_genome_len == 2 || bench_pop_size == 1) {
+                    printf("error: benchmarks need a genome length of at least 3 and a population of at least 2 [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+                    exit(0);
+                }
+
+                bench_result_str* results = malloc(sizeof(bench_result_str) * BENCH_MAX_RESULTS);
+                assert(results != NULL);
+
+                uint32_t num_results = bench_suite(bench_type, bench_genome_len, bench_pop_size, results);
+                uint32_t regressions = bench_report(stdout, results, num_results, BENCH_BASELINE_FILE);
+
+                if (bench_saving) {
+                    bench_save(results, num_results, BENCH_BASELINE_FILE);
+                    regressions = 0;
+                }
+
+                free(results);
+                exit(regressions > 0 ? 1 : 0);
+
+            }
+        }
+    }
+
+    // Arg parsing for job specs and job queues, which run without any interaction
+
+    if (argc >= 2) {
+
+        uint32_t num_jobs = 0;
+        uint32_t failed = 0;
+
+        for (uint32_t curr = 1; curr < argc; curr++) {
+            if (strcmp(argv[curr], "-job") == 0 && curr + 1 < argc) {
+
+                job_str job;
+
+                if (job_load(&job, argv[++curr])) {
+                    job_run(&job, stdout);
+                }
+                else {
+                    printf("{\"job\":\"%s\",\"status\":\"invalid\"}\n", job.name);
+                    failed++;
+                }
+
+                job_free(&job);
+                num_jobs++;
+
+            }
+            else if (strcmp(argv[curr], "-queue") == 0 && curr + 1 < argc) {
+                failed += job_queue(argv[++curr], stdout);
+                num_jobs++;
+            }
+        }
+
+        if (num_jobs > 0) {
+            exit(failed > 0 ? 1 : 0);
+        }
+
+    }
+
     // Parsing and interaction with users begin
 
     printf("\n--------------------------------------------------------- Launching Project Shackleton ---------------------------------------------------------\n\n\n");
@@ -108,7 +299,8 @@ int main(uint32_t argc, char* argv[]) {
     printf("\t[3] percent_crossover = %d\t\t-- The percent chance that any one individual will have crossover applied to it\n", percent_crossover);
     printf("\t[4] percent_mutation = %d\t\t-- The percent chance that any one individual will have mutation applied to it\n", percent_mutation);
     printf("\t[5] tournament_size = %d\t\t\t-- The number of individuals in each tournament for selection\n", tournament_size);
-    printf("\t[6] visualization = %s\t\t-- Whether or not visualization of the evolution process is enabled\n\n", visualization ? "true" : "false");
+    printf("\t[6] visualization = %s\t\t-- Whether or not visualization of the evolution process is enabled\n", visualization ? "true" : "false");
+    printf("\t[7] mutation_operator = %s\t-- Whether mutation redraws every parameter of a unit (all_params) or only one (single_param)\n\n", mutation_operator);
 
     // Core arg parsing ---------------------------------------------------------------
 
@@ -116,14 +308,15 @@ int main(uint32_t argc, char* argv[]) {
         for (uint32_t curr = 1; curr < argc; curr++) {
             if (strcmp(argv[curr], "-parameters_file") == 0) {
                 printf("Using a parameters file has been chosen, any changes to parameters will be taken from the src/files/parameters.txt\n\n");
-                set_params_from_file(&num_generations, &num_population_size, &percent_crossover, &percent_mutation, &tournament_size, &visualization);
+                set_params_from_file(&num_generations, &num_population_size, &percent_crossover, &percent_mutation, &tournament_size, &visualization, mutation_operator);
                 printf("\nHere are the values being used for this evolutionary run:\n");
                 printf("\t[1] num_generations = %d\n", num_generations);
                 printf("\t[2] num_population_size = %d\n", num_population_size);
                 printf("\t[3] percent_crossover = %d\n", percent_crossover);
                 printf("\t[4] percent_mutation = %d\n", percent_mutation);
                 printf("\t[5] tournament_size = %d\n", tournament_size);
-                printf("\t[6] visualization = %s\n\n", visualization ? "true" : "false");
+                printf("\t[6] visualization = %s\n", visualization ? "true" : "false");
+                printf("\t[7] mutation_operator = %s\n\n", mutation_operator);
 
                 using_params_file = true;
             }
@@ -131,7 +324,28 @@ int main(uint32_t argc, char* argv[]) {
     }
     if (argc >= 2) {
         for (uint32_t curr = 1; curr < argc; curr++) {
-            if (strcmp(argv[curr], "-llvm_optimize") == 0) {
+            if (strcmp(argv[curr], "-llvm_suite") == 0 && curr + 1 < argc && !llvm_optimizing) {
+
+                if (!suite_load(&llvm_suite, argv[++curr])) {
+                    printf("The benchmark suite %s is not valid.\n\nAborting code\n\n", argv[curr]);
+                    exit(1);
+                }
+
+                printf("You are using the llvm-integrated optimization tool in Shackleton over the %u benchmark(s) of %s\n\n", llvm_suite.num_benchmarks, argv[curr]);
+
+                strcpy(test_file, "");
+                src_files = NULL;
+                num_src_files = 0;
+
+                suite_enable(&llvm_suite);
+                llvm_optimizing = true;
+
+            }
+        }
+    }
+    if (argc >= 2) {
+        for (uint32_t curr = 1; curr < argc; curr++) {
+            if (strcmp(argv[curr], "-llvm_optimize") == 0 && !suite_enabled()) {
 
                 strcpy(test_file, "");
 
@@ -166,11 +380,40 @@ int main(uint32_t argc, char* argv[]) {
             }
         }
     }
+    if (argc >= 2) {
+        for (uint32_t curr = 1; curr < argc; curr++) {
+            if (strcmp(argv[curr], "-aarch64") == 0) {
+
+                if (!aarch64_available()) {
+                    printf("Evaluating on AArch64 needs %s and %s on the PATH.\n\nAborting code\n\n", AARCH64_CC, AARCH64_EMULATOR);
+                    exit(1);
+                }
+
+                printf("ASSEMBLER individuals will be evaluated on AArch64 under %s, one launch per generation\n\n", AARCH64_EMULATOR);
+                aarch64_enable();
+
+            }
+        }
+    }
     if (argc >= 2) {
         for (uint32_t curr = 1; curr < argc; curr++) {
             if (strcmp(argv[curr], "-cache") == 0) {
                 caching = true;
             }
+            if (strcmp(argv[curr], "-cache_binary") == 0) {
+                caching = true;
+                runlog_set_format(RUNLOG_BINARY);
+            }
+            if (strcmp(argv[curr], "-async_output") == 0) {
+                async_output = true;
+            }
+            if (strcmp(argv[curr], "-async_output_drop") == 0) {
+                async_output = true;
+                output_policy = OUTPUT_DROP;
+            }
+            if (strcmp(argv[curr], "-trace") == 0) {
+                tracing = true;
+            }
         }
     }
 
@@ -183,7 +426,7 @@ int main(uint32_t argc, char* argv[]) {
 
         if (strcmp(answer, "y") == 0 || strcmp(answer, "Y") == 0) {
             while (strcmp(answer, "y") == 0 || strcmp(answer, "Y") == 0) {
-                printf("\n\nWhich parameter from the above would you like to change? 1/2/3/4/5/6: ");
+                printf("\n\nWhich parameter from the above would you like to change? 1/2/3/4/5/6/7: ");
                 scanf("%s", answer);
 
                 if (strcmp(answer, "1") == 0) {
@@ -227,8 +470,13 @@ int main(uint32_t argc, char* argv[]) {
                     }
                     printf("\nVisualization has been set to the requested value of %s\n\n", visualization ? "true" : "false");
                 }
+                else if (strcmp(answer, "7") == 0) {
+                    printf("\nPlease specify the mutation operator to be used (all_params/single_param): ");
+                    scanf("%19s", mutation_operator);
+                    printf("\nmutation_operator has been set to the requested value of %s\n\n", mutation_operator);
+                }
                 else {
-                    printf("The input was not a valid option, please only choose a value between 1 and 6\n");
+                    printf("The input was not a valid option, please only choose a value between 1 and 7\n");
                 }
 
                 printf("Would you still like to change any settings? y/n: ");
@@ -286,14 +534,26 @@ int main(uint32_t argc, char* argv[]) {
 
     // Initializing vars --------------------------------------------------------------
 
-    uint32_t temp = 0;
     srand(time(0));
+    mutation_set_operator(mutation_operator_from_name(mutation_operator));
 
     // --------------------------------------------------------------------------------
 
     // Executing Code -----------------------------------------------------------------
 
+    if (async_output) {
+        output_start(OUTPUT_DEFAULT_CAPACITY, output_policy);
+    }
+    if (tracing) {
+        trace_start(TRACE_DEFAULT_FILE);
+    }
+
     evolution_basic_crossover_and_mutation_with_replacement(num_generations, num_population_size, 10, tournament_size, percent_mutation, percent_crossover, curr_type, visualization, test_file, src_files, num_src_files, caching);
+
+    if (tracing) {
+        trace_stop();
+        printf("\nTimeline of the run written to %s\n", TRACE_DEFAULT_FILE);
+    }
     
     // --------------------------------------------------------------------------------
 
@@ -314,6 +574,19 @@ int main(uint32_t argc, char* argv[]) {
         free(src_files);
     }
 
+    if (suite_enabled()) {
+        suite_disable();
+        suite_free(&llvm_suite);
+    }
+
+    if (async_output) {
+        uint64_t dropped = output_dropped();
+        output_stop();
+        if (dropped > 0) {
+            printf("%lu output record(s) were dropped by the background writer\n", (unsigned long) dropped);
+        }
+    }
+
     // --------------------------------------------------------------------------------
 
     printf("\n------------------------------------------------------ Run of Project Shackleton complete ------------------------------------------------------\n\n");
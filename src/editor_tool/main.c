@@ -46,7 +46,7 @@ uint32_t main(uint32_t argc, char* argv[]) {
     }
     
     // copy over argv[1] into its own var
-    char name[strlen(argv[1])];
+    char name[strlen(argv[1]) + 1];
     strcpy(name, argv[1]);
 
     char filename[100];
@@ -520,199 +520,237 @@ void create_macros(char* name, char* macros, cJSON* root) {
 /*
  * NAME
  *
- *   create_uid
+ *   create_is_compact
  *
  * DESCRIPTION
  *
- *  Helper to create a new uid method
+ *  Whether the object of a params file asks for a compact module,
+ *  one flat struct per object with the valid values of its
+ *  constrained params in static const tables
  *
  * PARAMETERS
  *
- *  char* name
- *  char* methods
+ *  cJSON* root
  *
  * RETURN
  *
- *  none
+ *  bool
  *
  * EXAMPLE
  *
- * create_uid(name, methods)
+ *  bool compact = create_is_compact(params_json);
  *
  * SIDE-EFFECT
  *
- *  alters the "methods" parameter
+ *  none
  *
  */
 
-void create_uid(char* name, char* methods) {
+bool create_is_compact(cJSON* root) {
 
-    // create_uid is always of a constant form
-    strcpy(methods, "uint32_t ");
-    strcat(methods, name);
-    strcat(methods, "_uid(void) {\n\n    static uint32_t uid=0;\n    return ++uid;\n\n}\n\n");
+    cJSON *object = cJSON_GetObjectItem(root, "object");
+    cJSON *compact = cJSON_GetObjectItem(object, "compact");
+
+    // like has_valid_values, compact is a "true" or "false" string, false if missing
+    return compact != NULL && compact->valuestring != NULL && strcmp(compact->valuestring, "true") == 0;
 
 }
 
 /*
  * NAME
  *
- *   create_valid_value_methods
+ *   __create_index_bits
  *
  * DESCRIPTION
  *
- *  For any new param that has a set list of valid values,
- *  it creates and initializes that list within the method
+ *  Number of bits of the index field of a constrained param
+ *  in a compact object, enough to hold its largest index
  *
  * PARAMETERS
  *
- *  char* name
- *  char* methods
- *  cJSON* root
+ *  uint32_t num_values
  *
  * RETURN
  *
- *  none
+ *  uint32_t
  *
  * EXAMPLE
  *
- * create_valid_value_methods(name, methods, params_json)
+ *  uint32_t bits = __create_index_bits(11);
  *
  * SIDE-EFFECT
  *
- *  alters the "methods" parameter
+ *  none
  *
  */
 
-void create_valid_value_methods(char* name, char* methods, cJSON* root) {
-
-    // create initial char variables and initialize
-    char curr_num[2];
-    char num_valid_values_str[3];
-    char curr_num2[3];
-    char valueint_str[3];
-    strcpy(curr_num, "");
-    strcpy(num_valid_values_str, "");
-    strcpy(curr_num2, "");
-    strcpy(valueint_str, "");
-
-    // get top-level cJSON objects
-    cJSON *new_object = cJSON_GetObjectItem(root, "object");
-    cJSON *new_params = cJSON_GetObjectItem(root, "params");
+uint32_t __create_index_bits(uint32_t num_values) {
 
-    // declare other needed variables
-    char* object_name = cJSON_GetObjectItem(new_object, "name")->valuestring;
-    uint32_t params_count = cJSON_GetArraySize(new_params);
+    uint32_t bits = 1;
 
-    for (uint32_t j = 0; j < params_count; j++) {
+    while (bits < 32 && ((num_values - 1) >> bits) != 0) {
+        bits++;
+    }
 
-        cJSON *new_param = cJSON_GetArrayItem(new_params, j);
+    return bits;
 
-        char* param_name = cJSON_GetObjectItem(new_param, "name")->valuestring;
-        char* param_type = cJSON_GetObjectItem(new_param, "type")->valuestring;
-        char* param_constrained = cJSON_GetObjectItem(new_param, "has_valid_values")->valuestring;
+}
 
-        if (strcmp(param_constrained, "true") == 0 ) {
+/*
+ * NAME
+ *
+ *   __create_param_number
+ *
+ * DESCRIPTION
+ *
+ *  Value of an optional number of a param, such as its
+ *  step or weight, or the fallback when the param has none
+ *
+ * PARAMETERS
+ *
+ *  cJSON* param
+ *  char* key
+ *  int64_t fallback
+ *
+ * RETURN
+ *
+ *  int64_t
+ *
+ * EXAMPLE
+ *
+ *  int64_t weight = __create_param_number(param, "weight", 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
 
-            cJSON *valid_values = cJSON_GetObjectItem(new_param, "values");
+int64_t __create_param_number(cJSON* param, char* key, int64_t fallback) {
 
-            uint32_t num_valid_values = cJSON_GetArraySize(valid_values);
-            sprintf(num_valid_values_str, "%d", num_valid_values);
-            char method[20000];
-            char temp[10000];
-            strcpy(temp, "");
-            char full_macro_name[200];
-            char* macro_name = cJSON_GetObjectItem(new_param, "macro_name")->valuestring;
-            strupr(macro_name);
+    cJSON* number = cJSON_GetObjectItem(param, key);
 
-            // create starting string for new valid values method
-            strcpy(method, "void ");
-            strcat(method, name);
-            strcat(method, "_");
-            strcat(method, param_name);
-            strcat(method, "_set_valid_values(object_");
-            strcat(method, name);
-            strcat(method, "_str* o) {\n\n\t");
-            strcat(method, param_type);
-            strcat(method, "* values = malloc(sizeof(");
-            strcat(method, param_type);
-            strcat(method, ") * ");
-            strcat(method, num_valid_values_str);
-            strcat(method, ");\n");
+    if (number == NULL) {
+        return fallback;
+    }
 
-            // for every valid value, create an assignment to a new index
-            // in the valud values array
-            for (uint32_t k = 0; k < num_valid_values; k++) {
+    if (!cJSON_IsNumber(number)) {
+        printf("error: %s of param %s must be a number [file:'%s',line:%d]\n", key, cJSON_GetObjectItem(param, "name")->valuestring, __FILE__, __LINE__);
+        exit(0);
+    }
 
-                sprintf(curr_num2, "%d", k);
-                strcat(temp, "\tvalues[");
-                strcat(temp, curr_num2);
+    return (int64_t) number->valuedouble;
 
-                // need to determine if the var is an int or string type
-                if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+}
 
-                    cJSON* single_value = cJSON_GetArrayItem(valid_values, k);
+/*
+ * NAME
+ *
+ *   __create_param_weight
+ *
+ * DESCRIPTION
+ *
+ *  How often the mutate method of a param is picked relative
+ *  to the other params of its object, 1 when it has no weight
+ *
+ * PARAMETERS
+ *
+ *  cJSON* param
+ *
+ * RETURN
+ *
+ *  uint32_t
+ *
+ * EXAMPLE
+ *
+ *  uint32_t weight = __create_param_weight(param);
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the weight is negative or above UINT16_MAX
+ *
+ */
 
-                    uint32_t single_valueint = cJSON_GetObjectItem(single_value, "value")->valueint;
-                    sprintf(valueint_str, "%d", single_valueint);
+uint32_t __create_param_weight(cJSON* param) {
 
-                    strcat(temp, "] = ");
-                    strcat(temp, valueint_str);
-                    strcat(temp, ";\n");
+    int64_t weight = __create_param_number(param, "weight", 1);
 
-                }
-                else {
+    if (weight < 0 || weight > UINT16_MAX) {
+        printf("error: weight of param %s must be between 0 and %d [file:'%s',line:%d]\n", cJSON_GetObjectItem(param, "name")->valuestring, UINT16_MAX, __FILE__, __LINE__);
+        exit(0);
+    }
 
-                    cJSON *single_str = cJSON_GetArrayItem(valid_values, k);
+    return (uint32_t) weight;
 
-                    strcat(method, "] = \"");
-                    strcat(method, cJSON_GetObjectItem(single_str, "value")->valuestring);
-                    strcat(method, "\"\n");
+}
 
-                }
+/*
+ * NAME
+ *
+ *   __create_param_bounds
+ *
+ * DESCRIPTION
+ *
+ *  Smallest and largest value of an integer param. A param with
+ *  a min or a max is ranged, and the bound it leaves out is the
+ *  limit of its type. Without either the param keeps the full
+ *  range of its type and the generated code is unchanged
+ *
+ * PARAMETERS
+ *
+ *  cJSON* param
+ *  int64_t* min
+ *  int64_t* max
+ *
+ * RETURN
+ *
+ *  bool - true if the param declares a min or a max
+ *
+ * EXAMPLE
+ *
+ *  bool ranged = __create_param_bounds(param, &min, &max);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets min and max, exits if the range is empty or does not fit the type
+ *
+ */
 
-            }
+bool __create_param_bounds(cJSON* param, int64_t* min, int64_t* max) {
 
-            // prepare full macro name
-            strcpy(full_macro_name, "");
-            strcat(full_macro_name, name);
-            strcat(full_macro_name, "_");
-            strcat(full_macro_name, param_name);
-            strupr(full_macro_name);
+    char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+    bool is_int = strcmp(param_type, "int") == 0;
 
-            // append final lines to new method, move on to next method
-            strcat(method, temp);
-            strcat(method, "\n\t");
-            strcat(method, full_macro_name);
-            strcat(method, "_VALID_VALUES(o) = values;\n\t");
-            strcat(method, full_macro_name);
-            strcat(method, "_CONSTRAINED(o) = true;\n\t");
-            strcat(method, full_macro_name);
-            strcat(method, "_NUM_VALID_VALUES(o) = ");
-            strcat(method, num_valid_values_str);
-            strcat(method, ";\n\n\treturn;\n\n}\n\n");
-            strcat(methods, method);
+    int64_t lowest = is_int ? INT32_MIN : 0;
+    int64_t highest = is_int ? INT32_MAX : UINT32_MAX;
 
-        }
+    *min = __create_param_number(param, "min", lowest);
+    *max = __create_param_number(param, "max", highest);
 
+    if (*min < lowest || *max > highest || *min > *max) {
+        printf("error: range of param %s is empty or does not fit its type [file:'%s',line:%d]\n", cJSON_GetObjectItem(param, "name")->valuestring, __FILE__, __LINE__);
+        exit(0);
     }
 
+    return cJSON_GetObjectItem(param, "min") != NULL || cJSON_GetObjectItem(param, "max") != NULL;
+
 }
 
 /*
  * NAME
  *
- *   create_createobject
+ *   __create_offset
  *
  * DESCRIPTION
  *
- *  Helper to create a new createobject method
+ *  Appends the signed offset added to a param shifted by the
+ *  start of its range, nothing for an offset of 0. The offset
+ *  is a long long so that unsigned fields do not wrap around
  *
  * PARAMETERS
  *
- *  char* name
  *  char* methods
- *  cJSON* params_json
+ *  int64_t offset
  *
  * RETURN
  *
@@ -720,7 +758,7 @@ void create_valid_value_methods(char* name, char* methods, cJSON* root) {
  *
  * EXAMPLE
  *
- * create_createobject(name, methods, params_json)
+ *  __create_offset(methods, -min);
  *
  * SIDE-EFFECT
  *
@@ -728,57 +766,1166 @@ void create_valid_value_methods(char* name, char* methods, cJSON* root) {
  *
  */
 
-void create_createobject(char* name, char* methods, cJSON* params_json) {
+void __create_offset(char* methods, int64_t offset) {
 
-    // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
-    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+    char text[24];
 
-    // prepare other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
-    uint32_t num_params = cJSON_GetArraySize(params);
+    if (offset > 0) {
+        sprintf(text, " + %lldLL", (long long) offset);
+        strcat(methods, text);
+    }
+    else if (offset < 0) {
+        sprintf(text, " - %lldLL", -(long long) offset);
+        strcat(methods, text);
+    }
 
-    // append beginning of createobject method to master methods string
-    strcat(methods, "object_");
-    strcat(methods, name);
-    strcat(methods, "_str *");
-    strcat(methods, name);
-    strcat(methods, "_createobject(void) {\n\n    object_");
-    strcat(methods, name);
-    strcat(methods, "_str *o;\n");
-    
-    // for each param, create a new variable declaration
-    for (uint32_t i = 0; i < num_params; i++) {
+}
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+/*
+ * NAME
+ *
+ *   __create_random_scalar
+ *
+ * DESCRIPTION
+ *
+ *  Appends the rand() draw of an unconstrained integer param
+ *  in randomizeobject, spread over its range when it has one
+ *
+ * PARAMETERS
+ *
+ *  char* methods
+ *  cJSON* param
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __create_random_scalar(methods, param);
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
 
-        strcat(methods, "\t");
-        strcat(methods, name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, " *");
-        strcat(methods, name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o;\n");
+void __create_random_scalar(char* methods, cJSON* param) {
 
+    int64_t min, max;
+
+    if (!__create_param_bounds(param, &min, &max)) {
+        strcat(methods, "(o) = rand() / (RAND_MAX + 1.0);\n\n");
+        return;
     }
 
-    // add malloc line for entire object
-    strcat(methods, "\n    o = malloc(sizeof(object_");
-    strcat(methods, name);
-    strcat(methods, "_str));\n");
+    char text[100];
 
-    // for each param, create a new malloc line
-    for (uint32_t i = 0; i < num_params; i++) {
+    if (min == 0) {
+        sprintf(text, "(o) = (int64_t) (%lld.0 * (rand() / (RAND_MAX + 1.0)));\n\n", (long long) (max + 1));
+    }
+    else {
+        sprintf(text, "(o) = %lld + (int64_t) (%lld.0 * (rand() / (RAND_MAX + 1.0)));\n\n", (long long) min, (long long) (max - min + 1));
+    }
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+    strcat(methods, text);
 
-        strcat(methods, "\t");
-        strcat(methods, object_name);
-        strcat(methods, "_");
+}
+
+/*
+ * NAME
+ *
+ *   create_compact_type
+ *
+ * DESCRIPTION
+ *
+ *  Creates the new object type of a compact module, one flat
+ *  struct holding unconstrained params by value and constrained
+ *  params as a bit field indexing a static const table of their
+ *  valid values, which is created after the struct
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* object
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_type(name, object, params_json);
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "object" parameter, exits if a param cannot be stored in the struct
+ *
+ */
+
+void create_compact_type(char* name, char* object, cJSON* root) {
+
+    // get top-level cJSON objects
+    cJSON *new_params = cJSON_GetObjectItem(root, "params");
+
+    // create top-level variables for use in for loops
+    uint32_t params_count = cJSON_GetArraySize(new_params);
+
+    // initialize object string with starting text
+    strcpy(object, "// the object is one flat struct, constrained params kept as an index into their valid values\n");
+    strcat(object, "typedef struct object_");
+    strcat(object, name);
+    strcat(object, "_str {\n");
+
+    for (uint32_t j = 0; j < params_count; j++) {
+
+        // get cJSON object specific to this param
+        cJSON *new_param = cJSON_GetArrayItem(new_params, j);
+
+        char* param_name = cJSON_GetObjectItem(new_param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(new_param, "type")->valuestring;
+        char* constrained = cJSON_GetObjectItem(new_param, "has_valid_values")->valuestring;
+
+        // constrained params only need enough bits to index their valid values
+        if (strcmp(constrained, "true") == 0) {
+
+            char bits[4];
+            sprintf(bits, "%d", __create_index_bits(cJSON_GetArraySize(cJSON_GetObjectItem(new_param, "values"))));
+
+            strcat(object, "\tuint32_t ");
+            strcat(object, param_name);
+            strcat(object, "_index : ");
+            strcat(object, bits);
+            strcat(object, ";\n");
+
+        }
+        else if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+
+            strcat(object, "\t");
+            strcat(object, param_type);
+            strcat(object, " ");
+            strcat(object, param_name);
+            strcat(object, ";\n");
+
+        }
+        else {
+
+            // free form values such as strings would need an allocation of their own
+            printf("error: param %s of a compact object needs valid values or an integer type [file:'%s',line:%d]\n", param_name, __FILE__, __LINE__);
+            exit(0);
+
+        }
+
+    }
+
+    // add closing text of the new struct type
+    strcat(object, "} object_");
+    strcat(object, name);
+    strcat(object, "_str;\n\n");
+
+    // the valid values of each constrained param are shared by every object
+    for (uint32_t j = 0; j < params_count; j++) {
+
+        cJSON *new_param = cJSON_GetArrayItem(new_params, j);
+
+        char* param_name = cJSON_GetObjectItem(new_param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(new_param, "type")->valuestring;
+        char* constrained = cJSON_GetObjectItem(new_param, "has_valid_values")->valuestring;
+
+        if (strcmp(constrained, "true") != 0) {
+            continue;
+        }
+
+        cJSON *valid_values = cJSON_GetObjectItem(new_param, "values");
+        uint32_t num_valid_values = cJSON_GetArraySize(valid_values);
+
+        strcat(object, "static const ");
+        strcat(object, param_type);
+        strcat(object, " ");
+        strcat(object, name);
+        strcat(object, "_");
+        strcat(object, param_name);
+        strcat(object, "_values[] = { ");
+
+        for (uint32_t k = 0; k < num_valid_values; k++) {
+
+            cJSON *single_value = cJSON_GetObjectItem(cJSON_GetArrayItem(valid_values, k), "value");
+
+            if (k != 0) {
+                strcat(object, ", ");
+            }
+
+            // need to determine if the var is an int or string type
+            if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+
+                char valueint_str[12];
+                sprintf(valueint_str, "%d", single_value->valueint);
+                strcat(object, valueint_str);
+
+            }
+            else {
+
+                strcat(object, "\"");
+                strcat(object, single_value->valuestring);
+                strcat(object, "\"");
+
+            }
+
+        }
+
+        strcat(object, " };\n\n");
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   create_compact_macros
+ *
+ * DESCRIPTION
+ *
+ *  Creates the macros for getting and setting each of the
+ *  parameters of a compact object. The value of a constrained
+ *  param is read through its table, and set through its index
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* macros
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_macros(name, macros, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "macros" parameter
+ *
+ */
+
+void create_compact_macros(char* name, char* macros, cJSON* root) {
+
+    cJSON *json_params = cJSON_GetObjectItem(root, "params");
+
+    uint32_t params_count = cJSON_GetArraySize(json_params);
+
+    strcpy(macros, "// Auto-generated macros: ----------------------------------------------\n\n");
+
+    for (uint32_t i = 0; i < params_count; i++) {
+
+        // get cJSON object for this param
+        cJSON *param = cJSON_GetArrayItem(json_params, i);
+
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char* param_has_valid_values = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        strupr(param_macro_name);
+
+        // name of the table of valid values and prefix of every macro
+        char table[200];
+        char full_macro_name[200];
+
+        strcpy(table, name);
+        strcat(table, "_");
+        strcat(table, param_name);
+        strcat(table, "_values");
+
+        strcpy(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strcat(full_macro_name, "_");
+        strupr(full_macro_name);
+
+        if (strcmp(param_has_valid_values, "true") == 0) {
+
+            // value is looked up in the table, index is the field itself
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, param_macro_name);
+            strcat(macros, "(s) ");
+            strcat(macros, table);
+            strcat(macros, "[s->");
+            strcat(macros, param_name);
+            strcat(macros, "_index]\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, param_macro_name);
+            strcat(macros, "_INDEX(s) s->");
+            strcat(macros, param_name);
+            strcat(macros, "_index\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "CONSTRAINED(s) true\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "VALID_VALUES(s) ");
+            strcat(macros, table);
+            strcat(macros, "\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "NUM_VALID_VALUES(s) (sizeof(");
+            strcat(macros, table);
+            strcat(macros, ") / sizeof(");
+            strcat(macros, param_type);
+            strcat(macros, "))\n\n");
+
+        }
+        else {
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, param_macro_name);
+            strcat(macros, "(s) s->");
+            strcat(macros, param_name);
+            strcat(macros, "\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "CONSTRAINED(s) false\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "VALID_VALUES(s) NULL\n");
+
+            strcat(macros, "#define ");
+            strcat(macros, full_macro_name);
+            strcat(macros, "NUM_VALID_VALUES(s) 0\n\n");
+
+        }
+
+    }
+
+    // epilogue
+    strcat(macros, "// ----------------------------------------------------------------------\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_uid
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new uid method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_uid(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_uid(char* name, char* methods) {
+
+    // create_uid is always of a constant form
+    strcpy(methods, "uint32_t ");
+    strcat(methods, name);
+    strcat(methods, "_uid(void) {\n\n    static _Atomic uint32_t uid=0;\n    return atomic_fetch_add(&uid, 1) + 1;\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_valid_value_methods
+ *
+ * DESCRIPTION
+ *
+ *  For any new param that has a set list of valid values,
+ *  it creates and initializes that list within the method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_valid_value_methods(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_valid_value_methods(char* name, char* methods, cJSON* root) {
+
+    // create initial char variables and initialize
+    char curr_num[2];
+    char num_valid_values_str[3];
+    char curr_num2[3];
+    char valueint_str[3];
+    strcpy(curr_num, "");
+    strcpy(num_valid_values_str, "");
+    strcpy(curr_num2, "");
+    strcpy(valueint_str, "");
+
+    // get top-level cJSON objects
+    cJSON *new_object = cJSON_GetObjectItem(root, "object");
+    cJSON *new_params = cJSON_GetObjectItem(root, "params");
+
+    // declare other needed variables
+    char* object_name = cJSON_GetObjectItem(new_object, "name")->valuestring;
+    uint32_t params_count = cJSON_GetArraySize(new_params);
+
+    for (uint32_t j = 0; j < params_count; j++) {
+
+        cJSON *new_param = cJSON_GetArrayItem(new_params, j);
+
+        char* param_name = cJSON_GetObjectItem(new_param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(new_param, "type")->valuestring;
+        char* param_constrained = cJSON_GetObjectItem(new_param, "has_valid_values")->valuestring;
+
+        if (strcmp(param_constrained, "true") == 0 ) {
+
+            cJSON *valid_values = cJSON_GetObjectItem(new_param, "values");
+
+            uint32_t num_valid_values = cJSON_GetArraySize(valid_values);
+            sprintf(num_valid_values_str, "%d", num_valid_values);
+            char method[20000];
+            char temp[10000];
+            strcpy(temp, "");
+            char full_macro_name[200];
+            char* macro_name = cJSON_GetObjectItem(new_param, "macro_name")->valuestring;
+            strupr(macro_name);
+
+            // create starting string for new valid values method
+            strcpy(method, "void ");
+            strcat(method, name);
+            strcat(method, "_");
+            strcat(method, param_name);
+            strcat(method, "_set_valid_values(object_");
+            strcat(method, name);
+            strcat(method, "_str* o) {\n\n\t");
+            strcat(method, param_type);
+            strcat(method, "* values = malloc(sizeof(");
+            strcat(method, param_type);
+            strcat(method, ") * ");
+            strcat(method, num_valid_values_str);
+            strcat(method, ");\n");
+
+            // for every valid value, create an assignment to a new index
+            // in the valud values array
+            for (uint32_t k = 0; k < num_valid_values; k++) {
+
+                sprintf(curr_num2, "%d", k);
+                strcat(temp, "\tvalues[");
+                strcat(temp, curr_num2);
+
+                // need to determine if the var is an int or string type
+                if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+
+                    cJSON* single_value = cJSON_GetArrayItem(valid_values, k);
+
+                    uint32_t single_valueint = cJSON_GetObjectItem(single_value, "value")->valueint;
+                    sprintf(valueint_str, "%d", single_valueint);
+
+                    strcat(temp, "] = ");
+                    strcat(temp, valueint_str);
+                    strcat(temp, ";\n");
+
+                }
+                else {
+
+                    cJSON *single_str = cJSON_GetArrayItem(valid_values, k);
+
+                    strcat(method, "] = \"");
+                    strcat(method, cJSON_GetObjectItem(single_str, "value")->valuestring);
+                    strcat(method, "\"\n");
+
+                }
+
+            }
+
+            // prepare full macro name
+            strcpy(full_macro_name, "");
+            strcat(full_macro_name, name);
+            strcat(full_macro_name, "_");
+            strcat(full_macro_name, param_name);
+            strupr(full_macro_name);
+
+            // append final lines to new method, move on to next method
+            strcat(method, temp);
+            strcat(method, "\n\t");
+            strcat(method, full_macro_name);
+            strcat(method, "_VALID_VALUES(o) = values;\n\t");
+            strcat(method, full_macro_name);
+            strcat(method, "_CONSTRAINED(o) = true;\n\t");
+            strcat(method, full_macro_name);
+            strcat(method, "_NUM_VALID_VALUES(o) = ");
+            strcat(method, num_valid_values_str);
+            strcat(method, ";\n\n\treturn;\n\n}\n\n");
+            strcat(methods, method);
+
+        }
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   create_createobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new createobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_createobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_createobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // prepare other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // append beginning of createobject method to master methods string
+    strcat(methods, "object_");
+    strcat(methods, name);
+    strcat(methods, "_str *");
+    strcat(methods, name);
+    strcat(methods, "_createobject(void) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o;\n");
+    
+    // for each param, create a new variable declaration
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\t");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, " *");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o;\n");
+
+    }
+
+    // add malloc line for entire object
+    strcat(methods, "\n    o = malloc(sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n");
+
+    // for each param, create a new malloc line
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\t");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o = malloc(sizeof(");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "));\n");
+
+    }
+
+    // need assert statement for the object itself
+    strcat(methods, "\n\tassert(o!=NULL);\n");
+
+    // for each param, create a new assert statment to check not NULL
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\tassert(");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o!=NULL);\n");
+
+    }
+
+    // newline only for formatting reasons
+    strcat(methods, "\n");
+
+    // for each param, need line setting struct of top-level
+    // object to the declared struct using a macro
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        char full_macro_name[200];
+        strcpy(full_macro_name, "");
+        strcat(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strupr(full_macro_name);
+
+        strcat(methods, "\t");
+        strcat(methods, full_macro_name);
+        strcat(methods, "_STRUCT(o) = ");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o;\n");
+
+    }
+
+    // newline only for formatting reasons
+    strcat(methods, "\n");
+
+    // for each param, either create call to their set_valid_values function
+    // or set each item in its struct using individual macros
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        strupr(param_macro_name);
+
+        char full_macro_name[100];
+        strcpy(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strupr(full_macro_name);
+
+        strcat(methods, "\t");
+        strcat(methods, full_macro_name);
+        strcat(methods, "_");
+        strcat(methods, param_macro_name);
+
+        // default value for not being set is different depending on type
+        if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+            strcat(methods, "(o) = -1;\n");
+        }
+        else {
+            strcat(methods, "(o) = \"not set\";\n");
+        }
+
+        // constrained with valid values, can use set_valid_values method
+        if (strcmp(constrained, "true") == 0) {
+
+            strcat(methods, "\t");
+            strcat(methods, full_macro_name);
+            strcat(methods, "_");
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o) = -1;\n");
+
+            strcat(methods, "\t");
+            strcat(methods, name);
+            strcat(methods, "_");
+            strcat(methods, param_name);
+            strcat(methods, "_set_valid_values(o);\n\n");
+
+        }
+        // no valid values, set everything manually in this method
+        else {
+
+            strcat(methods, "\t");
+            strcat(methods, full_macro_name);
+            strcat(methods, "_CONSTRAINED(o) = false;\n");
+
+            strcat(methods, "\t");
+            strcat(methods, full_macro_name);
+            strcat(methods, "_VALID_VALUES(o) = NULL;\n");
+
+            strcat(methods, "\t");
+            strcat(methods, full_macro_name);
+            strcat(methods, "_NUM_VALID_VALUES(o) = 0;\n\n");
+
+        }
+
+    }
+
+    // return the new object created
+    strcat(methods, "\treturn o;\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_randomizeobject
+ *
+ * DESCRIPTION
+ *
+ *  Changes all parameters in an object to random values,
+ *  either from the list of valid values or in a completely
+ *  random way if that list does not apply
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_randomizeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_randomizeobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_randomizeobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n");
+    
+    // each param gets its own print statement
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char full_macro[1000];
+
+        // add full macro name, needs to be separate so it can be capitalized
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        char curr_num[2];
+        itoa(i, curr_num, 10);
+
+        if (strcmp(constrained, "true") == 0) {
+
+            strcat(methods, "\tuint32_t num_valid_values");
+            strcat(methods, curr_num);
+            strcat(methods, " = ");
+            strcat(methods, full_macro);
+            strcat(methods, "NUM_VALID_VALUES(o);\n\tuint32_t new_index");
+            strcat(methods, curr_num);
+            strcat(methods, " = (uint32_t) (num_valid_values");
+            strcat(methods, curr_num);
+            strcat(methods, " * (rand() / (RAND_MAX + 1.0)));\n\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o) = new_index");
+            strcat(methods, curr_num);
+            strcat(methods, ";\n\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o) = ");
+            strcat(methods, full_macro);
+            strcat(methods, "VALID_VALUES(o)[new_index");
+            strcat(methods, curr_num);
+            strcat(methods, "];\n\n");
+
+        }
+        else {
+
+            if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+
+                strcat(methods, "\t");
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                __create_random_scalar(methods, param);
+
+            }
+            else {
+
+                strcat(methods, "\tuint32_t rand_length");
+                strcat(methods, curr_num);
+                strcat(methods, " = (uint32_t) (20 * (rand() / (RAND_MAX + 1.0)));\n\t");
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                strcat(methods, "(o) = randomString(rand_length");
+                strcat(methods, curr_num);
+                strcat(methods, ");\n\n");
+
+            }
+
+        }
+
+    }
+
+    // closing characters of method
+    strcat(methods, "}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_printobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new printobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_printobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_printobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_printobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n");
+    
+    // each param gets its own print statement
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char full_macro[1000];
+
+        strcat(methods, "\tprintf(\"");
+        strcat(methods, param_macro_name);
+        strcat(methods, " : %");
+        
+        // change internal of print statement to match type of parameter
+        if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+            strcat(methods, "d");
+        }
+        else {
+            strcat(methods, "s");
+        }
+
+        if (i != (num_params - 1)) {
+            strcat(methods, " ; ");
+        }
+
+        strcat(methods, "\", ");
+
+        // add full macro name, needs to be separate so it can be capitalized
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_macro_name);
+        strupr(full_macro);
+
+        // finally add macro to the master methods string
+        strcat(methods, full_macro);
+        strcat(methods, "(o));\n");
+
+    }
+
+    // closing characters of method
+    strcat(methods, "\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_deleteobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new deleteobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_deleteobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_deleteobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+    
+    // starting text of the delete method
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_deleteobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *s) {\n\n\tassert(s!=NULL);\n\n");
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+
+        char full_macro[1000];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strupr(full_macro);
+
+        // if a param is constrained, you must free its valid values
+        if (strcmp(param_constrained, "true") == 0) {
+            strcat(methods, "\tfree(");
+            strcat(methods, full_macro);
+            strcat(methods, "_VALID_VALUES(s));\n");
+        }
+
+        // always free the struct itself
+        strcat(methods, "\tfree(");
+        strcat(methods, full_macro);
+        strcat(methods, "_STRUCT(s));\n");
+
+    }
+
+    // final free
+    strcat(methods, "\n\tfree(s);\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_writeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new writeobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_writeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_writeobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning string of method, starts the fwrite statement
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_writeobject(FILE *stream, object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n    assert(stream!=NULL);\n    fwrite(o, sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str), 1, stream);\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_readobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new readobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_readobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_readobject(char* name, char* methods, cJSON* params_json) {
+    
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other neede variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // starting text of method, starts declaring new objects to be created
+    strcat(methods, "void *");
+    strcat(methods, name);
+    strcat(methods, "_readobject(FILE *stream) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o;\n");
+
+    // each param needs its own struct declaration
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\t");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, " *");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o;\n");
+
+    }
+
+    // assert for main object
+    strcat(methods, "\n\tassert(stream!=NULL);\n");
+    strcat(methods, "\n\to = malloc(sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n");
+
+    // each param needs its own malloc line
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\t");
+        strcat(methods, object_name);
+        strcat(methods, "_");
         strcat(methods, param_name);
         strcat(methods, "_o = malloc(sizeof(");
         strcat(methods, name);
@@ -786,135 +1933,982 @@ void create_createobject(char* name, char* methods, cJSON* params_json) {
         strcat(methods, param_name);
         strcat(methods, "));\n");
 
-    }
+    }
+
+    // assert method for the main object
+    strcat(methods, "\n\tassert(o!=NULL);\n");
+
+    // each param needs its own assert line with the newly malloced object
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        strcat(methods, "\tassert(");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o!=NULL);\n");
+
+    }
+
+    // newline only for formatting reasons
+    strcat(methods, "\n");
+
+    // set struct variables of main object to newly declared objects using macros
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+
+        char full_macro_name[200];
+        strcpy(full_macro_name, "");
+        strcat(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strupr(full_macro_name);
+
+        strcat(methods, "\t");
+        strcat(methods, full_macro_name);
+        strcat(methods, "_STRUCT(o) = ");
+        strcat(methods, object_name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_o;\n");
+
+    }
+
+    // start the fread statement
+    strcat(methods, "\n\tfread(o, sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str), 1, stream);\n\n\treturn o;\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_copyobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new copyobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * create_copyobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_copyobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *object = cJSON_GetObjectItem(params_json, "object");
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning text of copyobject method
+    strcat(methods, "void *");
+    strcat(methods, name);
+    strcat(methods, "_copyobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *c = ");
+    strcat(methods, name);
+    strcat(methods, "_createobject();\n\n");
+    
+    // each param has the values from the original copied over
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+
+        char full_macro_name[200];
+        strcpy(full_macro_name, "");
+        strcat(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strcat(full_macro_name, "_");
+        strupr(full_macro_name);
+        strupr(param_macro_name);
+
+        strcat(methods, "\t");
+
+        if (strcmp(constrained, "true") == 0) {
+            
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(c) = ");
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o);\n\t");
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(c) = ");
+            strcat(methods, full_macro_name);
+            strcat(methods, "VALID_VALUES(c)[");
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o)];\n\n");
+
+        }
+        else {
+            
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(c) = ");
+            strcat(methods, full_macro_name);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o);\n\n");
+
+        }
+
+    }
+
+    // close memcpy and the entire copyobject_method
+    strcat(methods, "\treturn c;\n\n}\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_hashobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new hashobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_hashobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_hashobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning text of hashobject method
+    strcat(methods, "\nuint64_t ");
+    strcat(methods, name);
+    strcat(methods, "_hashobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n\tuint64_t h = 0;\n\n");
+
+    // each param is folded into the hash in order, strings by their contents
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+
+        char full_macro_name[200];
+        strcpy(full_macro_name, "");
+        strcat(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strcat(full_macro_name, "_");
+        strupr(full_macro_name);
+        strupr(param_macro_name);
+        strcat(full_macro_name, param_macro_name);
+
+        strcat(methods, "\th = hash_combine(h, ");
+
+        if (strstr(param_type, "char") != NULL) {
+
+            strcat(methods, "hash_string(");
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o)));\n");
+
+        }
+        else {
+
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o));\n");
+
+        }
+
+    }
+
+    // close the entire hashobject method
+    strcat(methods, "\n\treturn h;\n\n}\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_equalobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new equalobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_equalobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_equalobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning text of equalobject method
+    strcat(methods, "\nbool ");
+    strcat(methods, name);
+    strcat(methods, "_equalobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o0, object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o1) {\n\n");
+
+    // any param that differs makes the objects unequal, strings by their contents
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+
+        char full_macro_name[200];
+        strcpy(full_macro_name, "");
+        strcat(full_macro_name, name);
+        strcat(full_macro_name, "_");
+        strcat(full_macro_name, param_name);
+        strcat(full_macro_name, "_");
+        strupr(full_macro_name);
+        strupr(param_macro_name);
+        strcat(full_macro_name, param_macro_name);
+
+        strcat(methods, "\tif (");
+
+        if (strstr(param_type, "char") != NULL) {
+
+            strcat(methods, "strcmp(");
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o0), ");
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o1)) != 0");
+
+        }
+        else {
+
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o0) != ");
+            strcat(methods, full_macro_name);
+            strcat(methods, "(o1)");
+
+        }
+
+        strcat(methods, ") {\n\t\treturn false;\n\t}\n\n");
+
+    }
+
+    // close the entire equalobject method
+    strcat(methods, "\treturn true;\n\n}\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_fieldsobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new fieldsobject method, which gives the number of
+ *  uint32_t fields a gene is encoded into and the range of each of them
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_fieldsobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_fieldsobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    char count[4];
+    sprintf(count, "%d", num_params);
+
+    // beginning text of fieldsobject method, a temporary object gives
+    // the number of valid values of the constrained params
+    strcat(methods, "\nuint32_t ");
+    strcat(methods, name);
+    strcat(methods, "_fieldsobject(uint32_t *ranges) {\n\n\tobject_");
+    strcat(methods, name);
+    strcat(methods, "_str *o = ");
+    strcat(methods, name);
+    strcat(methods, "_createobject();\n\n");
+
+    // constrained params are stored as an index into their valid values,
+    // everything else as the value itself over the full 32 bit range
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
+
+        strcat(methods, "\tranges[");
+        strcat(methods, curr_num);
+        strcat(methods, "] = ");
+
+        if (strcmp(constrained, "true") == 0) {
+
+            strcat(methods, full_macro);
+            strcat(methods, "NUM_VALID_VALUES(o);\n");
+
+        }
+        else {
+
+            // a declared range is stored from its min, 0 is the full 32 bit range
+            int64_t min, max;
+            char span[12];
+
+            __create_param_bounds(param, &min, &max);
+            sprintf(span, "%u", (uint32_t) (max - min + 1));
+            strcat(methods, span);
+            strcat(methods, ";\n");
+
+        }
+
+    }
+
+    // close the entire fieldsobject method
+    strcat(methods, "\n\t");
+    strcat(methods, name);
+    strcat(methods, "_deleteobject(o);\n\n\treturn ");
+    strcat(methods, count);
+    strcat(methods, ";\n\n}\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_encodeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new encodeobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_encodeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_encodeobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning text of encodeobject method
+    strcat(methods, "\nvoid ");
+    strcat(methods, name);
+    strcat(methods, "_encodeobject(uint32_t *fields, object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n");
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
+
+        if (strcmp(constrained, "true") == 0) {
+
+            strcat(methods, "\tfields[");
+            strcat(methods, curr_num);
+            strcat(methods, "] = ");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o);\n");
+
+        }
+        else if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
+
+            strcat(methods, "\tfields[");
+            strcat(methods, curr_num);
+            strcat(methods, "] = ");
+
+            int64_t min, max;
+
+            if (__create_param_bounds(param, &min, &max) && min != 0) {
+                strcat(methods, "(uint32_t) ((int64_t) ");
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                strcat(methods, "(o)");
+                __create_offset(methods, -min);
+                strcat(methods, ");\n");
+            }
+            else {
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                strcat(methods, "(o);\n");
+            }
+
+        }
+        else {
+
+            // free form values such as strings do not fit in a field
+            strcat(methods, "\tprintf(\"error: param ");
+            strcat(methods, param_name);
+            strcat(methods, " cannot be encoded into a field\\n\");\n\texit(0);\n");
+
+        }
+
+    }
+
+    // close the entire encodeobject method
+    strcat(methods, "\n}\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_decodeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new decodeobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_decodeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_decodeobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    // beginning text of decodeobject method
+    strcat(methods, "\nvoid *");
+    strcat(methods, name);
+    strcat(methods, "_decodeobject(uint32_t *fields) {\n\n\tobject_");
+    strcat(methods, name);
+    strcat(methods, "_str *o = ");
+    strcat(methods, name);
+    strcat(methods, "_createobject();\n\n");
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
+
+        if (strcmp(constrained, "true") == 0) {
 
-    // need assert statement for the object itself
-    strcat(methods, "\n\tassert(o!=NULL);\n");
+            strcat(methods, "\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o) = fields[");
+            strcat(methods, curr_num);
+            strcat(methods, "];\n\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o) = ");
+            strcat(methods, full_macro);
+            strcat(methods, "VALID_VALUES(o)[fields[");
+            strcat(methods, curr_num);
+            strcat(methods, "]];\n");
 
-    // for each param, create a new assert statment to check not NULL
-    for (uint32_t i = 0; i < num_params; i++) {
+        }
+        else if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+            strcat(methods, "\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o) = fields[");
+            strcat(methods, curr_num);
+            strcat(methods, "]");
 
-        strcat(methods, "\tassert(");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o!=NULL);\n");
+            int64_t min, max;
+
+            if (__create_param_bounds(param, &min, &max)) {
+                __create_offset(methods, min);
+            }
+
+            strcat(methods, ";\n");
+
+        }
 
     }
 
-    // newline only for formatting reasons
-    strcat(methods, "\n");
+    // close the entire decodeobject method
+    strcat(methods, "\n\treturn o;\n\n}\n");
 
-    // for each param, need line setting struct of top-level
-    // object to the declared struct using a macro
-    for (uint32_t i = 0; i < num_params; i++) {
+}
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+/*
+ * NAME
+ *
+ *   create_compact_createobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new createobject method for a compact
+ *  object, a single malloc with every param set to its default
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_createobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
 
-        char full_macro_name[200];
-        strcpy(full_macro_name, "");
-        strcat(full_macro_name, name);
-        strcat(full_macro_name, "_");
-        strcat(full_macro_name, param_name);
-        strupr(full_macro_name);
+void create_compact_createobject(char* name, char* methods, cJSON* params_json) {
 
-        strcat(methods, "\t");
-        strcat(methods, full_macro_name);
-        strcat(methods, "_STRUCT(o) = ");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o;\n");
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
-    }
+    // prepare other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
 
-    // newline only for formatting reasons
-    strcat(methods, "\n");
+    // the whole object is one allocation
+    strcat(methods, "object_");
+    strcat(methods, name);
+    strcat(methods, "_str *");
+    strcat(methods, name);
+    strcat(methods, "_createobject(void) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o = malloc(sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n\n\tassert(o!=NULL);\n\n");
 
-    // for each param, either create call to their set_valid_values function
-    // or set each item in its struct using individual macros
+    // unconstrained params are not set yet, constrained ones take their first valid value
     for (uint32_t i = 0; i < num_params; i++) {
 
         cJSON* param = cJSON_GetArrayItem(params, i);
         char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
         char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
-        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
         char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
-        strupr(param_macro_name);
 
-        char full_macro_name[100];
-        strcpy(full_macro_name, name);
-        strcat(full_macro_name, "_");
-        strcat(full_macro_name, param_name);
-        strupr(full_macro_name);
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
 
         strcat(methods, "\t");
-        strcat(methods, full_macro_name);
-        strcat(methods, "_");
+        strcat(methods, full_macro);
         strcat(methods, param_macro_name);
 
-        // default value for not being set is different depending on type
-        if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
-            strcat(methods, "(o) = -1;\n");
+        if (strcmp(constrained, "true") == 0) {
+            strcat(methods, "_INDEX(o) = 0;\n");
         }
         else {
-            strcat(methods, "(o) = \"not set\";\n");
+            strcat(methods, "(o) = -1;\n");
         }
 
-        // constrained with valid values, can use set_valid_values method
+    }
+
+    // return the new object created
+    strcat(methods, "\n\treturn o;\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_compact_randomizeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new randomizeobject method for a compact
+ *  object, constrained params draw a new index into their table
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_randomizeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_randomizeobject(char* name, char* methods, cJSON* params_json) {
+
+    // get top-level cJSON objects
+    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_randomizeobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n");
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
+
         if (strcmp(constrained, "true") == 0) {
 
-            strcat(methods, "\t");
-            strcat(methods, full_macro_name);
-            strcat(methods, "_");
+            strcat(methods, "\tuint32_t num_valid_values");
+            strcat(methods, curr_num);
+            strcat(methods, " = ");
+            strcat(methods, full_macro);
+            strcat(methods, "NUM_VALID_VALUES(o);\n\tuint32_t new_index");
+            strcat(methods, curr_num);
+            strcat(methods, " = (uint32_t) (num_valid_values");
+            strcat(methods, curr_num);
+            strcat(methods, " * (rand() / (RAND_MAX + 1.0)));\n\t");
+            strcat(methods, full_macro);
             strcat(methods, param_macro_name);
-            strcat(methods, "_INDEX(o) = -1;\n");
+            strcat(methods, "_INDEX(o) = new_index");
+            strcat(methods, curr_num);
+            strcat(methods, ";\n\n");
+
+        }
+        else {
 
             strcat(methods, "\t");
-            strcat(methods, name);
-            strcat(methods, "_");
-            strcat(methods, param_name);
-            strcat(methods, "_set_valid_values(o);\n\n");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            __create_random_scalar(methods, param);
 
         }
-        // no valid values, set everything manually in this method
-        else {
 
-            strcat(methods, "\t");
-            strcat(methods, full_macro_name);
-            strcat(methods, "_CONSTRAINED(o) = false;\n");
+    }
+
+    // closing characters of method
+    strcat(methods, "}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_compact_deleteobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new deleteobject method for a compact
+ *  object, which only has the object itself to free
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_deleteobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_deleteobject(char* name, char* methods) {
+
+    strcat(methods, "void ");
+    strcat(methods, name);
+    strcat(methods, "_deleteobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *s) {\n\n\tassert(s!=NULL);\n\n\tfree(s);\n\n}\n\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   create_compact_readobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new readobject method for a compact
+ *  object, a fixed size read of what writeobject wrote
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_readobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_readobject(char* name, char* methods) {
 
-            strcat(methods, "\t");
-            strcat(methods, full_macro_name);
-            strcat(methods, "_VALID_VALUES(o) = NULL;\n");
+    strcat(methods, "void *");
+    strcat(methods, name);
+    strcat(methods, "_readobject(FILE *stream) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o = malloc(sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n\n\tassert(stream!=NULL);\n\tassert(o!=NULL);\n\n\tfread(o, sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str), 1, stream);\n\n\treturn o;\n\n}\n\n");
 
-            strcat(methods, "\t");
-            strcat(methods, full_macro_name);
-            strcat(methods, "_NUM_VALID_VALUES(o) = 0;\n\n");
+}
 
-        }
+/*
+ * NAME
+ *
+ *   create_compact_copyobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new copyobject method for a compact
+ *  object, a single malloc and memcpy
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_copyobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
 
-    }
+void create_compact_copyobject(char* name, char* methods) {
 
-    // return the new object created
-    strcat(methods, "\treturn o;\n\n}\n\n");
+    strcat(methods, "void *");
+    strcat(methods, name);
+    strcat(methods, "_copyobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o) {\n\n    object_");
+    strcat(methods, name);
+    strcat(methods, "_str *c = malloc(sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n\n\tassert(c!=NULL);\n\n\tmemcpy(c, o, sizeof(object_");
+    strcat(methods, name);
+    strcat(methods, "_str));\n\n\treturn c;\n\n}\n");
 
 }
 
 /*
  * NAME
  *
- *   create_randomizeobject
+ *   create_compact_decodeobject
  *
  * DESCRIPTION
  *
- *  Changes all parameters in an object to random values,
- *  either from the list of valid values or in a completely
- *  random way if that list does not apply
+ *  Helper to create a new decodeobject method for a compact
+ *  object, constrained params are decoded into their index
  *
  * PARAMETERS
  *
@@ -928,7 +2922,7 @@ void create_createobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_randomizeobject(name, methods, params_json)
+ *  create_compact_decodeobject(name, methods, params_json)
  *
  * SIDE-EFFECT
  *
@@ -936,115 +2930,91 @@ void create_createobject(char* name, char* methods, cJSON* params_json) {
  *
  */
 
-void create_randomizeobject(char* name, char* methods, cJSON* params_json) {
+void create_compact_decodeobject(char* name, char* methods, cJSON* params_json) {
 
     // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
     cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
     // get other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
     uint32_t num_params = cJSON_GetArraySize(params);
 
-    strcat(methods, "void ");
+    // beginning text of decodeobject method
+    strcat(methods, "\nvoid *");
     strcat(methods, name);
-    strcat(methods, "_randomizeobject(object_");
+    strcat(methods, "_decodeobject(uint32_t *fields) {\n\n\tobject_");
     strcat(methods, name);
-    strcat(methods, "_str *o) {\n\n");
-    
-    // each param gets its own print statement
+    strcat(methods, "_str *o = ");
+    strcat(methods, name);
+    strcat(methods, "_createobject();\n\n");
+
     for (uint32_t i = 0; i < num_params; i++) {
 
         cJSON* param = cJSON_GetArrayItem(params, i);
         char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
-        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
-        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
         char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
-        char full_macro[1000];
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
 
-        // add full macro name, needs to be separate so it can be capitalized
+        char full_macro[200];
         strcpy(full_macro, name);
         strcat(full_macro, "_");
         strcat(full_macro, param_name);
         strcat(full_macro, "_");
-
         strupr(full_macro);
         strupr(param_macro_name);
 
-        char curr_num[2];
-        itoa(i, curr_num, 10);
-
-        if (strcmp(constrained, "true") == 0) {
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
 
-            strcat(methods, "\tuint32_t num_valid_values");
-            strcat(methods, curr_num);
-            strcat(methods, " = ");
-            strcat(methods, full_macro);
-            strcat(methods, "NUM_VALID_VALUES(o);\n\tuint32_t new_index");
-            strcat(methods, curr_num);
-            strcat(methods, " = (uint32_t) (num_valid_values");
-            strcat(methods, curr_num);
-            strcat(methods, " * (rand() / (RAND_MAX + 1.0)));\n\t");
-            strcat(methods, full_macro);
-            strcat(methods, param_macro_name);
-            strcat(methods, "_INDEX(o) = new_index");
-            strcat(methods, curr_num);
-            strcat(methods, ";\n\t");
-            strcat(methods, full_macro);
-            strcat(methods, param_macro_name);
-            strcat(methods, "(o) = ");
-            strcat(methods, full_macro);
-            strcat(methods, "VALID_VALUES(o)[new_index");
-            strcat(methods, curr_num);
-            strcat(methods, "];\n\n");
+        strcat(methods, "\t");
+        strcat(methods, full_macro);
+        strcat(methods, param_macro_name);
 
+        if (strcmp(constrained, "true") == 0) {
+            strcat(methods, "_INDEX");
         }
-        else {
-
-            if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
 
-                strcat(methods, "\t");
-                strcat(methods, full_macro);
-                strcat(methods, param_macro_name);
-                strcat(methods, "(o) = rand() / (RAND_MAX + 1.0);\n\n");
-
-            }
-            else {
+        strcat(methods, "(o) = fields[");
+        strcat(methods, curr_num);
+        strcat(methods, "]");
 
-                strcat(methods, "\tuint32_t rand_length");
-                strcat(methods, curr_num);
-                strcat(methods, " = (uint32_t) (20 * (rand() / (RAND_MAX + 1.0)));\n\t");
-                strcat(methods, full_macro);
-                strcat(methods, param_macro_name);
-                strcat(methods, "(o) = randomString(rand_length");
-                strcat(methods, curr_num);
-                strcat(methods, ");\n\n");
+        // unconstrained params were encoded from the start of their range
+        if (strcmp(constrained, "true") != 0) {
+            int64_t min, max;
 
+            if (__create_param_bounds(param, &min, &max)) {
+                __create_offset(methods, min);
             }
-
         }
 
+        strcat(methods, ";\n");
+
     }
 
-    // closing characters of method
-    strcat(methods, "}\n\n");
+    // close the entire decodeobject method
+    strcat(methods, "\n\treturn o;\n\n}\n");
 
 }
 
 /*
  * NAME
  *
- *   create_printobject
+ *   __create_draw_param
  *
  * DESCRIPTION
  *
- *  Helper to create a new printobject method
+ *  Appends the statements of a batch kernel drawing a new value
+ *  for one param of object o from the generator in state. Constrained
+ *  params draw an index into their valid values with bounded_rand,
+ *  integers draw from their range like the fields of fieldsobject,
+ *  strings get a new random string
  *
  * PARAMETERS
  *
  *  char* name
  *  char* methods
- *  cJSON* params_json
+ *  cJSON* param
+ *  bool compact
+ *  char* indent
  *
  * RETURN
  *
@@ -1052,7 +3022,7 @@ void create_randomizeobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_printobject(name, methods, params_json)
+ *  __create_draw_param(name, methods, param, true, "\t\t");
  *
  * SIDE-EFFECT
  *
@@ -1060,76 +3030,82 @@ void create_randomizeobject(char* name, char* methods, cJSON* params_json) {
  *
  */
 
-void create_printobject(char* name, char* methods, cJSON* params_json) {
+void __create_draw_param(char* name, char* methods, cJSON* param, bool compact, char* indent) {
 
-    // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
-    cJSON *params = cJSON_GetObjectItem(params_json, "params");
+    char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+    char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+    char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+    char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
 
-    // get other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
-    uint32_t num_params = cJSON_GetArraySize(params);
+    char full_macro[200];
+    strcpy(full_macro, name);
+    strcat(full_macro, "_");
+    strcat(full_macro, param_name);
+    strcat(full_macro, "_");
+    strupr(full_macro);
+    strupr(param_macro_name);
 
-    strcat(methods, "void ");
-    strcat(methods, name);
-    strcat(methods, "_printobject(object_");
-    strcat(methods, name);
-    strcat(methods, "_str *o) {\n\n");
-    
-    // each param gets its own print statement
-    for (uint32_t i = 0; i < num_params; i++) {
+    strcat(methods, indent);
+    strcat(methods, full_macro);
+    strcat(methods, param_macro_name);
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
-        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
-        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
-        char full_macro[1000];
+    if (strcmp(constrained, "true") == 0) {
 
-        strcat(methods, "\tprintf(\"");
-        strcat(methods, param_macro_name);
-        strcat(methods, " : %");
-        
-        // change internal of print statement to match type of parameter
-        if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
-            strcat(methods, "d");
-        }
-        else {
-            strcat(methods, "s");
-        }
+        strcat(methods, "_INDEX(o) = bounded_rand(state, ");
+        strcat(methods, full_macro);
+        strcat(methods, "NUM_VALID_VALUES(o));\n");
 
-        if (i != (num_params - 1)) {
-            strcat(methods, " ; ");
+        // only the index is stored in a compact object, otherwise the value is kept next to it
+        if (!compact) {
+            strcat(methods, indent);
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o) = ");
+            strcat(methods, full_macro);
+            strcat(methods, "VALID_VALUES(o)[");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o)];\n");
         }
 
-        strcat(methods, "\", ");
+    }
+    else if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
 
-        // add full macro name, needs to be separate so it can be capitalized
-        strcpy(full_macro, name);
-        strcat(full_macro, "_");
-        strcat(full_macro, param_name);
-        strcat(full_macro, "_");
-        strcat(full_macro, param_macro_name);
-        strupr(full_macro);
+        int64_t min, max;
+        char text[100];
 
-        // finally add macro to the master methods string
-        strcat(methods, full_macro);
-        strcat(methods, "(o));\n");
+        // without a range the whole 32 bits are drawn, a bound of 0
+        if (!__create_param_bounds(param, &min, &max)) {
+            strcat(methods, "(o) = bounded_rand(state, 0);\n");
+        }
+        else if (min == 0) {
+            sprintf(text, "(o) = bounded_rand(state, %u);\n", (uint32_t) (max + 1));
+            strcat(methods, text);
+        }
+        else {
+            sprintf(text, "(o) = %lld + (int64_t) bounded_rand(state, %u);\n", (long long) min, (uint32_t) (max - min + 1));
+            strcat(methods, text);
+        }
 
     }
+    else {
 
-    // closing characters of method
-    strcat(methods, "\n}\n\n");
+        strcat(methods, "(o) = randomString(bounded_rand(state, 20));\n");
+
+    }
 
 }
 
 /*
  * NAME
  *
- *   create_deleteobject
+ *   create_randomizebatch
  *
  * DESCRIPTION
  *
- *  Helper to create a new deleteobject method
+ *  Helper to create a new randomizebatch method, a kernel that
+ *  draws every param of n objects from a caller owned generator
+ *  instead of calling rand() several times per object
  *
  * PARAMETERS
  *
@@ -1143,7 +3119,7 @@ void create_printobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_deleteobject(name, methods, params_json)
+ *  create_randomizebatch(name, methods, params_json)
  *
  * SIDE-EFFECT
  *
@@ -1151,64 +3127,40 @@ void create_printobject(char* name, char* methods, cJSON* params_json) {
  *
  */
 
-void create_deleteobject(char* name, char* methods, cJSON* params_json) {
+void create_randomizebatch(char* name, char* methods, cJSON* params_json) {
 
     // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
     cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
     // get other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
     uint32_t num_params = cJSON_GetArraySize(params);
-    
-    // starting text of the delete method
-    strcat(methods, "void ");
+    bool compact = create_is_compact(params_json);
+
+    strcat(methods, "\nvoid ");
     strcat(methods, name);
-    strcat(methods, "_deleteobject(object_");
+    strcat(methods, "_randomizebatch(void **objs, uint32_t n, uint64_t *state) {\n\n\tfor (uint32_t i = 0; i < n; i++) {\n\n\t\tobject_");
     strcat(methods, name);
-    strcat(methods, "_str *s) {\n\n\tassert(s!=NULL);\n\n");
+    strcat(methods, "_str *o = objs[i];\n\n");
 
     for (uint32_t i = 0; i < num_params; i++) {
-
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
-        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
-        char* param_constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
-        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
-
-        char full_macro[1000];
-        strcpy(full_macro, name);
-        strcat(full_macro, "_");
-        strcat(full_macro, param_name);
-        strupr(full_macro);
-
-        // if a param is constrained, you must free its valid values
-        if (strcmp(param_constrained, "true") == 0) {
-            strcat(methods, "\tfree(");
-            strcat(methods, full_macro);
-            strcat(methods, "_VALID_VALUES(s));\n");
-        }
-
-        // always free the struct itself
-        strcat(methods, "\tfree(");
-        strcat(methods, full_macro);
-        strcat(methods, "_STRUCT(s));\n");
-
+        __create_draw_param(name, methods, cJSON_GetArrayItem(params, i), compact, "\t\t");
     }
 
-    // final free
-    strcat(methods, "\n\tfree(s);\n\n}\n\n");
+    // close the loop and the entire randomizebatch method
+    strcat(methods, "\n\t}\n\n}\n");
 
 }
 
 /*
  * NAME
  *
- *   create_writeobject
+ *   create_mutatebatch
  *
  * DESCRIPTION
  *
- *  Helper to create a new writeobject method
+ *  Helper to create a new mutatebatch method, a kernel that
+ *  mutates one param of each of n objects through its mutate
+ *  method, the param picked by weight from a caller owned generator
  *
  * PARAMETERS
  *
@@ -1222,43 +3174,106 @@ void create_deleteobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_writeobject(name, methods, params_json)
+ *  create_mutatebatch(name, methods, params_json)
  *
  * SIDE-EFFECT
  *
- *  alters the "methods" parameter
+ *  alters the "methods" parameter, exits if every param has a weight of 0
  *
  */
 
-void create_writeobject(char* name, char* methods, cJSON* params_json) {
+void create_mutatebatch(char* name, char* methods, cJSON* params_json) {
 
     // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
     cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
-    // get other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
-    uint32_t num_params = cJSON_GetArraySize(params);
+    // get other needed variables
+    uint32_t num_params = cJSON_GetArraySize(params);
+    uint32_t total_weight = 0;
+    uint32_t last = 0;
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        uint32_t weight = __create_param_weight(cJSON_GetArrayItem(params, i));
+        total_weight += weight;
+
+        if (weight > 0) {
+            last = i;
+        }
+
+    }
+
+    if (total_weight == 0) {
+        printf("error: at least one param of %s needs a weight above 0 [file:'%s',line:%d]\n", name, __FILE__, __LINE__);
+        exit(0);
+    }
 
-    // beginning string of method, starts the fwrite statement
-    strcat(methods, "void ");
-    strcat(methods, name);
-    strcat(methods, "_writeobject(FILE *stream, object_");
+    char total[12];
+    sprintf(total, "%u", total_weight);
+
+    strcat(methods, "\nvoid ");
     strcat(methods, name);
-    strcat(methods, "_str *o) {\n\n    assert(stream!=NULL);\n    fwrite(o, sizeof(object_");
+    strcat(methods, "_mutatebatch(void **objs, uint32_t n, uint64_t *state) {\n\n\tfor (uint32_t i = 0; i < n; i++) {\n\n\t\tobject_");
     strcat(methods, name);
-    strcat(methods, "_str), 1, stream);\n\n}\n\n");
+    strcat(methods, "_str *o = objs[i];\n\t\tuint32_t r = bounded_rand(state, ");
+    strcat(methods, total);
+    strcat(methods, ");\n\n");
+
+    // each param with a weight is one branch, taken for its share of r
+    uint32_t cumulative = 0;
+    bool first = true;
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        cJSON* param = cJSON_GetArrayItem(params, i);
+        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        uint32_t weight = __create_param_weight(param);
+
+        if (weight == 0) {
+            continue;
+        }
+
+        cumulative += weight;
+
+        char bound[12];
+        sprintf(bound, "%u", cumulative);
+
+        if (i == last) {
+            strcat(methods, first ? "\t\t{\n" : "\t\telse {\n");
+        }
+        else {
+            strcat(methods, first ? "\t\tif (r < " : "\t\telse if (r < ");
+            strcat(methods, bound);
+            strcat(methods, ") {\n");
+        }
+
+        strcat(methods, "\t\t\t");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_mutate(o, state);\n\t\t}\n");
+
+        first = false;
+
+    }
+
+    // close the loop and the entire mutatebatch method
+    strcat(methods, "\n\t}\n\n}\n");
 
 }
 
 /*
  * NAME
  *
- *   create_readobject
+ *   create_param_mutators
  *
  * DESCRIPTION
  *
- *  Helper to create a new readobject method
+ *  Helper to create one mutate method per param, each drawing a
+ *  new value for its param from a caller owned generator. Integers
+ *  take a gaussian step of the param's step, reflected back into
+ *  its range, ordered constrained params move to a neighboring
+ *  valid value and categorical ones swap to any other value
  *
  * PARAMETERS
  *
@@ -1272,131 +3287,158 @@ void create_writeobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_readobject(name, methods, params_json)
+ *  create_param_mutators(name, methods, params_json)
  *
  * SIDE-EFFECT
  *
- *  alters the "methods" parameter
+ *  alters the "methods" parameter, exits if a param has a step that does not fit a uint32_t
  *
  */
 
-void create_readobject(char* name, char* methods, cJSON* params_json) {
-    
+void create_param_mutators(char* name, char* methods, cJSON* params_json) {
+
     // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
     cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
-    // get other neede variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
+    // get other needed variables
     uint32_t num_params = cJSON_GetArraySize(params);
+    bool compact = create_is_compact(params_json);
 
-    // starting text of method, starts declaring new objects to be created
-    strcat(methods, "void *");
-    strcat(methods, name);
-    strcat(methods, "_readobject(FILE *stream) {\n\n    object_");
-    strcat(methods, name);
-    strcat(methods, "_str *o;\n");
-
-    // each param needs its own struct declaration
     for (uint32_t i = 0; i < num_params; i++) {
 
         cJSON* param = cJSON_GetArrayItem(params, i);
         char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        char* param_type = cJSON_GetObjectItem(param, "type")->valuestring;
+        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
+        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
+        cJSON* categorical = cJSON_GetObjectItem(param, "categorical");
 
-        strcat(methods, "\t");
+        char full_macro[200];
+        strcpy(full_macro, name);
+        strcat(full_macro, "_");
+        strcat(full_macro, param_name);
+        strcat(full_macro, "_");
+        strupr(full_macro);
+        strupr(param_macro_name);
+
+        int64_t step_value = __create_param_number(param, "step", 1);
+
+        if (step_value < 0 || step_value > UINT32_MAX) {
+            printf("error: step of param %s must fit a uint32_t [file:'%s',line:%d]\n", param_name, __FILE__, __LINE__);
+            exit(0);
+        }
+
+        char step[12];
+        sprintf(step, "%lld", (long long) step_value);
+
+        strcat(methods, "\nvoid ");
         strcat(methods, name);
         strcat(methods, "_");
         strcat(methods, param_name);
-        strcat(methods, " *");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o;\n");
+        strcat(methods, "_mutate(object_");
+        strcat(methods, name);
+        strcat(methods, "_str *o, uint64_t *state) {\n\n");
 
-    }
+        if (strcmp(constrained, "true") == 0) {
 
-    // assert for main object
-    strcat(methods, "\n\tassert(stream!=NULL);\n");
-    strcat(methods, "\n\to = malloc(sizeof(object_");
-    strcat(methods, name);
-    strcat(methods, "_str));\n");
+            // like has_valid_values, categorical is a "true" or "false" string, ordered if missing
+            bool is_categorical = categorical != NULL && categorical->valuestring != NULL && strcmp(categorical->valuestring, "true") == 0;
 
-    // each param needs its own malloc line
-    for (uint32_t i = 0; i < num_params; i++) {
+            strcat(methods, "\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+            if (is_categorical) {
+                strcat(methods, "_INDEX(o) = swap_index(state, ");
+            }
+            else {
+                strcat(methods, "_INDEX(o) = neighbor_index(state, ");
+            }
 
-        strcat(methods, "\t");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o = malloc(sizeof(");
-        strcat(methods, name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "));\n");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "_INDEX(o), ");
+            strcat(methods, full_macro);
+            strcat(methods, "NUM_VALID_VALUES(o)");
 
-    }
+            if (!is_categorical) {
+                strcat(methods, ", ");
+                strcat(methods, step);
+            }
 
-    // assert method for the main object
-    strcat(methods, "\n\tassert(o!=NULL);\n");
+            strcat(methods, ");\n");
 
-    // each param needs its own assert line with the newly malloced object
-    for (uint32_t i = 0; i < num_params; i++) {
+            // only the index is stored in a compact object, otherwise the value is kept next to it
+            if (!compact) {
+                strcat(methods, "\t");
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                strcat(methods, "(o) = ");
+                strcat(methods, full_macro);
+                strcat(methods, "VALID_VALUES(o)[");
+                strcat(methods, full_macro);
+                strcat(methods, param_macro_name);
+                strcat(methods, "_INDEX(o)];\n");
+            }
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+        }
+        else if (strcmp(param_type, "uint32_t") == 0 || strcmp(param_type, "int") == 0) {
 
-        strcat(methods, "\tassert(");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o!=NULL);\n");
+            int64_t min_value, max_value;
+            __create_param_bounds(param, &min_value, &max_value);
 
-    }
+            char min[24];
+            char max[24];
+            sprintf(min, "%lld", (long long) min_value);
+            sprintf(max, "%lld", (long long) max_value);
 
-    // newline only for formatting reasons
-    strcat(methods, "\n");
+            // a step past either end is reflected back, and clamped if it is still outside
+            strcat(methods, "\tint64_t current = (int64_t) ");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o);\n\tint64_t value = current + gaussian_step(state, ");
+            strcat(methods, step);
+            strcat(methods, ");\n\n\tif (value < ");
+            strcat(methods, min);
+            strcat(methods, " || value > ");
+            strcat(methods, max);
+            strcat(methods, ") {\n\t\tvalue = 2 * current - value;\n\t}\n\n\t");
+            strcat(methods, full_macro);
+            strcat(methods, param_macro_name);
+            strcat(methods, "(o) = value < ");
+            strcat(methods, min);
+            strcat(methods, " ? ");
+            strcat(methods, min);
+            strcat(methods, " : value > ");
+            strcat(methods, max);
+            strcat(methods, " ? ");
+            strcat(methods, max);
+            strcat(methods, " : value;\n");
 
-    // set struct variables of main object to newly declared objects using macros
-    for (uint32_t i = 0; i < num_params; i++) {
+        }
+        else {
 
-        cJSON* param = cJSON_GetArrayItem(params, i);
-        char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
+            // free form values have no neighbors, they are drawn again
+            __create_draw_param(name, methods, param, compact, "\t");
 
-        char full_macro_name[200];
-        strcpy(full_macro_name, "");
-        strcat(full_macro_name, name);
-        strcat(full_macro_name, "_");
-        strcat(full_macro_name, param_name);
-        strupr(full_macro_name);
+        }
 
-        strcat(methods, "\t");
-        strcat(methods, full_macro_name);
-        strcat(methods, "_STRUCT(o) = ");
-        strcat(methods, object_name);
-        strcat(methods, "_");
-        strcat(methods, param_name);
-        strcat(methods, "_o;\n");
+        strcat(methods, "\n}\n");
 
     }
 
-    // start the fread statement
-    strcat(methods, "\n\tfread(o, sizeof(object_");
-    strcat(methods, name);
-    strcat(methods, "_str), 1, stream);\n\n\treturn o;\n\n}\n\n");
-
 }
 
 /*
  * NAME
  *
- *   create_copyobject
+ *   create_mutatorsobject
  *
  * DESCRIPTION
  *
- *  Helper to create a new copyobject method
+ *  Helper to create a new mutatorsobject method, which lists the
+ *  mutate method of every param along with its weight so that the
+ *  mutation operators can pick which param of a node changes
  *
  * PARAMETERS
  *
@@ -1410,7 +3452,7 @@ void create_readobject(char* name, char* methods, cJSON* params_json) {
  *
  * EXAMPLE
  *
- * create_copyobject(name, methods, params_json)
+ *  create_mutatorsobject(name, methods, params_json)
  *
  * SIDE-EFFECT
  *
@@ -1418,79 +3460,50 @@ void create_readobject(char* name, char* methods, cJSON* params_json) {
  *
  */
 
-void create_copyobject(char* name, char* methods, cJSON* params_json) {
+void create_mutatorsobject(char* name, char* methods, cJSON* params_json) {
 
     // get top-level cJSON objects
-    cJSON *object = cJSON_GetObjectItem(params_json, "object");
     cJSON *params = cJSON_GetObjectItem(params_json, "params");
 
     // get other needed variables
-    char* object_name = cJSON_GetObjectItem(object, "name")->valuestring;
     uint32_t num_params = cJSON_GetArraySize(params);
 
-    // beginning text of copyobject method
-    strcat(methods, "void *");
-    strcat(methods, name);
-    strcat(methods, "_copyobject(object_");
-    strcat(methods, name);
-    strcat(methods, "_str *o) {\n\n    object_");
-    strcat(methods, name);
-    strcat(methods, "_str *c = ");
+    char count[4];
+    sprintf(count, "%d", num_params);
+
+    strcat(methods, "\nuint32_t ");
     strcat(methods, name);
-    strcat(methods, "_createobject();\n\n");
-    
-    // each param has the values from the original copied over
+    strcat(methods, "_mutatorsobject(void (**mutators)(void *, uint64_t *), uint32_t *weights) {\n\n");
+
     for (uint32_t i = 0; i < num_params; i++) {
 
         cJSON* param = cJSON_GetArrayItem(params, i);
         char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
-        char* param_macro_name = cJSON_GetObjectItem(param, "macro_name")->valuestring;
-        char* constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
-
-        char full_macro_name[200];
-        strcpy(full_macro_name, "");
-        strcat(full_macro_name, name);
-        strcat(full_macro_name, "_");
-        strcat(full_macro_name, param_name);
-        strcat(full_macro_name, "_");
-        strupr(full_macro_name);
-        strupr(param_macro_name);
-
-        strcat(methods, "\t");
 
-        if (strcmp(constrained, "true") == 0) {
-            
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "_INDEX(c) = ");
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "_INDEX(o);\n\t");
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "(c) = ");
-            strcat(methods, full_macro_name);
-            strcat(methods, "VALID_VALUES(c)[");
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "_INDEX(o)];\n\n");
+        char curr_num[4];
+        sprintf(curr_num, "%d", i);
 
-        }
-        else {
-            
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "(c) = ");
-            strcat(methods, full_macro_name);
-            strcat(methods, param_macro_name);
-            strcat(methods, "(o);\n\n");
+        char weight[8];
+        sprintf(weight, "%u", __create_param_weight(param));
 
-        }
+        strcat(methods, "\tmutators[");
+        strcat(methods, curr_num);
+        strcat(methods, "] = (void (*)(void *, uint64_t *)) ");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_mutate;\n\tweights[");
+        strcat(methods, curr_num);
+        strcat(methods, "] = ");
+        strcat(methods, weight);
+        strcat(methods, ";\n");
 
     }
 
-    // close memcpy and the entire copyobject_method
-    strcat(methods, "\treturn c;\n\n}\n");
+    // close the entire mutatorsobject method
+    strcat(methods, "\n\treturn ");
+    strcat(methods, count);
+    strcat(methods, ";\n\n}\n");
 
 }
 
@@ -1526,6 +3539,32 @@ void create_copyobject(char* name, char* methods, cJSON* params_json) {
 
 void create_methods_c(char* name, char* methods, cJSON* params_json) {
 
+    // compact objects need no valid value methods and have no per-param
+    // structs to allocate, copy or free, the rest of the methods are shared
+    if (create_is_compact(params_json)) {
+
+        create_uid(name, methods);
+        create_compact_createobject(name, methods, params_json);
+        create_compact_randomizeobject(name, methods, params_json);
+        create_printobject(name, methods, params_json);
+        create_compact_deleteobject(name, methods);
+        create_writeobject(name, methods, params_json);
+        create_compact_readobject(name, methods);
+        create_compact_copyobject(name, methods);
+        create_hashobject(name, methods, params_json);
+        create_equalobject(name, methods, params_json);
+        create_fieldsobject(name, methods, params_json);
+        create_encodeobject(name, methods, params_json);
+        create_compact_decodeobject(name, methods, params_json);
+        create_randomizebatch(name, methods, params_json);
+        create_param_mutators(name, methods, params_json);
+        create_mutatorsobject(name, methods, params_json);
+        create_mutatebatch(name, methods, params_json);
+
+        return;
+
+    }
+
     // call methods in order of final appearance in the .c file, can be changed
     create_uid(name, methods);
     create_valid_value_methods(name, methods, params_json);
@@ -1536,6 +3575,15 @@ void create_methods_c(char* name, char* methods, cJSON* params_json) {
     create_writeobject(name, methods, params_json);
     create_readobject(name, methods, params_json);
     create_copyobject(name, methods, params_json);
+    create_hashobject(name, methods, params_json);
+    create_equalobject(name, methods, params_json);
+    create_fieldsobject(name, methods, params_json);
+    create_encodeobject(name, methods, params_json);
+    create_decodeobject(name, methods, params_json);
+    create_randomizebatch(name, methods, params_json);
+    create_param_mutators(name, methods, params_json);
+    create_mutatorsobject(name, methods, params_json);
+    create_mutatebatch(name, methods, params_json);
 
 }
 
@@ -1590,7 +3638,7 @@ void create_methods_end_h(char* name, char* methods, cJSON* params_json) {
         char* param_name = cJSON_GetObjectItem(param, "name")->valuestring;
         char* param_constrained = cJSON_GetObjectItem(param, "has_valid_values")->valuestring;
 
-        if (strcmp(param_constrained, "true") == 0) {
+        if (strcmp(param_constrained, "true") == 0 && !create_is_compact(params_json)) {
             strcat(methods, "void ");
             strcat(methods, name);
             strcat(methods, "_");
@@ -1637,11 +3685,66 @@ void create_methods_end_h(char* name, char* methods, cJSON* params_json) {
     strcat(methods, name);
     strcat(methods, "_readobject(FILE *stream);\n\nvoid *");
 
-    // copyobject and end of entire module
+    // copyobject and start of hashobject
     strcat(methods, name);
     strcat(methods, "_copyobject(object_");
     strcat(methods, name);
-    strcat(methods, "_str *o);\n\n#endif /* MODULE_");
+    strcat(methods, "_str *o);\n\nuint64_t ");
+
+    // hashobject and start of equalobject
+    strcat(methods, name);
+    strcat(methods, "_hashobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o);\n\nbool ");
+
+    // equalobject and start of fieldsobject
+    strcat(methods, name);
+    strcat(methods, "_equalobject(object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o0, object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o1);\n\nuint32_t ");
+
+    // fieldsobject and start of encodeobject
+    strcat(methods, name);
+    strcat(methods, "_fieldsobject(uint32_t *ranges);\n\nvoid ");
+
+    // encodeobject and start of decodeobject
+    strcat(methods, name);
+    strcat(methods, "_encodeobject(uint32_t *fields, object_");
+    strcat(methods, name);
+    strcat(methods, "_str *o);\n\nvoid *");
+
+    // decodeobject and start of randomizebatch
+    strcat(methods, name);
+    strcat(methods, "_decodeobject(uint32_t *fields);\n\nvoid ");
+
+    // randomizebatch and start of mutatebatch
+    strcat(methods, name);
+    strcat(methods, "_randomizebatch(void **objs, uint32_t n, uint64_t *state);\n\nvoid ");
+
+    // mutatebatch and the mutate method of each param
+    strcat(methods, name);
+    strcat(methods, "_mutatebatch(void **objs, uint32_t n, uint64_t *state);\n\n");
+
+    for (uint32_t i = 0; i < num_params; i++) {
+
+        char* param_name = cJSON_GetObjectItem(cJSON_GetArrayItem(params, i), "name")->valuestring;
+
+        strcat(methods, "void ");
+        strcat(methods, name);
+        strcat(methods, "_");
+        strcat(methods, param_name);
+        strcat(methods, "_mutate(object_");
+        strcat(methods, name);
+        strcat(methods, "_str *o, uint64_t *state);\n\n");
+
+    }
+
+    // mutatorsobject and end of entire module
+    strcat(methods, "uint32_t ");
+    strcat(methods, name);
+    strcat(methods, "_mutatorsobject(void (**mutators)(void *, uint64_t *), uint32_t *weights);\n\n#endif /* MODULE_");
     strcat(methods, name);
     strcat(methods, "_H_ */");
 }
@@ -1683,7 +3786,7 @@ void create_c_file(char* name, cJSON* params_json) {
     char filename[19]; 
     char header[200];
     char includes[200];
-    char methods[5000];
+    char methods[20000];
 
     // form new filenamme to be created
     strcpy(filename, "../module/");
@@ -1765,9 +3868,16 @@ void create_h_file(char* name, cJSON* params_json) {
     // load content into master strings
     header_module_h(name, header);
     create_includes_h(name, includes);
-    create_new_structs(name, new_structs, params_json);
-    create_new_type(name, object, params_json);
-    create_macros(name, macros, params_json);
+    if (create_is_compact(params_json)) {
+        strcpy(new_structs, "");
+        create_compact_type(name, object, params_json);
+        create_compact_macros(name, macros, params_json);
+    }
+    else {
+        create_new_structs(name, new_structs, params_json);
+        create_new_type(name, object, params_json);
+        create_macros(name, macros, params_json);
+    }
     create_methods_end_h(name, methods, params_json);
 
     // concatenate all sub-master strings into master
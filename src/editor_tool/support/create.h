@@ -267,6 +267,104 @@ void create_new_type(char* name, char* object, cJSON* root);
 
 void create_macros(char* name, char* macros, cJSON* root);
 
+/*
+ * NAME
+ *
+ *   create_is_compact
+ *
+ * DESCRIPTION
+ *
+ *  Whether the object of a params file asks for a compact module,
+ *  one flat struct per object with the valid values of its
+ *  constrained params in static const tables
+ *
+ * PARAMETERS
+ *
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  bool
+ *
+ * EXAMPLE
+ *
+ *  bool compact = create_is_compact(params_json);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool create_is_compact(cJSON* root);
+
+/*
+ * NAME
+ *
+ *   create_compact_type
+ *
+ * DESCRIPTION
+ *
+ *  Creates the new object type of a compact module, one flat
+ *  struct holding unconstrained params by value and constrained
+ *  params as a bit field indexing a static const table of their
+ *  valid values, which is created after the struct
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* object
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_type(name, object, params_json);
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "object" parameter, exits if a param cannot be stored in the struct
+ *
+ */
+
+void create_compact_type(char* name, char* object, cJSON* root);
+
+/*
+ * NAME
+ *
+ *   create_compact_macros
+ *
+ * DESCRIPTION
+ *
+ *  Creates the macros for getting and setting each of the
+ *  parameters of a compact object. The value of a constrained
+ *  param is read through its table, and set through its index
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* macros
+ *  cJSON* root
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_macros(name, macros, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "macros" parameter
+ *
+ */
+
+void create_compact_macros(char* name, char* macros, cJSON* root);
+
 /*
  * NAME
  *
@@ -548,6 +646,485 @@ void create_readobject(char* name, char* methods, cJSON* params_json);
 
 void create_copyobject(char* name, char* methods, cJSON* params_json);
 
+/*
+ * NAME
+ *
+ *   create_hashobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new hashobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_hashobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_hashobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_equalobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new equalobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_equalobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_equalobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_fieldsobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new fieldsobject method, which gives the number of
+ *  uint32_t fields a gene is encoded into and the range of each of them
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_fieldsobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_fieldsobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_encodeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new encodeobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_encodeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_encodeobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_decodeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new decodeobject method
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_decodeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_decodeobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_compact_createobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new createobject method for a compact
+ *  object, a single malloc with every param set to its default
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_createobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_createobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_compact_randomizeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new randomizeobject method for a compact
+ *  object, constrained params draw a new index into their table
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_randomizeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_randomizeobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_compact_deleteobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new deleteobject method for a compact
+ *  object, which only has the object itself to free
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_deleteobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_deleteobject(char* name, char* methods);
+
+/*
+ * NAME
+ *
+ *   create_compact_readobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new readobject method for a compact
+ *  object, a fixed size read of what writeobject wrote
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_readobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_readobject(char* name, char* methods);
+
+/*
+ * NAME
+ *
+ *   create_compact_copyobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new copyobject method for a compact
+ *  object, a single malloc and memcpy
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_copyobject(name, methods)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_copyobject(char* name, char* methods);
+
+/*
+ * NAME
+ *
+ *   create_compact_decodeobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new decodeobject method for a compact
+ *  object, constrained params are decoded into their index
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_compact_decodeobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_compact_decodeobject(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_randomizebatch
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new randomizebatch method, a kernel that
+ *  draws every param of n objects from a caller owned generator
+ *  instead of calling rand() several times per object
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_randomizebatch(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_randomizebatch(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_mutatebatch
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new mutatebatch method, a kernel that
+ *  mutates one param of each of n objects through its mutate
+ *  method, the param picked by weight from a caller owned generator
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_mutatebatch(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter, exits if every param has a weight of 0
+ *
+ */
+
+void create_mutatebatch(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_param_mutators
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create one mutate method per param, each drawing a
+ *  new value for its param from a caller owned generator. Integers
+ *  take a gaussian step of the param's step, reflected back into
+ *  its range, ordered constrained params move to a neighboring
+ *  valid value and categorical ones swap to any other value
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_param_mutators(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter, exits if a param has a step that does not fit a uint32_t
+ *
+ */
+
+void create_param_mutators(char* name, char* methods, cJSON* params_json);
+
+/*
+ * NAME
+ *
+ *   create_mutatorsobject
+ *
+ * DESCRIPTION
+ *
+ *  Helper to create a new mutatorsobject method, which lists the
+ *  mutate method of every param along with its weight so that the
+ *  mutation operators can pick which param of a node changes
+ *
+ * PARAMETERS
+ *
+ *  char* name
+ *  char* methods
+ *  cJSON* params_json
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  create_mutatorsobject(name, methods, params_json)
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the "methods" parameter
+ *
+ */
+
+void create_mutatorsobject(char* name, char* methods, cJSON* params_json);
+
 /*
  * NAME
  *
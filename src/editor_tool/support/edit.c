@@ -403,7 +403,23 @@ void edit_modules_c_get_item(char* name, char* item, uint32_t index) {
     strcat(item, name);
     strcat(item, "_readobject,\n\t\t");
     strcat(item, name);
-    strcat(item, "_copyobject,\n\t},\n");
+    strcat(item, "_copyobject,\n\t\tNULL,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_hashobject,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_equalobject,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_fieldsobject,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_encodeobject,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_decodeobject,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_randomizebatch,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_mutatebatch,\n\t\t");
+    strcat(item, name);
+    strcat(item, "_mutatorsobject,\n\t},\n");
 
 }
 
@@ -447,7 +463,7 @@ bool edit_modules_c_read(char* name, char* content) {
     // declare and initialize needed variables
     uint32_t num = 0;
     char content_temp[1000];
-    char item[300];
+    char item[1000];
     strcpy(item, "");
     strcpy(content_temp, "");
     char temp_name[100];
@@ -564,7 +580,10 @@ bool edit_modules_c_read(char* name, char* content) {
  *      - new object_function_str in the object_table_function
  *        that has the new enum number, enum string (<name>),
  *        createobject, deleteobject, printobect, writeobject,
- *        readobject, and copyobject methods
+ *        readobject, copyobject, hashobject, equalobject,
+ *        fieldsobject, encodeobject and decodeobject methods
+ *        the randomizebatch and mutatebatch kernels and
+ *        the mutatorsobject method
  *      - increase of MAXTYPE by 1 
  *
  * PARAMETERS
@@ -614,8 +633,8 @@ void edit_modules_c(char* name) {
  *
  * DESCRIPTION
  *
- *  Creates build statement for new Shackleton object
- *  type and adds it to the new makefile
+ *  Creates build statements for new Shackleton object
+ *  type and its fitness file and adds them to the new makefile
  *
  * PARAMETERS
  *
@@ -632,7 +651,7 @@ void edit_modules_c(char* name) {
  *
  * SIDE-EFFECT
  *
- *  Adds new build statement to makefile
+ *  Adds new build statements to makefile
  *
  */
 
@@ -646,7 +665,16 @@ void edit_add_build_statement(char* name, char* stmt) {
     strcat(stmt, name);
     strcat(stmt, ".c $(SRCDIR)/module/");
     strcat(stmt, name);
-    strcat(stmt, ".h\n\tcc -c $(SRCDIR)/module/");
+    strcat(stmt, ".h\n\tcc $(CFLAGS) -c $(SRCDIR)/module/");
+    strcat(stmt, name);
+    strcat(stmt, ".c -o $@\n\n");
+
+    // the fitness file of the new type is built on its own
+    strcat(stmt, "$(OBJDIR)/fitness_");
+    strcat(stmt, name);
+    strcat(stmt, ".o : $(SRCDIR)/evolution/fitness_");
+    strcat(stmt, name);
+    strcat(stmt, ".c $(SRCDIR)/evolution/fitness.h\n\tcc $(CFLAGS) -c $(SRCDIR)/evolution/fitness_");
     strcat(stmt, name);
     strcat(stmt, ".c -o $@\n\n");
 
@@ -693,6 +721,11 @@ bool edit_makefile_read(char* name, char* content) {
     strcpy(obj, name);
     strcat(obj, ".o");
 
+    char fitness_obj[100];
+    strcpy(fitness_obj, "fitness_");
+    strcat(fitness_obj, name);
+    strcat(fitness_obj, ".o");
+
     // open the makefile for reading
     stream = fopen("../../makefile", "r");
 
@@ -722,11 +755,13 @@ bool edit_makefile_read(char* name, char* content) {
                     return false;
 
                 }
-                // always add new .o file just before evolution.o
+                // always add new .o files just before evolution.o
                 else if (strcmp(temp, "evolution.o") == 0) {
 
                     strcat(content, obj);
                     strcat(content, " ");
+                    strcat(content, fitness_obj);
+                    strcat(content, " ");
 
                 }
 
@@ -741,7 +776,7 @@ bool edit_makefile_read(char* name, char* content) {
         else if (strstr(line, "$(OBJDIR)/evolution.o") != NULL) {
 
             // always add the new build statement just before that for evolution.o
-            char stmt[500];
+            char stmt[1000];
             edit_add_build_statement(name, stmt);
             strcat(content, stmt);
             strcat(content, line);
@@ -773,9 +808,9 @@ bool edit_makefile_read(char* name, char* content) {
  *
  *  Takes the existing makefile and creates a new
  *  version with all the existing information plus the following:
- *      - adds <name>.o to the OBJS declaration
- *      - adds a line for the command line argument for building
- *        the new object type
+ *      - adds <name>.o and fitness_<name>.o to the OBJS declaration
+ *      - adds lines for the command line arguments for building
+ *        the new object type and its fitness file
  *
  * PARAMETERS
  *
@@ -798,7 +833,7 @@ bool edit_makefile_read(char* name, char* content) {
 void edit_makefile(char* name) {
 
     // create and clear master content string
-    char content[10000];
+    char content[100000];
     strcpy(content, "");
 
     // content is created here, returns false if it fails for some reason
@@ -809,7 +844,7 @@ void edit_makefile(char* name) {
     if (success) {
 
         FILE *new;
-        new = fopen("../makefile", "w");
+        new = fopen("../../makefile", "w");
         fputs(content, new);
         fclose(new);
 
@@ -820,12 +855,13 @@ void edit_makefile(char* name) {
 /*
  * NAME
  *
- *   edit_fitness_new_h_method
+ *   edit_fitness_new_entry
  *
  * DESCRIPTION
  *
- *  Creates the new method definition for fitness method
- *  for a new type
+ *  Creates the content of the fitness file for a new type,
+ *  a default fitness method along with a constructor that
+ *  registers it as the fitness entry of the type
  *
  * PARAMETERS
  *
@@ -838,7 +874,7 @@ void edit_makefile(char* name) {
  *
  * EXAMPLE
  *
- *  edit_fitness_new_h_method(name, content);
+ *  edit_fitness_new_entry(name, content);
  *
  * SIDE-EFFECT
  *
@@ -846,7 +882,23 @@ void edit_makefile(char* name) {
  *
  */
 
-void edit_fitness_new_h_method(char* name, char* content) {
+void edit_fitness_new_entry(char* name, char* content) {
+
+    // the entry is registered under the name of the type in the module table
+    char upper_name[100];
+    strcpy(upper_name, name);
+    strupr(upper_name);
+
+    // header of the new file
+    strcat(content, "/*\n");
+    strcat(content, " * fitness_");
+    strcat(content, name);
+    strcat(content, ".c\n");
+    strcat(content, " *\n");
+    strcat(content, " * Created on: <created_date>\n");
+    strcat(content, " * Author: Auto-generated fitness file using Shackleton tool\n");
+    strcat(content, " */\n\n");
+    strcat(content, "#include \"fitness.h\"\n\n");
 
     // create the block comment that describes the new method
     strcat(content, "/*\n");
@@ -865,18 +917,20 @@ void edit_fitness_new_h_method(char* name, char* content) {
     strcat(content, " *\n");
     strcat(content, " *  node_str* indiv - the individual that is to be evaluated\n");
     strcat(content, " *  bool vis - whether or not visualization is enabled\n");
+    strcat(content, " *  char* test_file, char** src_files, uint32_t num_src_files,\n");
+    strcat(content, " *  bool cache, char* cache_file - unused for this type\n");
     strcat(content, " *\n");
     strcat(content, " * RETURN\n");
     strcat(content, " *\n");
-    strcat(content, " *  uint32_t - the fitness value for indiv\n");
+    strcat(content, " *  double - the fitness value for indiv\n");
     strcat(content, " *\n");
     strcat(content, " * EXAMPLE\n");
     strcat(content, " *\n");
-    strcat(content, " * uint32_t ");
+    strcat(content, " * double ");
     strcat(content, name);
     strcat(content, "_fit = fitness_");
     strcat(content, name);
-    strcat(content, "(node, true);\n");
+    strcat(content, "(node, true, NULL, NULL, 0, false, NULL);\n");
     strcat(content, " *\n");
     strcat(content, " * SIDE-EFFECT\n");
     strcat(content, " *\n");
@@ -884,532 +938,123 @@ void edit_fitness_new_h_method(char* name, char* content) {
     strcat(content, " *\n");
     strcat(content, " */\n\n");
 
-    // add the actual method definition
-    strcat(content, "uint32_t fitness_");
+    // add the actual method
+    strcat(content, "double fitness_");
     strcat(content, name);
-    strcat(content, "(node_str* indiv, bool vis);\n\n");
-
-}
-
-/*
- * NAME
- *
- *  edit_fitness_h_read
- *
- * DESCRIPTION
- *
- *  Helper for edit_fitness_h method that reads the contents
- *  of the original fitness.h file into a content string
- *
- * PARAMETERS
- *
- *  char* name
- *  char* content
- *
- * RETURN
- *
- *  bool
- *
- * EXAMPLE
- *
- *  edit_fitness_h_read(name, content);
- *
- * SIDE-EFFECT
- *
- *  Edits the content variable
- *
- */
-
-bool edit_fitness_h_read(char* name, char* content) {
-
-    // variables needed for reading through file
-    FILE *fitness;
-    char* line = NULL;
-    size_t len = 0;
-    size_t read;
-
-    // declare and initialize needed variables
-    char desc_temp[1000];
-    strcpy(desc_temp, "");
-
-    // booleans for checking end conditions
-    bool at_function_pointers = false;
-    bool pointer_added = false;
-    bool at_new_method = false;
-    bool done = false;
-
-    // need to form a check for if type already exists
-    char fp_stmt[200];
-    strcpy(fp_stmt, "uint32_t (*fpfitness_");
-    strcat(fp_stmt, name);
-    strcat(fp_stmt, ")");
-
-    // open fitness.h to read through
-    fitness = fopen("../evolution/fitness.h", "r");
-
-    if (fitness == NULL) {
-        exit(EXIT_FAILURE);
-    }
-
-    // read fitness.h line by line
-    while ((read = getline(&line, &len, fitness)) != -1) {
-
-        // everything new has been added, copy rest as is
-        if (done) {
-
-            strcat(content, line);
-
-        }
-        // pointer declaration was added, now need to add new method
-        else if (pointer_added) {
-
-            // reached end of method that wasn't fitness_top, add as is
-            if (strstr(line, "/*") != NULL) {
-                
-                strcat(content, desc_temp);
-                strcpy(desc_temp, line);
-
-            }
-            // add new method just before the fitness_top method
-            else if (strstr(line, "fitness_top")) {
-
-                edit_fitness_new_h_method(name, content);
-                strcat(content, desc_temp);
-                strcat(content, line);
-                done = true;
-
-            }
-            // save everything until an end condition in case it needs to be
-            // added after the new method has been appended
-            else {
-
-                strcat(desc_temp, line);
-            
-            }
-
-        }
-        // searching for the function pointer declarations
-        else if (strstr(line, "uint32_t (*") != NULL) {
-
-            // type already exists, return failure and make no change
-            if (strstr(line, fp_stmt) != NULL) {
-
-                free(line);
-                fclose(fitness);
-                return false;
-
-            }
-
-            // found function pointers, set flag to true
-            strcat(desc_temp, line);
-            at_function_pointers = true;
-
-        }
-        // just add the line as is
-        else {
-            
-            // this means we have gone through all existing function pointers
-            // so we need to append the new one
-            if (at_function_pointers) {
-                
-                strcat(content, desc_temp);
-                strcpy(desc_temp, "");
-                strcat(content, "uint32_t (*fpfitness_");
-                strcat(content, name);
-                strcat(content, ")(node_str *n, bool vis);\n\n");
-
-                // set flag to move on to next searching element
-                pointer_added = true;
-                at_function_pointers = false;
-
-            }
-            else {
-
-                // save in desc_temp in case it needs to be appended after a new portion
-                strcat(desc_temp, line);
-
-            }
-
-        }
-
-    }
-
-    // free line and close, return true for success
-    free(line);
-    fclose(fitness);
-
-    return true;
-
-}
-
-/*
- * NAME
- *
- *  edit_fitness_h
- *
- * DESCRIPTION
- *
- *  Takes the existing fitness.h file, reads through it line
- *  by line, and inserts the new items needed for the new
- *  module type being created, namely:
- *      - adding a new function pointer declaration at
- *        the top of the file
- *      - creating a new method definition for the method
- *        specific to the new object type
- *
- * PARAMETERS
- *
- *  char* name
- *
- * RETURN
- *
- *  none
- *
- * EXAMPLE
- *
- *  edit_fitness_h(name);
- *
- * SIDE-EFFECT
- *
- *  Edits the fitness.h file
- *
- */
-
-void edit_fitness_h(char* name) {
-
-    // declare and clear content string variable
-    char content[100000];
-    strcpy(content, "");
-
-    // content is created here, false if could not add for some reason
-    bool success = edit_fitness_h_read(name, content);
-
-    // if created fitness_h was successful, go ahead with 
-    // clearing and adding the updated content to fitness.h
-    if (success) {
-
-        FILE *new;
-        new = fopen("../evolution/fitness.h", "w");
-        fputs(content, new);
-        fclose(new);
-
-    }
-
-}
+    strcat(content, "(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {\n\n");
+    strcat(content, "\treturn 100;\n\n}\n\n");
 
-/*
- * NAME
- *
- *  edit_fitness_new_c_method
- *
- * DESCRIPTION
- *
- *  Creates the new method definition for fitness method
- *  for a new type
- *
- * PARAMETERS
- *
- *  char* name
- *  char* content
- *
- * RETURN
- *
- *  void
- *
- * EXAMPLE
- *
- *  edit_fitness_new_c_method(name, content);
- *
- * SIDE-EFFECT
- *
- *  Edits the content variable
- *
- */
-
-void edit_fitness_new_c_method(char* name, char* content) {
-
-    // create the block comment for the new methof being added
+    // the constructor runs before main, so the entry is in
+    // the registry before fitness_setup looks up the types
     strcat(content, "/*\n");
     strcat(content, " * NAME\n");
     strcat(content, " *\n");
     strcat(content, " *   fitness_");
     strcat(content, name);
-    strcat(content, "\n *\n");
+    strcat(content, "_register\n");
+    strcat(content, " *\n");
     strcat(content, " * DESCRIPTION\n");
     strcat(content, " *\n");
-    strcat(content, " * Calculates the fitness value specifically for an ");
+    strcat(content, " * Registers fitness_");
     strcat(content, name);
-    strcat(content, "\n * inidividual, currently is only a default. AUTO-GENERATED\n");
+    strcat(content, " as the fitness entry of the\n");
+    strcat(content, " * ");
+    strcat(content, upper_name);
+    strcat(content, " type before main runs. AUTO-GENERATED\n");
     strcat(content, " *\n");
     strcat(content, " * PARAMETERS\n");
     strcat(content, " *\n");
-    strcat(content, " *  node_str* indiv - the individual that is to be evaluated\n");
-    strcat(content, " *  bool vis - whether or not visualization is enabled\n");
+    strcat(content, " *  none\n");
     strcat(content, " *\n");
     strcat(content, " * RETURN\n");
     strcat(content, " *\n");
-    strcat(content, " *  uint32_t - the fitness value for indiv\n");
+    strcat(content, " *  none\n");
     strcat(content, " *\n");
     strcat(content, " * EXAMPLE\n");
     strcat(content, " *\n");
-    strcat(content, " * uint32_t ");
-    strcat(content, name);
-    strcat(content, "_fit = fitness_");
-    strcat(content, name);
-    strcat(content, "(node, true);\n");
+    strcat(content, " * called by the loader, never directly\n");
     strcat(content, " *\n");
     strcat(content, " * SIDE-EFFECT\n");
     strcat(content, " *\n");
-    strcat(content, " * none\n");
+    strcat(content, " * adds an entry to the fitness registry\n");
     strcat(content, " *\n");
     strcat(content, " */\n\n");
 
-    // add the default method itself, will always return 100 if left unchanged
-    strcat(content, "uint32_t fitness_");
+    strcat(content, "__attribute__((constructor)) void fitness_");
+    strcat(content, name);
+    strcat(content, "_register(void) {\n\n");
+    strcat(content, "\tfitness_entry_str entry = { \"");
+    strcat(content, upper_name);
+    strcat(content, "\", NULL, fitness_");
     strcat(content, name);
-    strcat(content, "(node_str* indiv, bool vis) {\n\n\treturn 100;\n\n}\n\n");
+    strcat(content, ", NULL, NULL, FITNESS_MINIMIZE };\n");
+    strcat(content, "\tfitness_register(&entry);\n\n}\n");
 
 }
 
 /*
  * NAME
  *
- *  edit_fitness_c_read
+ *  edit_fitness_entry
  *
  * DESCRIPTION
  *
- *  Helper for edit_fitness_c method that reads the contents
- *  of the original fitness.c file into a content string
+ *  Creates the evolution/fitness_<name>.c file holding the
+ *  fitness method of the new type and its registration, so
+ *  fitness.c and fitness.h are left as they are
  *
  * PARAMETERS
  *
  *  char* name
- *  char* content
  *
  * RETURN
  *
- *  bool
+ *  none
  *
  * EXAMPLE
  *
- *  edit_fitness_c_read(name, content);
+ *  edit_fitness_entry(name);
  *
  * SIDE-EFFECT
  *
- *  Edits the content variable
+ *  Creates the fitness_<name>.c file if it does not exist yet
  *
  */
 
-bool edit_fitness_c_read(char* name, char* content) {
-
-    // variables needed for reading through file
-    FILE *fitness;
-    char* line = NULL;
-    size_t len = 0;
-    size_t read;
-
-    // declare and initialize needed variables
-    char desc_temp[50000];
-    strcpy(desc_temp, "");
-    uint32_t curr_num = 0;
-
-    // booleans for checking end conditions
-    bool at_fpfitness_defines = false;
-    bool conditional_added = false;
-    bool adding_conditional = false;
-    bool done = false;
-
-    // open fitness.c to read through
-    fitness = fopen("../evolution/fitness.c", "r");
-
-    if (fitness == NULL) {
-        exit(EXIT_FAILURE);
-    }
-
-    // read fitness.c line by line
-    while ((read = getline(&line, &len, fitness)) != -1) {
+void edit_fitness_entry(char* name) {
 
-        // all new items have been added, just use the rest as is
-        if (done) {
+    char file_name[200];
+    strcpy(file_name, "../evolution/fitness_");
+    strcat(file_name, name);
+    strcat(file_name, ".c");
 
-            strcat(content, line);
+    // type already has a fitness file, make no change
+    FILE *existing = fopen(file_name, "r");
 
-        }
-        // at the fpfitness initialization lines in fitness_setup
-        else if (at_fpfitness_defines) {
-
-            // for each fpfitness line, add as is 
-            if (strstr(line, "fpfitness") != NULL) {
-                
-                strcat(content, line);
+    if (existing != NULL) {
 
-            }
-            // until you've saved them all, now add new initialization for new item
-            else {
-
-                strcat(content, "\tfpfitness_");
-                strcat(content, name);
-                strcat(content, " = &fitness_");
-                strcat(content, name);
-                strcat(content, ";\n");
-                strcat(content, line);
-                done = true;
-
-            }
-
-        }
-        // condition within fitness_top was successfully added
-        // now search for the function pointer initializations in fitness_setup
-        else if (conditional_added) {
-
-            // within the fitness_setup method
-            if (strstr(line, "fpfitness") != NULL) {
-                
-                at_fpfitness_defines = true;
-
-            }
-
-            strcat(content, line);
-
-        }
-        // inside fitness_top method
-        else if (adding_conditional) {
-
-            // if reach the else {, this is where new conditional
-            // statement needs to be added
-            if (strstr(line, "else {") != NULL) {
-
-                char number[2];
-                sprintf(number, "%d", curr_num);
-
-                strcat(content, "\telse if (type == ");
-                strcat(content, number);
-                strcat(content, ") {\n\t\treturn fitness_");
-                strcat(content, name);
-                strcat(content, "(indiv, vis);\n\t}\n");
-                strcat(content, line);
-
-                // successfully added, moving on
-                conditional_added = true;
-
-            }
-            else {
-
-                // if a closing bracket is found, we had a conditional
-                // for an existing type, increment curr_num to keep track
-                if (strstr(line, "}") != NULL) {
-
-                    curr_num = curr_num + 1;
-
-                }
-
-                strcat(content, line);
-
-            }
-
-        }
-        // looking first for the fitness_top method,
-        // new method will be added just before it
-        else {
-            
-            // fitness_top method found, add new method and then add info 
-            // gotten up to this point for the fitness_top method
-            if (strstr(line, "fitness_top") != NULL) {
-                
-                edit_fitness_new_c_method(name, content);
-                strcat(content, desc_temp);
-                strcpy(desc_temp, "");
-
-                // next, will add conditional within fitness_top
-                adding_conditional = true;
-
-            }
-            // this means a method other than fitness_top was found
-            // and fully processed, add to content and clear desc_temo
-            else if (strstr(line, "/*") != NULL) {
-
-                strcat(content, desc_temp);
-                strcpy(desc_temp, line);
-
-            }
-            // type already exists, return failure and make no change
-            else if (strstr(line, name) != NULL) {
-
-                free(line);
-                fclose(fitness);
-                return false;
-
-            }
-            // keep track of information as you go
-            // in case it needs to be added after new content
-            else {
-
-                strcat(desc_temp, line);
-
-            }
-
-        }
+        fclose(existing);
+        return;
 
     }
 
-    // free line and close, return true for success
-    free(line);
-    fclose(fitness);
-
-    //return true, indicates success
-    return true;
-
-}
-
-/*
- * NAME
- *
- *  edit_fitness_c
- *
- * DESCRIPTION
- *
- *  Takes the existing fitness.c file, reads through it line
- *  by line, and inserts the new items needed for the new
- *  module type being created
- *
- * PARAMETERS
- *
- *  char* name
- *
- * RETURN
- *
- *  none
- *
- * EXAMPLE
- *
- *  edit_fitness_c(name);
- *
- * SIDE-EFFECT
- *
- *  Edits the fitness.c file
- *
- */
-
-void edit_fitness_c(char* name) {
-
     // declare and clear content string variable
-    char content[100000];
+    char content[10000];
     strcpy(content, "");
 
-    // content is created here, false if could not add for some reason
-    bool success = edit_fitness_c_read(name, content);
+    edit_fitness_new_entry(name, content);
 
-    // if created fitness_c was successful, go ahead with 
-    // clearing and adding the updated content to fitness.c
-    if (success) {
-
-        FILE *new;
-        new = fopen("../evolution/fitness.c", "w");
-        fputs(content, new);
-        fclose(new);
+    FILE *new;
+    new = fopen(file_name, "w");
 
+    if (new == NULL) {
+        printf("error: could not create %s [file:'%s',line:%d]\n", file_name, __FILE__, __LINE__);
+        exit(0);
     }
 
+    fputs(content, new);
+    fclose(new);
+
 }
 
 /*
@@ -1442,8 +1087,8 @@ void edit_fitness_c(char* name) {
  *      - module/modules.c
  *      - module/modules.h
  *      - makefile
- *      - evolution/fitness.h
- *      - evolution/fitness.c
+ *  Creates the following file:
+ *      - evolution/fitness_<name>.c
  *
  */
 
@@ -1453,7 +1098,6 @@ void edit_existing_files(char* name) {
     edit_modules_h(name);
     edit_modules_c(name);
     edit_makefile(name);
-    edit_fitness_h(name);
-    edit_fitness_c(name);
+    edit_fitness_entry(name);
 
 }
\ No newline at end of file
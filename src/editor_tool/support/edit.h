@@ -274,8 +274,8 @@ void edit_modules_c(char* name);
  *
  * DESCRIPTION
  *
- *  Creates build statement for new Shackleton object
- *  type and adds it to the new makefile
+ *  Creates build statements for new Shackleton object
+ *  type and its fitness file and adds them to the new makefile
  *
  * PARAMETERS
  *
@@ -292,7 +292,7 @@ void edit_modules_c(char* name);
  *
  * SIDE-EFFECT
  *
- *  Adds new build statement to makefile
+ *  Adds new build statements to makefile
  *
  */
 
@@ -338,9 +338,9 @@ bool edit_makefile_read(char* name, char* content);
  *
  *  Takes the existing makefile and creates a new
  *  version with all the existing information plus the following:
- *      - adds <name>.o to the OBJS declaration
- *      - adds a line for the command line argument for building
- *        the new object type
+ *      - adds <name>.o and fitness_<name>.o to the OBJS declaration
+ *      - adds lines for the command line arguments for building
+ *        the new object type and its fitness file
  *
  * PARAMETERS
  *
@@ -365,12 +365,13 @@ void edit_makefile(char* name);
 /*
  * NAME
  *
- *   edit_fitness_new_h_method
+ *   edit_fitness_new_entry
  *
  * DESCRIPTION
  *
- *  Creates the new method definition for fitness method
- *  for a new type
+ *  Creates the content of the fitness file for a new type,
+ *  a default fitness method along with a constructor that
+ *  registers it as the fitness entry of the type
  *
  * PARAMETERS
  *
@@ -383,7 +384,7 @@ void edit_makefile(char* name);
  *
  * EXAMPLE
  *
- *  edit_fitness_new_h_method(name, content);
+ *  edit_fitness_new_entry(name, content);
  *
  * SIDE-EFFECT
  *
@@ -391,111 +392,18 @@ void edit_makefile(char* name);
  *
  */
 
-void edit_fitness_new_h_method(char* name, char* content);
+void edit_fitness_new_entry(char* name, char* content);
 
 /*
  * NAME
  *
- *   edit_fitness_h_read
+ *  edit_fitness_entry
  *
  * DESCRIPTION
  *
- *  Helper for edit_fitness_h method that reads the contents
- *  of the original fitness.h file into a content string
- *
- * PARAMETERS
- *
- *  char* name
- *  char* content
- *
- * RETURN
- *
- *  bool
- *
- * EXAMPLE
- *
- * edit_fitness_h_read(name, content);
- *
- * SIDE-EFFECT
- *
- *  Edits the content variable
- *
- */
-
-bool edit_fitness_h_read(char* name, char* content);
-
-/*
- * NAME
- *
- *   edit_fitness_h
- *
- * DESCRIPTION
- *
- *  Takes the existing fitness.h file, reads through it line
- *  by line, and inserts the new items needed for the new
- *  module type being created
- *
- * PARAMETERS
- *
- *  char* name
- *
- * RETURN
- *
- *  none
- *
- * EXAMPLE
- *
- * edit_fitness_h(name);
- *
- * SIDE-EFFECT
- *
- *  Edits the fitness.h file
- *
- */
-
-void edit_fitness_h(char* name);
-
-/*
- * NAME
- *
- *   edit_fitness_c_read
- *
- * DESCRIPTION
- *
- *  Helper for edit_fitness_c method that reads the contents
- *  of the original fitness.c file into a content string
- *
- * PARAMETERS
- *
- *  char* name
- *  char* content
- *
- * RETURN
- *
- *  bool
- *
- * EXAMPLE
- *
- * edit_fitness_c_read(name, content);
- *
- * SIDE-EFFECT
- *
- *  Edits the content variable
- *
- */
-
-bool edit_fitness_c_read(char* name, char* content);
-
-/*
- * NAME
- *
- *   edit_fitness_c
- *
- * DESCRIPTION
- *
- *  Takes the existing fitness.c file, reads through it line
- *  by line, and inserts the new items needed for the new
- *  module type being created
+ *  Creates the evolution/fitness_<name>.c file holding the
+ *  fitness method of the new type and its registration, so
+ *  fitness.c and fitness.h are left as they are
  *
  * PARAMETERS
  *
@@ -507,15 +415,15 @@ bool edit_fitness_c_read(char* name, char* content);
  *
  * EXAMPLE
  *
- * edit_fitness_c(name);
+ *  edit_fitness_entry(name);
  *
  * SIDE-EFFECT
  *
- *  Edits the fitness.c file
+ *  Creates the fitness_<name>.c file if it does not exist yet
  *
  */
 
-void edit_fitness_c(char* name);
+void edit_fitness_entry(char* name);
 
 /*
  * NAME
@@ -547,6 +455,8 @@ void edit_fitness_c(char* name);
  *      - module/modules.c
  *      - module/modules.h
  *      - makefile
+ *  Creates the following file:
+ *      - evolution/fitness_<name>.c
  *
  */
 
@@ -72,7 +72,7 @@
 void crossover_onepoint_macro(node_str* osaka1, node_str* osaka2, bool vis) {
 
     if (vis) {
-        printf("\nPerforming onepoint crossover on individuals starting at %d and %d ---------------------\n", UID(osaka1), UID(osaka2));
+        output_printf(stdout, "\nPerforming onepoint crossover on individuals starting at %d and %d ---------------------\n", UID(osaka1), UID(osaka2));
     }
 
     uint32_t random = 1;
@@ -80,9 +80,9 @@ void crossover_onepoint_macro(node_str* osaka1, node_str* osaka2, bool vis) {
     uint32_t osaka2_length = osaka_listlength(osaka2);
 
     if (vis) {
-        printf("\n Individual 1 before crossover: ------------------------------------------------------\n\n");
+        output_printf(stdout, "\n Individual 1 before crossover: ------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka1);
-        printf("\n\n Individual 2 before crossover: ------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\n Individual 2 before crossover: ------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka2);
     }
 
@@ -100,44 +100,81 @@ void crossover_onepoint_macro(node_str* osaka1, node_str* osaka2, bool vis) {
     }
 
     if (vis) {
-        printf("\n\n------------------------- splitting is to be done at point %d -------------------------\n", random);
+        output_printf(stdout, "\n\n------------------------- splitting is to be done at point %d -------------------------\n", random);
 
-        printf("\nPlanned crossover points: ------------------------------------------------------------\n\n");
+        output_printf(stdout, "\nPlanned crossover points: ------------------------------------------------------------\n\n");
         visualization_print_individual_concise_details_to_nth(osaka1, random);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth(osaka1, random);
-        printf("\n\n");
+        output_printf(stdout, "\n\n");
         visualization_print_individual_concise_details_to_nth(osaka2, random);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth(osaka2, random);
     }
 
-    // the same point is used in both osaka sequences
-    node_str* nth_osaka1 = osaka_nthnode(osaka1, random);
-    node_str* nth_osaka2 = osaka_nthnode(osaka2, random);
-
-    // swap is implemented by changing the "last" and "next" pointers
-    // starting with the "next" pointers of the last nodes
-    node_str* osaka1_last = LAST(nth_osaka1);
-    node_str* osaka2_last = LAST(nth_osaka2);
-    NEXT(osaka1_last) = nth_osaka2;
-    NEXT(osaka2_last) = nth_osaka1;
-    // and then the "last" pointers of the current nodes
-    LAST(nth_osaka1) = osaka2_last;
-    LAST(nth_osaka2) = osaka1_last;
+    // the same point is used in both osaka sequences, the swap also
+    // keeps the list headers of both individuals up to date
+    osaka_swaptails(osaka1, osaka2, random);
 
     if (vis) {
-        printf("\n\nIndividual 1 after crossover: --------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\nIndividual 1 after crossover: --------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka1);
-        printf("\n\nIndividual 2 after crossover: --------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\nIndividual 2 after crossover: --------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka2);
-        printf("\n\n");
+        output_printf(stdout, "\n\n");
 
-        printf("\nCrossover complete -------------------------------------------------------------------\n\n");
+        output_printf(stdout, "\nCrossover complete -------------------------------------------------------------------\n\n");
     }
 
 }
 
+/*
+ * NAME
+ *
+ *   crossover_onepoint_state
+ *
+ * DESCRIPTION
+ *
+ *  Same splice as crossover_onepoint_macro, but the point is drawn
+ *  from a caller owned generator instead of rand(), so that worker
+ *  threads neither share the rand() lock nor depend on each other's
+ *  draws. Individuals shorter than 2 nodes are left as they are
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka1 -- the head of 1 osaka object
+ *  *node_str osaka2 -- the head of another osaka object
+ *  uint64_t* state -- generator state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * crossover_onepoint_state(osaka1, osaka2, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka1 and osaka2, advances the state
+ *
+ */
+
+void crossover_onepoint_state(node_str* osaka1, node_str* osaka2, uint64_t* state) {
+
+    uint32_t osaka1_length = osaka_listlength(osaka1);
+    uint32_t osaka2_length = osaka_listlength(osaka2);
+    uint32_t shortest = osaka1_length < osaka2_length ? osaka1_length : osaka2_length;
+
+    if (shortest < 2) {
+        return;
+    }
+
+    // point in [2, shortest], as the rejection loop of crossover_onepoint_macro
+    osaka_swaptails(osaka1, osaka2, bounded_rand(state, shortest - 1) + 2);
+
+}
+
 /*
  * NAME
  *
@@ -214,7 +251,7 @@ void crossover_twopoint_basic(node_str* osaka1, node_str* osaka2, bool vis) {
 void crossover_twopoint_diff(node_str* osaka1, node_str* osaka2, bool vis) {
 
     if (vis) {
-        printf("\nPerforming twopoint crossover on individuals starting at %d and %d ---------------------\n", UID(osaka1), UID(osaka2));
+        output_printf(stdout, "\nPerforming twopoint crossover on individuals starting at %d and %d ---------------------\n", UID(osaka1), UID(osaka2));
     }
 
     uint32_t random1;
@@ -223,9 +260,9 @@ void crossover_twopoint_diff(node_str* osaka1, node_str* osaka2, bool vis) {
     uint32_t osaka2_length = osaka_listlength(osaka2);
 
     if (vis) {
-        printf("\nIndividual 1 before crossover: -------------------------------------------------------\n\n");
+        output_printf(stdout, "\nIndividual 1 before crossover: -------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka1);
-        printf("\n\nIndividual 2 before crossover: -------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\nIndividual 2 before crossover: -------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka2);
     }
 
@@ -255,65 +292,96 @@ void crossover_twopoint_diff(node_str* osaka1, node_str* osaka2, bool vis) {
     }
 
     if (vis) {
-        printf("\n\n--------------------- splitting is to be done at points %d and %d ----------------------\n", random1, random2);
+        output_printf(stdout, "\n\n--------------------- splitting is to be done at points %d and %d ----------------------\n", random1, random2);
         uint32_t first = random1;
         uint32_t second = random2;
         if (random1 > random2) {
             first = random2;
             second = random1;
         }
-        printf("\nPlanned crossover points: ------------------------------------------------------------\n\n");
+        output_printf(stdout, "\nPlanned crossover points: ------------------------------------------------------------\n\n");
         visualization_print_individual_concise_details_to_nth(osaka1, first);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth_to_mth(osaka1, first, second);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth(osaka1, second);
 
-        printf("\n\n");
+        output_printf(stdout, "\n\n");
 
         visualization_print_individual_concise_details_to_nth(osaka2, first);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth_to_mth(osaka2, first, second);
-        printf(" <--///--> ");
+        output_printf(stdout, " <--///--> ");
         visualization_print_individual_concise_details_from_nth(osaka2, second);
     }
 
-    // the same point is used in both osaka sequences
-    node_str* nth_osaka1 = osaka_nthnode(osaka1, random1);
-    node_str* nth_osaka2 = osaka_nthnode(osaka2, random1);
-
-    // swap is implemented by changing the "last" and "next" pointers
-    // starting with the "next" pointers of the last nodes
-    node_str* osaka1_last = LAST(nth_osaka1);
-    node_str* osaka2_last = LAST(nth_osaka2);
-    NEXT(osaka1_last) = nth_osaka2;
-    NEXT(osaka2_last) = nth_osaka1;
-    // and then the "last" pointers of the current nodes
-    LAST(nth_osaka1) = osaka2_last;
-    LAST(nth_osaka2) = osaka1_last;
-
-    // the same point is used in both osaka sequences
-    node_str* nth_osaka3 = osaka_nthnode(osaka_findheadnode(nth_osaka1), random2);
-    node_str* nth_osaka4 = osaka_nthnode(osaka_findheadnode(nth_osaka2), random2);
-
-    // swap is implemented by changing the "last" and "next" pointers
-    // starting with the "next" pointers of the last nodes
-    node_str* osaka3_last = LAST(nth_osaka3);
-    node_str* osaka4_last = LAST(nth_osaka4);
-    NEXT(osaka3_last) = nth_osaka4;
-    NEXT(osaka4_last) = nth_osaka3;
-    // and then the "last" pointers of the current nodes
-    LAST(nth_osaka3) = osaka4_last;
-    LAST(nth_osaka4) = osaka3_last;
+    // the same point is used in both osaka sequences, swapping the tails
+    // at both points exchanges the segment between them
+    osaka_swaptails(osaka1, osaka2, random1);
+    osaka_swaptails(osaka1, osaka2, random2);
 
     if (vis) {
-        printf("\n\nIndividual 1 after crossover: --------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\nIndividual 1 after crossover: --------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka1);
-        printf("\n\nIndividual 2 after crossover: --------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\nIndividual 2 after crossover: --------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(osaka2);
-        printf("\n\n");
+        output_printf(stdout, "\n\n");
 
-        printf("\nCrossover complete -------------------------------------------------------------------\n\n");
+        output_printf(stdout, "\nCrossover complete -------------------------------------------------------------------\n\n");
     }
 
-}
\ No newline at end of file
+}
+
+/*
+ * NAME
+ *
+ *   crossover_onepoint_persistent
+ *
+ * DESCRIPTION
+ *
+ *  Persistent counterpart of crossover_onepoint_macro. Takes in two
+ *  persistent individuals and builds two children spliced at a single
+ *  random point. The children share their genes with the parents
+ *  instead of copying them, and the parents are left unchanged, so
+ *  there is no need to copy the parents before crossing them over.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str* osaka1 -- the first parent
+ *  persistent_str* osaka2 -- the second parent
+ *  persistent_str** child1 -- receives the first child
+ *  persistent_str** child2 -- receives the second child
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * crossover_onepoint_persistent(osaka1, osaka2, &child1, &child2, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates child1 and child2, to be released with osaka_persistent_release
+ *
+ */
+
+void crossover_onepoint_persistent(persistent_str* osaka1, persistent_str* osaka2, persistent_str** child1, persistent_str** child2, bool vis) {
+
+    uint32_t random = 1;
+    uint32_t shortest = PERSISTENT_LENGTH(osaka1) < PERSISTENT_LENGTH(osaka2) ? PERSISTENT_LENGTH(osaka1) : PERSISTENT_LENGTH(osaka2);
+
+    // same choice of point as crossover_onepoint_macro, never the first
+    // unit and never past the end of the shorter individual
+    while (random <= 1) {
+        random = (uint32_t) (shortest * (rand() / (RAND_MAX + 1.0))) + 1;
+    }
+
+    if (vis) {
+        output_printf(stdout, "\nPerforming persistent onepoint crossover, splitting is to be done at point %d ------------\n", random);
+    }
+
+    osaka_persistent_crossover(osaka1, osaka2, random, child1, child2);
+
+}
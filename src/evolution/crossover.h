@@ -37,6 +37,7 @@
  */
 
 #include "../osaka/osaka.h"
+#include "../osaka/osaka_persistent.h"
 #include "../support/visualization.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -78,6 +79,40 @@
 
 void crossover_onepoint_macro(node_str* osaka1, node_str* osaka2, bool vis);
 
+/*
+ * NAME
+ *
+ *   crossover_onepoint_state
+ *
+ * DESCRIPTION
+ *
+ *  Same splice as crossover_onepoint_macro, but the point is drawn
+ *  from a caller owned generator instead of rand(), so that worker
+ *  threads neither share the rand() lock nor depend on each other's
+ *  draws. Individuals shorter than 2 nodes are left as they are
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka1 -- the head of 1 osaka object
+ *  *node_str osaka2 -- the head of another osaka object
+ *  uint64_t* state -- generator state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * crossover_onepoint_state(osaka1, osaka2, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka1 and osaka2, advances the state
+ *
+ */
+
+void crossover_onepoint_state(node_str* osaka1, node_str* osaka2, uint64_t* state);
+
 /*
  * NAME
  *
@@ -144,4 +179,41 @@ void crossover_twopoint_basic(node_str* osaka1, node_str* osaka2, bool vis);
 
 void crossover_twopoint_diff(node_str* osaka1, node_str* osaka2, bool vis);
 
+/*
+ * NAME
+ *
+ *   crossover_onepoint_persistent
+ *
+ * DESCRIPTION
+ *
+ *  Persistent counterpart of crossover_onepoint_macro. Takes in two
+ *  persistent individuals and builds two children spliced at a single
+ *  random point. The children share their genes with the parents
+ *  instead of copying them, and the parents are left unchanged, so
+ *  there is no need to copy the parents before crossing them over.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str* osaka1 -- the first parent
+ *  persistent_str* osaka2 -- the second parent
+ *  persistent_str** child1 -- receives the first child
+ *  persistent_str** child2 -- receives the second child
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * crossover_onepoint_persistent(osaka1, osaka2, &child1, &child2, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates child1 and child2, to be released with osaka_persistent_release
+ *
+ */
+
+void crossover_onepoint_persistent(persistent_str* osaka1, persistent_str* osaka2, persistent_str** child1, persistent_str** child2, bool vis);
+
 #endif /* EVOLUTION_CROSSOVER_H_ */
\ No newline at end of file
@@ -34,10 +34,66 @@
 
 #include "evolution.h"
 
+/*
+ * STATIC
+ */
+
+// threads used by evolution_evaluate_generation, see evolution_set_workers
+static uint32_t evolution_num_workers = 1;
+
+// folder the run log is written to, see evolution_set_output_folder
+static char evolution_output_folder[EVOLUTION_MAX_PATH] = "";
+
 /*
  * ROUTINES
  */
 
+/*
+ * NAME
+ *
+ *   __evolution_evaluate_worker
+ *
+ * DESCRIPTION
+ *
+ *  Internal worker of evolution_evaluate_generation, claims the next
+ *  unevaluated individual with an atomic counter until none are left
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- evolution_evaluate_str* shared by all workers
+ *
+ * RETURN
+ *
+ *  void* -- NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&threads[t], NULL, __evolution_evaluate_worker, &args);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills in fitness values
+ *
+ */
+
+void* __evolution_evaluate_worker(void* arg) {
+
+    evolution_evaluate_str* args = arg;
+    uint32_t k;
+
+    while ((k = atomic_fetch_add(&args->next, 1)) < args->pop_size) {
+        INSTRUMENT_START(evaluation);
+        TRACE_START(evaluation);
+        args->fitness_values[k] = fitness_top(args->gen[k], false, args->file, args->src_files, args->num_src_files, false, NULL);
+        TRACE_STOP(evaluation, "evaluate", "evaluation");
+        INSTRUMENT_STOP(evaluation, INSTRUMENT_PHASE_EVALUATION);
+        INSTRUMENT_COUNT(INSTRUMENT_COUNTER_EVALUATIONS, 1);
+    }
+
+    return NULL;
+
+}
+
 /*
  * NAME
  *
@@ -45,17 +101,17 @@
  *
  * DESCRIPTION
  *
- *  For a given general, caches information on every individual
- *  and its fitness in a folder within run/
+ *  For a given generation, writes a record for every individual
+ *  with the fitness it was already given, and one for the best
+ *  individual, to the run log. Nothing is evaluated again
  *
  * PARAMETERS
  *
- *  char* main_folder - the folder in which the new file will be housed
+ *  runlog_str* log - the run log of this run
  *  uint32_t gen - the generation number within this run
  *  uint32_t pop_size - size of a single generation
  *  node_str** curr_gen - the current generation that is being cached
  *  bool vis - whether or not visualization is enabled
- *  char* file - the test file
  *  double* fitness_values - fitness values for every individual in the current generation
  *  osaka_object_typ ot - the object type that is being used for this run
  *
@@ -65,66 +121,102 @@
  *
  * EXAMPLE
  *
- *  evolution_cache_generation(main_folder_str, 5);
+ *  evolution_cache_generation(log, g, pop_size, current_generation, vis, fitness_values, ot);
  *
  * SIDE-EFFECT
  *
- *  Affects the value of main_folder variable
+ *  writes to the run log
  *
  */
 
-void evolution_cache_generation(char* main_folder, uint32_t gen, uint32_t pop_size, node_str** curr_gen, bool vis, char* file, char** src_files, uint32_t num_src_files, double* fitness_values, osaka_object_typ ot) {
+void evolution_cache_generation(runlog_str* log, uint32_t gen, uint32_t pop_size, node_str** curr_gen, bool vis, double* fitness_values, osaka_object_typ ot) {
 
-    char directory_name[70];
-    char generation_num[4];
+    uint32_t winner = 0;
+    double winner_value = fitness_values[0];
 
-    sprintf(generation_num, "%d", gen);
+    // every individual was already evaluated, only its record is written
+    for (uint32_t i = 0; i < pop_size; i++) {
 
-    strcpy(directory_name, main_folder);
-    strcat(directory_name, "/generation_");
-    strcat(directory_name, generation_num);
+        runlog_write_individual(log, gen, i, fitness_values[i], curr_gen[i]);
 
-    // for each individual, must create a file to cache their information
-    for (int i = 0; i < pop_size; i++) {
+        if (vis) {
+            output_printf(stdout, "\n\nfitness for %d is %f\n", i, fitness_values[i]);
+        }
 
-        char individual_num[4];
+    }
 
-        sprintf(individual_num, "%d", i);
+    // actually finding the individual with the best fitness
+    for (uint32_t j = 1; j < pop_size; j++) {
+        if (selection_compare_fitness(fitness_values[j], winner_value, ot)) {
+            winner = j;
+            winner_value = fitness_values[j];
+        }
+    }
 
-        char cache_file[100];
-        strcpy(cache_file, directory_name);
-        strcat(cache_file, "/individual");
-        strcat(cache_file, individual_num);
-        strcat(cache_file, ".txt");
+    output_printf(stdout, "\nbest fitness is that of %d, %f\n\n", winner, winner_value);
 
-        fitness_top(curr_gen[i], vis, file, src_files, num_src_files, true, cache_file);
+    runlog_write_best(log, gen, winner, winner_value);
 
-    }
+}
 
-    // add additional file for best individual in the generation
-    char best_file[100];
-    strcpy(best_file, directory_name);
-    strcat(best_file, "/best_individual.txt");
+/*
+ * NAME
+ *
+ *   evolution_trace_population
+ *
+ * DESCRIPTION
+ *
+ *  For a given generation, writes the best and mean fitness and the
+ *  diversity of the genes to the counter tracks of the trace. Only
+ *  does any work while tracing is on
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size - size of a single generation
+ *  uint32_t indiv_size - number of genes in every individual
+ *  node_str** curr_gen - the current generation
+ *  double* fitness_values - fitness values for every individual in the current generation
+ *  osaka_object_typ ot - the object type that is being used for this run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_trace_population(pop_size, indiv_size, current_generation, fitness_values, ot);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
 
-    uint32_t winner = 0;
-    double winner_value = fitness_values[0];
+void evolution_trace_population(uint32_t pop_size, uint32_t indiv_size, node_str** curr_gen, double* fitness_values, osaka_object_typ ot) {
 
-    // printing out fitness values for user's convenience, a sanity check
-    for (uint32_t i = 0; i < pop_size; i++) {
-        printf("\n\nfitness for %d is %f\n", i, fitness_values[i]);
+    if (!trace_enabled()) {
+        return;
     }
 
-    // actually finding the individual with the best fitness
-    for (uint32_t j = 1; j < pop_size; j++) {
-        if (selection_compare_fitness(fitness_values[j], winner_value, ot)) {
-            winner = j;
-            winner_value = fitness_values[j];
+    double best = fitness_values[0];
+    double total = 0.0;
+
+    for (uint32_t i = 0; i < pop_size; i++) {
+        if (selection_compare_fitness(fitness_values[i], best, ot)) {
+            best = fitness_values[i];
         }
+        total += fitness_values[i];
     }
 
-    printf("\nbest fitness is that of %d, %f\n\n", winner, winner_value);
+    // diversity is measured on the encoded genes, one column per gene field
+    population_str* p = population_create(pop_size, indiv_size, ot);
+    population_fromlists(p, curr_gen);
+    double diversity = population_diversity(p, NULL);
+    population_free(p);
 
-    fitness_cache(winner_value, curr_gen[winner], best_file);
+    trace_counter("fitness", "best", best);
+    trace_counter("fitness", "mean", total / pop_size);
+    trace_counter("diversity", "gini-simpson", diversity);
 
 }
 
@@ -187,11 +279,11 @@ void evolution_create_new_run_folder(char* main_folder) {
     strcat(main_folder, "_");
     strcat(main_folder, seconds_str);
 
-    // create and run the command for making the new directory
-    char create_dir[60];
-    strcpy(create_dir, "mkdir ");
-    strcat(create_dir, main_folder);
-    system(create_dir);
+    // create the new directory directly rather than through the shell
+    if (mkdir(main_folder, 0755) != 0 && errno != EEXIST) {
+        printf("error: could not create run folder %s [file:\'%s\',line:%d]\n", main_folder, __FILE__, __LINE__);
+        exit(0);
+    }
 
 }
 
@@ -227,8 +319,7 @@ void evolution_create_new_run_folder(char* main_folder) {
 void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
     char new_directory_name[70];
-    char new_directory[80];
-    char generation_num[4];
+    char generation_num[12];
 
     strcpy(new_directory_name, main_folder);
     strcat(new_directory_name, "/generation_");
@@ -236,10 +327,7 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
     strcat(new_directory_name, generation_num);
 
     // we are only making the directory, not adding anything to it
-    strcpy(new_directory, "mkdir ");
-    strcat(new_directory, new_directory_name);
-
-    system(new_directory);
+    mkdir(new_directory_name, 0755);
 
 }
 
@@ -284,7 +372,7 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 /* node_str* evolution_basic_crossover_and_mutation(uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, osaka_object_typ ot, bool vis, char* file) {
 
     if (vis) {
-        printf("Performing our basic tournament/crossover/mutation evolution -------------------------\n\n");
+        output_printf(stdout, "Performing our basic tournament/crossover/mutation evolution -------------------------\n\n");
     }
 
     // indexes and temporary values to keep track of information
@@ -319,9 +407,9 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
         for (int i = 0; i < pop_size; i++) {
         
-            printf("----------------------- Printing Individual %d before beginning -----------------------\n\n", i + 1);
+            output_printf(stdout, "----------------------- Printing Individual %d before beginning -----------------------\n\n", i + 1);
             visualization_print_individual_concise_details(current_generation[i]);
-            printf("\n\n");
+            output_printf(stdout, "\n\n");
 
         }
 
@@ -331,7 +419,7 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
         if (vis) {
 
-            printf("----------------------------------- Generation %d -----------------------------------\n\n", g + 1);
+            output_printf(stdout, "----------------------------------- Generation %d -----------------------------------\n\n", g + 1);
 
         }
 
@@ -343,7 +431,7 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
             if (vis) {
 
-                printf("---------------------------- Iteration %d of Generation %d ----------------------------\n\n", p + 1, g + 1);
+                output_printf(stdout, "---------------------------- Iteration %d of Generation %d ----------------------------\n\n", p + 1, g + 1);
 
             }
 
@@ -368,8 +456,8 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
             if (vis) {
 
-                printf("Contestant 1 starts at node %d\n", UID(contestant1));
-                printf("Contestant 2 starts at node %d\n\n", UID(contestant2));
+                output_printf(stdout, "Contestant 1 starts at node %d\n", UID(contestant1));
+                output_printf(stdout, "Contestant 2 starts at node %d\n\n", UID(contestant2));
 
             }
 
@@ -377,9 +465,9 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
             temp_mutation1 = (uint32_t) (100 * (rand() / (RAND_MAX + 1.0)));
             temp_mutation2 = (uint32_t) (100 * (rand() / (RAND_MAX + 1.0)));
 
-            //printf("temp_crossover for this iteration: %d\n", temp_crossover);
-            //printf("temp_mutation1 for this iteration: %d\n", temp_mutation1);
-            //printf("temp_mutation2 for this iteration: %d\n", temp_mutation2);
+            //output_printf(stdout, "temp_crossover for this iteration: %d\n", temp_crossover);
+            //output_printf(stdout, "temp_mutation1 for this iteration: %d\n", temp_mutation1);
+            //output_printf(stdout, "temp_mutation2 for this iteration: %d\n", temp_mutation2);
 
             // random numbers are used to decide if the crossover or mutation operators will be used with a certain probability
             if (temp_crossover <= cross_perc) {
@@ -387,11 +475,11 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
             }
             if (temp_mutation1 <= mut_perc) {
                 uint32_t random = (uint32_t) (indiv_size * (rand() / (RAND_MAX + 1.0))) + 1;
-                mutation_single_unit_all_params(contestant1, random, vis);
+                mutation_single_unit(contestant1, random, vis);
             }
             if (temp_mutation2 <= mut_perc) {
                 uint32_t random = (uint32_t) (indiv_size * (rand() / (RAND_MAX + 1.0))) + 1;
-                mutation_single_unit_all_params(contestant2, random, vis);
+                mutation_single_unit(contestant2, random, vis);
             }
 
             // free individuals from current population to make room for new individuals
@@ -410,7 +498,7 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
             if (vis) {
 
-                printf("\n-------------- End of Iteration %d of Generation %d, copy_size is now %d ---------------\n\n", p + 1, g + 1, copy_size);
+                output_printf(stdout, "\n-------------- End of Iteration %d of Generation %d, copy_size is now %d ---------------\n\n", p + 1, g + 1, copy_size);
 
             }
 
@@ -425,13 +513,13 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
             for (int i = 0; i < pop_size; i++) {
         
-                printf("------------------- Printing Individual %d at end of Generation %d --------------------\n\n", i + 1, g + 1);
+                output_printf(stdout, "------------------- Printing Individual %d at end of Generation %d --------------------\n\n", i + 1, g + 1);
                 visualization_print_individual_concise_details(current_generation[i]);
-                printf("\n\n");
+                output_printf(stdout, "\n\n");
 
             }
 
-            printf("-------------------------------- End of Generation %d --------------------------------\n\n", g + 1);
+            output_printf(stdout, "-------------------------------- End of Generation %d --------------------------------\n\n", g + 1);
 
         }
 
@@ -443,9 +531,9 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
 
     if (vis) {
         
-        printf("Best node: ---------------------------------------------------------------------------\n\n");
+        output_printf(stdout, "Best node: ---------------------------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(final_node);
-        printf("\n\n--------------------------------------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\n--------------------------------------------------------------------------------------\n\n");
 
     }
 
@@ -453,13 +541,221 @@ void evolution_create_new_gen_folder(char* main_folder, uint32_t gen) {
     generate_free_generation(current_generation, pop_size);
 
     if (vis) {
-        printf("Evolution complete -------------------------------------------------------------------\n\n");
+        output_printf(stdout, "Evolution complete -------------------------------------------------------------------\n\n");
     }
     
     return final_node;
 
 } */
 
+/*
+ * NAME
+ *
+ *  evolution_set_output_folder
+ *
+ * DESCRIPTION
+ *
+ *  Sets the folder the run log of later runs is written to. Missing
+ *  folders along the path are created. Without one, every run gets a
+ *  new dated folder in src/files/cache
+ *
+ * PARAMETERS
+ *
+ *  const char* folder -- folder for the run log, NULL or "" for the dated folders
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_set_output_folder("src/files/cache/job_sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  changes where later runs are cached
+ *
+ */
+
+void evolution_set_output_folder(const char* folder) {
+
+    if (folder == NULL || strlen(folder) == 0) {
+        strcpy(evolution_output_folder, "");
+        return;
+    }
+
+    if (strlen(folder) >= EVOLUTION_MAX_PATH - 16) {
+        printf("error: output folder %s is too long [file:\'%s\',line:%d]\n", folder, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    strcpy(evolution_output_folder, folder);
+
+    // create every folder along the path, the folder may name a new tree
+    for (char* slash = strchr(evolution_output_folder + 1, '/'); ; slash = strchr(slash + 1, '/')) {
+        if (slash != NULL) {
+            *slash = '\0';
+        }
+        if (strlen(evolution_output_folder) > 0 && mkdir(evolution_output_folder, 0755) != 0 && errno != EEXIST) {
+            printf("error: could not create output folder %s [file:\'%s\',line:%d]\n", evolution_output_folder, __FILE__, __LINE__);
+            exit(0);
+        }
+        if (slash == NULL) {
+            break;
+        }
+        *slash = '/';
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *  evolution_set_workers
+ *
+ * DESCRIPTION
+ *
+ *  Sets how many threads evaluate the individuals of a generation. Only
+ *  the synthetic evaluator of mock.h is evaluated in parallel, the real
+ *  fitness functions share files and the global random generator, so they
+ *  keep running on the calling thread whatever is set here
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_workers -- number of evaluation threads, 1 to EVOLUTION_MAX_WORKERS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_set_workers(8);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how later generations are evaluated
+ *
+ */
+
+void evolution_set_workers(uint32_t num_workers) {
+
+    assert(num_workers > 0 && num_workers <= EVOLUTION_MAX_WORKERS);
+
+    evolution_num_workers = num_workers;
+
+}
+
+/*
+ * NAME
+ *
+ *  evolution_get_workers
+ *
+ * DESCRIPTION
+ *
+ *  Number of threads set to evaluate the individuals of a generation
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of evaluation threads
+ *
+ * EXAMPLE
+ *
+ *  uint32_t workers = evolution_get_workers();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t evolution_get_workers(void) {
+
+    return evolution_num_workers;
+
+}
+
+/*
+ * NAME
+ *
+ *  evolution_evaluate_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates every individual of a generation, all at once when the
+ *  fitness registry has a batch function for its object type, otherwise
+ *  one at a time with fitness_top. When the synthetic evaluator is
+ *  enabled and more than one worker is set, the individuals are handed
+ *  out to that many threads, otherwise they are evaluated in order on
+ *  the calling thread
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  double* fitness_values - filled with the fitness of every individual
+ *  uint32_t pop_size - size of the generation
+ *  char* file - the test file, only used for LLVM_PASS
+ *  char** src_files - source files, only used for LLVM_PASS
+ *  uint32_t num_src_files - number of source files
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_evaluate_generation(current_generation, fitness_values, pop_size, file, src_files, num_src_files);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills in fitness values, may spawn and join threads
+ *
+ */
+
+void evolution_evaluate_generation(node_str** gen, double* fitness_values, uint32_t pop_size, char* file, char** src_files, uint32_t num_src_files) {
+
+    pthread_t threads[EVOLUTION_MAX_WORKERS];
+    uint32_t num_threads = mock_enabled() ? evolution_num_workers : 1;
+    evolution_evaluate_str args;
+
+    args.gen = gen;
+    args.fitness_values = fitness_values;
+    args.pop_size = pop_size;
+    args.file = file;
+    args.src_files = src_files;
+    args.num_src_files = num_src_files;
+    atomic_init(&args.next, 0);
+
+    num_threads = num_threads < pop_size ? num_threads : pop_size;
+
+    // a batch function of the fitness registry may evaluate the whole generation at once
+    if (fitness_generation(gen, fitness_values, pop_size)) {
+        INSTRUMENT_COUNT(INSTRUMENT_COUNTER_EVALUATIONS, pop_size);
+        return;
+    }
+
+    if (num_threads <= 1) {
+        __evolution_evaluate_worker(&args);
+        return;
+    }
+
+    for (uint32_t t = 0; t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, __evolution_evaluate_worker, &args) != 0) {
+            printf("error: failed to create evaluation thread [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+            exit(0);
+        }
+    }
+
+    for (uint32_t t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+}
+
 /*
  * NAME
  *
@@ -506,15 +802,11 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
     uint32_t temp_crossover = 0;
     uint32_t temp_mutation1 = 0;
     uint32_t temp_mutation2 = 0;
-    uint32_t fitness1 = 0;
-    uint32_t fitness2 = 0;
     uint32_t copy_size = 0;
     uint32_t contestant1_ind = 0;
     uint32_t contestant2_ind = 0;
     uint32_t swap_ind = 0;
 
-    node_str* contestant1_orig = NULL;
-    node_str* contestant2_orig = NULL;
     node_str* contestant1 = NULL;
     node_str* contestant2 = NULL;
     node_str* best_node = NULL;
@@ -525,35 +817,51 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
 
     double fitness_values[pop_size];
 
-    char main_folder[50];
+    char main_folder[EVOLUTION_MAX_PATH];
+    char log_file[EVOLUTION_MAX_PATH];
+    runlog_str* log = NULL;
 
     if (cache) {
 
-        evolution_create_new_run_folder(main_folder);
+        if (strlen(evolution_output_folder) > 0) {
+            strcpy(main_folder, evolution_output_folder);
+        }
+        else {
+            evolution_create_new_run_folder(main_folder);
+        }
+
+        // the whole run goes into a single log file in the run folder
+        strcpy(log_file, main_folder);
+        strcat(log_file, runlog_get_format() == RUNLOG_BINARY ? "/run.bin" : "/run.jsonl");
+        log = runlog_open(log_file, runlog_get_format());
+        runlog_write_header(log, num_gens, pop_size, indiv_size, tourn_size, mut_perc, cross_perc, ot, file);
 
     }
 
-    fitness_pre_cache(main_folder, file, src_files, num_src_files, ot, cache);
+    INSTRUMENT_RESET();
+
+    fitness_pre_cache(log, file, src_files, num_src_files, ot, cache);
 
     if (vis) {
-        printf("Performing our basic tournament/crossover/mutation evolution with replacement --------\n\n");
+        output_printf(stdout, "Performing our basic tournament/crossover/mutation evolution with replacement --------\n\n");
     }
 
     // create the initial population
     generate_new_generation(current_generation, pop_size, indiv_size, ot);
 
     // calculate initial fitness values for the current generation
-    for (uint32_t k = 0; k < pop_size; k++) {
-        fitness_values[k] = fitness_top(current_generation[k], false, file, src_files, num_src_files, false, NULL);
-    }
+    evolution_evaluate_generation(current_generation, fitness_values, pop_size, file, src_files, num_src_files);
+
+    INSTRUMENT_GENERATION(0);
+    evolution_trace_population(pop_size, indiv_size, current_generation, fitness_values, ot);
 
     if (vis) {
 
         for (int i = 0; i < pop_size; i++) {
         
-            printf("----------------------- Printing Individual %d before beginning -----------------------\n\n", i + 1);
+            output_printf(stdout, "----------------------- Printing Individual %d before beginning -----------------------\n\n", i + 1);
             visualization_print_individual_concise_details(current_generation[i]);
-            printf("\n\n");
+            output_printf(stdout, "\n\n");
 
         }
 
@@ -561,24 +869,28 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
 
     for (uint32_t g = 0; g < num_gens; g++) {
 
-        if (vis) {
-            printf("----------------------------------- Generation %d -----------------------------------\n\n", g + 1);
-        }
+        char generation_name[30];
+        TRACE_START(generation);
 
-        if (cache) {
-            evolution_create_new_gen_folder(main_folder, g);
+        if (vis) {
+            output_printf(stdout, "----------------------------------- Generation %d -----------------------------------\n\n", g + 1);
         }
 
         // at the start of every generation, copy over the last generation
+        INSTRUMENT_START(copy_generation);
         generate_copy_generation(current_generation, copy_gen, pop_size);
         copy_size = pop_size;
+        INSTRUMENT_STOP(copy_generation, INSTRUMENT_PHASE_COPY);
 
         for (uint32_t p = 0; p < (pop_size / 2); p++) {
 
+            TRACE_START(breed);
+
             if (vis) {
-                printf("---------------------------- Iteration %d of Generation %d ----------------------------\n\n", p + 1, g + 1);
+                output_printf(stdout, "---------------------------- Iteration %d of Generation %d ----------------------------\n\n", p + 1, g + 1);
             }
 
+            INSTRUMENT_START(selection);
             contestant1_ind = selection_tournament(copy_gen, fitness_values, contestant1, copy_size, tourn_size, vis, file);
             contestant2_ind = selection_tournament(copy_gen, fitness_values, contestant2, copy_size, tourn_size, vis, file);
 
@@ -593,14 +905,15 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
                 contestant1_ind = contestant2_ind;
                 contestant2_ind = swap_ind;
             }
+            INSTRUMENT_STOP(selection, INSTRUMENT_PHASE_SELECTION);
 
             // get actual individuals using the indices
             contestant1 = copy_gen[contestant1_ind];
             contestant2 = copy_gen[contestant2_ind];
 
             if (vis) {
-                printf("Contestant 1 starts at node %d\n", UID(contestant1));
-                printf("Contestant 2 starts at node %d\n\n", UID(contestant2));
+                output_printf(stdout, "Contestant 1 starts at node %d\n", UID(contestant1));
+                output_printf(stdout, "Contestant 2 starts at node %d\n\n", UID(contestant2));
             }
 
             temp_crossover = (uint32_t) (100 * (rand() / (RAND_MAX + 1.0)));
@@ -609,58 +922,77 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
 
             // random numbers are used to decide if the crossover or mutation operators will be used with a certain probability
             if (temp_crossover <= cross_perc) {
+                INSTRUMENT_START(crossover);
                 crossover_onepoint_macro(contestant1, contestant2, vis);
+                INSTRUMENT_STOP(crossover, INSTRUMENT_PHASE_CROSSOVER);
             }
             if (temp_mutation1 <= mut_perc) {
                 uint32_t random = (uint32_t) (indiv_size * (rand() / (RAND_MAX + 1.0))) + 1;
-                mutation_single_unit_all_params(contestant1, random, vis);
+                INSTRUMENT_START(mutation);
+                mutation_single_unit(contestant1, random, vis);
+                INSTRUMENT_STOP(mutation, INSTRUMENT_PHASE_MUTATION);
             }
             if (temp_mutation2 <= mut_perc) {
                 uint32_t random = (uint32_t) (indiv_size * (rand() / (RAND_MAX + 1.0))) + 1;
-                mutation_single_unit_all_params(contestant2, random, vis);
+                INSTRUMENT_START(mutation);
+                mutation_single_unit(contestant2, random, vis);
+                INSTRUMENT_STOP(mutation, INSTRUMENT_PHASE_MUTATION);
             }
 
             // free individuals from current population to make room for new individuals
+            INSTRUMENT_START(copy_individuals);
             generate_free_individual(current_generation[p]);
             generate_free_individual(current_generation[p + (pop_size / 2)]);
 
             // copy over new individuals into the new generation
             current_generation[p] = osaka_copylist(contestant1);
             current_generation[p + (pop_size / 2)] = osaka_copylist(contestant2);
+            INSTRUMENT_STOP(copy_individuals, INSTRUMENT_PHASE_COPY);
 
             if (vis) {
-                printf("\n-------------- End of Iteration %d of Generation %d, copy_size is now %d ---------------\n\n", p + 1, g + 1, copy_size);
+                output_printf(stdout, "\n-------------- End of Iteration %d of Generation %d, copy_size is now %d ---------------\n\n", p + 1, g + 1, copy_size);
             }
 
+            TRACE_STOP(breed, "breed", "breeding");
+
         }
 
         // refresh fitness values for the current_generation
-        for (uint32_t k = 0; k < pop_size; k++) {
-            fitness_values[k] = fitness_top(current_generation[k], false, file, src_files, num_src_files, false, NULL);
-        }
+        evolution_evaluate_generation(current_generation, fitness_values, pop_size, file, src_files, num_src_files);
 
+        INSTRUMENT_START(free_generation);
         generate_free_generation(copy_gen, copy_size);
+        INSTRUMENT_STOP(free_generation, INSTRUMENT_PHASE_COPY);
+
+        evolution_trace_population(pop_size, indiv_size, current_generation, fitness_values, ot);
 
         if (vis) {
 
             for (int i = 0; i < pop_size; i++) {
-                printf("------------------- Printing Individual %d at end of Generation %d --------------------\n\n", i + 1, g + 1);
+                output_printf(stdout, "------------------- Printing Individual %d at end of Generation %d --------------------\n\n", i + 1, g + 1);
                 visualization_print_individual_concise_details(current_generation[i]);
-                printf("\n\n");
+                output_printf(stdout, "\n\n");
             }
 
         }
 
         if (cache) {
 
-            evolution_cache_generation(main_folder, g, pop_size, current_generation, vis, file, src_files, num_src_files, fitness_values, ot);
+            INSTRUMENT_START(cache);
+            evolution_cache_generation(log, g, pop_size, current_generation, vis, fitness_values, ot);
+            INSTRUMENT_STOP(cache, INSTRUMENT_PHASE_CACHE);
 
         }
 
         if (vis) {
-            printf("-------------------------------- End of Generation %d --------------------------------\n\n", g + 1);
+            output_printf(stdout, "-------------------------------- End of Generation %d --------------------------------\n\n", g + 1);
         }
 
+        INSTRUMENT_GENERATION(g + 1);
+
+        sprintf(generation_name, "generation %u", g + 1);
+        TRACE_STOP(generation, generation_name, "generation");
+
     }
 
     // is currently a dummy decision, will be replaces later with better logic
@@ -668,16 +1000,19 @@ node_str* evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_g
     final_node = osaka_copylist(best_node);
 
     if (vis) {
-        printf("Best node: ---------------------------------------------------------------------------\n\n");
+        output_printf(stdout, "Best node: ---------------------------------------------------------------------------\n\n");
         visualization_print_individual_concise_details(final_node);
-        printf("\n\n--------------------------------------------------------------------------------------\n\n");
+        output_printf(stdout, "\n\n--------------------------------------------------------------------------------------\n\n");
     }
 
     // always free the generation at the end
     generate_free_generation(current_generation, pop_size);
+    runlog_close(log);
+
+    INSTRUMENT_TOTALS();
 
     if (vis) {
-        printf("Evolution complete -------------------------------------------------------------------\n\n");
+        output_printf(stdout, "Evolution complete -------------------------------------------------------------------\n\n");
     }
     
     return final_node;
@@ -43,6 +43,34 @@
 #include "crossover.h"
 #include "generation.h"
 #include "selection.h"
+#include "population.h"
+#include "../support/runlog.h"
+#include "../support/trace.h"
+#include <sys/stat.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef struct evolution_evaluate_str {
+    node_str** gen;
+    double* fitness_values;
+    uint32_t pop_size;
+    char* file;
+    char** src_files;
+    uint32_t num_src_files;
+    _Atomic uint32_t next;
+} evolution_evaluate_str;
+
+/*
+ * MACROS
+ */
+
+#define EVOLUTION_MAX_WORKERS 64
+#define EVOLUTION_MAX_PATH 256
 
 /*
  * ROUTINES
@@ -55,17 +83,17 @@
  *
  * DESCRIPTION
  *
- *  For a given general, caches information on every individual
- *  and its fitness in a folder within run/
+ *  For a given generation, writes a record for every individual
+ *  with the fitness it was already given, and one for the best
+ *  individual, to the run log. Nothing is evaluated again
  *
  * PARAMETERS
  *
- *  char* main_folder - the folder in which the new file will be housed
+ *  runlog_str* log - the run log of this run
  *  uint32_t gen - the generation number within this run
  *  uint32_t pop_size - size of a single generation
  *  node_str** curr_gen - the current generation that is being cached
  *  bool vis - whether or not visualization is enabled
- *  char* file - the test file
  *  double* fitness_values - fitness values for every individual in the current generation
  *  osaka_object_typ ot - the object type that is being used for this run
  *
@@ -75,15 +103,50 @@
  *
  * EXAMPLE
  *
- *  evolution_cache_generation(main_folder_str, 5);
+ *  evolution_cache_generation(log, g, pop_size, current_generation, vis, fitness_values, ot);
  *
  * SIDE-EFFECT
  *
- *  Affects the value of main_folder variable
+ *  writes to the run log
+ *
+ */
+
+void evolution_cache_generation(runlog_str* log, uint32_t gen, uint32_t pop_size, node_str** curr_gen, bool vis, double* fitness_values, osaka_object_typ ot);
+
+/*
+ * NAME
+ *
+ *   evolution_trace_population
+ *
+ * DESCRIPTION
+ *
+ *  For a given generation, writes the best and mean fitness and the
+ *  diversity of the genes to the counter tracks of the trace. Only
+ *  does any work while tracing is on
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size - size of a single generation
+ *  uint32_t indiv_size - number of genes in every individual
+ *  node_str** curr_gen - the current generation
+ *  double* fitness_values - fitness values for every individual in the current generation
+ *  osaka_object_typ ot - the object type that is being used for this run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_trace_population(pop_size, indiv_size, current_generation, fitness_values, ot);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
  *
  */
 
-void evolution_cache_generation(char* main_folder, uint32_t gen, uint32_t pop_size, node_str** curr_gen, bool vis, char* file, char** src_files, uint32_t num_src_files, double* fitness_values, osaka_object_typ ot);
+void evolution_trace_population(uint32_t pop_size, uint32_t indiv_size, node_str** curr_gen, double* fitness_values, osaka_object_typ ot);
 
 /*
  * NAME
@@ -146,6 +209,137 @@ void evolution_create_new_run_folder(char* main_folder);
 
 void evolution_create_new_gen_folder(char* main_folder, uint32_t gen);
 
+/*
+ * NAME
+ *
+ *  evolution_set_output_folder
+ *
+ * DESCRIPTION
+ *
+ *  Sets the folder the run log of later runs is written to. Missing
+ *  folders along the path are created. Without one, every run gets a
+ *  new dated folder in src/files/cache
+ *
+ * PARAMETERS
+ *
+ *  const char* folder -- folder for the run log, NULL or "" for the dated folders
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_set_output_folder("src/files/cache/job_sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  changes where later runs are cached
+ *
+ */
+
+void evolution_set_output_folder(const char* folder);
+
+/*
+ * NAME
+ *
+ *  evolution_set_workers
+ *
+ * DESCRIPTION
+ *
+ *  Sets how many threads evaluate the individuals of a generation. Only
+ *  the synthetic evaluator of mock.h is evaluated in parallel, the real
+ *  fitness functions share files and the global random generator, so they
+ *  keep running on the calling thread whatever is set here
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_workers -- number of evaluation threads, 1 to EVOLUTION_MAX_WORKERS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_set_workers(8);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how later generations are evaluated
+ *
+ */
+
+void evolution_set_workers(uint32_t num_workers);
+
+/*
+ * NAME
+ *
+ *  evolution_get_workers
+ *
+ * DESCRIPTION
+ *
+ *  Number of threads set to evaluate the individuals of a generation
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of evaluation threads
+ *
+ * EXAMPLE
+ *
+ *  uint32_t workers = evolution_get_workers();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t evolution_get_workers(void);
+
+/*
+ * NAME
+ *
+ *  evolution_evaluate_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates every individual of a generation, all at once when the
+ *  fitness registry has a batch function for its object type, otherwise
+ *  one at a time with fitness_top. When the synthetic evaluator is
+ *  enabled and more than one worker is set, the individuals are handed
+ *  out to that many threads, otherwise they are evaluated in order on
+ *  the calling thread
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  double* fitness_values - filled with the fitness of every individual
+ *  uint32_t pop_size - size of the generation
+ *  char* file - the test file, only used for LLVM_PASS
+ *  char** src_files - source files, only used for LLVM_PASS
+ *  uint32_t num_src_files - number of source files
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  evolution_evaluate_generation(current_generation, fitness_values, pop_size, file, src_files, num_src_files);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills in fitness values, may spawn and join threads
+ *
+ */
+
+void evolution_evaluate_generation(node_str** gen, double* fitness_values, uint32_t pop_size, char* file, char** src_files, uint32_t num_src_files);
+
 /*
  * NAME
  *
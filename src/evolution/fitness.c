@@ -50,7 +50,8 @@
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -60,7 +61,7 @@
  * EXAMPLE
  *
  * if (object_type == SIMPLE) {
- *     fitness_pre_cache_simple(main_folder, test_file);   
+ *     fitness_pre_cache_simple(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -69,7 +70,7 @@
  *
  */
 
-void fitness_pre_cache_simple(char* folder, bool cache) {
+void fitness_pre_cache_simple(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
 
     // do nothing, default for now
 
@@ -158,7 +159,8 @@ uint32_t fitness_simple(node_str* indiv, bool vis) {
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -168,7 +170,7 @@ uint32_t fitness_simple(node_str* indiv, bool vis) {
  * EXAMPLE
  *
  * if (object_type == ASSEMBLER) {
- *     fitness_pre_cache_assembler(main_folder, test_file);   
+ *     fitness_pre_cache_assembler(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -177,7 +179,7 @@ uint32_t fitness_simple(node_str* indiv, bool vis) {
  *
  */
 
-void fitness_pre_cache_assembler(char* folder, bool cache) {
+void fitness_pre_cache_assembler(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
 
     // do nothing, default for now
 
@@ -228,7 +230,8 @@ void fitness_cache_assembler(double fitness, node_str* indiv, char* cache_file)
  * DESCRIPTION
  *
  *  Calculates the fitness value specifically for an assembler
- *  individual, currently is only a default
+ *  individual, by running it on the register machine interpreter
+ *  over the cases of the current symbolic regression problem
  *
  * PARAMETERS
  *
@@ -251,7 +254,13 @@ void fitness_cache_assembler(double fitness, node_str* indiv, char* cache_file)
 
 uint32_t fitness_assembler(node_str* indiv, bool vis) {
 
-    return 100 * (rand() / (RAND_MAX + 1.0)); 
+    uint32_t fitness = interpreter_fitness(indiv);
+
+    if (vis) {
+        printf("Fitness of the individual on the interpreter is %u\n", fitness);
+    }
+
+    return fitness;
 
 }
 
@@ -266,7 +275,8 @@ uint32_t fitness_assembler(node_str* indiv, bool vis) {
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -276,7 +286,7 @@ uint32_t fitness_assembler(node_str* indiv, bool vis) {
  * EXAMPLE
  *
  * if (object_type == OSAKA_STRING) {
- *     fitness_pre_cache_osaka_string(main_folder, test_file);   
+ *     fitness_pre_cache_osaka_string(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -285,7 +295,7 @@ uint32_t fitness_assembler(node_str* indiv, bool vis) {
  *
  */
 
-void fitness_pre_cache_osaka_string(char* folder, bool cache) {
+void fitness_pre_cache_osaka_string(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
 
     // do nothing, default for now
 
@@ -336,7 +346,9 @@ void fitness_cache_osaka_string(double fitness, node_str* indiv, char* cache_fil
  * DESCRIPTION
  *
  *  Calculates the fitness value specifically for an osaka_string
- *  individual, currently is only a default
+ *  individual, the distance of its strings joined by spaces from the
+ *  target sentence, by edit distance unless distance_set_target chose
+ *  Hamming distance
  *
  * PARAMETERS
  *
@@ -359,7 +371,13 @@ void fitness_cache_osaka_string(double fitness, node_str* indiv, char* cache_fil
 
 uint32_t fitness_osaka_string(node_str* indiv, bool vis) {
 
-    return 100 * (rand() / (RAND_MAX + 1.0)); 
+    uint32_t fitness = distance_fitness(indiv);
+
+    if (vis) {
+        printf("Distance of the individual from the target sentence is %u\n", fitness);
+    }
+
+    return fitness;
 
 }
 
@@ -370,11 +388,14 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis) {
  *
  * DESCRIPTION
  *
- *  Creates a file that describes the control values for fitness using LLVM opt
+ *  Builds the test file and, when caching, writes the control timings
+ *  with no and with basic optimization to the run log. Both go through
+ *  the build cache of llvm_build_linked: only changed files are compiled,
+ *  and timings already measured on this machine are reused
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
  *  char* test_file - the file that will be measured for its control values
  *
  * RETURN
@@ -384,7 +405,7 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis) {
  * EXAMPLE
  *
  * if (object_type == LLVM_PASS) {
- *     fitness_pre_cache_llvm_pass(main_folder, test_file);   
+ *     fitness_pre_cache_llvm_pass(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -393,29 +414,36 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis) {
  *
  */
 
-void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
+void fitness_pre_cache_llvm_pass(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
+
+    double no_optimization = 0.0;
+    double basic_optimization = 0.0;
 
-    char build_command[5000];
-    strcpy(build_command, "");
+    uint64_t key = llvm_build_linked(src_files, num_src_files, test_file);
 
-    llvm_form_build_ll_command(src_files, num_src_files, test_file, build_command);
+    if (cache && llvm_cache_lookup_baselines(key, &no_optimization, &basic_optimization)) {
+
+        printf("Reusing the control timings of %s from the build cache\n\n", test_file);
+
+        if (log != NULL) {
+            runlog_write_baseline(log, "no_optimization", no_optimization);
+            runlog_write_baseline(log, "basic_optimization", basic_optimization);
+        }
 
-    printf("build command: %s\n\n", build_command);
+        return;
 
-    llvm_run_command(build_command);
+    }
 
     if (cache) {
 
         struct timeval start, end; 
-        uint32_t result = 0;
         uint32_t num_runs = 5;
 
         double total_time = 0.0;
         double time_taken = 0.0;
 
-        char test_file_name[30];
+        char test_file_name[LLVM_MAX_PATH];
         char base_name[60];
-        char time_str[50];
 
         char bc_command[1000];
         char run_command[1000];
@@ -456,7 +484,7 @@ void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files
         for (uint32_t runs = 0; runs < num_runs; runs++) {
 
             gettimeofday(&start, NULL);
-            result = llvm_run_command(run_command);
+            llvm_run_command(run_command);
             gettimeofday(&end, NULL);
 
             time_taken = (end.tv_sec - start.tv_sec) * 1e6;
@@ -467,20 +495,12 @@ void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files
         }
 
         time_taken = total_time / num_runs;
-        sprintf(time_str, "%f", time_taken);
-
-        char no_opt_file[60];
-        char no_opt_file_str[5000];
 
-        strcpy(no_opt_file, folder);
-        strcat(no_opt_file, "/original_no_optimization.txt");
-        strcpy(no_opt_file_str, "Description for original file with no optimization applied\n\nThe fitness of the individual is the time it takes to complete the testing script provided in seconds. Lower fitness is better.\n\nFitness of this individual: ");
-        strcat(no_opt_file_str, time_str);
-        strcat(no_opt_file_str, " sec");
+        if (log != NULL) {
+            runlog_write_baseline(log, "no_optimization", time_taken);
+        }
 
-        FILE* no_opt_file_ptr = fopen(no_opt_file, "w");
-        fputs(no_opt_file_str, no_opt_file_ptr);
-        fclose(no_opt_file_ptr);
+        no_optimization = time_taken;
 
         printf("Done. Time taken was %f\n\n", time_taken);
         time_taken = 0.0;
@@ -493,7 +513,7 @@ void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files
         for (uint32_t runs = 0; runs < num_runs; runs++) {
 
             gettimeofday(&start, NULL);
-            result = llvm_run_command(run_command);
+            llvm_run_command(run_command);
             gettimeofday(&end, NULL);
 
             time_taken = (end.tv_sec - start.tv_sec) * 1e6;
@@ -504,20 +524,13 @@ void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files
         }
 
         time_taken = total_time / num_runs;
-        sprintf(time_str, "%f", time_taken);
 
-        char basic_opt_file[60];
-        char basic_opt_file_str[5000];
-
-        strcpy(basic_opt_file, folder);
-        strcat(basic_opt_file, "/original_basic_optimization.txt");
-        strcpy(basic_opt_file_str, "Description for original file with only basic optimization applied\n\nThe fitness of the individual is the time it takes to complete the testing script provided in seconds. Lower fitness is better.\n\nFitness of this individual: ");
-        strcat(basic_opt_file_str, time_str);
-        strcat(basic_opt_file_str, " sec");
+        if (log != NULL) {
+            runlog_write_baseline(log, "basic_optimization", time_taken);
+        }
 
-        FILE* basic_opt_file_ptr = fopen(basic_opt_file, "w");
-        fputs(basic_opt_file_str, basic_opt_file_ptr);
-        fclose(basic_opt_file_ptr);
+        basic_optimization = time_taken;
+        llvm_cache_store_baselines(key, no_optimization, basic_optimization);
 
         printf("Done. Time taken was %f\n\n", time_taken);
 
@@ -558,68 +571,32 @@ void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files
 
 void fitness_cache_llvm_pass(double fitness, node_str* indiv, char* cache_file) {
 
-    char string[30000];
-    char fitness_num[100];
-    char input_str[10000];
-    char output_str[10000];
-    
-    strcpy(string, "Description file for Individual 1\n\nHere are the passes in this individual, in order:\n\n");
-    sprintf(fitness_num, "%f", fitness);
-    strcpy(input_str, "");
-    strcpy(output_str, "");
-
-    /*FILE *input;
-    FILE *output;
-    char* line = NULL;
-    size_t len = 0;
-    size_t read;
-    input = fopen(input_file, "r");
-    if (input == NULL) {
-        exit(EXIT_FAILURE);
-    }
-    while ((read = getline(&line, &len, input)) != -1) {
-        strcat(input_str, line);
-    }
-    output = fopen(output_file, "r");
-    if (output == NULL) {
-        exit(EXIT_FAILURE);
+    char desc[RUNLOG_DESC_SIZE];
+
+    FILE* file_ptr = fopen(cache_file, "w");
+
+    if (file_ptr == NULL) {
+        printf("error: could not create cache file %s [file:\'%s\',line:%d]\n", cache_file, __FILE__, __LINE__);
+        return;
     }
-    while ((read = getline(&line, &len, output)) != -1) {
-        strcat(output_str, line);
-    }*/
 
-    while (NEXT(indiv) != NULL) {
-        char desc[60];
+    // the description is streamed out pass by pass rather than built up in one string
+    fputs("Description file for Individual 1\n\nHere are the passes in this individual, in order:\n\n", file_ptr);
+
+    while (indiv != NULL) {
         strcpy(desc, "");
         osaka_describenode(desc, indiv);
-        strcat(string, desc);
-        strcat(string, "\n");
+        fputs(desc, file_ptr);
+        if (NEXT(indiv) != NULL) {
+            fputc('\n', file_ptr);
+        }
         indiv = NEXT(indiv);
     }
 
-    char desc[60];
-    strcpy(desc, "");
-    osaka_describenode(desc, indiv);
-    strcat(string, desc);
-    /*strcat(string, "\n\nHere is the input file before optimization was applied: \n\n###########################################################################################################################\n\n");
-    strcat(string, input_str);
-    strcat(string, "\n\n###########################################################################################################################\n\n");
-    strcat(string, "And here is the file after optimization: \n\n###########################################################################################################################\n\n");
-    strcat(string, output_str);
-    strcat(string, "\n\n###########################################################################################################################");*/
-    strcat(string, "\n\nThe fitness of the individual is the time it takes to complete the testing script provided in seconds after the specified optimization passes are applied. Lower fitness is better.\n\nFitness of this individual: ");
-    strcat(string, fitness_num);
-    strcat(string, " sec");
-
-    FILE* file_ptr = fopen(cache_file, "w");
-    fputs(string, file_ptr);
+    fprintf(file_ptr, "\n\nThe fitness of the individual is the time it takes to complete the testing script provided in seconds after the specified optimization passes are applied. Lower fitness is better.\n\nFitness of this individual: %f sec", fitness);
 
-    //fclose(input);
-    //fclose(output);
     fclose(file_ptr);
 
-    //free(line);
-
 }
 
 /*
@@ -656,10 +633,10 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
     double fitness = 100.0;
     uint32_t num_runs = 5;
 
-    char file_name[30];
+    char file_name[LLVM_MAX_PATH];
     char base_name[60];
-    char input_file[60];
-    char output_file[60];
+    char input_file[LLVM_MAX_PATH];
+    char output_file[LLVM_MAX_PATH];
 
     struct timeval start, end; 
     uint32_t result = 0;
@@ -700,7 +677,11 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
 
     printf("opt command: %s\n\nrun command: %s\n\n", opt_command, run_command);
 
+    INSTRUMENT_START(opt);
+    TRACE_START(opt);
     llvm_run_command(opt_command);
+    TRACE_STOP(opt, "opt", "evaluation");
+    INSTRUMENT_STOP(opt, INSTRUMENT_PHASE_OPT);
 
     double total_time = 0.0;
     double time_taken = 0.0;
@@ -708,9 +689,16 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
     gettimeofday(&start, NULL);
     for (uint32_t runs = 0; runs < num_runs; runs++) {
 
+        // llvm-as and lli are run as one command, so they are timed together
+        char run_name[30];
+        INSTRUMENT_START(exec);
+        TRACE_START(exec);
         gettimeofday(&start, NULL);
         result = llvm_run_command(run_command);
         gettimeofday(&end, NULL);
+        sprintf(run_name, "assemble and run #%u", runs + 1);
+        TRACE_STOP(exec, run_name, "evaluation");
+        INSTRUMENT_STOP(exec, INSTRUMENT_PHASE_EXEC);
 
         time_taken = (end.tv_sec - start.tv_sec) * 1e6;
         time_taken = (time_taken + (end.tv_usec - start.tv_usec)) * 1e-6;
@@ -750,7 +738,8 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -760,7 +749,7 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  * EXAMPLE
  *
  * if (object_type == BINARY_UP_TO_512) {
- *     fitness_pre_cache_llvm_pass(main_folder, test_file);   
+ *     fitness_pre_cache_llvm_pass(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -769,7 +758,7 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  *
  */
 
-void fitness_pre_cache_binary_up_to_512(char* folder, bool cache) {
+void fitness_pre_cache_binary_up_to_512(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache) {
 
     // do nothing, default for now
 
@@ -820,7 +809,8 @@ void fitness_cache_binary_up_to_512(double fitness, node_str* indiv, char* cache
  * DESCRIPTION
  *
  * Calculates the fitness value specifically for an binary_up_to_512
- * inidividual, currently is only a default. AUTO-GENERATED
+ * inidividual, on the packed genome of its binaries with the problem set
+ * by bitset_set_problem, OneMax unless set otherwise
  *
  * PARAMETERS
  *
@@ -843,7 +833,507 @@ void fitness_cache_binary_up_to_512(double fitness, node_str* indiv, char* cache
 
 uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis) {
 
-	return 100 * (rand() / (RAND_MAX + 1.0)); 
+	uint32_t fitness = bitset_fitness(indiv);
+
+	if (vis) {
+		printf("Fitness of the individual on its packed genome is %u\n", fitness);
+	}
+
+	return fitness;
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_simple
+ *
+ * DESCRIPTION
+ *
+ *  Registry form of fitness_simple, taking the arguments of
+ *  every fitness_single function
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis - whether or not visualization is enabled
+ *  char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file - unused
+ *
+ * RETURN
+ *
+ *  double - the fitness value for indiv
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_simple(node, false, NULL, NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __fitness_single_simple(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return fitness_simple(indiv, vis);
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_assembler
+ *
+ * DESCRIPTION
+ *
+ *  Registry form of fitness_assembler, taking the arguments of
+ *  every fitness_single function
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis - whether or not visualization is enabled
+ *  char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file - unused
+ *
+ * RETURN
+ *
+ *  double - the fitness value for indiv
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_assembler(node, false, NULL, NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __fitness_single_assembler(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return fitness_assembler(indiv, vis);
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_batch_assembler
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates an ASSEMBLER generation in one launch of the emulator
+ *  when the AArch64 evaluator is enabled. The interpreter does not
+ *  gain from batches, so without the emulator nothing is evaluated
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  uint32_t pop_size - size of the generation
+ *  double* fitness_values - filled with the fitness of every individual
+ *
+ * RETURN
+ *
+ *  bool - true if the generation was evaluated
+ *
+ * EXAMPLE
+ *
+ *  bool done = __fitness_batch_assembler(gen, pop_size, fitness_values);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds and runs a program, fills the interpreter memo
+ *
+ */
+
+bool __fitness_batch_assembler(node_str** gen, uint32_t pop_size, double* fitness_values) {
+
+    if (!aarch64_enabled()) {
+        return false;
+    }
+
+    // the fitness values wait in the interpreter memo once the emulator has run
+    aarch64_evaluate_generation(gen, pop_size);
+
+    for (uint32_t k = 0; k < pop_size; k++) {
+        fitness_values[k] = fitness_assembler(gen[k], false);
+    }
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_osaka_string
+ *
+ * DESCRIPTION
+ *
+ *  Registry form of fitness_osaka_string, taking the arguments of
+ *  every fitness_single function
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis - whether or not visualization is enabled
+ *  char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file - unused
+ *
+ * RETURN
+ *
+ *  double - the fitness value for indiv
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_osaka_string(node, false, NULL, NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __fitness_single_osaka_string(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return fitness_osaka_string(indiv, vis);
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_batch_osaka_string
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates an OSAKA_STRING generation with its string distances
+ *  taken in the lanes of a vector
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  uint32_t pop_size - size of the generation
+ *  double* fitness_values - filled with the fitness of every individual
+ *
+ * RETURN
+ *
+ *  bool - true, the generation is always evaluated
+ *
+ * EXAMPLE
+ *
+ *  bool done = __fitness_batch_osaka_string(gen, pop_size, fitness_values);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills the distance memo
+ *
+ */
+
+bool __fitness_batch_osaka_string(node_str** gen, uint32_t pop_size, double* fitness_values) {
+
+    distance_generation(gen, pop_size);
+
+    for (uint32_t k = 0; k < pop_size; k++) {
+        fitness_values[k] = fitness_osaka_string(gen[k], false);
+    }
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_llvm_pass
+ *
+ * DESCRIPTION
+ *
+ *  Registry form of fitness_llvm_pass, taking the arguments
+ *  of every fitness_single function in their order
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis - whether or not visualization is enabled
+ *  char* test_file - the file that the passes are applied to
+ *  char** src_files - the other source files of the program
+ *  uint32_t num_src_files - the number of source files
+ *  bool cache - whether or not the cache is used
+ *  char* cache_file - the file the cache is kept in
+ *
+ * RETURN
+ *
+ *  double - the fitness value for indiv
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_llvm_pass(node, false, "test.c", NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  compiles and runs the test file
+ *
+ */
+
+double __fitness_single_llvm_pass(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return fitness_llvm_pass(indiv, test_file, src_files, num_src_files, vis, cache, cache_file);
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_binary_up_to_512
+ *
+ * DESCRIPTION
+ *
+ *  Registry form of fitness_binary_up_to_512, taking the arguments
+ *  of every fitness_single function
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis - whether or not visualization is enabled
+ *  char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file - unused
+ *
+ * RETURN
+ *
+ *  double - the fitness value for indiv
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_binary_up_to_512(node, false, NULL, NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __fitness_single_binary_up_to_512(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return fitness_binary_up_to_512(indiv, vis);
+
+}
+
+/*
+ * NAME
+ *
+ *   __fitness_single_default
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an object type that has nothing registered,
+ *  always 100 like the default the editor tool generates
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv - the individual that is to be evaluated
+ *  bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file - unused
+ *
+ * RETURN
+ *
+ *  double - 100
+ *
+ * EXAMPLE
+ *
+ *  double fitness = __fitness_single_default(node, false, NULL, NULL, 0, false, NULL);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __fitness_single_default(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return 100;
+
+}
+
+/*
+ * REGISTRY
+ */
+
+// the built-in object types, others are added by fitness_register
+static fitness_entry_str fitness_registry[FITNESS_MAX_ENTRIES] = {
+    {
+        "SIMPLE",
+        fitness_pre_cache_simple,
+        __fitness_single_simple,
+        NULL,                               // evaluated one individual at a time
+        fitness_cache_simple,
+        FITNESS_MAXIMIZE,
+    },
+    {
+        "ASSEMBLER",
+        fitness_pre_cache_assembler,
+        __fitness_single_assembler,
+        __fitness_batch_assembler,
+        fitness_cache_assembler,
+        FITNESS_MINIMIZE,
+    },
+    {
+        "OSAKA_STRING",
+        fitness_pre_cache_osaka_string,
+        __fitness_single_osaka_string,
+        __fitness_batch_osaka_string,
+        fitness_cache_osaka_string,
+        FITNESS_MINIMIZE,
+    },
+    {
+        "LLVM_PASS",
+        fitness_pre_cache_llvm_pass,
+        __fitness_single_llvm_pass,
+        NULL,                               // evaluated one individual at a time
+        fitness_cache_llvm_pass,
+        FITNESS_MINIMIZE,
+    },
+    {
+        "BINARY_UP_TO_512",
+        fitness_pre_cache_binary_up_to_512,
+        __fitness_single_binary_up_to_512,
+        NULL,                               // packed genomes are already cheap one at a time
+        fitness_cache_binary_up_to_512,
+        FITNESS_MINIMIZE,
+    },
+};
+
+static uint32_t fitness_num_entries = 5;
+
+static fitness_entry_str fitness_default = {
+    "DEFAULT",
+    NULL,
+    __fitness_single_default,
+    NULL,
+    NULL,
+    FITNESS_MINIMIZE,
+};
+
+// entry of each object type, looked up by name the first time the type is evaluated
+static _Atomic(fitness_entry_str*) fitness_of_type[FITNESS_MAX_ENTRIES];
+
+/*
+ * NAME
+ *
+ *   fitness_register
+ *
+ * DESCRIPTION
+ *
+ *  Adds an entry to the fitness registry, or replaces the entry
+ *  that has the same name. The name is the name of an object
+ *  type in the module table, so a new module can be evaluated
+ *  without any change to fitness.c. Entries are meant to be
+ *  registered before evolution starts, not while it runs
+ *
+ * PARAMETERS
+ *
+ *  fitness_entry_str* entry - the entry, copied into the registry
+ *
+ * RETURN
+ *
+ *  bool - false if the registry is full or the entry has no fitness_single
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str entry = { "SIMPLE", NULL, my_fitness, NULL, NULL, FITNESS_MAXIMIZE };
+ *  fitness_register(&entry);
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the registry, object types are looked up again
+ *
+ */
+
+bool fitness_register(fitness_entry_str* entry) {
+
+    if (entry == NULL || entry->fitness_single == NULL) {
+        printf("error: a fitness entry needs a fitness_single function [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        return false;
+    }
+
+    uint32_t slot = 0;
+
+    while (slot < fitness_num_entries && strcmp(fitness_registry[slot].name, entry->name) != 0) {
+        slot++;
+    }
+
+    if (slot == FITNESS_MAX_ENTRIES) {
+        printf("error: the fitness registry is full, %s was not registered [file:\'%s\',line:%d]\n", entry->name, __FILE__, __LINE__);
+        return false;
+    }
+
+    fitness_registry[slot] = *entry;
+
+    if (slot == fitness_num_entries) {
+        fitness_num_entries++;
+    }
+
+    // a type that resolved to the default or to the replaced entry has to look again
+    for (uint32_t type = 0; type < FITNESS_MAX_ENTRIES; type++) {
+        atomic_store(&fitness_of_type[type], NULL);
+    }
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   fitness_lookup
+ *
+ * DESCRIPTION
+ *
+ *  The registry entry of an object type, found by the name the
+ *  type has in the module table. A type with no entry gets the
+ *  default one, whose fitness is always 100
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ type - the object type
+ *
+ * RETURN
+ *
+ *  fitness_entry_str* - the entry of the type, never NULL
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str* entry = fitness_lookup(BINARY_UP_TO_512);
+ *
+ * SIDE-EFFECT
+ *
+ *  remembers the entry of the type for the next lookup
+ *
+ */
+
+fitness_entry_str* fitness_lookup(osaka_object_typ type) {
+
+    if (type >= MAXTYPE) {
+        return &fitness_default;
+    }
+
+    fitness_entry_str* entry = type < FITNESS_MAX_ENTRIES ? atomic_load(&fitness_of_type[type]) : NULL;
+
+    if (entry != NULL) {
+        return entry;
+    }
+
+    entry = &fitness_default;
+
+    for (uint32_t slot = 0; slot < fitness_num_entries; slot++) {
+        if (strcmp(fitness_registry[slot].name, object_table_function[type].name) == 0) {
+            entry = &fitness_registry[slot];
+            break;
+        }
+    }
+
+    if (type < FITNESS_MAX_ENTRIES) {
+        atomic_store(&fitness_of_type[type], entry);
+    }
+
+    return entry;
 
 }
 
@@ -854,11 +1344,12 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis) {
  *
  * DESCRIPTION
  *
- *  Does an initial setup cache, is dependent on the object type
+ *  Does an initial setup cache with the init hook of the
+ *  registry entry of the object type, if it has one
  *
  * PARAMETERS
  *
- *  char* folder - the folder where the pre caching files will be housed
+ *  runlog_str* log - the run log the pre caching records are written to, NULL when not caching
  *  char* file - for some object types, will be a file used for the caching
  *  osaka_object_typ type - the object type for this evolutionary run
  *
@@ -869,7 +1360,7 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis) {
  * EXAMPLE
  *
  *  if (cache) {
- *      fitness_pre_cache(main_folder, test_file, ot);    
+ *      fitness_pre_cache(log, test_file, ot);
  *  }
  *
  * SIDE-EFFECT
@@ -878,23 +1369,23 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis) {
  *
  */
 
-void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t num_src_files, osaka_object_typ type, bool cache) {
+void fitness_pre_cache(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, osaka_object_typ type, bool cache) {
 
-    if (type == 0) {    // SIMPLE
-        return fitness_pre_cache_simple(folder, cache);
-    }
-    else if (type == 1) {   // ASSEMBLER
-        return fitness_pre_cache_assembler(folder, cache);
+    // the synthetic evaluator has no control values to measure
+    if (mock_enabled()) {
+        return;
     }
-    else if (type == 2) {   // OSAKA_STRING
-        return fitness_pre_cache_osaka_string(folder, cache);
+
+    // a benchmark suite measures the control values of each of its programs
+    if (suite_enabled() && type == LLVM_PASS) {
+        return suite_prepare(log);
     }
-    else if (type == 3) { // LLVM_PASS
-        return fitness_pre_cache_llvm_pass(folder, test_file, src_files, num_src_files, cache);
+
+    fitness_entry_str* entry = fitness_lookup(type);
+
+    if (entry->fitness_init != NULL) {
+        entry->fitness_init(log, test_file, src_files, num_src_files, cache);
     }
-	else if (type == 4) { // BINARY_UP_TO_512
-		return fitness_pre_cache_binary_up_to_512(folder, cache);
-	}
 
 }
 
@@ -905,7 +1396,8 @@ void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t
  *
  * DESCRIPTION
  *
- *  Caches 
+ *  Caches an individual with the cache hook of the registry
+ *  entry of its object type, if it has one
  *
  * PARAMETERS
  *
@@ -929,23 +1421,58 @@ void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t
 
 void fitness_cache(double fitness_value, node_str* indiv, char* cache_file) {
 
-    osaka_object_typ type = OBJECT_TYPE(indiv);
+    fitness_entry_str* entry = fitness_lookup(OBJECT_TYPE(indiv));
 
-    if (type == 0) {    // SIMPLE
-        return fitness_cache_simple(fitness_value, indiv, cache_file);
-    }
-    else if (type == 1) {   // ASSEMBLER
-        return fitness_cache_assembler(fitness_value, indiv, cache_file);
-    }
-    else if (type == 2) {   // OSAKA_STRING
-        return fitness_cache_osaka_string(fitness_value, indiv, cache_file);
+    if (entry->fitness_cache != NULL) {
+        entry->fitness_cache(fitness_value, indiv, cache_file);
     }
-    else if (type == 3) {   // LLVM_PASS
-        return fitness_cache_llvm_pass(fitness_value, indiv, cache_file);
+
+}
+
+/*
+ * NAME
+ *
+ *  fitness_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a whole generation at once with the batch function of
+ *  the registry entry of its object type. With the AArch64 evaluator
+ *  enabled, an ASSEMBLER generation runs in one launch of the emulator.
+ *  An OSAKA_STRING generation has its string distances taken in the
+ *  lanes of a vector. The values are those of the entry as they are,
+ *  selection reads the direction of the entry to compare them
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  double* fitness_values - filled with the fitness of every individual
+ *  uint32_t pop_size - size of the generation
+ *
+ * RETURN
+ *
+ *  bool - true if the generation was evaluated, false if it is left to fitness_top
+ *
+ * EXAMPLE
+ *
+ *  if (!fitness_generation(current_generation, fitness_values, pop_size)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  may build and run a program, fills the interpreter or distance memo
+ *
+ */
+
+bool fitness_generation(node_str** gen, double* fitness_values, uint32_t pop_size) {
+
+    // the synthetic evaluator and the benchmark suite evaluate one individual at a time
+    if (mock_enabled() || pop_size == 0 || (suite_enabled() && OBJECT_TYPE(gen[0]) == LLVM_PASS)) {
+        return false;
     }
-	else if (type == 4) {   // BINARY_UP_TO_512
-		return fitness_cache_binary_up_to_512(fitness_value, indiv, cache_file);
-	}
+
+    fitness_entry_str* entry = fitness_lookup(OBJECT_TYPE(gen[0]));
+
+    return entry->fitness_batch != NULL && entry->fitness_batch(gen, pop_size, fitness_values);
 
 }
 
@@ -956,8 +1483,12 @@ void fitness_cache(double fitness_value, node_str* indiv, char* cache_file) {
  *
  * DESCRIPTION
  *
- *  Applies the correct fitness function based on the
- *  specific object type of the individual
+ *  Applies the fitness function of the registry entry of the
+ *  object type of the individual, or the synthetic evaluator
+ *  of mock.h when it is enabled. LLVM_PASS individuals are
+ *  evaluated over the benchmark suite of suite.h when one is
+ *  enabled. The fitness is returned as the entry gives it,
+ *  whether lower or higher is better is the direction of the entry
  *
  * PARAMETERS
  *
@@ -982,26 +1513,18 @@ double fitness_top(node_str* indiv, bool vis, char* test_file, char** src_files,
 
     osaka_object_typ type = OBJECT_TYPE(indiv);
 
-    // the fitness function depends on the object type
-    if (type == 0) {    // SIMPLE
-        return fitness_simple(indiv, vis);
-    }
-    else if (type == 1) {   // ASSEMBLER
-        return fitness_assembler(indiv, vis);
-    }
-    else if (type == 2) {   // OSAKA_STRING
-        return fitness_osaka_string(indiv, vis);
+    // the synthetic evaluator stands in for every object type when enabled
+    if (mock_enabled()) {
+        return mock_fitness(indiv);
     }
-    else if (type == 3) {   // LLVM_PASS
-        return fitness_llvm_pass(indiv, test_file, src_files, num_src_files, vis, cache, cache_file);
-    }
-	else if (type == 4) {   // BINARY_UP_TO_512
-		return fitness_binary_up_to_512(indiv, vis);
-	}
-    else {
-        return 100;
+
+    // LLVM_PASS individuals are evaluated over the benchmark suite when there is one
+    if (suite_enabled() && type == LLVM_PASS) {
+        return suite_fitness(indiv, vis);
     }
 
+    return fitness_lookup(type)->fitness_single(indiv, vis, test_file, src_files, num_src_files, cache, cache_file);
+
 }
 
 /*
@@ -1011,8 +1534,9 @@ double fitness_top(node_str* indiv, bool vis, char* test_file, char** src_files,
  *
  * DESCRIPTION
  *
- *  initializes all typdefs for function pointers to their
- *  respective methods in fitness.h
+ *  Looks up the registry entry of every object type in the
+ *  module table ahead of the first evaluation, which would
+ *  otherwise look each type up on first use
  *
  * PARAMETERS
  *
@@ -1028,16 +1552,14 @@ double fitness_top(node_str* indiv, bool vis, char* test_file, char** src_files,
  *
  * SIDE-EFFECT
  *
- * alters the typedefs
+ * remembers the entry of every object type
  *
  */
 
 void fitness_setup() {
 
-    fpfitness_simple = &fitness_simple;
-    fpfitness_assembler = &fitness_assembler;
-    fpfitness_osaka_string = &fitness_osaka_string;
-    fpfitness_llvm_pass = &fitness_llvm_pass;
-	fpfitness_binary_up_to_512 = &fitness_binary_up_to_512;
+    for (uint32_t type = 0; type < MAXTYPE; type++) {
+        fitness_lookup(type);
+    }
 
-}
\ No newline at end of file
+}
@@ -38,18 +38,43 @@
 
 #include "../osaka/osaka.h"
 #include "../support/llvm.h"
+#include "../support/interpreter.h"
+#include "../support/aarch64.h"
+#include "../support/distance.h"
+#include "../support/bitset.h"
+#include "../support/runlog.h"
+#include "../support/trace.h"
+#include "mock.h"
+#include "suite.h"
 #include <stdbool.h>
 #include "sys/time.h"
+#include <stdatomic.h>
 
 /*
- * STATIC
+ * MACROS
  */
 
-uint32_t (*fpfitness_simple)(node_str *n, bool vis);
-uint32_t (*fpfitness_assembler)(node_str *n, bool vis);
-uint32_t (*fpfitness_osaka_string)(node_str *n, bool vis);
-double (*fpfitness_llvm_pass)(node_str* indiv, char* file, char** src_files, uint32_t num_src_files, bool vis, bool cache, char* cache_file);
-uint32_t (*fpfitness_binary_up_to_512)(node_str *n, bool vis);
+// built-in entries and those added with fitness_register
+#define FITNESS_MAX_ENTRIES 32
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    FITNESS_MINIMIZE,
+    FITNESS_MAXIMIZE
+} fitness_direction_typ;
+
+// how the individuals of an object type are evaluated, found by the name of the type in the module table
+typedef struct fitness_entry_str {
+    char name[25];
+    void (*fitness_init)(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);   // pre-cache hook, NULL if none
+    double (*fitness_single)(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file);
+    bool (*fitness_batch)(node_str** gen, uint32_t pop_size, double* fitness_values);   // NULL if evaluated one at a time
+    void (*fitness_cache)(double fitness, node_str* indiv, char* cache_file);
+    fitness_direction_typ direction;   // whether selection keeps the lower or the higher fitness
+} fitness_entry_str;
 
 /*
  * ROUTINES
@@ -66,7 +91,8 @@ uint32_t (*fpfitness_binary_up_to_512)(node_str *n, bool vis);
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -76,7 +102,7 @@ uint32_t (*fpfitness_binary_up_to_512)(node_str *n, bool vis);
  * EXAMPLE
  *
  * if (object_type == SIMPLE) {
- *     fitness_pre_cache_simple(main_folder, test_file);   
+ *     fitness_pre_cache_simple(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -85,7 +111,7 @@ uint32_t (*fpfitness_binary_up_to_512)(node_str *n, bool vis);
  *
  */
 
-void fitness_pre_cache_simple(char* folder, bool cache);
+void fitness_pre_cache_simple(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
 
 /*
  * NAME
@@ -162,7 +188,8 @@ uint32_t fitness_simple(node_str* indiv, bool vis);
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -172,7 +199,7 @@ uint32_t fitness_simple(node_str* indiv, bool vis);
  * EXAMPLE
  *
  * if (object_type == ASSEMBLER) {
- *     fitness_pre_cache_assembler(main_folder, test_file);   
+ *     fitness_pre_cache_assembler(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -181,7 +208,7 @@ uint32_t fitness_simple(node_str* indiv, bool vis);
  *
  */
 
-void fitness_pre_cache_assembler(char* folder, bool cache);
+void fitness_pre_cache_assembler(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
 
 /*
  * NAME
@@ -224,7 +251,8 @@ void fitness_cache_assembler(double fitness, node_str* indiv, char* cache_file);
  * DESCRIPTION
  *
  *  Calculates the fitness value specifically for an assembler
- *  individual, currently is only a default
+ *  individual, by running it on the register machine interpreter
+ *  over the cases of the current symbolic regression problem
  *
  * PARAMETERS
  *
@@ -258,7 +286,8 @@ uint32_t fitness_assembler(node_str* indiv, bool vis);
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -268,7 +297,7 @@ uint32_t fitness_assembler(node_str* indiv, bool vis);
  * EXAMPLE
  *
  * if (object_type == OSAKA_STRING) {
- *     fitness_pre_cache_osaka_string(main_folder, test_file);   
+ *     fitness_pre_cache_osaka_string(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -277,7 +306,7 @@ uint32_t fitness_assembler(node_str* indiv, bool vis);
  *
  */
 
-void fitness_pre_cache_osaka_string(char* folder, bool cache);
+void fitness_pre_cache_osaka_string(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
 
 /*
  * NAME
@@ -320,7 +349,9 @@ void fitness_cache_osaka_string(double fitness, node_str* indiv, char* cache_fil
  * DESCRIPTION
  *
  *  Calculates the fitness value specifically for an osaka_string
- *  individual, currently is only a default
+ *  individual, the distance of its strings joined by spaces from the
+ *  target sentence, by edit distance unless distance_set_target chose
+ *  Hamming distance
  *
  * PARAMETERS
  *
@@ -350,11 +381,12 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis);
  *
  * DESCRIPTION
  *
- *  Creates a file that describes the control values for fitness using LLVM opt
+ *  Builds the test file and, when caching, writes the control timings
+ *  with no and with basic optimization to the run log
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
  *  char* test_file - the file that will be measured for its control values
  *
  * RETURN
@@ -364,7 +396,7 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis);
  * EXAMPLE
  *
  * if (object_type == LLVM_PASS) {
- *     fitness_pre_cache_llvm_pass(main_folder, test_file);   
+ *     fitness_pre_cache_llvm_pass(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -373,7 +405,7 @@ uint32_t fitness_osaka_string(node_str* indiv, bool vis);
  *
  */
 
-void fitness_pre_cache_llvm_pass(char* folder, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
+void fitness_pre_cache_llvm_pass(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
 
 /*
  * NAME
@@ -417,7 +449,8 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  *
  * PARAMETERS
  *
- *  char* folder - the main run folder that the control will be saved to
+ *  runlog_str* log - the run log the control values are written to, NULL when not caching
+ *  char* test_file, char** src_files, uint32_t num_src_files - unused for this type
  *  char* bool - whether or not caching is being used
  *
  * RETURN
@@ -427,7 +460,7 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  * EXAMPLE
  *
  * if (object_type == BINARY_UP_TO_512) {
- *     fitness_pre_cache_llvm_pass(main_folder, test_file);   
+ *     fitness_pre_cache_llvm_pass(log, test_file);   
  * }
  *
  * SIDE-EFFECT
@@ -436,7 +469,7 @@ double fitness_llvm_pass(node_str* indiv, char* file, char** src_files, uint32_t
  *
  */
 
-void fitness_pre_cache_binary_up_to_512(char* folder, bool cache);
+void fitness_pre_cache_binary_up_to_512(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, bool cache);
 
 /*
  * NAME
@@ -479,7 +512,8 @@ void fitness_cache_binary_up_to_512(double fitness, node_str* indiv, char* cache
  * DESCRIPTION
  *
  * Calculates the fitness value specifically for an binary_up_to_512
- * inidividual, currently is only a default. AUTO-GENERATED
+ * inidividual, on the packed genome of its binaries with the problem set
+ * by bitset_set_problem, OneMax unless set otherwise
  *
  * PARAMETERS
  *
@@ -502,6 +536,71 @@ void fitness_cache_binary_up_to_512(double fitness, node_str* indiv, char* cache
 
 uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis);
 
+/*
+ * NAME
+ *
+ *   fitness_register
+ *
+ * DESCRIPTION
+ *
+ *  Adds an entry to the fitness registry, or replaces the entry
+ *  that has the same name. The name is the name of an object
+ *  type in the module table, so a new module can be evaluated
+ *  without any change to fitness.c. Entries are meant to be
+ *  registered before evolution starts, not while it runs
+ *
+ * PARAMETERS
+ *
+ *  fitness_entry_str* entry - the entry, copied into the registry
+ *
+ * RETURN
+ *
+ *  bool - false if the registry is full or the entry has no fitness_single
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str entry = { "SIMPLE", NULL, my_fitness, NULL, NULL, FITNESS_MAXIMIZE };
+ *  fitness_register(&entry);
+ *
+ * SIDE-EFFECT
+ *
+ *  alters the registry, object types are looked up again
+ *
+ */
+
+bool fitness_register(fitness_entry_str* entry);
+
+/*
+ * NAME
+ *
+ *   fitness_lookup
+ *
+ * DESCRIPTION
+ *
+ *  The registry entry of an object type, found by the name the
+ *  type has in the module table. A type with no entry gets the
+ *  default one, whose fitness is always 100
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ type - the object type
+ *
+ * RETURN
+ *
+ *  fitness_entry_str* - the entry of the type, never NULL
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str* entry = fitness_lookup(BINARY_UP_TO_512);
+ *
+ * SIDE-EFFECT
+ *
+ *  remembers the entry of the type for the next lookup
+ *
+ */
+
+fitness_entry_str* fitness_lookup(osaka_object_typ type);
+
 /*
  * NAME
  *
@@ -509,11 +608,12 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis);
  *
  * DESCRIPTION
  *
- *  Does an initial setup cache, is dependent on the object type
+ *  Does an initial setup cache with the init hook of the
+ *  registry entry of the object type, if it has one
  *
  * PARAMETERS
  *
- *  char* folder - the folder where the pre caching files will be housed
+ *  runlog_str* log - the run log the pre caching records are written to, NULL when not caching
  *  char* file - for some object types, will be a file used for the caching
  *  osaka_object_typ type - the object type for this evolutionary run
  *
@@ -524,7 +624,7 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis);
  * EXAMPLE
  *
  *  if (cache) {
- *      fitness_pre_cache(main_folder, test_file, ot);    
+ *      fitness_pre_cache(log, test_file, ot);
  *  }
  *
  * SIDE-EFFECT
@@ -533,7 +633,7 @@ uint32_t fitness_binary_up_to_512(node_str* indiv, bool vis);
  *
  */
 
-void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t num_src_files, osaka_object_typ type, bool cache);
+void fitness_pre_cache(runlog_str* log, char* test_file, char** src_files, uint32_t num_src_files, osaka_object_typ type, bool cache);
 
 /*
  * NAME
@@ -542,7 +642,8 @@ void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t
  *
  * DESCRIPTION
  *
- *  Caches 
+ *  Caches an individual with the cache hook of the registry
+ *  entry of its object type, if it has one
  *
  * PARAMETERS
  *
@@ -566,6 +667,42 @@ void fitness_pre_cache(char* folder, char* test_file, char** src_files, uint32_t
 
 void fitness_cache(double fitness_value, node_str* indiv, char* cache_file);
 
+/*
+ * NAME
+ *
+ *  fitness_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a whole generation at once with the batch function of
+ *  the registry entry of its object type. With the AArch64 evaluator
+ *  enabled, an ASSEMBLER generation runs in one launch of the emulator.
+ *  An OSAKA_STRING generation has its string distances taken in the
+ *  lanes of a vector. The values are those of the entry as they are,
+ *  selection reads the direction of the entry to compare them
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen - the generation to evaluate
+ *  double* fitness_values - filled with the fitness of every individual
+ *  uint32_t pop_size - size of the generation
+ *
+ * RETURN
+ *
+ *  bool - true if the generation was evaluated, false if it is left to fitness_top
+ *
+ * EXAMPLE
+ *
+ *  if (!fitness_generation(current_generation, fitness_values, pop_size)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  may build and run a program, fills the interpreter or distance memo
+ *
+ */
+
+bool fitness_generation(node_str** gen, double* fitness_values, uint32_t pop_size);
+
 /*
  * NAME
  *
@@ -573,8 +710,12 @@ void fitness_cache(double fitness_value, node_str* indiv, char* cache_file);
  *
  * DESCRIPTION
  *
- *  Applies the correct fitness function based on the
- *  specific object type of the individual
+ *  Applies the fitness function of the registry entry of the
+ *  object type of the individual, or the synthetic evaluator
+ *  of mock.h when it is enabled. LLVM_PASS individuals are
+ *  evaluated over the benchmark suite of suite.h when one is
+ *  enabled. The fitness is returned as the entry gives it,
+ *  whether lower or higher is better is the direction of the entry
  *
  * PARAMETERS
  *
@@ -604,8 +745,9 @@ double fitness_top(node_str* indiv, bool vis, char* test_file, char** src_files,
  *
  * DESCRIPTION
  *
- *  initializes all typdefs for function pointers to their
- *  respective methods in fitness.h
+ *  Looks up the registry entry of every object type in the
+ *  module table ahead of the first evaluation, which would
+ *  otherwise look each type up on first use
  *
  * PARAMETERS
  *
@@ -621,7 +763,7 @@ double fitness_top(node_str* indiv, bool vis, char* test_file, char** src_files,
  *
  * SIDE-EFFECT
  *
- * alters the typedefs
+ * remembers the entry of every object type
  *
  */
 
@@ -109,14 +109,44 @@ node_str* generate_new_initialized_node(osaka_object_typ osaka_type) {
 
 node_str* generate_new_individual(uint32_t individual_size, osaka_object_typ osaka_type) {
     
-    node_str *head = generate_new_initialized_node(osaka_type);
+    osaka_list_str individual;
+    osaka_list_init(&individual, NULL);
+
+    // types without a batch kernel keep drawing from rand() one node at a time
+    if (object_table_function[osaka_type].osaka_randomizebatch == NULL) {
+
+        // add as many nodes as is the individual_size to the single individual,
+        // the header keeps track of the tail so each addition is constant time
+        for (uint32_t k = 0; k < individual_size; k++) {
+            osaka_list_addnodetotail(&individual, generate_new_initialized_node(osaka_type));
+        }
+
+        return osaka_list_attach(&individual);
 
-    // add as many nodes as is the individual_size to the single individual
-    for (uint32_t k = 0; k < individual_size - 1; k++) {
-        head = osaka_addnodetotail(head, generate_new_initialized_node(osaka_type));
     }
 
-    return head;
+    // otherwise nodes are created OSAKA_BATCH at a time and all of their
+    // objects are randomized in one call from a generator seeded by rand()
+    node_str* batch[OSAKA_BATCH];
+    uint64_t state = rand_state();
+
+    for (uint32_t k = 0; k < individual_size; k += OSAKA_BATCH) {
+
+        uint32_t count = individual_size - k < OSAKA_BATCH ? individual_size - k : OSAKA_BATCH;
+
+        for (uint32_t b = 0; b < count; b++) {
+            batch[b] = osaka_createnode(NULL, HEAD, osaka_type);
+        }
+
+        osaka_randomizenodes(batch, count, &state);
+
+        for (uint32_t b = 0; b < count; b++) {
+            osaka_list_addnodetotail(&individual, batch[b]);
+        }
+
+    }
+
+    return osaka_list_attach(&individual);
 
 }
 
@@ -232,15 +262,17 @@ void generate_copy_generation(node_str** orig, node_str** copy, uint32_t generat
 
 void generate_free_individual(node_str* indiv) {
 
-    // we must free every single node in this individual
-    uint32_t list_length = osaka_listlength(indiv);
-
-    for (uint32_t i = list_length; i > 0; i--) {
-
-        osaka_deletenode(osaka_nthnode(indiv, i));
-
+    // we must free every single node in this individual, walking it
+    // once from the head rather than looking up each node from the tail
+    if (indiv != NULL && LIST(indiv) != NULL) {
+        osaka_list_free(LIST(indiv));
+        return;
     }
 
+    osaka_list_str individual;
+    osaka_list_init(&individual, indiv);
+    osaka_list_free(&individual);
+
 }
 
 /*
@@ -274,14 +306,7 @@ void generate_free_individual(node_str* indiv) {
 
 void generate_free_individual_inside_array(node_str** array, uint32_t gen_size, uint32_t ind, node_str* indiv) {
 
-    // we must free every single node in this individual
-    uint32_t list_length = osaka_listlength(indiv);
-
-    for (uint32_t i = list_length; i > 0; i--) {
-
-        osaka_deletenode(osaka_nthnode(indiv, i));
-
-    }
+    generate_free_individual(indiv);
 
     for (int k = ind; k < gen_size - 1; k++) {
 
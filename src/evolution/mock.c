@@ -0,0 +1,526 @@
+/*
+ ============================================================================
+ Name        : mock.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Deterministic synthetic evaluator. While enabled it replaces
+               the fitness function of every object type, so the whole
+               evolution loop can be benchmarked without LLVM. Each
+               evaluation burns a configurable amount of CPU, waits for a
+               latency drawn from a configurable distribution, and returns
+               a fitness derived from the genes plus configurable noise
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "mock.h"
+
+/*
+ * STATIC
+ */
+
+static mock_config_str mock_config;
+static _Atomic bool mock_active = false;
+static _Atomic uint64_t mock_num_evaluations = 0;
+static _Atomic uint64_t mock_total_busy_ns = 0;
+
+static const char* mock_latency_names[] = { "constant", "uniform", "exponential" };
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __mock_uniform
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, the next value of a counter based generator in [0,
+ *  1). The state is advanced by a constant and mixed, so every stream is
+ *  fully determined by its starting state
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state
+ *
+ * RETURN
+ *
+ *  double -- uniform value in [0, 1)
+ *
+ * EXAMPLE
+ *
+ *  double u = __mock_uniform(&state);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+double __mock_uniform(uint64_t* state) {
+
+    *state += 0x9e3779b97f4a7c15ULL;
+
+    return (hash_mix64(*state) >> 11) * 0x1.0p-53;
+
+}
+
+/*
+ * NAME
+ *
+ *   __mock_spin
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that keeps the CPU busy for a number of nanoseconds
+ *
+ * PARAMETERS
+ *
+ *  uint64_t ns -- time to burn
+ *  uint64_t h -- value to start mixing from
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __mock_spin(mock_config.cost_ns, state);
+ *
+ * SIDE-EFFECT
+ *
+ *  burns CPU
+ *
+ */
+
+void __mock_spin(uint64_t ns, uint64_t h) {
+
+    uint64_t start = instrument_now_ns();
+
+    while (instrument_now_ns() - start < ns) {
+        for (uint32_t i = 0; i < 64; i++) {
+            h = hash_mix64(h);
+        }
+    }
+
+    // stored so the mixing cannot be optimized away
+    volatile uint64_t sink = h;
+    (void) sink;
+
+}
+
+/*
+ * NAME
+ *
+ *   __mock_wait
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that sleeps for a number of nanoseconds
+ *
+ * PARAMETERS
+ *
+ *  uint64_t ns -- time to wait
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __mock_wait(latency);
+ *
+ * SIDE-EFFECT
+ *
+ *  sleeps
+ *
+ */
+
+void __mock_wait(uint64_t ns) {
+
+    struct timespec wait = { ns / 1000000000ull, ns % 1000000000ull };
+
+    if (ns > 0) {
+        nanosleep(&wait, NULL);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_enable
+ *
+ * DESCRIPTION
+ *
+ *  Enables the synthetic evaluator with the given configuration and
+ *  resets its statistics. From then on fitness_top uses mock_fitness for
+ *  every object type
+ *
+ * PARAMETERS
+ *
+ *  mock_config_str* config -- cost, latency, noise and seed of the evaluations
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_config_str config = { 1000000, 0, MOCK_LATENCY_CONSTANT, 5.0, 42 };
+ *  mock_enable(&config);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the fitness functions
+ *
+ */
+
+void mock_enable(mock_config_str* config) {
+
+    mock_config = *config;
+    mock_reset_stats();
+    atomic_store(&mock_active, true);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_disable
+ *
+ * DESCRIPTION
+ *
+ *  Disables the synthetic evaluator, the real fitness functions are used
+ *  again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  restores the fitness functions
+ *
+ */
+
+void mock_disable(void) {
+
+    atomic_store(&mock_active, false);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether the synthetic evaluator replaces the fitness functions
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between mock_enable and mock_disable
+ *
+ * EXAMPLE
+ *
+ *  if (mock_enabled()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool mock_enabled(void) {
+
+    return atomic_load(&mock_active);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates an individual. The fitness is 100 times the mean of a value
+ *  in [0, 1) hashed from each gene, plus noise with a standard deviation
+ *  of config.noise. Everything random is drawn from a generator seeded
+ *  with the hash of the individual and config.seed, so the same genes
+ *  always give the same fitness and latency, whichever thread and in
+ *  whichever order they are evaluated. Safe to call from many threads
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- individual to evaluate
+ *
+ * RETURN
+ *
+ *  double -- the fitness value
+ *
+ * EXAMPLE
+ *
+ *  fitness_values[k] = mock_fitness(current_generation[k]);
+ *
+ * SIDE-EFFECT
+ *
+ *  burns CPU and sleeps as configured, counts the evaluation
+ *
+ */
+
+double mock_fitness(node_str* indiv) {
+
+    uint64_t start = instrument_now_ns();
+    uint64_t state = hash_combine(osaka_hash(indiv), mock_config.seed);
+    uint32_t length = 0;
+    double score = 0.0;
+
+    for (node_str* n = indiv; n != NULL; n = NEXT(n)) {
+        score += (osaka_hashnode(n) >> 11) * 0x1.0p-53;
+        length++;
+    }
+
+    double fitness = length > 0 ? 100.0 * score / length : 0.0;
+
+    // a sum of twelve uniform values is close to normal with a variance of one
+    if (mock_config.noise > 0.0) {
+        double sum = 0.0;
+        for (uint32_t i = 0; i < 12; i++) {
+            sum += __mock_uniform(&state);
+        }
+        fitness += mock_config.noise * (sum - 6.0);
+    }
+
+    uint64_t latency = mock_config.latency_ns;
+
+    if (mock_config.latency == MOCK_LATENCY_UNIFORM) {
+        latency = (uint64_t) (2.0 * mock_config.latency_ns * __mock_uniform(&state));
+    }
+    else if (mock_config.latency == MOCK_LATENCY_EXPONENTIAL) {
+        latency = (uint64_t) (-log(1.0 - __mock_uniform(&state)) * mock_config.latency_ns);
+    }
+
+    __mock_spin(mock_config.cost_ns, state);
+    __mock_wait(latency);
+
+    atomic_fetch_add(&mock_num_evaluations, 1);
+    atomic_fetch_add(&mock_total_busy_ns, instrument_now_ns() - start);
+
+    return fitness;
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_reset_stats
+ *
+ * DESCRIPTION
+ *
+ *  Zeroes the evaluation count and the time spent evaluating
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_reset_stats();
+ *
+ * SIDE-EFFECT
+ *
+ *  resets the statistics
+ *
+ */
+
+void mock_reset_stats(void) {
+
+    atomic_store(&mock_num_evaluations, 0);
+    atomic_store(&mock_total_busy_ns, 0);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_evaluations
+ *
+ * DESCRIPTION
+ *
+ *  Number of evaluations since the statistics were last reset
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- evaluations
+ *
+ * EXAMPLE
+ *
+ *  uint64_t evaluations = mock_evaluations();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t mock_evaluations(void) {
+
+    return atomic_load(&mock_num_evaluations);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_busy_ns
+ *
+ * DESCRIPTION
+ *
+ *  Time spent inside mock_fitness since the statistics were last reset,
+ *  summed over all threads. Divided by the wall time and the number of
+ *  workers it gives how busy the evaluators were kept
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds
+ *
+ * EXAMPLE
+ *
+ *  double utilization = (double) mock_busy_ns() / (wall_ns * workers);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t mock_busy_ns(void) {
+
+    return atomic_load(&mock_total_busy_ns);
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_latency_name
+ *
+ * DESCRIPTION
+ *
+ *  Name of a latency distribution, as used on the command line
+ *
+ * PARAMETERS
+ *
+ *  mock_latency_typ latency -- the distribution
+ *
+ * RETURN
+ *
+ *  const char* -- constant, uniform or exponential
+ *
+ * EXAMPLE
+ *
+ *  printf("%s\\n", mock_latency_name(config.latency));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+const char* mock_latency_name(mock_latency_typ latency) {
+
+    return mock_latency_names[latency];
+
+}
+
+/*
+ * NAME
+ *
+ *   mock_latency_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Latency distribution with a given name
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- constant, uniform or exponential
+ *
+ * RETURN
+ *
+ *  mock_latency_typ -- the distribution
+ *
+ * EXAMPLE
+ *
+ *  config.latency = mock_latency_from_name(argv[++curr]);
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the name is unknown
+ *
+ */
+
+mock_latency_typ mock_latency_from_name(const char* name) {
+
+    for (uint32_t i = 0; i < sizeof(mock_latency_names) / sizeof(char*); i++) {
+        if (strcmp(name, mock_latency_names[i]) == 0) {
+            return (mock_latency_typ) i;
+        }
+    }
+
+    printf("error: unknown latency distribution %s, use constant, uniform or exponential [file:\'%s\',line:%d]\n", name, __FILE__, __LINE__);
+    exit(0);
+
+}
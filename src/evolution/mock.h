@@ -0,0 +1,347 @@
+/*
+ ============================================================================
+ Name        : mock.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Deterministic synthetic evaluator. While enabled it replaces
+               the fitness function of every object type, so the whole
+               evolution loop can be benchmarked without LLVM. Each
+               evaluation burns a configurable amount of CPU, waits for a
+               latency drawn from a configurable distribution, and returns
+               a fitness derived from the genes plus configurable noise
+ ============================================================================
+ */
+
+#ifndef EVOLUTION_MOCK_H_
+#define EVOLUTION_MOCK_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../support/instrument.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <stdatomic.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    MOCK_LATENCY_CONSTANT,
+    MOCK_LATENCY_UNIFORM,
+    MOCK_LATENCY_EXPONENTIAL
+} mock_latency_typ;
+
+typedef struct mock_config_str {
+    uint64_t cost_ns;
+    uint64_t latency_ns;
+    mock_latency_typ latency;
+    double noise;
+    uint64_t seed;
+} mock_config_str;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   mock_enable
+ *
+ * DESCRIPTION
+ *
+ *  Enables the synthetic evaluator with the given configuration and
+ *  resets its statistics. From then on fitness_top uses mock_fitness for
+ *  every object type
+ *
+ * PARAMETERS
+ *
+ *  mock_config_str* config -- cost, latency, noise and seed of the evaluations
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_config_str config = { 1000000, 0, MOCK_LATENCY_CONSTANT, 5.0, 42 };
+ *  mock_enable(&config);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the fitness functions
+ *
+ */
+
+void mock_enable(mock_config_str* config);
+
+/*
+ * NAME
+ *
+ *   mock_disable
+ *
+ * DESCRIPTION
+ *
+ *  Disables the synthetic evaluator, the real fitness functions are used
+ *  again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  restores the fitness functions
+ *
+ */
+
+void mock_disable(void);
+
+/*
+ * NAME
+ *
+ *   mock_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether the synthetic evaluator replaces the fitness functions
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between mock_enable and mock_disable
+ *
+ * EXAMPLE
+ *
+ *  if (mock_enabled()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool mock_enabled(void);
+
+/*
+ * NAME
+ *
+ *   mock_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates an individual. The fitness is 100 times the mean of a value
+ *  in [0, 1) hashed from each gene, plus noise with a standard deviation
+ *  of config.noise. Everything random is drawn from a generator seeded
+ *  with the hash of the individual and config.seed, so the same genes
+ *  always give the same fitness and latency, whichever thread and in
+ *  whichever order they are evaluated. Safe to call from many threads
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- individual to evaluate
+ *
+ * RETURN
+ *
+ *  double -- the fitness value
+ *
+ * EXAMPLE
+ *
+ *  fitness_values[k] = mock_fitness(current_generation[k]);
+ *
+ * SIDE-EFFECT
+ *
+ *  burns CPU and sleeps as configured, counts the evaluation
+ *
+ */
+
+double mock_fitness(node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   mock_reset_stats
+ *
+ * DESCRIPTION
+ *
+ *  Zeroes the evaluation count and the time spent evaluating
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mock_reset_stats();
+ *
+ * SIDE-EFFECT
+ *
+ *  resets the statistics
+ *
+ */
+
+void mock_reset_stats(void);
+
+/*
+ * NAME
+ *
+ *   mock_evaluations
+ *
+ * DESCRIPTION
+ *
+ *  Number of evaluations since the statistics were last reset
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- evaluations
+ *
+ * EXAMPLE
+ *
+ *  uint64_t evaluations = mock_evaluations();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t mock_evaluations(void);
+
+/*
+ * NAME
+ *
+ *   mock_busy_ns
+ *
+ * DESCRIPTION
+ *
+ *  Time spent inside mock_fitness since the statistics were last reset,
+ *  summed over all threads. Divided by the wall time and the number of
+ *  workers it gives how busy the evaluators were kept
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds
+ *
+ * EXAMPLE
+ *
+ *  double utilization = (double) mock_busy_ns() / (wall_ns * workers);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t mock_busy_ns(void);
+
+/*
+ * NAME
+ *
+ *   mock_latency_name
+ *
+ * DESCRIPTION
+ *
+ *  Name of a latency distribution, as used on the command line
+ *
+ * PARAMETERS
+ *
+ *  mock_latency_typ latency -- the distribution
+ *
+ * RETURN
+ *
+ *  const char* -- constant, uniform or exponential
+ *
+ * EXAMPLE
+ *
+ *  printf("%s\\n", mock_latency_name(config.latency));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+const char* mock_latency_name(mock_latency_typ latency);
+
+/*
+ * NAME
+ *
+ *   mock_latency_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Latency distribution with a given name
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- constant, uniform or exponential
+ *
+ * RETURN
+ *
+ *  mock_latency_typ -- the distribution
+ *
+ * EXAMPLE
+ *
+ *  config.latency = mock_latency_from_name(argv[++curr]);
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the name is unknown
+ *
+ */
+
+mock_latency_typ mock_latency_from_name(const char* name);
+
+#endif /* EVOLUTION_MOCK_H_ */
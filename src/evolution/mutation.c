@@ -34,6 +34,14 @@
 
 #include "mutation.h"
 
+/*
+ * STATIC
+ */
+
+static mutation_operator_typ mutation_operator = MUTATION_ALL_PARAMS;
+
+static const char* mutation_operator_names[] = { "all_params", "single_param" };
+
 /*
  * ROUTINES
  */
@@ -71,36 +79,85 @@
 void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis) {
 
     if (vis) {
-        printf("\nPerforming all params mutation on individual, node %d in that structure ---------------\n", ind);
-        printf("\nIndividual before mutation to node %d, with node to be changed marked: ----------------\n\n", ind);
+        output_printf(stdout, "\nPerforming all params mutation on individual, node %d in that structure ---------------\n", ind);
+        output_printf(stdout, "\nIndividual before mutation to node %d, with node to be changed marked: ----------------\n\n", ind);
         if (ind > 1) {
             visualization_print_individual_concise_details_to_nth(osaka, ind);
-            printf(" <--(((--> { ");
+            output_printf(stdout, " <--(((--> { ");
         }
         else {
-            printf("(((--> { ");
+            output_printf(stdout, "(((--> { ");
         }
         osaka_printnode_concise(osaka_nthnode(osaka, ind));
         if (ind < osaka_listlength(osaka)) {
-            printf(" } <--)))--> ");
+            output_printf(stdout, " } <--)))--> ");
             visualization_print_individual_concise_details_from_nth(osaka, ind + 1);
         }
         else {
-            printf(" } )))");
+            output_printf(stdout, " } )))");
         }
     }
 
     node_str* node_to_mutate = osaka_nthnode(osaka, ind);
-    osaka_randomizenode(node_to_mutate);
+
+    // a type with a batch kernel draws from its own generator, seeded by rand()
+    if (object_table_function[OBJECT_TYPE(node_to_mutate)].osaka_randomizebatch != NULL) {
+        uint64_t state = rand_state();
+        osaka_randomizenodes(&node_to_mutate, 1, &state);
+    }
+    else {
+        osaka_randomizenode(node_to_mutate);
+    }
 
     if (vis) {
-        printf("\n\nIndividual after mutation to node %d: -------------------------------------------------\n\n", ind);
+        output_printf(stdout, "\n\nIndividual after mutation to node %d: -------------------------------------------------\n\n", ind);
         visualization_print_individual_concise_details(osaka);
-        printf("\n");
+        output_printf(stdout, "\n");
     }
 
 }
 
+/*
+ * NAME
+ *
+ *   mutation_single_unit_all_params_persistent
+ *
+ * DESCRIPTION
+ *
+ *  Persistent counterpart of mutation_single_unit_all_params. Returns
+ *  a new individual with all parameters of one unit changed, sharing
+ *  every other unit with the original individual
+ *
+ * PARAMETERS
+ *
+ *  persistent_str* osaka -- the individual, left unchanged
+ *  uint32_t -- the index of the unit to change in the individual
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  persistent_str* -- the mutated individual
+ *
+ * EXAMPLE
+ *
+ * mutant = mutation_single_unit_all_params_persistent(osaka, 5, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the mutated individual
+ *
+ */
+
+persistent_str* mutation_single_unit_all_params_persistent(persistent_str* osaka, uint32_t ind, bool vis) {
+
+    if (vis) {
+        output_printf(stdout, "\nPerforming persistent all params mutation on individual, node %d in that structure ----\n", ind);
+    }
+
+    return osaka_persistent_mutate(osaka, ind);
+
+}
+
 /*
  * NAME
  *
@@ -109,7 +166,10 @@ void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis) {
  * DESCRIPTION
  *
  *  Takes in a single individual and changes the value of
- *  one parameter of a single unit at random
+ *  one parameter of a single unit, with the mutate method of
+ *  that parameter. Parameters are picked by the weights their
+ *  type lists in mutatorsobject. Types without mutate methods
+ *  use their mutate kernel, or have the whole unit randomized
  *
  * PARAMETERS
  *
@@ -132,4 +192,257 @@ void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis) {
 
 void mutation_single_unit_single_param(node_str* osaka, uint32_t ind) {
 
+    uint64_t state = rand_state();
+
+    mutation_single_unit_single_param_state(osaka, ind, &state);
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_single_unit_single_param_state
+ *
+ * DESCRIPTION
+ *
+ *  Same as mutation_single_unit_single_param, but draws the
+ *  parameter and its new value from a caller owned generator
+ *  instead of one seeded from rand()
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka -- the head of the individual
+ *  uint32_t -- the index of the unit to change in the individual
+ *  uint64_t* state -- generator state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * mutation_single_unit_single_param_state(osaka, 6, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka, advances the state
+ *
+ */
+
+void mutation_single_unit_single_param_state(node_str* osaka, uint32_t ind, uint64_t* state) {
+
+    node_str* node_to_mutate = osaka_nthnode(osaka, ind);
+
+    void (*mutators[OBJECT_MAX_FIELDS])(void *, uint64_t *);
+    uint32_t weights[OBJECT_MAX_FIELDS];
+    uint32_t count = 0;
+    uint32_t total = 0;
+
+    if (object_table_function[OBJECT_TYPE(node_to_mutate)].osaka_mutatorsobject != NULL) {
+        count = object_table_function[OBJECT_TYPE(node_to_mutate)].osaka_mutatorsobject(mutators, weights);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += weights[i];
+    }
+
+    if (total == 0) {
+        osaka_mutatenode(node_to_mutate, state);
+        return;
+    }
+
+    // walk the weights until the draw falls inside one, params with a weight of 0 are never picked
+    uint32_t r = bounded_rand(state, total);
+    uint32_t param = 0;
+
+    while (r >= weights[param]) {
+        r -= weights[param];
+        param++;
+    }
+
+    mutators[param](OBJECT(node_to_mutate), state);
+    HASH_VALID(node_to_mutate)=false;
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_single_unit
+ *
+ * DESCRIPTION
+ *
+ *  Mutates a single unit of an individual with the operator
+ *  chosen by mutation_set_operator, all params unless told
+ *  otherwise. This is the mutation of the evolution loop
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka -- the head of the individual
+ *  uint32_t -- the index of the unit to change in the individual
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * mutation_single_unit(osaka, 5, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka
+ *
+ */
+
+void mutation_single_unit(node_str* osaka, uint32_t ind, bool vis) {
+
+    if (mutation_operator == MUTATION_SINGLE_PARAM) {
+        mutation_single_unit_single_param(osaka, ind);
+    }
+    else {
+        mutation_single_unit_all_params(osaka, ind, vis);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_set_operator
+ *
+ * DESCRIPTION
+ *
+ *  Sets the operator mutation_single_unit applies. Must not be
+ *  changed while a generation is being bred
+ *
+ * PARAMETERS
+ *
+ *  mutation_operator_typ op -- MUTATION_ALL_PARAMS or MUTATION_SINGLE_PARAM
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mutation_set_operator(MUTATION_SINGLE_PARAM);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the mutation of later generations
+ *
+ */
+
+void mutation_set_operator(mutation_operator_typ op) {
+
+    mutation_operator = op;
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_get_operator
+ *
+ * DESCRIPTION
+ *
+ *  Operator mutation_single_unit applies, see mutation_set_operator
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  mutation_operator_typ -- the current operator
+ *
+ * EXAMPLE
+ *
+ *  mutation_operator_typ previous = mutation_get_operator();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+mutation_operator_typ mutation_get_operator(void) {
+
+    return mutation_operator;
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_operator_name
+ *
+ * DESCRIPTION
+ *
+ *  Name of a mutation operator, as used in the parameters file and jobs
+ *
+ * PARAMETERS
+ *
+ *  mutation_operator_typ op -- the operator
+ *
+ * RETURN
+ *
+ *  const char* -- all_params or single_param
+ *
+ * EXAMPLE
+ *
+ *  printf("%s\\n", mutation_operator_name(mutation_get_operator()));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+const char* mutation_operator_name(mutation_operator_typ op) {
+
+    return mutation_operator_names[op];
+
+}
+
+/*
+ * NAME
+ *
+ *   mutation_operator_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Mutation operator with a given name
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- all_params or single_param
+ *
+ * RETURN
+ *
+ *  mutation_operator_typ -- the operator
+ *
+ * EXAMPLE
+ *
+ *  mutation_set_operator(mutation_operator_from_name(name));
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the name is unknown
+ *
+ */
+
+mutation_operator_typ mutation_operator_from_name(const char* name) {
+
+    for (uint32_t i = 0; i < sizeof(mutation_operator_names) / sizeof(char*); i++) {
+        if (strcmp(name, mutation_operator_names[i]) == 0) {
+            return (mutation_operator_typ) i;
+        }
+    }
+
+    printf("error: unknown mutation operator %s, use all_params or single_param [file:\'%s\',line:%d]\n", name, __FILE__, __LINE__);
+    exit(0);
+
 }
\ No newline at end of file
@@ -36,8 +36,18 @@
  */
 
 #include "../osaka/osaka.h"
+#include "../osaka/osaka_persistent.h"
 #include "../support/visualization.h"
 
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    MUTATION_ALL_PARAMS,
+    MUTATION_SINGLE_PARAM
+} mutation_operator_typ;
+
 /*
  * ROUTINES
  */
@@ -74,6 +84,39 @@
 
 void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis);
 
+/*
+ * NAME
+ *
+ *   mutation_single_unit_all_params_persistent
+ *
+ * DESCRIPTION
+ *
+ *  Persistent counterpart of mutation_single_unit_all_params. Returns
+ *  a new individual with all parameters of one unit changed, sharing
+ *  every other unit with the original individual
+ *
+ * PARAMETERS
+ *
+ *  persistent_str* osaka -- the individual, left unchanged
+ *  uint32_t -- the index of the unit to change in the individual
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  persistent_str* -- the mutated individual
+ *
+ * EXAMPLE
+ *
+ * mutant = mutation_single_unit_all_params_persistent(osaka, 5, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the mutated individual
+ *
+ */
+
+persistent_str* mutation_single_unit_all_params_persistent(persistent_str* osaka, uint32_t ind, bool vis);
+
 /*
  * NAME
  *
@@ -82,7 +125,10 @@ void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis);
  * DESCRIPTION
  *
  *  Takes in a single individual and changes the value of
- *  one parameter of a single unit at random
+ *  one parameter of a single unit, with the mutate method of
+ *  that parameter. Parameters are picked by the weights their
+ *  type lists in mutatorsobject. Types without mutate methods
+ *  use their mutate kernel, or have the whole unit randomized
  *
  * PARAMETERS
  *
@@ -105,4 +151,187 @@ void mutation_single_unit_all_params(node_str* osaka, uint32_t ind, bool vis);
 
 void mutation_single_unit_single_param(node_str* osaka, uint32_t ind);
 
+/*
+ * NAME
+ *
+ *   mutation_single_unit_single_param_state
+ *
+ * DESCRIPTION
+ *
+ *  Same as mutation_single_unit_single_param, but draws the
+ *  parameter and its new value from a caller owned generator
+ *  instead of one seeded from rand()
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka -- the head of the individual
+ *  uint32_t -- the index of the unit to change in the individual
+ *  uint64_t* state -- generator state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * mutation_single_unit_single_param_state(osaka, 6, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka, advances the state
+ *
+ */
+
+void mutation_single_unit_single_param_state(node_str* osaka, uint32_t ind, uint64_t* state);
+
+/*
+ * NAME
+ *
+ *   mutation_single_unit
+ *
+ * DESCRIPTION
+ *
+ *  Mutates a single unit of an individual with the operator
+ *  chosen by mutation_set_operator, all params unless told
+ *  otherwise. This is the mutation of the evolution loop
+ *
+ * PARAMETERS
+ *
+ *  *node_str osaka -- the head of the individual
+ *  uint32_t -- the index of the unit to change in the individual
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * mutation_single_unit(osaka, 5, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits osaka
+ *
+ */
+
+void mutation_single_unit(node_str* osaka, uint32_t ind, bool vis);
+
+/*
+ * NAME
+ *
+ *   mutation_set_operator
+ *
+ * DESCRIPTION
+ *
+ *  Sets the operator mutation_single_unit applies. Must not be
+ *  changed while a generation is being bred
+ *
+ * PARAMETERS
+ *
+ *  mutation_operator_typ op -- MUTATION_ALL_PARAMS or MUTATION_SINGLE_PARAM
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  mutation_set_operator(MUTATION_SINGLE_PARAM);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the mutation of later generations
+ *
+ */
+
+void mutation_set_operator(mutation_operator_typ op);
+
+/*
+ * NAME
+ *
+ *   mutation_get_operator
+ *
+ * DESCRIPTION
+ *
+ *  Operator mutation_single_unit applies, see mutation_set_operator
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  mutation_operator_typ -- the current operator
+ *
+ * EXAMPLE
+ *
+ *  mutation_operator_typ previous = mutation_get_operator();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+mutation_operator_typ mutation_get_operator(void);
+
+/*
+ * NAME
+ *
+ *   mutation_operator_name
+ *
+ * DESCRIPTION
+ *
+ *  Name of a mutation operator, as used in the parameters file and jobs
+ *
+ * PARAMETERS
+ *
+ *  mutation_operator_typ op -- the operator
+ *
+ * RETURN
+ *
+ *  const char* -- all_params or single_param
+ *
+ * EXAMPLE
+ *
+ *  printf("%s\\n", mutation_operator_name(mutation_get_operator()));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+const char* mutation_operator_name(mutation_operator_typ op);
+
+/*
+ * NAME
+ *
+ *   mutation_operator_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Mutation operator with a given name
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- all_params or single_param
+ *
+ * RETURN
+ *
+ *  mutation_operator_typ -- the operator
+ *
+ * EXAMPLE
+ *
+ *  mutation_set_operator(mutation_operator_from_name(name));
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the name is unknown
+ *
+ */
+
+mutation_operator_typ mutation_operator_from_name(const char* name);
+
 #endif /* EVOLUTION_MUTATION_H_ */
\ No newline at end of file
@@ -0,0 +1,628 @@
+/*
+ ============================================================================
+ Name        : population.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Population container that stores the genes of every
+               individual of a generation as one structure-of-arrays matrix.
+               Each gene is encoded into a few uint32_t fields by its module,
+               and every (position, field) column holds that field for all
+               individuals contiguously, so population wide randomization,
+               copying, mutation and diversity statistics are flat loops
+               instead of per node pointer walks
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "population.h"
+#include <string.h>
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __population_compare_fields
+ *
+ * DESCRIPTION
+ *
+ *  Internal qsort comparison for uint32_t fields
+ *
+ * PARAMETERS
+ *
+ *  const void* a
+ *  const void* b
+ *
+ * RETURN
+ *
+ *  int -- negative, zero or positive as a is below, equal to or above b
+ *
+ * EXAMPLE
+ *
+ *  qsort(values, n, sizeof(uint32_t), __population_compare_fields);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+int __population_compare_fields(const void* a, const void* b) {
+
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+
+    return (x > y) - (x < y);
+
+}
+
+/*
+ * NAME
+ *
+ *   population_create
+ *
+ * DESCRIPTION
+ *
+ *  Allocates a population of pop_size individuals of indiv_size genes of
+ *  the given type. The number of fields per gene and their ranges come
+ *  from the osaka_fieldsobject hook of the type. The genes are zeroed,
+ *  see population_randomize and population_fromlists
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *
+ * RETURN
+ *
+ *  population_str* -- the new population
+ *
+ * EXAMPLE
+ *
+ *  population_str* pop = population_create(10000, 100, LLVM_PASS);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with population_free
+ *
+ */
+
+population_str* population_create(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot) {
+
+    assert(ot >= 0 && ot < MAXTYPE);
+    assert(object_table_function[ot].osaka_fieldsobject != NULL);
+
+    population_str* p = malloc(sizeof(population_str));
+
+    if (p == NULL) {
+        printf("error: failed to alloc memory for population_str [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    p->objtype = ot;
+    p->pop_size = pop_size;
+    p->indiv_size = indiv_size;
+    p->num_fields = object_table_function[ot].osaka_fieldsobject(p->ranges);
+
+    assert(p->num_fields > 0 && p->num_fields <= OBJECT_MAX_FIELDS);
+
+    p->genes = calloc((size_t) pop_size * indiv_size * p->num_fields, sizeof(uint32_t));
+
+    if (p->genes == NULL) {
+        printf("error: failed to alloc memory for population genes [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    return p;
+
+}
+
+/*
+ * NAME
+ *
+ *   population_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a population and its gene matrix
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_free(pop);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void population_free(population_str* p) {
+
+    if (p == NULL) {
+        return;
+    }
+
+    free(p->genes);
+    free(p);
+
+}
+
+/*
+ * NAME
+ *
+ *   population_randomize
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes every gene of every individual, drawing each field
+ *  uniformly from its range. Works column by column with a caller owned
+ *  generator, so it is a flat loop over the whole matrix
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_randomize(pop, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes
+ *
+ */
+
+void population_randomize(population_str* p, uint64_t* state) {
+
+    for (uint32_t f = 0; f < p->num_fields; f++) {
+
+        uint32_t range = p->ranges[f];
+
+        for (uint32_t pos = 0; pos < p->indiv_size; pos++) {
+
+            uint32_t* column = POPULATION_COLUMN(p, pos, f);
+
+            for (uint32_t ind = 0; ind < p->pop_size; ind++) {
+                column[ind] = bounded_rand(state, range);
+            }
+
+        }
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   population_copy
+ *
+ * DESCRIPTION
+ *
+ *  Copies all genes of one population into another of the same type and
+ *  dimensions
+ *
+ * PARAMETERS
+ *
+ *  population_str* dst -- population copied into
+ *  population_str* src -- population copied from
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_copy(next_gen, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes of dst
+ *
+ */
+
+void population_copy(population_str* dst, population_str* src) {
+
+    assert(dst->objtype == src->objtype);
+    assert(dst->pop_size == src->pop_size && dst->indiv_size == src->indiv_size);
+
+    memcpy(dst->genes, src->genes, sizeof(uint32_t) * (size_t) src->pop_size * src->indiv_size * src->num_fields);
+
+}
+
+/*
+ * NAME
+ *
+ *   population_copyindividual
+ *
+ * DESCRIPTION
+ *
+ *  Copies the genes of one individual over those of another, possibly in
+ *  a different population of the same type and individual size
+ *
+ * PARAMETERS
+ *
+ *  population_str* dst -- population copied into
+ *  uint32_t dst_ind -- individual overwritten
+ *  population_str* src -- population copied from
+ *  uint32_t src_ind -- individual copied
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_copyindividual(next_gen, i, curr_gen, winner);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites the genes of dst_ind
+ *
+ */
+
+void population_copyindividual(population_str* dst, uint32_t dst_ind, population_str* src, uint32_t src_ind) {
+
+    assert(dst->objtype == src->objtype && dst->indiv_size == src->indiv_size);
+    assert(dst_ind < dst->pop_size && src_ind < src->pop_size);
+
+    for (uint32_t f = 0; f < src->num_fields; f++) {
+        for (uint32_t pos = 0; pos < src->indiv_size; pos++) {
+            POPULATION_GENE(dst, dst_ind, pos, f) = POPULATION_GENE(src, src_ind, pos, f);
+        }
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   population_mutationmask
+ *
+ * DESCRIPTION
+ *
+ *  Fills a mask with one entry per (position, individual), laid out as
+ *  the columns are, marking each gene for mutation with a probability of
+ *  mut_perc percent
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population the mask is for
+ *  uint8_t* mask -- pop_size * indiv_size entries
+ *  uint32_t mut_perc -- percentage chance of each gene being marked
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of genes marked
+ *
+ * EXAMPLE
+ *
+ *  marked = population_mutationmask(pop, mask, 5, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites mask
+ *
+ */
+
+uint32_t population_mutationmask(population_str* p, uint8_t* mask, uint32_t mut_perc, uint64_t* state) {
+
+    uint32_t marked = 0;
+    size_t sites = (size_t) p->pop_size * p->indiv_size;
+
+    for (size_t i = 0; i < sites; i++) {
+        mask[i] = bounded_rand(state, 100) < mut_perc;
+        marked += mask[i];
+    }
+
+    return marked;
+
+}
+
+/*
+ * NAME
+ *
+ *   population_mutate
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes all fields of every gene marked in the mask, leaving the
+ *  others untouched. The selection is done with masks instead of branches
+ *  so that the inner loop over a column has no data dependent branch
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population to mutate
+ *  uint8_t* mask -- mask, see population_mutationmask
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_mutate(pop, mask, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the marked genes
+ *
+ */
+
+void population_mutate(population_str* p, uint8_t* mask, uint64_t* state) {
+
+    for (uint32_t f = 0; f < p->num_fields; f++) {
+
+        uint32_t range = p->ranges[f];
+
+        for (uint32_t pos = 0; pos < p->indiv_size; pos++) {
+
+            uint32_t* column = POPULATION_COLUMN(p, pos, f);
+            uint8_t* column_mask = mask + (size_t) pos * p->pop_size;
+
+            for (uint32_t ind = 0; ind < p->pop_size; ind++) {
+                uint32_t keep = (uint32_t) column_mask[ind] - 1;   // all ones when not marked
+                uint32_t r = bounded_rand(state, range);
+                column[ind] = (column[ind] & keep) | (r & ~keep);
+            }
+
+        }
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   population_diversity
+ *
+ * DESCRIPTION
+ *
+ *  Computes the Gini-Simpson diversity of every (position, field) column,
+ *  i.e. the chance that two individuals drawn at random hold different
+ *  values there. 0 means every individual agrees, values close to 1 mean
+ *  the column is spread over many values
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population
+ *  double* diversity -- indiv_size * num_fields entries, laid out as the columns, may be NULL
+ *
+ * RETURN
+ *
+ *  double -- mean diversity over all columns
+ *
+ * EXAMPLE
+ *
+ *  mean = population_diversity(pop, per_column);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills diversity
+ *
+ */
+
+double population_diversity(population_str* p, double* diversity) {
+
+    uint32_t histogram_size = 0;
+    double total = 0.0;
+    double pairs = (double) p->pop_size * p->pop_size;
+
+    for (uint32_t f = 0; f < p->num_fields; f++) {
+        if (p->ranges[f] != 0 && p->ranges[f] <= POPULATION_HISTOGRAM_MAX && p->ranges[f] > histogram_size) {
+            histogram_size = p->ranges[f];
+        }
+    }
+
+    uint32_t* histogram = malloc(sizeof(uint32_t) * (histogram_size > 0 ? histogram_size : 1));
+    uint32_t* sorted = malloc(sizeof(uint32_t) * (p->pop_size > 0 ? p->pop_size : 1));
+    assert(histogram != NULL && sorted != NULL);
+
+    for (uint32_t f = 0; f < p->num_fields; f++) {
+
+        uint32_t range = p->ranges[f];
+        bool use_histogram = range != 0 && range <= POPULATION_HISTOGRAM_MAX;
+
+        for (uint32_t pos = 0; pos < p->indiv_size; pos++) {
+
+            uint32_t* column = POPULATION_COLUMN(p, pos, f);
+            double same = 0.0;
+
+            if (use_histogram) {
+
+                memset(histogram, 0, sizeof(uint32_t) * range);
+                for (uint32_t ind = 0; ind < p->pop_size; ind++) {
+                    histogram[column[ind]]++;
+                }
+                for (uint32_t v = 0; v < range; v++) {
+                    same += (double) histogram[v] * histogram[v];
+                }
+
+            }
+            else {
+
+                // full range fields are counted as runs of a sorted copy
+                memcpy(sorted, column, sizeof(uint32_t) * p->pop_size);
+                qsort(sorted, p->pop_size, sizeof(uint32_t), __population_compare_fields);
+                for (uint32_t ind = 0, run = 1; ind < p->pop_size; ind++, run++) {
+                    if (ind + 1 == p->pop_size || sorted[ind + 1] != sorted[ind]) {
+                        same += (double) run * run;
+                        run = 0;
+                    }
+                }
+
+            }
+
+            double column_diversity = pairs > 0.0 ? 1.0 - same / pairs : 0.0;
+
+            if (diversity != NULL) {
+                diversity[(size_t) f * p->indiv_size + pos] = column_diversity;
+            }
+            total += column_diversity;
+
+        }
+
+    }
+
+    free(histogram);
+    free(sorted);
+
+    return p->indiv_size * p->num_fields > 0 ? total / (p->indiv_size * p->num_fields) : 0.0;
+
+}
+
+/*
+ * NAME
+ *
+ *   population_fromlists
+ *
+ * DESCRIPTION
+ *
+ *  Encodes a generation of osaka lists into a population with the
+ *  osaka_encodeobject hook of their type. Every individual must hold
+ *  indiv_size genes
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population written to
+ *  node_str** gen -- pop_size individuals
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_fromlists(pop, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes of p
+ *
+ */
+
+void population_fromlists(population_str* p, node_str** gen) {
+
+    uint32_t fields[OBJECT_MAX_FIELDS];
+
+    for (uint32_t ind = 0; ind < p->pop_size; ind++) {
+
+        node_str* n = gen[ind];
+
+        for (uint32_t pos = 0; pos < p->indiv_size; pos++) {
+
+            assert(n != NULL && OBJECT_TYPE(n) == p->objtype);
+
+            object_table_function[p->objtype].osaka_encodeobject(fields, OBJECT(n));
+            for (uint32_t f = 0; f < p->num_fields; f++) {
+                POPULATION_GENE(p, ind, pos, f) = fields[f];
+            }
+
+            n = NEXT(n);
+
+        }
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   population_tolists
+ *
+ * DESCRIPTION
+ *
+ *  Decodes a population into a generation of new osaka lists with the
+ *  osaka_decodeobject hook of its type, so that the rest of the framework
+ *  can work on it
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population read from
+ *  node_str** gen -- receives pop_size new individuals
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_tolists(pop, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the individuals, to be freed with generate_free_generation
+ *
+ */
+
+void population_tolists(population_str* p, node_str** gen) {
+
+    uint32_t fields[OBJECT_MAX_FIELDS];
+    osaka_list_str individual;
+
+    for (uint32_t ind = 0; ind < p->pop_size; ind++) {
+
+        osaka_list_init(&individual, NULL);
+
+        for (uint32_t pos = 0; pos < p->indiv_size; pos++) {
+
+            for (uint32_t f = 0; f < p->num_fields; f++) {
+                fields[f] = POPULATION_GENE(p, ind, pos, f);
+            }
+
+            // the node is created untyped so that no throwaway object is built
+            node_str* n = osaka_createnode(NULL, TAIL, NOTSET);
+            OBJECT_TYPE(n) = p->objtype;
+            OBJECT(n) = object_table_function[p->objtype].osaka_decodeobject(fields);
+            osaka_list_addnodetotail(&individual, n);
+
+        }
+
+        gen[ind] = osaka_list_attach(&individual);
+
+    }
+
+}
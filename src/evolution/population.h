@@ -0,0 +1,400 @@
+/*
+ ============================================================================
+ Name        : population.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Population container that stores the genes of every
+               individual of a generation as one structure-of-arrays matrix.
+               Each gene is encoded into a few uint32_t fields by its module,
+               and every (position, field) column holds that field for all
+               individuals contiguously, so population wide randomization,
+               copying, mutation and diversity statistics are flat loops
+               instead of per node pointer walks
+ ============================================================================
+ */
+
+#ifndef EVOLUTION_POPULATION_H_
+#define EVOLUTION_POPULATION_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef struct population_str {
+    osaka_object_typ objtype;
+    uint32_t pop_size;
+    uint32_t indiv_size;
+    uint32_t num_fields;
+    uint32_t ranges[OBJECT_MAX_FIELDS];
+    uint32_t *genes;
+} population_str;
+
+/*
+ * MACROS
+ */
+
+// columns are laid out field major, then position, with the individuals
+// of a column next to each other. positions and individuals count from 0
+#define POPULATION_COLUMN(p, pos, f) (p->genes + ((size_t) (f) * p->indiv_size + (pos)) * p->pop_size)
+#define POPULATION_GENE(p, ind, pos, f) POPULATION_COLUMN(p, pos, f)[ind]
+
+// fields with at most this many values get a histogram in
+// population_diversity, larger ones are sorted instead
+#define POPULATION_HISTOGRAM_MAX 65536
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   population_create
+ *
+ * DESCRIPTION
+ *
+ *  Allocates a population of pop_size individuals of indiv_size genes of
+ *  the given type. The number of fields per gene and their ranges come
+ *  from the osaka_fieldsobject hook of the type. The genes are zeroed,
+ *  see population_randomize and population_fromlists
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *
+ * RETURN
+ *
+ *  population_str* -- the new population
+ *
+ * EXAMPLE
+ *
+ *  population_str* pop = population_create(10000, 100, LLVM_PASS);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with population_free
+ *
+ */
+
+population_str* population_create(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot);
+
+/*
+ * NAME
+ *
+ *   population_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a population and its gene matrix
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_free(pop);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void population_free(population_str* p);
+
+/*
+ * NAME
+ *
+ *   population_randomize
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes every gene of every individual, drawing each field
+ *  uniformly from its range. Works column by column with a caller owned
+ *  generator, so it is a flat loop over the whole matrix
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_randomize(pop, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes
+ *
+ */
+
+void population_randomize(population_str* p, uint64_t* state);
+
+/*
+ * NAME
+ *
+ *   population_copy
+ *
+ * DESCRIPTION
+ *
+ *  Copies all genes of one population into another of the same type and
+ *  dimensions
+ *
+ * PARAMETERS
+ *
+ *  population_str* dst -- population copied into
+ *  population_str* src -- population copied from
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_copy(next_gen, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes of dst
+ *
+ */
+
+void population_copy(population_str* dst, population_str* src);
+
+/*
+ * NAME
+ *
+ *   population_copyindividual
+ *
+ * DESCRIPTION
+ *
+ *  Copies the genes of one individual over those of another, possibly in
+ *  a different population of the same type and individual size
+ *
+ * PARAMETERS
+ *
+ *  population_str* dst -- population copied into
+ *  uint32_t dst_ind -- individual overwritten
+ *  population_str* src -- population copied from
+ *  uint32_t src_ind -- individual copied
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_copyindividual(next_gen, i, curr_gen, winner);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites the genes of dst_ind
+ *
+ */
+
+void population_copyindividual(population_str* dst, uint32_t dst_ind, population_str* src, uint32_t src_ind);
+
+/*
+ * NAME
+ *
+ *   population_mutationmask
+ *
+ * DESCRIPTION
+ *
+ *  Fills a mask with one entry per (position, individual), laid out as
+ *  the columns are, marking each gene for mutation with a probability of
+ *  mut_perc percent
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population the mask is for
+ *  uint8_t* mask -- pop_size * indiv_size entries
+ *  uint32_t mut_perc -- percentage chance of each gene being marked
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of genes marked
+ *
+ * EXAMPLE
+ *
+ *  marked = population_mutationmask(pop, mask, 5, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites mask
+ *
+ */
+
+uint32_t population_mutationmask(population_str* p, uint8_t* mask, uint32_t mut_perc, uint64_t* state);
+
+/*
+ * NAME
+ *
+ *   population_mutate
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes all fields of every gene marked in the mask, leaving the
+ *  others untouched. The selection is done with masks instead of branches
+ *  so that the inner loop over a column has no data dependent branch
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population to mutate
+ *  uint8_t* mask -- mask, see population_mutationmask
+ *  uint64_t* state -- random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_mutate(pop, mask, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the marked genes
+ *
+ */
+
+void population_mutate(population_str* p, uint8_t* mask, uint64_t* state);
+
+/*
+ * NAME
+ *
+ *   population_diversity
+ *
+ * DESCRIPTION
+ *
+ *  Computes the Gini-Simpson diversity of every (position, field) column,
+ *  i.e. the chance that two individuals drawn at random hold different
+ *  values there. 0 means every individual agrees, values close to 1 mean
+ *  the column is spread over many values
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population
+ *  double* diversity -- indiv_size * num_fields entries, laid out as the columns, may be NULL
+ *
+ * RETURN
+ *
+ *  double -- mean diversity over all columns
+ *
+ * EXAMPLE
+ *
+ *  mean = population_diversity(pop, per_column);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills diversity
+ *
+ */
+
+double population_diversity(population_str* p, double* diversity);
+
+/*
+ * NAME
+ *
+ *   population_fromlists
+ *
+ * DESCRIPTION
+ *
+ *  Encodes a generation of osaka lists into a population with the
+ *  osaka_encodeobject hook of their type. Every individual must hold
+ *  indiv_size genes
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population written to
+ *  node_str** gen -- pop_size individuals
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_fromlists(pop, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites all genes of p
+ *
+ */
+
+void population_fromlists(population_str* p, node_str** gen);
+
+/*
+ * NAME
+ *
+ *   population_tolists
+ *
+ * DESCRIPTION
+ *
+ *  Decodes a population into a generation of new osaka lists with the
+ *  osaka_decodeobject hook of its type, so that the rest of the framework
+ *  can work on it
+ *
+ * PARAMETERS
+ *
+ *  population_str* p -- population read from
+ *  node_str** gen -- receives pop_size new individuals
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  population_tolists(pop, curr_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the individuals, to be freed with generate_free_generation
+ *
+ */
+
+void population_tolists(population_str* p, node_str** gen);
+
+#endif /* EVOLUTION_POPULATION_H_ */
@@ -47,7 +47,8 @@
  *
  *  Returns true or false depending on if a fitness metric has the quality of
  *  larger is better, or smaller is better. True means that smaller is better (cost),
- *  false means that larger is better (benefit)
+ *  false means that larger is better (benefit). The direction is that of the
+ *  fitness registry entry of the object type, see fitness_lookup
  *
  * PARAMETERS
  *
@@ -74,17 +75,9 @@
 
 bool selection_get_min_max(osaka_object_typ object_type) {
 
-    // determines if the fitness value is preferred to be
-    // higher or lower.
-    bool fitness_max_or_min[5] = {
-        false,       // a larger fitness value for SIMPLE is better
-        false,       // a larger fitness value for ASSEMBLER is better
-        false,       // a larger fitness value for OSAKA_STRING is better
-        true,        // a smaller fitness value for LLVM_PASS is better
-        false        // a larger fitness value for BINARY_UP_TO_512 is better
-    };
-
-    return fitness_max_or_min[object_type];
+    // the registry entry of the type knows if its fitness is a cost or a benefit,
+    // types without an entry get the default entry, which minimizes
+    return fitness_lookup(object_type)->direction == FITNESS_MINIMIZE;
 
 }
 
@@ -123,11 +116,11 @@ bool selection_get_min_max(osaka_object_typ object_type) {
 
 bool selection_compare_fitness(double fitness1, double fitness2, osaka_object_typ object_type) {
     
-    // if true, means that a larger value is better
+    // if true, means that a smaller value is better
     if (selection_get_min_max(object_type)) {
         return fitness2 > fitness1;
     }
-    // if false, means that a smaller value is better
+    // if false, means that a larger value is better
     else {
         return fitness2 < fitness1;
     }
@@ -175,11 +168,11 @@ uint32_t selection_tournament(node_str** population, double* fitness_values_all,
 
     if (vis) {
 
-        printf("Choosing using the basic tournament selection method ---------------------------------\n\n");
+        output_printf(stdout, "Choosing using the basic tournament selection method ---------------------------------\n\n");
 
     }
 
-    uint32_t fitness_values[tournament_size];
+    double fitness_values[tournament_size];
     uint32_t fitness_indices[tournament_size];
     double max_fitness = 0;
     uint32_t max_fitness_ind = -1;
@@ -187,10 +180,6 @@ uint32_t selection_tournament(node_str** population, double* fitness_values_all,
     uint32_t num_chosen = 0;
     osaka_object_typ type = OBJECT_TYPE(population[0]);
 
-    if (selection_get_min_max(type)) {
-        max_fitness = UINT32_MAX;
-    }
-
     // choose indexes of contestants in the tournament first
     while (num_chosen < tournament_size) {
         uint32_t index = (uint32_t) (pop_size * (rand() / (RAND_MAX + 1.0))); 
@@ -211,6 +200,11 @@ uint32_t selection_tournament(node_str** population, double* fitness_values_all,
         repeat_index = false;
     }
 
+    // the first contestant wins unless another one is better, so ties
+    // with the starting value can never leave the winner unset
+    max_fitness = fitness_values_all[fitness_indices[0]];
+    max_fitness_ind = fitness_indices[0];
+
     for (uint32_t c = 0; c < tournament_size; c++) {
 
         fitness_values[c] = fitness_values_all[fitness_indices[c]];
@@ -225,7 +219,7 @@ uint32_t selection_tournament(node_str** population, double* fitness_values_all,
 
     if (vis) {
 
-        printf("Individual chosen was number %d in the population -------------------------------------\n\n", max_fitness_ind);   
+        output_printf(stdout, "Individual chosen was number %d in the population -------------------------------------\n\n", max_fitness_ind);   
 
     }
 
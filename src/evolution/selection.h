@@ -56,7 +56,8 @@
  *
  *  Returns true or false depending on if a fitness metric has the quality of
  *  larger is better, or smaller is better. True means that smaller is better (cost),
- *  false means that larger is better (benefit)
+ *  false means that larger is better (benefit). The direction is that of the
+ *  fitness registry entry of the object type, see fitness_lookup
  *
  * PARAMETERS
  *
@@ -0,0 +1,721 @@
+/*
+ ============================================================================
+ Name        : store.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Concurrent population store. A fixed number of slots
+               are claimed with an atomic counter and filled by any number
+               of threads without locks, which lets the offspring of a
+               generation be created, crossed over and mutated in parallel
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "store.h"
+#include <string.h>
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __store_run_workers
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that runs a worker routine on num_threads threads,
+ *  each with its own copy of the worker arguments and its own random
+ *  state, and waits for all of them to finish
+ *
+ * PARAMETERS
+ *
+ *  store_worker_str* args -- arguments shared by every worker
+ *  uint32_t num_threads -- number of threads, 1 runs on the caller
+ *  void* (*worker)(void*) -- routine run by each thread
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __store_run_workers(&args, 8, __store_breed_worker);
+ *
+ * SIDE-EFFECT
+ *
+ *  spawns and joins threads
+ *
+ */
+
+void __store_run_workers(store_worker_str* args, uint32_t num_threads, void* (*worker)(void*)) {
+
+    pthread_t threads[STORE_MAX_THREADS];
+    store_worker_str worker_args[STORE_MAX_THREADS];
+
+    assert(num_threads > 0 && num_threads <= STORE_MAX_THREADS);
+
+    for (uint32_t t = 0; t < num_threads; t++) {
+
+        worker_args[t] = *args;
+        // every thread gets its own generator so no random state is shared
+        worker_args[t].state = hash_mix64(args->state + t) | 1;
+
+    }
+
+    if (num_threads == 1) {
+        worker(&worker_args[0]);
+        return;
+    }
+
+    for (uint32_t t = 0; t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, worker, &worker_args[t]) != 0) {
+            printf("error: failed to create worker thread [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+            exit(0);
+        }
+    }
+
+    for (uint32_t t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   __store_fill_worker
+ *
+ * DESCRIPTION
+ *
+ *  Internal worker of store_fill, claims slots and publishes new random
+ *  individuals into them until the store is full
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- store_worker_str* of the thread
+ *
+ * RETURN
+ *
+ *  void* -- NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&t, NULL, __store_fill_worker, &args);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills slots of the store
+ *
+ */
+
+void* __store_fill_worker(void* arg) {
+
+    store_worker_str* args = arg;
+    uint32_t slot;
+
+    while ((slot = store_claim(args->store)) != STORE_FULL) {
+        store_publish(args->store, slot, generate_new_individual(args->indiv_size, args->ot));
+    }
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   __store_tournament
+ *
+ * DESCRIPTION
+ *
+ *  Internal tournament selection on a read only set of fitness values,
+ *  driven by the random state of the calling thread rather than rand()
+ *
+ * PARAMETERS
+ *
+ *  store_worker_str* args -- worker arguments
+ *
+ * RETURN
+ *
+ *  uint32_t -- index of the winner in the parents
+ *
+ * EXAMPLE
+ *
+ *  winner = __store_tournament(args);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the random state of the worker
+ *
+ */
+
+uint32_t __store_tournament(store_worker_str* args) {
+
+    uint32_t best = bounded_rand(&args->state, args->pop_size);
+
+    for (uint32_t c = 1; c < args->tourn_size; c++) {
+
+        uint32_t contestant = bounded_rand(&args->state, args->pop_size);
+
+        if (selection_compare_fitness(args->fitness_values[contestant], args->fitness_values[best], args->ot)) {
+            best = contestant;
+        }
+
+    }
+
+    return best;
+
+}
+
+/*
+ * NAME
+ *
+ *   __store_mutate
+ *
+ * DESCRIPTION
+ *
+ *  Internal counterpart of mutation_single_unit, driven by the random
+ *  state of the calling thread rather than rand(). For all params, types
+ *  with a randomize kernel redraw the unit through it, the mutate kernels
+ *  of the other types already redraw the whole object
+ *
+ * PARAMETERS
+ *
+ *  node_str* child -- individual to mutate
+ *  store_worker_str* args -- worker arguments
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __store_mutate(child1, args);
+ *
+ * SIDE-EFFECT
+ *
+ *  edits child, advances the random state of the worker
+ *
+ */
+
+void __store_mutate(node_str* child, store_worker_str* args) {
+
+    uint32_t ind = bounded_rand(&args->state, osaka_listlength(child)) + 1;
+
+    if (mutation_get_operator() == MUTATION_SINGLE_PARAM) {
+        mutation_single_unit_single_param_state(child, ind, &args->state);
+        return;
+    }
+
+    node_str* node = osaka_nthnode(child, ind);
+
+    if (object_table_function[OBJECT_TYPE(node)].osaka_randomizebatch != NULL) {
+        osaka_randomizenodes(&node, 1, &args->state);
+    }
+    else {
+        osaka_mutatenode(node, &args->state);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   __store_breed_worker
+ *
+ * DESCRIPTION
+ *
+ *  Internal worker of store_breed. Claims a slot, picks two parents by
+ *  tournament, copies them and applies crossover and mutation to the
+ *  copies, then publishes the children into the claimed slot and the next
+ *  one. The parents are only read, so any number of workers can share
+ *  them
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- store_worker_str* of the thread
+ *
+ * RETURN
+ *
+ *  void* -- NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&t, NULL, __store_breed_worker, &args);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills slots of the store
+ *
+ */
+
+void* __store_breed_worker(void* arg) {
+
+    store_worker_str* args = arg;
+    uint32_t slot;
+
+    while ((slot = store_claim(args->store)) != STORE_FULL) {
+
+        TRACE_START(breed);
+        uint32_t parent1 = __store_tournament(args);
+        uint32_t parent2 = __store_tournament(args);
+
+        // parents cannot be the same individual
+        while (parent1 == parent2 && args->pop_size > 1) {
+            parent2 = __store_tournament(args);
+        }
+
+        node_str* child1 = osaka_copylist(args->parents[parent1]);
+        node_str* child2 = osaka_copylist(args->parents[parent2]);
+
+        if (bounded_rand(&args->state, 100) <= args->cross_perc) {
+            crossover_onepoint_state(child1, child2, &args->state);
+        }
+        if (bounded_rand(&args->state, 100) <= args->mut_perc) {
+            __store_mutate(child1, args);
+        }
+        if (bounded_rand(&args->state, 100) <= args->mut_perc) {
+            __store_mutate(child2, args);
+        }
+
+        store_publish(args->store, slot, child1);
+
+        // the second child only survives if there is still room for it
+        if ((slot = store_claim(args->store)) != STORE_FULL) {
+            store_publish(args->store, slot, child2);
+        }
+        else {
+            generate_free_individual(child2);
+        }
+
+        TRACE_STOP(breed, "breed", "breeding");
+
+    }
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   store_create
+ *
+ * DESCRIPTION
+ *
+ *  Allocates a concurrent store with room for capacity individuals, all
+ *  slots empty
+ *
+ * PARAMETERS
+ *
+ *  uint32_t capacity -- number of slots
+ *
+ * RETURN
+ *
+ *  store_str* -- the new store
+ *
+ * EXAMPLE
+ *
+ *  store_str* next_gen = store_create(pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with store_free
+ *
+ */
+
+store_str* store_create(uint32_t capacity) {
+
+    store_str* s = malloc(sizeof(store_str));
+
+    if (s == NULL) {
+        printf("error: failed to alloc memory for store_str [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    s->capacity = capacity;
+    s->slots = malloc(sizeof(*s->slots) * (capacity > 0 ? capacity : 1));
+
+    if (s->slots == NULL) {
+        printf("error: failed to alloc memory for store slots [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(&s->slots[i], NULL);
+    }
+    atomic_init(&s->next_slot, 0);
+    atomic_init(&s->num_published, 0);
+
+    return s;
+
+}
+
+/*
+ * NAME
+ *
+ *   store_reset
+ *
+ * DESCRIPTION
+ *
+ *  Empties every slot of a store so it can be filled again. Must not be
+ *  called while other threads are using the store
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  bool free_individuals -- whether the published individuals are freed or handed to the caller
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_reset(next_gen, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  may free individuals
+ *
+ */
+
+void store_reset(store_str* s, bool free_individuals) {
+
+    for (uint32_t i = 0; i < s->capacity; i++) {
+
+        node_str* indiv = atomic_exchange(&s->slots[i], NULL);
+
+        if (free_individuals && indiv != NULL) {
+            generate_free_individual(indiv);
+        }
+
+    }
+
+    atomic_store(&s->next_slot, 0);
+    atomic_store(&s->num_published, 0);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a store, and optionally the individuals it holds
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store, may be NULL
+ *  bool free_individuals -- whether the published individuals are freed as well
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_free(next_gen, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void store_free(store_str* s, bool free_individuals) {
+
+    if (s == NULL) {
+        return;
+    }
+
+    store_reset(s, free_individuals);
+    free(s->slots);
+    free(s);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_claim
+ *
+ * DESCRIPTION
+ *
+ *  Claims the next free slot of the store. Safe to call from any number
+ *  of threads at once, every slot is handed out exactly once
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *
+ * RETURN
+ *
+ *  uint32_t -- the claimed slot, STORE_FULL once the store is full
+ *
+ * EXAMPLE
+ *
+ *  uint32_t slot = store_claim(next_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the slot counter
+ *
+ */
+
+uint32_t store_claim(store_str* s) {
+
+    // a relaxed load first keeps full stores from pushing the counter up forever
+    if (atomic_load_explicit(&s->next_slot, memory_order_relaxed) >= s->capacity) {
+        return STORE_FULL;
+    }
+
+    uint32_t slot = atomic_fetch_add_explicit(&s->next_slot, 1, memory_order_relaxed);
+
+    return slot < s->capacity ? slot : STORE_FULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   store_publish
+ *
+ * DESCRIPTION
+ *
+ *  Publishes an individual into a slot claimed with store_claim. The
+ *  individual must be complete, once published it is visible to every
+ *  thread that reads the slot with store_get
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t slot -- claimed slot
+ *  node_str* indiv -- individual, owned by the store from now on
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_publish(next_gen, slot, child);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the slot was already published
+ *
+ */
+
+void store_publish(store_str* s, uint32_t slot, node_str* indiv) {
+
+    assert(slot < s->capacity);
+    assert(indiv != NULL);
+
+    node_str* previous = atomic_exchange_explicit(&s->slots[slot], indiv, memory_order_release);
+    assert(previous == NULL);
+    (void) previous;
+
+    atomic_fetch_add_explicit(&s->num_published, 1, memory_order_relaxed);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_get
+ *
+ * DESCRIPTION
+ *
+ *  Reads the individual published into a slot
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t slot -- slot to read
+ *
+ * RETURN
+ *
+ *  node_str* -- the individual, NULL if nothing was published yet
+ *
+ * EXAMPLE
+ *
+ *  node_str* indiv = store_get(next_gen, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+node_str* store_get(store_str* s, uint32_t slot) {
+
+    assert(slot < s->capacity);
+
+    return atomic_load_explicit(&s->slots[slot], memory_order_acquire);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_count
+ *
+ * DESCRIPTION
+ *
+ *  Number of individuals published into the store so far
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *
+ * RETURN
+ *
+ *  uint32_t -- published individuals
+ *
+ * EXAMPLE
+ *
+ *  while (store_count(next_gen) < pop_size) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t store_count(store_str* s) {
+
+    return atomic_load_explicit(&s->num_published, memory_order_relaxed);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_fill
+ *
+ * DESCRIPTION
+ *
+ *  Fills every free slot of the store with a new random individual, using
+ *  num_threads threads
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t num_threads -- number of threads, at most STORE_MAX_THREADS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_fill(first_gen, 100, LLVM_PASS, 8);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the individuals
+ *
+ */
+
+void store_fill(store_str* s, uint32_t indiv_size, osaka_object_typ ot, uint32_t num_threads) {
+
+    store_worker_str args;
+
+    memset(&args, 0, sizeof(store_worker_str));
+    args.store = s;
+    args.indiv_size = indiv_size;
+    args.ot = ot;
+
+    __store_run_workers(&args, num_threads, __store_fill_worker);
+
+}
+
+/*
+ * NAME
+ *
+ *   store_breed
+ *
+ * DESCRIPTION
+ *
+ *  Breeds the next generation into the free slots of the store using
+ *  num_threads threads. Each pair of children comes from two tournament
+ *  winners of the parents, copied and then crossed over and mutated with
+ *  the given percentages, as in the evolution loop. The parents and their
+ *  fitness values are only read
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store the children are published into
+ *  node_str** parents -- current generation
+ *  double* fitness_values -- fitness of every parent
+ *  uint32_t pop_size -- number of parents
+ *  uint32_t tourn_size -- tournament size
+ *  uint32_t mut_perc -- percentage chance of mutating each child
+ *  uint32_t cross_perc -- percentage chance of crossing over a pair
+ *  uint32_t num_threads -- number of threads, at most STORE_MAX_THREADS
+ *  uint64_t seed -- seed the per thread random states are derived from
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_breed(next_gen, curr_gen, fitness, 50, 5, 10, 75, 8, seed);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the children
+ *
+ */
+
+void store_breed(store_str* s, node_str** parents, double* fitness_values, uint32_t pop_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, uint32_t num_threads, uint64_t seed) {
+
+    store_worker_str args;
+
+    assert(pop_size > 0 && tourn_size > 0);
+
+    memset(&args, 0, sizeof(store_worker_str));
+    args.store = s;
+    args.parents = parents;
+    args.fitness_values = fitness_values;
+    args.pop_size = pop_size;
+    args.tourn_size = tourn_size;
+    args.mut_perc = mut_perc;
+    args.cross_perc = cross_perc;
+    args.ot = OBJECT_TYPE(parents[0]);
+    args.state = seed;
+
+    __store_run_workers(&args, num_threads, __store_breed_worker);
+
+}
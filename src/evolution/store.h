@@ -0,0 +1,372 @@
+/*
+ ============================================================================
+ Name        : store.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Concurrent population store. A fixed number of slots
+               are claimed with an atomic counter and filled by any number
+               of threads without locks, which lets the offspring of a
+               generation be created, crossed over and mutated in parallel
+ ============================================================================
+ */
+
+#ifndef EVOLUTION_STORE_H_
+#define EVOLUTION_STORE_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "crossover.h"
+#include "generation.h"
+#include "mutation.h"
+#include "selection.h"
+#include "../support/trace.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef struct store_str {
+    uint32_t capacity;
+    _Atomic uint32_t next_slot;
+    _Atomic uint32_t num_published;
+    _Atomic(node_str*) *slots;
+} store_str;
+
+typedef struct store_worker_str {
+    store_str* store;
+    node_str** parents;
+    double* fitness_values;
+    uint32_t pop_size;
+    uint32_t indiv_size;
+    uint32_t tourn_size;
+    uint32_t mut_perc;
+    uint32_t cross_perc;
+    osaka_object_typ ot;
+    uint64_t state;
+} store_worker_str;
+
+/*
+ * MACROS
+ */
+
+// returned by store_claim once every slot has been handed out
+#define STORE_FULL UINT32_MAX
+#define STORE_MAX_THREADS 64
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   store_create
+ *
+ * DESCRIPTION
+ *
+ *  Allocates a concurrent store with room for capacity individuals, all
+ *  slots empty
+ *
+ * PARAMETERS
+ *
+ *  uint32_t capacity -- number of slots
+ *
+ * RETURN
+ *
+ *  store_str* -- the new store
+ *
+ * EXAMPLE
+ *
+ *  store_str* next_gen = store_create(pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with store_free
+ *
+ */
+
+store_str* store_create(uint32_t capacity);
+
+/*
+ * NAME
+ *
+ *   store_reset
+ *
+ * DESCRIPTION
+ *
+ *  Empties every slot of a store so it can be filled again. Must not be
+ *  called while other threads are using the store
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  bool free_individuals -- whether the published individuals are freed or handed to the caller
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_reset(next_gen, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  may free individuals
+ *
+ */
+
+void store_reset(store_str* s, bool free_individuals);
+
+/*
+ * NAME
+ *
+ *   store_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a store, and optionally the individuals it holds
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store, may be NULL
+ *  bool free_individuals -- whether the published individuals are freed as well
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_free(next_gen, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void store_free(store_str* s, bool free_individuals);
+
+/*
+ * NAME
+ *
+ *   store_claim
+ *
+ * DESCRIPTION
+ *
+ *  Claims the next free slot of the store. Safe to call from any number
+ *  of threads at once, every slot is handed out exactly once
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *
+ * RETURN
+ *
+ *  uint32_t -- the claimed slot, STORE_FULL once the store is full
+ *
+ * EXAMPLE
+ *
+ *  uint32_t slot = store_claim(next_gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the slot counter
+ *
+ */
+
+uint32_t store_claim(store_str* s);
+
+/*
+ * NAME
+ *
+ *   store_publish
+ *
+ * DESCRIPTION
+ *
+ *  Publishes an individual into a slot claimed with store_claim. The
+ *  individual must be complete, once published it is visible to every
+ *  thread that reads the slot with store_get
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t slot -- claimed slot
+ *  node_str* indiv -- individual, owned by the store from now on
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_publish(next_gen, slot, child);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the slot was already published
+ *
+ */
+
+void store_publish(store_str* s, uint32_t slot, node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   store_get
+ *
+ * DESCRIPTION
+ *
+ *  Reads the individual published into a slot
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t slot -- slot to read
+ *
+ * RETURN
+ *
+ *  node_str* -- the individual, NULL if nothing was published yet
+ *
+ * EXAMPLE
+ *
+ *  node_str* indiv = store_get(next_gen, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+node_str* store_get(store_str* s, uint32_t slot);
+
+/*
+ * NAME
+ *
+ *   store_count
+ *
+ * DESCRIPTION
+ *
+ *  Number of individuals published into the store so far
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *
+ * RETURN
+ *
+ *  uint32_t -- published individuals
+ *
+ * EXAMPLE
+ *
+ *  while (store_count(next_gen) < pop_size) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t store_count(store_str* s);
+
+/*
+ * NAME
+ *
+ *   store_fill
+ *
+ * DESCRIPTION
+ *
+ *  Fills every free slot of the store with a new random individual, using
+ *  num_threads threads
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t num_threads -- number of threads, at most STORE_MAX_THREADS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_fill(first_gen, 100, LLVM_PASS, 8);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the individuals
+ *
+ */
+
+void store_fill(store_str* s, uint32_t indiv_size, osaka_object_typ ot, uint32_t num_threads);
+
+/*
+ * NAME
+ *
+ *   store_breed
+ *
+ * DESCRIPTION
+ *
+ *  Breeds the next generation into the free slots of the store using
+ *  num_threads threads. Each pair of children comes from two tournament
+ *  winners of the parents, copied and then crossed over and mutated with
+ *  the given percentages, as in the evolution loop. The parents and their
+ *  fitness values are only read
+ *
+ * PARAMETERS
+ *
+ *  store_str* s -- store the children are published into
+ *  node_str** parents -- current generation
+ *  double* fitness_values -- fitness of every parent
+ *  uint32_t pop_size -- number of parents
+ *  uint32_t tourn_size -- tournament size
+ *  uint32_t mut_perc -- percentage chance of mutating each child
+ *  uint32_t cross_perc -- percentage chance of crossing over a pair
+ *  uint32_t num_threads -- number of threads, at most STORE_MAX_THREADS
+ *  uint64_t seed -- seed the per thread random states are derived from
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  store_breed(next_gen, curr_gen, fitness, 50, 5, 10, 75, 8, seed);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the children
+ *
+ */
+
+void store_breed(store_str* s, node_str** parents, double* fitness_values, uint32_t pop_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, uint32_t num_threads, uint64_t seed);
+
+#endif /* EVOLUTION_STORE_H_ */
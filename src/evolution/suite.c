@@ -0,0 +1,988 @@
+/*
+ ============================================================================
+ Name        : suite.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Fitness of an LLVM pass sequence over a suite of benchmark
+               programs rather than a single test file. Each benchmark is
+               timed against its own unoptimized baseline and the fitness
+               is the weighted geometric mean of those time ratios, so no
+               single program dominates and lower is still better. The
+               time of every benchmark is cached under the genes of the
+               individual, and once a benchmark regresses past a cutoff
+               the remaining ones are not run at all
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "suite.h"
+
+/*
+ * STATIC
+ */
+
+static suite_str* suite_active = NULL;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __suite_key
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, key of the timings of a benchmark: its linked module
+ *  and args, and the machine it runs on when asked for
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- a built benchmark
+ *  bool host -- whether the machine is part of the key
+ *
+ * RETURN
+ *
+ *  uint64_t -- the key
+ *
+ * EXAMPLE
+ *
+ *  uint64_t key = __suite_key(benchmark, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t __suite_key(suite_benchmark_str* benchmark, bool host) {
+
+    char host_name[100];
+    uint64_t key = hash_combine(benchmark->key, hash_string(benchmark->args));
+
+    if (host) {
+        if (gethostname(host_name, sizeof(host_name)) != 0) {
+            strcpy(host_name, "unknown");
+        }
+        key = hash_combine(key, hash_string(host_name));
+    }
+
+    return key;
+
+}
+
+/*
+ * NAME
+ *
+ *   __suite_result_lookup
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, looks up the time of a benchmark for the given genes
+ *  in its open addressing table
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- the benchmark
+ *  uint64_t genes -- osaka_hash of the individual
+ *  double* seconds -- set to the cached time, if any
+ *
+ * RETURN
+ *
+ *  bool -- true if a time was cached for these genes
+ *
+ * EXAMPLE
+ *
+ *  if (__suite_result_lookup(benchmark, osaka_hash(indiv), &seconds)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool __suite_result_lookup(suite_benchmark_str* benchmark, uint64_t genes, double* seconds) {
+
+    // zero marks an empty slot
+    genes = genes == 0 ? 1 : genes;
+
+    if (benchmark->result_capacity == 0) {
+        return false;
+    }
+
+    uint32_t mask = benchmark->result_capacity - 1;
+
+    for (uint32_t slot = genes & mask; benchmark->result_genes[slot] != 0; slot = (slot + 1) & mask) {
+        if (benchmark->result_genes[slot] == genes) {
+            *seconds = benchmark->result_seconds[slot];
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+/*
+ * NAME
+ *
+ *   __suite_result_store
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, caches the time of a benchmark for the given genes,
+ *  doubling the table when it is half full
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- the benchmark
+ *  uint64_t genes -- osaka_hash of the individual
+ *  double seconds -- time of the benchmark with the passes of the individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __suite_result_store(benchmark, osaka_hash(indiv), seconds);
+ *
+ * SIDE-EFFECT
+ *
+ *  may reallocate the table
+ *
+ */
+
+void __suite_result_store(suite_benchmark_str* benchmark, uint64_t genes, double seconds) {
+
+    genes = genes == 0 ? 1 : genes;
+
+    if (2 * (benchmark->num_results + 1) > benchmark->result_capacity) {
+
+        uint64_t* old_genes = benchmark->result_genes;
+        double* old_seconds = benchmark->result_seconds;
+        uint32_t old_capacity = benchmark->result_capacity;
+
+        benchmark->result_capacity = old_capacity == 0 ? 64 : 2 * old_capacity;
+        benchmark->result_genes = calloc(benchmark->result_capacity, sizeof(uint64_t));
+        benchmark->result_seconds = calloc(benchmark->result_capacity, sizeof(double));
+        benchmark->num_results = 0;
+        assert(benchmark->result_genes != NULL && benchmark->result_seconds != NULL);
+
+        for (uint32_t slot = 0; slot < old_capacity; slot++) {
+            if (old_genes[slot] != 0) {
+                __suite_result_store(benchmark, old_genes[slot], old_seconds[slot]);
+            }
+        }
+
+        free(old_genes);
+        free(old_seconds);
+
+    }
+
+    uint32_t mask = benchmark->result_capacity - 1;
+    uint32_t slot = genes & mask;
+
+    while (benchmark->result_genes[slot] != 0 && benchmark->result_genes[slot] != genes) {
+        slot = (slot + 1) & mask;
+    }
+
+    if (benchmark->result_genes[slot] == 0) {
+        benchmark->num_results++;
+    }
+
+    benchmark->result_genes[slot] = genes;
+    benchmark->result_seconds[slot] = seconds;
+
+}
+
+/*
+ * NAME
+ *
+ *   __suite_time
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, assembles an IR file of a benchmark and times its
+ *  runs from SUITE_RUN_FOLDER with the args of the benchmark. The runs
+ *  stop early once their mean time is past the limit
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- the benchmark
+ *  char* ll_file -- the IR file to run
+ *  uint32_t num_runs -- number of timed runs
+ *  double limit -- time past which the runs stop, 0 for none
+ *  double* seconds -- set to the mean time of the runs made
+ *
+ * RETURN
+ *
+ *  bool -- true if the file was assembled and every run succeeded
+ *
+ * EXAMPLE
+ *
+ *  bool ran = __suite_time(benchmark, benchmark->linked_file, 5, 0.0, &seconds);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs llvm-as and lli through the shell
+ *
+ */
+
+bool __suite_time(suite_benchmark_str* benchmark, char* ll_file, uint32_t num_runs, double limit, double* seconds) {
+
+    char cwd[SUITE_MAX_PATH];
+    char bc_file[SUITE_MAX_PATH];
+    char bc_command[3 * SUITE_MAX_PATH];
+    char run_command[3 * SUITE_MAX_PATH];
+    struct timeval start, end;
+    double total_time = 0.0;
+    uint32_t runs = 0;
+
+    if (getcwd(cwd, sizeof(cwd)) == NULL) {
+        printf("error: could not get the working directory [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    snprintf(bc_file, sizeof(bc_file), "%s", ll_file);
+    if (strrchr(bc_file, '.') != NULL) {
+        *strrchr(bc_file, '.') = '\0';
+    }
+    strcat(bc_file, ".bc");
+
+    snprintf(bc_command, sizeof(bc_command), "llvm-as %s -o %s", ll_file, bc_file);
+
+    // run from the run folder, the output of the benchmark is not part of its fitness
+    snprintf(run_command, sizeof(run_command), "cd %s && lli %s/%s %s > /dev/null", SUITE_RUN_FOLDER, cwd, bc_file, benchmark->args);
+
+    if (llvm_run_command(bc_command) != 0) {
+        return false;
+    }
+
+    while (runs < num_runs) {
+
+        INSTRUMENT_START(exec);
+        TRACE_START(exec);
+        gettimeofday(&start, NULL);
+        uint32_t result = llvm_run_command(run_command);
+        gettimeofday(&end, NULL);
+        TRACE_STOP(exec, benchmark->name, "evaluation");
+        INSTRUMENT_STOP(exec, INSTRUMENT_PHASE_EXEC);
+
+        if (result != 0) {
+            return false;
+        }
+
+        total_time += (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) * 1e-6;
+        runs++;
+
+        if (limit > 0.0 && total_time / runs > limit) {
+            break;
+        }
+
+    }
+
+    *seconds = total_time / runs;
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __suite_results_file
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, path of the file in the build cache that holds the
+ *  times of a benchmark on this machine, one JSON line per individual
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- a built benchmark
+ *  char* path -- set to the path, at least LLVM_MAX_PATH long
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __suite_results_file(benchmark, path);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __suite_results_file(suite_benchmark_str* benchmark, char* path) {
+
+    snprintf(path, LLVM_MAX_PATH, "%s/%016lx_results.jsonl", LLVM_CACHE_FOLDER, (unsigned long) __suite_key(benchmark, true));
+
+}
+
+/*
+ * NAME
+ *
+ *   __suite_benchmark_from_json
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper of suite_load, reads one benchmark of a suite file
+ *
+ * PARAMETERS
+ *
+ *  suite_benchmark_str* benchmark -- the benchmark to fill in
+ *  cJSON* root -- the parsed benchmark
+ *
+ * RETURN
+ *
+ *  bool -- true if the benchmark is valid
+ *
+ * EXAMPLE
+ *
+ *  valid = __suite_benchmark_from_json(&suite->benchmarks[b], item) && valid;
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names
+ *
+ */
+
+bool __suite_benchmark_from_json(suite_benchmark_str* benchmark, cJSON* root) {
+
+    bool valid = cJSON_IsObject(root);
+    cJSON* item = NULL;
+
+    memset(benchmark, 0, sizeof(suite_benchmark_str));
+    benchmark->weight = 1.0;
+
+    cJSON_ArrayForEach(item, root) {
+
+        if (strcmp(item->string, "name") == 0 && cJSON_IsString(item) &&
+            strlen(item->valuestring) > 0 && strlen(item->valuestring) < SUITE_MAX_NAME &&
+            strspn(item->valuestring, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") == strlen(item->valuestring)) {
+            strcpy(benchmark->name, item->valuestring);
+        }
+        else if (strcmp(item->string, "test_file") == 0 && cJSON_IsString(item) &&
+            strlen(item->valuestring) > 0 && strlen(item->valuestring) < LLVM_MAX_PATH - 20) {
+            strcpy(benchmark->test_file, item->valuestring);
+        }
+        else if (strcmp(item->string, "sources") == 0 && cJSON_IsArray(item) &&
+            benchmark->src_files == NULL && cJSON_GetArraySize(item) < LLVM_MAX_JOBS) {
+            cJSON* source = NULL;
+            benchmark->src_files = malloc((cJSON_GetArraySize(item) + 1) * sizeof(char*));
+            assert(benchmark->src_files != NULL);
+            cJSON_ArrayForEach(source, item) {
+                if (!cJSON_IsString(source) || strlen(source->valuestring) == 0 || strlen(source->valuestring) >= LLVM_MAX_PATH - 20) {
+                    printf("error: benchmark %s has an invalid source file [file:\'%s\',line:%d]\n", benchmark->name, __FILE__, __LINE__);
+                    valid = false;
+                    continue;
+                }
+                benchmark->src_files[benchmark->num_src_files++] = strdup(source->valuestring);
+            }
+        }
+        else if (strcmp(item->string, "args") == 0 && cJSON_IsString(item) && strlen(item->valuestring) < LLVM_MAX_PATH) {
+            strcpy(benchmark->args, item->valuestring);
+        }
+        else if (strcmp(item->string, "weight") == 0 && cJSON_IsNumber(item) && item->valuedouble > 0.0) {
+            benchmark->weight = item->valuedouble;
+        }
+        else {
+            printf("error: invalid benchmark key %s [file:\'%s\',line:%d]\n", item->string != NULL ? item->string : "", __FILE__, __LINE__);
+            valid = false;
+        }
+
+    }
+
+    if (strlen(benchmark->name) == 0 || strlen(benchmark->test_file) == 0) {
+        printf("error: every benchmark needs a name and a test_file [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        valid = false;
+    }
+
+    return valid;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_load
+ *
+ * DESCRIPTION
+ *
+ *  Reads a benchmark suite from a JSON file. The file holds a list of
+ *  benchmarks, each with a name, a test_file and its sources in
+ *  src/files/llvm, the command line args it is run with from
+ *  SUITE_RUN_FOLDER and a weight (default 1), along with the cutoff past
+ *  which a regressing individual is short-circuited (default 1.5) and the
+ *  number of timed runs per benchmark (default 5). Unknown keys and invalid
+ *  values are reported and fail the suite
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- the suite to fill in
+ *  const char* path -- path of the suite file
+ *
+ * RETURN
+ *
+ *  bool -- true if the file describes a valid suite
+ *
+ * EXAMPLE
+ *
+ *  bool valid = suite_load(&suite, "src/files/llvm/suites/example.json");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with suite_free
+ *
+ */
+
+bool suite_load(suite_str* suite, const char* path) {
+
+    bool valid = true;
+    cJSON* item = NULL;
+
+    memset(suite, 0, sizeof(suite_str));
+    suite->cutoff = SUITE_DEFAULT_CUTOFF;
+    suite->runs = SUITE_DEFAULT_RUNS;
+
+    FILE* file = fopen(path, "r");
+
+    if (file == NULL) {
+        printf("error: could not open suite file %s [file:\'%s\',line:%d]\n", path, __FILE__, __LINE__);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* text = malloc(length + 1);
+    assert(text != NULL);
+    text[fread(text, 1, length, file)] = '\0';
+    fclose(file);
+
+    cJSON* root = cJSON_Parse(text);
+    free(text);
+
+    if (root == NULL || !cJSON_IsObject(root)) {
+        printf("error: suite %s is not a valid JSON object [file:\'%s\',line:%d]\n", path, __FILE__, __LINE__);
+        cJSON_Delete(root);
+        return false;
+    }
+
+    cJSON_ArrayForEach(item, root) {
+
+        if (strcmp(item->string, "cutoff") == 0 && cJSON_IsNumber(item) && item->valuedouble > 1.0) {
+            suite->cutoff = item->valuedouble;
+        }
+        else if (strcmp(item->string, "runs") == 0 && cJSON_IsNumber(item) && item->valuedouble >= 1.0 && item->valuedouble <= 1000.0) {
+            suite->runs = (uint32_t) item->valuedouble;
+        }
+        else if (strcmp(item->string, "benchmarks") == 0 && cJSON_IsArray(item) && suite->num_benchmarks == 0 &&
+            cJSON_GetArraySize(item) > 0 && cJSON_GetArraySize(item) <= SUITE_MAX_BENCHMARKS) {
+            cJSON* benchmark = NULL;
+            cJSON_ArrayForEach(benchmark, item) {
+                valid = __suite_benchmark_from_json(&suite->benchmarks[suite->num_benchmarks], benchmark) && valid;
+                suite->order[suite->num_benchmarks] = suite->num_benchmarks;
+                suite->num_benchmarks++;
+            }
+        }
+        else {
+            printf("error: invalid suite key %s [file:\'%s\',line:%d]\n", item->string, __FILE__, __LINE__);
+            valid = false;
+        }
+
+    }
+
+    cJSON_Delete(root);
+
+    if (suite->num_benchmarks == 0) {
+        printf("error: suite %s has no benchmarks [file:\'%s\',line:%d]\n", path, __FILE__, __LINE__);
+        valid = false;
+    }
+
+    // names key the baselines in the run log
+    for (uint32_t b = 0; b < suite->num_benchmarks; b++) {
+        for (uint32_t c = 0; c < b; c++) {
+            if (strcmp(suite->benchmarks[b].name, suite->benchmarks[c].name) == 0) {
+                printf("error: suite %s names benchmark %s twice [file:\'%s\',line:%d]\n", path, suite->benchmarks[b].name, __FILE__, __LINE__);
+                valid = false;
+            }
+        }
+    }
+
+    return valid;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees what a suite allocated for its source file names and cached results
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- the suite
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_free(&suite);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void suite_free(suite_str* suite) {
+
+    for (uint32_t b = 0; b < suite->num_benchmarks; b++) {
+
+        suite_benchmark_str* benchmark = &suite->benchmarks[b];
+
+        for (uint32_t s = 0; s < benchmark->num_src_files; s++) {
+            free(benchmark->src_files[s]);
+        }
+
+        free(benchmark->src_files);
+        free(benchmark->result_genes);
+        free(benchmark->result_seconds);
+
+    }
+
+    if (suite_active == suite) {
+        suite_active = NULL;
+    }
+
+    memset(suite, 0, sizeof(suite_str));
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_enable
+ *
+ * DESCRIPTION
+ *
+ *  Makes the suite the fitness of LLVM_PASS individuals. From then on
+ *  fitness_pre_cache prepares it and fitness_top evaluates it in place of
+ *  the test file
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- a valid suite, kept by reference until suite_disable
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_enable(&suite);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the LLVM_PASS fitness function
+ *
+ */
+
+void suite_enable(suite_str* suite) {
+
+    assert(suite != NULL && suite->num_benchmarks > 0);
+
+    suite_active = suite;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_disable
+ *
+ * DESCRIPTION
+ *
+ *  LLVM_PASS individuals are evaluated on the test file again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  restores the LLVM_PASS fitness function
+ *
+ */
+
+void suite_disable(void) {
+
+    suite_active = NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether a benchmark suite is the fitness of LLVM_PASS individuals
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between suite_enable and suite_disable
+ *
+ * EXAMPLE
+ *
+ *  if (suite_enabled()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool suite_enabled(void) {
+
+    return suite_active != NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_prepare
+ *
+ * DESCRIPTION
+ *
+ *  Builds every benchmark of the enabled suite through the build cache,
+ *  looks up or measures its baseline, the time it takes without
+ *  optimization, and loads the times cached for it by earlier runs on
+ *  this machine. The benchmarks are then ordered from the quickest to the
+ *  slowest, so that a regression is found at the lowest cost
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- the run log the baselines are written to, NULL when not caching
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_prepare(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs clang, llvm-link, llvm-as and lli through the shell, writes to the build cache
+ *
+ */
+
+void suite_prepare(runlog_str* log) {
+
+    char path[LLVM_MAX_PATH];
+    char basic_file[SUITE_MAX_PATH];
+    char opt_command[3 * SUITE_MAX_PATH];
+    char baseline_name[SUITE_MAX_NAME + 30];
+    char line[200];
+
+    suite_str* suite = suite_active;
+    assert(suite != NULL);
+
+    for (uint32_t b = 0; b < suite->num_benchmarks; b++) {
+
+        suite_benchmark_str* benchmark = &suite->benchmarks[b];
+        double no_optimization = 0.0;
+        double basic_optimization = 0.0;
+
+        benchmark->key = llvm_build_linked(benchmark->src_files, benchmark->num_src_files, benchmark->test_file);
+        llvm_cache_linked_file(benchmark->key, benchmark->linked_file);
+
+        // timings depend on the args as much as on the module
+        if (llvm_cache_lookup_baselines(__suite_key(benchmark, false), &no_optimization, &basic_optimization)) {
+            printf("Reusing the control timings of benchmark %s from the build cache\n\n", benchmark->name);
+        }
+        else {
+
+            snprintf(basic_file, sizeof(basic_file), "%s/%s_basic.ll", SUITE_RUN_FOLDER, benchmark->name);
+            snprintf(opt_command, sizeof(opt_command), "opt %s -S -o %s", benchmark->linked_file, basic_file);
+
+            printf("\nRunning benchmark %s without and with basic optimization\n", benchmark->name);
+
+            if (!__suite_time(benchmark, benchmark->linked_file, suite->runs, 0.0, &no_optimization) ||
+                llvm_run_command(opt_command) != 0 ||
+                !__suite_time(benchmark, basic_file, suite->runs, 0.0, &basic_optimization)) {
+                printf("error: benchmark %s does not run [file:\'%s\',line:%d]\n", benchmark->name, __FILE__, __LINE__);
+                exit(0);
+            }
+
+            llvm_cache_store_baselines(__suite_key(benchmark, false), no_optimization, basic_optimization);
+
+        }
+
+        if (log != NULL) {
+            snprintf(baseline_name, sizeof(baseline_name), "%s_no_optimization", benchmark->name);
+            runlog_write_baseline(log, baseline_name, no_optimization);
+            snprintf(baseline_name, sizeof(baseline_name), "%s_basic_optimization", benchmark->name);
+            runlog_write_baseline(log, baseline_name, basic_optimization);
+        }
+
+        // a program too quick to time still needs a ratio
+        benchmark->baseline = no_optimization > 1e-6 ? no_optimization : 1e-6;
+
+        // times cached by earlier runs of any process on this machine
+        __suite_results_file(benchmark, path);
+        FILE* results = fopen(path, "r");
+
+        if (results != NULL) {
+            while (fgets(line, sizeof(line), results) != NULL) {
+                unsigned long genes = 0;
+                double seconds = 0.0;
+                if (sscanf(line, "{\"genes\":\"%lx\",\"seconds\":%lf}", &genes, &seconds) == 2) {
+                    __suite_result_store(benchmark, genes, seconds);
+                }
+            }
+            fclose(results);
+        }
+
+        printf("Benchmark %s: baseline %f sec, weight %.2f, %u cached result(s)\n\n", benchmark->name, benchmark->baseline, benchmark->weight, benchmark->num_results);
+
+    }
+
+    // quickest first, a regression is then found at the lowest cost
+    for (uint32_t i = 1; i < suite->num_benchmarks; i++) {
+        uint32_t current = suite->order[i];
+        uint32_t j = i;
+        while (j > 0 && suite->benchmarks[suite->order[j - 1]].baseline > suite->benchmarks[current].baseline) {
+            suite->order[j] = suite->order[j - 1];
+            j--;
+        }
+        suite->order[j] = current;
+    }
+
+    suite->prepared = true;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_aggregate
+ *
+ * DESCRIPTION
+ *
+ *  Weighted geometric mean of the time ratios of the benchmarks, the time
+ *  with a pass sequence over the baseline time. It is the inverse of the
+ *  mean speedup, so lower is better and 1.0 is no change
+ *
+ * PARAMETERS
+ *
+ *  double* ratios -- time ratio of every benchmark
+ *  double* weights -- weight of every benchmark
+ *  uint32_t num_benchmarks -- number of benchmarks
+ *
+ * RETURN
+ *
+ *  double -- the weighted geometric mean
+ *
+ * EXAMPLE
+ *
+ *  double fitness = suite_aggregate(ratios, weights, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double suite_aggregate(double* ratios, double* weights, uint32_t num_benchmarks) {
+
+    double log_sum = 0.0;
+    double weight_sum = 0.0;
+
+    for (uint32_t b = 0; b < num_benchmarks; b++) {
+        assert(ratios[b] > 0.0 && weights[b] > 0.0);
+        log_sum += weights[b] * log(ratios[b]);
+        weight_sum += weights[b];
+    }
+
+    return weight_sum > 0.0 ? exp(log_sum / weight_sum) : 1.0;
+
+}
+
+/*
+ * NAME
+ *
+ *   suite_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an LLVM_PASS individual over the enabled suite. The passes
+ *  are applied to every benchmark, quickest first, and each is timed
+ *  unless its time for these genes is cached. As soon as a benchmark runs
+ *  past the cutoff times its baseline the individual is clearly
+ *  regressing: its runs stop there and the benchmarks not yet run count
+ *  at the cutoff, rather than being run
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- the individual to evaluate
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  double -- weighted geometric mean time ratio, UINT32_MAX if a benchmark failed
+ *
+ * EXAMPLE
+ *
+ *  double fitness = suite_fitness(indiv, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs opt, llvm-as and lli through the shell, appends to the result cache
+ *
+ */
+
+double suite_fitness(node_str* indiv, bool vis) {
+
+    char output_file[SUITE_MAX_PATH];
+    char opt_command[5000];
+    char path[LLVM_MAX_PATH];
+    double ratios[SUITE_MAX_BENCHMARKS];
+    double weights[SUITE_MAX_BENCHMARKS];
+    uint32_t num_run = 0;
+    uint32_t num_cached = 0;
+    uint32_t num_skipped = 0;
+    bool regressing = false;
+
+    suite_str* suite = suite_active;
+
+    if (suite == NULL || !suite->prepared) {
+        printf("error: the benchmark suite was not prepared [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    uint64_t genes = osaka_hash(indiv);
+
+    if (vis) {
+        printf("Calculating fitness of individual over %u benchmark(s)\n", suite->num_benchmarks);
+    }
+
+    for (uint32_t o = 0; o < suite->num_benchmarks; o++) {
+
+        suite_benchmark_str* benchmark = &suite->benchmarks[suite->order[o]];
+        double limit = suite->cutoff * benchmark->baseline;
+        double seconds = 0.0;
+
+        weights[o] = benchmark->weight;
+
+        // past the cutoff the individual is already out of the running
+        if (regressing) {
+            ratios[o] = suite->cutoff;
+            benchmark->num_skipped++;
+            num_skipped++;
+            continue;
+        }
+
+        if (__suite_result_lookup(benchmark, genes, &seconds)) {
+            benchmark->num_hits++;
+            num_cached++;
+        }
+        else {
+
+            snprintf(output_file, sizeof(output_file), "%s/%s_temp.ll", SUITE_RUN_FOLDER, benchmark->name);
+            strcpy(opt_command, "");
+            llvm_form_opt_command(indiv, NULL, 0, benchmark->linked_file, output_file, opt_command);
+
+            INSTRUMENT_START(opt);
+            TRACE_START(opt);
+            uint32_t result = llvm_run_command(opt_command);
+            TRACE_STOP(opt, "opt", "evaluation");
+            INSTRUMENT_STOP(opt, INSTRUMENT_PHASE_OPT);
+
+            if (result != 0 || !__suite_time(benchmark, output_file, suite->runs, limit, &seconds)) {
+                printf("Benchmark %s failed with these passes\n\n", benchmark->name);
+                return UINT32_MAX;
+            }
+
+            benchmark->num_runs++;
+            num_run++;
+
+            // a time cut short is not the time of the benchmark, so it is not cached
+            if (seconds <= limit) {
+
+                __suite_result_store(benchmark, genes, seconds);
+
+                __suite_results_file(benchmark, path);
+                FILE* results = fopen(path, "a");
+                if (results != NULL) {
+                    fprintf(results, "{\"genes\":\"%016lx\",\"seconds\":%.9f}\n", (unsigned long) (genes == 0 ? 1 : genes), seconds);
+                    fclose(results);
+                }
+
+            }
+
+        }
+
+        ratios[o] = seconds / benchmark->baseline;
+        regressing = ratios[o] >= suite->cutoff;
+
+    }
+
+    double fitness = suite_aggregate(ratios, weights, suite->num_benchmarks);
+
+    printf("Suite time ratio %f: %u benchmark(s) run, %u cached, %u skipped\n\n", fitness, num_run, num_cached, num_skipped);
+
+    return fitness;
+
+}
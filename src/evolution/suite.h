@@ -0,0 +1,362 @@
+/*
+ ============================================================================
+ Name        : suite.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Fitness of an LLVM pass sequence over a suite of benchmark
+               programs rather than a single test file. Each benchmark is
+               timed against its own unoptimized baseline and the fitness
+               is the weighted geometric mean of those time ratios, so no
+               single program dominates and lower is still better. The
+               time of every benchmark is cached under the genes of the
+               individual, and once a benchmark regresses past a cutoff
+               the remaining ones are not run at all
+ ============================================================================
+ */
+
+#ifndef EVOLUTION_SUITE_H_
+#define EVOLUTION_SUITE_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../support/llvm.h"
+#include "../support/runlog.h"
+#include "../support/trace.h"
+#include "../support/instrument.h"
+#include "../support/cJSON.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+
+/*
+ * MACROS
+ */
+
+#define SUITE_MAX_BENCHMARKS 32
+#define SUITE_MAX_NAME 50
+#define SUITE_MAX_PATH 512
+#define SUITE_DEFAULT_CUTOFF 1.5
+#define SUITE_DEFAULT_RUNS 5
+
+// benchmarks run from here, so that the files they write stay out of the tree
+#define SUITE_RUN_FOLDER "src/files/llvm/junk_output"
+
+/*
+ * DATATYPES
+ */
+
+typedef struct suite_benchmark_str {
+    char name[SUITE_MAX_NAME];
+    char test_file[LLVM_MAX_PATH];
+    char** src_files;
+    uint32_t num_src_files;
+    char args[LLVM_MAX_PATH];
+    double weight;
+    uint64_t key;
+    char linked_file[LLVM_MAX_PATH];
+    double baseline;
+    uint64_t* result_genes;
+    double* result_seconds;
+    uint32_t num_results;
+    uint32_t result_capacity;
+    uint64_t num_runs;
+    uint64_t num_hits;
+    uint64_t num_skipped;
+} suite_benchmark_str;
+
+typedef struct suite_str {
+    suite_benchmark_str benchmarks[SUITE_MAX_BENCHMARKS];
+    uint32_t num_benchmarks;
+    uint32_t order[SUITE_MAX_BENCHMARKS];
+    double cutoff;
+    uint32_t runs;
+    bool prepared;
+} suite_str;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   suite_load
+ *
+ * DESCRIPTION
+ *
+ *  Reads a benchmark suite from a JSON file. The file holds a list of
+ *  benchmarks, each with a name, a test_file and its sources in
+ *  src/files/llvm, the command line args it is run with from
+ *  SUITE_RUN_FOLDER and a weight (default 1), along with the cutoff past
+ *  which a regressing individual is short-circuited (default 1.5) and the
+ *  number of timed runs per benchmark (default 5). Unknown keys and invalid
+ *  values are reported and fail the suite
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- the suite to fill in
+ *  const char* path -- path of the suite file
+ *
+ * RETURN
+ *
+ *  bool -- true if the file describes a valid suite
+ *
+ * EXAMPLE
+ *
+ *  bool valid = suite_load(&suite, "src/files/llvm/suites/example.json");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with suite_free
+ *
+ */
+
+bool suite_load(suite_str* suite, const char* path);
+
+/*
+ * NAME
+ *
+ *   suite_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees what a suite allocated for its source file names and cached results
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- the suite
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_free(&suite);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void suite_free(suite_str* suite);
+
+/*
+ * NAME
+ *
+ *   suite_enable
+ *
+ * DESCRIPTION
+ *
+ *  Makes the suite the fitness of LLVM_PASS individuals. From then on
+ *  fitness_pre_cache prepares it and fitness_top evaluates it in place of
+ *  the test file
+ *
+ * PARAMETERS
+ *
+ *  suite_str* suite -- a valid suite, kept by reference until suite_disable
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_enable(&suite);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the LLVM_PASS fitness function
+ *
+ */
+
+void suite_enable(suite_str* suite);
+
+/*
+ * NAME
+ *
+ *   suite_disable
+ *
+ * DESCRIPTION
+ *
+ *  LLVM_PASS individuals are evaluated on the test file again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  restores the LLVM_PASS fitness function
+ *
+ */
+
+void suite_disable(void);
+
+/*
+ * NAME
+ *
+ *   suite_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether a benchmark suite is the fitness of LLVM_PASS individuals
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between suite_enable and suite_disable
+ *
+ * EXAMPLE
+ *
+ *  if (suite_enabled()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool suite_enabled(void);
+
+/*
+ * NAME
+ *
+ *   suite_prepare
+ *
+ * DESCRIPTION
+ *
+ *  Builds every benchmark of the enabled suite through the build cache,
+ *  looks up or measures its baseline, the time it takes without
+ *  optimization, and loads the times cached for it by earlier runs on
+ *  this machine. The benchmarks are then ordered from the quickest to the
+ *  slowest, so that a regression is found at the lowest cost
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- the run log the baselines are written to, NULL when not caching
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  suite_prepare(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs clang, llvm-link, llvm-as and lli through the shell, writes to the build cache
+ *
+ */
+
+void suite_prepare(runlog_str* log);
+
+/*
+ * NAME
+ *
+ *   suite_aggregate
+ *
+ * DESCRIPTION
+ *
+ *  Weighted geometric mean of the time ratios of the benchmarks, the time
+ *  with a pass sequence over the baseline time. It is the inverse of the
+ *  mean speedup, so lower is better and 1.0 is no change
+ *
+ * PARAMETERS
+ *
+ *  double* ratios -- time ratio of every benchmark
+ *  double* weights -- weight of every benchmark
+ *  uint32_t num_benchmarks -- number of benchmarks
+ *
+ * RETURN
+ *
+ *  double -- the weighted geometric mean
+ *
+ * EXAMPLE
+ *
+ *  double fitness = suite_aggregate(ratios, weights, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double suite_aggregate(double* ratios, double* weights, uint32_t num_benchmarks);
+
+/*
+ * NAME
+ *
+ *   suite_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an LLVM_PASS individual over the enabled suite. The passes
+ *  are applied to every benchmark, quickest first, and each is timed
+ *  unless its time for these genes is cached. As soon as a benchmark runs
+ *  past the cutoff times its baseline the individual is clearly
+ *  regressing: its runs stop there and the benchmarks not yet run count
+ *  at the cutoff, rather than being run
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- the individual to evaluate
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  double -- weighted geometric mean time ratio, UINT32_MAX if a benchmark failed
+ *
+ * EXAMPLE
+ *
+ *  double fitness = suite_fitness(indiv, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs opt, llvm-as and lli through the shell, appends to the result cache
+ *
+ */
+
+double suite_fitness(node_str* indiv, bool vis);
+
+#endif /* EVOLUTION_SUITE_H_ */
@@ -45,9 +45,9 @@
 
 uint32_t assembler_uid(void)    {
 
-    static uint32_t uid=0;
+    static _Atomic uint32_t uid=0;
 
-    return ++uid;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
@@ -70,6 +70,15 @@ char *register_string[] =   {
 
 };
 
+char *aarch64_register_string[] =   {
+
+    "x0",
+    "x1",
+    "x2",
+    "x3"
+
+};
+
 char *assembler_instruction_string(instruction_typ i)    {
 
     assert(i<MAXINSTRUCTIONS);
@@ -84,6 +93,23 @@ char *assembler_register_string(register_name r) {
 
 }
 
+uint32_t assembler_random(uint32_t range) {
+
+    return (uint32_t) (range * (rand() / (RAND_MAX + 1.0)));
+
+}
+
+void assembler_randomizeobject(object_assembler_str *o) {
+
+    ASSEMBLER_INSTRUCTION(o) = assembler_random(MAXINSTRUCTIONS);
+    ASSEMBLER_DEST(o) = assembler_random(PCSUSERREGS);
+    ASSEMBLER_SOURCE(o) = assembler_random(PCSUSERREGS);
+    ASSEMBLER_OPERAND(o) = assembler_random(PCSUSERREGS);
+    ASSEMBLER_HAS_IMMEDIATE(o) = assembler_random(2) == 1;
+    ASSEMBLER_IMMEDIATE(o) = MINIMMEDIATE + (int32_t) assembler_random(MAXIMMEDIATE - MINIMMEDIATE + 1);
+
+}
+
 object_assembler_str *assembler_createobject(void) {
 
     object_assembler_str *o;
@@ -92,30 +118,74 @@ object_assembler_str *assembler_createobject(void) {
 
     assert(o!=NULL);
 
-    ASSEMBLER_INSTRUCTION(o) = (int) (MAXINSTRUCTIONS * (rand() / (RAND_MAX + 1.0)));
+    assembler_randomizeobject(o);
     printf( "FORMING ASSEMBLER INSTRUCTION %s\n", assembler_instruction_string(ASSEMBLER_INSTRUCTION(o)));
 
     return o;
 
 }
 
-void assembler_randomizeobject(object_assembler_str *o) {
+void assembler_describeobject(char* desc, object_assembler_str *o) {
 
-    int new_instr = (int) (MAXINSTRUCTIONS * (rand() / (RAND_MAX + 1.0)));
-    ASSEMBLER_INSTRUCTION(o) = new_instr;
+    char operand[20];
+
+    if (ASSEMBLER_HAS_IMMEDIATE(o)) {
+        sprintf(operand, "#%d", ASSEMBLER_IMMEDIATE(o));
+    }
+    else {
+        strcpy(operand, assembler_register_string(ASSEMBLER_OPERAND(o)));
+    }
+
+    if (ASSEMBLER_INSTRUCTION(o) == MOV) {
+        sprintf(desc, "instr : %s %s, %s", assembler_instruction_string(ASSEMBLER_INSTRUCTION(o)),
+            assembler_register_string(ASSEMBLER_DEST(o)), operand);
+    }
+    else {
+        sprintf(desc, "instr : %s %s, %s, %s", assembler_instruction_string(ASSEMBLER_INSTRUCTION(o)),
+            assembler_register_string(ASSEMBLER_DEST(o)), assembler_register_string(ASSEMBLER_SOURCE(o)), operand);
+    }
 
 }
 
 void assembler_printobject(object_assembler_str *o)    {
 
-    printf("instr : %s", assembler_instruction_string(ASSEMBLER_INSTRUCTION(o)));
+    char desc[60];
+
+    assembler_describeobject(desc, o);
+    printf("%s", desc);
 
 }
 
-void assembler_describeobject(char* desc, object_assembler_str *o) {
+void assembler_emitobject(FILE *stream, object_assembler_str *o)    {
+
+    char *instr = assembler_instruction_string(ASSEMBLER_INSTRUCTION(o));
+    char *rd = aarch64_register_string[ASSEMBLER_DEST(o)];
+    char *rn = aarch64_register_string[ASSEMBLER_SOURCE(o)];
+    char *rm = aarch64_register_string[ASSEMBLER_OPERAND(o)];
+    int32_t imm = ASSEMBLER_IMMEDIATE(o);
+
+    assert(stream!=NULL);
 
-    strcpy(desc, "instr : ");
-    strcat(desc, assembler_instruction_string(ASSEMBLER_INSTRUCTION(o)));
+    if (ASSEMBLER_INSTRUCTION(o) == MOV) {
+        if (ASSEMBLER_HAS_IMMEDIATE(o)) {
+            fprintf(stream, "\tmov %s, #%d\n", rd, imm);
+        }
+        else {
+            fprintf(stream, "\tmov %s, %s\n", rd, rm);
+        }
+    }
+    else if (!ASSEMBLER_HAS_IMMEDIATE(o)) {
+        fprintf(stream, "\t%s %s, %s, %s\n", instr, rd, rn, rm);
+    }
+    else if (ASSEMBLER_INSTRUCTION(o) == ADD || ASSEMBLER_INSTRUCTION(o) == SUB) {
+        // the immediate of add and sub is unsigned, so a negative one turns one into the other
+        bool negative = imm < 0;
+        fprintf(stream, "\t%s %s, %s, #%d\n", (ASSEMBLER_INSTRUCTION(o) == ADD) != negative ? "add" : "sub", rd, rn, negative ? -imm : imm);
+    }
+    else {
+        fprintf(stream, "\tmov %s, #%d\n", ASSEMBLER_SCRATCH_REGISTER, imm);
+        fprintf(stream, "\t%s %s, %s, %s\n", instr, rd, rn, ASSEMBLER_SCRATCH_REGISTER);
+    }
 
 }
 
@@ -160,4 +230,85 @@ void *assembler_copyobject(object_assembler_str *o)    {
 
 }
 
-void assembler_test_cycle(void) {}
\ No newline at end of file
+void assembler_test_cycle(void) {}
+
+uint64_t assembler_hashobject(object_assembler_str *o)   {
+
+    // every field fits its own bits, so distinct instructions never pack the same
+    uint64_t packed = ASSEMBLER_INSTRUCTION(o) | ASSEMBLER_DEST(o) << 4 | ASSEMBLER_SOURCE(o) << 8 | ASSEMBLER_OPERAND(o) << 12 |
+        (uint64_t) ASSEMBLER_HAS_IMMEDIATE(o) << 16 | (uint64_t) (uint32_t) ASSEMBLER_IMMEDIATE(o) << 32;
+
+    return hash_mix64(packed);
+
+}
+
+bool assembler_equalobject(object_assembler_str *o0, object_assembler_str *o1)   {
+
+    return ASSEMBLER_INSTRUCTION(o0)==ASSEMBLER_INSTRUCTION(o1) &&
+        ASSEMBLER_DEST(o0)==ASSEMBLER_DEST(o1) &&
+        ASSEMBLER_SOURCE(o0)==ASSEMBLER_SOURCE(o1) &&
+        ASSEMBLER_OPERAND(o0)==ASSEMBLER_OPERAND(o1) &&
+        ASSEMBLER_HAS_IMMEDIATE(o0)==ASSEMBLER_HAS_IMMEDIATE(o1) &&
+        ASSEMBLER_IMMEDIATE(o0)==ASSEMBLER_IMMEDIATE(o1);
+
+}
+
+uint32_t assembler_fieldsobject(uint32_t *ranges)   {
+
+    ranges[0] = MAXINSTRUCTIONS;
+    ranges[1] = PCSUSERREGS;
+    ranges[2] = PCSUSERREGS;
+    ranges[3] = PCSUSERREGS;
+    ranges[4] = 2;
+    ranges[5] = MAXIMMEDIATE - MINIMMEDIATE + 1;
+
+    return 6;
+
+}
+
+void assembler_encodeobject(uint32_t *fields, object_assembler_str *o)   {
+
+    fields[0] = ASSEMBLER_INSTRUCTION(o);
+    fields[1] = ASSEMBLER_DEST(o);
+    fields[2] = ASSEMBLER_SOURCE(o);
+    fields[3] = ASSEMBLER_OPERAND(o);
+    fields[4] = ASSEMBLER_HAS_IMMEDIATE(o);
+    fields[5] = ASSEMBLER_IMMEDIATE(o) - MINIMMEDIATE;
+
+}
+
+void *assembler_decodeobject(uint32_t *fields)   {
+
+    object_assembler_str *o;
+
+    // allocated directly, assembler_createobject would pick and print a random instruction
+    o = malloc(sizeof(object_assembler_str));
+    assert(o!=NULL);
+
+    ASSEMBLER_INSTRUCTION(o) = fields[0];
+    ASSEMBLER_DEST(o) = fields[1];
+    ASSEMBLER_SOURCE(o) = fields[2];
+    ASSEMBLER_OPERAND(o) = fields[3];
+    ASSEMBLER_HAS_IMMEDIATE(o) = fields[4] == 1;
+    ASSEMBLER_IMMEDIATE(o) = (int32_t) fields[5] + MINIMMEDIATE;
+
+    return o;
+
+}
+
+void assembler_mutatebatch(void **objs, uint32_t n, uint64_t *state) {
+
+    for (uint32_t i = 0; i < n; i++) {
+
+        object_assembler_str *o = objs[i];
+
+        ASSEMBLER_INSTRUCTION(o) = bounded_rand(state, MAXINSTRUCTIONS);
+        ASSEMBLER_DEST(o) = bounded_rand(state, PCSUSERREGS);
+        ASSEMBLER_SOURCE(o) = bounded_rand(state, PCSUSERREGS);
+        ASSEMBLER_OPERAND(o) = bounded_rand(state, PCSUSERREGS);
+        ASSEMBLER_HAS_IMMEDIATE(o) = bounded_rand(state, 2) == 1;
+        ASSEMBLER_IMMEDIATE(o) = MINIMMEDIATE + (int32_t) bounded_rand(state, MAXIMMEDIATE - MINIMMEDIATE + 1);
+
+    }
+
+}
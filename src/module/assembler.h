@@ -61,17 +61,32 @@ typedef enum    {
     R3
 } register_name;
 
+// instr rd, rn, rm or instr rd, rn, #imm, mov ignores rn
 typedef struct object_assembler_str    {
     instruction_typ instr;
+    register_name rd;
+    register_name rn;
+    register_name rm;
+    bool immediate;
+    int32_t imm;
 } object_assembler_str;
 
 /*
  * MACROS
  */
 
-#define MAXINSTRUCTIONS 4
-#define PCSUSERREGS 3
+#define MAXINSTRUCTIONS 5
+#define PCSUSERREGS 4
+#define MINIMMEDIATE -128
+#define MAXIMMEDIATE 127
+// mul and sdiv have no immediate form on AArch64, their immediate goes through this register
+#define ASSEMBLER_SCRATCH_REGISTER "x9"
 #define ASSEMBLER_INSTRUCTION(s) s->instr
+#define ASSEMBLER_DEST(s) s->rd
+#define ASSEMBLER_SOURCE(s) s->rn
+#define ASSEMBLER_OPERAND(s) s->rm
+#define ASSEMBLER_HAS_IMMEDIATE(s) s->immediate
+#define ASSEMBLER_IMMEDIATE(s) s->imm
 
 /*
  * ROUTINES
@@ -83,6 +98,8 @@ void assembler_randomizeobject(object_assembler_str *o);
 
 void assembler_printobject(object_assembler_str *o);
 
+void assembler_emitobject(FILE *stream, object_assembler_str *o);
+
 void assembler_describeobject(char* desc, object_assembler_str *o);
 
 void assembler_deleteobject(object_assembler_str *o);
@@ -93,4 +110,16 @@ void *assembler_readobject(FILE *stream);
 
 void *assembler_copyobject(object_assembler_str *o);
 
+uint64_t assembler_hashobject(object_assembler_str *o);
+
+bool assembler_equalobject(object_assembler_str *o0, object_assembler_str *o1);
+
+uint32_t assembler_fieldsobject(uint32_t *ranges);
+
+void assembler_encodeobject(uint32_t *fields, object_assembler_str *o);
+
+void *assembler_decodeobject(uint32_t *fields);
+
+void assembler_mutatebatch(void **objs, uint32_t n, uint64_t *state);
+
 #endif /* MODULE_ASSEMBLER_H_ */
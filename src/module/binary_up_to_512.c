@@ -45,59 +45,19 @@
 
 uint32_t binary_up_to_512_uid(void) {
 
-    static uint32_t uid=0;
-    return ++uid;
-
-}
-
-void binary_up_to_512_binary_set_valid_values(object_binary_up_to_512_str* o) {
-
-	uint32_t* values = malloc(sizeof(uint32_t) * 11);
-	values[0] = 0;
-	values[1] = 1;
-	values[2] = 2;
-	values[3] = 4;
-	values[4] = 8;
-	values[5] = 16;
-	values[6] = 32;
-	values[7] = 64;
-	values[8] = 128;
-	values[9] = 256;
-	values[10] = 512;
-
-	BINARY_UP_TO_512_BINARY_VALID_VALUES(o) = values;
-	BINARY_UP_TO_512_BINARY_CONSTRAINED(o) = true;
-	BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(o) = 11;
-
-	return;
+    static _Atomic uint32_t uid=0;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
 object_binary_up_to_512_str *binary_up_to_512_createobject(void) {
 
-    object_binary_up_to_512_str *o;
-	binary_up_to_512_number *binary_up_to_512_number_o;
-	binary_up_to_512_binary *binary_up_to_512_binary_o;
-
-    o = malloc(sizeof(object_binary_up_to_512_str));
-	binary_up_to_512_number_o = malloc(sizeof(binary_up_to_512_number));
-	binary_up_to_512_binary_o = malloc(sizeof(binary_up_to_512_binary));
+    object_binary_up_to_512_str *o = malloc(sizeof(object_binary_up_to_512_str));
 
 	assert(o!=NULL);
-	assert(binary_up_to_512_number_o!=NULL);
-	assert(binary_up_to_512_binary_o!=NULL);
-
-	BINARY_UP_TO_512_NUMBER_STRUCT(o) = binary_up_to_512_number_o;
-	BINARY_UP_TO_512_BINARY_STRUCT(o) = binary_up_to_512_binary_o;
 
 	BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = -1;
-	BINARY_UP_TO_512_NUMBER_CONSTRAINED(o) = false;
-	BINARY_UP_TO_512_NUMBER_VALID_VALUES(o) = NULL;
-	BINARY_UP_TO_512_NUMBER_NUM_VALID_VALUES(o) = 0;
-
-	BINARY_UP_TO_512_BINARY_MY_BINARY(o) = -1;
-	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = -1;
-	binary_up_to_512_binary_set_valid_values(o);
+	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = 0;
 
 	return o;
 
@@ -105,12 +65,11 @@ object_binary_up_to_512_str *binary_up_to_512_createobject(void) {
 
 void binary_up_to_512_randomizeobject(object_binary_up_to_512_str *o) {
 
-	BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = rand() / (RAND_MAX + 1.0);
+	BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = (int64_t) (512.0 * (rand() / (RAND_MAX + 1.0)));
 
 	uint32_t num_valid_values1 = BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(o);
 	uint32_t new_index1 = (uint32_t) (num_valid_values1 * (rand() / (RAND_MAX + 1.0)));
 	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = new_index1;
-	BINARY_UP_TO_512_BINARY_MY_BINARY(o) = BINARY_UP_TO_512_BINARY_VALID_VALUES(o)[new_index1];
 
 }
 
@@ -123,8 +82,8 @@ void binary_up_to_512_printobject(object_binary_up_to_512_str *o) {
 
 void binary_up_to_512_describeobject(char* desc, object_binary_up_to_512_str *o) {
 
-    char my_number[5];
-    char my_binary[5];
+    char my_number[12];
+    char my_binary[12];
 
     itoa(BINARY_UP_TO_512_NUMBER_MY_NUMBER(o), my_number, 10);
     itoa(BINARY_UP_TO_512_BINARY_MY_BINARY(o), my_binary, 10);
@@ -140,10 +99,6 @@ void binary_up_to_512_deleteobject(object_binary_up_to_512_str *s) {
 
 	assert(s!=NULL);
 
-	free(BINARY_UP_TO_512_NUMBER_STRUCT(s));
-	free(BINARY_UP_TO_512_BINARY_VALID_VALUES(s));
-	free(BINARY_UP_TO_512_BINARY_STRUCT(s));
-
 	free(s);
 
 }
@@ -157,22 +112,10 @@ void binary_up_to_512_writeobject(FILE *stream, object_binary_up_to_512_str *o)
 
 void *binary_up_to_512_readobject(FILE *stream) {
 
-    object_binary_up_to_512_str *o;
-	binary_up_to_512_number *binary_up_to_512_number_o;
-	binary_up_to_512_binary *binary_up_to_512_binary_o;
+    object_binary_up_to_512_str *o = malloc(sizeof(object_binary_up_to_512_str));
 
 	assert(stream!=NULL);
-
-	o = malloc(sizeof(object_binary_up_to_512_str));
-	binary_up_to_512_number_o = malloc(sizeof(binary_up_to_512_number));
-	binary_up_to_512_binary_o = malloc(sizeof(binary_up_to_512_binary));
-
 	assert(o!=NULL);
-	assert(binary_up_to_512_number_o!=NULL);
-	assert(binary_up_to_512_binary_o!=NULL);
-
-	BINARY_UP_TO_512_NUMBER_STRUCT(o) = binary_up_to_512_number_o;
-	BINARY_UP_TO_512_BINARY_STRUCT(o) = binary_up_to_512_binary_o;
 
 	fread(o, sizeof(object_binary_up_to_512_str), 1, stream);
 
@@ -182,13 +125,116 @@ void *binary_up_to_512_readobject(FILE *stream) {
 
 void *binary_up_to_512_copyobject(object_binary_up_to_512_str *o) {
 
-    object_binary_up_to_512_str *c = binary_up_to_512_createobject();
+    object_binary_up_to_512_str *c = malloc(sizeof(object_binary_up_to_512_str));
 
-	BINARY_UP_TO_512_NUMBER_MY_NUMBER(c) = BINARY_UP_TO_512_NUMBER_MY_NUMBER(o);
+	assert(c!=NULL);
 
-	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(c) = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o);
-	BINARY_UP_TO_512_BINARY_MY_BINARY(c) = BINARY_UP_TO_512_BINARY_VALID_VALUES(c)[BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o)];
+	memcpy(c, o, sizeof(object_binary_up_to_512_str));
 
 	return c;
 
 }
+
+uint64_t binary_up_to_512_hashobject(object_binary_up_to_512_str *o) {
+
+	uint64_t h = hash_mix64(BINARY_UP_TO_512_NUMBER_MY_NUMBER(o));
+	h = hash_combine(h, BINARY_UP_TO_512_BINARY_MY_BINARY(o));
+
+	return h;
+
+}
+
+bool binary_up_to_512_equalobject(object_binary_up_to_512_str *o0, object_binary_up_to_512_str *o1) {
+
+	return BINARY_UP_TO_512_NUMBER_MY_NUMBER(o0) == BINARY_UP_TO_512_NUMBER_MY_NUMBER(o1) &&
+		BINARY_UP_TO_512_BINARY_MY_BINARY(o0) == BINARY_UP_TO_512_BINARY_MY_BINARY(o1);
+
+}
+
+uint32_t binary_up_to_512_fieldsobject(uint32_t *ranges) {
+
+	ranges[0] = 512;
+	ranges[1] = sizeof(binary_up_to_512_binary_values) / sizeof(uint32_t);
+
+	return 2;
+
+}
+
+void binary_up_to_512_encodeobject(uint32_t *fields, object_binary_up_to_512_str *o) {
+
+	fields[0] = BINARY_UP_TO_512_NUMBER_MY_NUMBER(o);
+	fields[1] = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o);
+
+}
+
+void *binary_up_to_512_decodeobject(uint32_t *fields) {
+
+	object_binary_up_to_512_str *o = binary_up_to_512_createobject();
+
+	BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = fields[0];
+	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = fields[1];
+
+	return o;
+
+}
+
+void binary_up_to_512_randomizebatch(void **objs, uint32_t n, uint64_t *state) {
+
+	for (uint32_t i = 0; i < n; i++) {
+
+		object_binary_up_to_512_str *o = objs[i];
+
+		BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = bounded_rand(state, 512);
+		BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = bounded_rand(state, BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(o));
+
+	}
+
+}
+
+void binary_up_to_512_number_mutate(object_binary_up_to_512_str *o, uint64_t *state) {
+
+	int64_t current = (int64_t) BINARY_UP_TO_512_NUMBER_MY_NUMBER(o);
+	int64_t value = current + gaussian_step(state, 16);
+
+	if (value < 0 || value > 511) {
+		value = 2 * current - value;
+	}
+
+	BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) = value < 0 ? 0 : value > 511 ? 511 : value;
+
+}
+
+void binary_up_to_512_binary_mutate(object_binary_up_to_512_str *o, uint64_t *state) {
+
+	BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = neighbor_index(state, BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o), BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(o), 1);
+
+}
+
+uint32_t binary_up_to_512_mutatorsobject(void (**mutators)(void *, uint64_t *), uint32_t *weights) {
+
+	mutators[0] = (void (*)(void *, uint64_t *)) binary_up_to_512_number_mutate;
+	weights[0] = 1;
+	mutators[1] = (void (*)(void *, uint64_t *)) binary_up_to_512_binary_mutate;
+	weights[1] = 3;
+
+	return 2;
+
+}
+
+void binary_up_to_512_mutatebatch(void **objs, uint32_t n, uint64_t *state) {
+
+	for (uint32_t i = 0; i < n; i++) {
+
+		object_binary_up_to_512_str *o = objs[i];
+		uint32_t r = bounded_rand(state, 4);
+
+		if (r < 1) {
+			binary_up_to_512_number_mutate(o, state);
+		}
+		else {
+			binary_up_to_512_binary_mutate(o, state);
+		}
+
+	}
+
+}
@@ -38,52 +38,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <assert.h>
 
 /*
  * DATATYPES
  */
 
-typedef struct binary_up_to_512_number {
-	uint32_t value;
-	uint32_t value_index;
-	bool constrained;
-	uint32_t* valid_values;
-	int num_values;
-} binary_up_to_512_number;
-
-typedef struct binary_up_to_512_binary {
-	uint32_t value;
-	uint32_t value_index;
-	bool constrained;
-	uint32_t* valid_values;
-	int num_values;
-} binary_up_to_512_binary;
-
+// the object is one flat struct, the binary kept as an index into its valid values
 typedef struct object_binary_up_to_512_str {
-	binary_up_to_512_number* item0;
-	binary_up_to_512_binary* item1;
+	uint32_t number;
+	uint32_t binary_index : 4;
 } object_binary_up_to_512_str;
 
+static const uint32_t binary_up_to_512_binary_values[] = { 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+
 /*
  * MACROS
  */
 
 // Auto-generated macros: ----------------------------------------------
 
-#define BINARY_UP_TO_512_NUMBER_STRUCT(s) s->item0
-#define BINARY_UP_TO_512_NUMBER_MY_NUMBER(s) s->item0->value
-#define BINARY_UP_TO_512_NUMBER_MY_NUMBER_INDEX(s) s->item0->value_index
-#define BINARY_UP_TO_512_NUMBER_CONSTRAINED(s) s->item0->constrained
-#define BINARY_UP_TO_512_NUMBER_VALID_VALUES(s) s->item0->valid_values
-#define BINARY_UP_TO_512_NUMBER_NUM_VALID_VALUES(s) s->item0->num_values
+#define BINARY_UP_TO_512_NUMBER_MY_NUMBER(s) s->number
+#define BINARY_UP_TO_512_NUMBER_CONSTRAINED(s) false
+#define BINARY_UP_TO_512_NUMBER_VALID_VALUES(s) NULL
+#define BINARY_UP_TO_512_NUMBER_NUM_VALID_VALUES(s) 0
 
-#define BINARY_UP_TO_512_BINARY_STRUCT(s) s->item1
-#define BINARY_UP_TO_512_BINARY_MY_BINARY(s) s->item1->value
-#define BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(s) s->item1->value_index
-#define BINARY_UP_TO_512_BINARY_CONSTRAINED(s) s->item1->constrained
-#define BINARY_UP_TO_512_BINARY_VALID_VALUES(s) s->item1->valid_values
-#define BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(s) s->item1->num_values
+#define BINARY_UP_TO_512_BINARY_MY_BINARY(s) binary_up_to_512_binary_values[s->binary_index]
+#define BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(s) s->binary_index
+#define BINARY_UP_TO_512_BINARY_CONSTRAINED(s) true
+#define BINARY_UP_TO_512_BINARY_VALID_VALUES(s) binary_up_to_512_binary_values
+#define BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(s) (sizeof(binary_up_to_512_binary_values) / sizeof(uint32_t))
 
 // ----------------------------------------------------------------------
 
@@ -91,8 +76,6 @@ typedef struct object_binary_up_to_512_str {
  * ROUTINES
  */
 
-void binary_up_to_512_binary_set_valid_values(object_binary_up_to_512_str* o);
-
 object_binary_up_to_512_str *binary_up_to_512_createobject(void);
 
 void binary_up_to_512_randomizeobject(object_binary_up_to_512_str *o);
@@ -109,4 +92,24 @@ void *binary_up_to_512_readobject(FILE *stream);
 
 void *binary_up_to_512_copyobject(object_binary_up_to_512_str *o);
 
+uint64_t binary_up_to_512_hashobject(object_binary_up_to_512_str *o);
+
+bool binary_up_to_512_equalobject(object_binary_up_to_512_str *o0, object_binary_up_to_512_str *o1);
+
+uint32_t binary_up_to_512_fieldsobject(uint32_t *ranges);
+
+void binary_up_to_512_encodeobject(uint32_t *fields, object_binary_up_to_512_str *o);
+
+void *binary_up_to_512_decodeobject(uint32_t *fields);
+
+void binary_up_to_512_randomizebatch(void **objs, uint32_t n, uint64_t *state);
+
+void binary_up_to_512_mutatebatch(void **objs, uint32_t n, uint64_t *state);
+
+void binary_up_to_512_number_mutate(object_binary_up_to_512_str *o, uint64_t *state);
+
+void binary_up_to_512_binary_mutate(object_binary_up_to_512_str *o, uint64_t *state);
+
+uint32_t binary_up_to_512_mutatorsobject(void (**mutators)(void *, uint64_t *), uint32_t *weights);
+
 #endif /* MODULE_BINARY_UP_TO_512_H_ */
\ No newline at end of file
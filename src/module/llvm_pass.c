@@ -46,8 +46,8 @@
 
 uint32_t llvm_pass_uid(void)  {
     
-    static uint32_t uid=0;
-    return ++uid;
+    static _Atomic uint32_t uid=0;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
@@ -233,4 +233,63 @@ void *llvm_pass_copyobject(object_llvm_pass_str *o)   {
 
     return c;
 
-}
\ No newline at end of file
+}
+
+uint64_t llvm_pass_hashobject(object_llvm_pass_str *o)   {
+
+    // hashed by contents, unconstrained passes are not shared between objects
+    return hash_string(PASS(o));
+
+}
+
+bool llvm_pass_equalobject(object_llvm_pass_str *o0, object_llvm_pass_str *o1)   {
+
+    return PASS(o0)==PASS(o1) || strcmp(PASS(o0), PASS(o1))==0;
+
+}
+
+uint32_t llvm_pass_fieldsobject(uint32_t *ranges)   {
+
+    object_llvm_pass_str *o = llvm_pass_createobject();
+
+    ranges[0] = PASS_NUM_VALID_VALUES(o);
+    llvm_pass_deleteobject(o);
+
+    return 1;
+
+}
+
+void llvm_pass_encodeobject(uint32_t *fields, object_llvm_pass_str *o)   {
+
+    fields[0] = PASS_INDEX(o);
+
+}
+
+void *llvm_pass_decodeobject(uint32_t *fields)   {
+
+    object_llvm_pass_str *o = llvm_pass_createobject();
+
+    PASS_INDEX(o) = fields[0];
+    PASS(o) = PASS_VALID_VALUES(o)[fields[0]];
+
+    return o;
+
+}
+
+void llvm_pass_mutatebatch(void **objs, uint32_t n, uint64_t *state) {
+
+    for (uint32_t i = 0; i < n; i++) {
+
+        object_llvm_pass_str *o = objs[i];
+
+        if (PASS_CONSTRAINED(o)) {
+            PASS_INDEX(o) = bounded_rand(state, PASS_NUM_VALID_VALUES(o));
+            PASS(o) = PASS_VALID_VALUES(o)[PASS_INDEX(o)];
+        }
+        else {
+            PASS(o) = random_string(bounded_rand(state, 20), state);
+        }
+
+    }
+
+}
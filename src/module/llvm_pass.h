@@ -90,4 +90,16 @@ void *llvm_pass_readobject(FILE *stream);
 
 void *llvm_pass_copyobject(object_llvm_pass_str *o);
 
+uint64_t llvm_pass_hashobject(object_llvm_pass_str *o);
+
+bool llvm_pass_equalobject(object_llvm_pass_str *o0, object_llvm_pass_str *o1);
+
+uint32_t llvm_pass_fieldsobject(uint32_t *ranges);
+
+void llvm_pass_encodeobject(uint32_t *fields, object_llvm_pass_str *o);
+
+void *llvm_pass_decodeobject(uint32_t *fields);
+
+void llvm_pass_mutatebatch(void **objs, uint32_t n, uint64_t *state);
+
 #endif /* MODULE_LLVM_PASS_H_ */
@@ -49,6 +49,14 @@ object_functions_str object_table_function[] =  {
         simple_readobject,
         simple_copyobject,
         simple_describeobject,            // will be used in cache update, WIP
+        simple_hashobject,
+        simple_equalobject,
+        simple_fieldsobject,
+        simple_encodeobject,
+        simple_decodeobject,
+        NULL,                             // no randomize kernel, generated one object at a time
+        simple_mutatebatch,
+        NULL,
     },
     {
         1,
@@ -61,6 +69,14 @@ object_functions_str object_table_function[] =  {
         assembler_readobject,
         assembler_copyobject,
         assembler_describeobject,         // will be used in cache update, WIP
+        assembler_hashobject,
+        assembler_equalobject,
+        assembler_fieldsobject,
+        assembler_encodeobject,
+        assembler_decodeobject,
+        NULL,                             // no randomize kernel, generated one object at a time
+        assembler_mutatebatch,
+        NULL,
     },
     {
         2,
@@ -73,6 +89,14 @@ object_functions_str object_table_function[] =  {
         osaka_string_readobject,
         osaka_string_copyobject,
         osaka_string_describeobject,      // will be used in cache update, WIP
+        osaka_string_hashobject,
+        osaka_string_equalobject,
+        osaka_string_fieldsobject,
+        osaka_string_encodeobject,
+        osaka_string_decodeobject,
+        NULL,                             // no randomize kernel, generated one object at a time
+        osaka_string_mutatebatch,
+        NULL,
     },
     {
         3,
@@ -85,6 +109,14 @@ object_functions_str object_table_function[] =  {
         llvm_pass_readobject,
         llvm_pass_copyobject,
         llvm_pass_describeobject,         // will be used in cache update, WIP
+        llvm_pass_hashobject,
+        llvm_pass_equalobject,
+        llvm_pass_fieldsobject,
+        llvm_pass_encodeobject,
+        llvm_pass_decodeobject,
+        NULL,                             // no randomize kernel, generated one object at a time
+        llvm_pass_mutatebatch,
+        NULL,
     },
 	{
 		4,
@@ -97,6 +129,14 @@ object_functions_str object_table_function[] =  {
 		binary_up_to_512_readobject,
 		binary_up_to_512_copyobject,
         binary_up_to_512_describeobject,  // will be used in cache update, WIP
+		binary_up_to_512_hashobject,
+		binary_up_to_512_equalobject,
+		binary_up_to_512_fieldsobject,
+		binary_up_to_512_encodeobject,
+		binary_up_to_512_decodeobject,
+		binary_up_to_512_randomizebatch,
+		binary_up_to_512_mutatebatch,
+		binary_up_to_512_mutatorsobject,
 	},
     {
         -1,
@@ -109,6 +149,14 @@ object_functions_str object_table_function[] =  {
         NULL,
         NULL,
         NULL,                             // will be used in cache update, WIP
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
     }
 };
 
@@ -40,6 +40,14 @@
 #include "llvm_pass.h"
 #include "binary_up_to_512.h"
 
+/*
+ * MACROS
+ */
+
+// maximum number of uint32_t fields a gene can be encoded into
+// by its osaka_encodeobject hook, see population.h
+#define OBJECT_MAX_FIELDS 8
+
 /*
  * DATATYPE
  */
@@ -55,6 +63,14 @@ typedef struct object_functions_str {
     void *(*osaka_readobject)(FILE *stream);
     void *(*osaka_copyobject)(void *);
     void (*osaka_describeobject)(char *, void *);         // Will be used for caching functionality, WIP
+    uint64_t (*osaka_hashobject)(void *);
+    bool (*osaka_equalobject)(void *, void *);
+    uint32_t (*osaka_fieldsobject)(uint32_t *);
+    void (*osaka_encodeobject)(uint32_t *, void *);
+    void *(*osaka_decodeobject)(uint32_t *);
+    void (*osaka_randomizebatch)(void **, uint32_t, uint64_t *);   // batch kernels, NULL if the type has none
+    void (*osaka_mutatebatch)(void **, uint32_t, uint64_t *);
+    uint32_t (*osaka_mutatorsobject)(void (**)(void *, uint64_t *), uint32_t *);   // per-param mutate methods and their weights
 } object_functions_str;
 
 /*
@@ -45,8 +45,8 @@
 
 uint32_t osaka_string_uid(void)  {
     
-    static uint32_t uid=0;
-    return ++uid;
+    static _Atomic uint32_t uid=0;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
@@ -173,4 +173,72 @@ void *osaka_string_copyobject(object_osaka_string_str *o)   {
 
     return c;
 
-}
\ No newline at end of file
+}
+
+uint64_t osaka_string_hashobject(object_osaka_string_str *o)   {
+
+    // hashed by contents, unconstrained strings are not shared between objects
+    return hash_string(MY_STRING(o));
+
+}
+
+bool osaka_string_equalobject(object_osaka_string_str *o0, object_osaka_string_str *o1)   {
+
+    return MY_STRING(o0)==MY_STRING(o1) || strcmp(MY_STRING(o0), MY_STRING(o1))==0;
+
+}
+
+uint32_t osaka_string_fieldsobject(uint32_t *ranges)   {
+
+    object_osaka_string_str *o = osaka_string_createobject();
+
+    ranges[0] = NUM_VALID_VALUES(o);
+    osaka_string_deleteobject(o);
+
+    return 1;
+
+}
+
+void osaka_string_encodeobject(uint32_t *fields, object_osaka_string_str *o)   {
+
+    // only constrained strings can be stored as an index into the valid values
+    assert(CONSTRAINED(o));
+
+    for (uint32_t i = 0; i < NUM_VALID_VALUES(o); i++) {
+        if (MY_STRING(o) == MY_STRING_VALID_VALUES(o)[i] || strcmp(MY_STRING(o), MY_STRING_VALID_VALUES(o)[i]) == 0) {
+            fields[0] = i;
+            return;
+        }
+    }
+
+    printf("error: string \'%s\' is not a valid value [file:\'%s\',line:%d]\n", MY_STRING(o), __FILE__, __LINE__);
+    exit(0);
+
+}
+
+void *osaka_string_decodeobject(uint32_t *fields)   {
+
+    object_osaka_string_str *o = osaka_string_createobject();
+
+    MY_STRING(o) = MY_STRING_VALID_VALUES(o)[fields[0]];
+
+    return o;
+
+}
+
+void osaka_string_mutatebatch(void **objs, uint32_t n, uint64_t *state) {
+
+    for (uint32_t i = 0; i < n; i++) {
+
+        object_osaka_string_str *o = objs[i];
+
+        if (CONSTRAINED(o)) {
+            MY_STRING(o) = MY_STRING_VALID_VALUES(o)[bounded_rand(state, NUM_VALID_VALUES(o))];
+        }
+        else {
+            MY_STRING(o) = random_string(bounded_rand(state, 20), state);
+        }
+
+    }
+
+}
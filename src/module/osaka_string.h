@@ -87,6 +87,18 @@ void *osaka_string_readobject(FILE *stream);
 
 void *osaka_string_copyobject(object_osaka_string_str *o);
 
+uint64_t osaka_string_hashobject(object_osaka_string_str *o);
+
+bool osaka_string_equalobject(object_osaka_string_str *o0, object_osaka_string_str *o1);
+
+uint32_t osaka_string_fieldsobject(uint32_t *ranges);
+
+void osaka_string_encodeobject(uint32_t *fields, object_osaka_string_str *o);
+
+void *osaka_string_decodeobject(uint32_t *fields);
+
+void osaka_string_mutatebatch(void **objs, uint32_t n, uint64_t *state);
+
 //uint32_t osaka_string_fitnessobject(node_str *n);
 
 #endif /* MODULE_OSAKA_STRING_H_ */
@@ -45,8 +45,8 @@
 
 uint32_t simple_uid(void)  {
     
-    static uint32_t uid=0;
-    return ++uid;
+    static _Atomic uint32_t uid=0;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
@@ -81,8 +81,8 @@ void simple_printobject(object_simple_str *o)   {
 
 void simple_describeobject(char* desc, object_simple_str *o) {
 
-    char subtype[5];
-    char integer[5];
+    char subtype[12];
+    char integer[12];
 
     itoa(SUBTYPE(o), subtype, 10);
     itoa(INTEGER(o), integer, 10);
@@ -136,4 +136,59 @@ void *simple_copyobject(object_simple_str *o)   {
 
     return c;
 
-}
\ No newline at end of file
+}
+
+uint64_t simple_hashobject(object_simple_str *o)   {
+
+    return hash_combine(hash_mix64(SUBTYPE(o)), INTEGER(o));
+
+}
+
+bool simple_equalobject(object_simple_str *o0, object_simple_str *o1)   {
+
+    return SUBTYPE(o0)==SUBTYPE(o1) && INTEGER(o0)==INTEGER(o1);
+
+}
+
+uint32_t simple_fieldsobject(uint32_t *ranges)   {
+
+    ranges[0] = 0;
+    ranges[1] = 0;
+
+    return 2;
+
+}
+
+void simple_encodeobject(uint32_t *fields, object_simple_str *o)   {
+
+    fields[0] = SUBTYPE(o);
+    fields[1] = INTEGER(o);
+
+}
+
+void *simple_decodeobject(uint32_t *fields)   {
+
+    object_simple_str *o;
+
+    o=malloc(sizeof(object_simple_str));
+    assert(o!=NULL);
+
+    SUBTYPE(o) = fields[0];
+    INTEGER(o) = fields[1];
+
+    return o;
+
+}
+
+void simple_mutatebatch(void **objs, uint32_t n, uint64_t *state) {
+
+    for (uint32_t i = 0; i < n; i++) {
+
+        object_simple_str *o = objs[i];
+
+        SUBTYPE(o) = (int) (xorshift64star(state) >> 33);
+        INTEGER(o) = (int) (xorshift64star(state) >> 33);
+
+    }
+
+}
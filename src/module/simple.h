@@ -76,6 +76,18 @@ void *simple_readobject(FILE *stream);
 
 void *simple_copyobject(object_simple_str *o);
 
+uint64_t simple_hashobject(object_simple_str *o);
+
+bool simple_equalobject(object_simple_str *o0, object_simple_str *o1);
+
+uint32_t simple_fieldsobject(uint32_t *ranges);
+
+void simple_encodeobject(uint32_t *fields, object_simple_str *o);
+
+void *simple_decodeobject(uint32_t *fields);
+
+void simple_mutatebatch(void **objs, uint32_t n, uint64_t *state);
+
 //uint32_t simple_fitnessobject(node_str *n);
 
 #endif /* MODULE_SIMPLE_H_ */
@@ -67,7 +67,8 @@ uint32_t global_nth;
  *
  *  This function increments an internal counter and returns a unique
  *  value. Normally useful for initial development and debugging. It
- *  limits the size of the list to 2^31.
+ *  limits the size of the list to 2^31. The counter is atomic so nodes
+ *  can be created from several threads at once.
  *
  * PARAMETERS
  *
@@ -89,9 +90,9 @@ uint32_t global_nth;
 
 uint32_t osaka_uid(void)  {
 
-    static uint32_t uid = 0;
+    static _Atomic uint32_t uid = 0;
 
-    return ++uid;
+    return atomic_fetch_add(&uid, 1) + 1;
 
 }
 
@@ -191,6 +192,9 @@ node_str *__osaka_createnode(osaka_object_typ ot) {
         exit(0);
     }
 
+    INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_ALLOCS, 1);
+    INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_BYTES, sizeof(node_str));
+
     UID(n)=osaka_uid();
     NEXT(n)=NULL;
     LAST(n)=NULL;
@@ -198,6 +202,9 @@ node_str *__osaka_createnode(osaka_object_typ ot) {
     LAST_LINK(n)=NULL;
     OBJECT_TYPE(n)=NOTSET;
     OBJECT(n)=NULL;
+    HASH(n)=0;
+    HASH_VALID(n)=false;
+    LIST(n)=NULL;
 
     if(ot>=0 && ot<MAXTYPE) {
         OBJECT_TYPE(n)=ot;
@@ -216,7 +223,8 @@ node_str *__osaka_createnode(osaka_object_typ ot) {
  * DESCRIPTION
  *
  *  This function finds the tail node of the OLS. When the tail is found 
- *  the pointer is returned of the tail node.  
+ *  the pointer is returned of the tail node. A root with an attached
+ *  header gives the tail without walking the list.
  *
  * PARAMETERS
  *
@@ -240,6 +248,10 @@ node_str *osaka_findtailnode(node_str *root)  {
 
     assert(root!=NULL);
 
+    if (LIST(root)!=NULL) {
+        return OSAKA_LIST_TAIL(LIST(root));
+    }
+
     while (NEXT(root)!=NULL) {
         root=NEXT(root);
     }
@@ -295,7 +307,8 @@ node_str *osaka_findheadnode(node_str *n) {
  * DESCRIPTION
  *
  *   This function adds a single node to the tail. Takes the root of the list and goes
- *   to the end of the list and appends the node.
+ *   to the end of the list and appends the node. If the root has an attached header
+ *   the header is updated and the list is not walked.
  *
  * PARAMETERS
  *
@@ -323,6 +336,10 @@ node_str *osaka_addnodetotail(node_str *r,node_str *n)  {
     assert(n!=NULL);
     assert(r!=NULL);
 
+    if (LIST(r)!=NULL) {
+        return osaka_list_addnodetotail(LIST(r),n);
+    }
+
     tail=osaka_findtailnode(r);
 
     NEXT(tail)=n;
@@ -341,7 +358,8 @@ node_str *osaka_addnodetotail(node_str *r,node_str *n)  {
  * DESCRIPTION
  *
  *   This function adds a single node to the head. Takes the root of the list and
- *   appends the new node to the head of the list.
+ *   appends the new node to the head of the list. An attached header moves to the
+ *   new head.
  *
  * PARAMETERS
  *
@@ -367,6 +385,10 @@ node_str *osaka_addnodetohead(node_str *r,node_str *n)  {
     assert(n!=NULL);
     assert(r!=NULL);
 
+    if (LIST(r)!=NULL) {
+        return osaka_list_addnodetohead(LIST(r),n);
+    }
+
     LAST(r)=n;
     NEXT(n)=r;
     LAST(n)=NULL; // makes it only a node addition
@@ -731,6 +753,7 @@ void osaka_postfix_mapto(node_str *n,void (*fun)(node_str *n))  {
  * DESCRIPTION
  *
  *  osaka_listlength takes a list and returns the length. Return zero if list has no nodes.
+ *  The length of a root with an attached header is read from the header.
  *
  * PARAMETERS
  *
@@ -754,6 +777,10 @@ uint32_t osaka_listlength(node_str *r)  {
 
     uint32_t i = 0;
 
+    if (r!=NULL && LIST(r)!=NULL) {
+        return OSAKA_LIST_LENGTH(LIST(r));
+    }
+
     while (r!=NULL) {
         r = NEXT(r);
         i++;
@@ -795,9 +822,14 @@ void osaka_freenode(node_str *n)  {
 
     assert(n!=NULL);
 
-    object_table_function[OBJECT_TYPE(n)].osaka_deleteobject(OBJECT(n));
+    // placeholder nodes such as the one osaka_deserialize starts from
+    // never had an object created for them
+    if (OBJECT_TYPE(n)!=NOTSET) {
+        object_table_function[OBJECT_TYPE(n)].osaka_deleteobject(OBJECT(n));
+    }
 
     free(n);
+    INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_FREES, 1);
 
 }
 
@@ -826,7 +858,8 @@ void osaka_freenode(node_str *n)  {
  * SIDE-EFFECT
  *
  *  side-effect are that the node is updated
- *  by changing the values in the object
+ *  by changing the values in the object, and the
+ *  hash cached in the node is invalidated
  *
  */
 
@@ -840,6 +873,132 @@ void osaka_randomizenode(node_str *n) {
     }
 
     object_table_function[OBJECT_TYPE(n)].osaka_randomizeobject(OBJECT(n));
+    HASH_VALID(n)=false;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_randomizenodes
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes all the parameters of the objects of many nodes. Runs of
+ *  nodes whose type has a batch kernel are randomized up to OSAKA_BATCH
+ *  objects per call from the given generator, a batch is flushed as soon
+ *  as the kernel changes so it never mixes types. Other types fall back
+ *  to osaka_randomizenode one node at a time
+ *
+ * PARAMETERS
+ *
+ *  node_str **nodes - nodes to randomize
+ *  uint32_t count - number of nodes
+ *  uint64_t *state - random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_randomizenodes(batch, 64, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the values in the objects, invalidates the cached hashes
+ *  and advances the state
+ *
+ */
+
+void osaka_randomizenodes(node_str **nodes, uint32_t count, uint64_t *state) {
+
+    void *objects[OSAKA_BATCH];
+    void (*pending)(void **, uint32_t, uint64_t *) = NULL;
+    uint32_t batched = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+
+        node_str *n = nodes[i];
+
+        if (n == NULL)  {
+            printf ("error: cannot randomize a NULL node [file:\'%s\',line:%d]\n",__FILE__,__LINE__);
+            exit(0);
+        }
+
+        void (*randomizebatch)(void **, uint32_t, uint64_t *) = object_table_function[OBJECT_TYPE(n)].osaka_randomizebatch;
+
+        // flush a full batch, or one queued for another kernel
+        if (batched > 0 && (randomizebatch != pending || batched == OSAKA_BATCH)) {
+            pending(objects, batched, state);
+            batched = 0;
+        }
+
+        if (randomizebatch == NULL) {
+            osaka_randomizenode(n);
+            continue;
+        }
+
+        pending = randomizebatch;
+        objects[batched++] = OBJECT(n);
+        HASH_VALID(n)=false;
+
+    }
+
+    if (batched > 0) {
+        pending(objects, batched, state);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_mutatenode
+ *
+ * DESCRIPTION
+ *
+ *  Changes one parameter of the object of a node, drawn with the mutate
+ *  kernel of its type. The kernel of a type with no smaller change than a
+ *  new object redraws the whole object from the state, a type without a
+ *  kernel is randomized with rand() instead
+ *
+ * PARAMETERS
+ *
+ *  node_str *n - node to mutate
+ *  uint64_t *state - random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_mutatenode(n, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the object, invalidates the cached hash and advances the state
+ *
+ */
+
+void osaka_mutatenode(node_str *n, uint64_t *state) {
+
+    if (n == NULL)  {
+        printf ("error: cannot mutate a NULL node [file:\'%s\',line:%d]\n",__FILE__,__LINE__);
+        exit(0);
+    }
+
+    void *object = OBJECT(n);
+    void (*mutatebatch)(void **, uint32_t, uint64_t *) = object_table_function[OBJECT_TYPE(n)].osaka_mutatebatch;
+
+    if (mutatebatch == NULL) {
+        osaka_randomizenode(n);
+        return;
+    }
+
+    mutatebatch(&object, 1, state);
+    HASH_VALID(n)=false;
 
 }
 
@@ -891,7 +1050,8 @@ uint32_t osaka_fitness(node_str *n) {
  *
  * DESCRIPTION
  *
- *  osaka_nthnode return nth node in the list.
+ *  osaka_nthnode return nth node in the list. If the root has an attached header
+ *  the lookup goes through its skip index, see osaka_list_nthnode.
  *
  * PARAMETERS
  *
@@ -917,6 +1077,10 @@ node_str *osaka_nthnode(node_str *r,uint32_t nth) {
     assert(r!=NULL);
     assert(nth!=0);
 
+    if (LIST(r)!=NULL) {
+        return osaka_list_nthnode(LIST(r),nth);
+    }
+
     while(r!=NULL)  {
         --nth;
         if (nth==0) {
@@ -936,7 +1100,8 @@ node_str *osaka_nthnode(node_str *r,uint32_t nth) {
  *
  * DESCRIPTION
  *
- *  osaka_deletenode deletes a node from a list
+ *  osaka_deletenode deletes a node from a list. If the list has an attached header
+ *  the header is updated, and released once the last node is deleted.
  *
  * PARAMETERS
  *
@@ -959,9 +1124,22 @@ node_str *osaka_nthnode(node_str *r,uint32_t nth) {
 node_str *osaka_deletenode(node_str *n) {
 
     node_str *t,*l;
+    osaka_list_str *header;
 
     assert(n!=NULL);
 
+    // a list with an attached header is edited through it, the header
+    // is released along with the last node
+    header=LIST(osaka_findheadnode(n));
+
+    if (header!=NULL) {
+        t=osaka_list_deletenode(header,n);
+        if (t==NULL) {
+            osaka_list_detach(header);
+        }
+        return t;
+    }
+
     switch(osaka_whatisnode(n)) {
         case EMPTY:
             return NULL;
@@ -1001,6 +1179,104 @@ node_str *osaka_deletenode(node_str *n) {
 
 }
 
+/*
+ * NAME
+ *
+ *  osaka_swaptails
+ *
+ * DESCRIPTION
+ *
+ *  Swaps the tails of two lists from the nth node onwards, so that the
+ *  nth node of r0 becomes the nth node of r1 and the other way around.
+ *  This is the splice used by crossover. The headers attached to either
+ *  root are updated, their skip indexes are swapped over the exchanged
+ *  strides rather than rebuilt.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r0 - root anchor of the first list
+ *  node_str *r1 - root anchor of the second list
+ *  uint32_t nth - first node to swap, counted from 1, must be at least 2
+ *                 and no longer than either list
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_swaptails(parent1,parent2,5);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if nth is 1, the roots are left in place
+ *
+ */
+
+void osaka_swaptails(node_str *r0,node_str *r1,uint32_t nth) {
+
+    osaka_list_str *l0,*l1;
+    node_str *n0,*n1,*o0,*o1,*t0,*t1,*swap;
+    uint32_t len0,len1,k,last;
+
+    assert(r0!=NULL);
+    assert(r1!=NULL);
+    assert(nth>1);
+
+    l0=LIST(r0);
+    l1=LIST(r1);
+    len0=osaka_listlength(r0);
+    len1=osaka_listlength(r1);
+    t0=osaka_findtailnode(r0);
+    t1=osaka_findtailnode(r1);
+
+    n0=osaka_nthnode(r0,nth);
+    n1=osaka_nthnode(r1,nth);
+
+    assert(n0!=NULL && n1!=NULL);
+
+    // swap is implemented by changing the "last" and "next" pointers
+    // starting with the "next" pointers of the last nodes
+    o0=LAST(n0);
+    o1=LAST(n1);
+    NEXT(o0)=n1;
+    NEXT(o1)=n0;
+    LAST(n0)=o1;
+    LAST(n1)=o0;
+
+    if (l0!=NULL) {
+        OSAKA_LIST_TAIL(l0)=t1;
+        OSAKA_LIST_LENGTH(l0)=len1;
+    }
+
+    if (l1!=NULL) {
+        OSAKA_LIST_TAIL(l1)=t0;
+        OSAKA_LIST_LENGTH(l1)=len0;
+    }
+
+    // the strides starting at or after the nth node moved with the tails,
+    // the ones before it did not, so only the former are exchanged
+    if (l0!=NULL && l1!=NULL && l0->index_valid && l1->index_valid &&
+        (len1-1)/OSAKA_LIST_STRIDE<l0->index_capacity &&
+        (len0-1)/OSAKA_LIST_STRIDE<l1->index_capacity) {
+        last=((len0>len1?len0:len1)-1)/OSAKA_LIST_STRIDE;
+        for (k=(nth+OSAKA_LIST_STRIDE-2)/OSAKA_LIST_STRIDE; k<=last; k++) {
+            swap=l0->index[k];
+            l0->index[k]=l1->index[k];
+            l1->index[k]=swap;
+        }
+    }
+    else {
+        if (l0!=NULL) {
+            l0->index_valid=false;
+        }
+        if (l1!=NULL) {
+            l1->index_valid=false;
+        }
+    }
+
+}
+
 
 /*
  * NAME
@@ -1095,12 +1371,14 @@ uint32_t osaka_serialize(node_str *r,char *filepath)  {
 
 node_str *osaka_deserialize(char *filepath) {
 
-    node_str *root=NULL,*tmp;
+    node_str *tmp;
+    osaka_list_str list;
     FILE *handle;
 
     assert(filepath!=NULL);
 
-    root=osaka_createnode(root,TAIL,NOTSET); // this will be discarded
+    osaka_list_init(&list,NULL);
+    osaka_list_createnode(&list,TAIL,NOTSET); // this will be discarded
 
     handle=fopen(filepath,"rb");
 
@@ -1112,6 +1390,7 @@ node_str *osaka_deserialize(char *filepath) {
     while(!feof(handle))  {
         tmp = __osaka_createnode(NOTSET);
         fread(tmp,sizeof(node_str),1,handle);
+        LIST(tmp)=NULL; // the header pointer of the writer is meaningless here
 
         if(OBJECT_TYPE(tmp)!=NOTSET)  {
             if(OBJECT_TYPE(tmp)>=0 && OBJECT_TYPE(tmp)<MAXTYPE) {
@@ -1123,18 +1402,18 @@ node_str *osaka_deserialize(char *filepath) {
             }
         }
         
-        root=osaka_addnodetotail(root,tmp);
+        osaka_list_addnodetotail(&list,tmp);
     }
 
-    //printf ("debug: pre list length %d\n",osaka_listlength(root));
+    //printf ("debug: pre list length %d\n",OSAKA_LIST_LENGTH((&list)));
 
-    root=osaka_deletenode(root);
-    root=osaka_deletenode(osaka_findtailnode(root));
+    osaka_list_deletenode(&list,OSAKA_LIST_HEAD((&list)));
+    osaka_list_deletenode(&list,OSAKA_LIST_TAIL((&list)));
 
-    //printf ("debug: post list length %d\n",osaka_listlength(root));
+    //printf ("debug: post list length %d\n",OSAKA_LIST_LENGTH((&list)));
 
     fclose(handle);
-    return root;
+    return osaka_list_detach(&list);
 
 }
 
@@ -1185,227 +1464,499 @@ bool osaka_compare(node_str *n0, node_str *n1)  {
 /*
  * NAME
  *
- *  osaka_consistencyofnode  
+ *  osaka_hashnode
  *
  * DESCRIPTION
  *
- * 
+ *  Returns the hash of the object held by a node, computed with the
+ *  osaka_hashobject hook of its type. The hash is cached in the node and
+ *  only recomputed after osaka_randomizenode has changed the object, so
+ *  hashing an individual after a mutation only rehashes the mutated
+ *  genes.
  *
  * PARAMETERS
  *
- *  node_str *n
+ *  node_str *n - node to be hashed
  *
  * RETURN
  *
+ *  uint64_t - hash of the object, 0 for a NOTSET node
  *
  * EXAMPLE
  *
+ *  h = osaka_hashnode(n);
  *
  * SIDE-EFFECT
  *
+ *  caches the hash in the node
  *
  */
 
-bool osaka_consistencyofnode(node_str *n) {
+uint64_t osaka_hashnode(node_str *n) {
 
-    switch(osaka_whatisnode(n)) {
-        case EMPTY: 
-            return true; 
-            break;
-        case ISOLATE: 
-            return true; 
-            break;
-        case HEADNODE:
-            if (LAST(n)==NULL && NEXT(n)!=NULL && LAST(NEXT(n))==n) {
-                return true;
-            }
-            return false;
-            break;
-        case TAILNODE:  
-            if (NEXT(n)==NULL && LAST(n)!=NULL && NEXT(LAST(n))==n) {
-                return true;
-            }
-            return false;
-            break;
-        case INTERMEDIATE:
-            if (NEXT(LAST(n))==n && LAST(NEXT(n))==n) {
-                return true;
-            }
-            return false;
-            break;
-        default:
-            printf("error: node type not recognised file:\'%s\' line: %d\n",__FILE__,__LINE__);
-            exit(EXIT_SUCCESS);
-            break;
+    assert(n!=NULL);
+
+    if (OBJECT_TYPE(n)==NOTSET) {
+        return 0;
     }
-    
-    return false;
+
+    if (!HASH_VALID(n)) {
+        HASH(n)=hash_combine(OBJECT_TYPE(n),object_table_function[OBJECT_TYPE(n)].osaka_hashobject(OBJECT(n)));
+        HASH_VALID(n)=true;
+    }
+
+    return HASH(n);
 
 }
-    
+
 /*
  * NAME
  *
- *  osaka_consistencycheck
- *  
+ *  osaka_hash
+ *
  * DESCRIPTION
  *
- * 
+ *  Hashes a whole list. The gene hashes are combined in order with a
+ *  polynomial rolling hash, h = h * OSAKA_HASH_BASE + gene, starting from
+ *  OSAKA_HASH_SEED, so that the hash of a list is the last of its prefix
+ *  hashes (see osaka_prefixhashes). Two lists with equal contents hash to
+ *  the same value whatever their node uids are.
  *
  * PARAMETERS
  *
+ *  node_str *r - root anchor for the list, may be NULL
  *
  * RETURN
  *
+ *  uint64_t - hash of the list
  *
  * EXAMPLE
  *
+ *  if (osaka_hash(r0)==osaka_hash(r1) && osaka_equal(r0,r1)) ...
  *
  * SIDE-EFFECT
  *
+ *  caches gene hashes in the nodes
  *
  */
-   
-bool osaka_consistencycheck(node_str *r)  {
 
-    global_nth=0;
-    return recurse_applytonode(r,osaka_consistencyofnode);
+uint64_t osaka_hash(node_str *r) {
+
+    uint64_t h=OSAKA_HASH_SEED;
+
+    while (r!=NULL) {
+        h=h*OSAKA_HASH_BASE+osaka_hashnode(r);
+        r=NEXT(r);
+    }
+
+    return h;
 
 }
 
 /*
  * NAME
  *
- *  osaka_copylist
- *  
+ *  osaka_hashupdate
+ *
  * DESCRIPTION
  *
- *  Constructs a replica of a list and returns a return to the replicated 
- *  list.
+ *  Updates the hash of a list after the gene at position nth (counting
+ *  from 1) has changed, without walking the list. Because the list hash
+ *  is polynomial the old gene's term can be swapped for the new one in
+ *  O(log length).
  *
  * PARAMETERS
  *
- *  node_str *
+ *  uint64_t h - hash of the list before the change
+ *  uint32_t length - length of the list
+ *  uint32_t nth - position of the changed gene
+ *  uint64_t old_gene - osaka_hashnode of the gene before the change
+ *  uint64_t new_gene - osaka_hashnode of the gene after the change
  *
  * RETURN
  *
- *  node_str *
+ *  uint64_t - hash of the list after the change
  *
  * EXAMPLE
  *
- *  new=osaka_copylist(r0);
+ *  old = osaka_hashnode(n);
+ *  osaka_randomizenode(n);
+ *  h = osaka_hashupdate(h, len, 5, old, osaka_hashnode(n));
  *
  * SIDE-EFFECT
  *
- *  Allocates memory for the data structure. 
+ *  none...
  *
  */
 
-node_str *osaka_copylist(node_str *r) {
+uint64_t osaka_hashupdate(uint64_t h,uint32_t length,uint32_t nth,uint64_t old_gene,uint64_t new_gene) {
 
-    node_str *c=NULL,*cr=NULL,*nc=NULL;
-    
-    while(r!=NULL)  {
-        c=malloc(sizeof(node_str));
-        assert(c!=NULL);
-        memcpy(c,r,sizeof(node_str));
+    uint64_t weight=1,base=OSAKA_HASH_BASE;
+    uint32_t e;
 
-        if (nc==NULL) {
-            nc=cr=c;
-            NEXT(c)=NULL;
-            LAST(c)=NULL;
-        }
-        else  {
-            NEXT(nc)=c;
-            LAST(c)=nc;
-            NEXT(c)=NULL;
-            nc=c;
-        }
-          
-        if (OBJECT_TYPE(r)!=NOTSET) {
-            OBJECT(c)=object_table_function[OBJECT_TYPE(r)].osaka_copyobject(OBJECT(r));
-        }
+    assert(nth!=0 && nth<=length);
 
-        r=NEXT(r);
+    // weight = OSAKA_HASH_BASE^(length-nth), by squaring
+    for (e=length-nth; e!=0; e>>=1) {
+        if (e&1) {
+            weight*=base;
+        }
+        base*=base;
     }
 
-    return cr; // return the new root;
+    return h+(new_gene-old_gene)*weight;
 
 }
 
 /*
  * NAME
  *
- *  osaka_innerfree  
+ *  osaka_prefixhashes
  *
  * DESCRIPTION
  *
- *  This function frees a payload object memory. Designed to be used as 
- *  conjection with the osaka_outerfree() function call.
+ *  Fills hashes[k] with the hash of the first k+1 genes of a list, for up
+ *  to max genes. Two lists share their first k+1 genes exactly when their
+ *  hashes[k] agree (barring collisions), so the longest shared prefix of
+ *  two lists can be found by comparing (or binary searching) their prefix
+ *  hashes.
  *
  * PARAMETERS
  *
- *  node_str * - root 
+ *  node_str *r - root anchor for the list
+ *  uint64_t *hashes - array of at least max entries
+ *  uint32_t max - maximum number of prefix hashes to compute
  *
  * RETURN
  *
- *  none...
+ *  uint32_t - number of prefix hashes written, min(max, length)
  *
  * EXAMPLE
  *
- *  osaka_postfix_mapto(n,xosaka_outerfree); // free list
+ *  n = osaka_prefixhashes(r, hashes, len);
  *
  * SIDE-EFFECT
  *
- *  frees a single node.
+ *  fills hashes and caches gene hashes in the nodes
  *
  */
 
-void xosaka_innerfree(node_str *n)  {
+uint32_t osaka_prefixhashes(node_str *r,uint64_t *hashes,uint32_t max) {
 
-    assert(OBJECT(n)!=NULL); // node cannot be set and have no point to object
-    free(OBJECT(n));
+    uint64_t h=OSAKA_HASH_SEED;
+    uint32_t i=0;
+
+    assert(hashes!=NULL || max==0);
+
+    while (r!=NULL && i<max) {
+        h=h*OSAKA_HASH_BASE+osaka_hashnode(r);
+        hashes[i++]=h;
+        r=NEXT(r);
+    }
+
+    return i;
 
 }
-   
+
 /*
  * NAME
  *
- *  osaka_freelist  
+ *  osaka_equal
  *
  * DESCRIPTION
  *
- *  This function frees a single node of memory. Designed to be used as 
- *  part of a recursive function call.
+ *  Compares two lists by contents. Unlike osaka_compare, which compares
+ *  types and uids, this is true when both lists hold equal objects in the
+ *  same order. Cached gene hashes are compared first so that most unequal
+ *  genes are rejected without calling osaka_equalobject.
  *
  * PARAMETERS
  *
- *  node_str * - root 
+ *  node_str *n0 - root anchor for the first list
+ *  node_str *n1 - root anchor for the second list
  *
  * RETURN
  *
- *  none...
+ *  bool - true if the lists hold equal genes in the same order
  *
  * EXAMPLE
  *
- *  osaka_postfix_mapto(n,xosaka_outerfree); // free list
+ *  are_equal = osaka_equal(r0, r1);
  *
  * SIDE-EFFECT
  *
- *  frees a single node.
+ *  caches gene hashes in the nodes
  *
  */
 
-void xosaka_outerfree(node_str *n)  {
-  
-    if(n==NULL) return;
-    
-    if(OBJECT_TYPE(n)!=NOTSET)
-    xosaka_innerfree(n);
-
-    free(n);
+bool osaka_equal(node_str *n0,node_str *n1) {
 
-}
+    while (n0!=NULL && n1!=NULL) {
+        if (n0!=n1) {
+            if (OBJECT_TYPE(n0)!=OBJECT_TYPE(n1) || osaka_hashnode(n0)!=osaka_hashnode(n1)) {
+                return false;
+            }
+            if (OBJECT_TYPE(n0)!=NOTSET && !object_table_function[OBJECT_TYPE(n0)].osaka_equalobject(OBJECT(n0),OBJECT(n1))) {
+                return false;
+            }
+        }
+
+        n0=NEXT(n0);
+        n1=NEXT(n1);
+    }
+
+    return n0==NULL && n1==NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_consistencyofnode  
+ *
+ * DESCRIPTION
+ *
+ * 
+ *
+ * PARAMETERS
+ *
+ *  node_str *n
+ *
+ * RETURN
+ *
+ *
+ * EXAMPLE
+ *
+ *
+ * SIDE-EFFECT
+ *
+ *
+ */
+
+bool osaka_consistencyofnode(node_str *n) {
+
+    switch(osaka_whatisnode(n)) {
+        case EMPTY: 
+            return true; 
+            break;
+        case ISOLATE: 
+            return LIST(n)==NULL || OSAKA_LIST_HEAD(LIST(n))==n;
+            break;
+        case HEADNODE:
+            if (LAST(n)==NULL && NEXT(n)!=NULL && LAST(NEXT(n))==n &&
+                (LIST(n)==NULL || OSAKA_LIST_HEAD(LIST(n))==n)) {
+                return true;
+            }
+            return false;
+            break;
+        case TAILNODE:  
+            if (NEXT(n)==NULL && LAST(n)!=NULL && NEXT(LAST(n))==n && LIST(n)==NULL) {
+                return true;
+            }
+            return false;
+            break;
+        case INTERMEDIATE:
+            if (NEXT(LAST(n))==n && LAST(NEXT(n))==n && LIST(n)==NULL) {
+                return true;
+            }
+            return false;
+            break;
+        default:
+            printf("error: node type not recognised file:\'%s\' line: %d\n",__FILE__,__LINE__);
+            exit(EXIT_SUCCESS);
+            break;
+    }
+    
+    return false;
+
+}
+    
+/*
+ * NAME
+ *
+ *  osaka_consistencycheck
+ *  
+ * DESCRIPTION
+ *
+ *  Checks that every node of a list is consistent with its neighbours,
+ *  and that the header attached to the root, if any, agrees with the list.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r - root anchor for the list
+ *
+ * RETURN
+ *
+ *  bool - true if the list and its header are consistent
+ *
+ * EXAMPLE
+ *
+ *  assert(osaka_consistencycheck(root));
+ *
+ * SIDE-EFFECT
+ *
+ *  none...
+ *
+ */
+   
+bool osaka_consistencycheck(node_str *r)  {
+
+    if (r!=NULL && LIST(r)!=NULL && !osaka_list_consistencycheck(LIST(r))) {
+        return false;
+    }
+
+    global_nth=0;
+    return recurse_applytonode(r,osaka_consistencyofnode);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_copylist
+ *  
+ * DESCRIPTION
+ *
+ *  Constructs a replica of a list and returns a return to the replicated 
+ *  list. If the list has an attached header the replica gets one as well.
+ *
+ * PARAMETERS
+ *
+ *  node_str *
+ *
+ * RETURN
+ *
+ *  node_str *
+ *
+ * EXAMPLE
+ *
+ *  new=osaka_copylist(r0);
+ *
+ * SIDE-EFFECT
+ *
+ *  Allocates memory for the data structure. 
+ *
+ */
+
+node_str *osaka_copylist(node_str *r) {
+
+    node_str *c=NULL,*cr=NULL,*nc=NULL;
+    osaka_list_str *header=r!=NULL?LIST(r):NULL,l;
+    
+    while(r!=NULL)  {
+        c=malloc(sizeof(node_str));
+        assert(c!=NULL);
+        INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_ALLOCS, 1);
+        INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_BYTES, sizeof(node_str));
+        memcpy(c,r,sizeof(node_str));
+        LIST(c)=NULL;
+
+        if (nc==NULL) {
+            nc=cr=c;
+            NEXT(c)=NULL;
+            LAST(c)=NULL;
+        }
+        else  {
+            NEXT(nc)=c;
+            LAST(c)=nc;
+            NEXT(c)=NULL;
+            nc=c;
+        }
+          
+        if (OBJECT_TYPE(r)!=NOTSET) {
+            OBJECT(c)=object_table_function[OBJECT_TYPE(r)].osaka_copyobject(OBJECT(r));
+        }
+
+        r=NEXT(r);
+    }
+
+    // the replica gets its own header, the skip index is rebuilt on demand
+    if (header!=NULL) {
+        osaka_list_init(&l,NULL);
+        OSAKA_LIST_HEAD((&l))=cr;
+        OSAKA_LIST_TAIL((&l))=nc;
+        OSAKA_LIST_LENGTH((&l))=OSAKA_LIST_LENGTH(header);
+        return osaka_list_attach(&l);
+    }
+
+    return cr; // return the new root;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_innerfree  
+ *
+ * DESCRIPTION
+ *
+ *  This function frees a payload object memory. Designed to be used as 
+ *  conjection with the osaka_outerfree() function call.
+ *
+ * PARAMETERS
+ *
+ *  node_str * - root 
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_postfix_mapto(n,xosaka_outerfree); // free list
+ *
+ * SIDE-EFFECT
+ *
+ *  frees a single node.
+ *
+ */
+
+void xosaka_innerfree(node_str *n)  {
+
+    assert(OBJECT(n)!=NULL); // node cannot be set and have no point to object
+    free(OBJECT(n));
+
+}
+   
+/*
+ * NAME
+ *
+ *  osaka_freelist  
+ *
+ * DESCRIPTION
+ *
+ *  This function frees a single node of memory. Designed to be used as 
+ *  part of a recursive function call.
+ *
+ * PARAMETERS
+ *
+ *  node_str * - root 
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_postfix_mapto(n,xosaka_outerfree); // free list
+ *
+ * SIDE-EFFECT
+ *
+ *  frees a single node.
+ *
+ */
+
+void xosaka_outerfree(node_str *n)  {
+  
+    if(n==NULL) return;
+    
+    if(OBJECT_TYPE(n)!=NOTSET)
+    xosaka_innerfree(n);
+
+    free(n);
+    INSTRUMENT_COUNT(INSTRUMENT_COUNTER_NODE_FREES, 1);
+
+}
 
 /*
  * NAME
@@ -1414,7 +1965,8 @@ void xosaka_outerfree(node_str *n)  {
  *
  * DESCRIPTION
  *
- *  This function recursively frees the nodes of a list. 
+ *  This function recursively frees the nodes of a list, and the header
+ *  attached to the root if there is one.
  *
  * PARAMETERS
  *
@@ -1436,12 +1988,686 @@ void xosaka_outerfree(node_str *n)  {
 
 node_str *osaka_freelist(node_str *r) {
 
+    if (r!=NULL && LIST(r)!=NULL) {
+        osaka_list_free(LIST(r)); // releases the header as well
+        return NULL;
+    }
+
     osaka_postfix_mapto(r,xosaka_outerfree); // free list
 
     return NULL;
 
 }
 
+/*
+ * NAME
+ *
+ *  osaka_list_init
+ *
+ * DESCRIPTION
+ *
+ *  Initializes a list header for an existing list, or for an empty list
+ *  when r is NULL. The header keeps the head, tail and length of the list
+ *  so that the osaka_list_* functions do not have to walk it. Walks the
+ *  list once.
+ *
+ *  A header on the stack is only kept up to date by the osaka_list_*
+ *  functions, if the list is edited with the node level functions the
+ *  header has to be initialized again. A header handed to
+ *  osaka_list_attach is linked from the head node and is kept up to date
+ *  by the node level functions as well.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - header to be initialized
+ *  node_str *r - root anchor for the list, may be NULL
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_list_init(&list, root);
+ *
+ * SIDE-EFFECT
+ *
+ *  the header is overwritten, any index it held is not released
+ *
+ */
+
+void osaka_list_init(osaka_list_str *l,node_str *r) {
+
+    assert(l!=NULL);
+    assert(r==NULL || LIST(r)==NULL); // an attached list already has its header
+
+    OSAKA_LIST_HEAD(l)=r;
+    OSAKA_LIST_TAIL(l)=NULL;
+    OSAKA_LIST_LENGTH(l)=0;
+    l->index=NULL;
+    l->index_capacity=0;
+    l->index_valid=false;
+    l->attached=false;
+
+    while (r!=NULL) {
+        OSAKA_LIST_TAIL(l)=r;
+        OSAKA_LIST_LENGTH(l)++;
+        r=NEXT(r);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_list_rebuildindex
+ *
+ * DESCRIPTION
+ *
+ *  Internal function which rebuilds the skip index of a list header. The
+ *  index holds every OSAKA_LIST_STRIDE-th node, starting with the head.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  __osaka_list_rebuildindex(l);
+ *
+ * SIDE-EFFECT
+ *
+ *  may grow the index memory
+ *
+ */
+
+void __osaka_list_rebuildindex(osaka_list_str *l) {
+
+    node_str *n;
+    uint32_t needed,i;
+
+    needed=OSAKA_LIST_LENGTH(l)/OSAKA_LIST_STRIDE+1;
+
+    if (needed>l->index_capacity) {
+        l->index=realloc(l->index,sizeof(node_str *)*needed*2);
+        if (l->index==NULL) {
+            printf ("error: failed to alloc memory for list index [file:\'%s\',line:%d]\n",__FILE__,__LINE__);
+            exit(0);
+        }
+        l->index_capacity=needed*2;
+    }
+
+    n=OSAKA_LIST_HEAD(l);
+
+    for (i=0; n!=NULL; i++) {
+        if (i%OSAKA_LIST_STRIDE==0) {
+            l->index[i/OSAKA_LIST_STRIDE]=n;
+        }
+        n=NEXT(n);
+    }
+
+    l->index_valid=true;
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_list_sethead
+ *
+ * DESCRIPTION
+ *
+ *  Internal function which moves the head of a list header. An attached
+ *  header is unlinked from the old head node and linked from the new one.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - new head, may be NULL
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  __osaka_list_sethead(l,NEXT(n));
+ *
+ * SIDE-EFFECT
+ *
+ *  none...
+ *
+ */
+
+void __osaka_list_sethead(osaka_list_str *l,node_str *n) {
+
+    if (l->attached) {
+        if (OSAKA_LIST_HEAD(l)!=NULL) {
+            LIST(OSAKA_LIST_HEAD(l))=NULL;
+        }
+        if (n!=NULL) {
+            LIST(n)=l;
+        }
+    }
+
+    OSAKA_LIST_HEAD(l)=n;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_addnodetotail
+ *
+ * DESCRIPTION
+ *
+ *  Adds a single node to the tail of the list held by a header. Unlike
+ *  osaka_addnodetotail the tail is known, so this does not walk the list.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_addnodetotail(&list,new_node);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the new node is NULL, a valid index is extended rather than
+ *  invalidated
+ *
+ */
+
+node_str *osaka_list_addnodetotail(osaka_list_str *l,node_str *n) {
+
+    assert(l!=NULL);
+    assert(n!=NULL);
+
+    NEXT(n)=NULL; // makes it only a node addition
+    LAST(n)=OSAKA_LIST_TAIL(l);
+
+    if (OSAKA_LIST_TAIL(l)==NULL) {
+        __osaka_list_sethead(l,n);
+    }
+    else {
+        NEXT(OSAKA_LIST_TAIL(l))=n;
+    }
+
+    OSAKA_LIST_TAIL(l)=n;
+
+    // appending does not move any existing node, so the index stays valid
+    // as long as there is room for the new node when it starts a stride
+    if (l->index_valid && OSAKA_LIST_LENGTH(l)%OSAKA_LIST_STRIDE==0) {
+        if (OSAKA_LIST_LENGTH(l)/OSAKA_LIST_STRIDE<l->index_capacity) {
+            l->index[OSAKA_LIST_LENGTH(l)/OSAKA_LIST_STRIDE]=n;
+        }
+        else {
+            l->index_valid=false;
+        }
+    }
+
+    OSAKA_LIST_LENGTH(l)++;
+
+    return OSAKA_LIST_HEAD(l);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_addnodetohead
+ *
+ * DESCRIPTION
+ *
+ *  Adds a single node to the head of the list held by a header.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, which is the new node
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_addnodetohead(&list,new_node);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the new node is NULL, invalidates the index
+ *
+ */
+
+node_str *osaka_list_addnodetohead(osaka_list_str *l,node_str *n) {
+
+    assert(l!=NULL);
+    assert(n!=NULL);
+
+    LAST(n)=NULL; // makes it only a node addition
+    NEXT(n)=OSAKA_LIST_HEAD(l);
+
+    if (OSAKA_LIST_HEAD(l)==NULL) {
+        OSAKA_LIST_TAIL(l)=n;
+    }
+    else {
+        LAST(OSAKA_LIST_HEAD(l))=n;
+    }
+
+    __osaka_list_sethead(l,n);
+    OSAKA_LIST_LENGTH(l)++;
+    l->index_valid=false;
+
+    return n;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_createnode
+ *
+ * DESCRIPTION
+ *
+ *  Creates a node holding a new object of the given type and places it at
+ *  either the head or the tail of the list held by a header.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  append_typ app_ty - HEAD or TAIL
+ *  osaka_object_typ ot - object type of the new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_createnode(&list,TAIL,SIMPLE);
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the list and the header
+ *
+ */
+
+node_str *osaka_list_createnode(osaka_list_str *l,append_typ app_ty,osaka_object_typ ot) {
+
+    node_str *n;
+
+    n = __osaka_createnode(ot);
+
+    if (app_ty==HEAD) {
+        return osaka_list_addnodetohead(l,n);
+    }
+
+    return osaka_list_addnodetotail(l,n);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_deletenode
+ *
+ * DESCRIPTION
+ *
+ *  Unlinks a node from the list held by a header and frees it. The header
+ *  gives the new head and tail directly, so unlike osaka_deletenode this
+ *  does not walk back to the head.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - node to be deleted, must be in the list
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, NULL once the list is empty
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_deletenode(&list,n);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees the node and its object, invalidates the index
+ *
+ */
+
+node_str *osaka_list_deletenode(osaka_list_str *l,node_str *n) {
+
+    assert(l!=NULL);
+    assert(n!=NULL);
+    assert(OSAKA_LIST_LENGTH(l)>0);
+
+    if (LAST(n)==NULL) {
+        __osaka_list_sethead(l,NEXT(n));
+    }
+    else {
+        NEXT(LAST(n))=NEXT(n);
+    }
+
+    if (NEXT(n)==NULL) {
+        OSAKA_LIST_TAIL(l)=LAST(n);
+    }
+    else {
+        LAST(NEXT(n))=LAST(n);
+    }
+
+    OSAKA_LIST_LENGTH(l)--;
+    l->index_valid=false;
+
+    osaka_freenode(n);
+
+    return OSAKA_LIST_HEAD(l);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_nthnode
+ *
+ * DESCRIPTION
+ *
+ *  Returns the nth node of the list held by a header, counting from 1 as
+ *  osaka_nthnode does. The skip index is rebuilt first if a mutator has
+ *  invalidated it, after which a lookup walks at most OSAKA_LIST_STRIDE
+ *  nodes.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  uint32_t nth - nth node
+ *
+ * RETURN
+ *
+ *  node_str * - nth node, NULL if nth is past the tail
+ *
+ * EXAMPLE
+ *
+ *  n = osaka_list_nthnode(&list,500);
+ *
+ * SIDE-EFFECT
+ *
+ *  may rebuild the index
+ *
+ */
+
+node_str *osaka_list_nthnode(osaka_list_str *l,uint32_t nth) {
+
+    node_str *n;
+    uint32_t i;
+
+    assert(l!=NULL);
+    assert(nth!=0);
+
+    if (nth>OSAKA_LIST_LENGTH(l)) {
+        return NULL;
+    }
+
+    if (nth==OSAKA_LIST_LENGTH(l)) {
+        return OSAKA_LIST_TAIL(l);
+    }
+
+    if (!l->index_valid) {
+        __osaka_list_rebuildindex(l);
+    }
+
+    n=l->index[(nth-1)/OSAKA_LIST_STRIDE];
+
+    for (i=(nth-1)%OSAKA_LIST_STRIDE; i>0; i--) {
+        n=NEXT(n);
+    }
+
+    return n;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_consistencycheck
+ *
+ * DESCRIPTION
+ *
+ *  Checks that every node of the list is consistent with its neighbours
+ *  and that the head, tail, length and (when valid) skip index held by
+ *  the header agree with the list itself. Walks the list iteratively.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  bool - true if the header and list are consistent
+ *
+ * EXAMPLE
+ *
+ *  assert(osaka_list_consistencycheck(&list));
+ *
+ * SIDE-EFFECT
+ *
+ *  none...
+ *
+ */
+
+bool osaka_list_consistencycheck(osaka_list_str *l) {
+
+    node_str *n,*last=NULL;
+    uint32_t i=0;
+
+    assert(l!=NULL);
+
+    if (OSAKA_LIST_HEAD(l)!=NULL && LAST(OSAKA_LIST_HEAD(l))!=NULL) {
+        return false;
+    }
+
+    // only an attached header is linked from the head, and it never outlives the list
+    if (OSAKA_LIST_HEAD(l)!=NULL ? LIST(OSAKA_LIST_HEAD(l))!=(l->attached?l:NULL) : l->attached) {
+        return false;
+    }
+
+    for (n=OSAKA_LIST_HEAD(l); n!=NULL; n=NEXT(n)) {
+        if (!osaka_consistencyofnode(n) || LAST(n)!=last) {
+            return false;
+        }
+        if (l->index_valid && i%OSAKA_LIST_STRIDE==0 && l->index[i/OSAKA_LIST_STRIDE]!=n) {
+            return false;
+        }
+        last=n;
+        i++;
+    }
+
+    return OSAKA_LIST_TAIL(l)==last && OSAKA_LIST_LENGTH(l)==i;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees every node of the list held by a header, along with their
+ *  objects and the skip index, and leaves the header empty. An attached
+ *  header is freed as well.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_list_free(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees every node in the list
+ *
+ */
+
+void osaka_list_free(osaka_list_str *l) {
+
+    node_str *n,*t;
+
+    assert(l!=NULL);
+
+    n=OSAKA_LIST_HEAD(l);
+
+    while (n!=NULL) {
+        t=NEXT(n);
+        osaka_freenode(n);
+        n=t;
+    }
+
+    free(l->index);
+
+    if (l->attached) {
+        free(l);
+        return;
+    }
+
+    osaka_list_init(l,NULL);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_detach
+ *
+ * DESCRIPTION
+ *
+ *  Releases the skip index of a list header and hands back the list
+ *  itself, which is left untouched. Used once a list has been built or
+ *  edited through its header and is handed on as a plain root anchor.
+ *  An attached header is unlinked from the head node and freed.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_detach(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees the index and leaves the header empty
+ *
+ */
+
+node_str *osaka_list_detach(osaka_list_str *l) {
+
+    node_str *r;
+
+    assert(l!=NULL);
+
+    r=OSAKA_LIST_HEAD(l);
+
+    free(l->index);
+
+    if (l->attached) {
+        if (r!=NULL) {
+            LIST(r)=NULL;
+        }
+        free(l);
+        return r;
+    }
+
+    osaka_list_init(l,NULL);
+
+    return r;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_list_attach
+ *
+ * DESCRIPTION
+ *
+ *  Moves a list header built on the stack to the heap and links it from
+ *  the head node, then hands back the list as a plain root anchor. From
+ *  then on the node level osaka_* functions keep the header up to date,
+ *  so osaka_listlength, osaka_findtailnode, osaka_addnodetotail and
+ *  osaka_nthnode no longer walk the list. The header is released by
+ *  osaka_freelist, or by deleting the last node.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header, not attached yet
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, NULL if the list is empty
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_attach(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the attached header and leaves l empty
+ *
+ */
+
+node_str *osaka_list_attach(osaka_list_str *l) {
+
+    osaka_list_str *a;
+    node_str *r;
+
+    assert(l!=NULL);
+    assert(!l->attached);
+
+    r=OSAKA_LIST_HEAD(l);
+
+    if (r==NULL) {
+        return osaka_list_detach(l);
+    }
+
+    a=malloc(sizeof(osaka_list_str));
+
+    if (a==NULL) {
+        printf ("error: failed to alloc memory for osaka_list_str [file:\'%s\',line:%d]\n",__FILE__,__LINE__);
+        exit(0);
+    }
+
+    memcpy(a,l,sizeof(osaka_list_str));
+    a->attached=true;
+    LIST(r)=a;
+
+    osaka_list_init(l,NULL); // the index now belongs to the attached header
+
+    return r;
+
+}
+
 /*
  * NAME
  *
@@ -46,9 +46,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <assert.h>
+#include <stdatomic.h>
 
 #include "../module/modules.h"
 #include "../support/utility.h"
+#include "../support/instrument.h"
 
 /*
  * DATATYPES
@@ -84,8 +86,21 @@ typedef struct node_str {
     struct node_str *next_ptr;
     struct node_str *last_link;
     struct node_str *next_link;
+    uint64_t hash;
+    bool hash_valid;
+    struct osaka_list_str *list; // header attached to a head node, NULL otherwise
 } node_str;
 
+typedef struct osaka_list_str {
+    node_str *head;
+    node_str *tail;
+    uint32_t length;
+    node_str **index;
+    uint32_t index_capacity;
+    bool index_valid;
+    bool attached; // allocated by osaka_list_attach and linked from the head node
+} osaka_list_str;
+
 /*
  * MACROS
  */
@@ -97,6 +112,25 @@ typedef struct node_str {
 #define OBJECT(s) s->object_ptr
 #define OBJECT_TYPE(s) s->objtype
 #define UID(s) s->uid
+#define HASH(s) s->hash
+#define HASH_VALID(s) s->hash_valid
+#define LIST(s) s->list
+
+// seed and multiplier of the polynomial rolling hash used by osaka_hash,
+// the multiplier is odd so it is invertible modulo 2^64
+#define OSAKA_HASH_SEED 0x243f6a8885a308d3ULL
+#define OSAKA_HASH_BASE 0x100000001b3ULL
+
+#define OSAKA_LIST_HEAD(l) l->head
+#define OSAKA_LIST_TAIL(l) l->tail
+#define OSAKA_LIST_LENGTH(l) l->length
+
+// every OSAKA_LIST_STRIDE-th node is kept in the skip index of an
+// osaka_list_str, so osaka_list_nthnode walks at most this many nodes
+#define OSAKA_LIST_STRIDE 32
+
+// objects handed to a batch kernel per call by osaka_randomizenodes
+#define OSAKA_BATCH 64
 
 #define DEBUG(s)  if (debug) printf(s);
 
@@ -181,7 +215,8 @@ osaka_node_typ osaka_whatisnode(node_str *n);
  * DESCRIPTION
  *
  *  This function finds the tail node of the OLS. When the tail is found 
- *  the pointer is returned of the tail node.  
+ *  the pointer is returned of the tail node. A root with an attached
+ *  header gives the tail without walking the list.
  *
  * PARAMETERS
  *
@@ -240,7 +275,8 @@ node_str *osaka_findheadnode(node_str *n);
  * DESCRIPTION
  *
  *   This function adds a single node to the tail. Takes the root of the list and goes
- *   to the end of the list and appends the node.
+ *   to the end of the list and appends the node. If the root has an attached header
+ *   the header is updated and the list is not walked.
  *
  * PARAMETERS
  *
@@ -271,7 +307,8 @@ node_str *osaka_addnodetotail(node_str *r,node_str *n);
  * DESCRIPTION
  *
  *   This function adds a single node to the head. Takes the root of the list and
- *   appends the new node to the head of the list.
+ *   appends the new node to the head of the list. An attached header moves to the
+ *   new head.
  *
  * PARAMETERS
  *
@@ -542,6 +579,7 @@ void osaka_postfix_mapto(node_str *n,void (*fun)(node_str *n));
  * DESCRIPTION
  *
  *  osaka_listlength takes a list and returns the length. Return zero if list has no nodes.
+ *  The length of a root with an attached header is read from the header.
  *
  * PARAMETERS
  *
@@ -624,6 +662,75 @@ void osaka_freenode(node_str *n);
 
 void osaka_randomizenode(node_str *n);
 
+/*
+ * NAME
+ *
+ *  osaka_randomizenodes
+ *
+ * DESCRIPTION
+ *
+ *  Randomizes all the parameters of the objects of many nodes. Runs of
+ *  nodes whose type has a batch kernel are randomized up to OSAKA_BATCH
+ *  objects per call from the given generator, a batch is flushed as soon
+ *  as the kernel changes so it never mixes types. Other types fall back
+ *  to osaka_randomizenode one node at a time
+ *
+ * PARAMETERS
+ *
+ *  node_str **nodes - nodes to randomize
+ *  uint32_t count - number of nodes
+ *  uint64_t *state - random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_randomizenodes(batch, 64, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the values in the objects, invalidates the cached hashes
+ *  and advances the state
+ *
+ */
+
+void osaka_randomizenodes(node_str **nodes, uint32_t count, uint64_t *state);
+
+/*
+ * NAME
+ *
+ *  osaka_mutatenode
+ *
+ * DESCRIPTION
+ *
+ *  Changes one parameter of the object of a node, drawn with the mutate
+ *  kernel of its type. The kernel of a type with no smaller change than a
+ *  new object redraws the whole object from the state, a type without a
+ *  kernel is randomized with rand() instead
+ *
+ * PARAMETERS
+ *
+ *  node_str *n - node to mutate
+ *  uint64_t *state - random state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_mutatenode(n, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the object, invalidates the cached hash and advances the state
+ *
+ */
+
+void osaka_mutatenode(node_str *n, uint64_t *state);
+
 /*
  * NAME
  *
@@ -662,7 +769,8 @@ uint32_t osaka_fitness(node_str *n);
  *
  * DESCRIPTION
  *
- *  osaka_nthnode return nth node in the list.
+ *  osaka_nthnode return nth node in the list. If the root has an attached header
+ *  the lookup goes through its skip index, see osaka_list_nthnode.
  *
  * PARAMETERS
  *
@@ -692,7 +800,8 @@ node_str *osaka_nthnode(node_str *r,uint32_t nth);
  *
  * DESCRIPTION
  *
- *  osaka_deletenode deletes a node from a list
+ *  osaka_deletenode deletes a node from a list. If the list has an attached header
+ *  the header is updated, and released once the last node is deleted.
  *
  * PARAMETERS
  *
@@ -714,6 +823,42 @@ node_str *osaka_nthnode(node_str *r,uint32_t nth);
 
 node_str *osaka_deletenode(node_str *n);
 
+/*
+ * NAME
+ *
+ *  osaka_swaptails
+ *
+ * DESCRIPTION
+ *
+ *  Swaps the tails of two lists from the nth node onwards, so that the
+ *  nth node of r0 becomes the nth node of r1 and the other way around.
+ *  This is the splice used by crossover. The headers attached to either
+ *  root are updated, their skip indexes are swapped over the exchanged
+ *  strides rather than rebuilt.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r0 - root anchor of the first list
+ *  node_str *r1 - root anchor of the second list
+ *  uint32_t nth - first node to swap, counted from 1, must be at least 2
+ *                 and no longer than either list
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_swaptails(parent1,parent2,5);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if nth is 1, the roots are left in place
+ *
+ */
+
+void osaka_swaptails(node_str *r0,node_str *r1,uint32_t nth);
+
 /*
  * NAME
  *
@@ -788,6 +933,178 @@ node_str *osaka_deserialize(char *filepath);
  */
 
 bool osaka_compare(node_str *n0, node_str *n1);
+
+/*
+ * NAME
+ *
+ *  osaka_hashnode
+ *
+ * DESCRIPTION
+ *
+ *  Returns the hash of the object held by a node, computed with the
+ *  osaka_hashobject hook of its type. The hash is cached in the node and
+ *  only recomputed after osaka_randomizenode has changed the object, so
+ *  hashing an individual after a mutation only rehashes the mutated
+ *  genes.
+ *
+ * PARAMETERS
+ *
+ *  node_str *n - node to be hashed
+ *
+ * RETURN
+ *
+ *  uint64_t - hash of the object, 0 for a NOTSET node
+ *
+ * EXAMPLE
+ *
+ *  h = osaka_hashnode(n);
+ *
+ * SIDE-EFFECT
+ *
+ *  caches the hash in the node
+ *
+ */
+
+uint64_t osaka_hashnode(node_str *n);
+
+/*
+ * NAME
+ *
+ *  osaka_hash
+ *
+ * DESCRIPTION
+ *
+ *  Hashes a whole list. The gene hashes are combined in order with a
+ *  polynomial rolling hash, h = h * OSAKA_HASH_BASE + gene, starting from
+ *  OSAKA_HASH_SEED, so that the hash of a list is the last of its prefix
+ *  hashes (see osaka_prefixhashes). Two lists with equal contents hash to
+ *  the same value whatever their node uids are.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r - root anchor for the list, may be NULL
+ *
+ * RETURN
+ *
+ *  uint64_t - hash of the list
+ *
+ * EXAMPLE
+ *
+ *  if (osaka_hash(r0)==osaka_hash(r1) && osaka_equal(r0,r1)) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  caches gene hashes in the nodes
+ *
+ */
+
+uint64_t osaka_hash(node_str *r);
+
+/*
+ * NAME
+ *
+ *  osaka_hashupdate
+ *
+ * DESCRIPTION
+ *
+ *  Updates the hash of a list after the gene at position nth (counting
+ *  from 1) has changed, without walking the list. Because the list hash
+ *  is polynomial the old gene's term can be swapped for the new one in
+ *  O(log length).
+ *
+ * PARAMETERS
+ *
+ *  uint64_t h - hash of the list before the change
+ *  uint32_t length - length of the list
+ *  uint32_t nth - position of the changed gene
+ *  uint64_t old_gene - osaka_hashnode of the gene before the change
+ *  uint64_t new_gene - osaka_hashnode of the gene after the change
+ *
+ * RETURN
+ *
+ *  uint64_t - hash of the list after the change
+ *
+ * EXAMPLE
+ *
+ *  old = osaka_hashnode(n);
+ *  osaka_randomizenode(n);
+ *  h = osaka_hashupdate(h, len, 5, old, osaka_hashnode(n));
+ *
+ * SIDE-EFFECT
+ *
+ *  none...
+ *
+ */
+
+uint64_t osaka_hashupdate(uint64_t h,uint32_t length,uint32_t nth,uint64_t old_gene,uint64_t new_gene);
+
+/*
+ * NAME
+ *
+ *  osaka_prefixhashes
+ *
+ * DESCRIPTION
+ *
+ *  Fills hashes[k] with the hash of the first k+1 genes of a list, for up
+ *  to max genes. Two lists share their first k+1 genes exactly when their
+ *  hashes[k] agree (barring collisions), so the longest shared prefix of
+ *  two lists can be found by comparing (or binary searching) their prefix
+ *  hashes.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r - root anchor for the list
+ *  uint64_t *hashes - array of at least max entries
+ *  uint32_t max - maximum number of prefix hashes to compute
+ *
+ * RETURN
+ *
+ *  uint32_t - number of prefix hashes written, min(max, length)
+ *
+ * EXAMPLE
+ *
+ *  n = osaka_prefixhashes(r, hashes, len);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills hashes and caches gene hashes in the nodes
+ *
+ */
+
+uint32_t osaka_prefixhashes(node_str *r,uint64_t *hashes,uint32_t max);
+
+/*
+ * NAME
+ *
+ *  osaka_equal
+ *
+ * DESCRIPTION
+ *
+ *  Compares two lists by contents. Unlike osaka_compare, which compares
+ *  types and uids, this is true when both lists hold equal objects in the
+ *  same order. Cached gene hashes are compared first so that most unequal
+ *  genes are rejected without calling osaka_equalobject.
+ *
+ * PARAMETERS
+ *
+ *  node_str *n0 - root anchor for the first list
+ *  node_str *n1 - root anchor for the second list
+ *
+ * RETURN
+ *
+ *  bool - true if the lists hold equal genes in the same order
+ *
+ * EXAMPLE
+ *
+ *  are_equal = osaka_equal(r0, r1);
+ *
+ * SIDE-EFFECT
+ *
+ *  caches gene hashes in the nodes
+ *
+ */
+
+bool osaka_equal(node_str *n0,node_str *n1);
     
 /*
  * NAME
@@ -796,19 +1113,24 @@ bool osaka_compare(node_str *n0, node_str *n1);
  *  
  * DESCRIPTION
  *
- * 
+ *  Checks that every node of a list is consistent with its neighbours,
+ *  and that the header attached to the root, if any, agrees with the list.
  *
  * PARAMETERS
  *
+ *  node_str *r - root anchor for the list
  *
  * RETURN
  *
+ *  bool - true if the list and its header are consistent
  *
  * EXAMPLE
  *
+ *  assert(osaka_consistencycheck(root));
  *
  * SIDE-EFFECT
  *
+ *  none...
  *
  */
    
@@ -822,7 +1144,7 @@ bool osaka_consistencycheck(node_str *r);
  * DESCRIPTION
  *
  *  Constructs a replica of a list and returns a return to the replicated 
- *  list.
+ *  list. If the list has an attached header the replica gets one as well.
  *
  * PARAMETERS
  *
@@ -851,7 +1173,8 @@ node_str *osaka_copylist(node_str *r);
  *
  * DESCRIPTION
  *
- *  This function recursively frees the nodes of a list. 
+ *  This function recursively frees the nodes of a list, and the header
+ *  attached to the root if there is one.
  *
  * PARAMETERS
  *
@@ -873,6 +1196,332 @@ node_str *osaka_copylist(node_str *r);
 
 node_str *osaka_freelist(node_str *r);
 
+/*
+ * NAME
+ *
+ *  osaka_list_init
+ *
+ * DESCRIPTION
+ *
+ *  Initializes a list header for an existing list, or for an empty list
+ *  when r is NULL. The header keeps the head, tail and length of the list
+ *  so that the osaka_list_* functions do not have to walk it. Walks the
+ *  list once.
+ *
+ *  A header on the stack is only kept up to date by the osaka_list_*
+ *  functions, if the list is edited with the node level functions the
+ *  header has to be initialized again. A header handed to
+ *  osaka_list_attach is linked from the head node and is kept up to date
+ *  by the node level functions as well.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - header to be initialized
+ *  node_str *r - root anchor for the list, may be NULL
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_list_init(&list, root);
+ *
+ * SIDE-EFFECT
+ *
+ *  the header is overwritten, any index it held is not released
+ *
+ */
+
+void osaka_list_init(osaka_list_str *l,node_str *r);
+
+/*
+ * NAME
+ *
+ *  osaka_list_addnodetotail
+ *
+ * DESCRIPTION
+ *
+ *  Adds a single node to the tail of the list held by a header. Unlike
+ *  osaka_addnodetotail the tail is known, so this does not walk the list.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_addnodetotail(&list,new_node);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the new node is NULL, a valid index is extended rather than
+ *  invalidated
+ *
+ */
+
+node_str *osaka_list_addnodetotail(osaka_list_str *l,node_str *n);
+
+/*
+ * NAME
+ *
+ *  osaka_list_addnodetohead
+ *
+ * DESCRIPTION
+ *
+ *  Adds a single node to the head of the list held by a header.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, which is the new node
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_addnodetohead(&list,new_node);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts if the new node is NULL, invalidates the index
+ *
+ */
+
+node_str *osaka_list_addnodetohead(osaka_list_str *l,node_str *n);
+
+/*
+ * NAME
+ *
+ *  osaka_list_createnode
+ *
+ * DESCRIPTION
+ *
+ *  Creates a node holding a new object of the given type and places it at
+ *  either the head or the tail of the list held by a header.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  append_typ app_ty - HEAD or TAIL
+ *  osaka_object_typ ot - object type of the new node
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_createnode(&list,TAIL,SIMPLE);
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the list and the header
+ *
+ */
+
+node_str *osaka_list_createnode(osaka_list_str *l,append_typ app_ty,osaka_object_typ ot);
+
+/*
+ * NAME
+ *
+ *  osaka_list_deletenode
+ *
+ * DESCRIPTION
+ *
+ *  Unlinks a node from the list held by a header and frees it. The header
+ *  gives the new head and tail directly, so unlike osaka_deletenode this
+ *  does not walk back to the head.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  node_str *n - node to be deleted, must be in the list
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, NULL once the list is empty
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_deletenode(&list,n);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees the node and its object, invalidates the index
+ *
+ */
+
+node_str *osaka_list_deletenode(osaka_list_str *l,node_str *n);
+
+/*
+ * NAME
+ *
+ *  osaka_list_nthnode
+ *
+ * DESCRIPTION
+ *
+ *  Returns the nth node of the list held by a header, counting from 1 as
+ *  osaka_nthnode does. The skip index is rebuilt first if a mutator has
+ *  invalidated it, after which a lookup walks at most OSAKA_LIST_STRIDE
+ *  nodes.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *  uint32_t nth - nth node
+ *
+ * RETURN
+ *
+ *  node_str * - nth node, NULL if nth is past the tail
+ *
+ * EXAMPLE
+ *
+ *  n = osaka_list_nthnode(&list,500);
+ *
+ * SIDE-EFFECT
+ *
+ *  may rebuild the index
+ *
+ */
+
+node_str *osaka_list_nthnode(osaka_list_str *l,uint32_t nth);
+
+/*
+ * NAME
+ *
+ *  osaka_list_consistencycheck
+ *
+ * DESCRIPTION
+ *
+ *  Checks that every node of the list is consistent with its neighbours
+ *  and that the head, tail, length and (when valid) skip index held by
+ *  the header agree with the list itself. Walks the list iteratively.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  bool - true if the header and list are consistent
+ *
+ * EXAMPLE
+ *
+ *  assert(osaka_list_consistencycheck(&list));
+ *
+ * SIDE-EFFECT
+ *
+ *  none...
+ *
+ */
+
+bool osaka_list_consistencycheck(osaka_list_str *l);
+
+/*
+ * NAME
+ *
+ *  osaka_list_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees every node of the list held by a header, along with their
+ *  objects and the skip index, and leaves the header empty. An attached
+ *  header is freed as well.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  none...
+ *
+ * EXAMPLE
+ *
+ *  osaka_list_free(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees every node in the list
+ *
+ */
+
+void osaka_list_free(osaka_list_str *l);
+
+/*
+ * NAME
+ *
+ *  osaka_list_detach
+ *
+ * DESCRIPTION
+ *
+ *  Releases the skip index of a list header and hands back the list
+ *  itself, which is left untouched. Used once a list has been built or
+ *  edited through its header and is handed on as a plain root anchor.
+ *  An attached header is unlinked from the head node and freed.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_detach(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees the index and leaves the header empty
+ *
+ */
+
+node_str *osaka_list_detach(osaka_list_str *l);
+
+/*
+ * NAME
+ *
+ *  osaka_list_attach
+ *
+ * DESCRIPTION
+ *
+ *  Moves a list header built on the stack to the heap and links it from
+ *  the head node, then hands back the list as a plain root anchor. From
+ *  then on the node level osaka_* functions keep the header up to date,
+ *  so osaka_listlength, osaka_findtailnode, osaka_addnodetotail and
+ *  osaka_nthnode no longer walk the list. The header is released by
+ *  osaka_freelist, or by deleting the last node.
+ *
+ * PARAMETERS
+ *
+ *  osaka_list_str *l - list header, not attached yet
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the list, NULL if the list is empty
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_list_attach(&list);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the attached header and leaves l empty
+ *
+ */
+
+node_str *osaka_list_attach(osaka_list_str *l);
+
 /*
  * NAME
  *
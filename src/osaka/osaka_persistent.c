@@ -0,0 +1,787 @@
+/*
+ ============================================================================
+ Name        : osaka_persistent.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Persistent (immutable, structurally shared) representation
+               of an individual. The genes of an individual live in
+               reference counted segments that are never modified once
+               created, and an individual is an ordered set of views
+               into those segments. Crossover builds children out of
+               views into the parents' segments and mutation only
+               allocates a new one gene segment, so neither operator
+               needs to deep copy the parents first.
+ ============================================================================
+ */
+
+/*
+ * IMPORT ...
+ */
+
+#include "osaka_persistent.h"
+#include <string.h>
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *  __osaka_segment_create
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that allocates a segment able to hold length
+ *  objects of the given type. The objects are left for the caller to
+ *  fill in.
+ *
+ * PARAMETERS
+ *
+ *  uint32_t length - number of genes in the segment
+ *  osaka_object_typ ot - object type of the genes
+ *
+ * RETURN
+ *
+ *  segment_str * - new segment with a refcount of 1
+ *
+ * EXAMPLE
+ *
+ *  s = __osaka_segment_create(10, LLVM_PASS);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory
+ *
+ */
+
+segment_str *__osaka_segment_create(uint32_t length, osaka_object_typ ot) {
+
+    segment_str *s;
+
+    s = malloc(sizeof(segment_str));
+
+    if (s == NULL) {
+        printf("error: failed to alloc memory for segment_str [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    s->refcount = 1;
+    s->length = length;
+    s->objtype = ot;
+    s->objects = malloc(sizeof(void *) * (length > 0 ? length : 1));
+
+    if (s->objects == NULL) {
+        printf("error: failed to alloc memory for segment objects [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    return s;
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_segment_release
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that drops a reference to a segment, deleting the
+ *  objects it owns once nobody references it anymore.
+ *
+ * PARAMETERS
+ *
+ *  segment_str *s - segment to release
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __osaka_segment_release(view->segment);
+ *
+ * SIDE-EFFECT
+ *
+ *  may free the segment and its objects
+ *
+ */
+
+void __osaka_segment_release(segment_str *s) {
+
+    assert(s != NULL);
+    assert(s->refcount > 0);
+
+    if (--s->refcount > 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < s->length; i++) {
+        object_table_function[s->objtype].osaka_deleteobject(s->objects[i]);
+    }
+
+    free(s->objects);
+    free(s);
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_persistent_create
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that allocates an empty persistent individual with
+ *  room for num_views views.
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot - object type of the genes
+ *  uint32_t num_views - number of views to make room for
+ *
+ * RETURN
+ *
+ *  persistent_str * - new individual with a refcount of 1
+ *
+ * EXAMPLE
+ *
+ *  p = __osaka_persistent_create(LLVM_PASS, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory
+ *
+ */
+
+persistent_str *__osaka_persistent_create(osaka_object_typ ot, uint32_t num_views) {
+
+    persistent_str *p;
+
+    p = malloc(sizeof(persistent_str));
+
+    if (p == NULL) {
+        printf("error: failed to alloc memory for persistent_str [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    p->refcount = 1;
+    p->length = 0;
+    p->objtype = ot;
+    p->num_views = 0;
+    p->views = malloc(sizeof(segment_view_str) * (num_views > 0 ? num_views : 1));
+
+    if (p->views == NULL) {
+        printf("error: failed to alloc memory for persistent views [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    return p;
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_persistent_addview
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that appends a view to an individual under
+ *  construction, taking a reference on the viewed segment. Empty views
+ *  are skipped and views that continue the previous view in the same
+ *  segment are merged into it.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - individual under construction
+ *  segment_str *s - segment being viewed
+ *  uint32_t offset - first gene of the view within s
+ *  uint32_t length - number of genes in the view
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __osaka_persistent_addview(child, v->segment, v->offset, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  updates p and the segment refcount
+ *
+ */
+
+void __osaka_persistent_addview(persistent_str *p, segment_str *s, uint32_t offset, uint32_t length) {
+
+    if (length == 0) {
+        return;
+    }
+
+    if (p->num_views > 0) {
+        segment_view_str *last = &p->views[p->num_views - 1];
+        if (last->segment == s && last->offset + last->length == offset) {
+            last->length += length;
+            p->length += length;
+            return;
+        }
+    }
+
+    s->refcount++;
+
+    p->views[p->num_views].segment = s;
+    p->views[p->num_views].offset = offset;
+    p->views[p->num_views].length = length;
+    p->num_views++;
+    p->length += length;
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_persistent_addrange
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that appends the genes of src in the half open
+ *  range [from, to), counted from 0, to an individual under construction
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - individual under construction
+ *  persistent_str *src - individual the genes are shared from
+ *  uint32_t from - first gene, inclusive
+ *  uint32_t to - last gene, exclusive
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __osaka_persistent_addrange(child, parent, 0, 4);
+ *
+ * SIDE-EFFECT
+ *
+ *  updates p and the segment refcounts
+ *
+ */
+
+void __osaka_persistent_addrange(persistent_str *p, persistent_str *src, uint32_t from, uint32_t to) {
+
+    uint32_t start = 0;
+
+    for (uint32_t v = 0; v < src->num_views && start < to; v++) {
+
+        segment_view_str *view = &src->views[v];
+        uint32_t end = start + view->length;
+
+        if (end > from) {
+            uint32_t lo = from > start ? from - start : 0;
+            uint32_t hi = to < end ? to - start : view->length;
+            __osaka_persistent_addview(p, view->segment, view->offset + lo, hi - lo);
+        }
+
+        start = end;
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *  __osaka_persistent_flatten
+ *
+ * DESCRIPTION
+ *
+ *  Internal function that replaces the views of an individual with a
+ *  single freshly copied segment. Used once an individual has been
+ *  through enough operators to be split into too many views.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - individual to flatten
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  if (p->num_views > PERSISTENT_MAX_VIEWS) __osaka_persistent_flatten(p);
+ *
+ * SIDE-EFFECT
+ *
+ *  copies every object of p and releases the old segments
+ *
+ */
+
+void __osaka_persistent_flatten(persistent_str *p) {
+
+    segment_str *s = __osaka_segment_create(p->length, p->objtype);
+    uint32_t k = 0;
+
+    for (uint32_t v = 0; v < p->num_views; v++) {
+        segment_view_str *view = &p->views[v];
+        for (uint32_t i = 0; i < view->length; i++) {
+            s->objects[k++] = object_table_function[p->objtype].osaka_copyobject(view->segment->objects[view->offset + i]);
+        }
+        __osaka_segment_release(view->segment);
+    }
+
+    p->num_views = 1;
+    p->views[0].segment = s;
+    p->views[0].offset = 0;
+    p->views[0].length = p->length;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_fromlist
+ *
+ * DESCRIPTION
+ *
+ *  Builds a persistent individual from an osaka list. Every object in
+ *  the list is copied into a single new segment, the list itself is
+ *  left untouched.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r - root anchor for the list
+ *
+ * RETURN
+ *
+ *  persistent_str * - new persistent individual with a refcount of 1
+ *
+ * EXAMPLE
+ *
+ *  p = osaka_persistent_fromlist(root);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with osaka_persistent_release
+ *
+ */
+
+persistent_str *osaka_persistent_fromlist(node_str *r) {
+
+    assert(r != NULL);
+    assert(OBJECT_TYPE(r) >= 0 && OBJECT_TYPE(r) < MAXTYPE);
+
+    uint32_t length = osaka_listlength(r);
+    persistent_str *p = __osaka_persistent_create(OBJECT_TYPE(r), 1);
+    segment_str *s = __osaka_segment_create(length, OBJECT_TYPE(r));
+
+    for (uint32_t i = 0; i < length; i++) {
+        s->objects[i] = object_table_function[OBJECT_TYPE(r)].osaka_copyobject(OBJECT(r));
+        r = NEXT(r);
+    }
+
+    __osaka_persistent_addview(p, s, 0, length);
+
+    // the view holds the only reference we want to keep
+    __osaka_segment_release(s);
+
+    return p;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_tolist
+ *
+ * DESCRIPTION
+ *
+ *  Materializes a persistent individual as a regular osaka list,
+ *  copying every object so that the list can be edited freely.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the new list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_persistent_tolist(p);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory for the list
+ *
+ */
+
+node_str *osaka_persistent_tolist(persistent_str *p) {
+
+    osaka_list_str list;
+
+    assert(p != NULL);
+
+    osaka_list_init(&list, NULL);
+
+    for (uint32_t v = 0; v < p->num_views; v++) {
+
+        segment_view_str *view = &p->views[v];
+
+        for (uint32_t i = 0; i < view->length; i++) {
+
+            // the node is created untyped so that no throwaway object is built
+            node_str *n = osaka_createnode(NULL, TAIL, NOTSET);
+            OBJECT_TYPE(n) = p->objtype;
+            OBJECT(n) = object_table_function[p->objtype].osaka_copyobject(view->segment->objects[view->offset + i]);
+
+            osaka_list_addnodetotail(&list, n);
+
+        }
+
+    }
+
+    return osaka_list_attach(&list);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_retain
+ *
+ * DESCRIPTION
+ *
+ *  Takes another reference to a persistent individual. Because the
+ *  individual is immutable, this is how it is copied.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  persistent_str * - the same individual
+ *
+ * EXAMPLE
+ *
+ *  next_gen[i] = osaka_persistent_retain(curr_gen[i]);
+ *
+ * SIDE-EFFECT
+ *
+ *  increments the refcount
+ *
+ */
+
+persistent_str *osaka_persistent_retain(persistent_str *p) {
+
+    assert(p != NULL);
+    p->refcount++;
+
+    return p;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_release
+ *
+ * DESCRIPTION
+ *
+ *  Drops a reference to a persistent individual. When the last
+ *  reference goes away the views are dropped, and any segment that is
+ *  no longer referenced frees its objects.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_persistent_release(p);
+ *
+ * SIDE-EFFECT
+ *
+ *  may free the individual, its segments and their objects
+ *
+ */
+
+void osaka_persistent_release(persistent_str *p) {
+
+    if (p == NULL) {
+        return;
+    }
+
+    assert(p->refcount > 0);
+
+    if (--p->refcount > 0) {
+        return;
+    }
+
+    for (uint32_t v = 0; v < p->num_views; v++) {
+        __osaka_segment_release(p->views[v].segment);
+    }
+
+    free(p->views);
+    free(p);
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_nthobject
+ *
+ * DESCRIPTION
+ *
+ *  Returns the object held by the nth gene of a persistent individual.
+ *  Counting starts at 1 to match osaka_nthnode. The object is shared
+ *  and must not be modified.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *  uint32_t nth - position of the gene
+ *
+ * RETURN
+ *
+ *  void * - the object, NULL if nth is out of range
+ *
+ * EXAMPLE
+ *
+ *  o = osaka_persistent_nthobject(p, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void *osaka_persistent_nthobject(persistent_str *p, uint32_t nth) {
+
+    assert(p != NULL);
+    assert(nth != 0);
+
+    nth--;
+
+    for (uint32_t v = 0; v < p->num_views; v++) {
+        segment_view_str *view = &p->views[v];
+        if (nth < view->length) {
+            return view->segment->objects[view->offset + nth];
+        }
+        nth -= view->length;
+    }
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_crossover
+ *
+ * DESCRIPTION
+ *
+ *  One point crossover of two persistent individuals. The first child
+ *  is the head of p1 up to (not including) the nth gene followed by the
+ *  tail of p2 from the nth gene, the second child is the opposite. Both
+ *  children share their segments with the parents, so no objects are
+ *  copied and the parents are left unchanged.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p1 - first parent
+ *  persistent_str *p2 - second parent
+ *  uint32_t nth - crossover point, 1 < nth <= shortest length
+ *  persistent_str **c1 - receives the first child
+ *  persistent_str **c2 - receives the second child
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_persistent_crossover(p1, p2, 4, &c1, &c2);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the two children and takes references on shared segments
+ *
+ */
+
+void osaka_persistent_crossover(persistent_str *p1, persistent_str *p2, uint32_t nth, persistent_str **c1, persistent_str **c2) {
+
+    assert(p1 != NULL && p2 != NULL);
+    assert(p1->objtype == p2->objtype);
+    assert(nth > 1 && nth <= p1->length && nth <= p2->length);
+
+    // the split can cut one view of each parent in two, hence the + 2
+    uint32_t max_views = p1->num_views + p2->num_views + 2;
+
+    persistent_str *child1 = __osaka_persistent_create(p1->objtype, max_views);
+    persistent_str *child2 = __osaka_persistent_create(p1->objtype, max_views);
+
+    __osaka_persistent_addrange(child1, p1, 0, nth - 1);
+    __osaka_persistent_addrange(child1, p2, nth - 1, p2->length);
+
+    __osaka_persistent_addrange(child2, p2, 0, nth - 1);
+    __osaka_persistent_addrange(child2, p1, nth - 1, p1->length);
+
+    if (child1->num_views > PERSISTENT_MAX_VIEWS) {
+        __osaka_persistent_flatten(child1);
+    }
+    if (child2->num_views > PERSISTENT_MAX_VIEWS) {
+        __osaka_persistent_flatten(child2);
+    }
+
+    *c1 = child1;
+    *c2 = child2;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_mutate
+ *
+ * DESCRIPTION
+ *
+ *  Returns a new individual that is p with all parameters of the nth
+ *  gene randomized. Only the mutated gene is copied, into a new one gene
+ *  segment, everything else is shared with p.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - individual to be mutated, left unchanged
+ *  uint32_t nth - position of the gene to mutate, starting at 1
+ *
+ * RETURN
+ *
+ *  persistent_str * - the mutated individual
+ *
+ * EXAMPLE
+ *
+ *  child = osaka_persistent_mutate(parent, 5);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the new individual and its new segment
+ *
+ */
+
+persistent_str *osaka_persistent_mutate(persistent_str *p, uint32_t nth) {
+
+    assert(p != NULL);
+    assert(nth > 0 && nth <= p->length);
+
+    // the gene is copied and then randomized so that any state that is
+    // not rerolled by randomizeobject (valid values, ...) carries over
+    segment_str *s = __osaka_segment_create(1, p->objtype);
+    s->objects[0] = object_table_function[p->objtype].osaka_copyobject(osaka_persistent_nthobject(p, nth));
+    object_table_function[p->objtype].osaka_randomizeobject(s->objects[0]);
+
+    persistent_str *child = __osaka_persistent_create(p->objtype, p->num_views + 2);
+
+    __osaka_persistent_addrange(child, p, 0, nth - 1);
+    __osaka_persistent_addview(child, s, 0, 1);
+    __osaka_persistent_addrange(child, p, nth, p->length);
+
+    __osaka_segment_release(s);
+
+    if (child->num_views > PERSISTENT_MAX_VIEWS) {
+        __osaka_persistent_flatten(child);
+    }
+
+    return child;
+
+}
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_consistencycheck
+ *
+ * DESCRIPTION
+ *
+ *  Verifies that the views of a persistent individual are in range of
+ *  their segments, add up to the recorded length and only reference
+ *  live segments of the right type.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  bool - true if the individual is consistent
+ *
+ * EXAMPLE
+ *
+ *  assert(osaka_persistent_consistencycheck(p));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool osaka_persistent_consistencycheck(persistent_str *p) {
+
+    uint32_t length = 0;
+
+    if (p == NULL || p->refcount == 0) {
+        return false;
+    }
+
+    for (uint32_t v = 0; v < p->num_views; v++) {
+
+        segment_view_str *view = &p->views[v];
+
+        if (view->segment == NULL || view->segment->refcount == 0) {
+            return false;
+        }
+        if (view->segment->objtype != p->objtype) {
+            return false;
+        }
+        if (view->length == 0 || view->offset + view->length > view->segment->length) {
+            return false;
+        }
+
+        length += view->length;
+
+    }
+
+    return length == p->length;
+
+}
@@ -0,0 +1,341 @@
+/*
+ ============================================================================
+ Name        : osaka_persistent.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Persistent (immutable, structurally shared) representation
+               of an individual. The genes of an individual live in
+               reference counted segments that are never modified once
+               created, and an individual is an ordered set of views
+               into those segments. Crossover builds children out of
+               views into the parents' segments and mutation only
+               allocates a new one gene segment, so neither operator
+               needs to deep copy the parents first.
+ ============================================================================
+ */
+
+#ifndef OSAKA_OSAKA_PERSISTENT_H_
+#define OSAKA_OSAKA_PERSISTENT_H_
+
+/*
+ * IMPORT
+ */
+
+#include "osaka.h"
+
+/*
+ * DATATYPES
+ */
+
+typedef struct segment_str {
+    uint32_t refcount;
+    uint32_t length;
+    osaka_object_typ objtype;
+    void **objects;
+} segment_str;
+
+typedef struct segment_view_str {
+    segment_str *segment;
+    uint32_t offset;
+    uint32_t length;
+} segment_view_str;
+
+typedef struct persistent_str {
+    uint32_t refcount;
+    uint32_t length;
+    osaka_object_typ objtype;
+    uint32_t num_views;
+    segment_view_str *views;
+} persistent_str;
+
+/*
+ * MACROS
+ */
+
+// once an individual is made of more views than this it is flattened back
+// into a single segment, which keeps lookups and crossover bounded
+#define PERSISTENT_MAX_VIEWS 32
+
+#define PERSISTENT_LENGTH(p) p->length
+#define PERSISTENT_TYPE(p) p->objtype
+#define PERSISTENT_NUM_VIEWS(p) p->num_views
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_fromlist
+ *
+ * DESCRIPTION
+ *
+ *  Builds a persistent individual from an osaka list. Every object in
+ *  the list is copied into a single new segment, the list itself is
+ *  left untouched.
+ *
+ * PARAMETERS
+ *
+ *  node_str *r - root anchor for the list
+ *
+ * RETURN
+ *
+ *  persistent_str * - new persistent individual with a refcount of 1
+ *
+ * EXAMPLE
+ *
+ *  p = osaka_persistent_fromlist(root);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory, must be given back with osaka_persistent_release
+ *
+ */
+
+persistent_str *osaka_persistent_fromlist(node_str *r);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_tolist
+ *
+ * DESCRIPTION
+ *
+ *  Materializes a persistent individual as a regular osaka list,
+ *  copying every object so that the list can be edited freely.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  node_str * - root anchor of the new list
+ *
+ * EXAMPLE
+ *
+ *  root = osaka_persistent_tolist(p);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates memory for the list
+ *
+ */
+
+node_str *osaka_persistent_tolist(persistent_str *p);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_retain
+ *
+ * DESCRIPTION
+ *
+ *  Takes another reference to a persistent individual. Because the
+ *  individual is immutable, this is how it is copied.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  persistent_str * - the same individual
+ *
+ * EXAMPLE
+ *
+ *  next_gen[i] = osaka_persistent_retain(curr_gen[i]);
+ *
+ * SIDE-EFFECT
+ *
+ *  increments the refcount
+ *
+ */
+
+persistent_str *osaka_persistent_retain(persistent_str *p);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_release
+ *
+ * DESCRIPTION
+ *
+ *  Drops a reference to a persistent individual. When the last
+ *  reference goes away the views are dropped, and any segment that is
+ *  no longer referenced frees its objects.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_persistent_release(p);
+ *
+ * SIDE-EFFECT
+ *
+ *  may free the individual, its segments and their objects
+ *
+ */
+
+void osaka_persistent_release(persistent_str *p);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_nthobject
+ *
+ * DESCRIPTION
+ *
+ *  Returns the object held by the nth gene of a persistent individual.
+ *  Counting starts at 1 to match osaka_nthnode. The object is shared
+ *  and must not be modified.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *  uint32_t nth - position of the gene
+ *
+ * RETURN
+ *
+ *  void * - the object, NULL if nth is out of range
+ *
+ * EXAMPLE
+ *
+ *  o = osaka_persistent_nthobject(p, 3);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void *osaka_persistent_nthobject(persistent_str *p, uint32_t nth);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_crossover
+ *
+ * DESCRIPTION
+ *
+ *  One point crossover of two persistent individuals. The first child
+ *  is the head of p1 up to (not including) the nth gene followed by the
+ *  tail of p2 from the nth gene, the second child is the opposite. Both
+ *  children share their segments with the parents, so no objects are
+ *  copied and the parents are left unchanged.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p1 - first parent
+ *  persistent_str *p2 - second parent
+ *  uint32_t nth - crossover point, 1 < nth <= shortest length
+ *  persistent_str **c1 - receives the first child
+ *  persistent_str **c2 - receives the second child
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  osaka_persistent_crossover(p1, p2, 4, &c1, &c2);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the two children and takes references on shared segments
+ *
+ */
+
+void osaka_persistent_crossover(persistent_str *p1, persistent_str *p2, uint32_t nth, persistent_str **c1, persistent_str **c2);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_mutate
+ *
+ * DESCRIPTION
+ *
+ *  Returns a new individual that is p with all parameters of the nth
+ *  gene randomized. Only the mutated gene is copied, into a new one gene
+ *  segment, everything else is shared with p.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - individual to be mutated, left unchanged
+ *  uint32_t nth - position of the gene to mutate, starting at 1
+ *
+ * RETURN
+ *
+ *  persistent_str * - the mutated individual
+ *
+ * EXAMPLE
+ *
+ *  child = osaka_persistent_mutate(parent, 5);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the new individual and its new segment
+ *
+ */
+
+persistent_str *osaka_persistent_mutate(persistent_str *p, uint32_t nth);
+
+/*
+ * NAME
+ *
+ *  osaka_persistent_consistencycheck
+ *
+ * DESCRIPTION
+ *
+ *  Verifies that the views of a persistent individual are in range of
+ *  their segments, add up to the recorded length and only reference
+ *  live segments of the right type.
+ *
+ * PARAMETERS
+ *
+ *  persistent_str *p - persistent individual
+ *
+ * RETURN
+ *
+ *  bool - true if the individual is consistent
+ *
+ * EXAMPLE
+ *
+ *  assert(osaka_persistent_consistencycheck(p));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool osaka_persistent_consistencycheck(persistent_str *p);
+
+#endif /* OSAKA_OSAKA_PERSISTENT_H_ */
@@ -36,6 +36,7 @@ bool osaka_test_cycler(osaka_test_typ mode) {
 
   node_str *r0,*r1,*r2,*r3;
   node_str *c0,*c1,*c2,*c3;
+  osaka_list_str l0;
   uint32_t i,x0,x1,x2,x3,t=0;
   bool test[20],b0,b1,b2,b3;
 
@@ -238,6 +239,110 @@ bool osaka_test_cycler(osaka_test_typ mode) {
   c2=osaka_freelist(c2);
   c3=osaka_freelist(c3);
   
+  // [10] ********************************************************
+
+  osaka_list_init(&l0,NULL);
+
+  for(i=0; i<1000; i++)  {
+    osaka_list_createnode(&l0,TAIL,SIMPLE);
+  }
+
+  b0=osaka_list_consistencycheck(&l0) &&
+     OSAKA_LIST_LENGTH((&l0))==1000 &&
+     osaka_listlength(OSAKA_LIST_HEAD((&l0)))==1000;
+
+  b1=true;
+  for(i=1; i<=1000; i+=37)  {
+    b1=b1 && osaka_list_nthnode(&l0,i)==osaka_nthnode(OSAKA_LIST_HEAD((&l0)),i);
+  }
+  b1=b1 && osaka_list_nthnode(&l0,1000)==OSAKA_LIST_TAIL((&l0)) &&
+           osaka_list_nthnode(&l0,1001)==NULL;
+
+  osaka_list_deletenode(&l0,OSAKA_LIST_HEAD((&l0)));
+  osaka_list_deletenode(&l0,OSAKA_LIST_TAIL((&l0)));
+  osaka_list_deletenode(&l0,osaka_list_nthnode(&l0,500));
+  osaka_list_createnode(&l0,HEAD,SIMPLE);
+  osaka_list_createnode(&l0,TAIL,SIMPLE);
+
+  b2=osaka_list_consistencycheck(&l0) &&
+     OSAKA_LIST_LENGTH((&l0))==999 &&
+     osaka_list_nthnode(&l0,777)==osaka_nthnode(OSAKA_LIST_HEAD((&l0)),777) &&
+     osaka_list_consistencycheck(&l0);
+
+  osaka_list_free(&l0);
+
+  b3=OSAKA_LIST_HEAD((&l0))==NULL && osaka_list_consistencycheck(&l0);
+
+  DEBUGIF {
+    printf("\n-- test 10: list header on a 1000 node list \n");
+    printf("   built consistent %s\n",b0?"true":"false");
+    printf("   nth lookups %s\n",b1?"true":"false");
+    printf("   edited consistent %s\n",b2?"true":"false");
+    printf("   freed %s\n",b3?"true":"false");
+  }
+
+  test[t++]=b0 && b1 && b2 && b3;
+
+  // [11] ********************************************************
+
+  for(i=0; i<100; i++)  {
+    osaka_list_createnode(&l0,TAIL,SIMPLE);
+  }
+  c0=osaka_list_attach(&l0);
+
+  for(i=0; i<70; i++)  {
+    osaka_list_createnode(&l0,TAIL,SIMPLE);
+  }
+  c1=osaka_list_attach(&l0);
+
+  c0=osaka_createnode(c0,TAIL,SIMPLE);
+  c0=osaka_createnode(c0,HEAD,SIMPLE);
+  c0=osaka_deletenode(osaka_nthnode(c0,50));
+  c0=osaka_deletenode(c0);
+
+  b0=LIST(c0)!=NULL && osaka_consistencycheck(c0) &&
+     osaka_listlength(c0)==100 &&
+     osaka_nthnode(c0,77)==osaka_list_nthnode(LIST(c0),77) &&
+     osaka_findtailnode(c0)==OSAKA_LIST_TAIL(LIST(c0));
+
+  // both skip indexes are valid, so the swap exchanges them rather than dropping them
+  osaka_nthnode(c1,2);
+  osaka_swaptails(c0,c1,40);
+
+  b1=osaka_consistencycheck(c0) && osaka_consistencycheck(c1) &&
+     osaka_listlength(c0)==70 && osaka_listlength(c1)==100 &&
+     LIST(c1)->index_valid;
+
+  c2=osaka_copylist(c1);
+
+  b2=LIST(c2)!=NULL && LIST(c2)!=LIST(c1) &&
+     osaka_consistencycheck(c2) && osaka_compare(c2,c1);
+
+  OSAKA_LIST_LENGTH(LIST(c2))++;
+  b2=b2 && !osaka_consistencycheck(c2);
+  OSAKA_LIST_LENGTH(LIST(c2))--;
+
+  b3=true;
+  while (c2!=NULL)  {
+    c2=osaka_deletenode(osaka_findtailnode(c2));
+    b3=b3 && (c2==NULL || osaka_consistencycheck(c2));
+  }
+
+  c0=osaka_freelist(c0);
+  c1=osaka_freelist(c1);
+
+  b3=b3 && c0==NULL && c1==NULL && c2==NULL;
+
+  DEBUGIF {
+    printf("\n-- test 11: header attached to the head, kept by the node functions \n");
+    printf("   node edits consistent %s\n",b0?"true":"false");
+    printf("   tails swapped %s\n",b1?"true":"false");
+    printf("   copied and checked %s\n",b2?"true":"false");
+    printf("   deleted to empty %s\n",b3?"true":"false");
+  }
+
+  test[t++]=b0 && b1 && b2 && b3;
+
   // ***************************************************************
 
   r0=osaka_freelist(r0);
@@ -260,5 +365,7 @@ bool osaka_test_cycler(osaka_test_typ mode) {
           test[6] &&
           test[7] &&
           test[8] &&
-          test[9] ;
+          test[9] &&
+          test[10] &&
+          test[11] ;
 }
\ No newline at end of file
@@ -0,0 +1,521 @@
+/*
+ ============================================================================
+ Name        : aarch64.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Native evaluation of ASSEMBLER individuals. A generation
+               is emitted as AArch64 functions, built with a driver that
+               runs each of them over the cases of the current problem,
+               and run once under a user-mode emulator. The errors it
+               prints are checked against the interpreter and kept in its
+               fitness memo
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "aarch64.h"
+
+/*
+ * STATIC
+ */
+
+static bool aarch64_active = false;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __aarch64_write_driver
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, writes the C driver of a batch: the dataset as
+ *  constant tables, and a main that runs every program over every case
+ *  and prints its total absolute error, added up as interpreter_error does
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- where the driver is written
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *  uint32_t num_programs -- functions shackleton_program_0 onward to run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __aarch64_write_driver(driver, dataset, num_indivs);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the stream
+ *
+ */
+
+void __aarch64_write_driver(FILE* stream, interpreter_dataset_str* dataset, uint32_t num_programs) {
+
+    fprintf(stream, "#include <stdio.h>\n#include <stdint.h>\n\n");
+    fprintf(stream, "typedef int64_t (*program_fn)(int64_t, int64_t, int64_t, int64_t);\n\n");
+
+    for (uint32_t p = 0; p < num_programs; p++) {
+        fprintf(stream, "int64_t shackleton_program_%u(int64_t, int64_t, int64_t, int64_t);\n", p);
+    }
+
+    fprintf(stream, "\nstatic const program_fn programs[%u] = {\n", num_programs);
+    for (uint32_t p = 0; p < num_programs; p++) {
+        fprintf(stream, "    shackleton_program_%u,\n", p);
+    }
+    fprintf(stream, "};\n\n");
+
+    // every value as its bits, so that no literal overflows
+    fprintf(stream, "static const int64_t inputs[%u][%u] = {\n", dataset->num_cases, INTERPRETER_NUM_REGISTERS);
+    for (uint32_t c = 0; c < dataset->num_cases; c++) {
+        fprintf(stream, "    {");
+        for (uint32_t i = 0; i < INTERPRETER_NUM_REGISTERS; i++) {
+            uint64_t value = i < dataset->num_inputs ? (uint64_t) dataset->inputs[(size_t) c * dataset->num_inputs + i] : 0;
+            fprintf(stream, " (int64_t) 0x%016llxULL,", (unsigned long long) value);
+        }
+        fprintf(stream, " },\n");
+    }
+    fprintf(stream, "};\n\n");
+
+    fprintf(stream, "static const int64_t targets[%u] = {\n", dataset->num_cases);
+    for (uint32_t c = 0; c < dataset->num_cases; c++) {
+        fprintf(stream, "    (int64_t) 0x%016llxULL,\n", (unsigned long long) (uint64_t) dataset->targets[c]);
+    }
+    fprintf(stream, "};\n\n");
+
+    fprintf(stream,
+        "int main(void) {\n"
+        "    for (uint32_t p = 0; p < %u; p++) {\n"
+        "        uint64_t error = 0;\n"
+        "        for (uint32_t c = 0; c < %u; c++) {\n"
+        "            uint64_t result = (uint64_t) programs[p](inputs[c][0], inputs[c][1], inputs[c][2], inputs[c][3]);\n"
+        "            uint64_t target = (uint64_t) targets[c];\n"
+        "            uint64_t difference = (int64_t) result >= (int64_t) target ? result - target : target - result;\n"
+        "            error = error + difference < error ? UINT64_MAX : error + difference;\n"
+        "        }\n"
+        "        printf(\"%%llu\\n\", (unsigned long long) error);\n"
+        "    }\n"
+        "    return 0;\n"
+        "}\n", num_programs, dataset->num_cases);
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_emit_function
+ *
+ * DESCRIPTION
+ *
+ *  Writes an ASSEMBLER individual as an AArch64 function that takes its
+ *  inputs in x0 to x3 and returns x0, as the procedure call standard has
+ *  it. The prologue saves the frame and zeroes the registers that are not
+ *  inputs, so the function computes exactly what the interpreter does,
+ *  then come the genes in order and the epilogue
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- where the assembly is written
+ *  node_str* indiv -- the individual
+ *  const char* name -- symbol of the function
+ *  uint32_t num_inputs -- registers holding inputs, at most INTERPRETER_NUM_REGISTERS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_emit_function(stdout, indiv, "shackleton_program_0", 2);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the stream
+ *
+ */
+
+void aarch64_emit_function(FILE* stream, node_str* indiv, const char* name, uint32_t num_inputs) {
+
+    assert(num_inputs <= INTERPRETER_NUM_REGISTERS);
+
+    fprintf(stream, "\t.text\n\t.align 2\n\t.globl %s\n\t.type %s, %%function\n%s:\n", name, name, name);
+    fprintf(stream, "\tstp x29, x30, [sp, #-16]!\n\tmov x29, sp\n");
+
+    // the interpreter starts every register that is not an input at zero
+    for (uint32_t r = num_inputs; r < INTERPRETER_NUM_REGISTERS; r++) {
+        fprintf(stream, "\tmov x%u, #0\n", r);
+    }
+
+    for (node_str* node = indiv; node != NULL; node = NEXT(node)) {
+        assert(OBJECT_TYPE(node) == ASSEMBLER);
+        assembler_emitobject(stream, (object_assembler_str*) OBJECT(node));
+    }
+
+    fprintf(stream, "\tldp x29, x30, [sp], #16\n\tret\n\t.size %s, .-%s\n\n", name, name);
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_available
+ *
+ * DESCRIPTION
+ *
+ *  Whether the cross compiler AARCH64_CC and the emulator AARCH64_EMULATOR
+ *  are installed
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true if both are found on the PATH
+ *
+ * EXAMPLE
+ *
+ *  if (aarch64_available()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  runs a shell command
+ *
+ */
+
+bool aarch64_available(void) {
+
+    return llvm_run_command("command -v " AARCH64_CC " > /dev/null 2>&1 && command -v " AARCH64_EMULATOR " > /dev/null 2>&1") == 0;
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_evaluate
+ *
+ * DESCRIPTION
+ *
+ *  Emits every individual as a function, builds them into one static
+ *  program with a driver holding the dataset and runs it once under the
+ *  emulator, which prints the total absolute error of every individual
+ *
+ * PARAMETERS
+ *
+ *  node_str** indivs -- the ASSEMBLER individuals
+ *  uint32_t num_indivs -- number of individuals
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *  uint64_t* errors -- filled with the error of every individual
+ *
+ * RETURN
+ *
+ *  bool -- true if the program was built and ran
+ *
+ * EXAMPLE
+ *
+ *  bool ran = aarch64_evaluate(gen, pop_size, interpreter_problem(), errors);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes, builds and runs files in AARCH64_FOLDER
+ *
+ */
+
+bool aarch64_evaluate(node_str** indivs, uint32_t num_indivs, interpreter_dataset_str* dataset, uint64_t* errors) {
+
+    char command[AARCH64_MAX_COMMAND];
+    char name[50];
+
+    if (mkdir(AARCH64_FOLDER, 0755) != 0 && errno != EEXIST) {
+        printf("error: could not create folder %s [file:\'%s\',line:%d]\n", AARCH64_FOLDER, __FILE__, __LINE__);
+        return false;
+    }
+
+    FILE* programs = fopen(AARCH64_FOLDER "/programs.s", "w");
+    FILE* driver = fopen(AARCH64_FOLDER "/driver.c", "w");
+
+    if (programs == NULL || driver == NULL) {
+        printf("error: could not write the programs to %s [file:\'%s\',line:%d]\n", AARCH64_FOLDER, __FILE__, __LINE__);
+        if (programs != NULL) fclose(programs);
+        if (driver != NULL) fclose(driver);
+        return false;
+    }
+
+    for (uint32_t p = 0; p < num_indivs; p++) {
+        sprintf(name, "shackleton_program_%u", p);
+        aarch64_emit_function(programs, indivs[p], name, dataset->num_inputs);
+    }
+    __aarch64_write_driver(driver, dataset, num_indivs);
+
+    fclose(programs);
+    fclose(driver);
+
+    sprintf(command, "%s -static -O1 -o %s/programs %s/driver.c %s/programs.s", AARCH64_CC, AARCH64_FOLDER, AARCH64_FOLDER, AARCH64_FOLDER);
+    if (llvm_run_command(command) != 0) {
+        printf("error: %s could not build the programs in %s [file:\'%s\',line:%d]\n", AARCH64_CC, AARCH64_FOLDER, __FILE__, __LINE__);
+        return false;
+    }
+
+    // one launch of the emulator for the whole batch
+    sprintf(command, "%s %s/programs > %s/results.txt", AARCH64_EMULATOR, AARCH64_FOLDER, AARCH64_FOLDER);
+    if (llvm_run_command(command) != 0) {
+        printf("error: the programs failed under %s [file:\'%s\',line:%d]\n", AARCH64_EMULATOR, __FILE__, __LINE__);
+        return false;
+    }
+
+    FILE* results = fopen(AARCH64_FOLDER "/results.txt", "r");
+    uint32_t read = 0;
+
+    if (results == NULL) {
+        printf("error: could not read %s/results.txt [file:\'%s\',line:%d]\n", AARCH64_FOLDER, __FILE__, __LINE__);
+        return false;
+    }
+
+    unsigned long long error;
+    while (read < num_indivs && fscanf(results, "%llu", &error) == 1) {
+        errors[read++] = (uint64_t) error;
+    }
+    fclose(results);
+
+    if (read != num_indivs) {
+        printf("error: the programs printed %u of %u errors [file:\'%s\',line:%d]\n", read, num_indivs, __FILE__, __LINE__);
+        return false;
+    }
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_evaluate_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a generation of ASSEMBLER individuals with one launch of the
+ *  emulator, each distinct effective program once, and records their
+ *  fitness in the interpreter memo, where interpreter_fitness finds it.
+ *  Every error is checked against the interpreter, and a program on which
+ *  they disagree is reported. The emulator is taken as right
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen -- the generation
+ *  uint32_t pop_size -- size of the generation
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of programs on which the emulator and the interpreter disagree
+ *
+ * EXAMPLE
+ *
+ *  uint32_t mismatches = aarch64_evaluate_generation(current_generation, pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds and runs a program, fills the interpreter memo
+ *
+ */
+
+uint32_t aarch64_evaluate_generation(node_str** gen, uint32_t pop_size) {
+
+    interpreter_dataset_str* dataset = interpreter_problem();
+    interpreter_program_str* programs = calloc(pop_size, sizeof(interpreter_program_str));
+    node_str** unique = malloc(pop_size * sizeof(node_str*));
+    uint64_t* errors = malloc(pop_size * sizeof(uint64_t));
+    uint32_t capacity = 1;
+    uint32_t num_unique = 0;
+    uint32_t mismatches = 0;
+
+    while (capacity < 2 * pop_size) {
+        capacity *= 2;
+    }
+
+    // open addressing over the hashes of the effective code, slot value is index + 1
+    uint64_t* keys = malloc(capacity * sizeof(uint64_t));
+    uint32_t* slots = calloc(capacity, sizeof(uint32_t));
+    assert(programs != NULL && unique != NULL && errors != NULL && keys != NULL && slots != NULL);
+
+    for (uint32_t k = 0; k < pop_size; k++) {
+
+        interpreter_program_str* program = &programs[num_unique];
+
+        interpreter_decode(program, gen[k]);
+        interpreter_strip_introns(program);
+
+        uint64_t key = interpreter_hash(program);
+        uint32_t slot = (uint32_t) key & (capacity - 1);
+
+        while (slots[slot] != 0 && keys[slot] != key) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+
+        if (slots[slot] == 0) {
+            keys[slot] = key;
+            slots[slot] = num_unique + 1;
+            unique[num_unique++] = gen[k];
+        }
+
+    }
+
+    if (aarch64_evaluate(unique, num_unique, dataset, errors)) {
+
+        for (uint32_t p = 0; p < num_unique; p++) {
+
+            uint64_t expected = interpreter_error_mode(&programs[p], dataset, INTERPRETER_MODE_SIMD);
+
+            if (errors[p] != expected) {
+                printf("error: shackleton_program_%u has error %llu on %s and %llu on the interpreter [file:\'%s\',line:%d]\n", p,
+                    (unsigned long long) errors[p], AARCH64_EMULATOR, (unsigned long long) expected, __FILE__, __LINE__);
+                mismatches++;
+            }
+
+            interpreter_memo_publish(&programs[p], errors[p]);
+
+        }
+
+    }
+
+    // the buffer of the last program decoded may be a duplicate past num_unique
+    for (uint32_t p = 0; p < pop_size; p++) {
+        interpreter_free(&programs[p]);
+    }
+
+    free(programs);
+    free(unique);
+    free(errors);
+    free(keys);
+    free(slots);
+
+    return mismatches;
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_enable
+ *
+ * DESCRIPTION
+ *
+ *  ASSEMBLER generations are evaluated on the emulator from now on
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_enable();
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how ASSEMBLER generations are evaluated
+ *
+ */
+
+void aarch64_enable(void) {
+
+    aarch64_active = true;
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_disable
+ *
+ * DESCRIPTION
+ *
+ *  ASSEMBLER individuals are evaluated on the interpreter alone again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how ASSEMBLER generations are evaluated
+ *
+ */
+
+void aarch64_disable(void) {
+
+    aarch64_active = false;
+
+}
+
+/*
+ * NAME
+ *
+ *   aarch64_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether ASSEMBLER generations are evaluated on the emulator
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between aarch64_enable and aarch64_disable
+ *
+ * EXAMPLE
+ *
+ *  if (aarch64_enabled()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool aarch64_enabled(void) {
+
+    return aarch64_active;
+
+}
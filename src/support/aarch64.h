@@ -0,0 +1,294 @@
+/*
+ ============================================================================
+ Name        : aarch64.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Native evaluation of ASSEMBLER individuals. Every
+               individual is emitted as an AArch64 function, a whole
+               generation is assembled and linked with a driver by a
+               local cross toolchain into one static program, and that
+               program runs once under a user-mode emulator, which gives
+               the error of every individual over the current problem
+ ============================================================================
+ */
+
+#ifndef SUPPORT_AARCH64_H_
+#define SUPPORT_AARCH64_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../module/assembler.h"
+#include "interpreter.h"
+#include "llvm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+/*
+ * MACROS
+ */
+
+// the toolchain, overridden at build time for another cross compiler or emulator
+#ifndef AARCH64_CC
+#define AARCH64_CC "aarch64-linux-gnu-gcc"
+#endif
+#ifndef AARCH64_EMULATOR
+#define AARCH64_EMULATOR "qemu-aarch64"
+#endif
+
+#define AARCH64_FOLDER "src/files/aarch64"
+#define AARCH64_MAX_COMMAND 1024
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   aarch64_emit_function
+ *
+ * DESCRIPTION
+ *
+ *  Writes an ASSEMBLER individual as an AArch64 function that takes its
+ *  inputs in x0 to x3 and returns x0, as the procedure call standard has
+ *  it. The prologue saves the frame and zeroes the registers that are not
+ *  inputs, so the function computes exactly what the interpreter does,
+ *  then come the genes in order and the epilogue
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- where the assembly is written
+ *  node_str* indiv -- the individual
+ *  const char* name -- symbol of the function
+ *  uint32_t num_inputs -- registers holding inputs, at most INTERPRETER_NUM_REGISTERS
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_emit_function(stdout, indiv, "shackleton_program_0", 2);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the stream
+ *
+ */
+
+void aarch64_emit_function(FILE* stream, node_str* indiv, const char* name, uint32_t num_inputs);
+
+/*
+ * NAME
+ *
+ *   aarch64_available
+ *
+ * DESCRIPTION
+ *
+ *  Whether the cross compiler AARCH64_CC and the emulator AARCH64_EMULATOR
+ *  are installed
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true if both are found on the PATH
+ *
+ * EXAMPLE
+ *
+ *  if (aarch64_available()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  runs a shell command
+ *
+ */
+
+bool aarch64_available(void);
+
+/*
+ * NAME
+ *
+ *   aarch64_evaluate
+ *
+ * DESCRIPTION
+ *
+ *  Emits every individual as a function, builds them into one static
+ *  program with a driver holding the dataset and runs it once under the
+ *  emulator, which prints the total absolute error of every individual
+ *
+ * PARAMETERS
+ *
+ *  node_str** indivs -- the ASSEMBLER individuals
+ *  uint32_t num_indivs -- number of individuals
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *  uint64_t* errors -- filled with the error of every individual
+ *
+ * RETURN
+ *
+ *  bool -- true if the program was built and ran
+ *
+ * EXAMPLE
+ *
+ *  bool ran = aarch64_evaluate(gen, pop_size, interpreter_problem(), errors);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes, builds and runs files in AARCH64_FOLDER
+ *
+ */
+
+bool aarch64_evaluate(node_str** indivs, uint32_t num_indivs, interpreter_dataset_str* dataset, uint64_t* errors);
+
+/*
+ * NAME
+ *
+ *   aarch64_evaluate_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a generation of ASSEMBLER individuals with one launch of the
+ *  emulator, each distinct effective program once, and records their
+ *  fitness in the interpreter memo, where interpreter_fitness finds it.
+ *  Every error is checked against the interpreter, and a program on which
+ *  they disagree is reported. The emulator is taken as right
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen -- the generation
+ *  uint32_t pop_size -- size of the generation
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of programs on which the emulator and the interpreter disagree
+ *
+ * EXAMPLE
+ *
+ *  uint32_t mismatches = aarch64_evaluate_generation(current_generation, pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds and runs a program, fills the interpreter memo
+ *
+ */
+
+uint32_t aarch64_evaluate_generation(node_str** gen, uint32_t pop_size);
+
+/*
+ * NAME
+ *
+ *   aarch64_enable
+ *
+ * DESCRIPTION
+ *
+ *  ASSEMBLER generations are evaluated on the emulator from now on
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_enable();
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how ASSEMBLER generations are evaluated
+ *
+ */
+
+void aarch64_enable(void);
+
+/*
+ * NAME
+ *
+ *   aarch64_disable
+ *
+ * DESCRIPTION
+ *
+ *  ASSEMBLER individuals are evaluated on the interpreter alone again
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  aarch64_disable();
+ *
+ * SIDE-EFFECT
+ *
+ *  changes how ASSEMBLER generations are evaluated
+ *
+ */
+
+void aarch64_disable(void);
+
+/*
+ * NAME
+ *
+ *   aarch64_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether ASSEMBLER generations are evaluated on the emulator
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between aarch64_enable and aarch64_disable
+ *
+ * EXAMPLE
+ *
+ *  if (aarch64_enabled()) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool aarch64_enabled(void);
+
+#endif /* SUPPORT_AARCH64_H_ */
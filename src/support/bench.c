@@ -0,0 +1,1198 @@
+/*
+ ============================================================================
+ Name        : bench.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Micro-benchmarks of the OSAKA routines and genetic operators.
+               Every benchmark is timed over enough iterations to take a
+               measurable time, the best of several repeats is kept, and the
+               results are printed as JSON Lines and compared against a stored
+               baseline so that regressions are flagged
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "bench.h"
+
+/*
+ * STATIC
+ */
+
+static uint32_t bench_default_genome_lens[] = { 10, 100 };
+static uint32_t bench_default_pop_sizes[] = { 50, 500 };
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __bench_copylist
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, copies an individual and frees the copy
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_copylist(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates and frees nodes
+ *
+ */
+
+void __bench_copylist(bench_fixture_str* f, uint64_t i) {
+
+    node_str* copy = osaka_copylist(f->gen[i % f->pop_size]);
+    f->sink += UID(copy);
+    generate_free_individual(copy);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_nthnode
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, walks to the last node of an individual
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_nthnode(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_nthnode(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += UID(osaka_nthnode(f->gen[i % f->pop_size], f->genome_len));
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_serialize
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, serializes an individual to the fixture file
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_serialize(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  overwrites the fixture file
+ *
+ */
+
+void __bench_serialize(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += osaka_serialize(f->gen[i % f->pop_size], f->file);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_deserialize
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, reads an individual back from the fixture file and
+ *  frees it
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_deserialize(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates and frees nodes
+ *
+ */
+
+void __bench_deserialize(bench_fixture_str* f, uint64_t i) {
+
+    node_str* indiv = osaka_deserialize(f->file);
+    f->sink += UID(indiv);
+    generate_free_individual(indiv);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_new_generation
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, creates a whole generation and frees it
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_new_generation(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates and frees nodes
+ *
+ */
+
+void __bench_new_generation(bench_fixture_str* f, uint64_t i) {
+
+    generate_new_generation(f->scratch, f->pop_size, f->genome_len, f->ot);
+    f->sink += UID(f->scratch[0]);
+    generate_free_generation(f->scratch, f->pop_size);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_crossover_onepoint
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, one point crossover of two individuals in place.
+ *  Runs on a copy of the generation, see bench_suite
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_crossover_onepoint(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the individuals in f->gen
+ *
+ */
+
+void __bench_crossover_onepoint(bench_fixture_str* f, uint64_t i) {
+
+    crossover_onepoint_macro(f->gen[i % f->pop_size], f->gen[(i + 1) % f->pop_size], false);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_crossover_twopoint
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, two point crossover of two individuals in place.
+ *  Runs on a copy of the generation, see bench_suite
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_crossover_twopoint(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the individuals in f->gen
+ *
+ */
+
+void __bench_crossover_twopoint(bench_fixture_str* f, uint64_t i) {
+
+    crossover_twopoint_diff(f->gen[i % f->pop_size], f->gen[(i + 1) % f->pop_size], false);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_mutation
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, mutates one gene of an individual in place.
+ *  Runs on a copy of the generation, see bench_suite
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_mutation(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the individuals in f->gen
+ *
+ */
+
+void __bench_mutation(bench_fixture_str* f, uint64_t i) {
+
+    mutation_single_unit_all_params(f->gen[i % f->pop_size], (uint32_t) (i % f->genome_len) + 1, false);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_mutation_single_param
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, mutates one parameter of one gene of an individual
+ *  in place. Runs on a copy of the generation, see bench_suite
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_mutation_single_param(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the individuals in f->gen
+ *
+ */
+
+void __bench_mutation_single_param(bench_fixture_str* f, uint64_t i) {
+
+    mutation_single_unit_single_param(f->gen[i % f->pop_size], (uint32_t) (i % f->genome_len) + 1);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_interpreter
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, evaluates an ASSEMBLER individual on the register
+ *  machine interpreter over the cases of the default problem, so the
+ *  instructions run per second are genome length times cases over the time.
+ *  The cases run in SIMD lanes, the default of the fitness
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_interpreter(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_interpreter(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += interpreter_fitness(f->gen[i % f->pop_size]);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_interpreter_scalar
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, as __bench_interpreter with the cases run one at a
+ *  time, to weigh the SIMD lanes against
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_interpreter_scalar(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_interpreter_scalar(bench_fixture_str* f, uint64_t i) {
+
+    interpreter_set_mode(INTERPRETER_MODE_SCALAR);
+    f->sink += interpreter_fitness(f->gen[i % f->pop_size]);
+    interpreter_set_mode(INTERPRETER_MODE_SIMD);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_distance
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, edit distance of one OSAKA_STRING individual from
+ *  the default target sentence, streamed over its strings
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_distance(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_distance(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += distance_edit(f->gen[i % f->pop_size]);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_distance_batch
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, as __bench_distance with the whole population taken
+ *  in the lanes of distance_batch every pop_size iterations, so the time
+ *  per operation is the time per individual
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_distance_batch(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_distance_batch(bench_fixture_str* f, uint64_t i) {
+
+    if (i % f->pop_size != 0) {
+        return;
+    }
+
+    uint32_t* distances = malloc(f->pop_size * sizeof(uint32_t));
+    assert(distances != NULL);
+
+    distance_batch(f->gen, f->pop_size, distances);
+    f->sink += distances[0];
+
+    free(distances);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_bitset
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, fitness of a BINARY_UP_TO_512 individual on the
+ *  current problem, packing its genome and running the kernel
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_bitset(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_bitset(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += bitset_fitness(f->gen[i % f->pop_size]);
+
+}
+
+/*
+ * NAME
+ *
+ *   __bench_selection
+ *
+ * DESCRIPTION
+ *
+ *  Internal benchmark, one tournament of size 2 over the population
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture
+ *  uint64_t i -- iteration number
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __bench_selection(&f, i);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __bench_selection(bench_fixture_str* f, uint64_t i) {
+
+    f->sink += selection_tournament(f->gen, f->fitness_values, NULL, f->pop_size, 2, false, NULL);
+
+}
+
+// serialization writes the raw objects, so it only round trips object types without pointers
+static bench_case_str bench_cases[] = {
+    { "osaka_copylist_and_free", __bench_copylist, NOTSET, false },
+    { "osaka_nthnode_last", __bench_nthnode, NOTSET, false },
+    { "osaka_serialize", __bench_serialize, SIMPLE, false },
+    { "osaka_deserialize_and_free", __bench_deserialize, SIMPLE, false },
+    { "generate_new_generation_and_free", __bench_new_generation, NOTSET, false },
+    { "crossover_onepoint_macro", __bench_crossover_onepoint, NOTSET, true },
+    { "crossover_twopoint_diff", __bench_crossover_twopoint, NOTSET, true },
+    { "mutation_single_unit_all_params", __bench_mutation, NOTSET, true },
+    { "mutation_single_unit_single_param", __bench_mutation_single_param, NOTSET, true },
+    { "selection_tournament", __bench_selection, NOTSET, false },
+    { "fitness_assembler_interpreter", __bench_interpreter, ASSEMBLER, false },
+    { "fitness_assembler_interpreter_scalar", __bench_interpreter_scalar, ASSEMBLER, false },
+    { "fitness_osaka_string_distance", __bench_distance, OSAKA_STRING, false },
+    { "fitness_osaka_string_distance_batch", __bench_distance_batch, OSAKA_STRING, false },
+    { "fitness_binary_up_to_512_bitset", __bench_bitset, BINARY_UP_TO_512, false }
+};
+
+/*
+ * NAME
+ *
+ *   bench_fixture_create
+ *
+ * DESCRIPTION
+ *
+ *  Creates the population and scratch space the benchmarks of one object
+ *  type and size work on. Fitness values are random so that selection has
+ *  to compare
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t genome_len -- genes per individual, at least 3 for crossover
+ *  uint32_t pop_size -- number of individuals, at least 2
+ *
+ * RETURN
+ *
+ *  bench_fixture_str* -- the new fixture
+ *
+ * EXAMPLE
+ *
+ *  bench_fixture_str* f = bench_fixture_create(SIMPLE, 100, 500);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the fixture and a generation
+ *
+ */
+
+bench_fixture_str* bench_fixture_create(osaka_object_typ ot, uint32_t genome_len, uint32_t pop_size) {
+
+    assert(genome_len >= 3 && pop_size >= 2);
+
+    bench_fixture_str* f = malloc(sizeof(bench_fixture_str));
+    assert(f != NULL);
+
+    f->ot = ot;
+    f->genome_len = genome_len;
+    f->pop_size = pop_size;
+    f->gen = malloc(sizeof(node_str*) * pop_size);
+    f->scratch = malloc(sizeof(node_str*) * pop_size);
+    f->fitness_values = malloc(sizeof(double) * pop_size);
+    f->sink = 0;
+    assert(f->gen != NULL && f->scratch != NULL && f->fitness_values != NULL);
+
+    generate_new_generation(f->gen, pop_size, genome_len, ot);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        f->fitness_values[i] = rand() / (RAND_MAX + 1.0);
+    }
+
+    // only SIMPLE has a file to deserialize, see bench_cases
+    sprintf(f->file, "%s/shackleton_bench_%d.bin", P_tmpdir, (int) getpid());
+    if (ot == SIMPLE) {
+        osaka_serialize(f->gen[0], f->file);
+    }
+
+    return f;
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_fixture_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a fixture and removes its file
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture to free
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_fixture_free(f);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory, removes a file
+ *
+ */
+
+void bench_fixture_free(bench_fixture_str* f) {
+
+    remove(f->file);
+    generate_free_generation(f->gen, f->pop_size);
+    free(f->gen);
+    free(f->scratch);
+    free(f->fitness_values);
+    free(f);
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_measure
+ *
+ * DESCRIPTION
+ *
+ *  Times one benchmark. The number of iterations is doubled until a run
+ *  takes at least BENCH_MIN_NS, then BENCH_REPEATS runs of that many
+ *  iterations are timed and the fastest is kept, which filters out most
+ *  noise from other processes
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture the benchmark works on
+ *  void (*op)(bench_fixture_str*, uint64_t) -- one operation of the benchmark
+ *  uint64_t* iterations -- set to the iterations of each timed run
+ *
+ * RETURN
+ *
+ *  double -- nanoseconds per operation
+ *
+ * EXAMPLE
+ *
+ *  double ns = bench_measure(f, __bench_nthnode, &iterations);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the benchmark
+ *
+ */
+
+double bench_measure(bench_fixture_str* f, void (*op)(bench_fixture_str*, uint64_t), uint64_t* iterations) {
+
+    uint64_t n = 1;
+    uint64_t elapsed = 0;
+    double best = 0.0;
+
+    while (true) {
+        uint64_t start = instrument_now_ns();
+        for (uint64_t i = 0; i < n; i++) {
+            op(f, i);
+        }
+        elapsed = instrument_now_ns() - start;
+        if (elapsed >= BENCH_MIN_NS) {
+            break;
+        }
+        n *= 2;
+    }
+
+    best = (double) elapsed / n;
+
+    for (uint32_t r = 1; r < BENCH_REPEATS; r++) {
+        uint64_t start = instrument_now_ns();
+        for (uint64_t i = 0; i < n; i++) {
+            op(f, i);
+        }
+        double ns = (double) (instrument_now_ns() - start) / n;
+        best = ns < best ? ns : best;
+    }
+
+    *iterations = n;
+
+    return best;
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_suite
+ *
+ * DESCRIPTION
+ *
+ *  Runs every benchmark for one object type over a set of genome lengths
+ *  and population sizes. Serialization is only benchmarked for SIMPLE,
+ *  whose objects hold no pointers. The interpreter fitness memo is off
+ *  while they run. Cases that change the individuals run on a copy of the
+ *  generation and every case starts from the same random stream, so each
+ *  case sees the same fixture whatever iteration counts the earlier ones
+ *  picked
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t genome_len -- genes per individual, 0 for the default set of lengths
+ *  uint32_t pop_size -- individuals in the population, 0 for the default set of sizes
+ *  bench_result_str* results -- filled with up to BENCH_MAX_RESULTS results
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of results
+ *
+ * EXAMPLE
+ *
+ *  uint32_t num = bench_suite(SIMPLE, 0, 0, results);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the benchmarks
+ *
+ */
+
+uint32_t bench_suite(osaka_object_typ ot, uint32_t genome_len, uint32_t pop_size, bench_result_str* results) {
+
+    uint32_t* genome_lens = genome_len > 0 ? &genome_len : bench_default_genome_lens;
+    uint32_t* pop_sizes = pop_size > 0 ? &pop_size : bench_default_pop_sizes;
+    uint32_t num_genome_lens = genome_len > 0 ? 1 : sizeof(bench_default_genome_lens) / sizeof(uint32_t);
+    uint32_t num_pop_sizes = pop_size > 0 ? 1 : sizeof(bench_default_pop_sizes) / sizeof(uint32_t);
+    uint32_t num_cases = sizeof(bench_cases) / sizeof(bench_case_str);
+    uint32_t num_results = 0;
+
+    // with the fitness memo on, the interpreter cases would time lookups rather than runs
+    interpreter_set_memo(false);
+
+    for (uint32_t g = 0; g < num_genome_lens; g++) {
+        for (uint32_t p = 0; p < num_pop_sizes; p++) {
+
+            // the same random stream for every run, so runs can be compared
+            srand(1);
+            bench_fixture_str* f = bench_fixture_create(ot, genome_lens[g], pop_sizes[p]);
+
+            for (uint32_t c = 0; c < num_cases && num_results < BENCH_MAX_RESULTS; c++) {
+
+                // NOTSET cases run for every object type
+                if (bench_cases[c].only_type != NOTSET && bench_cases[c].only_type != ot) {
+                    continue;
+                }
+
+                // cases that change the individuals work on a copy held in the scratch space
+                node_str** gen = f->gen;
+                if (bench_cases[c].changes_gen) {
+                    for (uint32_t i = 0; i < f->pop_size; i++) {
+                        f->scratch[i] = osaka_copylist(gen[i]);
+                    }
+                    f->gen = f->scratch;
+                }
+
+                // every case starts from the same random stream
+                srand(1);
+                bench_result_str* r = &results[num_results++];
+                strcpy(r->name, bench_cases[c].name);
+                r->ot = ot;
+                r->genome_len = genome_lens[g];
+                r->pop_size = pop_sizes[p];
+                r->ns_per_op = bench_measure(f, bench_cases[c].op, &r->iterations);
+
+                if (bench_cases[c].changes_gen) {
+                    generate_free_generation(f->gen, f->pop_size);
+                    f->gen = gen;
+                }
+
+            }
+
+            bench_fixture_free(f);
+
+        }
+    }
+
+    interpreter_set_memo(true);
+
+    return num_results;
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_format
+ *
+ * DESCRIPTION
+ *
+ *  Formats a result as one JSON object, without a newline
+ *
+ * PARAMETERS
+ *
+ *  char* line -- filled with the JSON object, at least 256 characters
+ *  bench_result_str* r -- result to format
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_format(line, &results[0]);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void bench_format(char* line, bench_result_str* r) {
+
+    sprintf(line, "{\"benchmark\":\"%s\",\"object_type\":\"%s\",\"genome_length\":%u,\"population\":%u,\"iterations\":%lu,\"ns_per_op\":%.3f}",
+        r->name, object_table_function[r->ot].name, r->genome_len, r->pop_size, (unsigned long) r->iterations, r->ns_per_op);
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_baseline_lookup
+ *
+ * DESCRIPTION
+ *
+ *  Finds the time per operation of the same benchmark, object type and
+ *  sizes in a baseline file
+ *
+ * PARAMETERS
+ *
+ *  const char* baseline_file -- JSON Lines file written by bench_save
+ *  bench_result_str* r -- result to look up
+ *
+ * RETURN
+ *
+ *  double -- baseline nanoseconds per operation, or 0 if there is none
+ *
+ * EXAMPLE
+ *
+ *  double base = bench_baseline_lookup(BENCH_BASELINE_FILE, &r);
+ *
+ * SIDE-EFFECT
+ *
+ *  reads the file
+ *
+ */
+
+double bench_baseline_lookup(const char* baseline_file, bench_result_str* r) {
+
+    char line[512];
+    double found = 0.0;
+
+    FILE* stream = fopen(baseline_file, "r");
+
+    if (stream == NULL) {
+        return 0.0;
+    }
+
+    while (found == 0.0 && fgets(line, sizeof(line), stream) != NULL) {
+
+        cJSON* json = cJSON_Parse(line);
+
+        if (json == NULL) {
+            continue;
+        }
+
+        char* name = cJSON_GetStringValue(cJSON_GetObjectItem(json, "benchmark"));
+        char* type = cJSON_GetStringValue(cJSON_GetObjectItem(json, "object_type"));
+        cJSON* genome_len = cJSON_GetObjectItem(json, "genome_length");
+        cJSON* pop_size = cJSON_GetObjectItem(json, "population");
+        cJSON* ns = cJSON_GetObjectItem(json, "ns_per_op");
+
+        if (name != NULL && type != NULL && cJSON_IsNumber(genome_len) && cJSON_IsNumber(pop_size) && cJSON_IsNumber(ns) &&
+            strcmp(name, r->name) == 0 && strcmp(type, object_table_function[r->ot].name) == 0 &&
+            genome_len->valueint == r->genome_len && pop_size->valueint == r->pop_size) {
+            found = ns->valuedouble;
+        }
+
+        cJSON_Delete(json);
+
+    }
+
+    fclose(stream);
+
+    return found;
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_report
+ *
+ * DESCRIPTION
+ *
+ *  Prints every result as a JSON line, with the baseline time, the ratio
+ *  to it and whether it is a regression when the baseline has the same
+ *  benchmark, followed by a summary line
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to print to
+ *  bench_result_str* results -- results of bench_suite
+ *  uint32_t num_results -- number of results
+ *  const char* baseline_file -- JSON Lines baseline, may not exist
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of regressions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t regressions = bench_report(stdout, results, num, BENCH_BASELINE_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to the stream
+ *
+ */
+
+uint32_t bench_report(FILE* stream, bench_result_str* results, uint32_t num_results, const char* baseline_file) {
+
+    char line[256];
+    uint32_t compared = 0;
+    uint32_t regressions = 0;
+
+    for (uint32_t i = 0; i < num_results; i++) {
+
+        double base = bench_baseline_lookup(baseline_file, &results[i]);
+
+        bench_format(line, &results[i]);
+
+        if (base > 0.0) {
+
+            double ratio = results[i].ns_per_op / base;
+            bool regression = ratio > 1.0 + BENCH_TOLERANCE;
+
+            // the closing brace is replaced with the comparison fields
+            line[strlen(line) - 1] = '\0';
+            fprintf(stream, "%s,\"baseline_ns_per_op\":%.3f,\"ratio\":%.3f,\"regression\":%s}\n", line, base, ratio, regression ? "true" : "false");
+
+            compared++;
+            regressions += regression;
+
+        }
+        else {
+            fprintf(stream, "%s\n", line);
+        }
+
+    }
+
+    fprintf(stream, "{\"summary\":true,\"results\":%u,\"compared\":%u,\"regressions\":%u,\"tolerance\":%.2f}\n",
+        num_results, compared, regressions, BENCH_TOLERANCE);
+
+    return regressions;
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_save
+ *
+ * DESCRIPTION
+ *
+ *  Writes results as the new baseline, replacing the old one
+ *
+ * PARAMETERS
+ *
+ *  bench_result_str* results -- results of bench_suite
+ *  uint32_t num_results -- number of results
+ *  const char* baseline_file -- file to write
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_save(results, num, BENCH_BASELINE_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the baseline folder and file
+ *
+ */
+
+void bench_save(bench_result_str* results, uint32_t num_results, const char* baseline_file) {
+
+    char line[256];
+    char folder[256];
+
+    // the baseline lives in a folder of its own, which may not exist yet
+    strcpy(folder, baseline_file);
+    char* slash = strrchr(folder, '/');
+
+    if (slash != NULL) {
+        *slash = '\0';
+        if (mkdir(folder, 0777) != 0 && errno != EEXIST) {
+            printf("error: could not create folder %s [file:\'%s\',line:%d]\n", folder, __FILE__, __LINE__);
+            exit(0);
+        }
+    }
+
+    FILE* stream = fopen(baseline_file, "w");
+
+    if (stream == NULL) {
+        printf("error: could not create baseline file %s [file:\'%s\',line:%d]\n", baseline_file, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    for (uint32_t i = 0; i < num_results; i++) {
+        bench_format(line, &results[i]);
+        fprintf(stream, "%s\n", line);
+    }
+
+    fclose(stream);
+
+}
+
+/*
+ * NAME
+ *
+ *   bench_evolution
+ *
+ * DESCRIPTION
+ *
+ *  Benchmarks the whole evolution loop end to end with the synthetic
+ *  evaluator of mock.h standing in for the fitness functions. The same
+ *  run is repeated with 1, 2, 4 and so on up to max_workers evaluation
+ *  threads, and for each one a JSON line is printed with the generations
+ *  and evaluations per second, how busy the evaluators were kept, and the
+ *  speedup and efficiency relative to a single worker. Every run starts
+ *  from the same seed, so all of them evolve the same individuals
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to print to
+ *  mock_config_str* config -- cost, latency and noise of every evaluation
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t num_gens -- generations per run
+ *  uint32_t pop_size -- individuals in the population
+ *  uint32_t genome_len -- genes per individual
+ *  uint32_t max_workers -- largest number of evaluation threads, at most EVOLUTION_MAX_WORKERS
+ *  bool cache -- whether the runs also write a run log
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of runs
+ *
+ * EXAMPLE
+ *
+ *  bench_evolution(stdout, &config, SIMPLE, 10, 100, 20, 8, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the evolution several times, changes the random seed
+ *
+ */
+
+uint32_t bench_evolution(FILE* stream, mock_config_str* config, osaka_object_typ ot, uint32_t num_gens, uint32_t pop_size, uint32_t genome_len, uint32_t max_workers, bool cache) {
+
+    uint32_t previous_workers = evolution_get_workers();
+    uint32_t num_runs = 0;
+    double single_ns = 0.0;
+
+    assert(max_workers > 0 && max_workers <= EVOLUTION_MAX_WORKERS);
+
+    // doubling the workers each run, the last run always uses max_workers
+    for (uint32_t workers = 1; ; workers = workers * 2 < max_workers ? workers * 2 : max_workers) {
+
+        srand(config->seed);
+        evolution_set_workers(workers);
+        mock_enable(config);
+
+        uint64_t start = instrument_now_ns();
+        node_str* best = evolution_basic_crossover_and_mutation_with_replacement(num_gens, pop_size, genome_len, 2, 20, 75, ot, false, "", NULL, 0, cache);
+        double wall_ns = (double) (instrument_now_ns() - start);
+
+        uint64_t evaluations = mock_evaluations();
+        double utilization = mock_busy_ns() / (wall_ns * workers);
+        single_ns = workers == 1 ? wall_ns : single_ns;
+
+        fprintf(stream, "{\"benchmark\":\"evolution\",\"object_type\":\"%s\",\"workers\":%u,\"generations\":%u,\"population\":%u,\"genome_length\":%u,"
+            "\"cost_ns\":%lu,\"latency_ns\":%lu,\"latency_distribution\":\"%s\",\"noise\":%.3f,\"cache\":%s,"
+            "\"seconds\":%.6f,\"generations_per_second\":%.3f,\"evaluations_per_second\":%.3f,\"utilization\":%.3f,\"speedup\":%.3f,\"efficiency\":%.3f,\"best_hash\":\"%016lx\"}\n",
+            object_table_function[ot].name, workers, num_gens, pop_size, genome_len,
+            (unsigned long) config->cost_ns, (unsigned long) config->latency_ns, mock_latency_name(config->latency), config->noise, cache ? "true" : "false",
+            wall_ns / 1e9, num_gens / (wall_ns / 1e9), evaluations / (wall_ns / 1e9), utilization, single_ns / wall_ns, single_ns / wall_ns / workers,
+            (unsigned long) osaka_hash(best));
+
+        generate_free_individual(best);
+        mock_disable();
+        num_runs++;
+
+        if (workers == max_workers) {
+            break;
+        }
+
+    }
+
+    evolution_set_workers(previous_workers);
+
+    return num_runs;
+
+}
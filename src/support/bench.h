@@ -0,0 +1,400 @@
+/*
+ ============================================================================
+ Name        : bench.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Micro-benchmarks of the OSAKA routines and genetic operators.
+               Every benchmark is timed over enough iterations to take a
+               measurable time, the best of several repeats is kept, and the
+               results are printed as JSON Lines and compared against a stored
+               baseline so that regressions are flagged
+ ============================================================================
+ */
+
+#ifndef SUPPORT_BENCH_H_
+#define SUPPORT_BENCH_H_
+
+/*
+ * IMPORT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "instrument.h"
+#include "../evolution/evolution.h"
+#include "../evolution/mock.h"
+
+/*
+ * DATATYPES
+ */
+
+// state shared by the benchmarks of one object type, genome length and population size
+typedef struct bench_fixture_str {
+    osaka_object_typ ot;
+    uint32_t genome_len;
+    uint32_t pop_size;
+    node_str** gen;
+    node_str** scratch;
+    double* fitness_values;
+    char file[100];
+    uint64_t sink;
+} bench_fixture_str;
+
+typedef struct bench_result_str {
+    char name[40];
+    osaka_object_typ ot;
+    uint32_t genome_len;
+    uint32_t pop_size;
+    uint64_t iterations;
+    double ns_per_op;
+} bench_result_str;
+
+typedef struct bench_case_str {
+    char name[40];
+    void (*op)(bench_fixture_str*, uint64_t);
+    osaka_object_typ only_type;
+    bool changes_gen;                   // runs on a copy of the generation, see bench_suite
+} bench_case_str;
+
+/*
+ * MACROS
+ */
+
+// every repeat runs for at least this long, the fastest of the repeats is reported
+#define BENCH_MIN_NS 20000000ull
+#define BENCH_REPEATS 5
+
+// a benchmark more than this much slower than its baseline is a regression
+#define BENCH_TOLERANCE 0.25
+
+#define BENCH_MAX_RESULTS 256
+#define BENCH_BASELINE_FILE "src/files/bench/baseline.jsonl"
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   bench_fixture_create
+ *
+ * DESCRIPTION
+ *
+ *  Creates the population and scratch space the benchmarks of one object
+ *  type and size work on. Fitness values are random so that selection has
+ *  to compare
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t genome_len -- genes per individual, at least 3 for crossover
+ *  uint32_t pop_size -- number of individuals, at least 2
+ *
+ * RETURN
+ *
+ *  bench_fixture_str* -- the new fixture
+ *
+ * EXAMPLE
+ *
+ *  bench_fixture_str* f = bench_fixture_create(SIMPLE, 100, 500);
+ *
+ * SIDE-EFFECT
+ *
+ *  allocates the fixture and a generation
+ *
+ */
+
+bench_fixture_str* bench_fixture_create(osaka_object_typ ot, uint32_t genome_len, uint32_t pop_size);
+
+/*
+ * NAME
+ *
+ *   bench_fixture_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees a fixture and removes its file
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture to free
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_fixture_free(f);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory, removes a file
+ *
+ */
+
+void bench_fixture_free(bench_fixture_str* f);
+
+/*
+ * NAME
+ *
+ *   bench_measure
+ *
+ * DESCRIPTION
+ *
+ *  Times one benchmark. The number of iterations is doubled until a run
+ *  takes at least BENCH_MIN_NS, then BENCH_REPEATS runs of that many
+ *  iterations are timed and the fastest is kept, which filters out most
+ *  noise from other processes
+ *
+ * PARAMETERS
+ *
+ *  bench_fixture_str* f -- fixture the benchmark works on
+ *  void (*op)(bench_fixture_str*, uint64_t) -- one operation of the benchmark
+ *  uint64_t* iterations -- set to the iterations of each timed run
+ *
+ * RETURN
+ *
+ *  double -- nanoseconds per operation
+ *
+ * EXAMPLE
+ *
+ *  double ns = bench_measure(f, __bench_nthnode, &iterations);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the benchmark
+ *
+ */
+
+double bench_measure(bench_fixture_str* f, void (*op)(bench_fixture_str*, uint64_t), uint64_t* iterations);
+
+/*
+ * NAME
+ *
+ *   bench_suite
+ *
+ * DESCRIPTION
+ *
+ *  Runs every benchmark for one object type over a set of genome lengths
+ *  and population sizes. Serialization is only benchmarked for SIMPLE,
+ *  whose objects hold no pointers. The interpreter fitness memo is off
+ *  while they run
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t genome_len -- genes per individual, 0 for the default set of lengths
+ *  uint32_t pop_size -- individuals in the population, 0 for the default set of sizes
+ *  bench_result_str* results -- filled with up to BENCH_MAX_RESULTS results
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of results
+ *
+ * EXAMPLE
+ *
+ *  uint32_t num = bench_suite(SIMPLE, 0, 0, results);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the benchmarks
+ *
+ */
+
+uint32_t bench_suite(osaka_object_typ ot, uint32_t genome_len, uint32_t pop_size, bench_result_str* results);
+
+/*
+ * NAME
+ *
+ *   bench_format
+ *
+ * DESCRIPTION
+ *
+ *  Formats a result as one JSON object, without a newline
+ *
+ * PARAMETERS
+ *
+ *  char* line -- filled with the JSON object, at least 256 characters
+ *  bench_result_str* r -- result to format
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_format(line, &results[0]);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void bench_format(char* line, bench_result_str* r);
+
+/*
+ * NAME
+ *
+ *   bench_baseline_lookup
+ *
+ * DESCRIPTION
+ *
+ *  Finds the time per operation of the same benchmark, object type and
+ *  sizes in a baseline file
+ *
+ * PARAMETERS
+ *
+ *  const char* baseline_file -- JSON Lines file written by bench_save
+ *  bench_result_str* r -- result to look up
+ *
+ * RETURN
+ *
+ *  double -- baseline nanoseconds per operation, or 0 if there is none
+ *
+ * EXAMPLE
+ *
+ *  double base = bench_baseline_lookup(BENCH_BASELINE_FILE, &r);
+ *
+ * SIDE-EFFECT
+ *
+ *  reads the file
+ *
+ */
+
+double bench_baseline_lookup(const char* baseline_file, bench_result_str* r);
+
+/*
+ * NAME
+ *
+ *   bench_report
+ *
+ * DESCRIPTION
+ *
+ *  Prints every result as a JSON line, with the baseline time, the ratio
+ *  to it and whether it is a regression when the baseline has the same
+ *  benchmark, followed by a summary line
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to print to
+ *  bench_result_str* results -- results of bench_suite
+ *  uint32_t num_results -- number of results
+ *  const char* baseline_file -- JSON Lines baseline, may not exist
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of regressions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t regressions = bench_report(stdout, results, num, BENCH_BASELINE_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to the stream
+ *
+ */
+
+uint32_t bench_report(FILE* stream, bench_result_str* results, uint32_t num_results, const char* baseline_file);
+
+/*
+ * NAME
+ *
+ *   bench_save
+ *
+ * DESCRIPTION
+ *
+ *  Writes results as the new baseline, replacing the old one
+ *
+ * PARAMETERS
+ *
+ *  bench_result_str* results -- results of bench_suite
+ *  uint32_t num_results -- number of results
+ *  const char* baseline_file -- file to write
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bench_save(results, num, BENCH_BASELINE_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the baseline folder and file
+ *
+ */
+
+void bench_save(bench_result_str* results, uint32_t num_results, const char* baseline_file);
+
+/*
+ * NAME
+ *
+ *   bench_evolution
+ *
+ * DESCRIPTION
+ *
+ *  Benchmarks the whole evolution loop end to end with the synthetic
+ *  evaluator of mock.h standing in for the fitness functions. The same
+ *  run is repeated with 1, 2, 4 and so on up to max_workers evaluation
+ *  threads, and for each one a JSON line is printed with the generations
+ *  and evaluations per second, how busy the evaluators were kept, and the
+ *  speedup and efficiency relative to a single worker. Every run starts
+ *  from the same seed, so all of them evolve the same individuals
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to print to
+ *  mock_config_str* config -- cost, latency and noise of every evaluation
+ *  osaka_object_typ ot -- object type of the genes
+ *  uint32_t num_gens -- generations per run
+ *  uint32_t pop_size -- individuals in the population
+ *  uint32_t genome_len -- genes per individual
+ *  uint32_t max_workers -- largest number of evaluation threads, at most EVOLUTION_MAX_WORKERS
+ *  bool cache -- whether the runs also write a run log
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of runs
+ *
+ * EXAMPLE
+ *
+ *  bench_evolution(stdout, &config, SIMPLE, 10, 100, 20, 8, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the evolution several times, changes the random seed
+ *
+ */
+
+uint32_t bench_evolution(FILE* stream, mock_config_str* config, osaka_object_typ ot, uint32_t num_gens, uint32_t pop_size, uint32_t genome_len, uint32_t max_workers, bool cache);
+
+#endif /* SUPPORT_BENCH_H_ */
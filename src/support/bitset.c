@@ -0,0 +1,638 @@
+/*
+ ============================================================================
+ Name        : bitset.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Packed genomes of BINARY_UP_TO_512 individuals and the
+               OneMax, target sum and knapsack kernels over them, which
+               work on sixteen genes a word with bit tricks and popcount
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "bitset.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BITSET_X86
+#endif
+
+// bit 0 of every gene, and every gene equal to 1
+#define BITSET_LOW 0x1111111111111111ULL
+
+/*
+ * STATIC
+ */
+
+static bitset_problem_typ bitset_problem = BITSET_ONEMAX;
+static uint64_t bitset_target;
+
+// bit g of word w of plane b is bit b of the weight of position 64 w + g
+static uint64_t bitset_planes[BITSET_WEIGHT_BITS][BITSET_PLANE_WORDS];
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __bitset_set
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, bit 0 of every gene of a word set where the gene is
+ *  not 0, the other bits clear
+ *
+ * PARAMETERS
+ *
+ *  uint64_t word -- sixteen packed genes
+ *
+ * RETURN
+ *
+ *  uint64_t -- one bit per gene, at the bottom of each
+ *
+ * EXAMPLE
+ *
+ *  ones += __builtin_popcountll(__bitset_set(genome->words[w]));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline uint64_t __bitset_set(uint64_t word) {
+
+    return (word | word >> 1 | word >> 2 | word >> 3) & BITSET_LOW;
+
+}
+
+/*
+ * NAME
+ *
+ *   __bitset_compress
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, moves bit 0 of each of the sixteen genes of a word
+ *  next to each other, halving the gaps between them at every step
+ *
+ * PARAMETERS
+ *
+ *  uint64_t bits -- bits at the bottom of the genes, as __bitset_set gives them
+ *
+ * RETURN
+ *
+ *  uint64_t -- the sixteen bits in bits 0 to 15, gene g in bit g
+ *
+ * EXAMPLE
+ *
+ *  selected |= __bitset_compress(__bitset_set(word)) << 16 * q;
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline uint64_t __bitset_compress(uint64_t bits) {
+
+    bits = (bits | bits >> 3) & 0x0303030303030303ULL;
+    bits = (bits | bits >> 6) & 0x000F000F000F000FULL;
+    bits = (bits | bits >> 12) & 0x000000FF000000FFULL;
+    bits = (bits | bits >> 24) & 0x000000000000FFFFULL;
+
+    return bits;
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_pack
+ *
+ * DESCRIPTION
+ *
+ *  Packs the binaries of a BINARY_UP_TO_512 individual into a genome,
+ *  gene g in bits 4 (g % 16) to 4 (g % 16) + 3 of word g / 16, the rest
+ *  of the words up to the next 64 genes left at zero
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- a BINARY_UP_TO_512 individual
+ *  bitset_genome_str* genome -- filled with the packed genes
+ *
+ * RETURN
+ *
+ *  bool -- false if the individual has more than BITSET_MAX_GENES genes
+ *
+ * EXAMPLE
+ *
+ *  bool packed = bitset_pack(indiv, &genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool bitset_pack(node_str* indiv, bitset_genome_str* genome) {
+
+    uint32_t length = 0;
+
+    for (node_str* node = indiv; node != NULL; node = NEXT(node), length++) {
+
+        if (length == BITSET_MAX_GENES) {
+            printf("error: individuals of more than %d genes cannot be packed [file:\'%s\',line:%d]\n", BITSET_MAX_GENES, __FILE__, __LINE__);
+            return false;
+        }
+
+        assert(OBJECT_TYPE(node) == BINARY_UP_TO_512);
+
+        uint64_t index = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(((object_binary_up_to_512_str*) OBJECT(node)));
+
+        if (length % BITSET_GENES_PER_WORD == 0) {
+            genome->words[length / BITSET_GENES_PER_WORD] = 0;
+        }
+        genome->words[length / BITSET_GENES_PER_WORD] |= index << (BITSET_GENE_BITS * (length % BITSET_GENES_PER_WORD));
+
+    }
+
+    // the kernels read the words up to the next 64 genes
+    for (uint32_t w = (length + BITSET_GENES_PER_WORD - 1) / BITSET_GENES_PER_WORD; w % 4 != 0; w++) {
+        genome->words[w] = 0;
+    }
+
+    genome->length = length;
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __bitset_onemax
+ *
+ * DESCRIPTION
+ *
+ *  Internal kernel of bitset_onemax, inlined into a variant built with the
+ *  popcount instruction and into one built without
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of one bits
+ *
+ * EXAMPLE
+ *
+ *  uint32_t ones = __bitset_onemax(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline __attribute__((always_inline)) uint32_t __bitset_onemax(const bitset_genome_str* genome) {
+
+    uint32_t words = (genome->length + BITSET_GENES_PER_WORD - 1) / BITSET_GENES_PER_WORD;
+    uint32_t ones = 0;
+
+    for (uint32_t w = 0; w < words; w++) {
+        ones += __builtin_popcountll(__bitset_set(genome->words[w]));
+    }
+
+    return ones;
+
+}
+
+/*
+ * NAME
+ *
+ *   __bitset_sum
+ *
+ * DESCRIPTION
+ *
+ *  Internal kernel of bitset_sum, inlined into a variant built with the
+ *  popcount instruction and into one built without
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the sum
+ *
+ * EXAMPLE
+ *
+ *  uint64_t sum = __bitset_sum(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline __attribute__((always_inline)) uint64_t __bitset_sum(const bitset_genome_str* genome) {
+
+    uint32_t words = (genome->length + BITSET_GENES_PER_WORD - 1) / BITSET_GENES_PER_WORD;
+    uint64_t sum = 0;
+
+    // the genes equal to index i are the ones left at 0 by an exclusive or with i in every gene
+    for (uint32_t i = 1; i < BITSET_NUM_VALUES; i++) {
+
+        uint64_t pattern = i * BITSET_LOW;
+        uint64_t count = 0;
+
+        for (uint32_t w = 0; w < words; w++) {
+            count += __builtin_popcountll(~__bitset_set(genome->words[w] ^ pattern) & BITSET_LOW);
+        }
+
+        sum += count * binary_up_to_512_binary_values[i];
+
+    }
+
+    return sum;
+
+}
+
+/*
+ * NAME
+ *
+ *   __bitset_weight
+ *
+ * DESCRIPTION
+ *
+ *  Internal kernel of bitset_weight, inlined into a variant built with the
+ *  popcount instruction and into one built without
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the weight
+ *
+ * EXAMPLE
+ *
+ *  uint64_t weight = __bitset_weight(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline __attribute__((always_inline)) uint64_t __bitset_weight(const bitset_genome_str* genome) {
+
+    uint32_t words = (genome->length + BITSET_GENES_PER_WORD - 1) / BITSET_GENES_PER_WORD;
+    uint64_t weight = 0;
+
+    for (uint32_t p = 0; p * 4 < words; p++) {
+
+        uint64_t selected = 0;
+
+        // bitset_pack clears the words up to the next 64 genes
+        for (uint32_t q = 0; q < 4; q++) {
+            selected |= __bitset_compress(__bitset_set(genome->words[4 * p + q])) << (16 * q);
+        }
+
+        for (uint32_t b = 0; b < BITSET_WEIGHT_BITS; b++) {
+            weight += (uint64_t) __builtin_popcountll(bitset_planes[b][p] & selected) << b;
+        }
+
+    }
+
+    return weight;
+
+}
+
+
+/*
+ * VARIANTS
+ */
+
+// every kernel as a function of its own, and on x86 once more built with the popcount instruction
+#define BITSET_VARIANT(type, kernel, variant, attribute) \
+    attribute static type __##kernel##_##variant(const bitset_genome_str* genome) { return __##kernel(genome); }
+
+BITSET_VARIANT(uint32_t, bitset_onemax, default, )
+BITSET_VARIANT(uint64_t, bitset_sum, default, )
+BITSET_VARIANT(uint64_t, bitset_weight, default, )
+
+#ifdef BITSET_X86
+BITSET_VARIANT(uint32_t, bitset_onemax, popcnt, __attribute__((target("popcnt"))))
+BITSET_VARIANT(uint64_t, bitset_sum, popcnt, __attribute__((target("popcnt"))))
+BITSET_VARIANT(uint64_t, bitset_weight, popcnt, __attribute__((target("popcnt"))))
+#endif
+
+// the variants in use, picked once by __bitset_select_kernels
+static uint32_t (*bitset_onemax_kernel)(const bitset_genome_str* genome) = __bitset_onemax_default;
+static uint64_t (*bitset_sum_kernel)(const bitset_genome_str* genome) = __bitset_sum_default;
+static uint64_t (*bitset_weight_kernel)(const bitset_genome_str* genome) = __bitset_weight_default;
+static pthread_once_t bitset_once = PTHREAD_ONCE_INIT;
+
+/*
+ * NAME
+ *
+ *   __bitset_select_kernels
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, points the kernels at the variants built with the
+ *  popcount instruction when the processor has it. Picked at run time
+ *  rather than by the loader, so that nothing runs before the sanitizer
+ *  runtimes are set up
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  pthread_once(&bitset_once, __bitset_select_kernels);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the kernel pointers
+ *
+ */
+
+void __bitset_select_kernels(void) {
+
+#ifdef BITSET_X86
+    if (__builtin_cpu_supports("popcnt")) {
+        bitset_onemax_kernel = __bitset_onemax_popcnt;
+        bitset_sum_kernel = __bitset_sum_popcnt;
+        bitset_weight_kernel = __bitset_weight_popcnt;
+    }
+#endif
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_onemax
+ *
+ * DESCRIPTION
+ *
+ *  Number of one bits in the bit string of a genome, every gene giving the
+ *  binary it holds. As every binary but 0 is a single bit, this counts the
+ *  genes that are not 0, sixteen at a time
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of one bits
+ *
+ * EXAMPLE
+ *
+ *  uint32_t ones = bitset_onemax(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t bitset_onemax(const bitset_genome_str* genome) {
+
+    pthread_once(&bitset_once, __bitset_select_kernels);
+
+    return bitset_onemax_kernel(genome);
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_sum
+ *
+ * DESCRIPTION
+ *
+ *  Sum of the binaries of a genome. The genes equal to each index are
+ *  counted sixteen at a time and the binary of the index is that count's
+ *  weight, so no gene is looked at on its own
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the sum
+ *
+ * EXAMPLE
+ *
+ *  uint64_t sum = bitset_sum(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t bitset_sum(const bitset_genome_str* genome) {
+
+    pthread_once(&bitset_once, __bitset_select_kernels);
+
+    return bitset_sum_kernel(genome);
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_weight
+ *
+ * DESCRIPTION
+ *
+ *  Knapsack weight of a genome, the sum of the weights of the positions
+ *  whose gene is not 0. The genes are turned into one bit each, 64 to a
+ *  word, and every bit plane of the weights adds the popcount of its
+ *  overlap with them, shifted by its place
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the weight
+ *
+ * EXAMPLE
+ *
+ *  uint64_t weight = bitset_weight(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t bitset_weight(const bitset_genome_str* genome) {
+
+    pthread_once(&bitset_once, __bitset_select_kernels);
+
+    return bitset_weight_kernel(genome);
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_set_problem
+ *
+ * DESCRIPTION
+ *
+ *  Sets the problem the BINARY_UP_TO_512 fitness solves. BITSET_ONEMAX,
+ *  the problem until this is called, wants every gene set. BITSET_TARGET_SUM
+ *  wants the binaries to add up to the target. BITSET_KNAPSACK takes every
+ *  set gene as an item whose profit is its binary and whose weight, from 1
+ *  to 255, is drawn for its position from the seed, and wants the most
+ *  profit within a capacity of the target
+ *
+ * PARAMETERS
+ *
+ *  bitset_problem_typ problem -- the problem
+ *  uint64_t target -- the sum or the capacity, unused by BITSET_ONEMAX
+ *  uint64_t seed -- seed of the knapsack weights, unused by the other problems
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bitset_set_problem(BITSET_KNAPSACK, 1000, BITSET_DEFAULT_SEED);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the knapsack weights, not to be called during an evaluation
+ *
+ */
+
+void bitset_set_problem(bitset_problem_typ problem, uint64_t target, uint64_t seed) {
+
+    bitset_problem = problem;
+    bitset_target = target;
+
+    memset(bitset_planes, 0, sizeof(bitset_planes));
+
+    if (problem != BITSET_KNAPSACK) {
+        return;
+    }
+
+    // a generator of its own, so that the weights do not move the evolution's rand
+    uint64_t state = seed == 0 ? BITSET_DEFAULT_SEED : seed;
+
+    for (uint32_t g = 0; g < BITSET_MAX_GENES; g++) {
+
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        uint64_t weight = 1 + state % 255;
+
+        for (uint32_t b = 0; b < BITSET_WEIGHT_BITS; b++) {
+            bitset_planes[b][g / 64] |= ((weight >> b) & 1) << (g % 64);
+        }
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   bitset_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of a BINARY_UP_TO_512 individual on the current problem, lower
+ *  being better and 0 a solution: the genes that are not set for OneMax,
+ *  the distance from the target for the target sum, and for the knapsack
+ *  the profit left out of the most there could be, plus the excess weight
+ *  if over capacity
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- a BINARY_UP_TO_512 individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness, UINT32_MAX if the individual is too long to pack
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = bitset_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t bitset_fitness(node_str* indiv) {
+
+    bitset_genome_str genome;
+
+    if (!bitset_pack(indiv, &genome)) {
+        return UINT32_MAX;
+    }
+
+    uint64_t fitness;
+    uint64_t most = (uint64_t) genome.length * binary_up_to_512_binary_values[BITSET_NUM_VALUES - 1];
+
+    if (bitset_problem == BITSET_ONEMAX) {
+        fitness = genome.length - bitset_onemax(&genome);
+    }
+    else if (bitset_problem == BITSET_TARGET_SUM) {
+        uint64_t sum = bitset_sum(&genome);
+        fitness = sum > bitset_target ? sum - bitset_target : bitset_target - sum;
+    }
+    else {
+        uint64_t weight = bitset_weight(&genome);
+        fitness = weight > bitset_target ? most + weight - bitset_target : most - bitset_sum(&genome);
+    }
+
+    return fitness > UINT32_MAX ? UINT32_MAX : (uint32_t) fitness;
+
+}
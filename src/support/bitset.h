@@ -0,0 +1,281 @@
+/*
+ ============================================================================
+ Name        : bitset.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Packed genomes of BINARY_UP_TO_512 individuals, the index
+               of every gene's binary in 4 bits, sixteen genes to a
+               word, and fitness kernels that work on whole words at a
+               time with bit tricks and popcount: OneMax, a target sum
+               and a knapsack whose item weights are held as bit planes
+ ============================================================================
+ */
+
+#ifndef SUPPORT_BITSET_H_
+#define SUPPORT_BITSET_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../module/binary_up_to_512.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * MACROS
+ */
+
+// genes of 4 bits per word of the packed genome
+#define BITSET_GENE_BITS 4
+#define BITSET_GENES_PER_WORD 16
+#define BITSET_MAX_GENES 4096
+#define BITSET_MAX_WORDS (BITSET_MAX_GENES / BITSET_GENES_PER_WORD)
+#define BITSET_NUM_VALUES (sizeof(binary_up_to_512_binary_values) / sizeof(uint32_t))
+
+// knapsack weights are 1 to 255, one bit plane per bit of the weights
+#define BITSET_WEIGHT_BITS 8
+#define BITSET_PLANE_WORDS (BITSET_MAX_GENES / 64)
+#define BITSET_DEFAULT_SEED 1
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    BITSET_ONEMAX,
+    BITSET_TARGET_SUM,
+    BITSET_KNAPSACK
+} bitset_problem_typ;
+
+// a gene is the index of its binary into binary_up_to_512_binary_values, 0 being the binary 0
+typedef struct bitset_genome_str {
+    uint32_t length;
+    uint64_t words[BITSET_MAX_WORDS];
+} bitset_genome_str;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   bitset_pack
+ *
+ * DESCRIPTION
+ *
+ *  Packs the binaries of a BINARY_UP_TO_512 individual into a genome,
+ *  gene g in bits 4 (g % 16) to 4 (g % 16) + 3 of word g / 16, the rest
+ *  of the words up to the next 64 genes left at zero
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- a BINARY_UP_TO_512 individual
+ *  bitset_genome_str* genome -- filled with the packed genes
+ *
+ * RETURN
+ *
+ *  bool -- false if the individual has more than BITSET_MAX_GENES genes
+ *
+ * EXAMPLE
+ *
+ *  bool packed = bitset_pack(indiv, &genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool bitset_pack(node_str* indiv, bitset_genome_str* genome);
+
+/*
+ * NAME
+ *
+ *   bitset_onemax
+ *
+ * DESCRIPTION
+ *
+ *  Number of one bits in the bit string of a genome, every gene giving the
+ *  binary it holds. As every binary but 0 is a single bit, this counts the
+ *  genes that are not 0, sixteen at a time
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of one bits
+ *
+ * EXAMPLE
+ *
+ *  uint32_t ones = bitset_onemax(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t bitset_onemax(const bitset_genome_str* genome);
+
+/*
+ * NAME
+ *
+ *   bitset_sum
+ *
+ * DESCRIPTION
+ *
+ *  Sum of the binaries of a genome. The genes equal to each index are
+ *  counted sixteen at a time and the binary of the index is that count's
+ *  weight, so no gene is looked at on its own
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the sum
+ *
+ * EXAMPLE
+ *
+ *  uint64_t sum = bitset_sum(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t bitset_sum(const bitset_genome_str* genome);
+
+/*
+ * NAME
+ *
+ *   bitset_weight
+ *
+ * DESCRIPTION
+ *
+ *  Knapsack weight of a genome, the sum of the weights of the positions
+ *  whose gene is not 0. The genes are turned into one bit each, 64 to a
+ *  word, and every bit plane of the weights adds the popcount of its
+ *  overlap with them, shifted by its place
+ *
+ * PARAMETERS
+ *
+ *  const bitset_genome_str* genome -- a packed genome
+ *
+ * RETURN
+ *
+ *  uint64_t -- the weight
+ *
+ * EXAMPLE
+ *
+ *  uint64_t weight = bitset_weight(&genome);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t bitset_weight(const bitset_genome_str* genome);
+
+/*
+ * NAME
+ *
+ *   bitset_set_problem
+ *
+ * DESCRIPTION
+ *
+ *  Sets the problem the BINARY_UP_TO_512 fitness solves. BITSET_ONEMAX,
+ *  the problem until this is called, wants every gene set. BITSET_TARGET_SUM
+ *  wants the binaries to add up to the target. BITSET_KNAPSACK takes every
+ *  set gene as an item whose profit is its binary and whose weight, from 1
+ *  to 255, is drawn for its position from the seed, and wants the most
+ *  profit within a capacity of the target
+ *
+ * PARAMETERS
+ *
+ *  bitset_problem_typ problem -- the problem
+ *  uint64_t target -- the sum or the capacity, unused by BITSET_ONEMAX
+ *  uint64_t seed -- seed of the knapsack weights, unused by the other problems
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  bitset_set_problem(BITSET_KNAPSACK, 1000, BITSET_DEFAULT_SEED);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the knapsack weights, not to be called during an evaluation
+ *
+ */
+
+void bitset_set_problem(bitset_problem_typ problem, uint64_t target, uint64_t seed);
+
+/*
+ * NAME
+ *
+ *   bitset_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of a BINARY_UP_TO_512 individual on the current problem, lower
+ *  being better and 0 a solution: the genes that are not set for OneMax,
+ *  the distance from the target for the target sum, and for the knapsack
+ *  the profit left out of the most there could be, plus the excess weight
+ *  if over capacity
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- a BINARY_UP_TO_512 individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness, UINT32_MAX if the individual is too long to pack
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = bitset_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t bitset_fitness(node_str* indiv);
+
+#endif /* SUPPORT_BITSET_H_ */
@@ -0,0 +1,859 @@
+/*
+ ============================================================================
+ Name        : distance.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : String distance fitness of OSAKA_STRING individuals, by
+               the bit parallel edit distance of Myers or by Hamming
+               distance, streamed over the strings of an individual
+               without joining them, and batched over a population in
+               the lanes of a vector
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "distance.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DISTANCE_X86
+#endif
+
+/*
+ * STATIC
+ */
+
+// lanes of 64 bits, lowered to whatever vector instructions the target has
+typedef uint64_t distance_vector_typ __attribute__((vector_size(DISTANCE_LANES * sizeof(uint64_t))));
+
+static char distance_target[DISTANCE_MAX_TARGET + 1];
+static uint32_t distance_length;
+static uint32_t distance_words;
+static distance_typ distance_metric = DISTANCE_EDIT;
+
+// bit i of word w for character c is set where the target has c at 64 w + i
+static uint64_t distance_peq[256][DISTANCE_MAX_WORDS];
+
+static distance_memo_str distance_memo[DISTANCE_MEMO_SIZE];
+static pthread_mutex_t distance_memo_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t distance_once = PTHREAD_ONCE_INIT;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __distance_build
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, takes a target and metric and builds the match
+ *  vectors of the target, emptying the memo
+ *
+ * PARAMETERS
+ *
+ *  const char* target -- the target sentence
+ *  distance_typ metric -- DISTANCE_EDIT or DISTANCE_HAMMING
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __distance_build(DISTANCE_DEFAULT_TARGET, DISTANCE_EDIT);
+ *
+ * SIDE-EFFECT
+ *
+ *  exits if the target is empty or too long
+ *
+ */
+
+void __distance_build(const char* target, distance_typ metric) {
+
+    size_t length = strlen(target);
+
+    if (length == 0 || length > DISTANCE_MAX_TARGET) {
+        printf("error: the target sentence must have 1 to %d characters [file:\'%s\',line:%d]\n", DISTANCE_MAX_TARGET, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    strcpy(distance_target, target);
+    distance_length = (uint32_t) length;
+    distance_words = (distance_length + DISTANCE_WORD_BITS - 1) / DISTANCE_WORD_BITS;
+    distance_metric = metric;
+
+    memset(distance_peq, 0, sizeof(distance_peq));
+    for (uint32_t i = 0; i < distance_length; i++) {
+        distance_peq[(unsigned char) distance_target[i]][i / DISTANCE_WORD_BITS] |= 1ULL << (i % DISTANCE_WORD_BITS);
+    }
+
+    pthread_mutex_lock(&distance_memo_lock);
+    memset(distance_memo, 0, sizeof(distance_memo));
+    pthread_mutex_unlock(&distance_memo_lock);
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_default_target
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, sets the default target the first time a distance
+ *  is asked for
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  pthread_once(&distance_once, __distance_default_target);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds the match vectors of the target
+ *
+ */
+
+void __distance_default_target(void) {
+
+    __distance_build(DISTANCE_DEFAULT_TARGET, DISTANCE_EDIT);
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_start
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, puts a cursor on the first character of an individual
+ *
+ * PARAMETERS
+ *
+ *  distance_cursor_str* cursor -- the cursor
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __distance_start(&cursor, indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline void __distance_start(distance_cursor_str* cursor, node_str* indiv) {
+
+    assert(OBJECT_TYPE(indiv) == OSAKA_STRING);
+
+    cursor->node = indiv;
+    cursor->c = MY_STRING(((object_osaka_string_str*) OBJECT(indiv)));
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_next
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, next character of the strings of an individual as if
+ *  they were joined by DISTANCE_SEPARATOR, read in place
+ *
+ * PARAMETERS
+ *
+ *  distance_cursor_str* cursor -- the cursor
+ *
+ * RETURN
+ *
+ *  int -- the character, -1 once there are none left
+ *
+ * EXAMPLE
+ *
+ *  for (int c = __distance_next(&cursor); c >= 0; c = __distance_next(&cursor)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  moves the cursor
+ *
+ */
+
+static inline int __distance_next(distance_cursor_str* cursor) {
+
+    if (*cursor->c != '\0') {
+        return (unsigned char) *cursor->c++;
+    }
+
+    cursor->node = cursor->node == NULL ? NULL : NEXT(cursor->node);
+
+    if (cursor->node == NULL) {
+        return -1;
+    }
+
+    assert(OBJECT_TYPE(cursor->node) == OSAKA_STRING);
+    cursor->c = MY_STRING(((object_osaka_string_str*) OBJECT(cursor->node)));
+
+    return DISTANCE_SEPARATOR;
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_block
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, one step of the edit distance for one word of the
+ *  target: updates the vertical deltas of the word for the next character
+ *  of the individual, given the horizontal delta that comes in under the
+ *  word, and gives the one that goes out at the bit that is watched
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* pv -- positive vertical deltas of the word
+ *  uint64_t* mv -- negative vertical deltas of the word
+ *  uint64_t eq -- bits of the word that match the character
+ *  int hin -- horizontal delta coming in, -1, 0 or 1
+ *  uint64_t out -- the bit whose horizontal delta goes out, the top one but in the last word
+ *
+ * RETURN
+ *
+ *  int -- horizontal delta going out, -1, 0 or 1
+ *
+ * EXAMPLE
+ *
+ *  hin = __distance_block(&pv[w], &mv[w], eq[w], hin, out);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline int __distance_block(uint64_t* pv, uint64_t* mv, uint64_t eq, int hin, uint64_t out) {
+
+    uint64_t negative = hin < 0 ? 1 : 0;
+    uint64_t xv = eq | *mv;
+
+    eq |= negative;
+
+    uint64_t xh = (((eq & *pv) + *pv) ^ *pv) | eq;
+    uint64_t ph = *mv | ~(xh | *pv);
+    uint64_t mh = *pv & xh;
+    int hout = ((ph & out) != 0) - ((mh & out) != 0);
+
+    ph = (ph << 1) | (hin > 0 ? 1 : 0);
+    mh = (mh << 1) | negative;
+
+    *pv = mh | ~(xv | ph);
+    *mv = ph & xv;
+
+    return hout;
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_mismatches
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, number of positions at which two runs of characters
+ *  differ, eight at a time: the differing bits of each byte are folded
+ *  into its lowest bit and the lowest bits counted
+ *
+ * PARAMETERS
+ *
+ *  const char* a -- first run
+ *  const char* b -- second run
+ *  size_t n -- length of the runs
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of differing positions
+ *
+ * EXAMPLE
+ *
+ *  mismatches += __distance_mismatches(s, distance_target + p, overlap);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t __distance_mismatches(const char* a, const char* b, size_t n) {
+
+    uint32_t mismatches = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+
+        uint64_t x = wa ^ wb;
+        x |= x >> 4;
+        x |= x >> 2;
+        x |= x >> 1;
+        mismatches += __builtin_popcountll(x & 0x0101010101010101ULL);
+
+    }
+
+    for (; i < n; i++) {
+        mismatches += a[i] != b[i];
+    }
+
+    return mismatches;
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_gather
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, reads the characters of an individual once and keeps
+ *  the match bits of each for a target of one word, so that a lane of
+ *  __distance_batch_edit steps through them without a branch a character
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *  uint64_t** eq -- buffer of match bits, grown as needed
+ *  uint32_t* capacity -- number of match bits the buffer holds
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of characters of the individual, separators included
+ *
+ * EXAMPLE
+ *
+ *  lengths[l] = __distance_gather(indivs[k], &eqs[l], &capacities[l]);
+ *
+ * SIDE-EFFECT
+ *
+ *  reallocs the buffer
+ *
+ */
+
+uint32_t __distance_gather(node_str* indiv, uint64_t** eq, uint32_t* capacity) {
+
+    distance_cursor_str cursor;
+    uint32_t length = 0;
+
+    __distance_start(&cursor, indiv);
+
+    for (int c = __distance_next(&cursor); c >= 0; c = __distance_next(&cursor)) {
+
+        if (length == *capacity) {
+            *capacity = *capacity == 0 ? 256 : 2 * *capacity;
+            *eq = realloc(*eq, *capacity * sizeof(uint64_t));
+            assert(*eq != NULL);
+        }
+
+        (*eq)[length++] = distance_peq[c][0];
+
+    }
+
+    return length;
+
+}
+
+/*
+ * NAME
+ *
+ *   __distance_batch_edit
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, edit distances of many individuals to a target of one
+ *  word, with DISTANCE_LANES individuals in the lanes of a vector and the
+ *  step of __distance_block run on all of them at once. The lanes run
+ *  together for as many characters as the one closest to the end of its
+ *  individual has left, then that lane records its distance and takes the
+ *  next individual. Compiled for AVX2, where a vector holds all the lanes
+ *
+ * PARAMETERS
+ *
+ *  node_str** indivs -- OSAKA_STRING individuals
+ *  uint32_t num_indivs -- number of individuals
+ *  uint32_t* distances -- filled with the distance of every individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __distance_batch_edit(gen, pop_size, distances);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+#ifdef DISTANCE_X86
+__attribute__((target("avx2")))
+#endif
+void __distance_batch_edit(node_str** indivs, uint32_t num_indivs, uint32_t* distances) {
+
+    distance_vector_typ pv = { 0 }, mv = { 0 }, score = { 0 }, keep;
+    uint64_t* eqs[DISTANCE_LANES] = { NULL };
+    const uint64_t* at[DISTANCE_LANES];
+    uint32_t capacities[DISTANCE_LANES] = { 0 };
+    uint32_t lengths[DISTANCE_LANES] = { 0 };
+    uint32_t positions[DISTANCE_LANES] = { 0 };
+    uint32_t owner[DISTANCE_LANES];
+    uint64_t keeps[DISTANCE_LANES];
+    uint64_t scores[DISTANCE_LANES];
+    uint32_t shift = distance_length - 1;
+    uint32_t next = 0;
+
+    for (uint32_t l = 0; l < DISTANCE_LANES; l++) {
+        owner[l] = UINT32_MAX;
+    }
+
+    do {
+
+        uint32_t run = UINT32_MAX;
+        int32_t busy = -1;
+
+        memcpy(scores, &score, sizeof(scores));
+
+        // a lane at the end of its individual records it and takes the next one, clearing its keep mask
+        for (uint32_t l = 0; l < DISTANCE_LANES; l++) {
+
+            keeps[l] = ~0ULL;
+
+            while (positions[l] == lengths[l]) {
+
+                if (owner[l] != UINT32_MAX) {
+                    distances[owner[l]] = keeps[l] ? (uint32_t) scores[l] : distance_length;
+                    owner[l] = UINT32_MAX;
+                }
+                if (next == num_indivs) {
+                    break;
+                }
+
+                owner[l] = next++;
+                keeps[l] = 0;
+                positions[l] = 0;
+                lengths[l] = __distance_gather(indivs[owner[l]], &eqs[l], &capacities[l]);
+
+            }
+
+            if (owner[l] != UINT32_MAX) {
+                run = lengths[l] - positions[l] < run ? lengths[l] - positions[l] : run;
+                at[l] = eqs[l] + positions[l];
+                busy = l;
+            }
+
+        }
+
+        if (busy < 0) {
+            break;
+        }
+
+        // an idle lane reads along with a busy one and its result is never recorded
+        for (uint32_t l = 0; l < DISTANCE_LANES; l++) {
+            if (owner[l] == UINT32_MAX) {
+                at[l] = at[busy];
+            }
+            else {
+                positions[l] += run;
+            }
+        }
+
+        keep = (distance_vector_typ) { keeps[0], keeps[1], keeps[2], keeps[3] };
+        pv |= ~keep;
+        mv &= keep;
+        score = (score & keep) | (~keep & distance_length);
+
+        // __distance_block with a horizontal delta of one coming in, lane by lane
+        for (uint32_t i = 0; i < run; i++) {
+
+            distance_vector_typ eq = { at[0][i], at[1][i], at[2][i], at[3][i] };
+            distance_vector_typ xv = eq | mv;
+            distance_vector_typ xh = (((eq & pv) + pv) ^ pv) | eq;
+            distance_vector_typ ph = mv | ~(xh | pv);
+            distance_vector_typ mh = pv & xh;
+
+            score += ((ph >> shift) & 1) - ((mh >> shift) & 1);
+
+            ph = (ph << 1) | 1;
+            mh = mh << 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+        }
+
+    } while (true);
+
+    for (uint32_t l = 0; l < DISTANCE_LANES; l++) {
+        free(eqs[l]);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_set_target
+ *
+ * DESCRIPTION
+ *
+ *  Sets the sentence OSAKA_STRING individuals are compared with and the
+ *  distance they are compared by. Until it is called the target is
+ *  DISTANCE_DEFAULT_TARGET, by edit distance
+ *
+ * PARAMETERS
+ *
+ *  const char* target -- the sentence, 1 to DISTANCE_MAX_TARGET characters
+ *  distance_typ metric -- edit or Hamming distance
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_set_target("lamb as white as snow", DISTANCE_HAMMING);
+ *
+ * SIDE-EFFECT
+ *
+ *  rebuilds the match vectors of the target and empties the memo, not to be called during an evaluation
+ *
+ */
+
+void distance_set_target(const char* target, distance_typ metric) {
+
+    // the default target is built first, never over the one built here
+    pthread_once(&distance_once, __distance_default_target);
+    __distance_build(target, metric);
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_edit
+ *
+ * DESCRIPTION
+ *
+ *  Edit distance between the strings of an individual, joined by spaces,
+ *  and the target. The target is held as bit vectors, one bit per
+ *  character, and each character of the individual updates a whole
+ *  column of the distance matrix with a few word operations, as Myers
+ *  does it, extended to targets longer than a word as Hyyro does
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the number of insertions, deletions and substitutions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t d = distance_edit(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+uint32_t distance_edit(node_str* indiv) {
+
+    uint64_t pv[DISTANCE_MAX_WORDS];
+    uint64_t mv[DISTANCE_MAX_WORDS];
+    distance_cursor_str cursor;
+
+    pthread_once(&distance_once, __distance_default_target);
+
+    uint32_t last = distance_words - 1;
+    uint64_t out = 1ULL << ((distance_length - 1) % DISTANCE_WORD_BITS);
+    int64_t score = distance_length;
+
+    for (uint32_t w = 0; w < distance_words; w++) {
+        pv[w] = ~0ULL;
+        mv[w] = 0;
+    }
+
+    __distance_start(&cursor, indiv);
+
+    // the top row of the matrix grows by one a character, so a delta of one comes in under the first word
+    for (int c = __distance_next(&cursor); c >= 0; c = __distance_next(&cursor)) {
+
+        int h = 1;
+
+        for (uint32_t w = 0; w < last; w++) {
+            h = __distance_block(&pv[w], &mv[w], distance_peq[c][w], h, 1ULL << (DISTANCE_WORD_BITS - 1));
+        }
+        score += __distance_block(&pv[last], &mv[last], distance_peq[c][last], h, out);
+
+    }
+
+    return (uint32_t) score;
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_hamming
+ *
+ * DESCRIPTION
+ *
+ *  Hamming distance between the strings of an individual, joined by
+ *  spaces, and the target: the characters that differ position by
+ *  position, plus the difference in length. Each string is compared
+ *  with its place in the target eight characters at a time
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the number of differing positions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t d = distance_hamming(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+uint32_t distance_hamming(node_str* indiv) {
+
+    uint32_t mismatches = 0;
+    size_t p = 0;
+
+    pthread_once(&distance_once, __distance_default_target);
+
+    for (node_str* node = indiv; node != NULL; node = NEXT(node)) {
+
+        assert(OBJECT_TYPE(node) == OSAKA_STRING);
+
+        if (node != indiv) {
+            mismatches += p >= distance_length || distance_target[p] != DISTANCE_SEPARATOR;
+            p++;
+        }
+
+        const char* s = MY_STRING(((object_osaka_string_str*) OBJECT(node)));
+        size_t length = strlen(s);
+        size_t overlap = p >= distance_length ? 0 : (length < distance_length - p ? length : distance_length - p);
+
+        mismatches += __distance_mismatches(s, distance_target + p, overlap) + (uint32_t) (length - overlap);
+        p += length;
+
+    }
+
+    return mismatches + (p < distance_length ? (uint32_t) (distance_length - p) : 0);
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_batch
+ *
+ * DESCRIPTION
+ *
+ *  Distances of many individuals to the target by the current metric.
+ *  For edit distance to a target of one word on a CPU with AVX2,
+ *  DISTANCE_LANES individuals run side by side in the lanes of a vector,
+ *  a lane taking the next individual as soon as its own runs out of
+ *  characters
+ *
+ * PARAMETERS
+ *
+ *  node_str** indivs -- OSAKA_STRING individuals
+ *  uint32_t num_indivs -- number of individuals
+ *  uint32_t* distances -- filled with the distance of every individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_batch(gen, pop_size, distances);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+void distance_batch(node_str** indivs, uint32_t num_indivs, uint32_t* distances) {
+
+    pthread_once(&distance_once, __distance_default_target);
+
+#ifdef DISTANCE_X86
+    // with fewer lanes to a register the vectors lose to the plain loop
+    if (distance_metric == DISTANCE_EDIT && distance_words == 1 && __builtin_cpu_supports("avx2")) {
+        __distance_batch_edit(indivs, num_indivs, distances);
+        return;
+    }
+#endif
+
+    for (uint32_t k = 0; k < num_indivs; k++) {
+        distances[k] = distance_metric == DISTANCE_EDIT ? distance_edit(indivs[k]) : distance_hamming(indivs[k]);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a generation with distance_batch and keeps the distances in
+ *  the memo by osaka_hash of the individuals, where distance_fitness
+ *  finds them
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen -- the generation
+ *  uint32_t pop_size -- size of the generation
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_generation(current_generation, pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills the memo
+ *
+ */
+
+void distance_generation(node_str** gen, uint32_t pop_size) {
+
+    uint32_t* distances = malloc(pop_size * sizeof(uint32_t));
+    assert(distances != NULL);
+
+    distance_batch(gen, pop_size, distances);
+
+    pthread_mutex_lock(&distance_memo_lock);
+    for (uint32_t k = 0; k < pop_size; k++) {
+        uint64_t key = osaka_hash(gen[k]);
+        distance_memo[key & (DISTANCE_MEMO_SIZE - 1)] = (distance_memo_str) { key, distances[k], true };
+    }
+    pthread_mutex_unlock(&distance_memo_lock);
+
+    free(distances);
+
+}
+
+/*
+ * NAME
+ *
+ *   distance_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an OSAKA_STRING individual, its distance to the target by
+ *  the current metric, taken from the memo when the same strings were
+ *  evaluated before. Lower is better, zero is the target itself
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the distance
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = distance_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use, fills the memo
+ *
+ */
+
+uint32_t distance_fitness(node_str* indiv) {
+
+    pthread_once(&distance_once, __distance_default_target);
+
+    uint64_t key = osaka_hash(indiv);
+    distance_memo_str* entry = &distance_memo[key & (DISTANCE_MEMO_SIZE - 1)];
+
+    pthread_mutex_lock(&distance_memo_lock);
+    bool hit = entry->valid && entry->key == key;
+    uint32_t distance = entry->distance;
+    pthread_mutex_unlock(&distance_memo_lock);
+
+    if (hit) {
+        return distance;
+    }
+
+    distance = distance_metric == DISTANCE_EDIT ? distance_edit(indiv) : distance_hamming(indiv);
+
+    pthread_mutex_lock(&distance_memo_lock);
+    *entry = (distance_memo_str) { key, distance, true };
+    pthread_mutex_unlock(&distance_memo_lock);
+
+    return distance;
+
+}
@@ -0,0 +1,289 @@
+/*
+ ============================================================================
+ Name        : distance.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : String distance fitness of OSAKA_STRING individuals. The
+               strings of an individual, joined by spaces, are compared
+               with a target sentence by edit distance, with the bit
+               parallel algorithm of Myers, or by Hamming distance, as a
+               stream that is never put together into one string. A
+               population is evaluated in batches, several individuals
+               side by side in the lanes of a vector
+ ============================================================================
+ */
+
+#ifndef SUPPORT_DISTANCE_H_
+#define SUPPORT_DISTANCE_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../module/osaka_string.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * MACROS
+ */
+
+// the sentence the valid values of OSAKA_STRING make up
+#define DISTANCE_DEFAULT_TARGET "Mary had a little lamb whose fleece was white as snow"
+#define DISTANCE_MAX_TARGET 1024
+#define DISTANCE_SEPARATOR ' '
+
+// bits of the target per word of the bit vectors, and individuals per batch vector
+#define DISTANCE_WORD_BITS 64
+#define DISTANCE_MAX_WORDS (DISTANCE_MAX_TARGET / DISTANCE_WORD_BITS)
+#define DISTANCE_LANES 4
+
+// fitness memo entries, a power of two
+#define DISTANCE_MEMO_SIZE 4096
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    DISTANCE_EDIT,
+    DISTANCE_HAMMING
+} distance_typ;
+
+// position in the stream of characters of an individual
+typedef struct distance_cursor_str {
+    node_str* node;
+    const char* c;
+} distance_cursor_str;
+
+typedef struct distance_memo_str {
+    uint64_t key;
+    uint32_t distance;
+    bool valid;
+} distance_memo_str;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   distance_set_target
+ *
+ * DESCRIPTION
+ *
+ *  Sets the sentence OSAKA_STRING individuals are compared with and the
+ *  distance they are compared by. Until it is called the target is
+ *  DISTANCE_DEFAULT_TARGET, by edit distance
+ *
+ * PARAMETERS
+ *
+ *  const char* target -- the sentence, 1 to DISTANCE_MAX_TARGET characters
+ *  distance_typ metric -- edit or Hamming distance
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_set_target("lamb as white as snow", DISTANCE_HAMMING);
+ *
+ * SIDE-EFFECT
+ *
+ *  rebuilds the match vectors of the target and empties the memo, not to be called during an evaluation
+ *
+ */
+
+void distance_set_target(const char* target, distance_typ metric);
+
+/*
+ * NAME
+ *
+ *   distance_edit
+ *
+ * DESCRIPTION
+ *
+ *  Edit distance between the strings of an individual, joined by spaces,
+ *  and the target. The target is held as bit vectors, one bit per
+ *  character, and each character of the individual updates a whole
+ *  column of the distance matrix with a few word operations, as Myers
+ *  does it, extended to targets longer than a word as Hyyro does
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the number of insertions, deletions and substitutions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t d = distance_edit(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+uint32_t distance_edit(node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   distance_hamming
+ *
+ * DESCRIPTION
+ *
+ *  Hamming distance between the strings of an individual, joined by
+ *  spaces, and the target: the characters that differ position by
+ *  position, plus the difference in length. Each string is compared
+ *  with its place in the target eight characters at a time
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the number of differing positions
+ *
+ * EXAMPLE
+ *
+ *  uint32_t d = distance_hamming(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+uint32_t distance_hamming(node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   distance_batch
+ *
+ * DESCRIPTION
+ *
+ *  Distances of many individuals to the target by the current metric.
+ *  For edit distance to a target of one word on a CPU with AVX2,
+ *  DISTANCE_LANES individuals run side by side in the lanes of a vector,
+ *  a lane taking the next individual as soon as its own runs out of
+ *  characters
+ *
+ * PARAMETERS
+ *
+ *  node_str** indivs -- OSAKA_STRING individuals
+ *  uint32_t num_indivs -- number of individuals
+ *  uint32_t* distances -- filled with the distance of every individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_batch(gen, pop_size, distances);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use
+ *
+ */
+
+void distance_batch(node_str** indivs, uint32_t num_indivs, uint32_t* distances);
+
+/*
+ * NAME
+ *
+ *   distance_generation
+ *
+ * DESCRIPTION
+ *
+ *  Evaluates a generation with distance_batch and keeps the distances in
+ *  the memo by osaka_hash of the individuals, where distance_fitness
+ *  finds them
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen -- the generation
+ *  uint32_t pop_size -- size of the generation
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  distance_generation(current_generation, pop_size);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills the memo
+ *
+ */
+
+void distance_generation(node_str** gen, uint32_t pop_size);
+
+/*
+ * NAME
+ *
+ *   distance_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an OSAKA_STRING individual, its distance to the target by
+ *  the current metric, taken from the memo when the same strings were
+ *  evaluated before. Lower is better, zero is the target itself
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- an OSAKA_STRING individual
+ *
+ * RETURN
+ *
+ *  uint32_t -- the distance
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = distance_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the default target on first use, fills the memo
+ *
+ */
+
+uint32_t distance_fitness(node_str* indiv);
+
+#endif /* SUPPORT_DISTANCE_H_ */
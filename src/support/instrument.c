@@ -0,0 +1,465 @@
+/*
+ ============================================================================
+ Name        : instrument.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Per-phase timing and counters. Phases of a generation are timed
+               with a monotonic clock and events such as node allocations are
+               counted, then reported per generation and for the whole run.
+               The INSTRUMENT_ macros only expand to calls when the framework
+               is built with make INSTRUMENT=1, otherwise they compile to
+               nothing
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "instrument.h"
+#include "output.h"
+
+/*
+ * STATIC
+ */
+
+static const char* instrument_phase_names[INSTRUMENT_NUM_PHASES] = {
+    "selection",
+    "crossover",
+    "mutation",
+    "copy and free",
+    "evaluation",
+    "  opt",
+    "  llvm-as and lli",
+    "cache I/O"
+};
+
+static const char* instrument_counter_names[INSTRUMENT_NUM_COUNTERS] = {
+    "node allocations",
+    "node bytes",
+    "node frees",
+    "evaluations",
+    "shell commands"
+};
+
+// statistics of the generation in progress, and of the run so far
+static instrument_stats_str instrument_window;
+static instrument_stats_str instrument_totals;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __instrument_clear
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that zeroes a set of statistics and restarts its wall
+ *  clock
+ *
+ * PARAMETERS
+ *
+ *  instrument_stats_str* stats -- statistics to clear
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __instrument_clear(&instrument_window);
+ *
+ * SIDE-EFFECT
+ *
+ *  resets every phase and counter of stats
+ *
+ */
+
+void __instrument_clear(instrument_stats_str* stats) {
+
+    for (uint32_t p = 0; p < INSTRUMENT_NUM_PHASES; p++) {
+        atomic_store(&stats->phase_ns[p], 0);
+        atomic_store(&stats->phase_calls[p], 0);
+    }
+    for (uint32_t c = 0; c < INSTRUMENT_NUM_COUNTERS; c++) {
+        atomic_store(&stats->counters[c], 0);
+    }
+
+    stats->start_ns = instrument_now_ns();
+    stats->wall_ns = 0;
+
+}
+
+/*
+ * NAME
+ *
+ *   __instrument_print
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that prints the breakdown table of a set of
+ *  statistics. Phases are shown with their share of the wall time, nested
+ *  phases (opt, llvm-as and lli) are part of evaluation, and phases timed
+ *  on several threads at once can add up to more than the wall time
+ *
+ * PARAMETERS
+ *
+ *  const char* title -- heading of the table
+ *  instrument_stats_str* stats -- statistics to print
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __instrument_print("Totals for the run", &instrument_totals);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to stdout
+ *
+ */
+
+void __instrument_print(const char* title, instrument_stats_str* stats) {
+
+    double wall_ms = stats->wall_ns / 1e6;
+
+    output_printf(stdout, "\n%s, wall time %.3f ms ------------------------------\n\n", title, wall_ms);
+    output_printf(stdout, "\t%-20s %10s %14s %12s %8s\n", "phase", "calls", "total ms", "mean us", "% wall");
+
+    for (uint32_t p = 0; p < INSTRUMENT_NUM_PHASES; p++) {
+
+        uint64_t calls = atomic_load(&stats->phase_calls[p]);
+        double total_ms = atomic_load(&stats->phase_ns[p]) / 1e6;
+
+        output_printf(stdout, "\t%-20s %10lu %14.3f %12.3f %7.1f%%\n", instrument_phase_names[p], (unsigned long) calls,
+            total_ms, calls > 0 ? total_ms * 1e3 / calls : 0.0, wall_ms > 0 ? 100.0 * total_ms / wall_ms : 0.0);
+
+    }
+
+    output_printf(stdout, "\n\t%-20s %10s\n", "counter", "value");
+    for (uint32_t c = 0; c < INSTRUMENT_NUM_COUNTERS; c++) {
+        output_printf(stdout, "\t%-20s %10lu\n", instrument_counter_names[c], (unsigned long) atomic_load(&stats->counters[c]));
+    }
+    output_printf(stdout, "\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_now_ns
+ *
+ * DESCRIPTION
+ *
+ *  Reads the monotonic clock, which unlike gettimeofday never jumps
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds since an arbitrary fixed point
+ *
+ * EXAMPLE
+ *
+ *  uint64_t start = instrument_now_ns();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_now_ns(void) {
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000ull + now.tv_nsec;
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_reset
+ *
+ * DESCRIPTION
+ *
+ *  Clears both the generation and the run statistics and restarts their
+ *  clocks
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_RESET();
+ *
+ * SIDE-EFFECT
+ *
+ *  resets all statistics
+ *
+ */
+
+void instrument_reset(void) {
+
+    __instrument_clear(&instrument_window);
+    __instrument_clear(&instrument_totals);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_add_time
+ *
+ * DESCRIPTION
+ *
+ *  Adds one timed call of a phase to the statistics, given the clock
+ *  readings at its start and its end
+ *
+ * PARAMETERS
+ *
+ *  instrument_phase_typ phase -- phase that was timed
+ *  uint64_t start_ns -- instrument_now_ns() at the start
+ *  uint64_t stop_ns -- instrument_now_ns() at the end
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  instrument_add_time(INSTRUMENT_PHASE_OPT, start, instrument_now_ns());
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the statistics
+ *
+ */
+
+void instrument_add_time(instrument_phase_typ phase, uint64_t start_ns, uint64_t stop_ns) {
+
+    uint64_t elapsed = stop_ns - start_ns;
+
+    atomic_fetch_add_explicit(&instrument_window.phase_ns[phase], elapsed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&instrument_window.phase_calls[phase], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&instrument_totals.phase_ns[phase], elapsed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&instrument_totals.phase_calls[phase], 1, memory_order_relaxed);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_add_count
+ *
+ * DESCRIPTION
+ *
+ *  Adds to one of the counters
+ *
+ * PARAMETERS
+ *
+ *  instrument_counter_typ counter -- counter to add to
+ *  uint64_t n -- amount to add
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  instrument_add_count(INSTRUMENT_COUNTER_NODE_BYTES, sizeof(node_str));
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the statistics
+ *
+ */
+
+void instrument_add_count(instrument_counter_typ counter, uint64_t n) {
+
+    atomic_fetch_add_explicit(&instrument_window.counters[counter], n, memory_order_relaxed);
+    atomic_fetch_add_explicit(&instrument_totals.counters[counter], n, memory_order_relaxed);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_phase_ns
+ *
+ * DESCRIPTION
+ *
+ *  Total time spent in a phase
+ *
+ * PARAMETERS
+ *
+ *  instrument_phase_typ phase -- phase to read
+ *  bool total -- true for the whole run, false for the current window
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds
+ *
+ * EXAMPLE
+ *
+ *  uint64_t opt_ns = instrument_phase_ns(INSTRUMENT_PHASE_OPT, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_phase_ns(instrument_phase_typ phase, bool total) {
+
+    return atomic_load(total ? &instrument_totals.phase_ns[phase] : &instrument_window.phase_ns[phase]);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_counter
+ *
+ * DESCRIPTION
+ *
+ *  Value of a counter
+ *
+ * PARAMETERS
+ *
+ *  instrument_counter_typ counter -- counter to read
+ *  bool total -- true for the whole run, false for the current window
+ *
+ * RETURN
+ *
+ *  uint64_t -- value of the counter
+ *
+ * EXAMPLE
+ *
+ *  uint64_t allocs = instrument_counter(INSTRUMENT_COUNTER_NODE_ALLOCS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_counter(instrument_counter_typ counter, bool total) {
+
+    return atomic_load(total ? &instrument_totals.counters[counter] : &instrument_window.counters[counter]);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_report_generation
+ *
+ * DESCRIPTION
+ *
+ *  Prints the breakdown of the current window as the report for a
+ *  generation and starts a new window
+ *
+ * PARAMETERS
+ *
+ *  uint32_t gen -- generation number, 0 for the initial population
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_GENERATION(g + 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to stdout, resets the generation statistics
+ *
+ */
+
+void instrument_report_generation(uint32_t gen) {
+
+    char title[60];
+
+    if (gen == 0) {
+        sprintf(title, "Instrumentation for the initial population");
+    }
+    else {
+        sprintf(title, "Instrumentation for generation %u", gen);
+    }
+
+    instrument_window.wall_ns = instrument_now_ns() - instrument_window.start_ns;
+    __instrument_print(title, &instrument_window);
+    __instrument_clear(&instrument_window);
+
+}
+
+/*
+ * NAME
+ *
+ *   instrument_report_totals
+ *
+ * DESCRIPTION
+ *
+ *  Prints the breakdown of the whole run since the last reset
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_TOTALS();
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to stdout
+ *
+ */
+
+void instrument_report_totals(void) {
+
+    instrument_totals.wall_ns = instrument_now_ns() - instrument_totals.start_ns;
+    __instrument_print("Instrumentation totals for the run", &instrument_totals);
+
+}
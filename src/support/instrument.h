@@ -0,0 +1,349 @@
+/*
+ ============================================================================
+ Name        : instrument.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Per-phase timing and counters. Phases of a generation are timed
+               with a monotonic clock and events such as node allocations are
+               counted, then reported per generation and for the whole run.
+               The INSTRUMENT_ macros only expand to calls when the framework
+               is built with make INSTRUMENT=1, otherwise they compile to
+               nothing
+ ============================================================================
+ */
+
+#ifndef SUPPORT_INSTRUMENT_H_
+#define SUPPORT_INSTRUMENT_H_
+
+/*
+ * IMPORT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    INSTRUMENT_PHASE_SELECTION,
+    INSTRUMENT_PHASE_CROSSOVER,
+    INSTRUMENT_PHASE_MUTATION,
+    INSTRUMENT_PHASE_COPY,
+    INSTRUMENT_PHASE_EVALUATION,
+    INSTRUMENT_PHASE_OPT,
+    INSTRUMENT_PHASE_EXEC,
+    INSTRUMENT_PHASE_CACHE,
+    INSTRUMENT_NUM_PHASES
+} instrument_phase_typ;
+
+typedef enum {
+    INSTRUMENT_COUNTER_NODE_ALLOCS,
+    INSTRUMENT_COUNTER_NODE_BYTES,
+    INSTRUMENT_COUNTER_NODE_FREES,
+    INSTRUMENT_COUNTER_EVALUATIONS,
+    INSTRUMENT_COUNTER_COMMANDS,
+    INSTRUMENT_NUM_COUNTERS
+} instrument_counter_typ;
+
+// one set of statistics covers either the current generation or the whole run
+typedef struct instrument_stats_str {
+    _Atomic uint64_t phase_ns[INSTRUMENT_NUM_PHASES];
+    _Atomic uint64_t phase_calls[INSTRUMENT_NUM_PHASES];
+    _Atomic uint64_t counters[INSTRUMENT_NUM_COUNTERS];
+    uint64_t start_ns;
+    uint64_t wall_ns;
+} instrument_stats_str;
+
+/*
+ * MACROS
+ */
+
+// timers are started and stopped in pairs inside one scope, counters can be
+// bumped from any thread
+#ifdef SHACKLETON_INSTRUMENT
+#define INSTRUMENT_START(name) uint64_t __instrument_##name = instrument_now_ns()
+#define INSTRUMENT_STOP(name, phase) instrument_add_time(phase, __instrument_##name, instrument_now_ns())
+#define INSTRUMENT_COUNT(counter, n) instrument_add_count(counter, n)
+#define INSTRUMENT_RESET() instrument_reset()
+#define INSTRUMENT_GENERATION(gen) instrument_report_generation(gen)
+#define INSTRUMENT_TOTALS() instrument_report_totals()
+#else
+#define INSTRUMENT_START(name)
+#define INSTRUMENT_STOP(name, phase)
+#define INSTRUMENT_COUNT(counter, n)
+#define INSTRUMENT_RESET()
+#define INSTRUMENT_GENERATION(gen)
+#define INSTRUMENT_TOTALS()
+#endif
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   instrument_now_ns
+ *
+ * DESCRIPTION
+ *
+ *  Reads the monotonic clock, which unlike gettimeofday never jumps
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds since an arbitrary fixed point
+ *
+ * EXAMPLE
+ *
+ *  uint64_t start = instrument_now_ns();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_now_ns(void);
+
+/*
+ * NAME
+ *
+ *   instrument_reset
+ *
+ * DESCRIPTION
+ *
+ *  Clears both the generation and the run statistics and restarts their
+ *  clocks
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_RESET();
+ *
+ * SIDE-EFFECT
+ *
+ *  resets all statistics
+ *
+ */
+
+void instrument_reset(void);
+
+/*
+ * NAME
+ *
+ *   instrument_add_time
+ *
+ * DESCRIPTION
+ *
+ *  Adds one timed call of a phase to the statistics, given the clock
+ *  readings at its start and its end
+ *
+ * PARAMETERS
+ *
+ *  instrument_phase_typ phase -- phase that was timed
+ *  uint64_t start_ns -- instrument_now_ns() at the start
+ *  uint64_t stop_ns -- instrument_now_ns() at the end
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  instrument_add_time(INSTRUMENT_PHASE_OPT, start, instrument_now_ns());
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the statistics
+ *
+ */
+
+void instrument_add_time(instrument_phase_typ phase, uint64_t start_ns, uint64_t stop_ns);
+
+/*
+ * NAME
+ *
+ *   instrument_add_count
+ *
+ * DESCRIPTION
+ *
+ *  Adds to one of the counters
+ *
+ * PARAMETERS
+ *
+ *  instrument_counter_typ counter -- counter to add to
+ *  uint64_t n -- amount to add
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  instrument_add_count(INSTRUMENT_COUNTER_NODE_BYTES, sizeof(node_str));
+ *
+ * SIDE-EFFECT
+ *
+ *  updates the statistics
+ *
+ */
+
+void instrument_add_count(instrument_counter_typ counter, uint64_t n);
+
+/*
+ * NAME
+ *
+ *   instrument_phase_ns
+ *
+ * DESCRIPTION
+ *
+ *  Total time spent in a phase
+ *
+ * PARAMETERS
+ *
+ *  instrument_phase_typ phase -- phase to read
+ *  bool total -- true for the whole run, false for the current window
+ *
+ * RETURN
+ *
+ *  uint64_t -- nanoseconds
+ *
+ * EXAMPLE
+ *
+ *  uint64_t opt_ns = instrument_phase_ns(INSTRUMENT_PHASE_OPT, true);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_phase_ns(instrument_phase_typ phase, bool total);
+
+/*
+ * NAME
+ *
+ *   instrument_counter
+ *
+ * DESCRIPTION
+ *
+ *  Value of a counter
+ *
+ * PARAMETERS
+ *
+ *  instrument_counter_typ counter -- counter to read
+ *  bool total -- true for the whole run, false for the current window
+ *
+ * RETURN
+ *
+ *  uint64_t -- value of the counter
+ *
+ * EXAMPLE
+ *
+ *  uint64_t allocs = instrument_counter(INSTRUMENT_COUNTER_NODE_ALLOCS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t instrument_counter(instrument_counter_typ counter, bool total);
+
+/*
+ * NAME
+ *
+ *   instrument_report_generation
+ *
+ * DESCRIPTION
+ *
+ *  Prints the breakdown of the current window as the report for a
+ *  generation and starts a new window
+ *
+ * PARAMETERS
+ *
+ *  uint32_t gen -- generation number, 0 for the initial population
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_GENERATION(g + 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to stdout, resets the generation statistics
+ *
+ */
+
+void instrument_report_generation(uint32_t gen);
+
+/*
+ * NAME
+ *
+ *   instrument_report_totals
+ *
+ * DESCRIPTION
+ *
+ *  Prints the breakdown of the whole run since the last reset
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  INSTRUMENT_TOTALS();
+ *
+ * SIDE-EFFECT
+ *
+ *  prints to stdout
+ *
+ */
+
+void instrument_report_totals(void);
+
+#endif /* SUPPORT_INSTRUMENT_H_ */
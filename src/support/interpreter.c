@@ -0,0 +1,1361 @@
+/*
+ ============================================================================
+ Name        : interpreter.c
+ Author      : Andrew Sloss
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Register machine interpreter for ASSEMBLER individuals, so
+               they can be evaluated on the host without AArch64 hardware.
+               An individual is decoded once into a compact bytecode, one
+               opcode per instruction and operand kind, which is then run
+               over a batch of input vectors. Its outputs are compared
+               with a target function for a symbolic regression fitness,
+               either the error or, once exact, the estimated cycles
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "interpreter.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INTERPRETER_X86
+#endif
+
+/*
+ * STATIC
+ */
+
+// estimated latencies of add, sub, mul, sdiv and mov on an AArch64 core
+static const uint32_t interpreter_cycles[] = { 1, 1, 3, 12, 1 };
+
+static interpreter_dataset_str interpreter_dataset;
+static interpreter_fitness_typ interpreter_fitness_type = INTERPRETER_FITNESS_ERROR;
+static interpreter_mode_typ interpreter_mode = INTERPRETER_MODE_SIMD;
+static pthread_once_t interpreter_once = PTHREAD_ONCE_INIT;
+
+static interpreter_memo_str interpreter_memo[INTERPRETER_MEMO_SIZE];
+static bool interpreter_memo_enabled = true;
+static pthread_mutex_t interpreter_memo_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __interpreter_default_problem
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, creates the default problem the first time a
+ *  fitness is asked for
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  pthread_once(&interpreter_once, __interpreter_default_problem);
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the dataset of the problem
+ *
+ */
+
+void __interpreter_default_problem(void) {
+
+    interpreter_dataset_create(&interpreter_dataset, interpreter_target_default, 2, INTERPRETER_DEFAULT_CASES,
+        INTERPRETER_DEFAULT_INPUT_RANGE, INTERPRETER_DEFAULT_SEED);
+
+}
+
+/*
+ * NAME
+ *
+ *   __interpreter_score
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, fitness of a program with the given error and
+ *  estimated cycles on the current problem
+ *
+ * PARAMETERS
+ *
+ *  uint64_t error -- total absolute error of the program
+ *  uint64_t cycles -- estimated cycles of the program
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness, saturated at UINT32_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = __interpreter_score(error, program.cycles);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t __interpreter_score(uint64_t error, uint64_t cycles) {
+
+    if (interpreter_fitness_type == INTERPRETER_FITNESS_CYCLES) {
+        error = error == 0 ? cycles : (error > UINT32_MAX ? UINT32_MAX : error + INTERPRETER_CYCLES_CEILING);
+    }
+
+    return error > UINT32_MAX ? UINT32_MAX : (uint32_t) error;
+
+}
+
+/*
+ * NAME
+ *
+ *   __interpreter_sdiv
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, signed division as sdiv does it on AArch64: rounded
+ *  toward zero, zero when dividing by zero, and the most negative value
+ *  divided by -1 wraps back to itself
+ *
+ * PARAMETERS
+ *
+ *  uint64_t dividend -- register holding the dividend
+ *  uint64_t divisor -- register holding the divisor
+ *
+ * RETURN
+ *
+ *  uint64_t -- the quotient
+ *
+ * EXAMPLE
+ *
+ *  r[rd] = __interpreter_sdiv(r[rn], r[rm]);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline uint64_t __interpreter_sdiv(uint64_t dividend, uint64_t divisor) {
+
+    int64_t n = (int64_t) dividend;
+    int64_t d = (int64_t) divisor;
+
+    if (d == 0) {
+        return 0;
+    }
+    if (n == INT64_MIN && d == -1) {
+        return dividend;
+    }
+
+    return (uint64_t) (n / d);
+
+}
+
+/*
+ * NAME
+ *
+ *   __interpreter_difference
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, absolute difference of a result and its target
+ *
+ * PARAMETERS
+ *
+ *  uint64_t result -- register holding the result
+ *  int64_t target -- the target
+ *
+ * RETURN
+ *
+ *  uint64_t -- the absolute difference
+ *
+ * EXAMPLE
+ *
+ *  uint64_t difference = __interpreter_difference(result, dataset->targets[c]);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline uint64_t __interpreter_difference(uint64_t result, int64_t target) {
+
+    // the difference of two 64 bit values only fits 64 bits unsigned
+    return (int64_t) result >= target ? result - (uint64_t) target : (uint64_t) target - result;
+
+}
+
+/*
+ * NAME
+ *
+ *   __interpreter_run_lanes_portable
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, runs a program on INTERPRETER_LANES input vectors
+ *  with one row of lanes per register. The loops over the lanes have no
+ *  dependence between lanes, so the compiler vectorizes add, sub and mov
+ *  with whatever the target has
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- input i of lane l at inputs[i * INTERPRETER_LANES + l]
+ *  uint32_t num_inputs -- inputs per lane
+ *  int64_t* results -- r0 of every lane once the program has run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __interpreter_run_lanes_portable(&program, dataset.lanes, 2, results);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void __interpreter_run_lanes_portable(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs, int64_t* results) {
+
+    uint64_t r[INTERPRETER_NUM_REGISTERS][INTERPRETER_LANES] = { { 0 } };
+
+    for (uint32_t i = 0; i < num_inputs; i++) {
+        for (uint32_t l = 0; l < INTERPRETER_LANES; l++) {
+            r[i][l] = (uint64_t) inputs[i * INTERPRETER_LANES + l];
+        }
+    }
+
+    interpreter_instruction_str* instruction = program->code;
+    interpreter_instruction_str* end = program->code + program->num_instructions;
+
+    for (; instruction < end; instruction++) {
+
+        uint64_t* d = r[instruction->rd];
+        const uint64_t* n = r[instruction->rn];
+        const uint64_t* m = r[instruction->rm];
+        uint64_t imm = (uint64_t) (int64_t) instruction->imm;
+
+        // each lane only reads its own column, so d may be n or m
+        switch (instruction->opcode) {
+            case INTERPRETER_ADD_REG: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] + m[l]; break;
+            case INTERPRETER_ADD_IMM: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] + imm; break;
+            case INTERPRETER_SUB_REG: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] - m[l]; break;
+            case INTERPRETER_SUB_IMM: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] - imm; break;
+            case INTERPRETER_MUL_REG: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] * m[l]; break;
+            case INTERPRETER_MUL_IMM: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = n[l] * imm; break;
+            case INTERPRETER_SDIV_REG: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = __interpreter_sdiv(n[l], m[l]); break;
+            case INTERPRETER_SDIV_IMM: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = __interpreter_sdiv(n[l], imm); break;
+            case INTERPRETER_MOV_REG: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = m[l]; break;
+            case INTERPRETER_MOV_IMM: for (uint32_t l = 0; l < INTERPRETER_LANES; l++) d[l] = imm; break;
+        }
+
+    }
+
+    for (uint32_t l = 0; l < INTERPRETER_LANES; l++) {
+        results[l] = (int64_t) r[0][l];
+    }
+
+}
+
+#ifdef INTERPRETER_X86
+
+// a row of lanes is this many AVX2 vectors
+#define INTERPRETER_VECTORS (INTERPRETER_LANES / 4)
+
+/*
+ * NAME
+ *
+ *   __interpreter_mul_avx2
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, low 64 bits of the products of four pairs of 64 bit
+ *  lanes. AVX2 only multiplies 32 bit halves, so the product is put
+ *  together from the low halves and the two cross terms, the high halves
+ *  times each other only reaching past 64 bits
+ *
+ * PARAMETERS
+ *
+ *  __m256i a -- four multiplicands
+ *  __m256i b -- four multipliers
+ *
+ * RETURN
+ *
+ *  __m256i -- the four products, wrapped as the scalar multiply wraps
+ *
+ * EXAMPLE
+ *
+ *  r[rd][v] = __interpreter_mul_avx2(r[rn][v], r[rm][v]);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+__attribute__((target("avx2"))) static inline __m256i __interpreter_mul_avx2(__m256i a, __m256i b) {
+
+    __m256i low = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)), _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+
+}
+
+/*
+ * NAME
+ *
+ *   __interpreter_run_lanes_avx2
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, runs a program on INTERPRETER_LANES input vectors with
+ *  every register a row of AVX2 vectors. There is no vector division, so
+ *  sdiv goes through __interpreter_sdiv one lane at a time and gives
+ *  exactly what the scalar interpreter gives
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- input i of lane l at inputs[i * INTERPRETER_LANES + l]
+ *  uint32_t num_inputs -- inputs per lane
+ *  int64_t* results -- r0 of every lane once the program has run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __interpreter_run_lanes_avx2(&program, dataset.lanes, 2, results);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+__attribute__((target("avx2"))) void __interpreter_run_lanes_avx2(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs, int64_t* results) {
+
+    __m256i r[INTERPRETER_NUM_REGISTERS][INTERPRETER_VECTORS];
+    uint64_t n[INTERPRETER_LANES] __attribute__((aligned(32)));
+    uint64_t m[INTERPRETER_LANES] __attribute__((aligned(32)));
+
+    for (uint32_t i = 0; i < INTERPRETER_NUM_REGISTERS; i++) {
+        for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) {
+            r[i][v] = i < num_inputs ? _mm256_loadu_si256((const __m256i*) (inputs + i * INTERPRETER_LANES + 4 * v)) : _mm256_setzero_si256();
+        }
+    }
+
+    interpreter_instruction_str* instruction = program->code;
+    interpreter_instruction_str* end = program->code + program->num_instructions;
+
+    for (; instruction < end; instruction++) {
+
+        __m256i* d = r[instruction->rd];
+        __m256i* rn = r[instruction->rn];
+        __m256i* rm = r[instruction->rm];
+        __m256i imm = _mm256_set1_epi64x((int64_t) instruction->imm);
+
+        switch (instruction->opcode) {
+            case INTERPRETER_ADD_REG: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = _mm256_add_epi64(rn[v], rm[v]); break;
+            case INTERPRETER_ADD_IMM: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = _mm256_add_epi64(rn[v], imm); break;
+            case INTERPRETER_SUB_REG: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = _mm256_sub_epi64(rn[v], rm[v]); break;
+            case INTERPRETER_SUB_IMM: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = _mm256_sub_epi64(rn[v], imm); break;
+            case INTERPRETER_MUL_REG: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = __interpreter_mul_avx2(rn[v], rm[v]); break;
+            case INTERPRETER_MUL_IMM: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = __interpreter_mul_avx2(rn[v], imm); break;
+            case INTERPRETER_SDIV_REG:
+            case INTERPRETER_SDIV_IMM:
+                for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) {
+                    _mm256_store_si256((__m256i*) (n + 4 * v), rn[v]);
+                    _mm256_store_si256((__m256i*) (m + 4 * v), instruction->opcode == INTERPRETER_SDIV_REG ? rm[v] : imm);
+                }
+                for (uint32_t l = 0; l < INTERPRETER_LANES; l++) {
+                    n[l] = __interpreter_sdiv(n[l], m[l]);
+                }
+                for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) {
+                    d[v] = _mm256_load_si256((const __m256i*) (n + 4 * v));
+                }
+                break;
+            case INTERPRETER_MOV_REG: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = rm[v]; break;
+            case INTERPRETER_MOV_IMM: for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) d[v] = imm; break;
+        }
+
+    }
+
+    for (uint32_t v = 0; v < INTERPRETER_VECTORS; v++) {
+        _mm256_storeu_si256((__m256i*) (results + 4 * v), r[0][v]);
+    }
+
+}
+
+#endif
+
+/*
+ * NAME
+ *
+ *   __interpreter_reads
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper, registers an instruction reads, as a mask with one
+ *  bit per register
+ *
+ * PARAMETERS
+ *
+ *  interpreter_instruction_str* instruction -- the instruction
+ *
+ * RETURN
+ *
+ *  uint32_t -- bit r set if the instruction reads register r
+ *
+ * EXAMPLE
+ *
+ *  live |= __interpreter_reads(instruction);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+static inline uint32_t __interpreter_reads(interpreter_instruction_str* instruction) {
+
+    switch (instruction->opcode) {
+        case INTERPRETER_MOV_IMM: return 0;
+        case INTERPRETER_MOV_REG: return 1u << instruction->rm;
+        case INTERPRETER_ADD_IMM:
+        case INTERPRETER_SUB_IMM:
+        case INTERPRETER_MUL_IMM:
+        case INTERPRETER_SDIV_IMM: return 1u << instruction->rn;
+        default: return (1u << instruction->rn) | (1u << instruction->rm);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_decode
+ *
+ * DESCRIPTION
+ *
+ *  Decodes an ASSEMBLER individual into bytecode, one instruction per
+ *  gene, and adds up its estimated cycles. The program keeps its buffer
+ *  between calls, so decoding many individuals into the same program only
+ *  allocates for the longest
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- the program, zeroed before its first use
+ *  node_str* indiv -- the individual to decode
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_program_str program = { 0 };
+ *  interpreter_decode(&program, indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  may grow the buffer of the program, free with interpreter_free
+ *
+ */
+
+void interpreter_decode(interpreter_program_str* program, node_str* indiv) {
+
+    program->num_instructions = 0;
+    program->cycles = 0;
+
+    for (node_str* node = indiv; node != NULL; node = NEXT(node)) {
+
+        object_assembler_str* o = (object_assembler_str*) OBJECT(node);
+
+        assert(OBJECT_TYPE(node) == ASSEMBLER);
+        assert(ASSEMBLER_INSTRUCTION(o) < MAXINSTRUCTIONS);
+        assert(ASSEMBLER_DEST(o) < INTERPRETER_NUM_REGISTERS && ASSEMBLER_SOURCE(o) < INTERPRETER_NUM_REGISTERS && ASSEMBLER_OPERAND(o) < INTERPRETER_NUM_REGISTERS);
+
+        if (program->num_instructions == program->capacity) {
+            program->capacity = program->capacity == 0 ? 64 : 2 * program->capacity;
+            program->code = realloc(program->code, program->capacity * sizeof(interpreter_instruction_str));
+            assert(program->code != NULL);
+        }
+
+        // the opcodes pair up every instruction with its register and immediate forms
+        interpreter_instruction_str* instruction = &program->code[program->num_instructions++];
+        instruction->opcode = 2 * ASSEMBLER_INSTRUCTION(o) + (ASSEMBLER_HAS_IMMEDIATE(o) ? 1 : 0);
+        instruction->rd = ASSEMBLER_DEST(o);
+        instruction->rn = ASSEMBLER_SOURCE(o);
+        instruction->rm = ASSEMBLER_OPERAND(o);
+        instruction->imm = ASSEMBLER_IMMEDIATE(o);
+
+        program->cycles += interpreter_cycles[ASSEMBLER_INSTRUCTION(o)];
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees the buffer of a program
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- the program
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_free(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void interpreter_free(interpreter_program_str* program) {
+
+    free(program->code);
+    memset(program, 0, sizeof(interpreter_program_str));
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_strip_introns
+ *
+ * DESCRIPTION
+ *
+ *  Removes the structural introns of a decoded program, the instructions
+ *  whose result never reaches r0. A sweep from the last instruction back
+ *  keeps the set of live registers, starting with r0: an instruction that
+ *  writes a register that is not live is an intron, any other makes its
+ *  destination dead and its sources live. The effective instructions that
+ *  are left also have the operands they do not read zeroed, and the
+ *  cycles are those of the effective instructions only, so programs that
+ *  only differ in their introns end up as the same bytecode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of instructions removed
+ *
+ * EXAMPLE
+ *
+ *  interpreter_decode(&program, indiv);
+ *  uint32_t introns = interpreter_strip_introns(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  rewrites the program in place
+ *
+ */
+
+uint32_t interpreter_strip_introns(interpreter_program_str* program) {
+
+    interpreter_instruction_str* code = program->code;
+    uint32_t live = 1u << 0;
+    uint32_t kept = program->num_instructions;
+
+    program->cycles = 0;
+
+    // effective instructions are packed toward the end as the sweep goes back
+    for (uint32_t i = program->num_instructions; i-- > 0; ) {
+
+        interpreter_instruction_str instruction = code[i];
+
+        if (!(live & (1u << instruction.rd))) {
+            continue;
+        }
+
+        live = (live & ~(1u << instruction.rd)) | __interpreter_reads(&instruction);
+
+        if (instruction.opcode == INTERPRETER_MOV_REG || instruction.opcode == INTERPRETER_MOV_IMM) {
+            instruction.rn = 0;
+        }
+        if (instruction.opcode & 1) {
+            instruction.rm = 0;
+        }
+        else {
+            instruction.imm = 0;
+        }
+
+        code[--kept] = instruction;
+        program->cycles += interpreter_cycles[instruction.opcode / 2];
+
+    }
+
+    uint32_t introns = kept;
+
+    memmove(code, code + kept, (program->num_instructions - kept) * sizeof(interpreter_instruction_str));
+    program->num_instructions -= introns;
+
+    return introns;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_hash
+ *
+ * DESCRIPTION
+ *
+ *  Hash of the bytecode of a program. Taken once the introns are stripped,
+ *  it is a canonical hash of what the program computes: individuals that
+ *  only differ in their introns hash the same
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *
+ * RETURN
+ *
+ *  uint64_t -- the hash
+ *
+ * EXAMPLE
+ *
+ *  uint64_t key = interpreter_hash(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_hash(interpreter_program_str* program) {
+
+    uint64_t h = hash_mix64(program->num_instructions);
+
+    for (uint32_t i = 0; i < program->num_instructions; i++) {
+
+        interpreter_instruction_str* instruction = &program->code[i];
+        uint64_t packed = (uint64_t) instruction->opcode | (uint64_t) instruction->rd << 8 | (uint64_t) instruction->rn << 16
+            | (uint64_t) instruction->rm << 24 | (uint64_t) (uint32_t) instruction->imm << 32;
+
+        h = hash_combine(h, packed);
+
+    }
+
+    return h;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_run
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program on one input vector. The inputs are loaded into r0,
+ *  r1 and so on, the other registers start at zero, and the result is
+ *  left in r0. Registers are 64 bits wide and wrap around, and division
+ *  by zero gives zero, as sdiv does on AArch64
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- the input vector
+ *  uint32_t num_inputs -- length of the input vector, at most INTERPRETER_NUM_REGISTERS
+ *
+ * RETURN
+ *
+ *  int64_t -- r0 once the program has run
+ *
+ * EXAMPLE
+ *
+ *  int64_t result = interpreter_run(&program, inputs, 2);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+int64_t interpreter_run(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs) {
+
+    // unsigned registers wrap around instead of overflowing
+    uint64_t r[INTERPRETER_NUM_REGISTERS] = { 0 };
+
+    assert(num_inputs <= INTERPRETER_NUM_REGISTERS);
+
+    for (uint32_t i = 0; i < num_inputs; i++) {
+        r[i] = (uint64_t) inputs[i];
+    }
+
+    interpreter_instruction_str* instruction = program->code;
+    interpreter_instruction_str* end = program->code + program->num_instructions;
+
+    for (; instruction < end; instruction++) {
+
+        uint64_t imm = (uint64_t) (int64_t) instruction->imm;
+
+        switch (instruction->opcode) {
+            case INTERPRETER_ADD_REG: r[instruction->rd] = r[instruction->rn] + r[instruction->rm]; break;
+            case INTERPRETER_ADD_IMM: r[instruction->rd] = r[instruction->rn] + imm; break;
+            case INTERPRETER_SUB_REG: r[instruction->rd] = r[instruction->rn] - r[instruction->rm]; break;
+            case INTERPRETER_SUB_IMM: r[instruction->rd] = r[instruction->rn] - imm; break;
+            case INTERPRETER_MUL_REG: r[instruction->rd] = r[instruction->rn] * r[instruction->rm]; break;
+            case INTERPRETER_MUL_IMM: r[instruction->rd] = r[instruction->rn] * imm; break;
+            case INTERPRETER_SDIV_REG: r[instruction->rd] = __interpreter_sdiv(r[instruction->rn], r[instruction->rm]); break;
+            case INTERPRETER_SDIV_IMM: r[instruction->rd] = __interpreter_sdiv(r[instruction->rn], imm); break;
+            case INTERPRETER_MOV_REG: r[instruction->rd] = r[instruction->rm]; break;
+            case INTERPRETER_MOV_IMM: r[instruction->rd] = imm; break;
+        }
+
+    }
+
+    return (int64_t) r[0];
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_run_lanes
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program on INTERPRETER_LANES input vectors at once. Registers
+ *  are kept as one row of lanes each, and every instruction is applied to
+ *  a whole row before the next, with AVX2 in SIMD mode when the CPU has
+ *  it and a plain loop over the lanes otherwise. Every lane gives exactly
+ *  what interpreter_run gives on its own input vector
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- input i of lane l at inputs[i * INTERPRETER_LANES + l]
+ *  uint32_t num_inputs -- inputs per lane, at most INTERPRETER_NUM_REGISTERS
+ *  int64_t* results -- r0 of every lane once the program has run
+ *  interpreter_mode_typ mode -- INTERPRETER_MODE_LANES or INTERPRETER_MODE_SIMD
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_run_lanes(&program, dataset.lanes, 2, results, INTERPRETER_MODE_SIMD);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void interpreter_run_lanes(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs, int64_t* results, interpreter_mode_typ mode) {
+
+    assert(num_inputs <= INTERPRETER_NUM_REGISTERS && mode != INTERPRETER_MODE_SCALAR);
+
+#ifdef INTERPRETER_X86
+    if (mode == INTERPRETER_MODE_SIMD && interpreter_simd_available()) {
+        __interpreter_run_lanes_avx2(program, inputs, num_inputs, results);
+        return;
+    }
+#endif
+
+    __interpreter_run_lanes_portable(program, inputs, num_inputs, results);
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_simd_available
+ *
+ * DESCRIPTION
+ *
+ *  Whether INTERPRETER_MODE_SIMD runs on AVX2 on this CPU, rather than
+ *  falling back to the plain loop over the lanes
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true if AVX2 is used
+ *
+ * EXAMPLE
+ *
+ *  bool simd = interpreter_simd_available();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool interpreter_simd_available(void) {
+
+#ifdef INTERPRETER_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_error
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program over every case of a dataset and adds up the absolute
+ *  differences between its results and the targets
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *
+ * RETURN
+ *
+ *  uint64_t -- total absolute error, saturated at UINT64_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint64_t error = interpreter_error(&program, &dataset);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_error(interpreter_program_str* program, interpreter_dataset_str* dataset) {
+
+    uint64_t error = 0;
+
+    for (uint32_t c = 0; c < dataset->num_cases; c++) {
+
+        uint64_t result = (uint64_t) interpreter_run(program, dataset->inputs + (size_t) c * dataset->num_inputs, dataset->num_inputs);
+        uint64_t difference = __interpreter_difference(result, dataset->targets[c]);
+
+        error = error + difference < error ? UINT64_MAX : error + difference;
+
+    }
+
+    return error;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_error_mode
+ *
+ * DESCRIPTION
+ *
+ *  Same total absolute error as interpreter_error, with the cases run one
+ *  at a time or INTERPRETER_LANES at a time as the mode says. The total is
+ *  the same whatever the mode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *  interpreter_mode_typ mode -- how the cases are run
+ *
+ * RETURN
+ *
+ *  uint64_t -- total absolute error, saturated at UINT64_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint64_t error = interpreter_error_mode(&program, &dataset, INTERPRETER_MODE_SIMD);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_error_mode(interpreter_program_str* program, interpreter_dataset_str* dataset, interpreter_mode_typ mode) {
+
+    int64_t results[INTERPRETER_LANES];
+    uint64_t error = 0;
+
+    if (mode == INTERPRETER_MODE_SCALAR) {
+        return interpreter_error(program, dataset);
+    }
+
+    // a saturating sum is the same in any order, so the blocks give the scalar total
+    for (uint32_t b = 0; b < dataset->num_blocks; b++) {
+
+        interpreter_run_lanes(program, dataset->lanes + (size_t) b * dataset->num_inputs * INTERPRETER_LANES, dataset->num_inputs, results, mode);
+
+        for (uint32_t l = 0; l < INTERPRETER_LANES && b * INTERPRETER_LANES + l < dataset->num_cases; l++) {
+
+            uint64_t difference = __interpreter_difference((uint64_t) results[l], dataset->targets[b * INTERPRETER_LANES + l]);
+
+            error = error + difference < error ? UINT64_MAX : error + difference;
+
+        }
+
+    }
+
+    return error;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_dataset_create
+ *
+ * DESCRIPTION
+ *
+ *  Draws the input vectors of a dataset uniformly from [-range, range]
+ *  with a generator of its own, so the random stream of the evolution is
+ *  left alone, and computes the target of each. The inputs are also laid
+ *  out in blocks of INTERPRETER_LANES cases for interpreter_run_lanes,
+ *  the last block padded with zeros
+ *
+ * PARAMETERS
+ *
+ *  interpreter_dataset_str* dataset -- the dataset to fill in
+ *  interpreter_target_fn target -- the function to regress
+ *  uint32_t num_inputs -- inputs of the function, at most INTERPRETER_NUM_REGISTERS
+ *  uint32_t num_cases -- number of input vectors
+ *  int64_t range -- largest magnitude of an input
+ *  uint64_t seed -- seed of the inputs
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_create(&dataset, interpreter_target_default, 2, 64, 100, 42);
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the inputs, their blocks and the targets, free with interpreter_dataset_free
+ *
+ */
+
+void interpreter_dataset_create(interpreter_dataset_str* dataset, interpreter_target_fn target, uint32_t num_inputs, uint32_t num_cases, int64_t range, uint64_t seed) {
+
+    assert(num_inputs > 0 && num_inputs <= INTERPRETER_NUM_REGISTERS && num_cases > 0 && range > 0);
+
+    dataset->num_inputs = num_inputs;
+    dataset->num_cases = num_cases;
+    dataset->inputs = malloc((size_t) num_cases * num_inputs * sizeof(int64_t));
+    dataset->targets = malloc((size_t) num_cases * sizeof(int64_t));
+    dataset->num_blocks = (num_cases + INTERPRETER_LANES - 1) / INTERPRETER_LANES;
+    dataset->lanes = calloc((size_t) dataset->num_blocks * num_inputs * INTERPRETER_LANES, sizeof(int64_t));
+    assert(dataset->inputs != NULL && dataset->targets != NULL && dataset->lanes != NULL);
+
+    uint64_t state = seed;
+
+    for (uint32_t c = 0; c < num_cases; c++) {
+
+        int64_t* inputs = dataset->inputs + (size_t) c * num_inputs;
+
+        for (uint32_t i = 0; i < num_inputs; i++) {
+            state = hash_mix64(state + 0x9e3779b97f4a7c15ULL);
+            inputs[i] = (int64_t) (state % (uint64_t) (2 * range + 1)) - range;
+            dataset->lanes[((size_t) (c / INTERPRETER_LANES) * num_inputs + i) * INTERPRETER_LANES + c % INTERPRETER_LANES] = inputs[i];
+        }
+
+        dataset->targets[c] = target(inputs);
+
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_dataset_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees the inputs, their blocks and the targets of a dataset
+ *
+ * PARAMETERS
+ *
+ *  interpreter_dataset_str* dataset -- the dataset
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_free(&dataset);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void interpreter_dataset_free(interpreter_dataset_str* dataset) {
+
+    free(dataset->inputs);
+    free(dataset->targets);
+    free(dataset->lanes);
+    memset(dataset, 0, sizeof(interpreter_dataset_str));
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_target_default
+ *
+ * DESCRIPTION
+ *
+ *  Default target of the ASSEMBLER fitness, x0 * x0 + x1 - 3, which a
+ *  program of three instructions computes exactly
+ *
+ * PARAMETERS
+ *
+ *  const int64_t* inputs -- x0 and x1
+ *
+ * RETURN
+ *
+ *  int64_t -- the target value
+ *
+ * EXAMPLE
+ *
+ *  int64_t target = interpreter_target_default(inputs);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+int64_t interpreter_target_default(const int64_t* inputs) {
+
+    return inputs[0] * inputs[0] + inputs[1] - 3;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_set_problem
+ *
+ * DESCRIPTION
+ *
+ *  Sets the symbolic regression problem the ASSEMBLER fitness solves: the
+ *  target function, its number of inputs, the number of cases and whether
+ *  the fitness is the error or the estimated cycles. Until it is called
+ *  the problem is interpreter_target_default over 64 cases, by error
+ *
+ * PARAMETERS
+ *
+ *  interpreter_target_fn target -- the function to regress
+ *  uint32_t num_inputs -- inputs of the function, at most INTERPRETER_NUM_REGISTERS
+ *  uint32_t num_cases -- number of input vectors
+ *  interpreter_fitness_typ fitness -- error or cycles
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_problem(my_target, 3, 256, INTERPRETER_FITNESS_CYCLES);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the dataset of the problem, not to be called during an evaluation
+ *
+ */
+
+void interpreter_set_problem(interpreter_target_fn target, uint32_t num_inputs, uint32_t num_cases, interpreter_fitness_typ fitness) {
+
+    // the default problem is never created over the one set here
+    pthread_once(&interpreter_once, __interpreter_default_problem);
+
+    interpreter_dataset_free(&interpreter_dataset);
+    interpreter_dataset_create(&interpreter_dataset, target, num_inputs, num_cases, INTERPRETER_DEFAULT_INPUT_RANGE, INTERPRETER_DEFAULT_SEED);
+    interpreter_fitness_type = fitness;
+    interpreter_set_memo(interpreter_memo_enabled);
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_set_mode
+ *
+ * DESCRIPTION
+ *
+ *  Sets how the ASSEMBLER fitness runs the cases of the problem. It is
+ *  INTERPRETER_MODE_SIMD until set, the fitness is the same in every mode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_mode_typ mode -- how the cases are run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_mode(INTERPRETER_MODE_SCALAR);
+ *
+ * SIDE-EFFECT
+ *
+ *  not to be called during an evaluation
+ *
+ */
+
+void interpreter_set_mode(interpreter_mode_typ mode) {
+
+    interpreter_mode = mode;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_set_memo
+ *
+ * DESCRIPTION
+ *
+ *  Turns the fitness memo on or off. The memo keeps the fitness of the
+ *  last INTERPRETER_MEMO_SIZE programs by interpreter_hash of their
+ *  effective code, so an individual whose effective code was seen before
+ *  is not run again. It is on until set, and emptied whenever it is set
+ *  or the problem changes
+ *
+ * PARAMETERS
+ *
+ *  bool enabled -- whether the memo is used
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_memo(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  empties the memo
+ *
+ */
+
+void interpreter_set_memo(bool enabled) {
+
+    pthread_mutex_lock(&interpreter_memo_lock);
+    interpreter_memo_enabled = enabled;
+    memset(interpreter_memo, 0, sizeof(interpreter_memo));
+    pthread_mutex_unlock(&interpreter_memo_lock);
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_problem
+ *
+ * DESCRIPTION
+ *
+ *  Dataset of the current problem, for evaluators that run the programs
+ *  somewhere else than on the interpreter
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  interpreter_dataset_str* -- inputs and targets of the current problem
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_str* dataset = interpreter_problem();
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the default problem on first use
+ *
+ */
+
+interpreter_dataset_str* interpreter_problem(void) {
+
+    pthread_once(&interpreter_once, __interpreter_default_problem);
+
+    return &interpreter_dataset;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_memo_publish
+ *
+ * DESCRIPTION
+ *
+ *  Records in the memo the fitness that goes with an error measured
+ *  somewhere else than on the interpreter, such as on an AArch64
+ *  emulator, so that interpreter_fitness returns it for every individual
+ *  with the same effective code. Nothing is recorded while the memo is off
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program with its introns stripped
+ *  uint64_t error -- total absolute error of the program over the current problem
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness recorded
+ *
+ * EXAMPLE
+ *
+ *  interpreter_memo_publish(&program, error);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills the memo
+ *
+ */
+
+uint32_t interpreter_memo_publish(interpreter_program_str* program, uint64_t error) {
+
+    uint64_t key = interpreter_hash(program);
+    uint32_t fitness = __interpreter_score(error, program->cycles);
+
+    pthread_mutex_lock(&interpreter_memo_lock);
+    if (interpreter_memo_enabled) {
+        interpreter_memo[key & (INTERPRETER_MEMO_SIZE - 1)] = (interpreter_memo_str) { key, fitness, true };
+    }
+    pthread_mutex_unlock(&interpreter_memo_lock);
+
+    return fitness;
+
+}
+
+/*
+ * NAME
+ *
+ *   interpreter_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an ASSEMBLER individual on the current problem. By error it
+ *  is the total absolute error over the cases. By cycles it is the
+ *  estimated cycles of an exact program, and INTERPRETER_CYCLES_CEILING
+ *  plus the error for any other, so every exact program ranks first.
+ *  Lower is better either way. Only the effective code is run, and its
+ *  fitness is looked up in the memo first
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- the individual to evaluate
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness, saturated at UINT32_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = interpreter_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the default problem on first use, fills the memo
+ *
+ */
+
+uint32_t interpreter_fitness(node_str* indiv) {
+
+    interpreter_program_str program = { 0 };
+
+    pthread_once(&interpreter_once, __interpreter_default_problem);
+
+    interpreter_decode(&program, indiv);
+    interpreter_strip_introns(&program);
+
+    uint64_t key = interpreter_hash(&program);
+    interpreter_memo_str* entry = &interpreter_memo[key & (INTERPRETER_MEMO_SIZE - 1)];
+
+    pthread_mutex_lock(&interpreter_memo_lock);
+    bool hit = interpreter_memo_enabled && entry->valid && entry->key == key;
+    uint32_t fitness = entry->fitness;
+    pthread_mutex_unlock(&interpreter_memo_lock);
+
+    if (hit) {
+        interpreter_free(&program);
+        return fitness;
+    }
+
+    fitness = __interpreter_score(interpreter_error_mode(&program, &interpreter_dataset, interpreter_mode), program.cycles);
+    interpreter_free(&program);
+
+    pthread_mutex_lock(&interpreter_memo_lock);
+    if (interpreter_memo_enabled) {
+        *entry = (interpreter_memo_str) { key, fitness, true };
+    }
+    pthread_mutex_unlock(&interpreter_memo_lock);
+
+    return fitness;
+
+}
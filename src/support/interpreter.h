@@ -0,0 +1,724 @@
+/*
+ ============================================================================
+ Name        : interpreter.h
+ Author      : Andrew Sloss
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Register machine interpreter for ASSEMBLER individuals, so
+               they can be evaluated on the host without AArch64 hardware.
+               An individual is decoded once into a compact bytecode, one
+               opcode per instruction and operand kind, which is then run
+               over a batch of input vectors. Its outputs are compared
+               with a target function for a symbolic regression fitness,
+               either the error or, once exact, the estimated cycles
+ ============================================================================
+ */
+
+#ifndef SUPPORT_INTERPRETER_H_
+#define SUPPORT_INTERPRETER_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "../module/assembler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+/*
+ * MACROS
+ */
+
+#define INTERPRETER_NUM_REGISTERS PCSUSERREGS
+#define INTERPRETER_DEFAULT_CASES 64
+#define INTERPRETER_DEFAULT_INPUT_RANGE 100
+#define INTERPRETER_DEFAULT_SEED 42
+
+// cases run side by side, two AVX2 vectors of 64 bit lanes
+#define INTERPRETER_LANES 8
+
+// fitness memo entries, a power of two
+#define INTERPRETER_MEMO_SIZE 4096
+
+// inexact programs rank after every exact one, however slow
+#define INTERPRETER_CYCLES_CEILING (1u << 20)
+
+/*
+ * DATATYPES
+ */
+
+// one opcode per instruction and kind of second operand, so running never looks at the immediate flag
+typedef enum {
+    INTERPRETER_ADD_REG = 0,
+    INTERPRETER_ADD_IMM,
+    INTERPRETER_SUB_REG,
+    INTERPRETER_SUB_IMM,
+    INTERPRETER_MUL_REG,
+    INTERPRETER_MUL_IMM,
+    INTERPRETER_SDIV_REG,
+    INTERPRETER_SDIV_IMM,
+    INTERPRETER_MOV_REG,
+    INTERPRETER_MOV_IMM
+} interpreter_opcode_typ;
+
+typedef enum {
+    INTERPRETER_FITNESS_ERROR,
+    INTERPRETER_FITNESS_CYCLES
+} interpreter_fitness_typ;
+
+// SCALAR runs one case at a time, LANES every lane in plain C and SIMD with AVX2 where the CPU has it
+typedef enum {
+    INTERPRETER_MODE_SCALAR,
+    INTERPRETER_MODE_LANES,
+    INTERPRETER_MODE_SIMD
+} interpreter_mode_typ;
+
+typedef struct interpreter_instruction_str {
+    uint8_t opcode;
+    uint8_t rd;
+    uint8_t rn;
+    uint8_t rm;
+    int32_t imm;
+} interpreter_instruction_str;
+
+typedef struct interpreter_program_str {
+    interpreter_instruction_str* code;
+    uint32_t num_instructions;
+    uint32_t capacity;
+    uint64_t cycles;
+} interpreter_program_str;
+
+typedef struct interpreter_dataset_str {
+    uint32_t num_inputs;
+    uint32_t num_cases;
+    int64_t* inputs;
+    int64_t* targets;
+    uint32_t num_blocks;
+    int64_t* lanes;
+} interpreter_dataset_str;
+
+typedef struct interpreter_memo_str {
+    uint64_t key;
+    uint32_t fitness;
+    bool valid;
+} interpreter_memo_str;
+
+typedef int64_t (*interpreter_target_fn)(const int64_t* inputs);
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   interpreter_decode
+ *
+ * DESCRIPTION
+ *
+ *  Decodes an ASSEMBLER individual into bytecode, one instruction per
+ *  gene, and adds up its estimated cycles. The program keeps its buffer
+ *  between calls, so decoding many individuals into the same program only
+ *  allocates for the longest
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- the program, zeroed before its first use
+ *  node_str* indiv -- the individual to decode
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_program_str program = { 0 };
+ *  interpreter_decode(&program, indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  may grow the buffer of the program, free with interpreter_free
+ *
+ */
+
+void interpreter_decode(interpreter_program_str* program, node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   interpreter_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees the buffer of a program
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- the program
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_free(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void interpreter_free(interpreter_program_str* program);
+
+/*
+ * NAME
+ *
+ *   interpreter_strip_introns
+ *
+ * DESCRIPTION
+ *
+ *  Removes the structural introns of a decoded program, the instructions
+ *  whose result never reaches r0. A sweep from the last instruction back
+ *  keeps the set of live registers, starting with r0: an instruction that
+ *  writes a register that is not live is an intron, any other makes its
+ *  destination dead and its sources live. The effective instructions that
+ *  are left also have the operands they do not read zeroed, and the
+ *  cycles are those of the effective instructions only, so programs that
+ *  only differ in their introns end up as the same bytecode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of instructions removed
+ *
+ * EXAMPLE
+ *
+ *  interpreter_decode(&program, indiv);
+ *  uint32_t introns = interpreter_strip_introns(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  rewrites the program in place
+ *
+ */
+
+uint32_t interpreter_strip_introns(interpreter_program_str* program);
+
+/*
+ * NAME
+ *
+ *   interpreter_hash
+ *
+ * DESCRIPTION
+ *
+ *  Hash of the bytecode of a program. Taken once the introns are stripped,
+ *  it is a canonical hash of what the program computes: individuals that
+ *  only differ in their introns hash the same
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *
+ * RETURN
+ *
+ *  uint64_t -- the hash
+ *
+ * EXAMPLE
+ *
+ *  uint64_t key = interpreter_hash(&program);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_hash(interpreter_program_str* program);
+
+/*
+ * NAME
+ *
+ *   interpreter_run
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program on one input vector. The inputs are loaded into r0,
+ *  r1 and so on, the other registers start at zero, and the result is
+ *  left in r0. Registers are 64 bits wide and wrap around, and division
+ *  by zero gives zero, as sdiv does on AArch64
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- the input vector
+ *  uint32_t num_inputs -- length of the input vector, at most INTERPRETER_NUM_REGISTERS
+ *
+ * RETURN
+ *
+ *  int64_t -- r0 once the program has run
+ *
+ * EXAMPLE
+ *
+ *  int64_t result = interpreter_run(&program, inputs, 2);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+int64_t interpreter_run(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs);
+
+/*
+ * NAME
+ *
+ *   interpreter_run_lanes
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program on INTERPRETER_LANES input vectors at once. Registers
+ *  are kept as one row of lanes each, and every instruction is applied to
+ *  a whole row before the next, with AVX2 in SIMD mode when the CPU has
+ *  it and a plain loop over the lanes otherwise. Every lane gives exactly
+ *  what interpreter_run gives on its own input vector
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  const int64_t* inputs -- input i of lane l at inputs[i * INTERPRETER_LANES + l]
+ *  uint32_t num_inputs -- inputs per lane, at most INTERPRETER_NUM_REGISTERS
+ *  int64_t* results -- r0 of every lane once the program has run
+ *  interpreter_mode_typ mode -- INTERPRETER_MODE_LANES or INTERPRETER_MODE_SIMD
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_run_lanes(&program, dataset.lanes, 2, results, INTERPRETER_MODE_SIMD);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void interpreter_run_lanes(interpreter_program_str* program, const int64_t* inputs, uint32_t num_inputs, int64_t* results, interpreter_mode_typ mode);
+
+/*
+ * NAME
+ *
+ *   interpreter_simd_available
+ *
+ * DESCRIPTION
+ *
+ *  Whether INTERPRETER_MODE_SIMD runs on AVX2 on this CPU, rather than
+ *  falling back to the plain loop over the lanes
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true if AVX2 is used
+ *
+ * EXAMPLE
+ *
+ *  bool simd = interpreter_simd_available();
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool interpreter_simd_available(void);
+
+/*
+ * NAME
+ *
+ *   interpreter_error
+ *
+ * DESCRIPTION
+ *
+ *  Runs a program over every case of a dataset and adds up the absolute
+ *  differences between its results and the targets
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *
+ * RETURN
+ *
+ *  uint64_t -- total absolute error, saturated at UINT64_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint64_t error = interpreter_error(&program, &dataset);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_error(interpreter_program_str* program, interpreter_dataset_str* dataset);
+
+/*
+ * NAME
+ *
+ *   interpreter_error_mode
+ *
+ * DESCRIPTION
+ *
+ *  Same total absolute error as interpreter_error, with the cases run one
+ *  at a time or INTERPRETER_LANES at a time as the mode says. The total is
+ *  the same whatever the mode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program
+ *  interpreter_dataset_str* dataset -- inputs and targets
+ *  interpreter_mode_typ mode -- how the cases are run
+ *
+ * RETURN
+ *
+ *  uint64_t -- total absolute error, saturated at UINT64_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint64_t error = interpreter_error_mode(&program, &dataset, INTERPRETER_MODE_SIMD);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t interpreter_error_mode(interpreter_program_str* program, interpreter_dataset_str* dataset, interpreter_mode_typ mode);
+
+/*
+ * NAME
+ *
+ *   interpreter_dataset_create
+ *
+ * DESCRIPTION
+ *
+ *  Draws the input vectors of a dataset uniformly from [-range, range]
+ *  with a generator of its own, so the random stream of the evolution is
+ *  left alone, and computes the target of each. The inputs are also laid
+ *  out in blocks of INTERPRETER_LANES cases for interpreter_run_lanes,
+ *  the last block padded with zeros
+ *
+ * PARAMETERS
+ *
+ *  interpreter_dataset_str* dataset -- the dataset to fill in
+ *  interpreter_target_fn target -- the function to regress
+ *  uint32_t num_inputs -- inputs of the function, at most INTERPRETER_NUM_REGISTERS
+ *  uint32_t num_cases -- number of input vectors
+ *  int64_t range -- largest magnitude of an input
+ *  uint64_t seed -- seed of the inputs
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_create(&dataset, interpreter_target_default, 2, 64, 100, 42);
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the inputs, their blocks and the targets, free with interpreter_dataset_free
+ *
+ */
+
+void interpreter_dataset_create(interpreter_dataset_str* dataset, interpreter_target_fn target, uint32_t num_inputs, uint32_t num_cases, int64_t range, uint64_t seed);
+
+/*
+ * NAME
+ *
+ *   interpreter_dataset_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees the inputs, their blocks and the targets of a dataset
+ *
+ * PARAMETERS
+ *
+ *  interpreter_dataset_str* dataset -- the dataset
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_free(&dataset);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void interpreter_dataset_free(interpreter_dataset_str* dataset);
+
+/*
+ * NAME
+ *
+ *   interpreter_target_default
+ *
+ * DESCRIPTION
+ *
+ *  Default target of the ASSEMBLER fitness, x0 * x0 + x1 - 3, which a
+ *  program of three instructions computes exactly
+ *
+ * PARAMETERS
+ *
+ *  const int64_t* inputs -- x0 and x1
+ *
+ * RETURN
+ *
+ *  int64_t -- the target value
+ *
+ * EXAMPLE
+ *
+ *  int64_t target = interpreter_target_default(inputs);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+int64_t interpreter_target_default(const int64_t* inputs);
+
+/*
+ * NAME
+ *
+ *   interpreter_set_problem
+ *
+ * DESCRIPTION
+ *
+ *  Sets the symbolic regression problem the ASSEMBLER fitness solves: the
+ *  target function, its number of inputs, the number of cases and whether
+ *  the fitness is the error or the estimated cycles. Until it is called
+ *  the problem is interpreter_target_default over 64 cases, by error
+ *
+ * PARAMETERS
+ *
+ *  interpreter_target_fn target -- the function to regress
+ *  uint32_t num_inputs -- inputs of the function, at most INTERPRETER_NUM_REGISTERS
+ *  uint32_t num_cases -- number of input vectors
+ *  interpreter_fitness_typ fitness -- error or cycles
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_problem(my_target, 3, 256, INTERPRETER_FITNESS_CYCLES);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the dataset of the problem, not to be called during an evaluation
+ *
+ */
+
+void interpreter_set_problem(interpreter_target_fn target, uint32_t num_inputs, uint32_t num_cases, interpreter_fitness_typ fitness);
+
+/*
+ * NAME
+ *
+ *   interpreter_set_mode
+ *
+ * DESCRIPTION
+ *
+ *  Sets how the ASSEMBLER fitness runs the cases of the problem. It is
+ *  INTERPRETER_MODE_SIMD until set, the fitness is the same in every mode
+ *
+ * PARAMETERS
+ *
+ *  interpreter_mode_typ mode -- how the cases are run
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_mode(INTERPRETER_MODE_SCALAR);
+ *
+ * SIDE-EFFECT
+ *
+ *  not to be called during an evaluation
+ *
+ */
+
+void interpreter_set_mode(interpreter_mode_typ mode);
+
+/*
+ * NAME
+ *
+ *   interpreter_set_memo
+ *
+ * DESCRIPTION
+ *
+ *  Turns the fitness memo on or off. The memo keeps the fitness of the
+ *  last INTERPRETER_MEMO_SIZE programs by interpreter_hash of their
+ *  effective code, so an individual whose effective code was seen before
+ *  is not run again. It is on until set, and emptied whenever it is set
+ *  or the problem changes
+ *
+ * PARAMETERS
+ *
+ *  bool enabled -- whether the memo is used
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  interpreter_set_memo(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  empties the memo
+ *
+ */
+
+void interpreter_set_memo(bool enabled);
+
+/*
+ * NAME
+ *
+ *   interpreter_problem
+ *
+ * DESCRIPTION
+ *
+ *  Dataset of the current problem, for evaluators that run the programs
+ *  somewhere else than on the interpreter
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  interpreter_dataset_str* -- inputs and targets of the current problem
+ *
+ * EXAMPLE
+ *
+ *  interpreter_dataset_str* dataset = interpreter_problem();
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the default problem on first use
+ *
+ */
+
+interpreter_dataset_str* interpreter_problem(void);
+
+/*
+ * NAME
+ *
+ *   interpreter_memo_publish
+ *
+ * DESCRIPTION
+ *
+ *  Records in the memo the fitness that goes with an error measured
+ *  somewhere else than on the interpreter, such as on an AArch64
+ *  emulator, so that interpreter_fitness returns it for every individual
+ *  with the same effective code. Nothing is recorded while the memo is off
+ *
+ * PARAMETERS
+ *
+ *  interpreter_program_str* program -- a decoded program with its introns stripped
+ *  uint64_t error -- total absolute error of the program over the current problem
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness recorded
+ *
+ * EXAMPLE
+ *
+ *  interpreter_memo_publish(&program, error);
+ *
+ * SIDE-EFFECT
+ *
+ *  fills the memo
+ *
+ */
+
+uint32_t interpreter_memo_publish(interpreter_program_str* program, uint64_t error);
+
+/*
+ * NAME
+ *
+ *   interpreter_fitness
+ *
+ * DESCRIPTION
+ *
+ *  Fitness of an ASSEMBLER individual on the current problem. By error it
+ *  is the total absolute error over the cases. By cycles it is the
+ *  estimated cycles of an exact program, and INTERPRETER_CYCLES_CEILING
+ *  plus the error for any other, so every exact program ranks first.
+ *  Lower is better either way. Only the effective code is run, and its
+ *  fitness is looked up in the memo first
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv -- the individual to evaluate
+ *
+ * RETURN
+ *
+ *  uint32_t -- the fitness, saturated at UINT32_MAX
+ *
+ * EXAMPLE
+ *
+ *  uint32_t fitness = interpreter_fitness(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the default problem on first use, fills the memo
+ *
+ */
+
+uint32_t interpreter_fitness(node_str* indiv);
+
+#endif /* SUPPORT_INTERPRETER_H_ */
@@ -0,0 +1,787 @@
+/*
+ ============================================================================
+ Name        : job.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Non-interactive runs described by JSON job specs. A job
+               names the object type, the evolution parameters, the
+               LLVM test and source files, the evaluator, the number of
+               evaluation threads, the seed and the output folder, and is
+               given inline on the command line or in a file. A queue of
+               job files is run back to back in one process, so that
+               builds and control timings stay warm between jobs
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "job.h"
+#include <strings.h>
+#include <time.h>
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __job_uint
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper of job_from_json, reads a whole number within a range
+ *
+ * PARAMETERS
+ *
+ *  cJSON* item -- the value in the spec
+ *  uint64_t min -- smallest allowed value
+ *  uint64_t max -- largest allowed value
+ *  uint64_t* out -- set to the value when it is valid
+ *
+ * RETURN
+ *
+ *  bool -- true if the value is a whole number within the range
+ *
+ * EXAMPLE
+ *
+ *  valid = __job_uint(item, 1, 100000, &value);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints an error for an invalid value
+ *
+ */
+
+bool __job_uint(cJSON* item, uint64_t min, uint64_t max, uint64_t* out) {
+
+    if (!cJSON_IsNumber(item) || item->valuedouble < min || item->valuedouble > max || item->valuedouble != (double) (uint64_t) item->valuedouble) {
+        printf("error: job key \"%s\" must be a whole number from %lu to %lu [file:\'%s\',line:%d]\n", item->string, (unsigned long) min, (unsigned long) max, __FILE__, __LINE__);
+        return false;
+    }
+
+    *out = (uint64_t) item->valuedouble;
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __job_name
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper of job_from_json, copies a file or job name that fits
+ *  the buffers it is used in
+ *
+ * PARAMETERS
+ *
+ *  cJSON* item -- the value in the spec
+ *  char* out -- buffer of JOB_MAX_NAME characters
+ *
+ * RETURN
+ *
+ *  bool -- true if the value is a short enough string
+ *
+ * EXAMPLE
+ *
+ *  valid = __job_name(item, job->test_file);
+ *
+ * SIDE-EFFECT
+ *
+ *  prints an error for an invalid value
+ *
+ */
+
+bool __job_name(cJSON* item, char* out) {
+
+    if (!cJSON_IsString(item) || strlen(item->valuestring) == 0 || strlen(item->valuestring) >= JOB_MAX_NAME) {
+        printf("error: job key \"%s\" must be a name of 1 to %d characters [file:\'%s\',line:%d]\n", item->string, JOB_MAX_NAME - 1, __FILE__, __LINE__);
+        return false;
+    }
+
+    strcpy(out, item->valuestring);
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_defaults
+ *
+ * DESCRIPTION
+ *
+ *  Fills in a job with the defaults of an interactive run: 10 generations
+ *  of 20 individuals of 10 genes, 75% crossover, 20% mutation, tournaments
+ *  of 2, the real fitness functions on one thread and a seed taken from
+ *  the clock. The object type is left NOTSET, every job has to name one
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  const char* name -- name of the job, used for its default output folder
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_defaults(&job, "sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void job_defaults(job_str* job, const char* name) {
+
+    memset(job, 0, sizeof(job_str));
+
+    strncpy(job->name, name, JOB_MAX_NAME - 1);
+    job->type = NOTSET;
+    job->num_generations = 10;
+    job->pop_size = 20;
+    job->indiv_size = 10;
+    job->percent_crossover = 75;
+    job->percent_mutation = 20;
+    job->mutation_operator = MUTATION_ALL_PARAMS;
+    job->tournament_size = 2;
+    job->visualization = false;
+    strcpy(job->test_file, "");
+    job->src_files = NULL;
+    job->num_src_files = 0;
+    strcpy(job->suite, "");
+    job->evaluator = JOB_EVALUATOR_FITNESS;
+    job->mock = (mock_config_str) { 1000000, 0, MOCK_LATENCY_CONSTANT, 0.0, 0 };
+    job->workers = 1;
+    job->seed = (uint64_t) time(0);
+    snprintf(job->output, EVOLUTION_MAX_PATH, "%s%s", JOB_DEFAULT_OUTPUT, job->name);
+    job->cache = false;
+    job->cache_format = RUNLOG_JSONL;
+    job->trace = false;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_type_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Object type with the given name, as listed by -help, in any case
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name of the object type, such as "llvm_pass"
+ *
+ * RETURN
+ *
+ *  osaka_object_typ -- the object type, NOTSET if there is none of that name
+ *
+ * EXAMPLE
+ *
+ *  osaka_object_typ ot = job_type_from_name("SIMPLE");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+osaka_object_typ job_type_from_name(const char* name) {
+
+    for (uint32_t t = 0; t < MAXTYPE; t++) {
+        if (strcasecmp(object_table_function[t].name, name) == 0) {
+            return (osaka_object_typ) t;
+        }
+    }
+
+    return NOTSET;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_from_json
+ *
+ * DESCRIPTION
+ *
+ *  Reads a job from a parsed JSON object on top of the defaults. The keys
+ *  are type, generations, population, genome_length, crossover, mutation,
+ *  mutation_operator ("all_params" or "single_param"), tournament,
+ *  visualization, test_file, sources, suite (a benchmark suite
+ *  file, in place of test_file and sources), evaluator ("fitness", "mock"
+ *  or "aarch64", the emulator for ASSEMBLER), mock (cost_us, latency_us, latency, noise, seed), workers, seed,
+ *  output, cache (true, "jsonl" or "binary") and trace. Unknown keys and
+ *  invalid values are reported and fail the job
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  cJSON* root -- the parsed job spec
+ *  const char* name -- name of the job, used unless the spec has a name key
+ *
+ * RETURN
+ *
+ *  bool -- true if the spec describes a valid job
+ *
+ * EXAMPLE
+ *
+ *  bool valid = job_from_json(&job, root, "sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with job_free
+ *
+ */
+
+bool job_from_json(job_str* job, cJSON* root, const char* name) {
+
+    cJSON* item = NULL;
+    cJSON* name_item = cJSON_GetObjectItemCaseSensitive(root, "name");
+    bool mock_seeded = false;
+    bool valid = true;
+    uint64_t value = 0;
+
+    if (!cJSON_IsObject(root)) {
+        printf("error: a job spec must be a JSON object [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        job_defaults(job, name);
+        return false;
+    }
+
+    // the name comes first, the default output folder depends on it
+    job_defaults(job, cJSON_IsString(name_item) && strlen(name_item->valuestring) > 0 ? name_item->valuestring : name);
+
+    cJSON_ArrayForEach(item, root) {
+
+        if (strcmp(item->string, "name") == 0) {
+            valid = __job_name(item, job->name) && valid;
+        }
+        else if (strcmp(item->string, "type") == 0) {
+            if (cJSON_IsString(item)) {
+                job->type = job_type_from_name(item->valuestring);
+            }
+            else if (cJSON_IsNumber(item) && item->valueint >= 1 && item->valueint <= MAXTYPE) {
+                job->type = (osaka_object_typ) (item->valueint - 1);
+            }
+            if (job->type == NOTSET) {
+                printf("error: job key \"type\" must name an object type or number it from 1 to %d [file:\'%s\',line:%d]\n", MAXTYPE, __FILE__, __LINE__);
+                valid = false;
+            }
+        }
+        else if (strcmp(item->string, "generations") == 0) {
+            valid = __job_uint(item, 0, 1000000, &value) && valid;
+            job->num_generations = value;
+        }
+        else if (strcmp(item->string, "population") == 0) {
+            valid = __job_uint(item, 4, 1000000, &value) && valid;
+            job->pop_size = value;
+        }
+        else if (strcmp(item->string, "genome_length") == 0) {
+            valid = __job_uint(item, 3, 100000, &value) && valid;
+            job->indiv_size = value;
+        }
+        else if (strcmp(item->string, "crossover") == 0) {
+            valid = __job_uint(item, 0, 100, &value) && valid;
+            job->percent_crossover = value;
+        }
+        else if (strcmp(item->string, "mutation") == 0) {
+            valid = __job_uint(item, 0, 100, &value) && valid;
+            job->percent_mutation = value;
+        }
+        else if (strcmp(item->string, "mutation_operator") == 0 && cJSON_IsString(item) && strcmp(item->valuestring, "all_params") == 0) {
+            job->mutation_operator = MUTATION_ALL_PARAMS;
+        }
+        else if (strcmp(item->string, "mutation_operator") == 0 && cJSON_IsString(item) && strcmp(item->valuestring, "single_param") == 0) {
+            job->mutation_operator = MUTATION_SINGLE_PARAM;
+        }
+        else if (strcmp(item->string, "tournament") == 0) {
+            valid = __job_uint(item, 1, 1000000, &value) && valid;
+            job->tournament_size = value;
+        }
+        else if (strcmp(item->string, "visualization") == 0 && cJSON_IsBool(item)) {
+            job->visualization = cJSON_IsTrue(item);
+        }
+        else if (strcmp(item->string, "test_file") == 0) {
+            valid = __job_name(item, job->test_file) && valid;
+        }
+        else if (strcmp(item->string, "sources") == 0 && cJSON_IsArray(item) && job->src_files == NULL) {
+            job->num_src_files = cJSON_GetArraySize(item);
+            job->src_files = malloc(sizeof(char*) * (job->num_src_files > 0 ? job->num_src_files : 1));
+            assert(job->src_files != NULL);
+            for (uint32_t i = 0; i < job->num_src_files; i++) {
+                job->src_files[i] = malloc(JOB_MAX_NAME);
+                assert(job->src_files[i] != NULL);
+                valid = __job_name(cJSON_GetArrayItem(item, i), job->src_files[i]) && valid;
+            }
+        }
+        else if (strcmp(item->string, "suite") == 0 && cJSON_IsString(item) && strlen(item->valuestring) > 0 && strlen(item->valuestring) < EVOLUTION_MAX_PATH) {
+            suite_str suite;
+            valid = suite_load(&suite, item->valuestring) && valid;
+            suite_free(&suite);
+            strcpy(job->suite, item->valuestring);
+        }
+        else if (strcmp(item->string, "evaluator") == 0 && cJSON_IsString(item) && strcmp(item->valuestring, "fitness") == 0) {
+            job->evaluator = JOB_EVALUATOR_FITNESS;
+        }
+        else if (strcmp(item->string, "evaluator") == 0 && cJSON_IsString(item) && strcmp(item->valuestring, "mock") == 0) {
+            job->evaluator = JOB_EVALUATOR_MOCK;
+        }
+        else if (strcmp(item->string, "evaluator") == 0 && cJSON_IsString(item) && strcmp(item->valuestring, "aarch64") == 0) {
+            job->evaluator = JOB_EVALUATOR_AARCH64;
+        }
+        else if (strcmp(item->string, "mock") == 0 && cJSON_IsObject(item)) {
+            cJSON* option = NULL;
+            cJSON_ArrayForEach(option, item) {
+                if (strcmp(option->string, "cost_us") == 0) {
+                    valid = __job_uint(option, 0, 60000000, &value) && valid;
+                    job->mock.cost_ns = value * 1000;
+                }
+                else if (strcmp(option->string, "latency_us") == 0) {
+                    valid = __job_uint(option, 0, 60000000, &value) && valid;
+                    job->mock.latency_ns = value * 1000;
+                }
+                else if (strcmp(option->string, "latency") == 0 && cJSON_IsString(option)) {
+                    job->mock.latency = mock_latency_from_name(option->valuestring);
+                }
+                else if (strcmp(option->string, "noise") == 0 && cJSON_IsNumber(option) && option->valuedouble >= 0.0) {
+                    job->mock.noise = option->valuedouble;
+                }
+                else if (strcmp(option->string, "seed") == 0) {
+                    valid = __job_uint(option, 0, UINT64_MAX, &job->mock.seed) && valid;
+                    mock_seeded = true;
+                }
+                else {
+                    printf("error: unknown or invalid job key \"mock.%s\" [file:\'%s\',line:%d]\n", option->string, __FILE__, __LINE__);
+                    valid = false;
+                }
+            }
+        }
+        else if (strcmp(item->string, "workers") == 0) {
+            valid = __job_uint(item, 1, EVOLUTION_MAX_WORKERS, &value) && valid;
+            job->workers = value;
+        }
+        else if (strcmp(item->string, "seed") == 0) {
+            valid = __job_uint(item, 0, UINT64_MAX, &job->seed) && valid;
+        }
+        else if (strcmp(item->string, "output") == 0 && cJSON_IsString(item) && strlen(item->valuestring) > 0 && strlen(item->valuestring) < EVOLUTION_MAX_PATH - 16) {
+            strcpy(job->output, item->valuestring);
+        }
+        else if (strcmp(item->string, "cache") == 0 && cJSON_IsBool(item)) {
+            job->cache = cJSON_IsTrue(item);
+        }
+        else if (strcmp(item->string, "cache") == 0 && cJSON_IsString(item) && (strcmp(item->valuestring, "jsonl") == 0 || strcmp(item->valuestring, "binary") == 0)) {
+            job->cache = true;
+            job->cache_format = strcmp(item->valuestring, "binary") == 0 ? RUNLOG_BINARY : RUNLOG_JSONL;
+        }
+        else if (strcmp(item->string, "trace") == 0 && cJSON_IsBool(item)) {
+            job->trace = cJSON_IsTrue(item);
+        }
+        else {
+            printf("error: unknown or invalid job key \"%s\" [file:\'%s\',line:%d]\n", item->string, __FILE__, __LINE__);
+            valid = false;
+        }
+
+    }
+
+    // the evaluator draws its own random numbers, seeded with the job unless told otherwise
+    if (!mock_seeded) {
+        job->mock.seed = job->seed;
+    }
+
+    if (job->type == NOTSET) {
+        printf("error: job %s does not name an object type [file:\'%s\',line:%d]\n", job->name, __FILE__, __LINE__);
+        valid = false;
+    }
+    if (job->tournament_size > job->pop_size) {
+        printf("error: job %s has tournaments larger than its population [file:\'%s\',line:%d]\n", job->name, __FILE__, __LINE__);
+        valid = false;
+    }
+    if (job->evaluator == JOB_EVALUATOR_AARCH64 && job->type != ASSEMBLER) {
+        printf("error: job %s runs on the AArch64 emulator, which only evaluates ASSEMBLER [file:\'%s\',line:%d]\n", job->name, __FILE__, __LINE__);
+        valid = false;
+    }
+    else if (job->evaluator == JOB_EVALUATOR_AARCH64 && !aarch64_available()) {
+        printf("error: job %s needs %s and %s on the PATH [file:\'%s\',line:%d]\n", job->name, AARCH64_CC, AARCH64_EMULATOR, __FILE__, __LINE__);
+        valid = false;
+    }
+    if (job->type == LLVM_PASS && job->evaluator == JOB_EVALUATOR_FITNESS && strlen(job->suite) == 0 && (strlen(job->test_file) == 0 || job->num_src_files == 0)) {
+        printf("error: job %s optimizes LLVM and needs a test_file and sources, or a suite [file:\'%s\',line:%d]\n", job->name, __FILE__, __LINE__);
+        valid = false;
+    }
+
+    return valid;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_load
+ *
+ * DESCRIPTION
+ *
+ *  Reads a job from a spec given on the command line: either the JSON
+ *  itself, when it starts with a brace, or the path of a file holding it.
+ *  A job read from a file is named after the file without its folder and
+ *  extension
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  const char* spec -- inline JSON or path of a job file
+ *
+ * RETURN
+ *
+ *  bool -- true if the spec was read and describes a valid job
+ *
+ * EXAMPLE
+ *
+ *  bool valid = job_load(&job, "jobs/sweep_1.json");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with job_free
+ *
+ */
+
+bool job_load(job_str* job, const char* spec) {
+
+    char name[JOB_MAX_NAME];
+    char* text = NULL;
+
+    // skip leading white space, an inline spec may be quoted with some
+    while (*spec == ' ' || *spec == '\t' || *spec == '\n') {
+        spec++;
+    }
+
+    if (spec[0] == '{') {
+
+        strcpy(name, "inline");
+        text = strdup(spec);
+
+    }
+    else {
+
+        // the job is named after its file, without folder and extension
+        const char* base = strrchr(spec, '/') != NULL ? strrchr(spec, '/') + 1 : spec;
+        strncpy(name, base, JOB_MAX_NAME - 1);
+        name[JOB_MAX_NAME - 1] = '\0';
+        if (strrchr(name, '.') != NULL) {
+            *strrchr(name, '.') = '\0';
+        }
+
+        FILE* file = fopen(spec, "r");
+
+        if (file == NULL) {
+            printf("error: could not open job file %s [file:\'%s\',line:%d]\n", spec, __FILE__, __LINE__);
+            job_defaults(job, name);
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long length = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        text = malloc(length + 1);
+        assert(text != NULL);
+        text[fread(text, 1, length, file)] = '\0';
+        fclose(file);
+
+    }
+
+    assert(text != NULL);
+
+    cJSON* root = cJSON_Parse(text);
+    free(text);
+
+    if (root == NULL) {
+        printf("error: job %s is not valid JSON [file:\'%s\',line:%d]\n", name, __FILE__, __LINE__);
+        job_defaults(job, name);
+        return false;
+    }
+
+    bool valid = job_from_json(job, root, name);
+    cJSON_Delete(root);
+
+    return valid;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees what a job allocated for its source file names
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_free(&job);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void job_free(job_str* job) {
+
+    for (uint32_t i = 0; i < job->num_src_files; i++) {
+        free(job->src_files[i]);
+    }
+    free(job->src_files);
+
+    job->src_files = NULL;
+    job->num_src_files = 0;
+
+}
+
+/*
+ * NAME
+ *
+ *   job_run
+ *
+ * DESCRIPTION
+ *
+ *  Runs the evolution a job describes without asking anything, then puts
+ *  back the evaluator, worker count, output folder and run log format it
+ *  changed, so that the next job starts from the same state. A JSON line
+ *  with the outcome of the job is printed to the stream
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- a valid job
+ *  FILE* stream -- where the outcome is printed
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_run(&job, stdout);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the evolution, reseeds the random generator, may write a run log and a trace
+ *
+ */
+
+void job_run(job_str* job, FILE* stream) {
+
+    // the output folder holds at most EVOLUTION_MAX_PATH characters, so the trace file name always fits
+    char trace_file[EVOLUTION_MAX_PATH + sizeof("/trace.json")];
+    suite_str suite;
+    uint32_t previous_workers = evolution_get_workers();
+    runlog_format_typ previous_format = runlog_get_format();
+    mutation_operator_typ previous_operator = mutation_get_operator();
+
+    srand(job->seed);
+    evolution_set_workers(job->workers);
+    mutation_set_operator(job->mutation_operator);
+    runlog_set_format(job->cache_format);
+
+    if (job->evaluator == JOB_EVALUATOR_MOCK) {
+        mock_enable(&job->mock);
+    }
+    if (job->evaluator == JOB_EVALUATOR_AARCH64) {
+        aarch64_enable();
+    }
+
+    // the suite was checked when the job was read, timings cached by earlier jobs are reused
+    if (strlen(job->suite) > 0) {
+        suite_load(&suite, job->suite);
+        suite_enable(&suite);
+    }
+
+    // the output folder is only created for a job that writes to it
+    if (job->cache || job->trace) {
+        evolution_set_output_folder(job->output);
+    }
+    if (job->trace) {
+        snprintf(trace_file, sizeof(trace_file), "%s/trace.json", job->output);
+        trace_start(trace_file);
+    }
+
+    uint64_t start = instrument_now_ns();
+    node_str* best = evolution_basic_crossover_and_mutation_with_replacement(job->num_generations, job->pop_size, job->indiv_size, job->tournament_size, job->percent_mutation,
+        job->percent_crossover, job->type, job->visualization, job->test_file, job->src_files, job->num_src_files, job->cache);
+    double seconds = (instrument_now_ns() - start) / 1e9;
+
+    if (job->trace) {
+        trace_stop();
+    }
+
+    // everything queued for the background writer belongs to this job
+    output_flush();
+
+    fprintf(stream, "{\"job\":\"%s\",\"status\":\"done\",\"object_type\":\"%s\",\"generations\":%u,\"population\":%u,\"genome_length\":%u,"
+        "\"evaluator\":\"%s\",\"workers\":%u,\"seed\":%lu,\"seconds\":%.6f,\"best_hash\":\"%016lx\",\"output\":\"%s\"}\n",
+        job->name, object_table_function[job->type].name, job->num_generations, job->pop_size, job->indiv_size,
+        job->evaluator == JOB_EVALUATOR_MOCK ? "mock" : (job->evaluator == JOB_EVALUATOR_AARCH64 ? "aarch64" : "fitness"), job->workers, (unsigned long) job->seed, seconds,
+        (unsigned long) osaka_hash(best), job->cache || job->trace ? job->output : "");
+    fflush(stream);
+
+    generate_free_individual(best);
+
+    mock_disable();
+    aarch64_disable();
+    if (strlen(job->suite) > 0) {
+        suite_disable();
+        suite_free(&suite);
+    }
+    evolution_set_output_folder(NULL);
+    evolution_set_workers(previous_workers);
+    runlog_set_format(previous_format);
+    mutation_set_operator(previous_operator);
+
+}
+
+/*
+ * NAME
+ *
+ *   job_queue
+ *
+ * DESCRIPTION
+ *
+ *  Runs a queue of jobs back to back in this process. The queue is either
+ *  a folder, in which case every .json file in it is a job and they run in
+ *  the order of their names, or a file listing the path of one job file
+ *  per line. An invalid job is reported and skipped, the rest still run
+ *
+ * PARAMETERS
+ *
+ *  const char* queue -- folder of job files or file listing job files
+ *  FILE* stream -- where the outcome of every job is printed
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of jobs that could not be run
+ *
+ * EXAMPLE
+ *
+ *  uint32_t failed = job_queue("jobs", stdout);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs every job of the queue
+ *
+ */
+
+uint32_t job_queue(const char* queue, FILE* stream) {
+
+    char** paths = malloc(sizeof(char*) * JOB_MAX_QUEUE);
+    uint32_t num_paths = 0;
+    uint32_t failed = 0;
+
+    assert(paths != NULL);
+
+    DIR* folder = opendir(queue);
+
+    if (folder != NULL) {
+
+        // every .json file of the folder, run in the order of their names
+        struct dirent** entries = NULL;
+        int32_t num_entries = scandir(queue, &entries, NULL, alphasort);
+
+        for (int32_t e = 0; e < num_entries; e++) {
+            size_t length = strlen(entries[e]->d_name);
+            if (length > 5 && strcmp(entries[e]->d_name + length - 5, ".json") == 0 && num_paths < JOB_MAX_QUEUE) {
+                paths[num_paths] = malloc(strlen(queue) + length + 2);
+                assert(paths[num_paths] != NULL);
+                sprintf(paths[num_paths++], "%s/%s", queue, entries[e]->d_name);
+            }
+            free(entries[e]);
+        }
+
+        free(entries);
+        closedir(folder);
+
+    }
+    else {
+
+        // a list of job files, one per line, blank lines and # comments skipped
+        FILE* list = fopen(queue, "r");
+        char* line = NULL;
+        size_t len = 0;
+
+        if (list == NULL) {
+            printf("error: could not open job queue %s [file:\'%s\',line:%d]\n", queue, __FILE__, __LINE__);
+            free(paths);
+            return 1;
+        }
+
+        while (getline(&line, &len, list) != -1 && num_paths < JOB_MAX_QUEUE) {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (strlen(line) > 0 && line[0] != '#') {
+                paths[num_paths++] = strdup(line);
+            }
+        }
+
+        free(line);
+        fclose(list);
+
+    }
+
+    for (uint32_t p = 0; p < num_paths; p++) {
+
+        job_str job;
+
+        if (job_load(&job, paths[p])) {
+            job_run(&job, stream);
+        }
+        else {
+            fprintf(stream, "{\"job\":\"%s\",\"status\":\"invalid\",\"file\":\"%s\"}\n", job.name, paths[p]);
+            fflush(stream);
+            failed++;
+        }
+
+        job_free(&job);
+        free(paths[p]);
+
+    }
+
+    free(paths);
+
+    return failed;
+
+}
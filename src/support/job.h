@@ -0,0 +1,332 @@
+/*
+ ============================================================================
+ Name        : job.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   :
+
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+
+ Description : Non-interactive runs described by JSON job specs. A job
+               names the object type, the evolution parameters, the
+               LLVM test and source files, the evaluator, the number of
+               evaluation threads, the seed and the output folder, and is
+               given inline on the command line or in a file. A queue of
+               job files is run back to back in one process, so that
+               builds and control timings stay warm between jobs
+ ============================================================================
+ */
+
+#ifndef SUPPORT_JOB_H_
+#define SUPPORT_JOB_H_
+
+/*
+ * IMPORT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <dirent.h>
+#include "cJSON.h"
+#include "output.h"
+#include "../evolution/evolution.h"
+#include "../evolution/mock.h"
+#include "../evolution/suite.h"
+#include "aarch64.h"
+
+/*
+ * MACROS
+ */
+
+// file names are bounded by the buffers of the LLVM build commands
+#define JOB_MAX_NAME 50
+#define JOB_MAX_QUEUE 4096
+#define JOB_DEFAULT_OUTPUT "src/files/cache/job_"
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    JOB_EVALUATOR_FITNESS,
+    JOB_EVALUATOR_MOCK,
+    JOB_EVALUATOR_AARCH64
+} job_evaluator_typ;
+
+typedef struct job_str {
+    char name[JOB_MAX_NAME];
+    osaka_object_typ type;
+    uint32_t num_generations;
+    uint32_t pop_size;
+    uint32_t indiv_size;
+    uint32_t percent_crossover;
+    uint32_t percent_mutation;
+    mutation_operator_typ mutation_operator;
+    uint32_t tournament_size;
+    bool visualization;
+    char test_file[JOB_MAX_NAME];
+    char** src_files;
+    uint32_t num_src_files;
+    char suite[EVOLUTION_MAX_PATH];
+    job_evaluator_typ evaluator;
+    mock_config_str mock;
+    uint32_t workers;
+    uint64_t seed;
+    char output[EVOLUTION_MAX_PATH];
+    bool cache;
+    runlog_format_typ cache_format;
+    bool trace;
+} job_str;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   job_defaults
+ *
+ * DESCRIPTION
+ *
+ *  Fills in a job with the defaults of an interactive run: 10 generations
+ *  of 20 individuals of 10 genes, 75% crossover, 20% mutation, tournaments
+ *  of 2, the real fitness functions on one thread and a seed taken from
+ *  the clock. The object type is left NOTSET, every job has to name one
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  const char* name -- name of the job, used for its default output folder
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_defaults(&job, "sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void job_defaults(job_str* job, const char* name);
+
+/*
+ * NAME
+ *
+ *   job_type_from_name
+ *
+ * DESCRIPTION
+ *
+ *  Object type with the given name, as listed by -help, in any case
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name of the object type, such as "llvm_pass"
+ *
+ * RETURN
+ *
+ *  osaka_object_typ -- the object type, NOTSET if there is none of that name
+ *
+ * EXAMPLE
+ *
+ *  osaka_object_typ ot = job_type_from_name("SIMPLE");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+osaka_object_typ job_type_from_name(const char* name);
+
+/*
+ * NAME
+ *
+ *   job_from_json
+ *
+ * DESCRIPTION
+ *
+ *  Reads a job from a parsed JSON object on top of the defaults. The keys
+ *  are type, generations, population, genome_length, crossover, mutation,
+ *  mutation_operator ("all_params" or "single_param"), tournament,
+ *  visualization, test_file, sources, suite (a benchmark suite
+ *  file, in place of test_file and sources), evaluator ("fitness", "mock"
+ *  or "aarch64", the emulator for ASSEMBLER), mock (cost_us, latency_us, latency, noise, seed), workers, seed,
+ *  output, cache (true, "jsonl" or "binary") and trace. Unknown keys and
+ *  invalid values are reported and fail the job
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  cJSON* root -- the parsed job spec
+ *  const char* name -- name of the job, used unless the spec has a name key
+ *
+ * RETURN
+ *
+ *  bool -- true if the spec describes a valid job
+ *
+ * EXAMPLE
+ *
+ *  bool valid = job_from_json(&job, root, "sweep_1");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with job_free
+ *
+ */
+
+bool job_from_json(job_str* job, cJSON* root, const char* name);
+
+/*
+ * NAME
+ *
+ *   job_load
+ *
+ * DESCRIPTION
+ *
+ *  Reads a job from a spec given on the command line: either the JSON
+ *  itself, when it starts with a brace, or the path of a file holding it.
+ *  A job read from a file is named after the file without its folder and
+ *  extension
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job to fill in
+ *  const char* spec -- inline JSON or path of a job file
+ *
+ * RETURN
+ *
+ *  bool -- true if the spec was read and describes a valid job
+ *
+ * EXAMPLE
+ *
+ *  bool valid = job_load(&job, "jobs/sweep_1.json");
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs the source file names, free with job_free
+ *
+ */
+
+bool job_load(job_str* job, const char* spec);
+
+/*
+ * NAME
+ *
+ *   job_free
+ *
+ * DESCRIPTION
+ *
+ *  Frees what a job allocated for its source file names
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- the job
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_free(&job);
+ *
+ * SIDE-EFFECT
+ *
+ *  frees memory
+ *
+ */
+
+void job_free(job_str* job);
+
+/*
+ * NAME
+ *
+ *   job_run
+ *
+ * DESCRIPTION
+ *
+ *  Runs the evolution a job describes without asking anything, then puts
+ *  back the evaluator, worker count, output folder and run log format it
+ *  changed, so that the next job starts from the same state. A JSON line
+ *  with the outcome of the job is printed to the stream
+ *
+ * PARAMETERS
+ *
+ *  job_str* job -- a valid job
+ *  FILE* stream -- where the outcome is printed
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  job_run(&job, stdout);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the evolution, reseeds the random generator, may write a run log and a trace
+ *
+ */
+
+void job_run(job_str* job, FILE* stream);
+
+/*
+ * NAME
+ *
+ *   job_queue
+ *
+ * DESCRIPTION
+ *
+ *  Runs a queue of jobs back to back in this process. The queue is either
+ *  a folder, in which case every .json file in it is a job and they run in
+ *  the order of their names, or a file listing the path of one job file
+ *  per line. An invalid job is reported and skipped, the rest still run
+ *
+ * PARAMETERS
+ *
+ *  const char* queue -- folder of job files or file listing job files
+ *  FILE* stream -- where the outcome of every job is printed
+ *
+ * RETURN
+ *
+ *  uint32_t -- number of jobs that could not be run
+ *
+ * EXAMPLE
+ *
+ *  uint32_t failed = job_queue("jobs", stdout);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs every job of the queue
+ *
+ */
+
+uint32_t job_queue(const char* queue, FILE* stream);
+
+#endif /* SUPPORT_JOB_H_ */
@@ -81,8 +81,6 @@
 
 void llvm_form_opt_command(node_str* indiv, char** passes, uint32_t passes_size, char* input_file, char* output_file, char* command) {
 
-    char* used_passes[100];
-
     if (indiv == NULL) {
         if (passes == NULL) {
             printf("No passes specified, return default call\n");
@@ -95,9 +93,6 @@ void llvm_form_opt_command(node_str* indiv, char** passes, uint32_t passes_size,
                 exit(0);
             }
             strcpy(command, "opt ");
-            for (int i = 0; i < passes_size; i++) {
-                used_passes[i] = passes[i];
-            }
         }
     }
     else {
@@ -155,7 +150,7 @@ void llvm_form_opt_command(node_str* indiv, char** passes, uint32_t passes_size,
 
 void llvm_form_run_command(char* file, char* command) {
 
-    char file_name[30];
+    char file_name[LLVM_MAX_PATH];
     char base_name[60];
 
     strcpy(file_name, file);
@@ -212,8 +207,8 @@ void llvm_form_run_command(char* file, char* command) {
 
 void llvm_form_build_ll_command(char** src_files, uint32_t num_src_files, char* test_file, char* command) {
 
-    char src_file_name[30];
-    char test_file_name[30];
+    char src_file_name[LLVM_MAX_PATH];
+    char test_file_name[LLVM_MAX_PATH];
     char base_name[60];
     char compiler[20];
 
@@ -319,7 +314,7 @@ void llvm_form_build_ll_command(char** src_files, uint32_t num_src_files, char*
 
 void llvm_form_exec_code_command(char* file, char* command) {
 
-    char file_name[30];
+    char file_name[LLVM_MAX_PATH];
     char base_name[60];
     char compiler[20];
 
@@ -396,9 +391,7 @@ void llvm_form_exec_code_command(char* file, char* command) {
 
 void llvm_form_exec_code_command_from_ll(char* file, char* command) {
 
-    char file_name[30];
-    char base_name[60];
-    char compiler[20];
+    char file_name[LLVM_MAX_PATH];
 
     strcpy(file_name, file);
     char* p = strchr(file_name, '.');
@@ -491,6 +484,543 @@ void llvm_form_test_command(char** src_files, uint32_t num_src_files, char* test
 
 uint32_t llvm_run_command(char* command) {
 
+    INSTRUMENT_COUNT(INSTRUMENT_COUNTER_COMMANDS, 1);
+
     return system(command) >> 8; // shift by 8 to get the correct error number
 
-}
\ No newline at end of file
+}
+
+/*
+ * NAME
+ *
+ *   __llvm_compile_worker
+ *
+ * DESCRIPTION
+ *
+ *  Internal worker of llvm_build_linked, runs the compile command of a
+ *  single file
+ *
+ * PARAMETERS
+ *
+ *  void* arg - llvm_compile_str* of the file
+ *
+ * RETURN
+ *
+ *  void* - NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&threads[i], NULL, __llvm_compile_worker, &compiles[i]);
+ *
+ * SIDE-EFFECT
+ *
+ *  runs the command through the shell
+ *
+ */
+
+void* __llvm_compile_worker(void* arg) {
+
+    llvm_compile_str* compile = (llvm_compile_str*) arg;
+
+    compile->result = llvm_run_command(compile->command);
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   __llvm_copy_file
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper of llvm_build_linked, copies a file
+ *
+ * PARAMETERS
+ *
+ *  const char* from - the file to copy
+ *  const char* to - the copy, replaced if it exists
+ *
+ * RETURN
+ *
+ *  bool - true if the whole file was copied
+ *
+ * EXAMPLE
+ *
+ *  __llvm_copy_file(cached, "src/files/llvm/test_linked.ll");
+ *
+ * SIDE-EFFECT
+ *
+ *  writes the copy
+ *
+ */
+
+bool __llvm_copy_file(const char* from, const char* to) {
+
+    char buffer[65536];
+    size_t length = 0;
+    bool copied = true;
+
+    FILE* source = fopen(from, "rb");
+    FILE* target = fopen(to, "wb");
+
+    if (source == NULL || target == NULL) {
+        if (source != NULL) {
+            fclose(source);
+        }
+        if (target != NULL) {
+            fclose(target);
+        }
+        return false;
+    }
+
+    while ((length = fread(buffer, 1, sizeof(buffer), source)) > 0) {
+        copied = fwrite(buffer, 1, length, target) == length && copied;
+    }
+
+    fclose(source);
+    return fclose(target) == 0 && copied;
+
+}
+
+/*
+ * NAME
+ *
+ *   llvm_hash_file
+ *
+ * DESCRIPTION
+ *
+ *  Hashes the contents of a file, so that a file is known to be unchanged
+ *  whatever happened to its modification time
+ *
+ * PARAMETERS
+ *
+ *  const char* path - the file to hash
+ *
+ * RETURN
+ *
+ *  uint64_t - hash of the contents, 0 if the file could not be read
+ *
+ * EXAMPLE
+ *
+ *  uint64_t hash = llvm_hash_file("src/files/llvm/test.cpp");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t llvm_hash_file(const char* path) {
+
+    unsigned char buffer[65536];
+    size_t length = 0;
+    uint64_t hash = 0;
+
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return 0;
+    }
+
+    // eight bytes at a time, the tail padded with zeroes
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        for (size_t i = 0; i < length; i += 8) {
+            uint64_t word = 0;
+            memcpy(&word, buffer + i, length - i < 8 ? length - i : 8);
+            hash = hash_combine(hash, word);
+        }
+        hash = hash_combine(hash, length);
+    }
+
+    fclose(file);
+
+    return hash == 0 ? 1 : hash;
+
+}
+
+/*
+ * NAME
+ *
+ *   __llvm_hash_headers
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper of llvm_build_linked, hashes the name and contents of
+ *  every .h and .hpp file in the folder of a source file, in name order
+ *
+ * PARAMETERS
+ *
+ *  const char* source - path of the source file
+ *  uint64_t hash - hash the headers are combined into
+ *
+ * RETURN
+ *
+ *  uint64_t - the hash combined with every header
+ *
+ * EXAMPLE
+ *
+ *  uint64_t headers = __llvm_hash_headers("src/files/llvm/acotsp/ants.c", hash_string("clang"));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t __llvm_hash_headers(const char* source, uint64_t hash) {
+
+    char folder[LLVM_MAX_PATH];
+    char path[LLVM_MAX_PATH * 2];
+
+    strcpy(folder, source);
+    char* slash = strrchr(folder, '/');
+
+    if (slash == NULL) {
+        strcpy(folder, ".");
+    }
+    else {
+        *slash = 0;
+    }
+
+    struct dirent** entries = NULL;
+    int32_t num_entries = scandir(folder, &entries, NULL, alphasort);
+
+    for (int32_t e = 0; e < num_entries; e++) {
+        char* extension = strrchr(entries[e]->d_name, '.');
+        if (extension != NULL && (strcmp(extension, ".h") == 0 || strcmp(extension, ".hpp") == 0)) {
+            if (snprintf(path, sizeof(path), "%s/%s", folder, entries[e]->d_name) >= (int) sizeof(path)) {
+                printf("error: the path of header %s is longer than %d characters [file:\'%s\',line:%d]\n", entries[e]->d_name, (int) sizeof(path) - 1, __FILE__, __LINE__);
+                exit(0);
+            }
+            hash = hash_combine(hash_combine(hash, hash_string(entries[e]->d_name)), llvm_hash_file(path));
+        }
+        free(entries[e]);
+    }
+
+    free(entries);
+
+    return hash;
+
+}
+
+/*
+ * NAME
+ *
+ *   llvm_cache_linked_file
+ *
+ * DESCRIPTION
+ *
+ *  Path of the linked module with the given key in the build cache, for
+ *  callers that need more than one linked module at a time
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  char* path - set to the path, at least LLVM_MAX_PATH long
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  llvm_cache_linked_file(key, linked_file);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void llvm_cache_linked_file(uint64_t key, char* path) {
+
+    snprintf(path, LLVM_MAX_PATH, "%s/%016lx_linked.ll", LLVM_CACHE_FOLDER, (unsigned long) key);
+
+}
+
+/*
+ * NAME
+ *
+ *   llvm_build_linked
+ *
+ * DESCRIPTION
+ *
+ *  Builds src/files/llvm/<test>_linked.ll from the test file and its source
+ *  files through the build cache in LLVM_CACHE_FOLDER. Every file is compiled
+ *  to IR under the hash of its contents, the headers next to it and the
+ *  compiler, and the linked module is kept under the hashes of its parts,
+ *  so only files that changed since any earlier run are compiled again.
+ *  Files that need compiling are compiled in parallel
+ *
+ * PARAMETERS
+ *
+ *  char** src_files - source files in src/files/llvm
+ *  uint32_t num_src_files - number of source files
+ *  char* test_file - the .c or .cpp test file in src/files/llvm
+ *
+ * RETURN
+ *
+ *  uint64_t - key of the linked module, used to look up its control timings
+ *
+ * EXAMPLE
+ *
+ *  uint64_t key = llvm_build_linked(src_files, 2, "test.cpp");
+ *
+ * SIDE-EFFECT
+ *
+ *  runs clang and llvm-link through the shell, writes to the build cache
+ *
+ */
+
+uint64_t llvm_build_linked(char** src_files, uint32_t num_src_files, char* test_file) {
+
+    char test_file_name[LLVM_MAX_PATH];
+    char compiler[20];
+    char path[LLVM_MAX_PATH];
+    char linked_file[LLVM_MAX_PATH];
+    char link_command[LLVM_MAX_COMMAND * (LLVM_MAX_JOBS + 1)];
+    uint32_t num_files = num_src_files + 1;
+    uint32_t num_compiles = 0;
+
+    strcpy(test_file_name, test_file);
+    char* p = strchr(test_file_name, '.');
+
+    if (!p) {
+        printf("File must have valid extension such as .c or .cpp.\n\nAborting code\n\n");
+        exit(0);
+    }
+    *p = 0;
+
+    if (strstr(test_file, ".cpp") != NULL) {
+        strcpy(compiler, "clang++");
+    }
+    else if (strstr(test_file, ".c") != NULL) {
+        strcpy(compiler, "clang");
+    }
+    else {
+        printf("File type of %s used with llvm is not supported.\n\nAborting code\n\n", test_file);
+        exit(0);
+    }
+
+    if (num_files > LLVM_MAX_JOBS) {
+        printf("error: at most %d source files can be built [file:\'%s\',line:%d]\n", LLVM_MAX_JOBS - 1, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    if (mkdir(LLVM_CACHE_FOLDER, 0755) != 0 && errno != EEXIST) {
+        printf("error: could not create build cache %s [file:\'%s\',line:%d]\n", LLVM_CACHE_FOLDER, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    // headers are included by name, so every header next to a file is part of its key
+    uint64_t compiler_hash = hash_string(compiler);
+
+    llvm_compile_str compiles[LLVM_MAX_JOBS];
+    pthread_t threads[LLVM_MAX_JOBS];
+    uint64_t key = compiler_hash;
+
+    snprintf(link_command, sizeof(link_command), "llvm-link");
+
+    for (uint32_t f = 0; f < num_files; f++) {
+
+        char* name = f == 0 ? test_file : src_files[f - 1];
+        char ir_file[LLVM_MAX_PATH];
+
+        snprintf(path, LLVM_MAX_PATH, "%s%s", LLVM_FOLDER, name);
+        uint64_t content = llvm_hash_file(path);
+        uint64_t headers = __llvm_hash_headers(path, compiler_hash);
+
+        if (content == 0) {
+            printf("error: could not read %s [file:\'%s\',line:%d]\n", path, __FILE__, __LINE__);
+            exit(0);
+        }
+
+        uint64_t file_key = hash_combine(headers, content);
+        key = hash_combine(key, file_key);
+
+        snprintf(ir_file, LLVM_MAX_PATH, "%s/%016lx.ll", LLVM_CACHE_FOLDER, (unsigned long) file_key);
+        snprintf(link_command + strlen(link_command), sizeof(link_command) - strlen(link_command), " %s", ir_file);
+
+        // compiled to a file of its own first, so that an interrupted compile never looks cached
+        if (access(ir_file, F_OK) != 0) {
+            // a cut short command would compile or move the wrong file, so it is never run
+            if (snprintf(compiles[num_compiles].command, LLVM_MAX_COMMAND, "%s -S -emit-llvm %s -o %s.%d && mv %s.%d %s",
+                compiler, path, ir_file, (int) getpid(), ir_file, (int) getpid(), ir_file) >= LLVM_MAX_COMMAND) {
+                printf("error: the command to compile %s is longer than %d characters [file:\'%s\',line:%d]\n", path, LLVM_MAX_COMMAND - 1, __FILE__, __LINE__);
+                exit(0);
+            }
+            strcpy(compiles[num_compiles].file, path);
+            num_compiles++;
+        }
+
+    }
+
+    for (uint32_t c = 0; c < num_compiles; c++) {
+        pthread_create(&threads[c], NULL, __llvm_compile_worker, &compiles[c]);
+    }
+    for (uint32_t c = 0; c < num_compiles; c++) {
+        pthread_join(threads[c], NULL);
+        if (compiles[c].result != 0) {
+            printf("error: could not compile %s [file:\'%s\',line:%d]\n", compiles[c].file, __FILE__, __LINE__);
+            exit(0);
+        }
+    }
+
+    llvm_cache_linked_file(key, linked_file);
+
+    if (access(linked_file, F_OK) != 0) {
+
+        snprintf(link_command + strlen(link_command), sizeof(link_command) - strlen(link_command), " -S -o %s.%d && mv %s.%d %s",
+            linked_file, (int) getpid(), linked_file, (int) getpid(), linked_file);
+
+        if (llvm_run_command(link_command) != 0) {
+            printf("error: could not link %s [file:\'%s\',line:%d]\n", test_file, __FILE__, __LINE__);
+            exit(0);
+        }
+
+    }
+
+    printf("Built %s from the build cache, %u of %u file(s) compiled\n\n", test_file, num_compiles, num_files);
+
+    // the rest of the tool works on the linked module next to the sources
+    if (snprintf(path, LLVM_MAX_PATH, "%s%s_linked.ll", LLVM_FOLDER, test_file_name) >= LLVM_MAX_PATH) {
+        printf("error: the linked module of %s needs a path longer than %d characters [file:\'%s\',line:%d]\n", test_file, LLVM_MAX_PATH - 1, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    if (!__llvm_copy_file(linked_file, path)) {
+        printf("error: could not copy %s to %s [file:\'%s\',line:%d]\n", linked_file, path, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    return key;
+
+}
+
+/*
+ * NAME
+ *
+ *   llvm_cache_lookup_baselines
+ *
+ * DESCRIPTION
+ *
+ *  Looks up the control timings, with no and with basic optimization, that
+ *  were measured for a linked module on this machine
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  double* no_optimization - set to the time without optimization, in seconds
+ *  double* basic_optimization - set to the time with basic optimization, in seconds
+ *
+ * RETURN
+ *
+ *  bool - true if timings were found
+ *
+ * EXAMPLE
+ *
+ *  if (llvm_cache_lookup_baselines(key, &no_opt, &basic_opt)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool llvm_cache_lookup_baselines(uint64_t key, double* no_optimization, double* basic_optimization) {
+
+    char path[LLVM_MAX_PATH];
+    char host[100];
+    bool found = false;
+
+    // timings only hold for the machine they were measured on
+    if (gethostname(host, sizeof(host)) != 0) {
+        strcpy(host, "unknown");
+    }
+
+    snprintf(path, LLVM_MAX_PATH, "%s/%016lx_baselines.json", LLVM_CACHE_FOLDER, (unsigned long) key);
+
+    if (access(path, R_OK) != 0) {
+        return false;
+    }
+
+    cJSON* root = getJSON(path);
+    cJSON* cached_host = cJSON_GetObjectItemCaseSensitive(root, "host");
+    cJSON* cached_no_optimization = cJSON_GetObjectItemCaseSensitive(root, "no_optimization");
+    cJSON* cached_basic_optimization = cJSON_GetObjectItemCaseSensitive(root, "basic_optimization");
+
+    if (cJSON_IsString(cached_host) && strcmp(cached_host->valuestring, host) == 0 &&
+        cJSON_IsNumber(cached_no_optimization) && cJSON_IsNumber(cached_basic_optimization)) {
+        *no_optimization = cached_no_optimization->valuedouble;
+        *basic_optimization = cached_basic_optimization->valuedouble;
+        found = true;
+    }
+
+    cJSON_Delete(root);
+
+    return found;
+
+}
+
+/*
+ * NAME
+ *
+ *   llvm_cache_store_baselines
+ *
+ * DESCRIPTION
+ *
+ *  Stores the control timings of a linked module for this machine in the
+ *  build cache, for llvm_cache_lookup_baselines
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  double no_optimization - time without optimization, in seconds
+ *  double basic_optimization - time with basic optimization, in seconds
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  llvm_cache_store_baselines(key, no_opt, basic_opt);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the build cache
+ *
+ */
+
+void llvm_cache_store_baselines(uint64_t key, double no_optimization, double basic_optimization) {
+
+    char path[LLVM_MAX_PATH];
+    char temp_path[LLVM_MAX_PATH + 20];
+    char host[100];
+
+    if (gethostname(host, sizeof(host)) != 0) {
+        strcpy(host, "unknown");
+    }
+
+    if (mkdir(LLVM_CACHE_FOLDER, 0755) != 0 && errno != EEXIST) {
+        printf("error: could not create build cache %s [file:\'%s\',line:%d]\n", LLVM_CACHE_FOLDER, __FILE__, __LINE__);
+        return;
+    }
+
+    snprintf(path, LLVM_MAX_PATH, "%s/%016lx_baselines.json", LLVM_CACHE_FOLDER, (unsigned long) key);
+    snprintf(temp_path, sizeof(temp_path), "%s.%d", path, (int) getpid());
+
+    FILE* file = fopen(temp_path, "w");
+
+    if (file == NULL) {
+        printf("error: could not write %s [file:\'%s\',line:%d]\n", temp_path, __FILE__, __LINE__);
+        return;
+    }
+
+    fprintf(file, "{\"host\":\"%s\",\"no_optimization\":%.9f,\"basic_optimization\":%.9f}\n", host, no_optimization, basic_optimization);
+    fclose(file);
+    rename(temp_path, path);
+
+}
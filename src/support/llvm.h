@@ -42,6 +42,33 @@
  */
 
 #include "../osaka/osaka.h"
+#include <pthread.h>
+#include <dirent.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*
+ * MACROS
+ */
+
+#define LLVM_FOLDER "src/files/llvm/"
+#define LLVM_CACHE_FOLDER "src/files/llvm/cache"
+#define LLVM_MAX_PATH 200
+#define LLVM_MAX_COMMAND 700
+
+// the test file and its source files, each compiled on a thread of its own
+#define LLVM_MAX_JOBS 32
+
+/*
+ * DATATYPES
+ */
+
+typedef struct llvm_compile_str {
+    char file[LLVM_MAX_PATH];
+    char command[LLVM_MAX_COMMAND];
+    uint32_t result;
+} llvm_compile_str;
 
 /*
  * ROUTINES
@@ -278,4 +305,165 @@ void llvm_form_test_command(char** src_files, uint32_t num_src_files, char* test
 
 uint32_t llvm_run_command(char* command);
 
+/*
+ * NAME
+ *
+ *   llvm_hash_file
+ *
+ * DESCRIPTION
+ *
+ *  Hashes the contents of a file, so that a file is known to be unchanged
+ *  whatever happened to its modification time
+ *
+ * PARAMETERS
+ *
+ *  const char* path - the file to hash
+ *
+ * RETURN
+ *
+ *  uint64_t - hash of the contents, 0 if the file could not be read
+ *
+ * EXAMPLE
+ *
+ *  uint64_t hash = llvm_hash_file("src/files/llvm/test.cpp");
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t llvm_hash_file(const char* path);
+
+/*
+ * NAME
+ *
+ *   llvm_cache_linked_file
+ *
+ * DESCRIPTION
+ *
+ *  Path of the linked module with the given key in the build cache, for
+ *  callers that need more than one linked module at a time
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  char* path - set to the path, at least LLVM_MAX_PATH long
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  llvm_cache_linked_file(key, linked_file);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void llvm_cache_linked_file(uint64_t key, char* path);
+
+/*
+ * NAME
+ *
+ *   llvm_build_linked
+ *
+ * DESCRIPTION
+ *
+ *  Builds src/files/llvm/<test>_linked.ll from the test file and its source
+ *  files through the build cache in LLVM_CACHE_FOLDER. Every file is compiled
+ *  to IR under the hash of its contents, the headers next to it and the
+ *  compiler, and the linked module is kept under the hashes of its parts,
+ *  so only files that changed since any earlier run are compiled again.
+ *  Files that need compiling are compiled in parallel
+ *
+ * PARAMETERS
+ *
+ *  char** src_files - source files in src/files/llvm
+ *  uint32_t num_src_files - number of source files
+ *  char* test_file - the .c or .cpp test file in src/files/llvm
+ *
+ * RETURN
+ *
+ *  uint64_t - key of the linked module, used to look up its control timings
+ *
+ * EXAMPLE
+ *
+ *  uint64_t key = llvm_build_linked(src_files, 2, "test.cpp");
+ *
+ * SIDE-EFFECT
+ *
+ *  runs clang and llvm-link through the shell, writes to the build cache
+ *
+ */
+
+uint64_t llvm_build_linked(char** src_files, uint32_t num_src_files, char* test_file);
+
+/*
+ * NAME
+ *
+ *   llvm_cache_lookup_baselines
+ *
+ * DESCRIPTION
+ *
+ *  Looks up the control timings, with no and with basic optimization, that
+ *  were measured for a linked module on this machine
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  double* no_optimization - set to the time without optimization, in seconds
+ *  double* basic_optimization - set to the time with basic optimization, in seconds
+ *
+ * RETURN
+ *
+ *  bool - true if timings were found
+ *
+ * EXAMPLE
+ *
+ *  if (llvm_cache_lookup_baselines(key, &no_opt, &basic_opt)) { ... }
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool llvm_cache_lookup_baselines(uint64_t key, double* no_optimization, double* basic_optimization);
+
+/*
+ * NAME
+ *
+ *   llvm_cache_store_baselines
+ *
+ * DESCRIPTION
+ *
+ *  Stores the control timings of a linked module for this machine in the
+ *  build cache, for llvm_cache_lookup_baselines
+ *
+ * PARAMETERS
+ *
+ *  uint64_t key - key of the linked module, from llvm_build_linked
+ *  double no_optimization - time without optimization, in seconds
+ *  double basic_optimization - time with basic optimization, in seconds
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  llvm_cache_store_baselines(key, no_opt, basic_opt);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the build cache
+ *
+ */
+
+void llvm_cache_store_baselines(uint64_t key, double no_optimization, double basic_optimization);
+
 #endif /* SUPPORT_LLVM_H_ */
\ No newline at end of file
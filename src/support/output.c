@@ -0,0 +1,673 @@
+/*
+ ============================================================================
+ Name        : output.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Asynchronous output. Once started, text written through
+               output_printf and output_write is only copied into a bounded
+               lock-free queue, and a background writer thread drains the
+               queue into the destination streams. When the queue is full
+               records are either dropped or the writer waits, depending on
+               the policy. Before output_start, and after output_stop, the
+               same routines write synchronously
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "output.h"
+
+/*
+ * STATIC
+ */
+
+// the one output queue of the process, NULL while output is synchronous
+static output_queue_str* output_queue = NULL;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __output_idle
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that sleeps the calling thread for OUTPUT_IDLE_NS
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __output_idle();
+ *
+ * SIDE-EFFECT
+ *
+ *  sleeps
+ *
+ */
+
+void __output_idle(void) {
+
+    struct timespec idle = { 0, OUTPUT_IDLE_NS };
+
+    nanosleep(&idle, NULL);
+
+}
+
+/*
+ * NAME
+ *
+ *   __output_enqueue
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that claims a record of the queue and fills it. The
+ *  queue is a bounded multi producer queue where every record carries a
+ *  sequence number, so producers only contend on one compare and swap of
+ *  the head and never take a lock. When the queue is full a text record
+ *  is dropped or the producer yields until there is room, by policy, sync
+ *  records always wait
+ *
+ * PARAMETERS
+ *
+ *  output_record_typ type -- kind of record
+ *  FILE* stream -- destination stream
+ *  const char* data -- text to write, may be NULL for sync records
+ *  size_t length -- length of the text
+ *
+ * RETURN
+ *
+ *  bool -- false if the record was dropped
+ *
+ * EXAMPLE
+ *
+ *  __output_enqueue(OUTPUT_RECORD_TEXT, stdout, text, length);
+ *
+ * SIDE-EFFECT
+ *
+ *  may allocate a copy of long text, may yield
+ *
+ */
+
+bool __output_enqueue(output_record_typ type, FILE* stream, const char* data, size_t length) {
+
+    output_queue_str* q = output_queue;
+    output_record_str* record;
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    while (true) {
+
+        record = &q->records[pos & q->mask];
+        size_t sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // the queue is full, only text can be dropped
+            if (q->policy == OUTPUT_DROP && type == OUTPUT_RECORD_TEXT) {
+                atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+                return false;
+            }
+            sched_yield();
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+        else {
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+        }
+
+    }
+
+    record->type = type;
+    record->stream = stream;
+    record->length = length;
+    record->data = record->text;
+
+    if (length > OUTPUT_INLINE_SIZE) {
+        record->data = malloc(length);
+        assert(record->data != NULL);
+    }
+    if (length > 0) {
+        memcpy(record->data, data, length);
+    }
+
+    atomic_store_explicit(&record->sequence, pos + 1, memory_order_release);
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __output_dequeue
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper used by the writer to take the oldest published record
+ *  off the queue and write it out
+ *
+ * PARAMETERS
+ *
+ *  output_queue_str* q -- the queue
+ *
+ * RETURN
+ *
+ *  bool -- false if there was nothing to write
+ *
+ * EXAMPLE
+ *
+ *  while (__output_dequeue(q)) ;
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the record stream, frees long text
+ *
+ */
+
+bool __output_dequeue(output_queue_str* q) {
+
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    output_record_str* record = &q->records[pos & q->mask];
+
+    if (atomic_load_explicit(&record->sequence, memory_order_acquire) != pos + 1) {
+        return false;
+    }
+
+    if (record->type == OUTPUT_RECORD_SYNC) {
+        fflush(record->stream);
+        fsync(fileno(record->stream));
+    }
+    else {
+        fwrite(record->data, 1, record->length, record->stream);
+    }
+
+    if (record->data != record->text) {
+        free(record->data);
+    }
+
+    // hand the record back to the producers for the next lap of the ring
+    atomic_store_explicit(&record->sequence, pos + q->mask + 1, memory_order_release);
+    atomic_store_explicit(&q->tail, pos + 1, memory_order_release);
+
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   __output_writer
+ *
+ * DESCRIPTION
+ *
+ *  Internal writer thread. Drains the queue, flushes the streams whenever
+ *  it runs dry, and exits once output_stop was called and everything was
+ *  written
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- output_queue_str* to drain
+ *
+ * RETURN
+ *
+ *  void* -- NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&q->writer, NULL, __output_writer, q);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to every stream used
+ *
+ */
+
+void* __output_writer(void* arg) {
+
+    output_queue_str* q = arg;
+    bool written = false;
+
+    while (true) {
+
+        if (__output_dequeue(q)) {
+            written = true;
+            continue;
+        }
+
+        if (written) {
+            fflush(NULL);
+            written = false;
+        }
+
+        if (!atomic_load(&q->running) && atomic_load(&q->tail) == atomic_load(&q->head)) {
+            break;
+        }
+
+        __output_idle();
+
+    }
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   output_start
+ *
+ * DESCRIPTION
+ *
+ *  Starts asynchronous output with a queue of at least capacity records
+ *  and the given policy for when it is full. A final flush is registered
+ *  to run at exit
+ *
+ * PARAMETERS
+ *
+ *  uint32_t capacity -- number of records, rounded up to a power of two
+ *  output_policy_typ policy -- OUTPUT_BLOCK to wait for room, OUTPUT_DROP to drop records
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_start(OUTPUT_DEFAULT_CAPACITY, OUTPUT_DROP);
+ *
+ * SIDE-EFFECT
+ *
+ *  starts the writer thread
+ *
+ */
+
+void output_start(uint32_t capacity, output_policy_typ policy) {
+
+    static bool registered = false;
+    size_t size = 2;
+
+    assert(output_queue == NULL);
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    output_queue_str* q = malloc(sizeof(output_queue_str));
+    output_record_str* records = malloc(sizeof(output_record_str) * size);
+
+    if (q == NULL || records == NULL) {
+        printf("error: failed to alloc memory for the output queue [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&records[i].sequence, i);
+    }
+
+    q->records = records;
+    q->mask = size - 1;
+    q->policy = policy;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->dropped, 0);
+    atomic_init(&q->running, true);
+
+    // anything printed so far must come out before the queued text
+    fflush(NULL);
+
+    if (pthread_create(&q->writer, NULL, __output_writer, q) != 0) {
+        printf("error: failed to create the output writer thread [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    output_queue = q;
+
+    if (!registered) {
+        atexit(output_stop);
+        registered = true;
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   output_stop
+ *
+ * DESCRIPTION
+ *
+ *  Stops asynchronous output. Everything queued so far is written out
+ *  before the writer thread exits, after which output is synchronous
+ *  again. Does nothing if output was not started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_stop();
+ *
+ * SIDE-EFFECT
+ *
+ *  joins the writer thread and frees the queue
+ *
+ */
+
+void output_stop(void) {
+
+    output_queue_str* q = output_queue;
+
+    if (q == NULL) {
+        return;
+    }
+
+    atomic_store(&q->running, false);
+    pthread_join(q->writer, NULL);
+    fflush(NULL);
+
+    output_queue = NULL;
+    free(q->records);
+    free(q);
+
+}
+
+/*
+ * NAME
+ *
+ *   output_running
+ *
+ * DESCRIPTION
+ *
+ *  Whether asynchronous output is currently started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between output_start and output_stop
+ *
+ * EXAMPLE
+ *
+ *  if (!output_running()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool output_running(void) {
+
+    return output_queue != NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   output_write
+ *
+ * DESCRIPTION
+ *
+ *  Writes length bytes to a stream, through the queue if asynchronous
+ *  output is started
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- destination stream
+ *  const char* data -- bytes to write
+ *  size_t length -- number of bytes
+ *
+ * RETURN
+ *
+ *  bool -- false if the record was dropped
+ *
+ * EXAMPLE
+ *
+ *  output_write(log->file, record, length);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues the bytes
+ *
+ */
+
+bool output_write(FILE* stream, const char* data, size_t length) {
+
+    if (output_queue == NULL) {
+        return fwrite(data, 1, length, stream) == length;
+    }
+
+    return __output_enqueue(OUTPUT_RECORD_TEXT, stream, data, length);
+
+}
+
+/*
+ * NAME
+ *
+ *   output_printf
+ *
+ * DESCRIPTION
+ *
+ *  Formatted counterpart of output_write. Only the formatting is done on
+ *  the calling thread, the text is written by the writer thread
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- destination stream
+ *  const char* format -- printf style format
+ *  ... -- values for the format
+ *
+ * RETURN
+ *
+ *  bool -- false if the record was dropped
+ *
+ * EXAMPLE
+ *
+ *  output_printf(stdout, "Generation %d\\n", g + 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues the text
+ *
+ */
+
+bool output_printf(FILE* stream, const char* format, ...) {
+
+    char text[OUTPUT_INLINE_SIZE];
+    va_list args;
+
+    if (output_queue == NULL) {
+        va_start(args, format);
+        int length = vfprintf(stream, format, args);
+        va_end(args);
+        return length >= 0;
+    }
+
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length < 0) {
+        return false;
+    }
+    if ((size_t) length < sizeof(text)) {
+        return __output_enqueue(OUTPUT_RECORD_TEXT, stream, text, length);
+    }
+
+    // too long for the record, format again into a buffer of the right size
+    char* long_text = malloc(length + 1);
+    assert(long_text != NULL);
+    va_start(args, format);
+    vsnprintf(long_text, length + 1, format, args);
+    va_end(args);
+
+    bool queued = __output_enqueue(OUTPUT_RECORD_TEXT, stream, long_text, length);
+    free(long_text);
+
+    return queued;
+
+}
+
+/*
+ * NAME
+ *
+ *   output_sync
+ *
+ * DESCRIPTION
+ *
+ *  Flushes a stream and syncs it to disk once everything queued for it
+ *  before this call has been written
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to sync, must refer to a file
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_sync(log->file);
+ *
+ * SIDE-EFFECT
+ *
+ *  flushes and syncs the stream, now or from the writer
+ *
+ */
+
+void output_sync(FILE* stream) {
+
+    if (output_queue == NULL) {
+        fflush(stream);
+        fsync(fileno(stream));
+        return;
+    }
+
+    // a sync is never dropped, it waits for room whatever the policy
+    __output_enqueue(OUTPUT_RECORD_SYNC, stream, NULL, 0);
+
+}
+
+/*
+ * NAME
+ *
+ *   output_flush
+ *
+ * DESCRIPTION
+ *
+ *  Waits until everything queued before this call has been written and
+ *  flushes all streams, e.g. before a stream is closed or before printing
+ *  directly
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_flush();
+ *
+ * SIDE-EFFECT
+ *
+ *  may wait for the writer thread
+ *
+ */
+
+void output_flush(void) {
+
+    output_queue_str* q = output_queue;
+
+    if (q != NULL) {
+
+        size_t target = atomic_load(&q->head);
+
+        while (atomic_load(&q->tail) < target) {
+            __output_idle();
+        }
+
+    }
+
+    fflush(NULL);
+
+}
+
+/*
+ * NAME
+ *
+ *   output_dropped
+ *
+ * DESCRIPTION
+ *
+ *  Number of records dropped because the queue was full
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- dropped records since output_start
+ *
+ * EXAMPLE
+ *
+ *  printf("%lu records dropped\\n", output_dropped());
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t output_dropped(void) {
+
+    return output_queue != NULL ? atomic_load(&output_queue->dropped) : 0;
+
+}
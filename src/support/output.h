@@ -0,0 +1,352 @@
+/*
+ ============================================================================
+ Name        : output.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Asynchronous output. Once started, text written through
+               output_printf and output_write is only copied into a bounded
+               lock-free queue, and a background writer thread drains the
+               queue into the destination streams. When the queue is full
+               records are either dropped or the writer waits, depending on
+               the policy. Before output_start, and after output_stop, the
+               same routines write synchronously
+ ============================================================================
+ */
+
+#ifndef SUPPORT_OUTPUT_H_
+#define SUPPORT_OUTPUT_H_
+
+/*
+ * IMPORT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    OUTPUT_BLOCK,
+    OUTPUT_DROP
+} output_policy_typ;
+
+typedef enum {
+    OUTPUT_RECORD_TEXT,
+    OUTPUT_RECORD_SYNC
+} output_record_typ;
+
+typedef struct output_record_str {
+    _Atomic size_t sequence;
+    output_record_typ type;
+    FILE* stream;
+    size_t length;
+    char* data;
+    char text[240];
+} output_record_str;
+
+typedef struct output_queue_str {
+    output_record_str* records;
+    size_t mask;
+    output_policy_typ policy;
+    _Atomic size_t head;
+    _Atomic size_t tail;
+    _Atomic uint64_t dropped;
+    _Atomic bool running;
+    pthread_t writer;
+} output_queue_str;
+
+/*
+ * MACROS
+ */
+
+// text up to this size is copied into the record itself, longer text
+// gets its own allocation that the writer frees
+#define OUTPUT_INLINE_SIZE sizeof(((output_record_str*) 0)->text)
+#define OUTPUT_DEFAULT_CAPACITY 65536
+
+// how long the writer sleeps when it finds the queue empty
+#define OUTPUT_IDLE_NS 100000
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   output_start
+ *
+ * DESCRIPTION
+ *
+ *  Starts asynchronous output with a queue of at least capacity records
+ *  and the given policy for when it is full. A final flush is registered
+ *  to run at exit
+ *
+ * PARAMETERS
+ *
+ *  uint32_t capacity -- number of records, rounded up to a power of two
+ *  output_policy_typ policy -- OUTPUT_BLOCK to wait for room, OUTPUT_DROP to drop records
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_start(OUTPUT_DEFAULT_CAPACITY, OUTPUT_DROP);
+ *
+ * SIDE-EFFECT
+ *
+ *  starts the writer thread
+ *
+ */
+
+void output_start(uint32_t capacity, output_policy_typ policy);
+
+/*
+ * NAME
+ *
+ *   output_stop
+ *
+ * DESCRIPTION
+ *
+ *  Stops asynchronous output. Everything queued so far is written out
+ *  before the writer thread exits, after which output is synchronous
+ *  again. Does nothing if output was not started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_stop();
+ *
+ * SIDE-EFFECT
+ *
+ *  joins the writer thread and frees the queue
+ *
+ */
+
+void output_stop(void);
+
+/*
+ * NAME
+ *
+ *   output_running
+ *
+ * DESCRIPTION
+ *
+ *  Whether asynchronous output is currently started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between output_start and output_stop
+ *
+ * EXAMPLE
+ *
+ *  if (!output_running()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool output_running(void);
+
+/*
+ * NAME
+ *
+ *   output_write
+ *
+ * DESCRIPTION
+ *
+ *  Writes length bytes to a stream, through the queue if asynchronous
+ *  output is started
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- destination stream
+ *  const char* data -- bytes to write
+ *  size_t length -- number of bytes
+ *
+ * RETURN
+ *
+ *  bool -- false if the record was dropped
+ *
+ * EXAMPLE
+ *
+ *  output_write(log->file, record, length);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues the bytes
+ *
+ */
+
+bool output_write(FILE* stream, const char* data, size_t length);
+
+/*
+ * NAME
+ *
+ *   output_printf
+ *
+ * DESCRIPTION
+ *
+ *  Formatted counterpart of output_write. Only the formatting is done on
+ *  the calling thread, the text is written by the writer thread
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- destination stream
+ *  const char* format -- printf style format
+ *  ... -- values for the format
+ *
+ * RETURN
+ *
+ *  bool -- false if the record was dropped
+ *
+ * EXAMPLE
+ *
+ *  output_printf(stdout, "Generation %d\\n", g + 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues the text
+ *
+ */
+
+bool output_printf(FILE* stream, const char* format, ...);
+
+/*
+ * NAME
+ *
+ *   output_sync
+ *
+ * DESCRIPTION
+ *
+ *  Flushes a stream and syncs it to disk once everything queued for it
+ *  before this call has been written
+ *
+ * PARAMETERS
+ *
+ *  FILE* stream -- stream to sync, must refer to a file
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_sync(log->file);
+ *
+ * SIDE-EFFECT
+ *
+ *  flushes and syncs the stream, now or from the writer
+ *
+ */
+
+void output_sync(FILE* stream);
+
+/*
+ * NAME
+ *
+ *   output_flush
+ *
+ * DESCRIPTION
+ *
+ *  Waits until everything queued before this call has been written and
+ *  flushes all streams, e.g. before a stream is closed or before printing
+ *  directly
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  output_flush();
+ *
+ * SIDE-EFFECT
+ *
+ *  may wait for the writer thread
+ *
+ */
+
+void output_flush(void);
+
+/*
+ * NAME
+ *
+ *   output_dropped
+ *
+ * DESCRIPTION
+ *
+ *  Number of records dropped because the queue was full
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- dropped records since output_start
+ *
+ * EXAMPLE
+ *
+ *  printf("%lu records dropped\\n", output_dropped());
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t output_dropped(void);
+
+#endif /* SUPPORT_OUTPUT_H_ */
@@ -0,0 +1,838 @@
+/*
+ ============================================================================
+ Name        : runlog.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Structured run log. Every cached evolutionary run writes
+               a single file holding the run header and parameters, the
+               baseline timings and one record per evaluated individual,
+               either as JSON Lines or as a compact binary stream. Records
+               are composed in memory and handed to output_write, so with
+               asynchronous output they are written by the writer thread.
+               The file goes through a large stdio buffer and is only
+               synced to disk every RUNLOG_SYNC_INTERVAL records
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "runlog.h"
+#include <unistd.h>
+#include <stdarg.h>
+
+/*
+ * STATIC
+ */
+
+// format used for the cached runs of the evolution, see runlog_set_format
+static runlog_format_typ runlog_format = RUNLOG_JSONL;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __runlog_append
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends bytes to the record being composed
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  const void* data -- bytes to append
+ *  size_t length -- number of bytes
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_append(log, &value, sizeof(uint32_t));
+ *
+ * SIDE-EFFECT
+ *
+ *  may grow the record buffer
+ *
+ */
+
+void __runlog_append(runlog_str* log, const void* data, size_t length) {
+
+    if (log->record_length + length > log->record_capacity) {
+
+        while (log->record_length + length > log->record_capacity) {
+            log->record_capacity *= 2;
+        }
+
+        log->record = realloc(log->record, log->record_capacity);
+        assert(log->record != NULL);
+
+    }
+
+    memcpy(log->record + log->record_length, data, length);
+    log->record_length += length;
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_appendf
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends formatted text to the record being
+ *  composed
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  const char* format -- printf style format
+ *  ... -- values for the format
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_appendf(log, ",\"seconds\":%.9g}\n", seconds);
+ *
+ * SIDE-EFFECT
+ *
+ *  may grow the record buffer
+ *
+ */
+
+void __runlog_appendf(runlog_str* log, const char* format, ...) {
+
+    char text[RUNLOG_DESC_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    assert(length >= 0 && (size_t) length < sizeof(text));
+    __runlog_append(log, text, length);
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_write_json_string
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends a string as a quoted JSON string,
+ *  escaping quotes, backslashes and control characters
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  char* str -- string to write
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_write_json_string(log, test_file);
+ *
+ * SIDE-EFFECT
+ *
+ *  appends to the record
+ *
+ */
+
+void __runlog_write_json_string(runlog_str* log, char* str) {
+
+    __runlog_append(log, "\"", 1);
+
+    for (char* c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            __runlog_append(log, "\\", 1);
+            __runlog_append(log, c, 1);
+        }
+        else if ((unsigned char) *c < 0x20) {
+            __runlog_appendf(log, "\\u%04x", (unsigned char) *c);
+        }
+        else {
+            __runlog_append(log, c, 1);
+        }
+    }
+
+    __runlog_append(log, "\"", 1);
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_write_tag
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that starts a binary record with its tag
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  char tag -- one of the RUNLOG_TAG values
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_write_tag(log, RUNLOG_TAG_BEST);
+ *
+ * SIDE-EFFECT
+ *
+ *  appends to the record
+ *
+ */
+
+void __runlog_write_tag(runlog_str* log, char tag) {
+
+    __runlog_append(log, &tag, 1);
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_write_u32
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends a uint32_t to a binary record
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t value -- value to write
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_write_u32(log, gen);
+ *
+ * SIDE-EFFECT
+ *
+ *  appends to the record
+ *
+ */
+
+void __runlog_write_u32(runlog_str* log, uint32_t value) {
+
+    __runlog_append(log, &value, sizeof(uint32_t));
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_write_f64
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends a double to a binary record
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  double value -- value to write
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_write_f64(log, fitness);
+ *
+ * SIDE-EFFECT
+ *
+ *  appends to the record
+ *
+ */
+
+void __runlog_write_f64(runlog_str* log, double value) {
+
+    __runlog_append(log, &value, sizeof(double));
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_write_bstring
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that appends a length prefixed string to a binary
+ *  record
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  char* str -- string to write, NULL is written as empty
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_write_bstring(log, name);
+ *
+ * SIDE-EFFECT
+ *
+ *  appends to the record
+ *
+ */
+
+void __runlog_write_bstring(runlog_str* log, char* str) {
+
+    uint32_t length = str != NULL ? strlen(str) : 0;
+
+    __runlog_write_u32(log, length);
+    __runlog_append(log, str, length);
+
+}
+
+/*
+ * NAME
+ *
+ *   __runlog_record_written
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper called after every record. Hands the composed record
+ *  to output_write and syncs the file to disk once RUNLOG_SYNC_INTERVAL
+ *  records have been written since the last sync
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __runlog_record_written(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues the record, may sync the file
+ *
+ */
+
+void __runlog_record_written(runlog_str* log) {
+
+    output_write(log->file, log->record, log->record_length);
+    log->record_length = 0;
+    log->records_since_sync++;
+
+    if (log->records_since_sync >= RUNLOG_SYNC_INTERVAL) {
+        runlog_sync(log);
+    }
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_set_format
+ *
+ * DESCRIPTION
+ *
+ *  Sets the format the evolution uses for the logs of cached runs, JSON
+ *  Lines unless changed
+ *
+ * PARAMETERS
+ *
+ *  runlog_format_typ format -- RUNLOG_JSONL or RUNLOG_BINARY
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_set_format(RUNLOG_BINARY);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the format of later runs
+ *
+ */
+
+void runlog_set_format(runlog_format_typ format) {
+
+    runlog_format = format;
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_get_format
+ *
+ * DESCRIPTION
+ *
+ *  Returns the format set with runlog_set_format
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  runlog_format_typ -- format for the logs of cached runs
+ *
+ * EXAMPLE
+ *
+ *  runlog_str* log = runlog_open(path, runlog_get_format());
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+runlog_format_typ runlog_get_format(void) {
+
+    return runlog_format;
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_open
+ *
+ * DESCRIPTION
+ *
+ *  Creates a run log at the given path, in JSON Lines or binary format.
+ *  The file is written through a RUNLOG_BUFFER_SIZE buffer
+ *
+ * PARAMETERS
+ *
+ *  char* path -- file to create, overwritten if it exists
+ *  runlog_format_typ format -- RUNLOG_JSONL or RUNLOG_BINARY
+ *
+ * RETURN
+ *
+ *  runlog_str* -- the open log
+ *
+ * EXAMPLE
+ *
+ *  runlog_str* log = runlog_open("src/files/cache/run_1/run.jsonl", RUNLOG_JSONL);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the file, must be closed with runlog_close
+ *
+ */
+
+runlog_str* runlog_open(char* path, runlog_format_typ format) {
+
+    runlog_str* log = malloc(sizeof(runlog_str));
+
+    if (log == NULL) {
+        printf("error: failed to alloc memory for runlog_str [file:\'%s\',line:%d]\n", __FILE__, __LINE__);
+        exit(0);
+    }
+
+    log->file = fopen(path, format == RUNLOG_BINARY ? "wb" : "w");
+
+    if (log->file == NULL) {
+        printf("error: could not create run log %s [file:\'%s\',line:%d]\n", path, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    log->buffer = malloc(RUNLOG_BUFFER_SIZE);
+    assert(log->buffer != NULL);
+    setvbuf(log->file, log->buffer, _IOFBF, RUNLOG_BUFFER_SIZE);
+
+    log->record_capacity = RUNLOG_RECORD_SIZE;
+    log->record_length = 0;
+    log->record = malloc(log->record_capacity);
+    assert(log->record != NULL);
+
+    log->format = format;
+    log->records_since_sync = 0;
+
+    if (format == RUNLOG_BINARY) {
+        output_write(log->file, RUNLOG_BINARY_MAGIC, sizeof(RUNLOG_BINARY_MAGIC));
+    }
+
+    return log;
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_write_header
+ *
+ * DESCRIPTION
+ *
+ *  Writes the run header, with the time the run started, the object type
+ *  and the parameters of the evolution
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t num_gens -- number of generations
+ *  uint32_t pop_size -- population size
+ *  uint32_t indiv_size -- individual size
+ *  uint32_t tourn_size -- tournament size
+ *  uint32_t mut_perc -- mutation percentage
+ *  uint32_t cross_perc -- crossover percentage
+ *  osaka_object_typ ot -- object type being evolved
+ *  char* test_file -- test file for llvm runs, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_header(log, 10, 20, 10, 2, 20, 75, LLVM_PASS, file);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_header(runlog_str* log, uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, osaka_object_typ ot, char* test_file) {
+
+    char started[32];
+    time_t now = time(NULL);
+
+    strftime(started, sizeof(started), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    if (log->format == RUNLOG_BINARY) {
+
+        __runlog_write_tag(log, RUNLOG_TAG_HEADER);
+        __runlog_write_bstring(log, started);
+        __runlog_write_bstring(log, object_table_function[ot].name);
+        __runlog_write_u32(log, num_gens);
+        __runlog_write_u32(log, pop_size);
+        __runlog_write_u32(log, indiv_size);
+        __runlog_write_u32(log, tourn_size);
+        __runlog_write_u32(log, mut_perc);
+        __runlog_write_u32(log, cross_perc);
+        __runlog_write_bstring(log, test_file);
+
+    }
+    else {
+
+        __runlog_appendf(log, "{\"record\":\"header\",\"started\":\"%s\",\"object_type\":", started);
+        __runlog_write_json_string(log, object_table_function[ot].name);
+        __runlog_appendf(log, ",\"num_gens\":%u,\"pop_size\":%u,\"indiv_size\":%u,\"tourn_size\":%u,\"mut_perc\":%u,\"cross_perc\":%u,\"test_file\":",
+            num_gens, pop_size, indiv_size, tourn_size, mut_perc, cross_perc);
+        __runlog_write_json_string(log, test_file != NULL ? test_file : "");
+        __runlog_append(log, "}\n", 2);
+
+    }
+
+    __runlog_record_written(log);
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_write_baseline
+ *
+ * DESCRIPTION
+ *
+ *  Writes a baseline timing, such as the run time of the test file before
+ *  any evolved optimization is applied
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  char* name -- name of the baseline
+ *  double seconds -- measured time
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_baseline(log, "no_optimization", time_taken);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_baseline(runlog_str* log, char* name, double seconds) {
+
+    if (log->format == RUNLOG_BINARY) {
+
+        __runlog_write_tag(log, RUNLOG_TAG_BASELINE);
+        __runlog_write_bstring(log, name);
+        __runlog_write_f64(log, seconds);
+
+    }
+    else {
+
+        __runlog_appendf(log, "{\"record\":\"baseline\",\"name\":");
+        __runlog_write_json_string(log, name);
+        __runlog_appendf(log, ",\"seconds\":%.9g}\n", seconds);
+
+    }
+
+    __runlog_record_written(log);
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_write_individual
+ *
+ * DESCRIPTION
+ *
+ *  Writes the record of one evaluated individual with its fitness. The
+ *  JSON Lines format lists the description of every gene, the binary
+ *  format stores the genes as the fields given by osaka_encodeobject
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t gen -- generation of the individual
+ *  uint32_t ind -- index in the generation
+ *  double fitness -- fitness the individual was given
+ *  node_str* indiv -- the individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_individual(log, g, i, fitness_values[i], curr_gen[i]);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_individual(runlog_str* log, uint32_t gen, uint32_t ind, double fitness, node_str* indiv) {
+
+    if (log->format == RUNLOG_BINARY) {
+
+        uint32_t fields[OBJECT_MAX_FIELDS];
+        uint32_t ranges[OBJECT_MAX_FIELDS];
+        osaka_object_typ ot = OBJECT_TYPE(indiv);
+        uint32_t num_fields = object_table_function[ot].osaka_fieldsobject(ranges);
+
+        __runlog_write_tag(log, RUNLOG_TAG_INDIVIDUAL);
+        __runlog_write_u32(log, gen);
+        __runlog_write_u32(log, ind);
+        __runlog_write_f64(log, fitness);
+        __runlog_write_u32(log, osaka_listlength(indiv));
+        __runlog_write_u32(log, num_fields);
+
+        for (node_str* n = indiv; n != NULL; n = NEXT(n)) {
+            object_table_function[ot].osaka_encodeobject(fields, OBJECT(n));
+            __runlog_append(log, fields, sizeof(uint32_t) * num_fields);
+        }
+
+    }
+    else {
+
+        char desc[RUNLOG_DESC_SIZE];
+
+        __runlog_appendf(log, "{\"record\":\"individual\",\"gen\":%u,\"index\":%u,\"fitness\":%.9g,\"genes\":[", gen, ind, fitness);
+
+        for (node_str* n = indiv; n != NULL; n = NEXT(n)) {
+            strcpy(desc, "");
+            osaka_describenode(desc, n);
+            __runlog_write_json_string(log, desc);
+            if (NEXT(n) != NULL) {
+                __runlog_append(log, ",", 1);
+            }
+        }
+
+        __runlog_append(log, "]}\n", 3);
+
+    }
+
+    __runlog_record_written(log);
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_write_best
+ *
+ * DESCRIPTION
+ *
+ *  Writes which individual of a generation had the best fitness
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t gen -- generation
+ *  uint32_t ind -- index of the best individual
+ *  double fitness -- its fitness
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_best(log, g, winner, winner_value);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_best(runlog_str* log, uint32_t gen, uint32_t ind, double fitness) {
+
+    if (log->format == RUNLOG_BINARY) {
+
+        __runlog_write_tag(log, RUNLOG_TAG_BEST);
+        __runlog_write_u32(log, gen);
+        __runlog_write_u32(log, ind);
+        __runlog_write_f64(log, fitness);
+
+    }
+    else {
+
+        __runlog_appendf(log, "{\"record\":\"best\",\"gen\":%u,\"index\":%u,\"fitness\":%.9g}\n", gen, ind, fitness);
+
+    }
+
+    __runlog_record_written(log);
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_sync
+ *
+ * DESCRIPTION
+ *
+ *  Flushes the buffered records of a run log and syncs the file to disk,
+ *  so that a crashed run keeps everything written up to this point
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_sync(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  flushes and syncs the file
+ *
+ */
+
+void runlog_sync(runlog_str* log) {
+
+    output_sync(log->file);
+
+    log->records_since_sync = 0;
+
+}
+
+/*
+ * NAME
+ *
+ *   runlog_close
+ *
+ * DESCRIPTION
+ *
+ *  Syncs and closes a run log
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_close(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  closes the file and frees the log
+ *
+ */
+
+void runlog_close(runlog_str* log) {
+
+    if (log == NULL) {
+        return;
+    }
+
+    runlog_sync(log);
+    // the writer must be done with the file before it is closed
+    output_flush();
+    fclose(log->file);
+    free(log->buffer);
+    free(log->record);
+    free(log);
+
+}
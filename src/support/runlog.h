@@ -0,0 +1,376 @@
+/*
+ ============================================================================
+ Name        : runlog.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Structured run log. Every cached evolutionary run writes
+               a single file holding the run header and parameters, the
+               baseline timings and one record per evaluated individual,
+               either as JSON Lines or as a compact binary stream. Records
+               are composed in memory and handed to output_write, so with
+               asynchronous output they are written by the writer thread.
+               The file goes through a large stdio buffer and is only
+               synced to disk every RUNLOG_SYNC_INTERVAL records
+ ============================================================================
+ */
+
+#ifndef SUPPORT_RUNLOG_H_
+#define SUPPORT_RUNLOG_H_
+
+/*
+ * IMPORT
+ */
+
+#include "../osaka/osaka.h"
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * DATATYPES
+ */
+
+typedef enum {
+    RUNLOG_JSONL,
+    RUNLOG_BINARY
+} runlog_format_typ;
+
+typedef struct runlog_str {
+    FILE* file;
+    char* buffer;
+    char* record;
+    size_t record_length;
+    size_t record_capacity;
+    runlog_format_typ format;
+    uint32_t records_since_sync;
+} runlog_str;
+
+/*
+ * MACROS
+ */
+
+#define RUNLOG_BUFFER_SIZE (1 << 20)
+#define RUNLOG_SYNC_INTERVAL 4096
+#define RUNLOG_DESC_SIZE 256
+#define RUNLOG_RECORD_SIZE 4096
+
+// every binary file starts with this magic, each record with one of the tags
+#define RUNLOG_BINARY_MAGIC "SHKLOG1"
+#define RUNLOG_TAG_HEADER 'H'
+#define RUNLOG_TAG_BASELINE 'B'
+#define RUNLOG_TAG_INDIVIDUAL 'I'
+#define RUNLOG_TAG_BEST 'W'
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   runlog_set_format
+ *
+ * DESCRIPTION
+ *
+ *  Sets the format the evolution uses for the logs of cached runs, JSON
+ *  Lines unless changed
+ *
+ * PARAMETERS
+ *
+ *  runlog_format_typ format -- RUNLOG_JSONL or RUNLOG_BINARY
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_set_format(RUNLOG_BINARY);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the format of later runs
+ *
+ */
+
+void runlog_set_format(runlog_format_typ format);
+
+/*
+ * NAME
+ *
+ *   runlog_get_format
+ *
+ * DESCRIPTION
+ *
+ *  Returns the format set with runlog_set_format
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  runlog_format_typ -- format for the logs of cached runs
+ *
+ * EXAMPLE
+ *
+ *  runlog_str* log = runlog_open(path, runlog_get_format());
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+runlog_format_typ runlog_get_format(void);
+
+/*
+ * NAME
+ *
+ *   runlog_open
+ *
+ * DESCRIPTION
+ *
+ *  Creates a run log at the given path, in JSON Lines or binary format.
+ *  The file is written through a RUNLOG_BUFFER_SIZE buffer
+ *
+ * PARAMETERS
+ *
+ *  char* path -- file to create, overwritten if it exists
+ *  runlog_format_typ format -- RUNLOG_JSONL or RUNLOG_BINARY
+ *
+ * RETURN
+ *
+ *  runlog_str* -- the open log
+ *
+ * EXAMPLE
+ *
+ *  runlog_str* log = runlog_open("src/files/cache/run_1/run.jsonl", RUNLOG_JSONL);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the file, must be closed with runlog_close
+ *
+ */
+
+runlog_str* runlog_open(char* path, runlog_format_typ format);
+
+/*
+ * NAME
+ *
+ *   runlog_write_header
+ *
+ * DESCRIPTION
+ *
+ *  Writes the run header, with the time the run started, the object type
+ *  and the parameters of the evolution
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t num_gens -- number of generations
+ *  uint32_t pop_size -- population size
+ *  uint32_t indiv_size -- individual size
+ *  uint32_t tourn_size -- tournament size
+ *  uint32_t mut_perc -- mutation percentage
+ *  uint32_t cross_perc -- crossover percentage
+ *  osaka_object_typ ot -- object type being evolved
+ *  char* test_file -- test file for llvm runs, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_header(log, 10, 20, 10, 2, 20, 75, LLVM_PASS, file);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_header(runlog_str* log, uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, osaka_object_typ ot, char* test_file);
+
+/*
+ * NAME
+ *
+ *   runlog_write_baseline
+ *
+ * DESCRIPTION
+ *
+ *  Writes a baseline timing, such as the run time of the test file before
+ *  any evolved optimization is applied
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  char* name -- name of the baseline
+ *  double seconds -- measured time
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_baseline(log, "no_optimization", time_taken);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_baseline(runlog_str* log, char* name, double seconds);
+
+/*
+ * NAME
+ *
+ *   runlog_write_individual
+ *
+ * DESCRIPTION
+ *
+ *  Writes the record of one evaluated individual with its fitness. The
+ *  JSON Lines format lists the description of every gene, the binary
+ *  format stores the genes as the fields given by osaka_encodeobject
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t gen -- generation of the individual
+ *  uint32_t ind -- index in the generation
+ *  double fitness -- fitness the individual was given
+ *  node_str* indiv -- the individual
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_individual(log, g, i, fitness_values[i], curr_gen[i]);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_individual(runlog_str* log, uint32_t gen, uint32_t ind, double fitness, node_str* indiv);
+
+/*
+ * NAME
+ *
+ *   runlog_write_best
+ *
+ * DESCRIPTION
+ *
+ *  Writes which individual of a generation had the best fitness
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *  uint32_t gen -- generation
+ *  uint32_t ind -- index of the best individual
+ *  double fitness -- its fitness
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_write_best(log, g, winner, winner_value);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes a record
+ *
+ */
+
+void runlog_write_best(runlog_str* log, uint32_t gen, uint32_t ind, double fitness);
+
+/*
+ * NAME
+ *
+ *   runlog_sync
+ *
+ * DESCRIPTION
+ *
+ *  Flushes the buffered records of a run log and syncs the file to disk,
+ *  so that a crashed run keeps everything written up to this point
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_sync(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  flushes and syncs the file
+ *
+ */
+
+void runlog_sync(runlog_str* log);
+
+/*
+ * NAME
+ *
+ *   runlog_close
+ *
+ * DESCRIPTION
+ *
+ *  Syncs and closes a run log
+ *
+ * PARAMETERS
+ *
+ *  runlog_str* log -- run log, may be NULL
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  runlog_close(log);
+ *
+ * SIDE-EFFECT
+ *
+ *  closes the file and frees the log
+ *
+ */
+
+void runlog_close(runlog_str* log);
+
+#endif /* SUPPORT_RUNLOG_H_ */
@@ -237,8 +237,6 @@ void test_llvm_form_exec_code_command(char* file) {
 
     uint32_t result;
 
-    time_t time1, time2;
-    clock_t clock1, clock2;
     struct timeval start, end; 
 
     llvm_form_exec_code_command(file, command);
@@ -1052,6 +1050,2499 @@ void test_system() {
 
 }
 
+/*
+ * NAME
+ *
+ *   test_osaka_structure
+ *
+ * DESCRIPTION
+ *
+ *  Runs the checks of the Osaka Structure itself in osaka_test.c:
+ *  creating, serializing, comparing, copying and freeing lists, and
+ *  building, looking up and editing a 1000 node list through its header
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_osaka_structure(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes the serialized lists in the working directory
+ *
+ */
+
+void test_osaka_structure(bool vis) {
+
+    assert(osaka_test_cycler(vis ? LOUD : QUIET));
+
+    remove("tmp0.dat");
+    remove("tmp1.dat");
+    remove("tmp2.dat");
+    remove("tmp3.dat");
+
+    printf("\nOsaka structure test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_persistent_individuals
+ *
+ * DESCRIPTION
+ *
+ *  Tests that persistent crossover and mutation share genes with
+ *  the parents instead of copying them, and that the parents are
+ *  left unchanged by either operator
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- individual size
+ *  osaka_object_typ ot -- object type to be created
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * test_persistent_individuals(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_persistent_individuals(uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    node_str* my_generation[2];
+    generate_new_generation(my_generation, 2, indiv_size, ot);
+
+    persistent_str* parent1 = osaka_persistent_fromlist(my_generation[0]);
+    persistent_str* parent2 = osaka_persistent_fromlist(my_generation[1]);
+
+    // remember which objects the parents held before crossover and mutation
+    void** objects1 = malloc(sizeof(void*) * indiv_size);
+    void** objects2 = malloc(sizeof(void*) * indiv_size);
+    for (uint32_t i = 1; i <= indiv_size; i++) {
+        objects1[i - 1] = osaka_persistent_nthobject(parent1, i);
+        objects2[i - 1] = osaka_persistent_nthobject(parent2, i);
+    }
+
+    persistent_str* child1;
+    persistent_str* child2;
+    crossover_onepoint_persistent(parent1, parent2, &child1, &child2, vis);
+
+    assert(osaka_persistent_consistencycheck(child1));
+    assert(osaka_persistent_consistencycheck(child2));
+    assert(PERSISTENT_LENGTH(child1) == indiv_size);
+    assert(PERSISTENT_LENGTH(child2) == indiv_size);
+
+    // every gene of a child is one of the parents' objects, not a copy
+    for (uint32_t i = 1; i <= indiv_size; i++) {
+        void* o1 = osaka_persistent_nthobject(child1, i);
+        void* o2 = osaka_persistent_nthobject(child2, i);
+        assert((o1 == objects1[i - 1] && o2 == objects2[i - 1]) || (o1 == objects2[i - 1] && o2 == objects1[i - 1]));
+    }
+
+    persistent_str* mutant = mutation_single_unit_all_params_persistent(child1, indiv_size, vis);
+    assert(osaka_persistent_consistencycheck(mutant));
+    assert(osaka_persistent_nthobject(mutant, indiv_size) != osaka_persistent_nthobject(child1, indiv_size));
+    for (uint32_t i = 1; i < indiv_size; i++) {
+        assert(osaka_persistent_nthobject(mutant, i) == osaka_persistent_nthobject(child1, i));
+    }
+
+    // parents can go away while the children still hold on to their genes
+    for (uint32_t i = 1; i <= indiv_size; i++) {
+        assert(osaka_persistent_nthobject(parent1, i) == objects1[i - 1]);
+        assert(osaka_persistent_nthobject(parent2, i) == objects2[i - 1]);
+    }
+    osaka_persistent_release(parent1);
+    osaka_persistent_release(parent2);
+
+    node_str* materialized = osaka_persistent_tolist(mutant);
+    assert(osaka_listlength(materialized) == indiv_size);
+    osaka_freelist(materialized);
+
+    osaka_persistent_release(mutant);
+    osaka_persistent_release(child1);
+    osaka_persistent_release(child2);
+
+    free(objects1);
+    free(objects2);
+
+    // always free the generation
+    generate_free_generation(my_generation, 2);
+
+    printf("\nPersistent individual test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_hash_and_equal
+ *
+ * DESCRIPTION
+ *
+ *  Tests that copies of an individual hash the same and are
+ *  osaka_equal, and that after mutating one unit the incremental
+ *  hash update and the prefix hashes agree with a full rehash
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- individual size
+ *  osaka_object_typ ot -- object type to be created
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * test_hash_and_equal(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_hash_and_equal(uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    node_str* original = generate_new_individual(indiv_size, ot);
+    node_str* copy = osaka_copylist(original);
+
+    uint64_t hash = osaka_hash(original);
+    assert(hash == osaka_hash(copy));
+    assert(osaka_equal(original, copy));
+
+    // mutate a unit of the copy until it actually holds a different value
+    uint32_t nth = (uint32_t) (indiv_size * (rand() / (RAND_MAX + 1.0))) + 1;
+    node_str* node = osaka_nthnode(copy, nth);
+    uint64_t old_gene = osaka_hashnode(node);
+    for (uint32_t tries = 0; tries < 100 && osaka_equal(original, copy); tries++) {
+        mutation_single_unit_all_params(copy, nth, vis);
+    }
+
+    if (!osaka_equal(original, copy)) {
+
+        uint64_t updated = osaka_hashupdate(hash, indiv_size, nth, old_gene, osaka_hashnode(node));
+        assert(updated == osaka_hash(copy));
+        assert(updated != hash);
+
+        // prefix hashes agree up to the mutated unit and differ from there on
+        uint64_t* prefix_original = malloc(sizeof(uint64_t) * indiv_size);
+        uint64_t* prefix_copy = malloc(sizeof(uint64_t) * indiv_size);
+        assert(osaka_prefixhashes(original, prefix_original, indiv_size) == indiv_size);
+        assert(osaka_prefixhashes(copy, prefix_copy, indiv_size) == indiv_size);
+        for (uint32_t i = 0; i < indiv_size; i++) {
+            assert((prefix_original[i] == prefix_copy[i]) == (i + 1 < nth));
+        }
+        assert(prefix_copy[indiv_size - 1] == osaka_hash(copy));
+        free(prefix_original);
+        free(prefix_copy);
+
+    }
+
+    generate_free_individual(original);
+    generate_free_individual(copy);
+
+    printf("\nHash and equality test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_population_matrix
+ *
+ * DESCRIPTION
+ *
+ *  Test of the structure-of-arrays population. A large population is
+ *  randomized and timed, a generation of lists is round tripped through
+ *  it, a masked mutation is checked to only touch the marked genes and
+ *  the diversity is checked for a random and for a uniform population
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals in the round trip
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print progress
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_population_matrix(10, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts on failure
+ *
+ */
+
+void test_population_matrix(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    struct timeval start, stop;
+    uint64_t state = ((uint64_t) rand() << 32) | (uint64_t) rand() | 1;
+
+    // bulk randomization of a large population
+    gettimeofday(&start, NULL);
+    population_str* large = population_create(10000, indiv_size, ot);
+    population_randomize(large, &state);
+    gettimeofday(&stop, NULL);
+
+    for (uint32_t f = 0; f < large->num_fields; f++) {
+        for (uint32_t pos = 0; pos < indiv_size; pos++) {
+            for (uint32_t ind = 0; ind < large->pop_size; ind++) {
+                assert(large->ranges[f] == 0 || POPULATION_GENE(large, ind, pos, f) < large->ranges[f]);
+            }
+        }
+    }
+
+    if (vis) {
+        printf("\nCreated and randomized %d individuals of %d genes in %ld us\n", large->pop_size, indiv_size,
+            (long) ((stop.tv_sec - start.tv_sec) * 1000000 + stop.tv_usec - start.tv_usec));
+    }
+
+    // round trip of a generation of lists
+    node_str** gen = malloc(sizeof(node_str*) * pop_size);
+    generate_new_generation(gen, pop_size, indiv_size, ot);
+    node_str** back = malloc(sizeof(node_str*) * pop_size);
+    population_str* pop = population_create(pop_size, indiv_size, ot);
+    population_fromlists(pop, gen);
+    population_tolists(pop, back);
+    for (uint32_t ind = 0; ind < pop_size; ind++) {
+        assert(osaka_equal(gen[ind], back[ind]));
+    }
+
+    // masked mutation only touches the marked genes
+    population_str* before = population_create(pop_size, indiv_size, ot);
+    population_copy(before, pop);
+    uint8_t* mask = malloc((size_t) pop_size * indiv_size);
+    population_mutationmask(pop, mask, 30, &state);
+    population_mutate(pop, mask, &state);
+    for (uint32_t f = 0; f < pop->num_fields; f++) {
+        for (uint32_t pos = 0; pos < indiv_size; pos++) {
+            for (uint32_t ind = 0; ind < pop_size; ind++) {
+                if (!mask[(size_t) pos * pop_size + ind]) {
+                    assert(POPULATION_GENE(pop, ind, pos, f) == POPULATION_GENE(before, ind, pos, f));
+                }
+            }
+        }
+    }
+
+    // a random population is diverse, copies of one individual are not
+    assert(population_diversity(large, NULL) > 0.0);
+    for (uint32_t ind = 0; ind < pop_size; ind++) {
+        population_copyindividual(before, ind, pop, 0);
+    }
+    assert(population_diversity(before, NULL) == 0.0);
+
+    generate_free_generation(gen, pop_size);
+    generate_free_generation(back, pop_size);
+    free(gen);
+    free(back);
+    free(mask);
+    population_free(large);
+    population_free(pop);
+    population_free(before);
+
+    printf("\nPopulation matrix test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_concurrent_store
+ *
+ * DESCRIPTION
+ *
+ *  Stress test of the concurrent population store. Many threads fill a
+ *  store with new individuals at once, after which every slot must hold
+ *  exactly one individual and every node uid must be unique. A generation
+ *  is then bred in parallel and every child checked for its size
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals bred
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_concurrent_store(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts on failure
+ *
+ */
+
+void test_concurrent_store(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    struct timeval start, stop;
+    uint32_t num_threads = 16;
+    uint32_t capacity = 4000;
+
+    // hammer slot claiming and uid generation from many threads
+    gettimeofday(&start, NULL);
+    store_str* s = store_create(capacity);
+    store_fill(s, indiv_size, ot, num_threads);
+    gettimeofday(&stop, NULL);
+
+    assert(store_count(s) == capacity);
+    assert(store_claim(s) == STORE_FULL);
+
+    // every node was created during the fill, so the uids are a range
+    uint32_t min_uid = UINT32_MAX;
+    uint32_t max_uid = 0;
+    for (uint32_t i = 0; i < capacity; i++) {
+        node_str* n = store_get(s, i);
+        assert(n != NULL);
+        assert(osaka_listlength(n) == indiv_size);
+        for (; n != NULL; n = NEXT(n)) {
+            min_uid = UID(n) < min_uid ? UID(n) : min_uid;
+            max_uid = UID(n) > max_uid ? UID(n) : max_uid;
+        }
+    }
+    assert(max_uid - min_uid + 1 == capacity * indiv_size);
+    bool* seen = calloc(max_uid - min_uid + 1, sizeof(bool));
+    for (uint32_t i = 0; i < capacity; i++) {
+        for (node_str* n = store_get(s, i); n != NULL; n = NEXT(n)) {
+            assert(!seen[UID(n) - min_uid]);
+            seen[UID(n) - min_uid] = true;
+        }
+    }
+
+    if (vis) {
+        printf("\nFilled %d slots from %d threads in %ld us\n", capacity, num_threads,
+            (long) ((stop.tv_sec - start.tv_sec) * 1000000 + stop.tv_usec - start.tv_usec));
+    }
+
+    // breed a generation in parallel from the first pop_size individuals
+    node_str** parents = malloc(sizeof(node_str*) * pop_size);
+    double* fitness_values = malloc(sizeof(double) * pop_size);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        parents[i] = store_get(s, i);
+        fitness_values[i] = rand() / (RAND_MAX + 1.0);
+    }
+
+    store_str* children = store_create(pop_size);
+    store_breed(children, parents, fitness_values, pop_size, 3, 50, 75, num_threads, (uint64_t) rand());
+    assert(store_count(children) == pop_size);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        assert(osaka_listlength(store_get(children, i)) == indiv_size);
+    }
+
+    // a reset store can be filled again
+    store_reset(children, true);
+    assert(store_count(children) == 0 && store_get(children, 0) == NULL);
+    uint64_t seed = (uint64_t) rand();
+    store_breed(children, parents, fitness_values, pop_size, 3, 50, 75, 1, seed);
+    assert(store_count(children) == pop_size);
+
+    // a single worker breeds the same generation again from the same seed
+    store_str* again = store_create(pop_size);
+    store_breed(again, parents, fitness_values, pop_size, 3, 50, 75, 1, seed);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        assert(osaka_equal(store_get(children, i), store_get(again, i)));
+    }
+
+    store_free(again, true);
+    store_free(children, true);
+    store_free(s, true);
+    free(parents);
+    free(fitness_values);
+    free(seen);
+
+    printf("\nConcurrent store test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_runlog
+ *
+ * DESCRIPTION
+ *
+ *  Writes the records of a generation to a JSON Lines and to a binary run
+ *  log in the temporary directory and reads both back, checking that
+ *  there is one well formed line per record and that the binary records
+ *  hold the encoded genes of every individual
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_runlog(20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes two files in P_tmpdir, asserts on failure
+ *
+ */
+
+void test_runlog(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    struct timeval start, stop;
+    char jsonl_file[100];
+    char binary_file[100];
+    char line[RUNLOG_DESC_SIZE * 64];
+    uint32_t num_gens = 50;
+
+    node_str** gen = malloc(sizeof(node_str*) * pop_size);
+    double* fitness_values = malloc(sizeof(double) * pop_size);
+    generate_new_generation(gen, pop_size, indiv_size, ot);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        fitness_values[i] = rand() / (RAND_MAX + 1.0);
+    }
+
+    sprintf(jsonl_file, "%s/shackleton_test_run_%d.jsonl", P_tmpdir, (int) getpid());
+    sprintf(binary_file, "%s/shackleton_test_run_%d.bin", P_tmpdir, (int) getpid());
+
+    // json lines, one line per record
+    gettimeofday(&start, NULL);
+    runlog_str* log = runlog_open(jsonl_file, RUNLOG_JSONL);
+    runlog_write_header(log, num_gens, pop_size, indiv_size, 2, 20, 75, ot, "test \"file\".c");
+    runlog_write_baseline(log, "no_optimization", 0.5);
+    for (uint32_t g = 0; g < num_gens; g++) {
+        for (uint32_t i = 0; i < pop_size; i++) {
+            runlog_write_individual(log, g, i, fitness_values[i], gen[i]);
+        }
+        runlog_write_best(log, g, 0, fitness_values[0]);
+    }
+    runlog_close(log);
+    gettimeofday(&stop, NULL);
+
+    if (vis) {
+        printf("\nWrote %d individual records in %ld us\n", num_gens * pop_size,
+            (long) ((stop.tv_sec - start.tv_sec) * 1000000 + stop.tv_usec - start.tv_usec));
+    }
+
+    FILE* stream = fopen(jsonl_file, "r");
+    assert(stream != NULL);
+    uint32_t num_lines = 0;
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        size_t length = strlen(line);
+        assert(length >= 3 && line[0] == '{' && line[length - 2] == '}' && line[length - 1] == '\n');
+        num_lines++;
+    }
+    fclose(stream);
+    assert(num_lines == 2 + num_gens * (pop_size + 1));
+
+    // binary, every individual record holds the encoded genes
+    log = runlog_open(binary_file, RUNLOG_BINARY);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        runlog_write_individual(log, 0, i, fitness_values[i], gen[i]);
+    }
+    runlog_write_best(log, 0, 0, fitness_values[0]);
+    runlog_close(log);
+
+    stream = fopen(binary_file, "rb");
+    assert(stream != NULL);
+    assert(fread(line, 1, sizeof(RUNLOG_BINARY_MAGIC), stream) == sizeof(RUNLOG_BINARY_MAGIC));
+    assert(strcmp(line, RUNLOG_BINARY_MAGIC) == 0);
+    for (uint32_t i = 0; i < pop_size; i++) {
+
+        uint32_t header[4];
+        uint32_t stored[OBJECT_MAX_FIELDS];
+        uint32_t expected[OBJECT_MAX_FIELDS];
+        double fitness;
+
+        assert(fgetc(stream) == RUNLOG_TAG_INDIVIDUAL);
+        assert(fread(header, sizeof(uint32_t), 2, stream) == 2 && header[0] == 0 && header[1] == i);
+        assert(fread(&fitness, sizeof(double), 1, stream) == 1 && fitness == fitness_values[i]);
+        assert(fread(header + 2, sizeof(uint32_t), 2, stream) == 2 && header[2] == indiv_size);
+
+        for (node_str* n = gen[i]; n != NULL; n = NEXT(n)) {
+            object_table_function[ot].osaka_encodeobject(expected, OBJECT(n));
+            assert(fread(stored, sizeof(uint32_t), header[3], stream) == header[3]);
+            assert(memcmp(stored, expected, sizeof(uint32_t) * header[3]) == 0);
+        }
+
+    }
+    assert(fgetc(stream) == RUNLOG_TAG_BEST);
+    fclose(stream);
+
+    remove(jsonl_file);
+    remove(binary_file);
+    generate_free_generation(gen, pop_size);
+    free(gen);
+    free(fitness_values);
+
+    printf("\nRun log test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   __test_async_output_producer
+ *
+ * DESCRIPTION
+ *
+ *  Thread body for test_async_output, writes numbered lines to a stream
+ *  through the output queue
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- test_output_producer_str* naming the stream, thread id and number of lines
+ *
+ * RETURN
+ *
+ *  void* -- always NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&thread, NULL, __test_async_output_producer, &producer);
+ *
+ * SIDE-EFFECT
+ *
+ *  queues num_lines lines of text
+ *
+ */
+
+void* __test_async_output_producer(void* arg) {
+
+    test_output_producer_str* producer = (test_output_producer_str*) arg;
+
+    for (uint32_t i = 0; i < producer->num_lines; i++) {
+        output_printf(producer->stream, "%u %u\n", producer->id, i);
+    }
+
+    return NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   test_async_output
+ *
+ * DESCRIPTION
+ *
+ *  Writes numbered lines from several threads through the asynchronous
+ *  output queue into a file in the temporary directory, once waiting for
+ *  room and once dropping records when the queue is full. Checks that no
+ *  line is lost or torn when blocking, that each thread's lines keep
+ *  their order, that a record longer than the inline text is written
+ *  whole and that written and dropped lines add up when dropping
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_threads -- number of producer threads, at most STORE_MAX_THREADS
+ *  uint32_t num_lines -- lines written by each thread
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_async_output(4, 5000, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a file in P_tmpdir, asserts on failure. Skipped if
+ *  asynchronous output was already started for the run
+ *
+ */
+
+void test_async_output(uint32_t num_threads, uint32_t num_lines, bool vis) {
+
+    struct timeval start, stop;
+    char output_file[100];
+    char line[1100];
+    char long_line[1000];
+    pthread_t threads[STORE_MAX_THREADS];
+    test_output_producer_str producers[STORE_MAX_THREADS];
+    uint32_t next_line[STORE_MAX_THREADS];
+
+    assert(num_threads > 0 && num_threads <= STORE_MAX_THREADS);
+
+    if (output_running()) {
+        printf("\nAsync output test skipped, output is already asynchronous\n");
+        return;
+    }
+
+    sprintf(output_file, "%s/shackleton_test_output_%d.txt", P_tmpdir, (int) getpid());
+    memset(long_line, 'x', sizeof(long_line) - 1);
+    long_line[sizeof(long_line) - 1] = '\0';
+
+    for (uint32_t drop = 0; drop < 2; drop++) {
+
+        FILE* stream = fopen(output_file, "w");
+        assert(stream != NULL);
+
+        // a small queue so that the producers keep catching up with the writer
+        gettimeofday(&start, NULL);
+        output_start(64, drop ? OUTPUT_DROP : OUTPUT_BLOCK);
+        for (uint32_t t = 0; t < num_threads; t++) {
+            producers[t].stream = stream;
+            producers[t].id = t;
+            producers[t].num_lines = num_lines;
+            assert(pthread_create(&threads[t], NULL, __test_async_output_producer, &producers[t]) == 0);
+        }
+        for (uint32_t t = 0; t < num_threads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+        if (!drop) {
+            output_printf(stream, "%s\n", long_line);
+        }
+        output_flush();
+        uint64_t dropped = output_dropped();
+        output_stop();
+        gettimeofday(&stop, NULL);
+        fclose(stream);
+
+        if (vis) {
+            printf("\nQueued %d lines from %d threads (%s) in %ld us, %lu dropped\n", num_threads * num_lines, num_threads,
+                drop ? "drop" : "block", (long) ((stop.tv_sec - start.tv_sec) * 1000000 + stop.tv_usec - start.tv_usec), (unsigned long) dropped);
+        }
+
+        stream = fopen(output_file, "r");
+        assert(stream != NULL);
+        memset(next_line, 0, sizeof(next_line));
+        uint32_t num_read = 0;
+        bool long_read = false;
+        while (fgets(line, sizeof(line), stream) != NULL) {
+
+            uint32_t id, i;
+
+            if (line[0] == 'x') {
+                assert(strlen(line) == sizeof(long_line) && !long_read);
+                long_read = true;
+                continue;
+            }
+
+            assert(sscanf(line, "%u %u", &id, &i) == 2 && id < num_threads);
+            assert(i >= next_line[id]);
+            assert(drop || i == next_line[id]);
+            next_line[id] = i + 1;
+            num_read++;
+
+        }
+        fclose(stream);
+
+        if (drop) {
+            assert(num_read + dropped == num_threads * num_lines);
+        }
+        else {
+            assert(dropped == 0 && long_read);
+            assert(num_read == num_threads * num_lines);
+        }
+
+    }
+
+    remove(output_file);
+
+    printf("\nAsync output test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_instrument
+ *
+ * DESCRIPTION
+ *
+ *  Checks that timed phases and counters are added to both the generation
+ *  and the run statistics, that reporting a generation starts a new
+ *  window while the run totals are kept, and that the monotonic clock
+ *  does not go backwards. When built with make INSTRUMENT=1 it also
+ *  checks that creating and freeing individuals is counted
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the totals table
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_instrument(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  resets the instrumentation statistics, asserts on failure
+ *
+ */
+
+void test_instrument(uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    uint64_t before = instrument_now_ns();
+    uint64_t after = instrument_now_ns();
+    assert(after >= before);
+
+    instrument_reset();
+    instrument_add_time(INSTRUMENT_PHASE_OPT, 1000, 4000);
+    instrument_add_time(INSTRUMENT_PHASE_OPT, 5000, 6000);
+    instrument_add_count(INSTRUMENT_COUNTER_COMMANDS, 2);
+    assert(instrument_phase_ns(INSTRUMENT_PHASE_OPT, false) == 4000);
+    assert(instrument_phase_ns(INSTRUMENT_PHASE_OPT, true) == 4000);
+    assert(instrument_phase_ns(INSTRUMENT_PHASE_EXEC, true) == 0);
+    assert(instrument_counter(INSTRUMENT_COUNTER_COMMANDS, false) == 2);
+
+    // reporting prints the table and starts a new window, keeping the totals
+    instrument_report_generation(1);
+    assert(instrument_phase_ns(INSTRUMENT_PHASE_OPT, false) == 0);
+    assert(instrument_counter(INSTRUMENT_COUNTER_COMMANDS, false) == 0);
+    assert(instrument_phase_ns(INSTRUMENT_PHASE_OPT, true) == 4000);
+    assert(instrument_counter(INSTRUMENT_COUNTER_COMMANDS, true) == 2);
+
+#ifdef SHACKLETON_INSTRUMENT
+    node_str* indiv = generate_new_individual(indiv_size, ot);
+    node_str* copy = osaka_copylist(indiv);
+    assert(instrument_counter(INSTRUMENT_COUNTER_NODE_ALLOCS, false) >= 2 * indiv_size);
+    assert(instrument_counter(INSTRUMENT_COUNTER_NODE_BYTES, false) == instrument_counter(INSTRUMENT_COUNTER_NODE_ALLOCS, false) * sizeof(node_str));
+    generate_free_individual(indiv);
+    generate_free_individual(copy);
+    assert(instrument_counter(INSTRUMENT_COUNTER_NODE_FREES, false) >= 2 * indiv_size);
+#endif
+
+    if (vis) {
+        instrument_report_totals();
+    }
+    instrument_reset();
+
+    printf("\nInstrumentation test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_trace
+ *
+ * DESCRIPTION
+ *
+ *  Breeds a generation on several threads while tracing into a file in
+ *  the temporary directory, then parses the trace back as JSON and checks
+ *  that there is a well formed span for every breeding step, that the
+ *  workers were given their own tracks and that the population counters
+ *  were written
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print a summary
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_trace(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a file in P_tmpdir, asserts on failure. Skipped if
+ *  the run itself is being traced
+ *
+ */
+
+void test_trace(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    char trace_file[100];
+    uint32_t num_threads = 4;
+
+    if (trace_enabled()) {
+        printf("\nTrace test skipped, the run is already being traced\n");
+        return;
+    }
+
+    node_str** gen = malloc(sizeof(node_str*) * pop_size);
+    double* fitness_values = malloc(sizeof(double) * pop_size);
+    generate_new_generation(gen, pop_size, indiv_size, ot);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        fitness_values[i] = rand() / (RAND_MAX + 1.0);
+    }
+
+    sprintf(trace_file, "%s/shackleton_test_trace_%d.json", P_tmpdir, (int) getpid());
+
+    trace_start(trace_file);
+    TRACE_START(test);
+    store_str* s = store_create(pop_size);
+    store_breed(s, gen, fitness_values, pop_size, 2, 20, 75, num_threads, 42);
+    evolution_trace_population(pop_size, indiv_size, gen, fitness_values, ot);
+    TRACE_STOP(test, "test", "generation");
+    trace_stop();
+    assert(!trace_enabled());
+
+    // read the whole trace back, it has to be valid json
+    FILE* stream = fopen(trace_file, "r");
+    assert(stream != NULL);
+    fseek(stream, 0, SEEK_END);
+    long length = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+    char* text = malloc(length + 1);
+    assert(fread(text, 1, length, stream) == length);
+    text[length] = '\0';
+    fclose(stream);
+
+    cJSON* root = cJSON_Parse(text);
+    assert(root != NULL);
+    cJSON* events = cJSON_GetObjectItem(root, "traceEvents");
+    assert(cJSON_IsArray(events));
+
+    uint32_t num_breeds = 0;
+    uint32_t num_counters = 0;
+    uint32_t max_tid = 0;
+    bool test_span = false;
+    for (int e = 0; e < cJSON_GetArraySize(events); e++) {
+
+        cJSON* event = cJSON_GetArrayItem(events, e);
+        char* ph = cJSON_GetStringValue(cJSON_GetObjectItem(event, "ph"));
+        char* name = cJSON_GetStringValue(cJSON_GetObjectItem(event, "name"));
+        assert(ph != NULL && name != NULL);
+
+        if (strcmp(ph, "X") == 0) {
+            cJSON* tid = cJSON_GetObjectItem(event, "tid");
+            assert(cJSON_IsNumber(cJSON_GetObjectItem(event, "ts")) && cJSON_IsNumber(cJSON_GetObjectItem(event, "dur")));
+            assert(cJSON_IsNumber(tid) && tid->valueint >= 1);
+            max_tid = tid->valueint > max_tid ? tid->valueint : max_tid;
+            if (strcmp(name, "breed") == 0) {
+                num_breeds++;
+            }
+            if (strcmp(name, "test") == 0) {
+                assert(tid->valueint == 1);
+                test_span = true;
+            }
+        }
+        else if (strcmp(ph, "C") == 0) {
+            num_counters++;
+        }
+
+    }
+
+    // two children per breeding step, except when a worker only finds room for one
+    assert(num_breeds >= (pop_size + 1) / 2 && num_breeds <= pop_size);
+    assert(test_span && max_tid >= 2);
+    assert(num_counters == 3);
+
+    if (vis) {
+        printf("\nTraced %d breeding steps on %d tracks\n", num_breeds, max_tid);
+    }
+
+    cJSON_Delete(root);
+    free(text);
+    remove(trace_file);
+    store_free(s, true);
+    generate_free_generation(gen, pop_size);
+    free(gen);
+    free(fitness_values);
+
+    printf("\nTrace test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_bench
+ *
+ * DESCRIPTION
+ *
+ *  Builds a benchmark fixture and checks its population, then writes a
+ *  baseline to a temporary file and checks that results are found in it
+ *  by benchmark, object type and sizes, and that results slower than the
+ *  baseline by more than the tolerance are reported as regressions
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals in the fixture
+ *  uint32_t indiv_size -- number of genes per individual, at least 3
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the comparison
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_bench(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates and removes a temporary file, asserts on failure
+ *
+ */
+
+void test_bench(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    char baseline_file[100];
+    bench_result_str results[2];
+
+    bench_fixture_str* f = bench_fixture_create(ot, indiv_size, pop_size);
+    for (uint32_t i = 0; i < pop_size; i++) {
+        assert(osaka_listlength(f->gen[i]) == indiv_size);
+    }
+    bench_fixture_free(f);
+
+    strcpy(results[0].name, "test_fast");
+    strcpy(results[1].name, "test_slow");
+    for (uint32_t r = 0; r < 2; r++) {
+        results[r].ot = ot;
+        results[r].genome_len = indiv_size;
+        results[r].pop_size = pop_size;
+        results[r].iterations = 1;
+        results[r].ns_per_op = 100.0;
+    }
+
+    sprintf(baseline_file, "%s/shackleton_test_bench_%d.jsonl", P_tmpdir, (int) getpid());
+    bench_save(results, 2, baseline_file);
+
+    assert(bench_baseline_lookup(baseline_file, &results[0]) == 100.0);
+    results[0].pop_size++;
+    assert(bench_baseline_lookup(baseline_file, &results[0]) == 0.0);
+    results[0].pop_size--;
+
+    // one result within the tolerance, one just outside of it
+    results[0].ns_per_op = 100.0 * (1.0 + BENCH_TOLERANCE / 2);
+    results[1].ns_per_op = 100.0 * (1.0 + BENCH_TOLERANCE * 2);
+
+    FILE* stream = vis ? stdout : fopen("/dev/null", "w");
+    assert(stream != NULL);
+    assert(bench_report(stream, results, 2, baseline_file) == 1);
+    if (!vis) {
+        fclose(stream);
+    }
+
+    remove(baseline_file);
+
+    printf("\nBench test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_mock_evolution
+ *
+ * DESCRIPTION
+ *
+ *  Checks that the synthetic evaluator gives the same fitness every time
+ *  it sees the same individual, that a generation evaluated by several
+ *  threads gets the same fitness values as one evaluated in order, and
+ *  that whole runs with one and with four evaluation threads evaluate
+ *  every individual once and end with the same best individual
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_gens -- generations of every run
+ *  uint32_t pop_size -- number of individuals in the population
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the results
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_mock_evolution(3, 20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the random seed, asserts on failure
+ *
+ */
+
+void test_mock_evolution(uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    mock_config_str config = { 20000, 50000, MOCK_LATENCY_EXPONENTIAL, 1.0, 7 };
+    uint32_t previous_workers = evolution_get_workers();
+    uint64_t best_hash[2];
+    uint32_t workers[2] = { 1, 4 };
+
+    node_str** gen = malloc(sizeof(node_str*) * pop_size);
+    double* serial_values = malloc(sizeof(double) * pop_size);
+    double* parallel_values = malloc(sizeof(double) * pop_size);
+
+    mock_enable(&config);
+    generate_new_generation(gen, pop_size, indiv_size, ot);
+
+    assert(mock_fitness(gen[0]) == mock_fitness(gen[0]));
+    assert(mock_evaluations() == 2);
+
+    evolution_set_workers(1);
+    evolution_evaluate_generation(gen, serial_values, pop_size, "", NULL, 0);
+    evolution_set_workers(4);
+    evolution_evaluate_generation(gen, parallel_values, pop_size, "", NULL, 0);
+    assert(memcmp(serial_values, parallel_values, sizeof(double) * pop_size) == 0);
+    assert(mock_evaluations() == 2 + 2 * pop_size);
+
+    // every evaluation burns at least its cost before it counts as done
+    assert(mock_busy_ns() >= 2 * pop_size * config.cost_ns);
+
+    for (uint32_t r = 0; r < 2; r++) {
+
+        srand(config.seed);
+        evolution_set_workers(workers[r]);
+        mock_enable(&config);
+
+        node_str* best = evolution_basic_crossover_and_mutation_with_replacement(num_gens, pop_size, indiv_size, 2, 20, 75, ot, false, "", NULL, 0, false);
+        assert(mock_evaluations() == pop_size * (num_gens + 1));
+        best_hash[r] = osaka_hash(best);
+
+        if (vis) {
+            printf("\n%d workers: %lu evaluations, best individual hash %016lx\n", workers[r], (unsigned long) mock_evaluations(), (unsigned long) best_hash[r]);
+        }
+
+        generate_free_individual(best);
+
+    }
+
+    assert(best_hash[0] == best_hash[1]);
+
+    mock_disable();
+    assert(!mock_enabled());
+    evolution_set_workers(previous_workers);
+
+    generate_free_generation(gen, pop_size);
+    free(gen);
+    free(serial_values);
+    free(parallel_values);
+
+    printf("\nMock evolution test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_job
+ *
+ * DESCRIPTION
+ *
+ *  Tests job specs and the queue runner: an inline spec and a queue folder
+ *  with one valid and one invalid job file are read, the valid job runs
+ *  with the synthetic evaluator and caches to its own output folder, and
+ *  the evaluator and worker count are put back afterwards
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size - size of the population of the jobs, at least 4
+ *  uint32_t indiv_size - genes per individual, at least 3
+ *  osaka_object_typ ot - the object type being used for this run
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_job(20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes temporary files, changes the random seed
+ *
+ */
+
+void test_job(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis) {
+
+    char folder[200];
+    char valid_file[250];
+    char invalid_file[250];
+    char output[250];
+    char log_file[270];
+    char spec[600];
+    struct stat info;
+    job_str job;
+
+    uint32_t previous_workers = evolution_get_workers();
+
+    sprintf(folder, "%s/shackleton_test_jobs_%d", P_tmpdir, (int) getpid());
+    sprintf(valid_file, "%s/a_valid.json", folder);
+    sprintf(invalid_file, "%s/b_invalid.json", folder);
+    sprintf(output, "%s/out/valid", folder);
+    sprintf(log_file, "%s/run.jsonl", output);
+    assert(mkdir(folder, 0755) == 0);
+
+    assert(job_type_from_name(object_table_function[ot].name) == ot);
+    assert(job_type_from_name("no_such_type") == NOTSET);
+
+    // an inline spec, with the defaults filled in around it
+    sprintf(spec, "{\"type\":%d,\"population\":%u,\"genome_length\":%u,\"evaluator\":\"mock\",\"mock\":{\"cost_us\":0},\"workers\":2,\"seed\":3}", ot + 1, pop_size, indiv_size);
+    assert(job_load(&job, spec));
+    assert(job.type == ot && job.pop_size == pop_size && job.num_generations == 10 && job.workers == 2);
+    assert(job.evaluator == JOB_EVALUATOR_MOCK && job.mock.seed == 3 && !job.cache);
+    job_free(&job);
+
+    // a job file for the queue, named after the file
+    sprintf(spec, "{\"type\":\"%s\",\"generations\":2,\"population\":%u,\"genome_length\":%u,\"evaluator\":\"mock\",\"mock\":{\"cost_us\":0},\"workers\":2,\"cache\":true,\"output\":\"%s\"}",
+        object_table_function[ot].name, pop_size, indiv_size, output);
+    FILE* file = fopen(valid_file, "w");
+    assert(file != NULL);
+    fprintf(file, "%s\n", spec);
+    fclose(file);
+    assert(job_load(&job, valid_file));
+    assert(strcmp(job.name, "a_valid") == 0 && job.cache && strcmp(job.output, output) == 0);
+    job_free(&job);
+
+    // unknown keys and values out of range fail the job, the queue goes on without it
+    file = fopen(invalid_file, "w");
+    assert(file != NULL);
+    fprintf(file, "{\"type\":%d,\"population\":2,\"colour\":\"blue\"}\n", ot + 1);
+    fclose(file);
+
+    FILE* stream = vis ? stdout : fopen("/dev/null", "w");
+    assert(stream != NULL);
+    assert(job_queue(folder, stream) == 1);
+    if (!vis) {
+        fclose(stream);
+    }
+
+    // the valid job cached to its own folder and put everything back
+    assert(stat(log_file, &info) == 0 && info.st_size > 0);
+    assert(!mock_enabled());
+    assert(evolution_get_workers() == previous_workers);
+
+    remove(log_file);
+    remove(valid_file);
+    remove(invalid_file);
+    rmdir(output);
+    sprintf(output, "%s/out", folder);
+    rmdir(output);
+    rmdir(folder);
+
+    printf("\nJob test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_build_cache
+ *
+ * DESCRIPTION
+ *
+ *  Tests the parts of the LLVM build cache that do not need LLVM: files
+ *  are hashed by their contents alone, and control timings stored for a
+ *  linked module are found again on this machine
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_build_cache(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes temporary files
+ *
+ */
+
+void test_build_cache(bool vis) {
+
+    char first[200];
+    char second[200];
+    char baselines[LLVM_MAX_PATH];
+    double no_optimization = 0.0;
+    double basic_optimization = 0.0;
+
+    sprintf(first, "%s/shackleton_test_hash_a_%d.c", P_tmpdir, (int) getpid());
+    sprintf(second, "%s/shackleton_test_hash_b_%d.c", P_tmpdir, (int) getpid());
+
+    FILE* file = fopen(first, "w");
+    assert(file != NULL);
+    fprintf(file, "int main() { return 0; }\n");
+    fclose(file);
+
+    file = fopen(second, "w");
+    assert(file != NULL);
+    fprintf(file, "int main() { return 0; }\n");
+    fclose(file);
+
+    // same contents under another name hash the same, any change does not
+    uint64_t hash = llvm_hash_file(first);
+    assert(hash != 0);
+    assert(llvm_hash_file(second) == hash);
+
+    file = fopen(second, "a");
+    assert(file != NULL);
+    fprintf(file, "\n");
+    fclose(file);
+    assert(llvm_hash_file(second) != hash);
+    assert(llvm_hash_file("no_such_file.c") == 0);
+
+    remove(first);
+    remove(second);
+
+    // timings go next to the LLVM sources, only checked where they exist
+    if (access(LLVM_FOLDER, F_OK) == 0) {
+
+        uint64_t key = hash_combine(hash, (uint64_t) getpid());
+
+        assert(!llvm_cache_lookup_baselines(key, &no_optimization, &basic_optimization));
+        llvm_cache_store_baselines(key, 0.25, 0.125);
+        assert(llvm_cache_lookup_baselines(key, &no_optimization, &basic_optimization));
+        assert(no_optimization == 0.25 && basic_optimization == 0.125);
+
+        sprintf(baselines, "%s/%016lx_baselines.json", LLVM_CACHE_FOLDER, (unsigned long) key);
+        assert(remove(baselines) == 0);
+
+    }
+
+    if (vis) {
+        printf("\nContent hash %016lx\n", (unsigned long) hash);
+    }
+
+    printf("\nBuild cache test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_suite
+ *
+ * DESCRIPTION
+ *
+ *  Tests the parts of the benchmark suite fitness that do not need LLVM:
+ *  the weighted geometric mean of the time ratios, and reading valid and
+ *  invalid suite files
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_suite(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a temporary file
+ *
+ */
+
+void test_suite(bool vis) {
+
+    char path[200];
+    suite_str suite;
+    double ratios[3] = { 0.5, 2.0, 0.8 };
+    double weights[3] = { 1.0, 1.0, 1.0 };
+
+    // a speedup on one program and the same slowdown on another cancel out
+    assert(fabs(suite_aggregate(ratios, weights, 2) - 1.0) < 1e-12);
+    assert(fabs(suite_aggregate(ratios + 2, weights, 1) - 0.8) < 1e-12);
+
+    // weights count a program several times over
+    weights[0] = 3.0;
+    assert(fabs(suite_aggregate(ratios, weights, 2) - sqrt(0.5)) < 1e-12);
+
+    sprintf(path, "%s/shackleton_test_suite_%d.json", P_tmpdir, (int) getpid());
+
+    FILE* file = fopen(path, "w");
+    assert(file != NULL);
+    fprintf(file, "{\"cutoff\":2.0,\"runs\":3,\"benchmarks\":[{\"name\":\"test\",\"test_file\":\"test.cpp\",\"sources\":[\"math.cpp\"]},"
+        "{\"name\":\"acotsp\",\"test_file\":\"acotsp/acotsp.c\",\"args\":\"-r 1\",\"weight\":2}]}\n");
+    fclose(file);
+
+    assert(suite_load(&suite, path));
+    assert(suite.num_benchmarks == 2 && suite.cutoff == 2.0 && suite.runs == 3);
+    assert(suite.benchmarks[0].num_src_files == 1 && strcmp(suite.benchmarks[0].src_files[0], "math.cpp") == 0);
+    assert(suite.benchmarks[0].weight == 1.0 && strcmp(suite.benchmarks[0].args, "") == 0);
+    assert(suite.benchmarks[1].num_src_files == 0 && suite.benchmarks[1].weight == 2.0);
+    assert(strcmp(suite.benchmarks[1].args, "-r 1") == 0);
+
+    assert(!suite_enabled());
+    suite_enable(&suite);
+    assert(suite_enabled());
+    suite_disable();
+    assert(!suite_enabled());
+    suite_free(&suite);
+
+    // unknown keys, missing test files, repeated names and bad weights all fail
+    const char* invalid[] = {
+        "{\"benchmarks\":[{\"name\":\"test\",\"test_file\":\"test.cpp\"}],\"speed\":1}",
+        "{\"benchmarks\":[{\"name\":\"test\"}]}",
+        "{\"benchmarks\":[{\"name\":\"test\",\"test_file\":\"test.cpp\"},{\"name\":\"test\",\"test_file\":\"main.cpp\"}]}",
+        "{\"benchmarks\":[{\"name\":\"test\",\"test_file\":\"test.cpp\",\"weight\":0}]}",
+        "{\"benchmarks\":[{\"name\":\"a b\",\"test_file\":\"test.cpp\"}]}",
+        "{\"cutoff\":0.5,\"benchmarks\":[{\"name\":\"test\",\"test_file\":\"test.cpp\"}]}",
+        "{\"benchmarks\":[]}",
+        "[1, 2"
+    };
+
+    for (uint32_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        file = fopen(path, "w");
+        assert(file != NULL);
+        fprintf(file, "%s\n", invalid[i]);
+        fclose(file);
+        assert(!suite_load(&suite, path));
+        suite_free(&suite);
+    }
+
+    remove(path);
+    assert(!suite_load(&suite, path));
+
+    if (vis) {
+        printf("\nWeighted geometric mean %f\n", suite_aggregate(ratios, weights, 2));
+    }
+
+    printf("\nBenchmark suite test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   __test_evolution_improves
+ *
+ * DESCRIPTION
+ *
+ *  Runs a short seeded evolution of an object type whose fitness is a
+ *  cost, lower is better, and checks that the best individual it ends
+ *  with scores no worse than the best of a random generation and
+ *  better than its mean, so selection pushes towards the target
+ *
+ * PARAMETERS
+ *
+ *  osaka_object_typ ot -- object type whose fitness is lower is better
+ *  bool vis -- whether or not to print the results
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __test_evolution_improves(BINARY_UP_TO_512, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the random seed, asserts on failure
+ *
+ */
+
+void __test_evolution_improves(osaka_object_typ ot, bool vis) {
+
+    node_str* gen[30];
+    double fitness_values[30];
+    double random_best;
+    double random_mean = 0;
+
+    srand(11);
+    generate_new_generation(gen, 30, 10, ot);
+    evolution_evaluate_generation(gen, fitness_values, 30, "", NULL, 0);
+    random_best = fitness_values[0];
+
+    for (uint32_t i = 0; i < 30; i++) {
+        random_best = fitness_values[i] < random_best ? fitness_values[i] : random_best;
+        random_mean += fitness_values[i] / 30;
+    }
+
+    generate_free_generation(gen, 30);
+
+    node_str* best = evolution_basic_crossover_and_mutation_with_replacement(15, 30, 10, 3, 20, 75, ot, false, "", NULL, 0, false);
+    double best_fitness = fitness_top(best, false, "", NULL, 0, false, "");
+
+    if (vis) {
+        printf("\n%s: random generation best %f mean %f, evolved best %f\n", object_table_function[ot].name, random_best, random_mean, best_fitness);
+    }
+
+    assert(best_fitness <= random_best && best_fitness < random_mean);
+    generate_free_individual(best);
+
+}
+
+/*
+ * NAME
+ *
+ *   test_interpreter
+ *
+ * DESCRIPTION
+ *
+ *  Tests the register machine interpreter of ASSEMBLER individuals: a
+ *  program computing the default target exactly has no error and the
+ *  expected cycles, a changed immediate shows up in the error on every
+ *  case, division follows AArch64 sdiv, the fitness by cycles ranks exact
+ *  programs first, the operands survive encoding and decoding, and random
+ *  programs give bit for bit the same results one case at a time, in a
+ *  plain loop over the lanes and with SIMD, overflowing inputs included.
+ *  Stripping the introns leaves what a program computes alone, and gives
+ *  programs that only differ in their introns the same bytecode and hash
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_interpreter(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the interpreter problem back to the default
+ *
+ */
+
+void test_interpreter(bool vis) {
+
+    interpreter_program_str program = { 0 };
+    uint32_t fields[OBJECT_MAX_FIELDS];
+    int64_t inputs[2] = { 5, 7 };
+
+    // mul r2, r0, r0; add r2, r2, r1; sub r0, r2, #3 is x0 * x0 + x1 - 3
+    node_str* indiv = generate_new_individual(3, ASSEMBLER);
+    object_assembler_str* mul = (object_assembler_str*) OBJECT(indiv);
+    object_assembler_str* add = (object_assembler_str*) OBJECT(NEXT(indiv));
+    object_assembler_str* sub = (object_assembler_str*) OBJECT(NEXT(NEXT(indiv)));
+
+    *mul = (object_assembler_str) { MUL, R2, R0, R0, false, 0 };
+    *add = (object_assembler_str) { ADD, R2, R2, R1, false, 0 };
+    *sub = (object_assembler_str) { SUB, R0, R2, R0, true, 3 };
+
+    interpreter_decode(&program, indiv);
+    assert(program.num_instructions == 3 && program.cycles == 5);
+    assert(interpreter_run(&program, inputs, 2) == 29);
+    assert(interpreter_fitness(indiv) == 0);
+
+    // the same program with a dead write to r3, r0 written before it is next written and r1 written after its last read
+    interpreter_program_str effective = { 0 };
+    node_str* introns = generate_new_individual(6, ASSEMBLER);
+    object_assembler_str program_with_introns[6] = {
+        { ADD, R3, R1, R2, true, 9 },
+        { MUL, R2, R0, R0, false, 0 },
+        { MOV, R0, R2, R1, true, 1 },
+        { ADD, R2, R2, R1, false, 0 },
+        { SDIV, R1, R2, R2, false, 0 },
+        { SUB, R0, R2, R3, true, 3 }
+    };
+    uint32_t g = 0;
+    for (node_str* node = introns; node != NULL; node = NEXT(node)) {
+        *(object_assembler_str*) OBJECT(node) = program_with_introns[g++];
+    }
+
+    interpreter_decode(&effective, introns);
+    assert(interpreter_strip_introns(&effective) == 3);
+    assert(effective.num_instructions == 3 && effective.cycles == 5);
+    assert(interpreter_run(&effective, inputs, 2) == 29);
+    assert(interpreter_strip_introns(&program) == 0);
+    assert(interpreter_hash(&effective) == interpreter_hash(&program));
+    assert(memcmp(effective.code, program.code, 3 * sizeof(interpreter_instruction_str)) == 0);
+    assert(interpreter_fitness(introns) == 0);
+
+    interpreter_free(&effective);
+    generate_free_individual(introns);
+
+    // off by one on all 64 cases
+    sub->imm = 4;
+    assert(interpreter_fitness(indiv) == INTERPRETER_DEFAULT_CASES);
+
+    interpreter_set_problem(interpreter_target_default, 2, INTERPRETER_DEFAULT_CASES, INTERPRETER_FITNESS_CYCLES);
+    assert(interpreter_fitness(indiv) == INTERPRETER_CYCLES_CEILING + INTERPRETER_DEFAULT_CASES);
+    sub->imm = 3;
+    assert(interpreter_fitness(indiv) == 5);
+    interpreter_set_problem(interpreter_target_default, 2, INTERPRETER_DEFAULT_CASES, INTERPRETER_FITNESS_ERROR);
+
+    // sdiv rounds toward zero, gives zero for a zero divisor and wraps the one overflow
+    *mul = (object_assembler_str) { SDIV, R0, R0, R1, false, 0 };
+    *add = (object_assembler_str) { MOV, R1, R3, R0, false, 0 };
+    *sub = (object_assembler_str) { ADD, R0, R0, R1, false, 0 };
+    interpreter_decode(&program, indiv);
+
+    int64_t division[4][3] = { { -7, 2, -6 }, { 7, 0, 0 }, { INT64_MIN, -1, 0 }, { 100, -10, -20 } };
+    for (uint32_t i = 0; i < 4; i++) {
+        assert(interpreter_run(&program, division[i], 2) == division[i][2]);
+    }
+
+    *sub = (object_assembler_str) { MOV, R0, R1, R1, true, -5 };
+    interpreter_decode(&program, indiv);
+    assert(interpreter_run(&program, inputs, 2) == -5);
+
+    // every operand is a field of its own
+    assert(assembler_fieldsobject(fields) == 6);
+    assembler_encodeobject(fields, sub);
+    object_assembler_str* decoded = (object_assembler_str*) assembler_decodeobject(fields);
+    assert(assembler_equalobject(sub, decoded));
+    assert(assembler_hashobject(sub) == assembler_hashobject(decoded));
+    decoded->imm = 5;
+    assert(!assembler_equalobject(sub, decoded));
+    assert(assembler_hashobject(sub) != assembler_hashobject(decoded));
+    assembler_deleteobject(decoded);
+
+    // the lanes hold the values that overflow, wrap or divide by zero next to ordinary ones
+    int64_t edges[] = { 0, 1, -1, 2, INT64_MIN, INT64_MAX, INT64_MIN + 1, 1LL << 32, -(1LL << 32), 0xffffffffLL, 7, -100 };
+    int64_t lanes[INTERPRETER_NUM_REGISTERS * INTERPRETER_LANES];
+    int64_t scalar[INTERPRETER_NUM_REGISTERS];
+    int64_t portable[INTERPRETER_LANES];
+    int64_t simd[INTERPRETER_LANES];
+    interpreter_dataset_str dataset;
+
+    node_str* random = generate_new_individual(12, ASSEMBLER);
+    interpreter_dataset_create(&dataset, interpreter_target_default, 2, 61, 1000, 7);
+
+    for (uint32_t p = 0; p < 500; p++) {
+
+        for (node_str* node = random; node != NULL; node = NEXT(node)) {
+            assembler_randomizeobject(OBJECT(node));
+        }
+        interpreter_decode(&program, random);
+
+        for (uint32_t i = 0; i < INTERPRETER_NUM_REGISTERS * INTERPRETER_LANES; i++) {
+            lanes[i] = edges[(p + 5 * i) % (sizeof(edges) / sizeof(edges[0]))];
+        }
+        interpreter_run_lanes(&program, lanes, INTERPRETER_NUM_REGISTERS, portable, INTERPRETER_MODE_LANES);
+        interpreter_run_lanes(&program, lanes, INTERPRETER_NUM_REGISTERS, simd, INTERPRETER_MODE_SIMD);
+
+        for (uint32_t l = 0; l < INTERPRETER_LANES; l++) {
+            for (uint32_t i = 0; i < INTERPRETER_NUM_REGISTERS; i++) {
+                scalar[i] = lanes[i * INTERPRETER_LANES + l];
+            }
+            int64_t expected = interpreter_run(&program, scalar, INTERPRETER_NUM_REGISTERS);
+            assert(portable[l] == expected && simd[l] == expected);
+        }
+
+        // 61 cases leave the last block part padding
+        uint64_t error = interpreter_error(&program, &dataset);
+        assert(interpreter_error_mode(&program, &dataset, INTERPRETER_MODE_LANES) == error);
+        assert(interpreter_error_mode(&program, &dataset, INTERPRETER_MODE_SIMD) == error);
+
+        // the introns never change r0
+        interpreter_strip_introns(&program);
+        assert(interpreter_error_mode(&program, &dataset, INTERPRETER_MODE_SIMD) == error);
+
+    }
+
+    interpreter_dataset_free(&dataset);
+    generate_free_individual(random);
+
+    if (vis) {
+
+        printf("\nInterpreter lanes run %s\n", interpreter_simd_available() ? "on AVX2" : "in plain C");
+
+        struct timeval start, end;
+        uint32_t repeats = 100000;
+        uint64_t sink = 0;
+
+        gettimeofday(&start, NULL);
+        for (uint32_t i = 0; i < repeats; i++) {
+            inputs[0] = i;
+            sink += interpreter_run(&program, inputs, 2);
+        }
+        gettimeofday(&end, NULL);
+
+        double seconds = (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) * 1e-6;
+        printf("\nInterpreter ran %.1f million instructions per second (%lu)\n", repeats * 3.0 / seconds / 1e6, (unsigned long) sink);
+
+    }
+
+    // selection keeps the lower error, so a short run gets closer to the target
+    __test_evolution_improves(ASSEMBLER, vis);
+
+    interpreter_free(&program);
+    generate_free_individual(indiv);
+
+    printf("\nInterpreter test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_aarch64
+ *
+ * DESCRIPTION
+ *
+ *  Tests the AArch64 evaluator of ASSEMBLER individuals: the function
+ *  emitted for an individual zeroes the registers that are not inputs and
+ *  turns immediates AArch64 has no form for into valid instructions, and,
+ *  when the cross toolchain and the emulator are installed, a generation
+ *  run under the emulator agrees with the interpreter on every individual
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_aarch64(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds and runs a program in src/files/aarch64 if the toolchain is installed
+ *
+ */
+
+void test_aarch64(bool vis) {
+
+    char text[4096];
+
+    node_str* indiv = generate_new_individual(4, ASSEMBLER);
+    object_assembler_str genes[4] = {
+        { ADD, R2, R0, R1, true, -3 },
+        { MUL, R1, R2, R0, true, -5 },
+        { SDIV, R0, R1, R3, false, 0 },
+        { MOV, R3, R2, R1, true, -128 }
+    };
+    uint32_t g = 0;
+    for (node_str* node = indiv; node != NULL; node = NEXT(node)) {
+        *(object_assembler_str*) OBJECT(node) = genes[g++];
+    }
+
+    FILE* stream = tmpfile();
+    assert(stream != NULL);
+    aarch64_emit_function(stream, indiv, "shackleton_test", 2);
+    rewind(stream);
+    size_t length = fread(text, 1, sizeof(text) - 1, stream);
+    text[length] = '\0';
+    fclose(stream);
+
+    if (vis) {
+        printf("\n%s", text);
+    }
+
+    assert(strstr(text, "shackleton_test:\n") != NULL);
+    assert(strstr(text, "\tmov x2, #0\n\tmov x3, #0\n") != NULL);
+    assert(strstr(text, "\tmov x1, #0\n") == NULL);
+    assert(strstr(text, "\tsub x2, x0, #3\n") != NULL);
+    assert(strstr(text, "\tmov x9, #-5\n\tmul x1, x2, x9\n") != NULL);
+    assert(strstr(text, "\tsdiv x0, x1, x3\n") != NULL);
+    assert(strstr(text, "\tmov x3, #-128\n") != NULL);
+    assert(strstr(text, "\tret\n") != NULL);
+
+    generate_free_individual(indiv);
+
+    if (aarch64_available()) {
+
+        uint32_t pop_size = 40;
+        node_str** gen = malloc(pop_size * sizeof(node_str*));
+        assert(gen != NULL);
+
+        for (uint32_t k = 0; k < pop_size; k++) {
+            gen[k] = generate_new_individual(1 + k % 12, ASSEMBLER);
+        }
+
+        // the emulator results go through the memo, which the interpreter results then have to match
+        assert(aarch64_evaluate_generation(gen, pop_size) == 0);
+        interpreter_set_memo(false);
+        uint32_t interpreted = interpreter_fitness(gen[pop_size - 1]);
+        interpreter_set_memo(true);
+        assert(interpreted == interpreter_fitness(gen[pop_size - 1]));
+
+        for (uint32_t k = 0; k < pop_size; k++) {
+            generate_free_individual(gen[k]);
+        }
+        free(gen);
+
+    }
+    else if (vis) {
+        printf("\n%s or %s is not installed, the emulator was not run\n", AARCH64_CC, AARCH64_EMULATOR);
+    }
+
+    printf("\nAArch64 test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   __test_edit_distance
+ *
+ * DESCRIPTION
+ *
+ *  Reference edit distance for test_distance, the textbook dynamic
+ *  programming over one row of the matrix
+ *
+ * PARAMETERS
+ *
+ *  const char* a -- first string
+ *  const char* b -- second string
+ *
+ * RETURN
+ *
+ *  uint32_t -- least number of insertions, deletions and substitutions turning a into b
+ *
+ * EXAMPLE
+ *
+ *  assert(distance_edit(indiv) == __test_edit_distance(joined, target));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint32_t __test_edit_distance(const char* a, const char* b) {
+
+    size_t n = strlen(a);
+    size_t m = strlen(b);
+    uint32_t* row = malloc((m + 1) * sizeof(uint32_t));
+    assert(row != NULL);
+
+    for (size_t j = 0; j <= m; j++) {
+        row[j] = j;
+    }
+
+    for (size_t i = 1; i <= n; i++) {
+
+        uint32_t diagonal = row[0];
+        row[0] = i;
+
+        for (size_t j = 1; j <= m; j++) {
+            uint32_t above = row[j];
+            uint32_t best = diagonal + (a[i - 1] != b[j - 1]);
+            best = above + 1 < best ? above + 1 : best;
+            best = row[j - 1] + 1 < best ? row[j - 1] + 1 : best;
+            row[j] = best;
+            diagonal = above;
+        }
+
+    }
+
+    uint32_t distance = row[m];
+    free(row);
+
+    return distance;
+
+}
+
+/*
+ * NAME
+ *
+ *   test_distance
+ *
+ * DESCRIPTION
+ *
+ *  Tests the string distance fitness of OSAKA_STRING individuals: for
+ *  targets of one word, exactly one word and several words of the bit
+ *  vectors, the edit and Hamming distances of a batch and of single
+ *  individuals match a plain dynamic programming reference on the joined
+ *  strings, the target sentence itself is at distance 0, and the distance
+ *  memo filled for a generation gives back the same fitness values
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_distance(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the target sentence back to the default
+ *
+ */
+
+void test_distance(bool vis) {
+
+    const char* words[] = { "Mary", "had", "a", "little", "lamb", "whose", "fleece", "was", "white", "as", "snow", "lamp", "", "Marry", "snowwhite" };
+    uint32_t num_words = sizeof(words) / sizeof(words[0]);
+    char targets[3][DISTANCE_MAX_TARGET];
+    char joined[DISTANCE_MAX_TARGET];
+    uint32_t pop_size = 60;
+
+    strcpy(targets[0], DISTANCE_DEFAULT_TARGET);
+    snprintf(targets[2], DISTANCE_MAX_TARGET, "%s and everywhere that Mary went the lamb was sure to go, %s", DISTANCE_DEFAULT_TARGET, DISTANCE_DEFAULT_TARGET);
+    // the first DISTANCE_WORD_BITS characters of the long target, a target that fills one word of the bit vectors exactly
+    assert(strlen(targets[2]) > DISTANCE_WORD_BITS);
+    memcpy(targets[1], targets[2], DISTANCE_WORD_BITS);
+    targets[1][DISTANCE_WORD_BITS] = '\0';
+
+    node_str** gen = malloc(pop_size * sizeof(node_str*));
+    uint32_t* distances = malloc(pop_size * sizeof(uint32_t));
+    assert(gen != NULL && distances != NULL);
+
+    // every fourth string keeps its random value, the rest are taken from words near the target
+    for (uint32_t k = 0; k < pop_size; k++) {
+        gen[k] = generate_new_individual(1 + k % 12, OSAKA_STRING);
+        for (node_str* node = gen[k]; node != NULL; node = NEXT(node)) {
+            if (rand() % 4 != 0) {
+                MY_STRING(((object_osaka_string_str*) OBJECT(node))) = (char*) words[rand() % num_words];
+                HASH_VALID(node) = false;
+            }
+        }
+    }
+
+    for (uint32_t t = 0; t < 3; t++) {
+
+        distance_set_target(targets[t], DISTANCE_EDIT);
+        distance_batch(gen, pop_size, distances);
+
+        for (uint32_t k = 0; k < pop_size; k++) {
+
+            joined[0] = '\0';
+            for (node_str* node = gen[k]; node != NULL; node = NEXT(node)) {
+                strcat(joined, node == gen[k] ? "" : " ");
+                strcat(joined, MY_STRING(((object_osaka_string_str*) OBJECT(node))));
+            }
+
+            uint32_t expected = __test_edit_distance(joined, targets[t]);
+
+            if (vis && k < 4) {
+                printf("\n\"%s\" is %u edits from \"%s\"\n", joined, expected, targets[t]);
+            }
+
+            assert(distances[k] == expected);
+            assert(distance_edit(gen[k]) == expected);
+
+            uint32_t mismatches = 0;
+            size_t n = strlen(joined);
+            size_t m = strlen(targets[t]);
+            for (size_t i = 0; i < (n > m ? n : m); i++) {
+                mismatches += i >= n || i >= m || joined[i] != targets[t][i];
+            }
+            assert(distance_hamming(gen[k]) == mismatches);
+
+        }
+
+        distance_set_target(targets[t], DISTANCE_HAMMING);
+        distance_batch(gen, pop_size, distances);
+        for (uint32_t k = 0; k < pop_size; k++) {
+            assert(distances[k] == distance_hamming(gen[k]));
+        }
+
+    }
+
+    // the target sentence itself, one word to a gene
+    distance_set_target(DISTANCE_DEFAULT_TARGET, DISTANCE_EDIT);
+    node_str* exact = generate_new_individual(11, OSAKA_STRING);
+    uint32_t w = 0;
+    for (node_str* node = exact; node != NULL; node = NEXT(node)) {
+        MY_STRING(((object_osaka_string_str*) OBJECT(node))) = (char*) words[w++];
+        HASH_VALID(node) = false;
+    }
+    assert(distance_edit(exact) == 0);
+    assert(distance_hamming(exact) == 0);
+    assert(fitness_osaka_string(exact, false) == 0);
+    generate_free_individual(exact);
+
+    // fitness values come from the memo a generation filled and agree with a fresh evaluation
+    distance_generation(gen, pop_size);
+    for (uint32_t k = 0; k < pop_size; k++) {
+        assert(fitness_osaka_string(gen[k], false) == distance_edit(gen[k]));
+    }
+
+    for (uint32_t k = 0; k < pop_size; k++) {
+        generate_free_individual(gen[k]);
+    }
+    free(gen);
+    free(distances);
+
+    // selection keeps the lower distance, so a short run gets closer to the target
+    __test_evolution_improves(OSAKA_STRING, vis);
+
+    printf("\nDistance test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_bitset
+ *
+ * DESCRIPTION
+ *
+ *  Tests the packed genomes of BINARY_UP_TO_512 individuals: the flat
+ *  objects copy, write and read back equal, a packed genome holds the
+ *  index of every gene, and for individuals of 1 to 300 genes the OneMax,
+ *  target sum and knapsack kernels and the fitness of each problem match
+ *  a plain loop over the genes
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_bitset(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the problem back to OneMax
+ *
+ */
+
+void test_bitset(bool vis) {
+
+    bitset_genome_str genome;
+    uint64_t weights[300];
+    uint32_t lengths[] = { 1, 10, 15, 16, 17, 63, 64, 65, 128, 300 };
+
+    // the flat object round trips through a copy and a stream
+    object_binary_up_to_512_str* o = binary_up_to_512_createobject();
+    binary_up_to_512_randomizeobject(o);
+    BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) = 10;
+    object_binary_up_to_512_str* c = binary_up_to_512_copyobject(o);
+    assert(binary_up_to_512_equalobject(o, c) && BINARY_UP_TO_512_BINARY_MY_BINARY(c) == 512);
+    FILE* stream = tmpfile();
+    assert(stream != NULL);
+    binary_up_to_512_writeobject(stream, o);
+    rewind(stream);
+    object_binary_up_to_512_str* r = binary_up_to_512_readobject(stream);
+    fclose(stream);
+    assert(binary_up_to_512_equalobject(o, r) && binary_up_to_512_hashobject(o) == binary_up_to_512_hashobject(r));
+    binary_up_to_512_deleteobject(o);
+    binary_up_to_512_deleteobject(c);
+    binary_up_to_512_deleteobject(r);
+
+    // the weight of every position, from genomes with that one gene set
+    bitset_set_problem(BITSET_KNAPSACK, 0, BITSET_DEFAULT_SEED);
+    for (uint32_t g = 0; g < 300; g++) {
+        memset(&genome, 0, sizeof(genome));
+        genome.length = 300;
+        genome.words[g / BITSET_GENES_PER_WORD] = 1ULL << (BITSET_GENE_BITS * (g % BITSET_GENES_PER_WORD));
+        weights[g] = bitset_weight(&genome);
+        assert(weights[g] >= 1 && weights[g] <= 255);
+    }
+
+    for (uint32_t t = 0; t < 40; t++) {
+
+        uint32_t length = lengths[t % 10];
+        node_str* indiv = generate_new_individual(length, BINARY_UP_TO_512);
+        uint32_t ones = 0;
+        uint64_t sum = 0;
+        uint64_t weight = 0;
+        uint32_t g = 0;
+
+        // every other individual leaves most genes at 0
+        for (node_str* node = indiv; node != NULL; node = NEXT(node), g++) {
+
+            object_binary_up_to_512_str* gene = (object_binary_up_to_512_str*) OBJECT(node);
+
+            if (t % 2 == 1 && rand() % 4 != 0) {
+                BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(gene) = 0;
+                HASH_VALID(node) = false;
+            }
+
+            ones += BINARY_UP_TO_512_BINARY_MY_BINARY(gene) != 0;
+            sum += BINARY_UP_TO_512_BINARY_MY_BINARY(gene);
+            weight += BINARY_UP_TO_512_BINARY_MY_BINARY(gene) != 0 ? weights[g] : 0;
+
+        }
+
+        assert(bitset_pack(indiv, &genome) && genome.length == length);
+
+        g = 0;
+        for (node_str* node = indiv; node != NULL; node = NEXT(node), g++) {
+            uint64_t index = (genome.words[g / BITSET_GENES_PER_WORD] >> (BITSET_GENE_BITS * (g % BITSET_GENES_PER_WORD))) & 0xF;
+            assert(index == BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(((object_binary_up_to_512_str*) OBJECT(node))));
+        }
+
+        if (vis) {
+            printf("\n%u genes, %u set, sum %lu, weight %lu\n", length, ones, sum, weight);
+        }
+
+        uint64_t most = 512 * (uint64_t) length;
+        uint64_t capacity = weight / 2 + t % 3 * weight;
+
+        bitset_set_problem(BITSET_KNAPSACK, capacity, BITSET_DEFAULT_SEED);
+        assert(bitset_onemax(&genome) == ones);
+        assert(bitset_sum(&genome) == sum);
+        assert(bitset_weight(&genome) == weight);
+        assert(fitness_binary_up_to_512(indiv, false) == (weight > capacity ? most + weight - capacity : most - sum));
+        bitset_set_problem(BITSET_TARGET_SUM, 1000, BITSET_DEFAULT_SEED);
+        assert(fitness_binary_up_to_512(indiv, false) == (sum > 1000 ? sum - 1000 : 1000 - sum));
+        bitset_set_problem(BITSET_ONEMAX, 0, BITSET_DEFAULT_SEED);
+        assert(fitness_binary_up_to_512(indiv, false) == length - ones);
+
+        generate_free_individual(indiv);
+
+    }
+
+    // selection keeps the smaller cost, so a short run gets closer to the target sum,
+    // most random generations already hold an individual that solves OneMax outright
+    bitset_set_problem(BITSET_TARGET_SUM, 1000, BITSET_DEFAULT_SEED);
+    __test_evolution_improves(BINARY_UP_TO_512, vis);
+    bitset_set_problem(BITSET_ONEMAX, 0, BITSET_DEFAULT_SEED);
+
+    printf("\nBitset test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_batch
+ *
+ * DESCRIPTION
+ *
+ *  Tests the batch kernels of the module table: individuals generated
+ *  through the randomize kernel only hold valid values and reach all of
+ *  them, the same srand seed generates the same individuals, a mutate
+ *  kernel changes at most one field of one unit, types without
+ *  kernels fall back to randomizing one object at a time, and a batch
+ *  is flushed before a node of another type
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_batch(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  reseeds the random generator
+ *
+ */
+
+void test_batch(bool vis) {
+
+    uint32_t seen[11] = { 0 };
+    uint32_t lengths[] = { 1, 63, 64, 65, 200 };
+
+    assert(object_table_function[BINARY_UP_TO_512].osaka_randomizebatch != NULL);
+    assert(object_table_function[BINARY_UP_TO_512].osaka_mutatebatch != NULL);
+
+    // individuals across the batch boundary hold valid indices, reaching every one of them
+    for (uint32_t t = 0; t < 5; t++) {
+
+        srand(t + 1);
+        node_str* indiv = generate_new_individual(lengths[t], BINARY_UP_TO_512);
+        srand(t + 1);
+        node_str* again = generate_new_individual(lengths[t], BINARY_UP_TO_512);
+
+        assert(osaka_listlength(indiv) == lengths[t]);
+
+        for (node_str *n = indiv, *m = again; n != NULL; n = NEXT(n), m = NEXT(m)) {
+            uint32_t index = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(((object_binary_up_to_512_str*) OBJECT(n)));
+            assert(index < BINARY_UP_TO_512_BINARY_NUM_VALID_VALUES(OBJECT(n)) && !HASH_VALID(n));
+            assert(m != NULL && binary_up_to_512_equalobject(OBJECT(n), OBJECT(m)));
+            seen[index]++;
+        }
+
+        generate_free_individual(indiv);
+        generate_free_individual(again);
+
+    }
+
+    for (uint32_t v = 0; v < 11; v++) {
+        if (vis) {
+            printf("\nindex %u drawn %u times\n", v, seen[v]);
+        }
+        assert(seen[v] > 0);
+    }
+
+    // single param mutation changes one field of the chosen unit and nothing else
+    node_str* indiv = generate_new_individual(10, BINARY_UP_TO_512);
+    node_str* before = osaka_copylist(indiv);
+
+    for (uint32_t t = 0; t < 200; t++) {
+
+        uint32_t ind = t % 10 + 1;
+        mutation_single_unit_single_param(indiv, ind);
+
+        uint32_t pos = 1;
+        for (node_str *n = indiv, *b = before; n != NULL; n = NEXT(n), b = NEXT(b), pos++) {
+
+            object_binary_up_to_512_str* now = OBJECT(n);
+            object_binary_up_to_512_str* then = OBJECT(b);
+            uint32_t changed = (BINARY_UP_TO_512_NUMBER_MY_NUMBER(now) != BINARY_UP_TO_512_NUMBER_MY_NUMBER(then))
+                + (BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(now) != BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(then));
+
+            assert(changed <= (pos == ind ? 1 : 0));
+            BINARY_UP_TO_512_NUMBER_MY_NUMBER(then) = BINARY_UP_TO_512_NUMBER_MY_NUMBER(now);
+            BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(then) = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(now);
+
+        }
+
+    }
+
+    generate_free_individual(indiv);
+    generate_free_individual(before);
+
+    // a type without a randomize kernel is still randomized, one object at a time
+    assert(object_table_function[SIMPLE].osaka_randomizebatch == NULL);
+    uint64_t state = rand_state();
+    node_str* simple = generate_new_individual(70, SIMPLE);
+    node_str* nodes[70];
+    uint32_t count = 0;
+    for (node_str* n = simple; n != NULL; n = NEXT(n)) {
+        nodes[count++] = n;
+    }
+    osaka_randomizenodes(nodes, count, &state);
+    osaka_mutatenode(nodes[0], &state);
+    assert(count == 70 && !HASH_VALID(nodes[0]));
+    generate_free_individual(simple);
+
+    // a batch queued before a node without a kernel is still flushed, from the same draws
+    node_str* binary = generate_new_individual(2, BINARY_UP_TO_512);
+    node_str* last = generate_new_individual(1, SIMPLE);
+    node_str* mixed[] = { binary, NEXT(binary), last };
+    void* expected[] = { binary_up_to_512_copyobject(OBJECT(binary)), binary_up_to_512_copyobject(OBJECT(NEXT(binary))) };
+    uint64_t expected_state = state;
+    binary_up_to_512_randomizebatch(expected, 2, &expected_state);
+    osaka_randomizenodes(mixed, 3, &state);
+    assert(state == expected_state);
+    assert(binary_up_to_512_equalobject(OBJECT(mixed[0]), expected[0]) && binary_up_to_512_equalobject(OBJECT(mixed[1]), expected[1]));
+    binary_up_to_512_deleteobject(expected[0]);
+    binary_up_to_512_deleteobject(expected[1]);
+    generate_free_individual(binary);
+    generate_free_individual(last);
+
+    printf("\nBatch kernel test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   test_mutators
+ *
+ * DESCRIPTION
+ *
+ *  Tests the per-param mutate methods: gaussian steps are never 0,
+ *  neighbor and swap moves always land on another index in range,
+ *  and single param mutation of BINARY_UP_TO_512 units changes one
+ *  field within its declared range, picking the binary about three
+ *  times as often as the number as its weights ask, also when the
+ *  evolution loop is told to mutate single params
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_mutators(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_mutators(bool vis) {
+
+    uint64_t state = 12345;
+
+    for (uint32_t t = 0; t < 1000; t++) {
+        assert(gaussian_step(&state, 1 + t % 8) != 0);
+    }
+
+    for (uint32_t step = 0; step < 4; step++) {
+        for (uint32_t index = 0; index < 11; index++) {
+            for (uint32_t t = 0; t < 50; t++) {
+
+                uint32_t next = neighbor_index(&state, index, 11, step);
+                uint32_t distance = next > index ? next - index : index - next;
+                assert(next < 11 && distance >= 1 && distance <= (step > 0 ? step : 1));
+
+                uint32_t other = swap_index(&state, index, 11);
+                assert(other < 11 && other != index);
+
+            }
+        }
+    }
+
+    assert(neighbor_index(&state, 0, 1, 3) == 0 && swap_index(&state, 0, 1) == 0);
+
+    void (*mutators[OBJECT_MAX_FIELDS])(void *, uint64_t *);
+    uint32_t weights[OBJECT_MAX_FIELDS];
+    assert(object_table_function[BINARY_UP_TO_512].osaka_mutatorsobject(mutators, weights) == 2);
+    assert(weights[0] == 1 && weights[1] == 3);
+
+    // every mutation changes exactly one field of the unit, and keeps it in range
+    srand(3);
+    node_str* indiv = generate_new_individual(5, BINARY_UP_TO_512);
+    object_binary_up_to_512_str* o = OBJECT(osaka_nthnode(indiv, 3));
+    uint32_t numbers = 0;
+    uint32_t binaries = 0;
+
+    for (uint32_t t = 0; t < 4000; t++) {
+
+        object_binary_up_to_512_str copy = *o;
+        object_binary_up_to_512_str* then = &copy;
+        mutation_single_unit_single_param(indiv, 3);
+
+        bool number = BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) != BINARY_UP_TO_512_NUMBER_MY_NUMBER(then);
+        bool binary = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) != BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(then);
+        uint32_t index = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o);
+        uint32_t before = BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(then);
+
+        assert(number != binary && !HASH_VALID(osaka_nthnode(indiv, 3)));
+        assert(BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) <= 511);
+        assert(!binary || index == before + 1 || index + 1 == before);
+
+        numbers += number;
+        binaries += binary;
+
+    }
+
+    if (vis) {
+        printf("\nnumber mutated %u times, binary mutated %u times\n", numbers, binaries);
+    }
+
+    assert(binaries > 2 * numbers && binaries < 4 * numbers);
+
+    // the mutation of the evolution loop follows the operator, all params by default
+    assert(mutation_get_operator() == MUTATION_ALL_PARAMS);
+    assert(mutation_operator_from_name(mutation_operator_name(MUTATION_SINGLE_PARAM)) == MUTATION_SINGLE_PARAM);
+    mutation_set_operator(MUTATION_SINGLE_PARAM);
+    for (uint32_t t = 0; t < 200; t++) {
+        object_binary_up_to_512_str copy = *o;
+        object_binary_up_to_512_str* then = &copy;
+        mutation_single_unit(indiv, 3, false);
+        assert((BINARY_UP_TO_512_NUMBER_MY_NUMBER(o) != BINARY_UP_TO_512_NUMBER_MY_NUMBER(then)) != (BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(o) != BINARY_UP_TO_512_BINARY_MY_BINARY_INDEX(then)));
+    }
+    mutation_set_operator(MUTATION_ALL_PARAMS);
+
+    generate_free_individual(indiv);
+
+    printf("\nMutator test passed\n");
+
+}
+
+/*
+ * NAME
+ *
+ *   __test_fitness_single
+ *
+ * DESCRIPTION
+ *
+ *  Stand-in fitness method registered by test_fitness_registry,
+ *  scoring every individual the same
+ *
+ * PARAMETERS
+ *
+ *  node_str* indiv, bool vis, char* test_file, char** src_files,
+ *  uint32_t num_src_files, bool cache, char* cache_file -- unused
+ *
+ * RETURN
+ *
+ *  double -- always 7
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str entry = { "SIMPLE", NULL, __test_fitness_single, NULL, NULL, FITNESS_MINIMIZE };
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+double __test_fitness_single(node_str* indiv, bool vis, char* test_file, char** src_files, uint32_t num_src_files, bool cache, char* cache_file) {
+
+    return 7;
+
+}
+
+static uint32_t test_fitness_batch_calls = 0;
+
+/*
+ * NAME
+ *
+ *   __test_fitness_batch
+ *
+ * DESCRIPTION
+ *
+ *  Stand-in batch method registered by test_fitness_registry,
+ *  scoring each individual by its place in the generation and
+ *  counting how often it is called
+ *
+ * PARAMETERS
+ *
+ *  node_str** gen -- the generation, unused
+ *  uint32_t pop_size -- number of individuals in gen
+ *  double* fitness_values -- where the scores are written
+ *
+ * RETURN
+ *
+ *  bool -- always true
+ *
+ * EXAMPLE
+ *
+ *  fitness_entry_str entry = { "SIMPLE", NULL, __test_fitness_single, __test_fitness_batch, NULL, FITNESS_MINIMIZE };
+ *
+ * SIDE-EFFECT
+ *
+ *  fills fitness_values and counts the call
+ *
+ */
+
+bool __test_fitness_batch(node_str** gen, uint32_t pop_size, double* fitness_values) {
+
+    for (uint32_t i = 0; i < pop_size; i++) {
+        fitness_values[i] = i;
+    }
+
+    test_fitness_batch_calls++;
+    return true;
+
+}
+
+/*
+ * NAME
+ *
+ *   test_fitness_registry
+ *
+ * DESCRIPTION
+ *
+ *  Tests the fitness registry: built in types find their entry by
+ *  name, types without one fall back to the default score of 100,
+ *  and an entry registered over SIMPLE takes over both single and
+ *  generation evaluation, with selection following its direction
+ *  while the scores are left as they are
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_fitness_registry(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the SIMPLE entry for the length of the test
+ *
+ */
+
+void test_fitness_registry(bool vis) {
+
+    fitness_setup();
+
+    assert(strcmp(fitness_lookup(BINARY_UP_TO_512)->name, "BINARY_UP_TO_512") == 0);
+    assert(strcmp(fitness_lookup(OSAKA_STRING)->name, "OSAKA_STRING") == 0);
+    assert(fitness_lookup(OSAKA_STRING)->fitness_batch != NULL);
+
+    node_str* indiv = generate_new_individual(4, SIMPLE);
+    fitness_entry_str* fallback = fitness_lookup(MAXTYPE);
+    assert(strcmp(fallback->name, "DEFAULT") == 0);
+    assert(fallback->fitness_single(indiv, vis, NULL, NULL, 0, false, NULL) == 100);
+
+    // selection takes its direction from the registry, also for types past the built-in ones
+    assert(!selection_get_min_max(SIMPLE) && selection_compare_fitness(2, 1, SIMPLE));
+    assert(selection_get_min_max(BINARY_UP_TO_512) && selection_compare_fitness(0, 1, BINARY_UP_TO_512));
+    assert(selection_get_min_max(MAXTYPE) && selection_get_min_max(FITNESS_MAX_ENTRIES));
+
+    // an entry without a fitness method is refused
+    fitness_entry_str broken = { "SIMPLE", NULL, NULL, NULL, NULL, FITNESS_MINIMIZE };
+    assert(!fitness_register(&broken));
+
+    fitness_entry_str original = *fitness_lookup(SIMPLE);
+    fitness_entry_str replacement = { "SIMPLE", NULL, __test_fitness_single, __test_fitness_batch, NULL, FITNESS_MINIMIZE };
+    assert(fitness_register(&replacement));
+    assert(fitness_lookup(SIMPLE)->fitness_single == __test_fitness_single);
+    assert(fitness_top(indiv, vis, NULL, NULL, 0, false, NULL) == 7);
+    assert(selection_get_min_max(SIMPLE) && selection_compare_fitness(1, 2, SIMPLE));
+
+    node_str* gen[6];
+    double fitness_values[6];
+
+    for (uint32_t i = 0; i < 6; i++) {
+        gen[i] = generate_new_individual(4, SIMPLE);
+    }
+
+    test_fitness_batch_calls = 0;
+    evolution_evaluate_generation(gen, fitness_values, 6, NULL, NULL, 0);
+    assert(test_fitness_batch_calls == 1);
+
+    for (uint32_t i = 0; i < 6; i++) {
+        assert(fitness_values[i] == i);
+    }
+
+    if (vis) {
+        printf("\nreplacement SIMPLE entry scored the generation in %u batch call\n", test_fitness_batch_calls);
+    }
+
+    // registering the saved entry puts SIMPLE back for the tests that follow
+    assert(fitness_register(&original));
+    assert(fitness_lookup(SIMPLE)->fitness_single == original.fitness_single);
+    assert(fitness_lookup(SIMPLE)->fitness_batch == NULL);
+    assert(!selection_get_min_max(SIMPLE));
+    assert(!fitness_generation(gen, fitness_values, 6));
+
+    for (uint32_t i = 0; i < 6; i++) {
+        generate_free_individual(gen[i]);
+    }
+
+    generate_free_individual(indiv);
+
+    printf("\nFitness registry test passed\n");
+
+}
+
 /*
  * NAME
  *
@@ -1098,6 +3589,27 @@ void test_master(uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, uint
     //test_selection_tournament(4, 4, 2, ot, vis, file, src_files, num_src_files);
     //test_selection_tournament_multiple(pop_size, 5, tourn_size, ot, vis, file, src_files, num_src_files);
     //test_generate_free_individual_inside_array(pop_size, 20, ot, vis);
+    test_osaka_structure(vis);
+    test_persistent_individuals(indiv_size, ot, vis);
+    test_hash_and_equal(indiv_size, ot, vis);
+    test_population_matrix(pop_size, indiv_size, ot, vis);
+    test_concurrent_store(pop_size, indiv_size, ot, vis);
+    test_runlog(pop_size, indiv_size, ot, vis);
+    test_async_output(4, 5000, vis);
+    test_instrument(indiv_size, ot, vis);
+    test_trace(pop_size, indiv_size, ot, vis);
+    test_bench(pop_size, indiv_size < 3 ? 3 : indiv_size, ot, vis);
+    test_mock_evolution(3, pop_size, indiv_size, ot, vis);
+    test_job(pop_size < 4 ? 4 : pop_size, indiv_size < 3 ? 3 : indiv_size, ot, vis);
+    test_build_cache(vis);
+    test_suite(vis);
+    test_interpreter(vis);
+    test_aarch64(vis);
+    test_distance(vis);
+    test_bitset(vis);
+    test_batch(vis);
+    test_mutators(vis);
+    test_fitness_registry(vis);
     test_evolution_basic_crossover_and_mutation_with_replacement(num_gens, pop_size, indiv_size, tourn_size, mut_perc, cross_perc, ot, vis, file, src_files, num_src_files, cache);
     //*/
 
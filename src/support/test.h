@@ -38,6 +38,18 @@
 #include "sys/time.h"
 #include "llvm.h"
 #include "../evolution/evolution.h"
+#include "../evolution/population.h"
+#include "../evolution/store.h"
+#include "output.h"
+#include "bench.h"
+#include "job.h"
+#include "../osaka/osaka_test.h"
+
+typedef struct test_output_producer_str {
+    FILE* stream;
+    uint32_t id;
+    uint32_t num_lines;
+} test_output_producer_str;
 
 /*
  * ROUTINES
@@ -500,6 +512,748 @@ void test_evolution_basic_crossover_and_mutation(uint32_t pop_size, uint32_t num
 
 void test_evolution_basic_crossover_and_mutation_with_replacement(uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, uint32_t tourn_size, uint32_t mut_perc, uint32_t cross_perc, osaka_object_typ ot, bool vis, char* file, char** src_files, uint32_t num_src_files, bool cache);
 
+/*
+ * NAME
+ *
+ *   test_osaka_structure
+ *
+ * DESCRIPTION
+ *
+ *  Runs the checks of the Osaka Structure itself in osaka_test.c:
+ *  creating, serializing, comparing, copying and freeing lists, and
+ *  building, looking up and editing a 1000 node list through its header
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_osaka_structure(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes the serialized lists in the working directory
+ *
+ */
+
+void test_osaka_structure(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_persistent_individuals
+ *
+ * DESCRIPTION
+ *
+ *  Tests that persistent crossover and mutation share genes with
+ *  the parents instead of copying them, and that the parents are
+ *  left unchanged by either operator
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- individual size
+ *  osaka_object_typ ot -- object type to be created
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * test_persistent_individuals(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_persistent_individuals(uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_hash_and_equal
+ *
+ * DESCRIPTION
+ *
+ *  Tests that copies of an individual hash the same and are
+ *  osaka_equal, and that after mutating one unit the incremental
+ *  hash update and the prefix hashes agree with a full rehash
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- individual size
+ *  osaka_object_typ ot -- object type to be created
+ *  bool vis -- whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ * test_hash_and_equal(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_hash_and_equal(uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_population_matrix
+ *
+ * DESCRIPTION
+ *
+ *  Test of the structure-of-arrays population. A large population is
+ *  randomized and timed, a generation of lists is round tripped through
+ *  it, a masked mutation is checked to only touch the marked genes and
+ *  the diversity is checked for a random and for a uniform population
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals in the round trip
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print progress
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_population_matrix(10, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts on failure
+ *
+ */
+
+void test_population_matrix(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_concurrent_store
+ *
+ * DESCRIPTION
+ *
+ *  Stress test of the concurrent population store. Many threads fill a
+ *  store with new individuals at once, after which every slot must hold
+ *  exactly one individual and every node uid must be unique. A generation
+ *  is then bred in parallel and every child checked for its size
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals bred
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_concurrent_store(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  asserts on failure
+ *
+ */
+
+void test_concurrent_store(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_runlog
+ *
+ * DESCRIPTION
+ *
+ *  Writes the records of a generation to a JSON Lines and to a binary run
+ *  log in the temporary directory and reads both back, checking that
+ *  there is one well formed line per record and that the binary records
+ *  hold the encoded genes of every individual
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_runlog(20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes two files in P_tmpdir, asserts on failure
+ *
+ */
+
+void test_runlog(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   __test_async_output_producer
+ *
+ * DESCRIPTION
+ *
+ *  Thread body for test_async_output, writes numbered lines to a stream
+ *  through the output queue
+ *
+ * PARAMETERS
+ *
+ *  void* arg -- test_output_producer_str* naming the stream, thread id and number of lines
+ *
+ * RETURN
+ *
+ *  void* -- always NULL
+ *
+ * EXAMPLE
+ *
+ *  pthread_create(&thread, NULL, __test_async_output_producer, &producer);
+ *
+ * SIDE-EFFECT
+ *
+ *  queues num_lines lines of text
+ *
+ */
+
+void* __test_async_output_producer(void* arg);
+
+/*
+ * NAME
+ *
+ *   test_async_output
+ *
+ * DESCRIPTION
+ *
+ *  Writes numbered lines from several threads through the asynchronous
+ *  output queue into a file in the temporary directory, once waiting for
+ *  room and once dropping records when the queue is full. Checks that no
+ *  line is lost or torn when blocking, that each thread's lines keep
+ *  their order, that a record longer than the inline text is written
+ *  whole and that written and dropped lines add up when dropping
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_threads -- number of producer threads, at most STORE_MAX_THREADS
+ *  uint32_t num_lines -- lines written by each thread
+ *  bool vis -- whether or not to print timings
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_async_output(4, 5000, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a file in P_tmpdir, asserts on failure. Skipped if
+ *  asynchronous output was already started for the run
+ *
+ */
+
+void test_async_output(uint32_t num_threads, uint32_t num_lines, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_instrument
+ *
+ * DESCRIPTION
+ *
+ *  Checks that timed phases and counters are added to both the generation
+ *  and the run statistics, that reporting a generation starts a new
+ *  window while the run totals are kept, and that the monotonic clock
+ *  does not go backwards. When built with make INSTRUMENT=1 it also
+ *  checks that creating and freeing individuals is counted
+ *
+ * PARAMETERS
+ *
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the totals table
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_instrument(10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  resets the instrumentation statistics, asserts on failure
+ *
+ */
+
+void test_instrument(uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_trace
+ *
+ * DESCRIPTION
+ *
+ *  Breeds a generation on several threads while tracing into a file in
+ *  the temporary directory, then parses the trace back as JSON and checks
+ *  that there is a well formed span for every breeding step, that the
+ *  workers were given their own tracks and that the population counters
+ *  were written
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print a summary
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_trace(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a file in P_tmpdir, asserts on failure. Skipped if
+ *  the run itself is being traced
+ *
+ */
+
+void test_trace(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_bench
+ *
+ * DESCRIPTION
+ *
+ *  Builds a benchmark fixture and checks its population, then writes a
+ *  baseline to a temporary file and checks that results are found in it
+ *  by benchmark, object type and sizes, and that results slower than the
+ *  baseline by more than the tolerance are reported as regressions
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size -- number of individuals in the fixture
+ *  uint32_t indiv_size -- number of genes per individual, at least 3
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the comparison
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_bench(50, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates and removes a temporary file, asserts on failure
+ *
+ */
+
+void test_bench(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_mock_evolution
+ *
+ * DESCRIPTION
+ *
+ *  Checks that the synthetic evaluator gives the same fitness every time
+ *  it sees the same individual, that a generation evaluated by several
+ *  threads gets the same fitness values as one evaluated in order, and
+ *  that whole runs with one and with four evaluation threads evaluate
+ *  every individual once and end with the same best individual
+ *
+ * PARAMETERS
+ *
+ *  uint32_t num_gens -- generations of every run
+ *  uint32_t pop_size -- number of individuals in the population
+ *  uint32_t indiv_size -- number of genes per individual
+ *  osaka_object_typ ot -- object type of the genes
+ *  bool vis -- whether or not to print the results
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_mock_evolution(3, 20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  changes the random seed, asserts on failure
+ *
+ */
+
+void test_mock_evolution(uint32_t num_gens, uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_job
+ *
+ * DESCRIPTION
+ *
+ *  Tests job specs and the queue runner: an inline spec and a queue folder
+ *  with one valid and one invalid job file are read, the valid job runs
+ *  with the synthetic evaluator and caches to its own output folder, and
+ *  the evaluator and worker count are put back afterwards
+ *
+ * PARAMETERS
+ *
+ *  uint32_t pop_size - size of the population of the jobs, at least 4
+ *  uint32_t indiv_size - genes per individual, at least 3
+ *  osaka_object_typ ot - the object type being used for this run
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_job(20, 10, LLVM_PASS, false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes temporary files, changes the random seed
+ *
+ */
+
+void test_job(uint32_t pop_size, uint32_t indiv_size, osaka_object_typ ot, bool vis);
+
+/*
+ * NAME
+ *
+ *   test_build_cache
+ *
+ * DESCRIPTION
+ *
+ *  Tests the parts of the LLVM build cache that do not need LLVM: files
+ *  are hashed by their contents alone, and control timings stored for a
+ *  linked module are found again on this machine
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_build_cache(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes temporary files
+ *
+ */
+
+void test_build_cache(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_suite
+ *
+ * DESCRIPTION
+ *
+ *  Tests the parts of the benchmark suite fitness that do not need LLVM:
+ *  the weighted geometric mean of the time ratios, and reading valid and
+ *  invalid suite files
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_suite(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes and removes a temporary file
+ *
+ */
+
+void test_suite(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_interpreter
+ *
+ * DESCRIPTION
+ *
+ *  Tests the register machine interpreter of ASSEMBLER individuals: a
+ *  program computing the default target exactly has no error and the
+ *  expected cycles, a changed immediate shows up in the error on every
+ *  case, division follows AArch64 sdiv, the fitness by cycles ranks exact
+ *  programs first, and the operands survive encoding and decoding
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_interpreter(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the interpreter problem back to the default
+ *
+ */
+
+void test_interpreter(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_aarch64
+ *
+ * DESCRIPTION
+ *
+ *  Tests the AArch64 evaluator of ASSEMBLER individuals: the function
+ *  emitted for an individual zeroes the registers that are not inputs and
+ *  turns immediates AArch64 has no form for into valid instructions, and,
+ *  when the cross toolchain and the emulator are installed, a generation
+ *  run under the emulator agrees with the interpreter on every individual
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_aarch64(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  builds and runs a program in src/files/aarch64 if the toolchain is installed
+ *
+ */
+
+void test_aarch64(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_distance
+ *
+ * DESCRIPTION
+ *
+ *  Tests the string distance fitness of OSAKA_STRING individuals: for
+ *  targets of one word, exactly one word and several words of the bit
+ *  vectors, the edit and Hamming distances of a batch and of single
+ *  individuals match a plain dynamic programming reference on the joined
+ *  strings, the target sentence itself is at distance 0, and the distance
+ *  memo filled for a generation gives back the same fitness values
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_distance(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the target sentence back to the default
+ *
+ */
+
+void test_distance(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_bitset
+ *
+ * DESCRIPTION
+ *
+ *  Tests the packed genomes of BINARY_UP_TO_512 individuals: the flat
+ *  objects copy, write and read back equal, a packed genome holds the
+ *  index of every gene, and for individuals of 1 to 300 genes the OneMax,
+ *  target sum and knapsack kernels and the fitness of each problem match
+ *  a plain loop over the genes
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_bitset(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  sets the problem back to OneMax
+ *
+ */
+
+void test_bitset(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_batch
+ *
+ * DESCRIPTION
+ *
+ *  Tests the batch kernels of the module table: individuals generated
+ *  through the randomize kernel only hold valid values and reach all of
+ *  them, the same srand seed generates the same individuals, a mutate
+ *  kernel changes at most one field of one unit, and types without
+ *  kernels fall back to randomizing one object at a time
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_batch(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  reseeds the random generator
+ *
+ */
+
+void test_batch(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_mutators
+ *
+ * DESCRIPTION
+ *
+ *  Tests the per-param mutate methods: gaussian steps are never 0,
+ *  neighbor and swap moves always land on another index in range,
+ *  and single param mutation of BINARY_UP_TO_512 units changes one
+ *  field within its declared range, picking the binary about three
+ *  times as often as the number as its weights ask
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_mutators(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+void test_mutators(bool vis);
+
+/*
+ * NAME
+ *
+ *   test_fitness_registry
+ *
+ * DESCRIPTION
+ *
+ *  Tests the fitness registry: built in types find their entry by
+ *  name, types without one fall back to the default score of 100,
+ *  and an entry registered over SIMPLE takes over both single and
+ *  generation evaluation, with selection following its direction
+ *  while the scores are left as they are
+ *
+ * PARAMETERS
+ *
+ *  bool vis - whether or not visualization is enabled
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  test_fitness_registry(false);
+ *
+ * SIDE-EFFECT
+ *
+ *  replaces the SIMPLE entry for the length of the test
+ *
+ */
+
+void test_fitness_registry(bool vis);
+
 /*
  * NAME
  *
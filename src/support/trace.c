@@ -0,0 +1,371 @@
+/*
+ ============================================================================
+ Name        : trace.c
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Timeline export. When started, spans for generations, breeding
+               steps and evaluations are written as Chrome Trace Event JSON,
+               one track per thread, together with counters of the
+               population, so a run can be opened in Perfetto or
+               chrome://tracing. When not started every call returns at once
+ ============================================================================
+ */
+
+/*
+ * IMPORT
+ */
+
+#include "trace.h"
+
+/*
+ * STATIC
+ */
+
+// the trace file of the process, NULL while tracing is off
+static _Atomic(FILE*) trace_file = NULL;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool trace_first_event = true;
+static uint64_t trace_start_ns = 0;
+
+// every thread gets its own track, numbered in the order threads first trace
+static _Atomic uint32_t trace_next_tid = 0;
+static _Thread_local uint32_t trace_tid = 0;
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   __trace_event
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that writes one event object to the trace file. The
+ *  event is formatted first and written under the lock, so events from
+ *  different threads never interleave
+ *
+ * PARAMETERS
+ *
+ *  const char* format -- printf style format of the event object, without the separating comma
+ *  ... -- values for the format
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __trace_event("{\"name\":\"%s\",\"ph\":\"i\"}", name);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
+
+void __trace_event(const char* format, ...) {
+
+    char event[512];
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(event, sizeof(event), format, args);
+    va_end(args);
+
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file != NULL) {
+        fputs(trace_first_event ? "\n" : ",\n", trace_file);
+        fputs(event, trace_file);
+        trace_first_event = false;
+    }
+    pthread_mutex_unlock(&trace_lock);
+
+}
+
+/*
+ * NAME
+ *
+ *   __trace_thread
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that returns the track of the calling thread, naming
+ *  the track the first time the thread traces
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint32_t -- track id of the calling thread
+ *
+ * EXAMPLE
+ *
+ *  uint32_t tid = __trace_thread();
+ *
+ * SIDE-EFFECT
+ *
+ *  may write a metadata event
+ *
+ */
+
+uint32_t __trace_thread(void) {
+
+    if (trace_tid == 0) {
+
+        trace_tid = atomic_fetch_add(&trace_next_tid, 1) + 1;
+
+        if (trace_tid == 1) {
+            __trace_event("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"main\"}}");
+        }
+        else {
+            __trace_event("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"worker %u\"}}",
+                trace_tid, trace_tid - 1);
+        }
+
+    }
+
+    return trace_tid;
+
+}
+
+/*
+ * NAME
+ *
+ *   trace_start
+ *
+ * DESCRIPTION
+ *
+ *  Starts tracing into the given file, which is overwritten. The trace is
+ *  closed at exit if trace_stop is not called before
+ *
+ * PARAMETERS
+ *
+ *  const char* file -- path of the trace file
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_start(TRACE_DEFAULT_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the file
+ *
+ */
+
+void trace_start(const char* file) {
+
+    static bool registered = false;
+
+    assert(trace_file == NULL);
+
+    FILE* stream = fopen(file, "w");
+
+    if (stream == NULL) {
+        printf("error: could not create trace file %s [file:\'%s\',line:%d]\n", file, __FILE__, __LINE__);
+        exit(0);
+    }
+
+    if (!registered) {
+        atexit(trace_stop);
+        registered = true;
+    }
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", stream);
+
+    trace_start_ns = instrument_now_ns();
+    trace_first_event = true;
+    trace_file = stream;
+
+    __trace_event("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"shackleton\"}}");
+
+    // the thread that starts tracing is always the first track
+    atomic_store(&trace_next_tid, 0);
+    trace_tid = 0;
+    __trace_thread();
+
+}
+
+/*
+ * NAME
+ *
+ *   trace_stop
+ *
+ * DESCRIPTION
+ *
+ *  Finishes the trace file and stops tracing
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_stop();
+ *
+ * SIDE-EFFECT
+ *
+ *  closes the file
+ *
+ */
+
+void trace_stop(void) {
+
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file != NULL) {
+        fputs("\n]}\n", trace_file);
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+    pthread_mutex_unlock(&trace_lock);
+
+}
+
+/*
+ * NAME
+ *
+ *   trace_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether tracing is currently started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between trace_start and trace_stop
+ *
+ * EXAMPLE
+ *
+ *  if (trace_enabled()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool trace_enabled(void) {
+
+    return trace_file != NULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   trace_span
+ *
+ * DESCRIPTION
+ *
+ *  Writes a complete span on the track of the calling thread, given the
+ *  clock readings at its start and its end
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name shown on the span
+ *  const char* category -- category used to filter spans
+ *  uint64_t start_ns -- instrument_now_ns() at the start
+ *  uint64_t stop_ns -- instrument_now_ns() at the end
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_span("opt", "evaluation", start, instrument_now_ns());
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
+
+void trace_span(const char* name, const char* category, uint64_t start_ns, uint64_t stop_ns) {
+
+    if (trace_file == NULL) {
+        return;
+    }
+
+    uint32_t tid = __trace_thread();
+
+    __trace_event("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+        name, category, (start_ns - trace_start_ns) / 1e3, (stop_ns - start_ns) / 1e3, tid);
+
+}
+
+/*
+ * NAME
+ *
+ *   trace_counter
+ *
+ * DESCRIPTION
+ *
+ *  Writes the current value of one series of a counter track. Series with
+ *  the same counter name are drawn together
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name of the counter track
+ *  const char* series -- name of the series
+ *  double value -- value at the current time
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_counter("population", "best", best_fitness);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
+
+void trace_counter(const char* name, const char* series, double value) {
+
+    if (trace_file == NULL) {
+        return;
+    }
+
+    __trace_event("{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{\"%s\":%.17g}}",
+        name, (instrument_now_ns() - trace_start_ns) / 1e3, series, value);
+
+}
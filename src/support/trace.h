@@ -0,0 +1,224 @@
+/*
+ ============================================================================
+ Name        : trace.h
+ Author      : Hannah M. Peeler
+ Version     : 1.0
+ Copyright   : 
+ 
+    Copyright 2019 Arm Inc., Andrew Sloss, Hannah Peeler
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    Please refer to 
+    https://github.com/ARM-software/Shackleton-Framework/blob/master/LICENSE.TXT
+    for a full overview of the license covering this work.
+    
+ Description : Timeline export. When started, spans for generations, breeding
+               steps and evaluations are written as Chrome Trace Event JSON,
+               one track per thread, together with counters of the
+               population, so a run can be opened in Perfetto or
+               chrome://tracing. When not started every call returns at once
+ ============================================================================
+ */
+
+#ifndef SUPPORT_TRACE_H_
+#define SUPPORT_TRACE_H_
+
+/*
+ * IMPORT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "instrument.h"
+
+/*
+ * MACROS
+ */
+
+// spans are started and stopped in pairs inside one scope, the clock is
+// only read when tracing is on
+#define TRACE_START(name) uint64_t __trace_##name = trace_enabled() ? instrument_now_ns() : 0
+#define TRACE_STOP(name, label, category) do { \
+        if (trace_enabled()) { \
+            trace_span(label, category, __trace_##name, instrument_now_ns()); \
+        } \
+    } while (0)
+
+#define TRACE_DEFAULT_FILE "shackleton_trace.json"
+
+/*
+ * ROUTINES
+ */
+
+/*
+ * NAME
+ *
+ *   trace_start
+ *
+ * DESCRIPTION
+ *
+ *  Starts tracing into the given file, which is overwritten. The trace is
+ *  closed at exit if trace_stop is not called before
+ *
+ * PARAMETERS
+ *
+ *  const char* file -- path of the trace file
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_start(TRACE_DEFAULT_FILE);
+ *
+ * SIDE-EFFECT
+ *
+ *  creates the file
+ *
+ */
+
+void trace_start(const char* file);
+
+/*
+ * NAME
+ *
+ *   trace_stop
+ *
+ * DESCRIPTION
+ *
+ *  Finishes the trace file and stops tracing
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_stop();
+ *
+ * SIDE-EFFECT
+ *
+ *  closes the file
+ *
+ */
+
+void trace_stop(void);
+
+/*
+ * NAME
+ *
+ *   trace_enabled
+ *
+ * DESCRIPTION
+ *
+ *  Whether tracing is currently started
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  bool -- true between trace_start and trace_stop
+ *
+ * EXAMPLE
+ *
+ *  if (trace_enabled()) ...
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+bool trace_enabled(void);
+
+/*
+ * NAME
+ *
+ *   trace_span
+ *
+ * DESCRIPTION
+ *
+ *  Writes a complete span on the track of the calling thread, given the
+ *  clock readings at its start and its end
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name shown on the span
+ *  const char* category -- category used to filter spans
+ *  uint64_t start_ns -- instrument_now_ns() at the start
+ *  uint64_t stop_ns -- instrument_now_ns() at the end
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_span("opt", "evaluation", start, instrument_now_ns());
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
+
+void trace_span(const char* name, const char* category, uint64_t start_ns, uint64_t stop_ns);
+
+/*
+ * NAME
+ *
+ *   trace_counter
+ *
+ * DESCRIPTION
+ *
+ *  Writes the current value of one series of a counter track. Series with
+ *  the same counter name are drawn together
+ *
+ * PARAMETERS
+ *
+ *  const char* name -- name of the counter track
+ *  const char* series -- name of the series
+ *  double value -- value at the current time
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  trace_counter("population", "best", best_fitness);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes to the trace file
+ *
+ */
+
+void trace_counter(const char* name, const char* series, double value);
+
+#endif /* SUPPORT_TRACE_H_ */
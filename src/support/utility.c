@@ -134,10 +134,10 @@ str2int_errno str2int(uint32_t *out, char *s, uint32_t base) {
 
 void swap(char* temp1, char* temp2) {
 
-    char* temp;
-    *temp = *temp1;
+    char temp;
+    temp = *temp1;
     *temp1 = *temp2;
-    *temp2 = *temp;
+    *temp2 = temp;
 
 } 
 
@@ -442,6 +442,7 @@ char *randomString(uint32_t length) {
  *  uint32_t perc_mut
  *  uint32_t tourn_size
  *  bool vis
+ *  char* mut_op -- name of the mutation operator, at least 20 characters
  *
  * RETURN
  *
@@ -449,7 +450,7 @@ char *randomString(uint32_t length) {
  *
  * EXAMPLE
  *
- * set_params_from_file(num_generations, num_population_size, percent_crossover, percent_mutation, tournament_size, visualization);
+ * set_params_from_file(num_generations, num_population_size, percent_crossover, percent_mutation, tournament_size, visualization, mutation_operator);
  *
  * SIDE-EFFECT
  *
@@ -457,7 +458,7 @@ char *randomString(uint32_t length) {
  *
  */
 
-void set_params_from_file(uint32_t *num_gen, uint32_t *pop_size, uint32_t *perc_cross, uint32_t *perc_mut, uint32_t *tourn_size, bool *vis) {
+void set_params_from_file(uint32_t *num_gen, uint32_t *pop_size, uint32_t *perc_cross, uint32_t *perc_mut, uint32_t *tourn_size, bool *vis, char *mut_op) {
 
     FILE *file;
     char* line = NULL;
@@ -513,6 +514,13 @@ void set_params_from_file(uint32_t *num_gen, uint32_t *pop_size, uint32_t *perc_
                 temp[strlen(temp) - 2] = '\0';
                 str2int(tourn_size, temp, 10);
             }
+            else if (strcmp(temp, "mutation_operator:") == 0) {
+                printf("\tsetting mutation_operator from file\n");
+                temp = strtok(NULL, delim);
+                temp[strcspn(temp, "\r\n")] = '\0';
+                strncpy(mut_op, temp, 19);
+                mut_op[19] = '\0';
+            }
             else if (strcmp(temp, "visualization:") == 0) {
                 printf("\tsetting visualization from file\n");
                 temp = strtok(NULL, delim);
@@ -535,4 +543,448 @@ void set_params_from_file(uint32_t *num_gen, uint32_t *pop_size, uint32_t *perc_
     free(line);
     fclose(file);
 
-}
\ No newline at end of file
+}
+
+/*
+ * NAME
+ *
+ *   hash_mix64
+ *
+ * DESCRIPTION
+ *
+ *  Fast non-cryptographic 64 bit mixer (the splitmix64 finalizer). Every
+ *  input bit affects every output bit, so it can be applied to small or
+ *  poorly distributed values such as enum indices before they are
+ *  combined into a larger hash
+ *
+ * PARAMETERS
+ *
+ *  uint64_t x -- value to be mixed
+ *
+ * RETURN
+ *
+ *  uint64_t -- mixed value
+ *
+ * EXAMPLE
+ *
+ *  h = hash_mix64(PASS_INDEX(o));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t hash_mix64(uint64_t x) {
+
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return x;
+
+}
+
+/*
+ * NAME
+ *
+ *   hash_combine
+ *
+ * DESCRIPTION
+ *
+ *  Folds a value into a running hash. The result depends on the order in
+ *  which values are combined
+ *
+ * PARAMETERS
+ *
+ *  uint64_t seed -- running hash
+ *  uint64_t value -- value to fold in
+ *
+ * RETURN
+ *
+ *  uint64_t -- new running hash
+ *
+ * EXAMPLE
+ *
+ *  h = hash_combine(h, SUBTYPE(o));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t hash_combine(uint64_t seed, uint64_t value) {
+
+    return hash_mix64(seed * 0x9e3779b97f4a7c15ULL + hash_mix64(value));
+
+}
+
+/*
+ * NAME
+ *
+ *   hash_string
+ *
+ * DESCRIPTION
+ *
+ *  Hashes a NUL terminated string by its contents (FNV-1a, then mixed). A
+ *  NULL string hashes to 0
+ *
+ * PARAMETERS
+ *
+ *  const char* str -- string to be hashed
+ *
+ * RETURN
+ *
+ *  uint64_t -- hash of the contents
+ *
+ * EXAMPLE
+ *
+ *  h = hash_string(MY_STRING(o));
+ *
+ * SIDE-EFFECT
+ *
+ *  none
+ *
+ */
+
+uint64_t hash_string(const char* str) {
+
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    if (str == NULL) {
+        return 0;
+    }
+
+    while (*str != '\0') {
+        h ^= (unsigned char) *str++;
+        h *= 0x100000001b3ULL;
+    }
+
+    return hash_mix64(h);
+
+}
+
+
+/*
+ * NAME
+ *
+ *   xorshift64star
+ *
+ * DESCRIPTION
+ *
+ *  Small, fast pseudo random number generator (xorshift64*) for bulk
+ *  operations where calling rand() per value is too slow. The state is
+ *  owned by the caller, so independent streams do not interfere
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state, must not be 0
+ *
+ * RETURN
+ *
+ *  uint64_t -- next pseudo random value
+ *
+ * EXAMPLE
+ *
+ *  uint64_t state = rand() | 1;
+ *  uint64_t r = xorshift64star(&state);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+uint64_t xorshift64star(uint64_t* state) {
+
+    uint64_t x = *state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+
+    return x * 0x2545f4914f6cdd1dULL;
+
+}
+
+/*
+ * NAME
+ *
+ *   bounded_rand
+ *
+ * DESCRIPTION
+ *
+ *  Returns a pseudo random value in [0, range) using a multiply and shift
+ *  (Lemire's method) instead of a division. A range of 0 stands for the
+ *  full 32 bit range
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state, see xorshift64star
+ *  uint32_t range -- number of possible values, 0 for all 2^32
+ *
+ * RETURN
+ *
+ *  uint32_t -- pseudo random value in [0, range)
+ *
+ * EXAMPLE
+ *
+ *  index = bounded_rand(&state, num_valid_values);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+uint32_t bounded_rand(uint64_t* state, uint32_t range) {
+
+    uint32_t r = (uint32_t) (xorshift64star(state) >> 32);
+
+    if (range == 0) {
+        return r;
+    }
+
+    return (uint32_t) (((uint64_t) r * range) >> 32);
+
+}
+
+/*
+ * NAME
+ *
+ *   rand_state
+ *
+ * DESCRIPTION
+ *
+ *  Draws a fresh xorshift64star state from rand(), so that code moved
+ *  from rand() to a caller owned generator still follows srand and runs
+ *  with the same seed stay reproducible
+ *
+ * PARAMETERS
+ *
+ *  none
+ *
+ * RETURN
+ *
+ *  uint64_t -- generator state, never 0
+ *
+ * EXAMPLE
+ *
+ *  uint64_t state = rand_state();
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the rand() sequence by one value
+ *
+ */
+
+uint64_t rand_state(void) {
+
+    // rand() gives at most 31 bits, the mixer spreads them over the whole state
+    return hash_mix64((uint64_t) rand()) | 1;
+
+}
+
+/*
+ * NAME
+ *
+ *   gaussian_step
+ *
+ * DESCRIPTION
+ *
+ *  Integer step drawn from a normal distribution with a standard
+ *  deviation of step, rounded to the nearest integer. A draw that
+ *  rounds to 0 becomes 1 or -1, so a mutation always changes the value
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state, see xorshift64star
+ *  uint32_t step -- standard deviation of the step
+ *
+ * RETURN
+ *
+ *  int64_t -- non-zero step
+ *
+ * EXAMPLE
+ *
+ *  value += gaussian_step(&state, 8);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+int64_t gaussian_step(uint64_t* state, uint32_t step) {
+
+    // Box-Muller, with u1 in (0, 1] so that its log is finite
+    double u1 = ((xorshift64star(state) >> 11) + 1) * 0x1.0p-53;
+    double u2 = (xorshift64star(state) >> 11) * 0x1.0p-53;
+    int64_t s = llround(sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2) * step);
+
+    if (s == 0) {
+        s = (xorshift64star(state) >> 63) ? 1 : -1;
+    }
+
+    return s;
+
+}
+
+/*
+ * NAME
+ *
+ *   neighbor_index
+ *
+ * DESCRIPTION
+ *
+ *  Index of a value close to the current one among count ordered
+ *  values, at most step positions away in either direction. A move
+ *  past either end goes the other way instead
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state, see xorshift64star
+ *  uint32_t index -- current index
+ *  uint32_t count -- number of values
+ *  uint32_t step -- largest distance, at least 1
+ *
+ * RETURN
+ *
+ *  uint32_t -- new index, only equal to index when count is 1
+ *
+ * EXAMPLE
+ *
+ *  index = neighbor_index(&state, index, 11, 1);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+uint32_t neighbor_index(uint64_t* state, uint32_t index, uint32_t count, uint32_t step) {
+
+    if (count <= 1) {
+        return index;
+    }
+
+    // no further than the last value, so the index always changes
+    uint32_t widest = step < count - 1 ? step : count - 1;
+    int64_t distance = (int64_t) bounded_rand(state, widest > 0 ? widest : 1) + 1;
+    int64_t next = index + ((xorshift64star(state) >> 63) ? distance : -distance);
+
+    if (next < 0 || next >= count) {
+        next = 2 * (int64_t) index - next;
+    }
+
+    // when both directions overshoot the index is inside, so either end is a change
+    if (next < 0) {
+        next = 0;
+    }
+    else if (next >= count) {
+        next = count - 1;
+    }
+
+    return (uint32_t) next;
+
+}
+
+/*
+ * NAME
+ *
+ *   swap_index
+ *
+ * DESCRIPTION
+ *
+ *  Index of another value among count unordered values, every
+ *  value other than the current one being equally likely
+ *
+ * PARAMETERS
+ *
+ *  uint64_t* state -- generator state, see xorshift64star
+ *  uint32_t index -- current index
+ *  uint32_t count -- number of values
+ *
+ * RETURN
+ *
+ *  uint32_t -- new index, only equal to index when count is 1
+ *
+ * EXAMPLE
+ *
+ *  index = swap_index(&state, index, 4);
+ *
+ * SIDE-EFFECT
+ *
+ *  advances the state
+ *
+ */
+
+uint32_t swap_index(uint64_t* state, uint32_t index, uint32_t count) {
+
+    if (count <= 1) {
+        return index;
+    }
+
+    uint32_t other = bounded_rand(state, count - 1);
+
+    return other >= index ? other + 1 : other;
+
+}
+
+/*
+ * NAME
+ *
+ *   random_string
+ *
+ * DESCRIPTION
+ *
+ *  Same as randomString, but draws the characters from a caller
+ *  owned generator instead of rand()
+ *
+ * PARAMETERS
+ *
+ *  uint32_t length -- number of characters
+ *  uint64_t* state -- generator state, see xorshift64star
+ *
+ * RETURN
+ *
+ *  char* -- the new string, NULL when length is 0
+ *
+ * EXAMPLE
+ *
+ *  char* new_string = random_string(10, &state);
+ *
+ * SIDE-EFFECT
+ *
+ *  mallocs a new string that must be freed at some point, advances the state
+ *
+ */
+
+char* random_string(uint32_t length, uint64_t* state) {
+
+    static char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,.-#'?!";
+    char* result = NULL;
+
+    if (length) {
+
+        result = malloc(sizeof(char) * (length + 1));
+
+        if (result) {
+
+            for (uint32_t n = 0; n < length; n++) {
+                result[n] = charset[bounded_rand(state, (uint32_t) (sizeof(charset) - 1))];
+            }
+
+            result[length] = '\0';
+
+        }
+
+    }
+
+    return result;
+
+}
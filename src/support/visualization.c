@@ -39,6 +39,45 @@
  * ROUTINES
  */
 
+/*
+ * NAME
+ *
+ *   __visualization_print_node
+ *
+ * DESCRIPTION
+ *
+ *  Internal helper that prints the uid and the description of a single
+ *  node through output_printf, so that it can be queued like the rest of
+ *  the visualization output
+ *
+ * PARAMETERS
+ *
+ *  node_str* n -- node to print
+ *
+ * RETURN
+ *
+ *  none
+ *
+ * EXAMPLE
+ *
+ *  __visualization_print_node(indiv);
+ *
+ * SIDE-EFFECT
+ *
+ *  writes or queues output
+ *
+ */
+
+void __visualization_print_node(node_str* n) {
+
+    char desc[256];
+
+    strcpy(desc, "");
+    osaka_describenode(desc, n);
+    output_printf(stdout, "UID : %d ; %s", UID(n), desc);
+
+}
+
 /*
  * NAME
  *
@@ -70,8 +109,10 @@
 
 void visualization_print_individual_verbose(node_str* indiv) {
 
-    // only use internal methods through osaka
+    // the osaka methods print directly, so anything queued goes first
+    output_flush();
     osaka_printnodearray(indiv);
+    fflush(stdout);
 
 }
 
@@ -105,13 +146,13 @@ void visualization_print_individual_verbose(node_str* indiv) {
 
 void visualization_print_individual_concise_addresses(node_str* indiv) {
 
-    printf("{ %p }", indiv);
+    output_printf(stdout, "{ %p }", indiv);
 
     // only print pointer with <---> to represent connections
     while (NEXT(indiv) != NULL) {
 
         indiv = NEXT(indiv);
-        printf(" <---> { %p }", indiv);
+        output_printf(stdout, " <---> { %p }", indiv);
 
     }
 
@@ -147,17 +188,17 @@ void visualization_print_individual_concise_addresses(node_str* indiv) {
 
 void visualization_print_individual_concise_details(node_str* indiv) {
 
-    printf("{ ");
-    osaka_printnode_concise(indiv);
-    printf(" }");
+    output_printf(stdout, "{ ");
+    __visualization_print_node(indiv);
+    output_printf(stdout, " }");
 
     // using internal methods of osaka, with <---> representing connections
     while (NEXT(indiv) != NULL) {
 
         indiv = NEXT(indiv);
-        printf(" <---> { ");
-        osaka_printnode_concise(indiv);
-        printf(" }");
+        output_printf(stdout, " <---> { ");
+        __visualization_print_node(indiv);
+        output_printf(stdout, " }");
 
     }
 
@@ -194,19 +235,19 @@ void visualization_print_individual_concise_details(node_str* indiv) {
 
 void visualization_print_individual_concise_details_to_nth(node_str* indiv, uint32_t nth) {
 
-    printf("{ ");
-    osaka_printnode_concise(indiv);
-    printf(" }");
+    output_printf(stdout, "{ ");
+    __visualization_print_node(indiv);
+    output_printf(stdout, " }");
 
     uint32_t curr = 2;
 
     // using internal methods of osaka, with <---> representing connections
     while (NEXT(indiv) != NULL && curr < nth) {
 
-        printf(" <---> { ");
+        output_printf(stdout, " <---> { ");
         indiv = NEXT(indiv);
-        osaka_printnode_concise(indiv);
-        printf(" }");
+        __visualization_print_node(indiv);
+        output_printf(stdout, " }");
 
         curr++;
 
@@ -247,17 +288,17 @@ void visualization_print_individual_concise_details_from_nth(node_str* indiv, ui
 
     indiv = osaka_nthnode(indiv, nth);
 
-    printf("{ ");
-    osaka_printnode_concise(indiv);
-    printf(" }");
+    output_printf(stdout, "{ ");
+    __visualization_print_node(indiv);
+    output_printf(stdout, " }");
 
     // using internal methods of osaka, with <---> representing connections
     while (NEXT(indiv) != NULL) {
 
-        printf(" <---> { ");
+        output_printf(stdout, " <---> { ");
         indiv = NEXT(indiv);
-        osaka_printnode_concise(indiv);
-        printf(" }");
+        __visualization_print_node(indiv);
+        output_printf(stdout, " }");
 
     }
 
@@ -297,19 +338,19 @@ void visualization_print_individual_concise_details_from_nth_to_mth(node_str* in
 
     indiv = osaka_nthnode(indiv, nth);
 
-    printf("{ ");
-    osaka_printnode_concise(indiv);
-    printf(" }");
+    output_printf(stdout, "{ ");
+    __visualization_print_node(indiv);
+    output_printf(stdout, " }");
 
     uint32_t curr = 1;
 
     // using internal methods of osaka, with <---> representing connections
     while (NEXT(indiv) != NULL && curr < nth) {
 
-        printf(" <---> { ");
+        output_printf(stdout, " <---> { ");
         indiv = NEXT(indiv);
-        osaka_printnode_concise(indiv);
-        printf(" }");
+        __visualization_print_node(indiv);
+        output_printf(stdout, " }");
 
         curr++;
 
@@ -37,6 +37,7 @@
  */
 
 #include "../osaka/osaka.h"
+#include "output.h"
 
 /*
  * ROUTINES